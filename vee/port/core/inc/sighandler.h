@@ -30,6 +30,21 @@ void microej_segfault_handler_init(void);
  */
 void microej_usr1_signal_handler_init(void);
 
+/**
+ * @brief Dump function executed when SIGUSR1 signal is received, after the MicroEJ Core Engine dump.
+ */
+typedef void (*microej_signal_dump_t)(void);
+
+/**
+ * @brief Registers a dump function to execute when SIGUSR1 signal is received by the current process.
+ * The function is executed from the signal handler: it must print its state without allocating memory or taking locks.
+ *
+ * @param[in] dump the dump function.
+ *
+ * @return 0 on success, -1 if MICROEJ_USR1_SIGNAL_MAX_DUMPS functions are already registered.
+ */
+int microej_usr1_signal_register_dump(microej_signal_dump_t dump);
+
 #ifdef __cplusplus
 	}
 #endif
@@ -22,6 +22,15 @@
 #ifdef LLKERNEL_VALIDATION
 #include "t_llkernel_main.h"
 #endif
+#ifdef LLSEC_VALIDATION
+#include "t_llsec_main.h"
+#endif
+#ifdef LLNET_VALIDATION
+#include "t_llnet_main.h"
+#endif
+#ifdef LLSSL_VALIDATION
+#include "t_llssl_main.h"
+#endif
 
 #ifdef __cplusplus
 	extern "C" {
@@ -43,6 +52,18 @@ int main(int argc, char** argv){
 #ifdef LLKERNEL_VALIDATION
 	/* Start the LLkernel tests */
 	T_LLKERNEL_main();
+#ifdef LLSSL_VALIDATION
+	/* Start the LLssl benchmarks, first: the SSL memory hooks are installed before any OpenSSL allocation */
+	T_LLSSL_main();
+#endif
+#ifdef LLSEC_VALIDATION
+	/* Start the LLsec tests */
+	T_LLSEC_main();
+#endif
+#ifdef LLNET_VALIDATION
+	/* Start the LLnet benchmarks */
+	T_LLNET_main();
+#endif
 	return 0;
 #else
 
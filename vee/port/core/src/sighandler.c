@@ -40,6 +40,17 @@
 #include <unistd.h>
 
 #include "LLMJVM.h"
+#include "sighandler.h"
+
+/**
+ * @brief Maximum number of dump functions that can be registered for the SIGUSR1 signal.
+ */
+#ifndef MICROEJ_USR1_SIGNAL_MAX_DUMPS
+#define MICROEJ_USR1_SIGNAL_MAX_DUMPS (4)
+#endif
+
+/** @brief Dump functions executed after the MicroEJ Core Engine dump on SIGUSR1. */
+static microej_signal_dump_t microej_usr1_signal_dumps[MICROEJ_USR1_SIGNAL_MAX_DUMPS];
 
 /* This structure mirrors the one found in /usr/include/asm/ucontext.h */
 typedef struct _sig_ucontext {
@@ -109,6 +120,11 @@ static void crit_err_hdlr(int sig_num, siginfo_t * info, void * ucontext)
 static void microej_core_engine_dump_hdlr(int sig_num, siginfo_t * info, void * ucontext){
 
 	LLMJVM_dump();
+
+	for (int i = 0; i < MICROEJ_USR1_SIGNAL_MAX_DUMPS && microej_usr1_signal_dumps[i] != NULL; ++i)
+	{
+		microej_usr1_signal_dumps[i]();
+	}
 }
 
 static void microej_signal_handler_init(int signum, void (*handler)(int, siginfo_t *, void *))
@@ -136,6 +152,23 @@ void microej_usr1_signal_handler_init(void)
 	microej_signal_handler_init(SIGUSR1, microej_core_engine_dump_hdlr);
 }
 
+int microej_usr1_signal_register_dump(microej_signal_dump_t dump)
+{
+	for (int i = 0; i < MICROEJ_USR1_SIGNAL_MAX_DUMPS; ++i)
+	{
+		if (microej_usr1_signal_dumps[i] == dump)
+		{
+			return 0;
+		}
+		if (microej_usr1_signal_dumps[i] == NULL)
+		{
+			microej_usr1_signal_dumps[i] = dump;
+			return 0;
+		}
+	}
+	return -1;
+}
+
 #ifdef __cplusplus
 	}
 #endif
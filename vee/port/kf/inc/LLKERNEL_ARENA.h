@@ -0,0 +1,82 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/**
+ * @file
+ * @brief LLKERNEL Feature arena.
+ *
+ * The areas of the Features that are not in the store are allocated from a region of LLKERNEL_ARENA_SIZE bytes of
+ * virtual address space, reserved on first use, instead of the process heap: the Features are not mixed with other
+ * allocations, and the memory of an uninstalled Feature is given back to the system.
+ *
+ * The arena is a buddy allocator: a block is a power of two from LLKERNEL_ARENA_MIN_BLOCK_SIZE, aligned on its size,
+ * so the ROM area alignment is met without padding. Freed blocks are merged with their free buddy.
+ *
+ * With the Feature store (LLKERNEL_STORE.h), the arena only holds the Features allocated when the store is full or
+ * unavailable.
+ *
+ * @author MicroEJ Development Team
+ * @version 3.0.0
+ */
+
+#ifndef LLKERNEL_ARENA_H
+#define LLKERNEL_ARENA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Arena statistics, see LLKERNEL_ARENA_get_stats().
+ */
+typedef struct {
+	uint32_t size; // reserved size
+	uint32_t allocated_size; // size of the allocated blocks
+	uint32_t requested_size; // size requested for the allocated blocks, the rest is lost to rounding
+	uint32_t free_size; // size of the free blocks
+	uint32_t largest_free_block; // size of the largest allocation that can succeed
+	uint32_t nb_free_blocks;
+	uint32_t nb_allocated_blocks;
+	uint32_t nb_failed_allocations; // allocations failed since the arena was reserved
+	uint32_t fragmentation; // free space not in the largest free block, in percent of the free space
+} LLKERNEL_ARENA_stats;
+
+/**
+ * @brief Reserves the arena, once.
+ *
+ * @return true if the arena can be used, false if the address space cannot be reserved.
+ */
+bool LLKERNEL_ARENA_open(void);
+
+/**
+ * @brief Allocates a block, aligned on LLKERNEL_ROM_AREA_ALIGNMENT at least.
+ *
+ * @return the block, NULL if no free block is large enough.
+ */
+void * LLKERNEL_ARENA_allocate(int32_t size);
+
+/**
+ * @brief Frees a block, and releases its pages.
+ *
+ * @param[in] block the block returned by LLKERNEL_ARENA_allocate().
+ * @param[in] size the size given to LLKERNEL_ARENA_allocate().
+ */
+void LLKERNEL_ARENA_free(void *block, int32_t size);
+
+/**
+ * @brief Gets the free space and fragmentation statistics of the arena.
+ */
+void LLKERNEL_ARENA_get_stats(LLKERNEL_ARENA_stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LLKERNEL_ARENA_H
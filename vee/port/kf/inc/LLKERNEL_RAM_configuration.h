@@ -34,6 +34,95 @@
 #endif
 // #define KERNEL_RAM_IMPL_BESTFIT
 
+/**
+ * @brief Set to 1 to keep the installed Features across restarts (see LLKERNEL_STORE.h): their ROM areas are stored
+ * in a file mapped at a fixed address. Only with KERNEL_RAM_IMPL_MALLOC. If the file cannot be mapped, the Features
+ * are allocated with KERNEL_MALLOC() and lost on restart.
+ */
+#ifndef LLKERNEL_STORE_ENABLED
+#ifdef KERNEL_RAM_IMPL_MALLOC
+#define LLKERNEL_STORE_ENABLED 1
+#else
+#define LLKERNEL_STORE_ENABLED 0
+#endif
+#endif
+
+/**
+ * @brief Path of the Feature store file, replaced at run time by the LLKERNEL_STORE environment variable.
+ */
+#ifndef LLKERNEL_STORE_PATH
+#define LLKERNEL_STORE_PATH "microej_features.store"
+#endif
+
+/**
+ * @brief Fixed address and size of the mapping of the Feature store file, holding the ROM areas. The installed
+ * Features are linked at these addresses: changing them discards the stored Features.
+ */
+#ifndef LLKERNEL_STORE_ROM_ADDRESS
+#define LLKERNEL_STORE_ROM_ADDRESS 0x60000000u
+#endif
+#ifndef LLKERNEL_STORE_ROM_SIZE
+#define LLKERNEL_STORE_ROM_SIZE (64u * 1024u * 1024u)
+#endif
+
+/**
+ * @brief Fixed address and size of the RAM areas of the stored Features. They are not saved, only their addresses
+ * are kept across restarts.
+ */
+#ifndef LLKERNEL_STORE_RAM_ADDRESS
+#define LLKERNEL_STORE_RAM_ADDRESS (LLKERNEL_STORE_ROM_ADDRESS + LLKERNEL_STORE_ROM_SIZE)
+#endif
+#ifndef LLKERNEL_STORE_RAM_SIZE
+#define LLKERNEL_STORE_RAM_SIZE (16u * 1024u * 1024u)
+#endif
+
+/**
+ * @brief Maximum number of Features in the store.
+ */
+#ifndef LLKERNEL_STORE_MAX_FEATURES
+#define LLKERNEL_STORE_MAX_FEATURES 64
+#endif
+
+/**
+ * @brief Set to 1 to allocate the Features that are not in the store from a dedicated arena (see LLKERNEL_ARENA.h),
+ * instead of the process heap. Only with KERNEL_RAM_IMPL_MALLOC. If the arena cannot be reserved, the Features are
+ * allocated with KERNEL_MALLOC().
+ *
+ * With LLKERNEL_STORE_ENABLED (the default), the ROM and RAM areas of the Features are in the store mappings: the
+ * arena only holds the Features that do not fit in the store, or all of them if the store file is unavailable. It
+ * takes no memory until then.
+ */
+#ifndef LLKERNEL_ARENA_ENABLED
+#ifdef KERNEL_RAM_IMPL_MALLOC
+#define LLKERNEL_ARENA_ENABLED 1
+#else
+#define LLKERNEL_ARENA_ENABLED 0
+#endif
+#endif
+
+/**
+ * @brief Size of the virtual address space reserved for the arena, a power of two. Pages are only used once written.
+ */
+#ifndef LLKERNEL_ARENA_SIZE
+#define LLKERNEL_ARENA_SIZE (64u * 1024u * 1024u)
+#endif
+
+/**
+ * @brief Smallest block of the arena, a power of two at least LLKERNEL_ROM_AREA_ALIGNMENT. A Feature takes a block of
+ * the power of two above the size of its areas.
+ */
+#ifndef LLKERNEL_ARENA_MIN_BLOCK_SIZE
+#define LLKERNEL_ARENA_MIN_BLOCK_SIZE 256u
+#endif
+
+/**
+ * @brief Blocks of the arena from this size are backed by transparent huge pages, if the system enables them with
+ * madvise. Set to 0 to always use normal pages.
+ */
+#ifndef LLKERNEL_ARENA_HUGE_PAGE_THRESHOLD
+#define LLKERNEL_ARENA_HUGE_PAGE_THRESHOLD 0u
+#endif
+
 /**
  * @brief Uncomment this macro to set {@link #LLKERNEL_MAX_NB_DYNAMIC_FEATURES}
  * value to a custom value.
@@ -0,0 +1,96 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/**
+ * @file
+ * @brief LLKERNEL persistent Feature store.
+ *
+ * The ROM areas of the installed Features are stored in a file (LLKERNEL_STORE_PATH), mapped read-only and shared at
+ * LLKERNEL_STORE_ROM_ADDRESS. The Features are written to the file by LLKERNEL_IMPL_copyToROM() and committed to the
+ * storage by LLKERNEL_IMPL_flushCopyToROM(). On restart, the file is mapped again at the same address: the installed
+ * Features are available without copy or re-link, the pages are read on demand.
+ *
+ * The file starts with a table of the Features (install order, offsets and sizes of their ROM and RAM areas). The
+ * RAM areas are allocated at the same offsets of an anonymous mapping at LLKERNEL_STORE_RAM_ADDRESS.
+ *
+ * A Feature is marked committed in the table only once its ROM area is on the storage. A Feature whose install was
+ * interrupted before LLKERNEL_IMPL_flushCopyToROM() (crash, power loss) is removed when the store is opened again.
+ *
+ * @author MicroEJ Development Team
+ * @version 3.0.0
+ */
+
+#ifndef LLKERNEL_STORE_H
+#define LLKERNEL_STORE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Opens and maps the store file, once. The file is reset if it does not match the configuration, and the
+ * Features not committed are removed.
+ *
+ * @return true if the store can be used, false if the file cannot be opened or mapped at its address.
+ */
+bool LLKERNEL_STORE_open(void);
+
+/**
+ * @brief Unmaps and closes the store file. The Features not committed are removed on the next open, and the RAM areas
+ * are released. The next LLKERNEL_STORE_open() maps the file again, at the same addresses.
+ */
+void LLKERNEL_STORE_close(void);
+
+/**
+ * @brief Gets the stored Features, in install order.
+ *
+ * @param[out] slots the slots of the stored Features.
+ * @param[in] max_slots the size of slots.
+ * @return the number of stored Features.
+ */
+int32_t LLKERNEL_STORE_get_slots(int32_t *slots, int32_t max_slots);
+
+/**
+ * @brief Gets the ROM and RAM areas of a stored Feature.
+ */
+void LLKERNEL_STORE_get_areas(int32_t slot, void **ROM_area, int32_t *ROM_area_size, void **RAM_area,
+                              int32_t *RAM_area_size);
+
+/**
+ * @brief Allocates the ROM and RAM areas of a new Feature, after the ones already stored.
+ *
+ * @return the slot of the Feature, -1 if the store is full.
+ */
+int32_t LLKERNEL_STORE_allocate(int32_t size_ROM, int32_t size_RAM);
+
+/**
+ * @brief Removes a Feature from the store and releases the memory of its areas.
+ */
+void LLKERNEL_STORE_free(int32_t slot);
+
+/**
+ * @brief Writes to the ROM area of a stored Feature. The destination must be in the area.
+ *
+ * @return LLKERNEL_OK on success, LLKERNEL_ERROR on error.
+ */
+int32_t LLKERNEL_STORE_write(void *dest_address_ROM, const void *src_address, int32_t size);
+
+/**
+ * @brief Commits the written ROM areas to the storage, then marks the allocated Features committed.
+ *
+ * @return LLKERNEL_OK on success, LLKERNEL_ERROR on error.
+ */
+int32_t LLKERNEL_STORE_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LLKERNEL_STORE_H
@@ -0,0 +1,264 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/**
+ * @file
+ * @brief LLKERNEL Feature arena implementation.
+ * @author MicroEJ Development Team
+ * @version 3.0.0
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "LLKERNEL_RAM.h"
+#include "LLKERNEL_ARENA.h"
+#include "LLKERNEL_impl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if LLKERNEL_ARENA_ENABLED == 1
+
+#if (0u == LLKERNEL_ARENA_SIZE) || (0u != (LLKERNEL_ARENA_SIZE & (LLKERNEL_ARENA_SIZE - 1u)))
+#error "LLKERNEL_ARENA_SIZE must be a power of two"
+#endif
+#if (0u == LLKERNEL_ARENA_MIN_BLOCK_SIZE) || \
+	(0u != (LLKERNEL_ARENA_MIN_BLOCK_SIZE & (LLKERNEL_ARENA_MIN_BLOCK_SIZE - 1u)))
+#error "LLKERNEL_ARENA_MIN_BLOCK_SIZE must be a power of two"
+#endif
+#if (LLKERNEL_ARENA_MIN_BLOCK_SIZE < LLKERNEL_ROM_AREA_ALIGNMENT) || (LLKERNEL_ARENA_MIN_BLOCK_SIZE > LLKERNEL_ARENA_SIZE)
+#error "LLKERNEL_ARENA_MIN_BLOCK_SIZE must be between LLKERNEL_ROM_AREA_ALIGNMENT and LLKERNEL_ARENA_SIZE"
+#endif
+
+// Alignment of the arena, so that the blocks from this size can be backed by huge pages
+#define LLKERNEL_ARENA_ALIGNMENT (2u * 1024u * 1024u)
+
+#define LLKERNEL_ARENA_MAX_ORDERS 32
+
+// Start of a free block, in the list of the free blocks of its order
+typedef struct free_block {
+	struct free_block *next;
+	struct free_block *prev;
+} free_block_t;
+
+static bool arena_opened = false;
+static bool arena_failed = false;
+static uintptr_t arena_base;
+static size_t page_size;
+static int32_t nb_orders; // a block of order k has LLKERNEL_ARENA_MIN_BLOCK_SIZE << k bytes
+static free_block_t *free_lists[LLKERNEL_ARENA_MAX_ORDERS];
+
+// One bit per block of each order, set when the block is free. The bits of order k start at map_offsets[k]
+static uint8_t *free_map;
+static uint32_t map_offsets[LLKERNEL_ARENA_MAX_ORDERS];
+
+static LLKERNEL_ARENA_stats stats;
+
+static uint32_t _block_size(int32_t order) {
+	return LLKERNEL_ARENA_MIN_BLOCK_SIZE << order;
+}
+
+static uint32_t _map_bit(int32_t order, uintptr_t offset) {
+	return map_offsets[order] + (uint32_t)(offset / _block_size(order));
+}
+
+static bool _is_free(int32_t order, uintptr_t offset) {
+	uint32_t bit = _map_bit(order, offset);
+	return 0u != (free_map[bit / 8u] & (1u << (bit % 8u)));
+}
+
+static void _push(int32_t order, uintptr_t offset) {
+	free_block_t *block = (free_block_t *)(arena_base + offset);
+	block->next = free_lists[order];
+	block->prev = NULL;
+	if (NULL != block->next) {
+		block->next->prev = block;
+	}
+	free_lists[order] = block;
+
+	uint32_t bit = _map_bit(order, offset);
+	free_map[bit / 8u] |= (uint8_t)(1u << (bit % 8u));
+	stats.free_size += _block_size(order);
+	stats.nb_free_blocks++;
+}
+
+static void _remove(int32_t order, uintptr_t offset) {
+	free_block_t *block = (free_block_t *)(arena_base + offset);
+	if (NULL != block->prev) {
+		block->prev->next = block->next;
+	} else {
+		free_lists[order] = block->next;
+	}
+	if (NULL != block->next) {
+		block->next->prev = block->prev;
+	}
+
+	uint32_t bit = _map_bit(order, offset);
+	free_map[bit / 8u] &= (uint8_t)~(1u << (bit % 8u));
+	stats.free_size -= _block_size(order);
+	stats.nb_free_blocks--;
+}
+
+// Gets the order of the smallest block of the given size, nb_orders if it is too large
+static int32_t _order(int32_t size) {
+	int32_t order = 0;
+	while ((order < nb_orders) && (_block_size(order) < (uint32_t)size)) {
+		order++;
+	}
+	return order;
+}
+
+static uint32_t _largest_free_block(void) {
+	uint32_t size = 0;
+	for (int32_t order = nb_orders - 1; order >= 0; order--) {
+		if (NULL != free_lists[order]) {
+			size = _block_size(order);
+			break;
+		}
+	}
+	return size;
+}
+
+// Gives the pages inside a free block back to the system, they read as zero when used again
+static void _release_pages(uintptr_t address, uint32_t size) {
+	uintptr_t start = (address + page_size - 1u) & ~(uintptr_t)(page_size - 1u);
+	uintptr_t end = (address + size) & ~(uintptr_t)(page_size - 1u);
+	if (start < end) {
+		(void)madvise((void *)start, end - start, MADV_DONTNEED);
+	}
+}
+
+bool LLKERNEL_ARENA_open(void) {
+	if (!arena_opened && !arena_failed) {
+		page_size = (size_t)sysconf(_SC_PAGESIZE);
+		nb_orders = 1;
+		while ((nb_orders < LLKERNEL_ARENA_MAX_ORDERS) && (_block_size(nb_orders - 1) < LLKERNEL_ARENA_SIZE)) {
+			nb_orders++;
+		}
+		uint32_t map_bits = 0;
+		for (int32_t order = 0; order < nb_orders; order++) {
+			map_offsets[order] = map_bits;
+			map_bits += LLKERNEL_ARENA_SIZE / _block_size(order);
+		}
+		free_map = (uint8_t *)KERNEL_MALLOC((map_bits + 7u) / 8u);
+
+		// Reserve more than the arena to align it, the pages are only allocated when written
+		size_t reserved_size = (size_t)LLKERNEL_ARENA_SIZE + LLKERNEL_ARENA_ALIGNMENT;
+		void *reserved = MAP_FAILED;
+		if (NULL != free_map) {
+			(void)memset(free_map, 0, (map_bits + 7u) / 8u);
+			reserved = mmap(NULL, reserved_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+			                -1, 0);
+		}
+
+		if (MAP_FAILED == reserved) {
+			LLKERNEL_WARNING_LOG("Cannot reserve the Feature arena (errno=%d), the Features are allocated in the heap\n",
+			                     errno);
+			KERNEL_FREE(free_map);
+			free_map = NULL;
+			arena_failed = true;
+		} else {
+			uintptr_t start = (uintptr_t)reserved;
+			arena_base = (start + LLKERNEL_ARENA_ALIGNMENT - 1u) & ~(uintptr_t)(LLKERNEL_ARENA_ALIGNMENT - 1u);
+			if (arena_base > start) {
+				(void)munmap(reserved, arena_base - start);
+			}
+			uintptr_t arena_end = arena_base + LLKERNEL_ARENA_SIZE;
+			if ((start + reserved_size) > arena_end) {
+				(void)munmap((void *)arena_end, (start + reserved_size) - arena_end);
+			}
+
+			stats.size = LLKERNEL_ARENA_SIZE;
+			_push(nb_orders - 1, 0);
+			arena_opened = true;
+			LLKERNEL_INFO_LOG("Feature arena reserved at 0x%.8x (%u bytes)\n", (unsigned int)arena_base,
+			                  (unsigned int)LLKERNEL_ARENA_SIZE);
+		}
+	}
+	return arena_opened;
+}
+
+void * LLKERNEL_ARENA_allocate(int32_t size) {
+	void *result = NULL;
+	int32_t order = (0 <= size) ? _order(size) : nb_orders;
+
+	// Smallest free block large enough
+	int32_t free_order = order;
+	while ((free_order < nb_orders) && (NULL == free_lists[free_order])) {
+		free_order++;
+	}
+
+	if (free_order >= nb_orders) {
+		stats.nb_failed_allocations++;
+		LLKERNEL_WARNING_LOG("Feature arena full (%d bytes requested, largest free block %u bytes)\n", (int)size,
+		                     (unsigned int)_largest_free_block());
+	} else {
+		uintptr_t offset = (uintptr_t)free_lists[free_order] - arena_base;
+		_remove(free_order, offset);
+
+		// Split the block, its upper halves become free
+		while (free_order > order) {
+			free_order--;
+			_push(free_order, offset + _block_size(free_order));
+		}
+
+		result = (void *)(arena_base + offset);
+		stats.allocated_size += _block_size(order);
+		stats.requested_size += (uint32_t)size;
+		stats.nb_allocated_blocks++;
+#if defined(MADV_HUGEPAGE) && (LLKERNEL_ARENA_HUGE_PAGE_THRESHOLD > 0u)
+		if (_block_size(order) >= LLKERNEL_ARENA_HUGE_PAGE_THRESHOLD) {
+			(void)madvise(result, _block_size(order), MADV_HUGEPAGE);
+		}
+#endif
+	}
+	return result;
+}
+
+void LLKERNEL_ARENA_free(void *block, int32_t size) {
+	uintptr_t offset = (uintptr_t)block - arena_base;
+	int32_t order = _order(size);
+
+	if (!arena_opened || ((uintptr_t)block < arena_base) || (offset >= LLKERNEL_ARENA_SIZE) ||
+	    (order >= nb_orders) || (0u != (offset % _block_size(order)))) {
+		LLKERNEL_ERROR_LOG("Feature arena free issue (block=0x%.8x, size=%d)\n", (unsigned int)block, (int)size);
+	} else {
+		_release_pages((uintptr_t)block, _block_size(order));
+		stats.allocated_size -= _block_size(order);
+		stats.requested_size -= (uint32_t)size;
+		stats.nb_allocated_blocks--;
+
+		// Merge with the free buddies
+		while ((order < (nb_orders - 1)) && _is_free(order, offset ^ _block_size(order))) {
+			_remove(order, offset ^ _block_size(order));
+			offset &= ~(uintptr_t)_block_size(order);
+			order++;
+		}
+		_push(order, offset);
+	}
+}
+
+void LLKERNEL_ARENA_get_stats(LLKERNEL_ARENA_stats *arena_stats) {
+	*arena_stats = stats;
+	arena_stats->largest_free_block = _largest_free_block();
+	arena_stats->fragmentation = 0;
+	if (0u != stats.free_size) {
+		arena_stats->fragmentation = (uint32_t)((((uint64_t)stats.free_size - arena_stats->largest_free_block) * 100u) /
+		                                        stats.free_size);
+	}
+}
+
+#endif // LLKERNEL_ARENA_ENABLED == 1
+
+#ifdef __cplusplus
+}
+#endif
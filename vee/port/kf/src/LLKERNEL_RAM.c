@@ -17,6 +17,8 @@
 #include <stdbool.h>
 
 #include "LLKERNEL_RAM.h"
+#include "LLKERNEL_ARENA.h"
+#include "LLKERNEL_STORE.h"
 #include "LLKERNEL_impl.h"
 
 #ifdef __cplusplus
@@ -25,6 +27,7 @@ extern "C" {
 
 // Utility macros for allocating RAM and ROM areas with required alignment constraints
 #define KERNEL_AREA_GET_MAX_SIZE(size, alignment) ((size) + ((alignment) - 1))
+#define KERNEL_AREA_GET_ALIGNED_SIZE(size, alignment) (((size) + ((alignment) - 1)) & ~((alignment) - 1))
 #define KERNEL_AREA_GET_START_ADDRESS(addr, \
 									  alignment) ((void *)((((int32_t)(addr)) + (alignment) - 1) & ~((alignment) - 1)))
 
@@ -33,13 +36,28 @@ typedef struct installed_feature {
 	void *RAM_area;
 	int32_t ROM_area_size;
 	int32_t RAM_area_size;
-	struct installed_feature *next;
+	int32_t store_slot; // slot in the Feature store, -1 if the areas are in block
+	void *block; // allocated block holding the areas, NULL for a stored feature
+	int32_t arena_size; // size of block in the arena, 0 if block is allocated with KERNEL_MALLOC()
+	int32_t install_index; // index in installed_features, -1 if the descriptor is free
 } installed_feature_t;
 
-static installed_feature_t *first_installed_feature = NULL;
+/*
+ * Feature registry, allocated once for LLKERNEL_MAX_NB_DYNAMIC_FEATURES features:
+ * - a feature handle is the address of its descriptor in feature_descriptors, so it is checked without any search;
+ * - installed_features gives the handle of an allocation index;
+ * - ROM_index is sorted by ROM area address, to find the destination feature of copyToROM() by binary search.
+ */
+static installed_feature_t *feature_descriptors = NULL;
+static installed_feature_t **installed_features = NULL;
+static installed_feature_t **ROM_index = NULL;
+static int32_t registry_capacity = 0;
 
 static int32_t nb_allocated_features = 0;
 
+// Feature of the last copyToROM(): a feature is copied by consecutive chunks
+static installed_feature_t *last_copy_feature = NULL;
+
 static const char *_error_code_to_str(uint32_t error_code) {
 	const char *str = "";
 	switch (error_code) {
@@ -75,20 +93,16 @@ static const char *_error_code_to_str(uint32_t error_code) {
 }
 
 static int8_t _is_valid_feature_handle(installed_feature_t *handle) {
-	installed_feature_t *ptr_feature = first_installed_feature;
-	uint8_t found = 0;
-
-	while (NULL != ptr_feature) {
-		if (ptr_feature == handle) {
-			// Feature handle is the first feature in the list
-			found = 1;
-			break;
-		} else {
-			// Go to the next feature
-			ptr_feature = ptr_feature->next;
+	int8_t valid = 0;
+	if (NULL != feature_descriptors) {
+		uintptr_t offset = (uintptr_t)handle - (uintptr_t)feature_descriptors;
+		if (((uintptr_t)handle >= (uintptr_t)feature_descriptors) &&
+		    (offset < ((uintptr_t)registry_capacity * sizeof(installed_feature_t))) &&
+		    (0u == (offset % sizeof(installed_feature_t))) && (0 <= handle->install_index)) {
+			valid = 1;
 		}
 	}
-	return found;
+	return valid;
 }
 
 #ifdef KERNEL_RAM_IMPL_BESTFIT
@@ -113,77 +127,238 @@ void * BESTFIT_ALLOCATOR_allocate_with_check(int32_t size) {
 
 #endif // KERNEL_RAM_IMPL_BESTFIT
 
-int32_t LLKERNEL_IMPL_allocateFeature(int32_t size_ROM, int32_t size_RAM) {
-	LLKERNEL_DEBUG_LOG("%s(%d, %d)\n", __func__, size_ROM, size_RAM);
-	int32_t ret = 0;
+/**
+ * @brief Allocates the feature registry with KERNEL_MALLOC() on first use, so after
+ * LLKERNEL_RAM_BESTFIT_initialize() with KERNEL_RAM_IMPL_BESTFIT.
+ */
+static bool _registry_initialize(void) {
+	if ((NULL == feature_descriptors) && (0 < LLKERNEL_MAX_NB_DYNAMIC_FEATURES)) {
+		int32_t capacity = LLKERNEL_MAX_NB_DYNAMIC_FEATURES;
+		int32_t size = capacity * (int32_t)(sizeof(installed_feature_t) + (2u * sizeof(installed_feature_t *)));
+		void *registry = KERNEL_MALLOC(size);
+		if (NULL == registry) {
+			LLKERNEL_ERROR_LOG("Out of memory, feature registry not allocated\n");
+		} else {
+			feature_descriptors = (installed_feature_t *)registry;
+			installed_features = (installed_feature_t **)&feature_descriptors[capacity];
+			ROM_index = &installed_features[capacity];
+			for (int32_t i = 0; i < capacity; i++) {
+				feature_descriptors[i].install_index = -1;
+			}
+			registry_capacity = capacity;
+		}
+	}
+	return NULL != feature_descriptors;
+}
 
-	if (nb_allocated_features == LLKERNEL_MAX_NB_DYNAMIC_FEATURES) {
-		LLKERNEL_WARNING_LOG("Max number of dynamic features installed reached\n");
-	} else {
-		int total_size = sizeof(struct installed_feature);
-		total_size += KERNEL_AREA_GET_MAX_SIZE(size_ROM, LLKERNEL_ROM_AREA_ALIGNMENT);
-		total_size += KERNEL_AREA_GET_MAX_SIZE(size_RAM, LLKERNEL_RAM_AREA_ALIGNMENT);
-
-		installed_feature_t *total_area = (installed_feature_t *)KERNEL_MALLOC(total_size);
-		if (NULL != total_area) {
-			// Add new allocated feature at the end of the installed features list
-			installed_feature_t *f = (installed_feature_t *)total_area;
-			if (NULL == first_installed_feature) {
-				first_installed_feature = f;
-			} else {
-				installed_feature_t *ptr_feature = first_installed_feature;
-				while (NULL != ptr_feature->next) {
-					ptr_feature = ptr_feature->next;
+/**
+ * @brief Gets the position of the first feature of ROM_index whose ROM area starts after the given address.
+ */
+static int32_t _ROM_index_upper_bound(uintptr_t address) {
+	int32_t low = 0;
+	int32_t high = nb_allocated_features;
+	while (low < high) {
+		int32_t middle = low + ((high - low) / 2);
+		if ((uintptr_t)ROM_index[middle]->ROM_area <= address) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+	return low;
+}
+
+/**
+ * @brief Gets a free descriptor, NULL if LLKERNEL_MAX_NB_DYNAMIC_FEATURES features are installed.
+ */
+static installed_feature_t * _new_feature(void) {
+	installed_feature_t *f = NULL;
+	if (_registry_initialize() && (nb_allocated_features < registry_capacity)) {
+		for (int32_t i = 0; i < registry_capacity; i++) {
+			if (0 > feature_descriptors[i].install_index) {
+				f = &feature_descriptors[i];
+				break;
+			}
+		}
+	}
+	return f;
+}
+
+/**
+ * @brief Adds a feature with its areas set at the end of the installed features.
+ */
+static void _append_feature(installed_feature_t *f) {
+	int32_t position = _ROM_index_upper_bound((uintptr_t)f->ROM_area);
+	// cppcheck-suppress [misra-c2012-17.7] no need to check memmove return value here
+	memmove(&ROM_index[position + 1], &ROM_index[position],
+	        (size_t)(nb_allocated_features - position) * sizeof(installed_feature_t *));
+	ROM_index[position] = f;
+
+	f->install_index = nb_allocated_features;
+	installed_features[nb_allocated_features] = f;
+	++nb_allocated_features;
+}
+
+/**
+ * @brief Removes an installed feature, the next features keep their install order.
+ */
+static void _remove_feature(installed_feature_t *f) {
+	int32_t position = _ROM_index_upper_bound((uintptr_t)f->ROM_area) - 1;
+	while (ROM_index[position] != f) {
+		// Features with the same ROM area address (empty areas)
+		--position;
+	}
+	// cppcheck-suppress [misra-c2012-17.7] no need to check memmove return value here
+	memmove(&ROM_index[position], &ROM_index[position + 1],
+	        (size_t)(nb_allocated_features - position - 1) * sizeof(installed_feature_t *));
+
+	for (int32_t i = f->install_index + 1; i < nb_allocated_features; i++) {
+		installed_features[i - 1] = installed_features[i];
+		installed_features[i - 1]->install_index = i - 1;
+	}
+	--nb_allocated_features;
+	f->install_index = -1;
+	if (last_copy_feature == f) {
+		last_copy_feature = NULL;
+	}
+}
+
+/**
+ * @brief Adds the Features of the store to the installed features list, once. Their areas are in the mapped store
+ * file: nothing is read or copied.
+ */
+static void _load_store(void) {
+#if LLKERNEL_STORE_ENABLED == 1
+	static bool store_loaded = false;
+	if (!store_loaded) {
+		store_loaded = true;
+		if (LLKERNEL_STORE_open()) {
+			int32_t slots[LLKERNEL_STORE_MAX_FEATURES];
+			int32_t count = LLKERNEL_STORE_get_slots(slots, LLKERNEL_STORE_MAX_FEATURES);
+			for (int32_t i = 0; i < count; i++) {
+				installed_feature_t *f = _new_feature();
+				if (NULL == f) {
+					LLKERNEL_ERROR_LOG("Too many stored features, %d not loaded\n", (int)(count - i));
+					break;
 				}
-				ptr_feature->next = f;
+				LLKERNEL_STORE_get_areas(slots[i], &f->ROM_area, &f->ROM_area_size, &f->RAM_area, &f->RAM_area_size);
+				f->store_slot = slots[i];
+				f->block = NULL;
+				f->arena_size = 0;
+				_append_feature(f);
 			}
+			LLKERNEL_INFO_LOG("%d stored feature(s) loaded\n", (int)count);
+		}
+	}
+#endif // LLKERNEL_STORE_ENABLED == 1
+}
 
-			++nb_allocated_features;
+static void _log_arena_stats(void) {
+#if (LLKERNEL_ARENA_ENABLED == 1) && (LLKERNEL_LOG_INFO >= LLKERNEL_LOG_LEVEL)
+	LLKERNEL_ARENA_stats stats;
+	LLKERNEL_ARENA_get_stats(&stats);
+	LLKERNEL_INFO_LOG("Feature arena: %u/%u bytes allocated (%u requested), %u bytes free in %u blocks, "
+	                  "largest %u bytes, fragmentation %u%%\n", (unsigned int)stats.allocated_size,
+	                  (unsigned int)stats.size, (unsigned int)stats.requested_size, (unsigned int)stats.free_size,
+	                  (unsigned int)stats.nb_free_blocks, (unsigned int)stats.largest_free_block,
+	                  (unsigned int)stats.fragmentation);
+#endif
+}
 
-			// Initialize new feature
-			f->ROM_area = KERNEL_AREA_GET_START_ADDRESS((void *)(((int32_t)f) + ((int32_t)sizeof(installed_feature_t))),
-			                                            LLKERNEL_ROM_AREA_ALIGNMENT);
+static bool _allocate_areas(installed_feature_t *f, int32_t size_ROM, int32_t size_RAM) {
+	bool allocated = false;
+
+#if LLKERNEL_STORE_ENABLED == 1
+	if (LLKERNEL_STORE_open()) {
+		int32_t slot = LLKERNEL_STORE_allocate(size_ROM, size_RAM);
+		if (0 <= slot) {
+			LLKERNEL_STORE_get_areas(slot, &f->ROM_area, &f->ROM_area_size, &f->RAM_area, &f->RAM_area_size);
+			f->store_slot = slot;
+			f->block = NULL;
+			f->arena_size = 0;
+			allocated = true;
+		} else {
+			LLKERNEL_WARNING_LOG("Feature not kept across restarts, allocated in memory\n");
+		}
+	}
+#endif // LLKERNEL_STORE_ENABLED == 1
+
+	if (!allocated) {
+		void *block = NULL;
+		int32_t arena_size = 0;
+		bool use_arena = false;
+#if LLKERNEL_ARENA_ENABLED == 1
+		use_arena = LLKERNEL_ARENA_open();
+		if (use_arena) {
+			// The arena blocks are aligned on LLKERNEL_ROM_AREA_ALIGNMENT, only the RAM area needs padding.
+			// An empty Feature still takes a block
+			arena_size = KERNEL_AREA_GET_ALIGNED_SIZE(size_ROM, LLKERNEL_RAM_AREA_ALIGNMENT) + size_RAM;
+			if (0 == arena_size) {
+				arena_size = 1;
+			}
+			block = LLKERNEL_ARENA_allocate(arena_size);
+			_log_arena_stats();
+		}
+#endif // LLKERNEL_ARENA_ENABLED == 1
+		if (!use_arena) {
+			block = KERNEL_MALLOC(KERNEL_AREA_GET_MAX_SIZE(size_ROM, LLKERNEL_ROM_AREA_ALIGNMENT) +
+			                      KERNEL_AREA_GET_MAX_SIZE(size_RAM, LLKERNEL_RAM_AREA_ALIGNMENT));
+		}
+		if (NULL != block) {
+			f->ROM_area = KERNEL_AREA_GET_START_ADDRESS(block, LLKERNEL_ROM_AREA_ALIGNMENT);
 			f->ROM_area_size = size_ROM;
 			f->RAM_area = KERNEL_AREA_GET_START_ADDRESS((void *)(((int32_t)f->ROM_area) + size_ROM),
 			                                            LLKERNEL_RAM_AREA_ALIGNMENT);
 			f->RAM_area_size = size_RAM;
-			f->next = NULL;
-			ret = (int32_t)f;
+			f->store_slot = -1;
+			f->block = block;
+			f->arena_size = arena_size;
+			allocated = true;
 		}
 		// else Out of memory
 	}
+	return allocated;
+}
+
+int32_t LLKERNEL_IMPL_allocateFeature(int32_t size_ROM, int32_t size_RAM) {
+	LLKERNEL_DEBUG_LOG("%s(%d, %d)\n", __func__, size_ROM, size_RAM);
+	int32_t ret = 0;
+
+	_load_store();
+	installed_feature_t *f = _new_feature();
+	if (NULL == f) {
+		LLKERNEL_WARNING_LOG("Max number of dynamic features installed reached\n");
+	} else if (_allocate_areas(f, size_ROM, size_RAM)) {
+		_append_feature(f);
+		ret = (int32_t)f;
+	} else {
+		// Out of memory, the descriptor stays free
+	}
 	return ret;
 }
 
 void LLKERNEL_IMPL_freeFeature(int32_t handle) {
 	LLKERNEL_DEBUG_LOG("%s(0x%.8x)\n", __func__, handle);
 
-	// Remove installed feature from the installed features list
 	installed_feature_t *remove_feature = (installed_feature_t *)handle;
-	installed_feature_t *ptr_feature = first_installed_feature;
-	if (NULL == first_installed_feature) {
+	if (0 == nb_allocated_features) {
 		LLKERNEL_ERROR_LOG("Feature free issue (no feature installed)\n");
+	} else if (0 == _is_valid_feature_handle(remove_feature)) {
+		LLKERNEL_ERROR_LOG("Feature free issue (feature not found)\n");
 	} else {
-		if (remove_feature == first_installed_feature) {
-			// Feature to remove is the first one in the installed features list.
-			first_installed_feature = remove_feature->next;
-			--nb_allocated_features;
-		} else {
-			// Search feature in the installed features list and remove it
-			while (NULL != ptr_feature->next) {
-				if (ptr_feature->next == remove_feature) {
-					// Feature to remove found in the installed features list. Now remove it from the list.
-					ptr_feature->next = remove_feature->next;
-					--nb_allocated_features;
-					break;
-				}
-				ptr_feature = ptr_feature->next;
-			}
-			if (ptr_feature->next != remove_feature->next) {
-				LLKERNEL_ERROR_LOG("Feature free issue (feature not found)\n");
-			} else {
-				KERNEL_FREE((void *)handle);
-			}
+		_remove_feature(remove_feature);
+#if LLKERNEL_STORE_ENABLED == 1
+		if (0 <= remove_feature->store_slot) {
+			LLKERNEL_STORE_free(remove_feature->store_slot);
+		}
+#endif
+		if (0 < remove_feature->arena_size) {
+#if LLKERNEL_ARENA_ENABLED == 1
+			LLKERNEL_ARENA_free(remove_feature->block, remove_feature->arena_size);
+			_log_arena_stats();
+#endif // LLKERNEL_ARENA_ENABLED == 1
+		} else if (NULL != remove_feature->block) {
+			KERNEL_FREE(remove_feature->block);
 		}
 	}
 }
@@ -191,6 +366,7 @@ void LLKERNEL_IMPL_freeFeature(int32_t handle) {
 // cppcheck-suppress [misra-c2012-5.5] Macro name is configured in VEE Port headers.
 int32_t LLKERNEL_IMPL_getAllocatedFeaturesCount(void) {
 	LLKERNEL_DEBUG_LOG("%s()\n", __func__);
+	_load_store();
 	LLKERNEL_INFO_LOG("%d feature(s) allocated\n", nb_allocated_features);
 	return nb_allocated_features;
 }
@@ -199,18 +375,12 @@ int32_t LLKERNEL_IMPL_getFeatureHandle(int32_t allocation_index) {
 	LLKERNEL_DEBUG_LOG("%s(%d)\n", __func__, allocation_index);
 	int32_t ret = 0;
 
-	installed_feature_t *ptr_feature = first_installed_feature;
-	int32_t tmp_index = 0;
-	while ((tmp_index != allocation_index) && (NULL != ptr_feature) && (NULL != ptr_feature->next)) {
-		++tmp_index;
-		ptr_feature = ptr_feature->next;
-	}
-
-	if ((tmp_index != allocation_index) || (NULL == ptr_feature)) {
+	_load_store();
+	if ((0 > allocation_index) || (allocation_index >= nb_allocated_features)) {
 		// Allocation index not in range of allocated features count
 		LLKERNEL_ERROR_LOG("No feature found at index (allocation_index=%d)\n", allocation_index);
 	} else {
-		ret = (int32_t)ptr_feature;
+		ret = (int32_t)installed_features[allocation_index];
 	}
 	return ret;
 }
@@ -241,6 +411,16 @@ void * LLKERNEL_IMPL_getFeatureAddressROM(int32_t handle) {
 	return ret;
 }
 
+static bool _is_in_ROM_area(installed_feature_t *f, void *address, int32_t size) {
+	bool in_area = false;
+	if (NULL != f) {
+		uintptr_t ROM_area_end = ((uintptr_t)f->ROM_area) + ((uintptr_t)f->ROM_area_size);
+		in_area = (size <= f->ROM_area_size) && (((uintptr_t)address) >= ((uintptr_t)f->ROM_area)) &&
+		          (((uintptr_t)address) < ROM_area_end) && ((((uintptr_t)address) + ((uintptr_t)size)) <= ROM_area_end);
+	}
+	return in_area;
+}
+
 int32_t LLKERNEL_IMPL_copyToROM(void *dest_address_ROM, void *src_address, int32_t size) {
 	LLKERNEL_DEBUG_LOG("%s(0x%.8x, 0x%.8x, %d)\n", __func__, (unsigned int)dest_address_ROM, (unsigned int)src_address,
 	                   size);
@@ -250,27 +430,33 @@ int32_t LLKERNEL_IMPL_copyToROM(void *dest_address_ROM, void *src_address, int32
 	if ((NULL == dest_address_ROM) || (NULL == src_address) || (size < 0)) {
 		LLKERNEL_ERROR_LOG("Wrong parameters passed\n");
 	} else {
-		// Check that copy to ROM area match an allocated installed feature ROM area
-		installed_feature_t *ptr_feature = first_installed_feature;
-		do{
-			uint32_t ptr_feature_ROM_area_end = ((uint32_t)ptr_feature->ROM_area) +
-			                                    ((uint32_t)ptr_feature->ROM_area_size);
-			if ((size <= ptr_feature->ROM_area_size) &&
-			    (((uint32_t)dest_address_ROM) >= ((uint32_t)ptr_feature->ROM_area)) &&
-			    (((uint32_t)dest_address_ROM) < ptr_feature_ROM_area_end) &&
-			    (((uint32_t)dest_address_ROM + ((uint32_t)size)) <= ptr_feature_ROM_area_end)) {
-				// ROM destination address match an allocated installed feature ROM area
-				// cppcheck-suppress [misra-c2012-17.7] no need to check memcpy return value here
-				memcpy(dest_address_ROM, src_address, size);
-				break;
+		// Check that copy to ROM area match an allocated installed feature ROM area: the last one, else the one with
+		// the closest ROM area address below the destination
+		installed_feature_t *ptr_feature = NULL;
+		if (_is_in_ROM_area(last_copy_feature, dest_address_ROM, size)) {
+			ptr_feature = last_copy_feature;
+		} else {
+			int32_t position = _ROM_index_upper_bound((uintptr_t)dest_address_ROM);
+			if ((0 < position) && _is_in_ROM_area(ROM_index[position - 1], dest_address_ROM, size)) {
+				ptr_feature = ROM_index[position - 1];
 			}
-			ptr_feature = ptr_feature->next;
-		} while (NULL != ptr_feature);
+		}
 
 		if (NULL == ptr_feature) {
 			LLKERNEL_ERROR_LOG("ROM destination address do not match LLKERNEL installed feature ROM area\n");
 		} else {
-			ret = LLKERNEL_OK;
+			// ROM destination address match an allocated installed feature ROM area
+			last_copy_feature = ptr_feature;
+			if (0 > ptr_feature->store_slot) {
+				// cppcheck-suppress [misra-c2012-17.7] no need to check memcpy return value here
+				memcpy(dest_address_ROM, src_address, size);
+				ret = LLKERNEL_OK;
+			} else {
+#if LLKERNEL_STORE_ENABLED == 1
+				// The ROM area is a read-only mapping of the store file, write to the file
+				ret = LLKERNEL_STORE_write(dest_address_ROM, src_address, size);
+#endif
+			}
 		}
 	}
 	return ret;
@@ -279,8 +465,14 @@ int32_t LLKERNEL_IMPL_copyToROM(void *dest_address_ROM, void *src_address, int32
 // cppcheck-suppress [misra-c2012-5.5] Macro name is configured in VEE Port headers.
 int32_t LLKERNEL_IMPL_flushCopyToROM(void) {
 	LLKERNEL_DEBUG_LOG("%s()\n", __func__);
-	// Nothing to do here, flush already done
-	return LLKERNEL_OK;
+	int32_t ret = LLKERNEL_OK;
+#if LLKERNEL_STORE_ENABLED == 1
+	// Commit the stored features, the other ones are already in place
+	if (LLKERNEL_STORE_open()) {
+		ret = LLKERNEL_STORE_flush();
+	}
+#endif
+	return ret;
 }
 
 int32_t LLKERNEL_IMPL_onFeatureInitializationError(int32_t handle, int32_t error_code) {
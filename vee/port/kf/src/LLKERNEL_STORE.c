@@ -0,0 +1,442 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/**
+ * @file
+ * @brief LLKERNEL persistent Feature store implementation.
+ * @author MicroEJ Development Team
+ * @version 3.0.0
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "LLKERNEL_RAM.h"
+#include "LLKERNEL_STORE.h"
+#include "LLKERNEL_impl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if LLKERNEL_STORE_ENABLED == 1
+
+#define LLKERNEL_STORE_MAGIC   0x3153464B // "KFS1"
+#define LLKERNEL_STORE_VERSION 2
+
+typedef struct {
+	uint32_t sequence; // install order, 0 for a free slot
+	uint32_t committed; // 1 once the content of the Feature is on the storage, 0 while it is installed
+	uint32_t ROM_offset; // from the start of the file
+	uint32_t ROM_size;
+	uint32_t RAM_offset; // from LLKERNEL_STORE_RAM_ADDRESS
+	uint32_t RAM_size;
+} LLKERNEL_STORE_record;
+
+// Start of the file. The ROM areas follow, from the next page
+typedef struct {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t ROM_address;
+	uint32_t ROM_size;
+	uint32_t RAM_address;
+	uint32_t RAM_size;
+	uint32_t max_features;
+	uint32_t last_sequence;
+	LLKERNEL_STORE_record records[LLKERNEL_STORE_MAX_FEATURES];
+} LLKERNEL_STORE_header;
+
+typedef struct {
+	uint32_t offset;
+	uint32_t size;
+} LLKERNEL_STORE_range;
+
+static bool store_opened = false;
+static bool store_failed = false;
+static int store_fd = -1;
+static size_t page_size;
+static uint32_t data_offset; // offset of the first ROM area in the file
+static const LLKERNEL_STORE_header *header; // in the read-only mapping, updated with pwrite()
+
+// Range of the file written since the last flush
+static uint32_t dirty_start = UINT32_MAX;
+static uint32_t dirty_end = 0;
+
+static uint32_t _align(uint32_t value, uint32_t alignment) {
+	return (value + (alignment - 1u)) & ~(alignment - 1u);
+}
+
+static bool _write_file(const void *data, size_t size, uint32_t offset) {
+	const uint8_t *ptr = (const uint8_t *)data;
+	bool ok = true;
+	while (ok && (0u < size)) {
+		ssize_t written = pwrite(store_fd, ptr, size, (off_t)offset);
+		if (0 < written) {
+			ptr += written;
+			size -= (size_t)written;
+			offset += (uint32_t)written;
+		} else if ((0 > written) && (EINTR == errno)) {
+			// Interrupted, try again
+		} else {
+			LLKERNEL_ERROR_LOG("Cannot write the Feature store (errno=%d)\n", errno);
+			ok = false;
+		}
+	}
+	return ok;
+}
+
+static bool _write_record(int32_t slot, const LLKERNEL_STORE_record *record) {
+	return _write_file(record, sizeof(LLKERNEL_STORE_record),
+	                   (uint32_t)(offsetof(LLKERNEL_STORE_header, records) + ((size_t)slot * sizeof(LLKERNEL_STORE_record))));
+}
+
+static bool _is_valid_header(void) {
+	bool valid = (LLKERNEL_STORE_MAGIC == header->magic) && (LLKERNEL_STORE_VERSION == header->version) &&
+	             (LLKERNEL_STORE_ROM_ADDRESS == header->ROM_address) && (LLKERNEL_STORE_ROM_SIZE == header->ROM_size) &&
+	             (LLKERNEL_STORE_RAM_ADDRESS == header->RAM_address) && (LLKERNEL_STORE_RAM_SIZE == header->RAM_size) &&
+	             (LLKERNEL_STORE_MAX_FEATURES == header->max_features);
+	for (int32_t i = 0; valid && (i < LLKERNEL_STORE_MAX_FEATURES); i++) {
+		const LLKERNEL_STORE_record *record = &header->records[i];
+		if (0u != record->sequence) {
+			valid = (record->ROM_offset >= data_offset) && (record->ROM_size <= LLKERNEL_STORE_ROM_SIZE) &&
+			        (record->ROM_offset <= (LLKERNEL_STORE_ROM_SIZE - record->ROM_size)) &&
+			        (record->RAM_size <= LLKERNEL_STORE_RAM_SIZE) &&
+			        (record->RAM_offset <= (LLKERNEL_STORE_RAM_SIZE - record->RAM_size)) &&
+			        (record->sequence <= header->last_sequence);
+		}
+	}
+	return valid;
+}
+
+// Releases the pages entirely in a range
+static void _release_pages(uintptr_t address, uint32_t size, bool ROM) {
+	uintptr_t start = (address + page_size - 1u) & ~(uintptr_t)(page_size - 1u);
+	uintptr_t end = (address + size) & ~(uintptr_t)(page_size - 1u);
+	if (start < end) {
+		if (ROM) {
+			(void)fallocate(store_fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+			                (off_t)(start - LLKERNEL_STORE_ROM_ADDRESS), (off_t)(end - start));
+		} else {
+			(void)madvise((void *)start, end - start, MADV_DONTNEED);
+		}
+	}
+}
+
+// Removes a Feature from the table and releases its areas
+static bool _remove_record(int32_t slot) {
+	LLKERNEL_STORE_record record = header->records[slot];
+	LLKERNEL_STORE_record empty;
+	(void)memset(&empty, 0, sizeof(empty));
+	bool ok = _write_record(slot, &empty);
+	_release_pages(LLKERNEL_STORE_ROM_ADDRESS + record.ROM_offset, record.ROM_size, true);
+	_release_pages(LLKERNEL_STORE_RAM_ADDRESS + record.RAM_offset, record.RAM_size, false);
+	return ok;
+}
+
+// Removes the Features whose install was interrupted before LLKERNEL_STORE_flush(), their content may be partial
+static bool _remove_uncommitted(void) {
+	bool ok = true;
+	bool removed = false;
+	for (int32_t i = 0; ok && (i < LLKERNEL_STORE_MAX_FEATURES); i++) {
+		const LLKERNEL_STORE_record *record = &header->records[i];
+		if ((0u != record->sequence) && (0u == record->committed)) {
+			LLKERNEL_WARNING_LOG("Feature %u of the store not committed, removed\n", (unsigned int)record->sequence);
+			ok = _remove_record(i);
+			removed = true;
+		}
+	}
+	if (ok && removed) {
+		ok = (0 == fdatasync(store_fd));
+	}
+	return ok;
+}
+
+// Discards the content of the file and writes an empty Feature table
+static bool _format(void) {
+	LLKERNEL_STORE_header empty;
+	(void)memset(&empty, 0, sizeof(empty));
+	empty.magic = LLKERNEL_STORE_MAGIC;
+	empty.version = LLKERNEL_STORE_VERSION;
+	empty.ROM_address = LLKERNEL_STORE_ROM_ADDRESS;
+	empty.ROM_size = LLKERNEL_STORE_ROM_SIZE;
+	empty.RAM_address = LLKERNEL_STORE_RAM_ADDRESS;
+	empty.RAM_size = LLKERNEL_STORE_RAM_SIZE;
+	empty.max_features = LLKERNEL_STORE_MAX_FEATURES;
+
+	bool ok = (0 == ftruncate(store_fd, 0)) && (0 == ftruncate(store_fd, (off_t)LLKERNEL_STORE_ROM_SIZE)) &&
+	          _write_file(&empty, sizeof(empty), 0) && (0 == fdatasync(store_fd));
+	if (!ok) {
+		LLKERNEL_ERROR_LOG("Cannot format the Feature store (errno=%d)\n", errno);
+	}
+	return ok;
+}
+
+// Maps a region at its fixed address, without replacing an existing mapping
+static void * _map_fixed(uintptr_t address, size_t size, int prot, int flags, int fd) {
+	void *area = mmap((void *)address, size, prot, flags, fd, 0);
+	if (MAP_FAILED == area) {
+		LLKERNEL_ERROR_LOG("Cannot map the Feature store at 0x%.8x (errno=%d)\n", (unsigned int)address, errno);
+		area = NULL;
+	} else if ((uintptr_t)area != address) {
+		// The address is already used by the process
+		LLKERNEL_ERROR_LOG("Cannot map the Feature store at 0x%.8x (address in use)\n", (unsigned int)address);
+		(void)munmap(area, size);
+		area = NULL;
+	} else {
+		// Mapped at the requested address
+	}
+	return area;
+}
+
+bool LLKERNEL_STORE_open(void) {
+	if (!store_opened && !store_failed) {
+		const char *path = getenv("LLKERNEL_STORE");
+		if (NULL == path) {
+			path = LLKERNEL_STORE_PATH;
+		}
+		page_size = (size_t)sysconf(_SC_PAGESIZE);
+		data_offset = _align((uint32_t)sizeof(LLKERNEL_STORE_header), (uint32_t)page_size);
+
+		struct stat st;
+		void *ROM = NULL;
+		void *RAM = NULL;
+		store_fd = open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+		bool ok = (0 <= store_fd) && (0 == fstat(store_fd, &st));
+		if (ok && (st.st_size != (off_t)LLKERNEL_STORE_ROM_SIZE)) {
+			// New file, or sized for another configuration: mapped pages must exist
+			ok = _format();
+		}
+		if (ok) {
+			ROM = _map_fixed(LLKERNEL_STORE_ROM_ADDRESS, LLKERNEL_STORE_ROM_SIZE, PROT_READ, MAP_SHARED, store_fd);
+			RAM = _map_fixed(LLKERNEL_STORE_RAM_ADDRESS, LLKERNEL_STORE_RAM_SIZE, PROT_READ | PROT_WRITE,
+			                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1);
+			ok = (NULL != ROM) && (NULL != RAM);
+		}
+		if (ok) {
+			header = (const LLKERNEL_STORE_header *)ROM;
+			if (!_is_valid_header()) {
+				LLKERNEL_WARNING_LOG("Feature store %s reset (other configuration or corrupted)\n", path);
+				// The shared mapping shows the formatted file
+				ok = _format();
+			} else {
+				ok = _remove_uncommitted();
+			}
+		}
+
+		if (ok) {
+			store_opened = true;
+			LLKERNEL_INFO_LOG("Feature store %s mapped at 0x%.8x\n", path, (unsigned int)LLKERNEL_STORE_ROM_ADDRESS);
+		} else {
+			LLKERNEL_WARNING_LOG("Feature store %s unavailable, the Features are not kept across restarts\n", path);
+			store_failed = true;
+			if (NULL != ROM) {
+				(void)munmap(ROM, LLKERNEL_STORE_ROM_SIZE);
+			}
+			if (NULL != RAM) {
+				(void)munmap(RAM, LLKERNEL_STORE_RAM_SIZE);
+			}
+			if (0 <= store_fd) {
+				(void)close(store_fd);
+				store_fd = -1;
+			}
+		}
+	}
+	return store_opened;
+}
+
+void LLKERNEL_STORE_close(void) {
+	if (store_opened) {
+		(void)munmap((void *)(uintptr_t)LLKERNEL_STORE_ROM_ADDRESS, LLKERNEL_STORE_ROM_SIZE);
+		(void)munmap((void *)(uintptr_t)LLKERNEL_STORE_RAM_ADDRESS, LLKERNEL_STORE_RAM_SIZE);
+		(void)close(store_fd);
+		store_fd = -1;
+		header = NULL;
+		dirty_start = UINT32_MAX;
+		dirty_end = 0;
+		store_opened = false;
+	}
+	store_failed = false;
+}
+
+int32_t LLKERNEL_STORE_get_slots(int32_t *slots, int32_t max_slots) {
+	int32_t ordered[LLKERNEL_STORE_MAX_FEATURES];
+	int32_t count = 0;
+	for (int32_t i = 0; i < LLKERNEL_STORE_MAX_FEATURES; i++) {
+		uint32_t sequence = header->records[i].sequence;
+		if (0u != sequence) {
+			// Insertion in install order
+			int32_t j = count;
+			while ((j > 0) && (header->records[ordered[j - 1]].sequence > sequence)) {
+				ordered[j] = ordered[j - 1];
+				j--;
+			}
+			ordered[j] = i;
+			count++;
+		}
+	}
+	if (count > max_slots) {
+		count = max_slots;
+	}
+	(void)memcpy(slots, ordered, (size_t)count * sizeof(int32_t));
+	return count;
+}
+
+void LLKERNEL_STORE_get_areas(int32_t slot, void **ROM_area, int32_t *ROM_area_size, void **RAM_area,
+                              int32_t *RAM_area_size) {
+	const LLKERNEL_STORE_record *record = &header->records[slot];
+	*ROM_area = (void *)(uintptr_t)(LLKERNEL_STORE_ROM_ADDRESS + record->ROM_offset);
+	*ROM_area_size = (int32_t)record->ROM_size;
+	*RAM_area = (void *)(uintptr_t)(LLKERNEL_STORE_RAM_ADDRESS + record->RAM_offset);
+	*RAM_area_size = (int32_t)record->RAM_size;
+}
+
+// Finds the first free range of an address space: the used ranges are sorted by offset, then the gaps are scanned
+static bool _find_free_range(bool ROM, uint32_t start, uint32_t end, uint32_t size, uint32_t alignment,
+                             uint32_t *offset) {
+	LLKERNEL_STORE_range used[LLKERNEL_STORE_MAX_FEATURES];
+	int32_t count = 0;
+	for (int32_t i = 0; i < LLKERNEL_STORE_MAX_FEATURES; i++) {
+		const LLKERNEL_STORE_record *record = &header->records[i];
+		if (0u != record->sequence) {
+			LLKERNEL_STORE_range range;
+			range.offset = ROM ? record->ROM_offset : record->RAM_offset;
+			range.size = ROM ? record->ROM_size : record->RAM_size;
+			if (0u == range.size) {
+				// Empty areas have distinct addresses too
+				range.size = 1;
+			}
+			int32_t j = count;
+			while ((j > 0) && (used[j - 1].offset > range.offset)) {
+				used[j] = used[j - 1];
+				j--;
+			}
+			used[j] = range;
+			count++;
+		}
+	}
+
+	if (0u == size) {
+		size = 1;
+	}
+	uint64_t candidate = _align(start, alignment);
+	for (int32_t i = 0; i < count; i++) {
+		if ((candidate + size) <= used[i].offset) {
+			break;
+		}
+		uint64_t used_end = _align(used[i].offset + used[i].size, alignment);
+		if (used_end > candidate) {
+			candidate = used_end;
+		}
+	}
+	bool found = (candidate + size) <= end;
+	if (found) {
+		*offset = (uint32_t)candidate;
+	}
+	return found;
+}
+
+int32_t LLKERNEL_STORE_allocate(int32_t size_ROM, int32_t size_RAM) {
+	int32_t slot = -1;
+	if ((0 <= size_ROM) && (0 <= size_RAM)) {
+		for (int32_t i = 0; i < LLKERNEL_STORE_MAX_FEATURES; i++) {
+			if (0u == header->records[i].sequence) {
+				slot = i;
+				break;
+			}
+		}
+	}
+
+	if (0 <= slot) {
+		LLKERNEL_STORE_record record;
+		record.ROM_size = (uint32_t)size_ROM;
+		record.RAM_size = (uint32_t)size_RAM;
+		if (_find_free_range(true, data_offset, LLKERNEL_STORE_ROM_SIZE, record.ROM_size, LLKERNEL_ROM_AREA_ALIGNMENT,
+		                     &record.ROM_offset) &&
+		    _find_free_range(false, 0, LLKERNEL_STORE_RAM_SIZE, record.RAM_size, LLKERNEL_RAM_AREA_ALIGNMENT,
+		                     &record.RAM_offset)) {
+			uint32_t sequence = header->last_sequence + 1u;
+			record.sequence = sequence;
+			// Committed once the Feature content is on the storage, by LLKERNEL_STORE_flush()
+			record.committed = 0;
+			if (!_write_file(&sequence, sizeof(sequence), (uint32_t)offsetof(LLKERNEL_STORE_header, last_sequence)) ||
+			    !_write_record(slot, &record)) {
+				slot = -1;
+			}
+		} else {
+			LLKERNEL_WARNING_LOG("Feature store full\n");
+			slot = -1;
+		}
+	}
+	return slot;
+}
+
+void LLKERNEL_STORE_free(int32_t slot) {
+	// Committed now, an uninstalled Feature must not come back on restart
+	if (_remove_record(slot) && (0 != fdatasync(store_fd))) {
+		LLKERNEL_ERROR_LOG("Cannot commit the Feature store (errno=%d)\n", errno);
+	}
+}
+
+int32_t LLKERNEL_STORE_write(void *dest_address_ROM, const void *src_address, int32_t size) {
+	int32_t ret = LLKERNEL_ERROR;
+	uint32_t offset = (uint32_t)((uintptr_t)dest_address_ROM - LLKERNEL_STORE_ROM_ADDRESS);
+	// The read-only mapping shows the written data, it is shared with the file
+	if (_write_file(src_address, (size_t)size, offset)) {
+		if (offset < dirty_start) {
+			dirty_start = offset;
+		}
+		if ((offset + (uint32_t)size) > dirty_end) {
+			dirty_end = offset + (uint32_t)size;
+		}
+		ret = LLKERNEL_OK;
+	}
+	return ret;
+}
+
+int32_t LLKERNEL_STORE_flush(void) {
+	int32_t ret = LLKERNEL_OK;
+	uint8_t *ROM = (uint8_t *)(uintptr_t)LLKERNEL_STORE_ROM_ADDRESS;
+	// Feature content first, then the Feature table that marks it committed
+	if (dirty_start < dirty_end) {
+		uint32_t start = dirty_start & ~(uint32_t)(page_size - 1u);
+		if (0 != msync(ROM + start, dirty_end - start, MS_SYNC)) {
+			ret = LLKERNEL_ERROR;
+		}
+	}
+	for (int32_t i = 0; (LLKERNEL_OK == ret) && (i < LLKERNEL_STORE_MAX_FEATURES); i++) {
+		LLKERNEL_STORE_record record = header->records[i];
+		if ((0u != record.sequence) && (0u == record.committed)) {
+			record.committed = 1;
+			if (!_write_record(i, &record)) {
+				ret = LLKERNEL_ERROR;
+			}
+		}
+	}
+	if ((LLKERNEL_OK == ret) && (0 != msync(ROM, data_offset, MS_SYNC))) {
+		ret = LLKERNEL_ERROR;
+	}
+	if (LLKERNEL_OK == ret) {
+		dirty_start = UINT32_MAX;
+		dirty_end = 0;
+	}
+	if (LLKERNEL_OK != ret) {
+		LLKERNEL_ERROR_LOG("Cannot commit the Feature store (errno=%d)\n", errno);
+	}
+	return ret;
+}
+
+#endif // LLKERNEL_STORE_ENABLED == 1
+
+#ifdef __cplusplus
+}
+#endif
@@ -25,7 +25,7 @@
  * This value must not be changed by the user of the CCO.
  * This value must be incremented by the implementor of the CCO when a configuration define is added, deleted or modified.
  */
-#define LLNET_LINUX_CONFIGURATION_VERSION (1)
+#define LLNET_LINUX_CONFIGURATION_VERSION (2)
 
 /**
  * Maximum length plus one for the interface name string.
@@ -33,4 +33,150 @@
  */
 #define IFADDRNAMEMAX (10)
 
+/**
+ * @brief Maximum number of network links (interfaces) stored in the network interface cache.
+ */
+#define NETIF_CACHE_MAX_LINKS (16)
+
+/**
+ * @brief Maximum number of IP addresses (all interfaces) stored in the network interface cache.
+ */
+#define NETIF_CACHE_MAX_ADDRESSES (32)
+
+/**
+ * @brief Maximum length in bytes of a hardware address stored in the network interface cache.
+ */
+#define NETIF_CACHE_HW_ADDR_MAX_LENGTH (8)
+
+/**
+ * @brief Size in bytes of the buffers used to receive netlink messages.
+ */
+#define NETIF_CACHE_NETLINK_BUFFER_SIZE (8192)
+
+/**
+ * @brief Network interface cache listener task stack size in bytes.
+ */
+#define NETIF_CACHE_TASK_STACK_SIZE (1024*16)
+
+/**
+ * @brief Network interface cache listener task name.
+ */
+#define NETIF_CACHE_TASK_NAME	((uint8_t*)"NetifCache")
+
+/**
+ * @brief Network interface cache listener task priority.
+ */
+#define NETIF_CACHE_TASK_PRIORITY	(12)
+
+/**
+ * @brief Network interface cache mutex name.
+ */
+#define NETIF_CACHE_MUTEX_NAME	((uint8_t*)"NetifCacheMutex")
+
+/**
+ * @brief Set this define to race the connections to multi-address hosts (RFC 8305 "Happy Eyeballs").
+ * When a socket connects to an address returned by a recent host name resolution, non-blocking connections
+ * to the other addresses of this host are started in a staggered way and the first one to complete wins.
+ * Comment this define to connect to the requested address only.
+ */
+#define LLNET_USE_CONNECT_RACER
+
+/**
+ * @brief Delay in milliseconds before starting the next connection attempt of a race
+ * (RFC 8305 "Connection Attempt Delay"). The next attempt starts immediately if the previous one fails.
+ */
+#define CONNECT_RACER_ATTEMPT_DELAY_MS (250)
+
+/**
+ * @brief Maximum number of connection attempts of a race.
+ */
+#define CONNECT_RACER_MAX_ATTEMPTS (4)
+
+/**
+ * @brief Maximum number of races in progress at the same time. Connections are not raced when all the races are in use.
+ */
+#define CONNECT_RACER_MAX_RACES (4)
+
+/**
+ * @brief Number of host name resolutions remembered to find the alternative addresses of a host.
+ */
+#define CONNECT_RACER_RESOLUTIONS_CACHE_SIZE (8)
+
+/**
+ * @brief Maximum number of addresses remembered per host name resolution.
+ */
+#define CONNECT_RACER_MAX_ADDRESSES (8)
+
+/**
+ * @brief Duration in milliseconds during which a host name resolution is used to find alternative addresses.
+ */
+#define CONNECT_RACER_RESOLUTION_LIFETIME_MS (30000)
+
+/**
+ * @brief TCP Fast Open queue length set on the listening sockets whose queue length has not been set with the
+ * LLNET_SOCKETOPTION_TCP_FASTOPEN option. Set to 0 to not enable TCP Fast Open by default on the listening sockets.
+ * The server side of TCP Fast Open must be enabled in the kernel (bit 1 of the net.ipv4.tcp_fastopen sysctl).
+ */
+#define LLNET_TCP_FASTOPEN_LISTEN_QUEUE_LENGTH (0)
+
+/**
+ * @brief Set to 1 to enable TCP_FASTOPEN_CONNECT by default on the client sockets: the first data written is then
+ * sent in the SYN when a Fast Open cookie is known for the peer. Connection errors are then reported by the first read or write.
+ * The client side of TCP Fast Open must be enabled in the kernel (bit 0 of the net.ipv4.tcp_fastopen sysctl).
+ */
+#define LLNET_TCP_FASTOPEN_CONNECT_DEFAULT (0)
+
+/**
+ * @brief Maximum number of listening sockets that can park accepted connections at the same time.
+ * The other listening sockets accept one connection per accept() call.
+ */
+#define ACCEPT_QUEUE_MAX_LISTENERS (4)
+
+/**
+ * @brief Maximum number of accepted connections parked per listening socket.
+ * When the Java thread accepts a connection, the backlog is drained and up to this number of extra connections
+ * are parked in a native queue to serve the next accept() calls without a syscall.
+ */
+#define ACCEPT_QUEUE_LENGTH (16)
+
+/**
+ * @brief Maximum number of sockets with the low-latency mode (LLNET_SOCKETOPTION_BUSY_POLL) enabled at the same time.
+ */
+#define BUSY_POLL_MAX_SOCKETS (8)
+
+/**
+ * @brief Maximum busy-poll budget in microseconds that can be set on a socket.
+ * While a socket busy-polls, the other Java threads are not scheduled.
+ */
+#define BUSY_POLL_MAX_BUDGET_US (500)
+
+/**
+ * @brief Maximum percentage of the time that can be spent busy-polling, all sockets included.
+ * Once reached, the sockets wait with async_select() until the end of the current window.
+ */
+#define BUSY_POLL_MAX_CPU_PERCENT (10)
+
+/**
+ * @brief Duration in microseconds of the window over which BUSY_POLL_MAX_CPU_PERCENT is enforced.
+ */
+#define BUSY_POLL_CPU_WINDOW_US (100000)
+
+/**
+ * @brief Maximum number of waits without busy-polling after busy-polling repeatedly missed the socket readiness.
+ */
+#define BUSY_POLL_MAX_BACKOFF (64)
+
+/**
+ * @brief Delay in milliseconds before retrying the connection of a Unix domain stream socket whose peer
+ * has a full backlog. Such a connection cannot be waited for with async_select().
+ */
+#define UNIX_SOCKET_CONNECT_RETRY_DELAY_MS (10)
+
+/**
+ * @brief Number of entries of the socket table, indexed by file descriptor.
+ * The sockets whose file descriptor is greater or equal are handled without cached state (async_select() uses
+ * select(), so the file descriptors are lower than FD_SETSIZE anyway).
+ */
+#define SOCKET_TABLE_SIZE (1024)
+
 #endif // LLNET_LINUX_CONFIGURATION_H
@@ -0,0 +1,78 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#ifndef  ACCEPT_QUEUE_H
+#define  ACCEPT_QUEUE_H
+
+/**
+ * @file
+ * @brief Batched accept of the stream socket channels.
+ *
+ * Each wakeup of a listening socket drains its backlog with accept4(SOCK_NONBLOCK|SOCK_CLOEXEC): the first
+ * connection is returned and the others are parked in a native queue that serves the next accept() calls.
+ *
+ * All the functions must be called from the VM task.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/** @brief Accept statistics identifiers. */
+typedef enum {
+	ACCEPT_STAT_ACCEPTED = 0, // connections accepted from the kernel
+	ACCEPT_STAT_QUEUED = 1, // connections parked in a native queue
+	ACCEPT_STAT_BATCHES = 2, // backlog drains that accepted more than one connection
+	ACCEPT_STAT_MAX_BATCH = 3, // maximum number of connections accepted in one drain
+	ACCEPT_STAT_RATE = 4, // connections accepted during the last elapsed second
+	ACCEPT_STAT_PEAK_RATE = 5, // maximum number of connections accepted in one second
+	ACCEPT_STATS_COUNT
+} accept_stat_t;
+
+#ifndef LLNET_ACCEPT_IMPL_getStatistic
+#define LLNET_ACCEPT_IMPL_getStatistic	Java_com_microej_net_AcceptStatistics_getStatistic
+#endif
+
+/**
+ * @brief Native: gets an accept statistic.
+ *
+ * @param[in] id the statistic identifier, one of accept_stat_t.
+ *
+ * @return the statistic value, or -1 if the identifier is unknown.
+ */
+int64_t LLNET_ACCEPT_IMPL_getStatistic(int32_t id);
+
+/**
+ * @brief Accepts a connection on the given listening socket, from its native queue if not empty, or else
+ * by draining its backlog.
+ *
+ * @param[in] fd the listening socket file descriptor.
+ *
+ * @return the non-blocking accepted socket file descriptor, or -1 on error with errno set
+ * (EAGAIN or EWOULDBLOCK if there is no pending connection).
+ */
+int32_t accept_queue_accept(int32_t fd);
+
+/**
+ * @brief Notifies that a socket has been closed.
+ * If it is a listening socket, its parked connections are closed.
+ *
+ * @param[in] fd the closed file descriptor.
+ */
+void accept_queue_notify_closed_fd(int32_t fd);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif // ACCEPT_QUEUE_H
@@ -0,0 +1,108 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#ifndef  BUSY_POLL_H
+#define  BUSY_POLL_H
+
+/**
+ * @file
+ * @brief Opt-in low-latency mode for the socket waits.
+ *
+ * When a read or write on a socket with the low-latency mode enabled would block, the socket is busy-polled for a
+ * short time before the Java thread is suspended with async_select(). If the socket becomes ready meanwhile, the
+ * operation is retried right away, saving the async_select task round trip.
+ *
+ * The busy-poll duration adapts to the recently observed readiness delays of the socket, busy-polling is backed off
+ * when it keeps missing, and the overall busy-poll time is capped to BUSY_POLL_MAX_CPU_PERCENT.
+ *
+ * The mode is enabled with the socket option <code>LLNET_SOCKETOPTION_BUSY_POLL</code>, whose value is the maximum
+ * busy-poll duration in microseconds (0 to disable). The kernel SO_BUSY_POLL and SO_PREFER_BUSY_POLL options are
+ * also requested on the socket; they require a driver with busy-poll support and may require CAP_NET_ADMIN.
+ *
+ * All the functions must be called from the VM task.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "async_select.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/** @brief Socket option: maximum busy-poll duration in microseconds before suspending, 0 to disable. */
+#define LLNET_SOCKETOPTION_BUSY_POLL	(0x10003)
+
+/** @brief Busy-poll statistics identifiers. */
+typedef enum {
+	BUSY_POLL_STAT_POLLS = 0, // busy-poll attempts
+	BUSY_POLL_STAT_HITS = 1, // busy-polls that saw the socket ready
+	BUSY_POLL_STAT_MISSES = 2, // busy-polls that ended with a suspend
+	BUSY_POLL_STAT_TIME_US = 3, // total time spent busy-polling
+	BUSY_POLL_STAT_CAPPED = 4, // waits not busy-polled because of the CPU cap
+	BUSY_POLL_STAT_BACKED_OFF = 5, // waits not busy-polled because of the back off
+	BUSY_POLL_STATS_COUNT
+} busy_poll_stat_t;
+
+#ifndef LLNET_BUSY_POLL_IMPL_getStatistic
+#define LLNET_BUSY_POLL_IMPL_getStatistic	Java_com_microej_net_BusyPoll_getStatistic
+#endif
+
+/**
+ * @brief Native: gets a busy-poll statistic.
+ *
+ * @param[in] id the statistic identifier, one of busy_poll_stat_t.
+ *
+ * @return the statistic value, or -1 if the identifier is unknown.
+ */
+int64_t LLNET_BUSY_POLL_IMPL_getStatistic(int32_t id);
+
+/**
+ * @brief Sets the busy-poll budget of a socket.
+ *
+ * @param[in] fd the socket file descriptor.
+ * @param[in] budget_us the maximum busy-poll duration in microseconds, 0 to disable.
+ *
+ * @return 0 on success, -1 if too many sockets have the low-latency mode enabled (errno set to ENOBUFS).
+ */
+int32_t busy_poll_set_budget(int32_t fd, int32_t budget_us);
+
+/**
+ * @brief Gets the busy-poll budget of a socket.
+ *
+ * @param[in] fd the socket file descriptor.
+ *
+ * @return the maximum busy-poll duration in microseconds, 0 if disabled.
+ */
+int32_t busy_poll_get_budget(int32_t fd);
+
+/**
+ * @brief Busy-polls a socket that is not ready for the given operation, if it has the low-latency mode enabled.
+ *
+ * @param[in] fd the socket file descriptor.
+ * @param[in] operation the operation to wait for.
+ *
+ * @return true if the socket became ready while busy-polling, false otherwise.
+ */
+bool busy_poll_wait(int32_t fd, select_operation operation);
+
+/**
+ * @brief Notifies that a socket has been closed: its low-latency mode is disabled.
+ *
+ * @param[in] fd the closed file descriptor.
+ */
+void busy_poll_notify_closed_fd(int32_t fd);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif // BUSY_POLL_H
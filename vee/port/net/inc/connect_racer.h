@@ -0,0 +1,74 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#ifndef  CONNECT_RACER_H
+#define  CONNECT_RACER_H
+
+/**
+ * @file
+ * @brief Connection racer for multi-address hosts (RFC 8305 "Happy Eyeballs").
+ *
+ * The Java connect() is called with a single address. To find the other addresses of the same host, the
+ * racer remembers the recent host name resolutions. When the connected address belongs to one of them,
+ * non-blocking connections to the other addresses are started every <code>CONNECT_RACER_ATTEMPT_DELAY_MS</code>,
+ * alternating the address families. All the attempts are monitored by async_select() through an epoll file
+ * descriptor; the first connection to complete is moved onto the Java socket file descriptor with dup2()
+ * and the other attempts are closed.
+ *
+ * All the functions must be called from the VM task.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include <stdint.h>
+#include <netdb.h>
+#include "LLNET_Common.h"
+#include "LLNET_linux_configuration.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/**
+ * @brief Remembers the addresses returned by a host name resolution.
+ *
+ * @param[in] hostname the null terminated resolved host name.
+ * @param[in] addrinfos the addresses returned by getaddrinfo().
+ */
+void connect_racer_record_resolution(const uint8_t* hostname, const struct addrinfo* addrinfos);
+
+/**
+ * @brief Connects the given socket, racing the other addresses of the host if the given address
+ * belongs to a recent host name resolution.
+ *
+ * On return, either the connection is established, or the current Java thread is suspended until the race
+ * ends, or a NativeIOException is thrown.
+ *
+ * @param[in] fd the non-blocking socket file descriptor.
+ * @param[in] sockaddr the requested address.
+ * @param[in] sockaddr_length the length of the requested address.
+ * @param[in] absolute_timeout_ms the absolute timeout in milliseconds or 0 if no timeout.
+ *
+ * @return 1 if the connection has been handled by the racer, 0 if it must be done with a simple connect().
+ */
+int32_t connect_racer_connect(int32_t fd, const union llnet_sockaddr* sockaddr, int32_t sockaddr_length, int64_t absolute_timeout_ms);
+
+/**
+ * @brief Notifies the racer that a socket has been closed.
+ * If a race is in progress on this socket, it is aborted.
+ *
+ * @param[in] fd the closed file descriptor.
+ */
+void connect_racer_notify_closed_fd(int32_t fd);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif // CONNECT_RACER_H
@@ -0,0 +1,127 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#ifndef  NET_STATS_H
+#define  NET_STATS_H
+
+/**
+ * @file
+ * @brief Network I/O statistics, per socket and global.
+ *
+ * The natives record their send and receive system calls, the operations that would have blocked, and the
+ * suspensions of the Java threads in async_select() with their wait times. The per-socket statistics are held
+ * by the socket table. The statistics are printed when SIGUSR1 signal is received.
+ *
+ * All the functions must be called from the VM task, except net_stats_dump().
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/**
+ * @brief Number of buckets of the wait time histograms.
+ * Bucket 0 counts the waits shorter than 128 us, bucket i (0 < i < 15) the waits in [64 << i, 128 << i[ us and
+ * bucket 15 the waits of 2.1 s or more.
+ */
+#define NET_STATS_WAIT_BUCKETS	(16)
+
+/** @brief Network statistics identifiers. */
+typedef enum {
+	NET_STAT_RECEIVE_CALLS = 0, // receive system calls
+	NET_STAT_SEND_CALLS = 1, // send system calls
+	NET_STAT_BYTES_RECEIVED = 2,
+	NET_STAT_BYTES_SENT = 3,
+	NET_STAT_DATAGRAMS_RECEIVED = 4,
+	NET_STAT_DATAGRAMS_SENT = 5,
+	NET_STAT_EAGAIN = 6, // operations that returned EAGAIN or EWOULDBLOCK
+	NET_STAT_SUSPENDS = 7, // Java threads suspended in async_select()
+	NET_STAT_RESUMES = 8, // Java threads resumed from async_select()
+	NET_STAT_WAIT_TIME_US = 9, // total time spent suspended in async_select()
+	NET_STAT_MAX_WAIT_TIME_US = 10, // longest time spent suspended in async_select()
+	NET_STAT_WAIT_HISTOGRAM = 11, // first bucket of the wait time histogram
+	NET_STATS_COUNT = NET_STAT_WAIT_HISTOGRAM + NET_STATS_WAIT_BUCKETS
+} net_stat_t;
+
+#ifndef LLNET_STATS_IMPL_getStatistic
+#define LLNET_STATS_IMPL_getStatistic	Java_com_microej_net_NetStatistics_getStatistic
+#endif
+
+/**
+ * @brief Native: gets a network statistic.
+ *
+ * @param[in] fd the socket file descriptor, or -1 for the global statistic.
+ * @param[in] id the statistic identifier, one of net_stat_t (NET_STAT_WAIT_HISTOGRAM + n for the bucket n).
+ *
+ * @return the statistic value, or -1 if the identifier is unknown or the socket is not in the socket table.
+ */
+int64_t LLNET_STATS_IMPL_getStatistic(int32_t fd, int32_t id);
+
+/**
+ * @brief Initializes the statistics and registers their SIGUSR1 dump.
+ */
+void net_stats_init(void);
+
+/**
+ * @brief Records a receive system call.
+ *
+ * @param[in] fd the socket file descriptor.
+ * @param[in] result the system call result: the received length, or -1 on error.
+ * @param[in] datagram true if a datagram socket.
+ */
+void net_stats_on_receive(int32_t fd, int32_t result, bool datagram);
+
+/**
+ * @brief Records a send system call.
+ *
+ * @param[in] fd the socket file descriptor.
+ * @param[in] result the system call result: the sent length, or -1 on error.
+ * @param[in] datagram true if a datagram socket.
+ */
+void net_stats_on_send(int32_t fd, int32_t result, bool datagram);
+
+/**
+ * @brief Records an operation that returned EAGAIN or EWOULDBLOCK.
+ *
+ * @param[in] fd the socket file descriptor.
+ */
+void net_stats_on_eagain(int32_t fd);
+
+/**
+ * @brief Records the suspension of a Java thread in async_select().
+ *
+ * @param[in] fd the socket file descriptor.
+ *
+ * @return the suspension time in microseconds, to give to net_stats_on_resume().
+ */
+int64_t net_stats_on_suspend(int32_t fd);
+
+/**
+ * @brief Records the resumption of a Java thread suspended in async_select().
+ *
+ * @param[in] fd the socket file descriptor.
+ * @param[in] suspend_time_us the time returned by net_stats_on_suspend().
+ */
+void net_stats_on_resume(int32_t fd, int64_t suspend_time_us);
+
+/**
+ * @brief Prints the global statistics on the standard output.
+ */
+void net_stats_dump(void);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif // NET_STATS_H
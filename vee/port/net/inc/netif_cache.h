@@ -0,0 +1,138 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#ifndef  NETIF_CACHE_H
+#define  NETIF_CACHE_H
+
+/**
+ * @file
+ * @brief Network interface information cache API.
+ *
+ * The cache holds a snapshot of the network links and of their IP addresses. It is populated once with a
+ * NETLINK_ROUTE dump and then kept up to date by a task listening to the RTMGRP_LINK, RTMGRP_IPV4_IFADDR and
+ * RTMGRP_IPV6_IFADDR notifications, so that the LLNET_NETWORKINTERFACE natives are served from memory.
+ *
+ * Only the addresses of the families enabled by <code>LLNET_AF</code> are stored.
+ * All the getters copy the requested entry into the caller structure so that it can be used without holding the cache lock.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include <stdint.h>
+#include <net/if.h>
+#include "LLNET_linux_configuration.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/** @brief A network link (interface) entry. */
+typedef struct {
+	int32_t index; // interface index (if_nametoindex())
+	char name[IF_NAMESIZE]; // interface name, null terminated
+	uint32_t flags; // IFF_* flags
+	int32_t mtu; // MTU, 0 if unknown
+	uint16_t hw_type; // ARPHRD_* type
+	uint8_t hw_addr_length; // length of hw_addr, 0 if no hardware address
+	uint8_t hw_addr[NETIF_CACHE_HW_ADDR_MAX_LENGTH]; // hardware address
+} netif_cache_link_t;
+
+/** @brief An IP address entry. */
+typedef struct {
+	int32_t if_index; // index of the interface that owns this address
+	uint8_t family; // AF_INET or AF_INET6
+	uint8_t prefix_length; // network prefix length in bits
+	uint8_t has_broadcast; // 1 if broadcast is valid (IPv4 only)
+	uint8_t addr[16]; // address in network byte order (4 bytes used for IPv4)
+	uint8_t broadcast[4]; // IPv4 broadcast address in network byte order
+} netif_cache_address_t;
+
+/**
+ * @brief Initializes the cache: performs the initial dump and starts the netlink listener task.
+ * This function can be called several times, only the first call has an effect.
+ *
+ * If the listener task cannot be started, or as long as no dump has succeeded, the cache is refreshed with a netlink
+ * dump on each query.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+int32_t netif_cache_init(void);
+
+/**
+ * @brief Gets the number of links in the cache.
+ *
+ * @return the number of links, or a negative value on error.
+ */
+int32_t netif_cache_get_links_count(void);
+
+/**
+ * @brief Gets the link at the given position. Links are sorted by interface index.
+ *
+ * @param[in] id the zero-based position of the link.
+ * @param[out] link the structure to fill-in.
+ *
+ * @return 0 on success, -1 if there is no such link.
+ */
+int32_t netif_cache_get_link(int32_t id, netif_cache_link_t* link);
+
+/**
+ * @brief Gets the link with the given name.
+ *
+ * @param[in] name the interface name (not necessarily null terminated).
+ * @param[in] length the length of the name.
+ * @param[out] link the structure to fill-in.
+ *
+ * @return 0 on success, -1 if there is no such link.
+ */
+int32_t netif_cache_get_link_by_name(const uint8_t* name, int32_t length, netif_cache_link_t* link);
+
+/**
+ * @brief Gets the number of addresses of the given interface.
+ *
+ * @param[in] if_index the interface index.
+ *
+ * @return the number of addresses, or a negative value on error.
+ */
+int32_t netif_cache_get_addresses_count(int32_t if_index);
+
+/**
+ * @brief Gets an address of the given interface.
+ *
+ * @param[in] if_index the interface index.
+ * @param[in] id the zero-based position of the address in the interface addresses.
+ * @param[out] address the structure to fill-in.
+ *
+ * @return 0 on success, -1 if there is no such address.
+ */
+int32_t netif_cache_get_address(int32_t if_index, int32_t id, netif_cache_address_t* address);
+
+/**
+ * @brief Gets the index of the interface that owns the given address.
+ *
+ * @param[in] family AF_INET or AF_INET6.
+ * @param[in] addr the address in network byte order (4 or 16 bytes depending on the family).
+ *
+ * @return the interface index, or 0 if the address is not found.
+ */
+uint32_t netif_cache_get_index_by_address(int32_t family, const void* addr);
+
+/**
+ * @brief Gets the index of the interface with the given null terminated name.
+ *
+ * @param[in] name the interface name.
+ *
+ * @return the interface index, or 0 if the interface is not found.
+ */
+uint32_t netif_cache_get_index_by_name(const char* name);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif // NETIF_CACHE_H
@@ -0,0 +1,132 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#ifndef  SOCKET_TABLE_H
+#define  SOCKET_TABLE_H
+
+/**
+ * @file
+ * @brief Table of the native socket states, indexed by file descriptor.
+ *
+ * Each socket created or accepted by the LLNET natives has an entry holding its family, type, blocking mode,
+ * timeouts, cached local and peer addresses and I/O statistics, so the natives get the state of a socket without
+ * extra system calls. The table is printed when SIGUSR1 signal is received.
+ *
+ * All the functions must be called from the VM task, except socket_table_dump().
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/socket.h>
+#include "LLNET_Common.h"
+#include "net_stats.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/** @brief State of a socket. */
+typedef struct {
+	uint8_t in_use; // 1 if the file descriptor is a socket of the LLNET natives
+	uint8_t non_blocking; // 1 if the socket is in non-blocking mode
+	uint8_t local_address_valid; // 1 if local_address holds the bound address
+	uint8_t peer_address_valid; // 1 if peer_address holds the connected address
+	int32_t family; // AF_INET, AF_INET6, AF_UNIX, or AF_UNSPEC if unknown
+	int32_t type; // SOCK_STREAM, SOCK_DGRAM, or 0 if unknown
+	int32_t timeout; // timeout in milliseconds, -1 if not set
+	int64_t absolute_timeout; // absolute timeout in milliseconds, -1 if not set
+	union llnet_sockaddr local_address;
+	union llnet_sockaddr peer_address;
+	int64_t stats[NET_STATS_COUNT]; // see net_stats.h
+} socket_table_entry_t;
+
+/**
+ * @brief Initializes the socket table and registers its SIGUSR1 dump.
+ */
+void socket_table_init(void);
+
+/**
+ * @brief Adds a socket to the table, replacing the state of a previous socket with the same file descriptor.
+ *
+ * @param[in] fd the socket file descriptor.
+ * @param[in] family the socket family.
+ * @param[in] type the socket type.
+ * @param[in] non_blocking true if the socket is in non-blocking mode.
+ *
+ * @return the socket state, or NULL if the file descriptor is out of the table.
+ */
+socket_table_entry_t* socket_table_add(int32_t fd, int32_t family, int32_t type, bool non_blocking);
+
+/**
+ * @brief Removes a closed socket from the table.
+ *
+ * @param[in] fd the socket file descriptor.
+ */
+void socket_table_remove(int32_t fd);
+
+/**
+ * @brief Gets the state of a socket.
+ *
+ * @param[in] fd the socket file descriptor.
+ *
+ * @return the socket state, or NULL if the socket is not in the table.
+ */
+socket_table_entry_t* socket_table_get(int32_t fd);
+
+/**
+ * @brief Gets the type of a socket, from the table or else from the system.
+ *
+ * @param[in] fd the socket file descriptor.
+ *
+ * @return the socket type, or -1 on error with errno set.
+ */
+int32_t socket_table_get_type(int32_t fd);
+
+/**
+ * @brief Gets the family of a socket, from the table or else from the system.
+ *
+ * @param[in] fd the socket file descriptor.
+ *
+ * @return the socket family, or -1 on error with errno set.
+ */
+int32_t socket_table_get_family(int32_t fd);
+
+/**
+ * @brief Gets the local or peer address of an IP socket, from the table or else from the system.
+ * The address is cached once the socket is bound to a port (local) or connected (peer).
+ *
+ * @param[in] fd the socket file descriptor.
+ * @param[out] address the address.
+ * @param[in] local true for the local address, false for the peer address.
+ *
+ * @return 0 on success, -1 on error with errno set.
+ */
+int32_t socket_table_get_address(int32_t fd, union llnet_sockaddr* address, bool local);
+
+/**
+ * @brief Invalidates the cached addresses of a socket, before an operation that may change them (bind, connect,
+ * listen, disconnect).
+ *
+ * @param[in] fd the socket file descriptor.
+ */
+void socket_table_invalidate_addresses(int32_t fd);
+
+/**
+ * @brief Prints the table on the standard output.
+ */
+void socket_table_dump(void);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif // SOCKET_TABLE_H
@@ -0,0 +1,102 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#ifndef  TCP_FASTOPEN_H
+#define  TCP_FASTOPEN_H
+
+/**
+ * @file
+ * @brief TCP Fast Open (RFC 7413) support for the stream socket channels.
+ *
+ * TCP Fast Open is controlled per socket with two socket options handled by LLNET_CHANNEL_IMPL_setOption() and
+ * LLNET_CHANNEL_IMPL_getOption():
+ * - <code>LLNET_SOCKETOPTION_TCP_FASTOPEN</code>: Fast Open queue length of a server socket, set before listen().
+ * - <code>LLNET_SOCKETOPTION_TCP_FASTOPEN_CONNECT</code>: boolean, client socket, set before connect().
+ *
+ * Default values for these options are defined in LLNET_linux_configuration.h.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/** @brief Socket option: TCP Fast Open queue length of a listening socket (0 disables Fast Open). */
+#define LLNET_SOCKETOPTION_TCP_FASTOPEN			(0x10001)
+/** @brief Socket option: send the first written data in the SYN of a client socket (boolean). */
+#define LLNET_SOCKETOPTION_TCP_FASTOPEN_CONNECT	(0x10002)
+
+/** @brief TCP Fast Open statistics identifiers. */
+typedef enum {
+	TCP_FASTOPEN_STAT_CLIENT_CONNECTS = 0, // client connections started with TCP_FASTOPEN_CONNECT
+	TCP_FASTOPEN_STAT_CLIENT_SYN_DATA_ACKED = 1, // closed client connections whose data in SYN was acknowledged
+	TCP_FASTOPEN_STAT_CLIENT_FALLBACKS = 2, // closed client connections that fell back to a regular 3-way handshake
+	TCP_FASTOPEN_STAT_SERVER_ACCEPTS = 3, // connections accepted while Fast Open is enabled on a listening socket
+	TCP_FASTOPEN_STAT_SERVER_SYN_DATA_ACCEPTED = 4, // accepted connections whose SYN carried data
+	TCP_FASTOPEN_STAT_ENABLE_ERRORS = 5, // failures to enable Fast Open by default (kernel support missing)
+	TCP_FASTOPEN_STATS_COUNT
+} tcp_fastopen_stat_t;
+
+#ifndef LLNET_TCP_FASTOPEN_IMPL_getStatistic
+#define LLNET_TCP_FASTOPEN_IMPL_getStatistic	Java_com_microej_net_TcpFastOpen_getStatistic
+#endif
+
+/**
+ * @brief Native: gets a TCP Fast Open statistic.
+ *
+ * @param[in] id the statistic identifier, one of tcp_fastopen_stat_t.
+ *
+ * @return the statistic value, or -1 if the identifier is unknown.
+ */
+int64_t LLNET_TCP_FASTOPEN_IMPL_getStatistic(int32_t id);
+
+/**
+ * @brief Applies the default TCP Fast Open queue length to a socket about to listen.
+ *
+ * @param[in] fd the socket file descriptor.
+ */
+void tcp_fastopen_on_listen(int32_t fd);
+
+/**
+ * @brief Applies the default TCP_FASTOPEN_CONNECT value to a socket about to connect and updates the statistics.
+ *
+ * @param[in] fd the socket file descriptor.
+ */
+void tcp_fastopen_on_connect(int32_t fd);
+
+/**
+ * @brief Updates the statistics with a newly accepted connection.
+ *
+ * @param[in] fd the accepted socket file descriptor.
+ */
+void tcp_fastopen_on_accept(int32_t fd);
+
+/**
+ * @brief Updates the statistics with the outcome of a client connection about to be closed.
+ *
+ * @param[in] fd the socket file descriptor.
+ */
+void tcp_fastopen_on_close(int32_t fd);
+
+/**
+ * @brief Records that Fast Open has been explicitly enabled on a socket with one of the socket options.
+ *
+ * @param[in] option LLNET_SOCKETOPTION_TCP_FASTOPEN or LLNET_SOCKETOPTION_TCP_FASTOPEN_CONNECT.
+ * @param[in] value the option value.
+ */
+void tcp_fastopen_on_set_option(int32_t option, int32_t value);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif // TCP_FASTOPEN_H
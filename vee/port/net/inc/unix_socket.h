@@ -0,0 +1,192 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#ifndef  UNIX_SOCKET_H
+#define  UNIX_SOCKET_H
+
+/**
+ * @file
+ * @brief Unix domain (AF_UNIX) socket channels.
+ *
+ * The natives below create, bind and connect Unix domain stream and datagram sockets, and exchange datagrams
+ * and file descriptors (SCM_RIGHTS) over them. Once created, the sockets are regular non-blocking channels:
+ * LLNET_CHANNEL (close, shutdown, listen, options) and LLNET_STREAMSOCKETCHANNEL (read, write, available,
+ * accept) natives apply to them.
+ *
+ * Addresses are given as the path bytes, without terminating NUL character. A path starting with a NUL byte
+ * denotes an address in the Linux abstract namespace, the following bytes being its name.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+#ifndef LLNET_UNIX_IMPL_socket
+#define LLNET_UNIX_IMPL_socket				Java_com_microej_net_UnixSocketChannel_socket
+#endif
+#ifndef LLNET_UNIX_IMPL_bind
+#define LLNET_UNIX_IMPL_bind				Java_com_microej_net_UnixSocketChannel_bind
+#endif
+#ifndef LLNET_UNIX_IMPL_connect
+#define LLNET_UNIX_IMPL_connect				Java_com_microej_net_UnixSocketChannel_connect
+#endif
+#ifndef LLNET_UNIX_IMPL_getLocalPath
+#define LLNET_UNIX_IMPL_getLocalPath		Java_com_microej_net_UnixSocketChannel_getLocalPath
+#endif
+#ifndef LLNET_UNIX_IMPL_getPeerPath
+#define LLNET_UNIX_IMPL_getPeerPath			Java_com_microej_net_UnixSocketChannel_getPeerPath
+#endif
+#ifndef LLNET_UNIX_IMPL_send
+#define LLNET_UNIX_IMPL_send				Java_com_microej_net_UnixSocketChannel_send
+#endif
+#ifndef LLNET_UNIX_IMPL_receive
+#define LLNET_UNIX_IMPL_receive				Java_com_microej_net_UnixSocketChannel_receive
+#endif
+#ifndef LLNET_UNIX_IMPL_sendWithFd
+#define LLNET_UNIX_IMPL_sendWithFd			Java_com_microej_net_UnixSocketChannel_sendWithFd
+#endif
+#ifndef LLNET_UNIX_IMPL_receiveWithFd
+#define LLNET_UNIX_IMPL_receiveWithFd		Java_com_microej_net_UnixSocketChannel_receiveWithFd
+#endif
+
+/**
+ * @brief Creates a new non-blocking Unix domain socket.
+ *
+ * @param[in] stream true for a stream socket, false for a datagram socket.
+ *
+ * @return the socket file descriptor.
+ *
+ * @note Throws NativeIOException on error.
+ */
+int32_t LLNET_UNIX_IMPL_socket(uint8_t stream);
+
+/**
+ * @brief Binds a Unix domain socket to a path.
+ *
+ * @param[in] fd the socket file descriptor.
+ * @param[in] path the path bytes.
+ * @param[in] length the path length.
+ *
+ * @note Throws NativeIOException on error.
+ */
+void LLNET_UNIX_IMPL_bind(int32_t fd, int8_t* path, int32_t length);
+
+/**
+ * @brief Connects a Unix domain socket to a path.
+ * A stream socket whose peer backlog is full retries every UNIX_SOCKET_CONNECT_RETRY_DELAY_MS milliseconds.
+ *
+ * @param[in] fd the socket file descriptor.
+ * @param[in] path the path bytes.
+ * @param[in] length the path length.
+ * @param[in] absoluteTimeout the absolute time in milliseconds at which the connection times out, 0 for no timeout.
+ *
+ * @note Throws NativeIOException on error.
+ */
+void LLNET_UNIX_IMPL_connect(int32_t fd, int8_t* path, int32_t length, int64_t absoluteTimeout);
+
+/**
+ * @brief Gets the path a Unix domain socket is bound to.
+ *
+ * @param[in] fd the socket file descriptor.
+ * @param[out] path the buffer to fill with the path bytes.
+ * @param[in] length the buffer length.
+ *
+ * @return the path length, 0 if the socket is unbound.
+ *
+ * @note Throws NativeIOException on error.
+ */
+int32_t LLNET_UNIX_IMPL_getLocalPath(int32_t fd, int8_t* path, int32_t length);
+
+/**
+ * @brief Gets the path of the peer of a connected Unix domain socket.
+ *
+ * @param[in] fd the socket file descriptor.
+ * @param[out] path the buffer to fill with the path bytes.
+ * @param[in] length the buffer length.
+ *
+ * @return the path length, 0 if the peer is unbound.
+ *
+ * @note Throws NativeIOException on error.
+ */
+int32_t LLNET_UNIX_IMPL_getPeerPath(int32_t fd, int8_t* path, int32_t length);
+
+/**
+ * @brief Sends a datagram on a Unix domain datagram socket.
+ *
+ * @param[in] fd the socket file descriptor.
+ * @param[in] src the data buffer.
+ * @param[in] offset the data offset in the buffer.
+ * @param[in] length the data length.
+ * @param[in] path the destination path bytes.
+ * @param[in] pathLength the destination path length, 0 to send to the connected peer.
+ *
+ * @note Throws NativeIOException on error.
+ */
+void LLNET_UNIX_IMPL_send(int32_t fd, int8_t* src, int32_t offset, int32_t length, int8_t* path, int32_t pathLength);
+
+/**
+ * @brief Receives a datagram on a Unix domain datagram socket.
+ *
+ * @param[in] fd the socket file descriptor.
+ * @param[out] dst the data buffer.
+ * @param[in] offset the data offset in the buffer.
+ * @param[in] length the maximum data length.
+ * @param[out] path the buffer to fill with the sender path bytes.
+ * @param[in] pathLength the sender path buffer length.
+ * @param[in] absoluteTimeout the absolute time in milliseconds at which the reception times out, 0 for no timeout.
+ *
+ * @return the received data length in the 32 most significant bits and the sender path length (0 if the sender
+ * is unbound) in the 32 least significant bits.
+ *
+ * @note Throws NativeIOException on error.
+ */
+int64_t LLNET_UNIX_IMPL_receive(int32_t fd, int8_t* dst, int32_t offset, int32_t length, int8_t* path, int32_t pathLength, int64_t absoluteTimeout);
+
+/**
+ * @brief Sends data along with a file descriptor (SCM_RIGHTS) on a connected Unix domain socket.
+ * The file descriptor is attached to the first byte sent.
+ *
+ * @param[in] fd the socket file descriptor.
+ * @param[in] src the data buffer.
+ * @param[in] offset the data offset in the buffer.
+ * @param[in] length the data length, at least 1.
+ * @param[in] passedFd the file descriptor to pass.
+ *
+ * @return the number of bytes sent, which may be less than length on a stream socket.
+ *
+ * @note Throws NativeIOException on error.
+ */
+int32_t LLNET_UNIX_IMPL_sendWithFd(int32_t fd, int8_t* src, int32_t offset, int32_t length, int32_t passedFd);
+
+/**
+ * @brief Receives data and possibly a file descriptor (SCM_RIGHTS) on a connected Unix domain socket.
+ * The received file descriptor is close-on-exec; the extra file descriptors of a message are closed.
+ *
+ * @param[in] fd the socket file descriptor.
+ * @param[out] dst the data buffer.
+ * @param[in] offset the data offset in the buffer.
+ * @param[in] length the maximum data length.
+ * @param[out] receivedFd an array whose first element is set to the received file descriptor, or -1 if none.
+ * @param[in] absoluteTimeout the absolute time in milliseconds at which the reception times out, 0 for no timeout.
+ *
+ * @return the number of bytes received, -1 on end of stream.
+ *
+ * @note Throws NativeIOException on error.
+ */
+int32_t LLNET_UNIX_IMPL_receiveWithFd(int32_t fd, int8_t* dst, int32_t offset, int32_t length, int32_t* receivedFd, int64_t absoluteTimeout);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif // UNIX_SOCKET_H
@@ -26,8 +26,14 @@
 #include "async_select.h"
 #include "LLNET_ERRORS.h"
 #include "LLNET_Common.h"
+#include "netif_cache.h"
+#include "connect_racer.h"
+#include "tcp_fastopen.h"
+#include "accept_queue.h"
+#include "busy_poll.h"
+#include "socket_table.h"
+#include "net_stats.h"
 #if LLNET_AF & LLNET_AF_IPV6
-#include <ifaddrs.h>
 #include <arpa/inet.h>
 #include <netdb.h>
 #include <net/if.h>
@@ -52,6 +58,8 @@ void LLNET_CHANNEL_IMPL_close(int32_t fd)
 		return;
     }
 
+	tcp_fastopen_on_close(fd);
+
 	if(llnet_close(fd) == -1){
 		fd_errno = llnet_errno(fd);
 		SNI_throwNativeIOException(LLNET_map_to_java_exception(fd_errno), LLNET_get_socket_error_msg(fd_errno));
@@ -59,6 +67,10 @@ void LLNET_CHANNEL_IMPL_close(int32_t fd)
 		return;
 	}
 	async_select_notify_closed_fd(fd);
+	connect_racer_notify_closed_fd(fd);
+	accept_queue_notify_closed_fd(fd);
+	busy_poll_notify_closed_fd(fd);
+	socket_table_remove(fd);
 }
 
 void LLNET_CHANNEL_IMPL_initialize(void)
@@ -70,7 +82,12 @@ void LLNET_CHANNEL_IMPL_initialize(void)
 	signal(SIGPIPE, SIG_IGN);
 #endif
 	llnet_init();
+	socket_table_init();
+	net_stats_init();
 	res = async_select_init();
+	if(res == 0){
+		res = netif_cache_init();
+	}
 	if(res != 0){
 		SNI_throwNativeIOException(J_EUNKNOWN, "init error");
 	}
@@ -154,6 +171,7 @@ void LLNET_CHANNEL_IMPL_bind(int32_t fd, int8_t* addr, int32_t length, int32_t p
 		return;
 	}
 
+	socket_table_invalidate_addresses(fd);
 	int32_t ret = llnet_bind(fd, &sockaddr.addr, sockaddr_sizeof);
 	LLNET_DEBUG_TRACE("%s[thread %d](fd=0x%X, ret=%d, errno=%d, ...)\n", __func__, SNI_getCurrentJavaThreadID(), fd, ret, llnet_errno(fd));
 	if(ret == -1){
@@ -227,6 +245,16 @@ int32_t LLNET_CHANNEL_IMPL_getOption(int32_t fd, int32_t option)
 		case LLNET_SOCKETOPTION_SO_OOBINLINE:
 			optname = SO_OOBINLINE;
 			break;
+		case LLNET_SOCKETOPTION_TCP_FASTOPEN:
+			level = IPPROTO_TCP;
+			optname = TCP_FASTOPEN;
+			break;
+		case LLNET_SOCKETOPTION_TCP_FASTOPEN_CONNECT:
+			level = IPPROTO_TCP;
+			optname = TCP_FASTOPEN_CONNECT;
+			break;
+		case LLNET_SOCKETOPTION_BUSY_POLL:
+			return busy_poll_get_budget(fd);
 		default:
 			//option not available
 			SNI_throwNativeIOException(J_ENOPROTOOPT, "socket option not supported");
@@ -303,8 +331,6 @@ void LLNET_CHANNEL_IMPL_setOption(int32_t fd, int32_t option, int32_t value)
 	void* p_optval = &value;
 
 	int32_t sock_type;
-        uint32_t size;
-	size = sizeof (uint32_t);
 	int32_t fd_errno;
 
 	switch (option) {
@@ -353,6 +379,19 @@ void LLNET_CHANNEL_IMPL_setOption(int32_t fd, int32_t option, int32_t value)
 		case LLNET_SOCKETOPTION_SO_OOBINLINE:
 			optname = SO_OOBINLINE;
 			break;
+		case LLNET_SOCKETOPTION_TCP_FASTOPEN:
+			level = IPPROTO_TCP;
+			optname = TCP_FASTOPEN;
+			break;
+		case LLNET_SOCKETOPTION_TCP_FASTOPEN_CONNECT:
+			level = IPPROTO_TCP;
+			optname = TCP_FASTOPEN_CONNECT;
+			break;
+		case LLNET_SOCKETOPTION_BUSY_POLL:
+			if(busy_poll_set_budget(fd, value) == -1){
+				SNI_throwNativeIOException(J_ENOMEM, "too many sockets in low-latency mode");
+			}
+			return;
 		default:
 			/* option not available */
 			LLNET_DEBUG_TRACE("option not supported %d\n",option);
@@ -367,8 +406,12 @@ void LLNET_CHANNEL_IMPL_setOption(int32_t fd, int32_t option, int32_t value)
 		return;
 	}
 
+	if(option == LLNET_SOCKETOPTION_TCP_FASTOPEN || option == LLNET_SOCKETOPTION_TCP_FASTOPEN_CONNECT){
+		tcp_fastopen_on_set_option(option, value);
+	}
+
 	if(option == LLNET_SOCKETOPTION_SO_REUSEADDR){
-		llnet_getsockopt(fd, level, SO_TYPE, (char *)&sock_type, &size);
+		sock_type = socket_table_get_type(fd);
 		if(sock_type == SOCK_DGRAM){
 			// Force enable/disable SO_REUSEPORT on UDP/Multicast sockets
 			// to allow multiple multicast sockets to be bound to the same address
@@ -451,25 +494,8 @@ void LLNET_CHANNEL_IMPL_setOptionAsByteArray(int32_t fd, int32_t option, int8_t*
 #if LLNET_AF & LLNET_AF_IPV6
 				//Only IPv6
 				if(valueLength == sizeof(struct in6_addr)) {
-					// get interface name
-					struct ifaddrs * ifaddrs = NULL;
-					struct ifaddrs * i;
-					if(getifaddrs(&ifaddrs) != 0) {
-						fd_errno = llnet_errno(fd);
-						SNI_throwNativeIOException(LLNET_map_to_java_exception(fd_errno), LLNET_get_socket_error_msg(fd_errno));
-						return;
-					}
-					uint32_t ifindex = 0;
-					// Walk the interface address structure until we match the interface address
-					for (i = ifaddrs; i != NULL; i = i->ifa_next) {
-						if (NULL != i->ifa_addr && AF_INET6 == i->ifa_addr->sa_family) {
-							if(memcmp(value, ((struct sockaddr_in6*)i->ifa_addr)->sin6_addr.s6_addr, valueLength) == 0) {
-								ifindex = if_nametoindex(i->ifa_name);
-								break;
-							}
-						}
-					}
-					freeifaddrs(ifaddrs);
+					// get interface index
+					uint32_t ifindex = netif_cache_get_index_by_address(AF_INET6, value);
 					if(ifindex == 0){
 						SNI_throwNativeIOException(J_EINVAL, "No interface index found");
 						return;
@@ -503,6 +529,10 @@ void LLNET_CHANNEL_IMPL_listen(int32_t fd, int32_t backlog)
 		return;
     }
 
+	tcp_fastopen_on_listen(fd);
+
+	// listening binds an unbound socket
+	socket_table_invalidate_addresses(fd);
 	int32_t res = llnet_listen(fd, backlog);
 	if(res == -1){
 		fd_errno = llnet_errno(fd);
@@ -23,11 +23,12 @@
 #include <netinet/in.h>
 #include <stdint.h>
 #if LLNET_AF & LLNET_AF_IPV6
-#include <ifaddrs.h>
 #include <arpa/inet.h>
-#include <netdb.h>
-#include <net/if.h>
+#include "netif_cache.h"
 #endif
+#include "busy_poll.h"
+#include "socket_table.h"
+#include "net_stats.h"
 #ifndef LLNET_USE_IOCTL_FOR_BLOCKING_OPTION
 #include <fcntl.h>
 #endif // LLNET_USE_IOCTL_FOR_BLOCKING_OPTION
@@ -96,35 +97,17 @@ int32_t LLNET_map_to_java_exception(int32_t err){
 
 #if LLNET_AF & LLNET_AF_IPV6
 uint32_t LLNET_getScopeForIp(const char *ip){
-	struct ifaddrs *addrs;
-	char ipAddress[NI_MAXHOST];
+	struct in6_addr ipAddress;
 	uint32_t scope = 0;
 
-	// walk over the list of all interface addresses
-	getifaddrs(&addrs);
-	for (struct ifaddrs *addr = addrs; addr; addr = addr->ifa_next) {
-		if (addr->ifa_addr && addr->ifa_addr->sa_family == AF_INET6) { // only interested in ipv6 ones
-			getnameinfo(addr->ifa_addr, sizeof(struct sockaddr_in6), ipAddress,
-					sizeof(ipAddress), NULL, 0, NI_NUMERICHOST);
-			// result actually contains the interface name, so strip it
-			for (int i = 0; ipAddress[i]; i++) {
-				if (ipAddress[i] == '%') {
-					ipAddress[i] = '\0';
-					break;
-				}
-			}
-			// if the ip matches, convert the interface name to a scope index
-			if (strcmp(ipAddress, ip) == 0) {
-				scope = if_nametoindex(addr->ifa_name);
-				break;
-			}
-		}
+	// look for the interface that owns this address in the interface cache
+	if (inet_pton(AF_INET6, ip, &ipAddress) == 1) {
+		scope = netif_cache_get_index_by_address(AF_INET6, &ipAddress);
 	}
-	// If the scope wasn't set in the name search, set it to LLNET_IPV6_INTERFACE_NAME
+	// If the scope wasn't set in the address search, set it to LLNET_IPV6_INTERFACE_NAME
 	if(0 == scope) {
-		scope = if_nametoindex(LLNET_IPV6_INTERFACE_NAME);
+		scope = netif_cache_get_index_by_name(LLNET_IPV6_INTERFACE_NAME);
 	}
-	freeifaddrs(addrs);
 	return scope;
 }
 
@@ -189,6 +172,17 @@ void LLNET_handle_blocking_operation_error(int32_t fd, int32_t fd_errno, select_
 		return;
 	}
 
+	if((EAGAIN == fd_errno) || (EWOULDBLOCK == fd_errno)){
+		net_stats_on_eagain(fd);
+	}
+
+	if(((EAGAIN == fd_errno) || (EWOULDBLOCK == fd_errno)) && busy_poll_wait(fd, operation)){
+		//the socket became ready while busy-polling (low-latency mode): retry the operation right away
+		SNI_suspendCurrentJavaThreadWithCallback(0, callback, callback_suspend_arg);
+		SNI_resumeJavaThread(SNI_getCurrentJavaThreadID());
+		return;
+	}
+
 	if((EAGAIN == fd_errno)  || (EINPROGRESS == fd_errno) || (EWOULDBLOCK == fd_errno)){
 		//need to wait for operation
 		//add async_select request
@@ -207,17 +201,27 @@ void LLNET_handle_blocking_operation_error(int32_t fd, int32_t fd_errno, select_
  * @return 0 on success, a negative value on error.
  */
 int32_t LLNET_set_non_blocking(int32_t fd){
+	socket_table_entry_t* entry = socket_table_get(fd);
+	if(entry != NULL && entry->non_blocking == 1){
+		// already in non-blocking mode
+		return 0;
+	}
+	int32_t res;
 #ifdef LLNET_USE_IOCTL_FOR_BLOCKING_OPTION
 	int32_t non_blocking_option = 1;
-	return llnet_ioctl(fd, FIONBIO, &non_blocking_option);
+	res = llnet_ioctl(fd, FIONBIO, &non_blocking_option);
 #else
 	int32_t flags = llnet_fcntl(fd, F_GETFL, 0);
 	if(flags == -1){
 		return -1;
 	}
 	flags |= O_NONBLOCK;
-	return llnet_fcntl(fd, F_SETFL, flags);
+	res = llnet_fcntl(fd, F_SETFL, flags);
 #endif // LLNET_USE_IOCTL_FOR_BLOCKING_OPTION
+	if(res == 0 && entry != NULL){
+		entry->non_blocking = 1;
+	}
+	return res;
 }
 
 #ifdef __cplusplus
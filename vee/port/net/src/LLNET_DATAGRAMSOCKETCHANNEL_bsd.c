@@ -22,6 +22,8 @@
 #include "sni.h"
 #include "LLNET_ERRORS.h"
 #include "LLNET_Common.h"
+#include "socket_table.h"
+#include "net_stats.h"
 
 #ifdef __cplusplus
 	extern "C" {
@@ -41,6 +43,7 @@ int64_t LLNET_DATAGRAMSOCKETCHANNEL_IMPL_receive(int32_t fd, int8_t* dst, int32_
 	int32_t ret;
 
 	ret = llnet_recvfrom(fd, dst+dstOffset, dstLength, flags, &sockaddr.addr, (socklen_t *)&addrLen);
+	net_stats_on_receive(fd, ret, true);
 
 	LLNET_DEBUG_TRACE("%s recvfrom() returned %d errno = %d\n",__func__, ret, llnet_errno(fd));
 
@@ -169,6 +172,8 @@ void LLNET_DATAGRAMSOCKETCHANNEL_IMPL_send(int32_t fd, int8_t* src, int32_t srco
 		ret = llnet_sendto(fd, src+srcoffset, srclength, 0, (struct sockaddr*)NULL, 0);
 	}
 
+	net_stats_on_send(fd, ret, true);
+
 	if(ret == 0){
 		SNI_throwNativeIOException(J_EUNKNOWN, "0 byte written");
 		return;
@@ -176,6 +181,7 @@ void LLNET_DATAGRAMSOCKETCHANNEL_IMPL_send(int32_t fd, int8_t* src, int32_t srco
 
 	if(0 > ret){
 		LLNET_handle_blocking_operation_error(fd, llnet_errno(fd), SELECT_READ, 0, (SNI_callback)LLNET_DATAGRAMSOCKETCHANNEL_IMPL_send, NULL);
+		return;
 	}
 }
 
@@ -190,6 +196,7 @@ void LLNET_DATAGRAMSOCKETCHANNEL_IMPL_disconnect(int32_t fd)
 
 	struct sockaddr sockaddr = {0};
 	sockaddr.sa_family = AF_UNSPEC;
+	socket_table_invalidate_addresses(fd);
 	if(llnet_connect(fd, &sockaddr, sizeof(struct sockaddr)) < 0) {
 		int32_t fd_errno = llnet_errno(fd);
 		SNI_throwNativeIOException(LLNET_map_to_java_exception(fd_errno), LLNET_get_socket_error_msg(fd_errno));
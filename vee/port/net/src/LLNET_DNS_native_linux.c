@@ -20,6 +20,7 @@
 #include <arpa/inet.h>
 #include "LLNET_ERRORS.h"
 #include "LLNET_Common.h"
+#include "connect_racer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -63,9 +64,14 @@ int32_t LLNET_DNS_IMPL_getHostByNameAt(int32_t index, uint8_t *hostname, int32_t
 	hints.ai_family = AF_INET6;
 
 #if LLNET_AF == LLNET_AF_DUAL
+#ifdef LLNET_USE_CONNECT_RACER
+	// return both the IPv6 and the IPv4 (mapped) addresses so that the connections can be raced
+	hints.ai_flags = AI_V4MAPPED | AI_ALL;
+#else
 	// allow to map on IPv4 if no IPv6 available
 	hints.ai_flags = AI_V4MAPPED;
 #endif
+#endif
 
 #else // only IPv4
 	hints.ai_family = AF_INET;
@@ -135,9 +141,14 @@ int32_t LLNET_DNS_IMPL_getHostByNameCount(uint8_t *hostname, int32_t hostname_le
 	hints.ai_family = AF_INET6;
 
 #if LLNET_AF == LLNET_AF_DUAL
+#ifdef LLNET_USE_CONNECT_RACER
+	// return both the IPv6 and the IPv4 (mapped) addresses so that the connections can be raced
+	hints.ai_flags = AI_V4MAPPED | AI_ALL;
+#else
 	// allow to map on IPv4 if no IPv6 available
 	hints.ai_flags = AI_V4MAPPED;
 #endif
+#endif
 
 #else // only IPv4
 	hints.ai_family = AF_INET;
@@ -149,6 +160,9 @@ int32_t LLNET_DNS_IMPL_getHostByNameCount(uint8_t *hostname, int32_t hostname_le
 		(void)SNI_throwNativeIOException(J_EHOSTUNKNOWN, gai_strerror(r));
 		counter = SNI_IGNORED_RETURNED_VALUE;
 		addrinfos = NULL;
+	} else {
+		// Remember the addresses to race them on connect
+		connect_racer_record_resolution(hostname, addrinfos);
 	}
 
 	// Count the number of entries
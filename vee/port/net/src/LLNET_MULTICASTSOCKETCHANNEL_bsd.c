@@ -23,7 +23,7 @@
 #include "LLNET_Common.h"
 #include "LLNET_CHANNEL_impl.h"
 #if LLNET_AF & LLNET_AF_IPV6
-#include <ifaddrs.h>
+#include "netif_cache.h"
 #include <arpa/inet.h>
 #include <netdb.h>
 #include <net/if.h>
@@ -77,24 +77,8 @@ void LLNET_MULTICASTSOCKETCHANNEL_IMPL_joinOrLeave(int32_t fd, uint8_t join, int
 		struct ipv6_mreq optval;
 		memcpy(optval.ipv6mr_multiaddr.s6_addr, mcastAddr, sizeof(struct in6_addr));
 		if(netIfAddrLength != 0){
-			// get interface name
-			struct ifaddrs * ifaddrs = NULL;
-			struct ifaddrs * i;
-			if(getifaddrs(&ifaddrs) != 0) {
-				fd_errno = llnet_errno(fd);
-				SNI_throwNativeIOException(LLNET_map_to_java_exception(fd_errno), LLNET_get_socket_error_msg(fd_errno));
-				return;
-			}
-			// Walk the interface address structure until we match the interface address
-			for (i = ifaddrs; i != NULL; i = i->ifa_next) {
-				if (NULL != i->ifa_addr && AF_INET6 == i->ifa_addr->sa_family) {
-					if(memcmp(netIfAddr, ((struct sockaddr_in6*)i->ifa_addr)->sin6_addr.s6_addr, netIfAddrLength) == 0) {
-						optval.ipv6mr_interface = if_nametoindex(i->ifa_name);
-						break;
-					}
-				}
-			}
-			freeifaddrs(ifaddrs);
+			// get interface index, 0 (any interface) if the address is not found
+			optval.ipv6mr_interface = netif_cache_get_index_by_address(AF_INET6, netIfAddr);
 		}
 		else {
 			optval.ipv6mr_interface = 0;
@@ -33,6 +33,9 @@
 #include "LLNET_ERRORS.h"
 #include "sni.h"
 #include "LLNET_configuration.h"
+#include "connect_racer.h"
+#include "tcp_fastopen.h"
+#include "socket_table.h"
 
 #ifdef __cplusplus
 	extern "C" {
@@ -45,13 +48,7 @@ static int32_t LLNET_SOCKETCHANNEL_get_port(int32_t fd, uint8_t localPort);
 static int32_t LLNET_SOCKETCHANNEL_get_port(int32_t fd, uint8_t localPort){
 	union llnet_sockaddr sockaddr = {0};
 
-	uint32_t addrlen = sizeof(sockaddr);
-	int32_t ret = -1;
-	if(localPort){
-		ret = llnet_getsockname(fd, &sockaddr.addr, (socklen_t*)&addrlen);
-	}else{
-		ret = llnet_getpeername(fd, &sockaddr.addr, (socklen_t*)&addrlen);
-	}
+	int32_t ret = socket_table_get_address(fd, &sockaddr, localPort ? true : false);
 
 	if (ret == 0){
 #if LLNET_AF & LLNET_AF_IPV4
@@ -75,15 +72,8 @@ static int32_t LLNET_SOCKETCHANNEL_get_port(int32_t fd, uint8_t localPort){
 static int32_t LLNET_SOCKETCHANNEL_get_address(int32_t fd, int8_t* name, int32_t nameLength, uint8_t localAddress){
 
 	union llnet_sockaddr sockaddr = {0};
-	uint32_t addrlen = sizeof(sockaddr);
-	int32_t ret = -1;
-	if(localAddress){
-		ret = llnet_getsockname(fd, &sockaddr.addr, (socklen_t*)&addrlen);
-		LLNET_DEBUG_TRACE("getsockname(fd=0x%X) ret=%d errno=%d\n", fd,ret,llnet_errno(fd));
-	}else{
-		ret = llnet_getpeername(fd, &sockaddr.addr, (socklen_t*)&addrlen);
-		LLNET_DEBUG_TRACE("getpeername(fd=0x%X) ret=%d errno=%d\n", fd,ret,llnet_errno(fd));
-	}
+	int32_t ret = socket_table_get_address(fd, &sockaddr, localAddress ? true : false);
+	LLNET_DEBUG_TRACE("%s(fd=0x%X) ret=%d errno=%d\n", localAddress ? "getsockname" : "getpeername", fd, ret, llnet_errno(fd));
 	if (ret == 0){
 #if LLNET_AF & LLNET_AF_IPV4
 		if(sockaddr.addr.sa_family == AF_INET) {
@@ -221,6 +211,16 @@ void LLNET_SOCKETCHANNEL_IMPL_connect(int32_t fd, int8_t* addr, int32_t length,
 		return;
 	}
 
+	// the connection binds the socket and sets its peer
+	socket_table_invalidate_addresses(fd);
+
+	tcp_fastopen_on_connect(fd);
+
+	// Race the other addresses of the host if some are known
+	if(connect_racer_connect(fd, &sockaddr, sockaddr_sizeof, absoluteTimeout) == 1){
+		return;
+	}
+
 	connectRes = llnet_connect(fd, &sockaddr.addr, sockaddr_sizeof);
 
 	if(connectRes < 0){
@@ -332,6 +332,7 @@ int32_t LLNET_SOCKETCHANNEL_IMPL_socket(uint8_t stream)
 	}
 #endif
 
+	(void)socket_table_add(fd, domain, stream ? SOCK_STREAM : SOCK_DGRAM, true);
 	return fd;
 }
 
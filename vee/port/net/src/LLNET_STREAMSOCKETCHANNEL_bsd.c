@@ -27,6 +27,10 @@
 #include <LLNET_CHANNEL_impl.h>
 #include "LLNET_ERRORS.h"
 #include "LLNET_Common.h"
+#include "tcp_fastopen.h"
+#include "accept_queue.h"
+#include "socket_table.h"
+#include "net_stats.h"
 
 #ifdef __cplusplus
 	extern "C" {
@@ -70,6 +74,7 @@ static void LLNET_STREAMSOCKETCHANNEL_write(int32_t fd, int8_t* buffer, int32_t
 
 	int32_t fd_errno;
 	int32_t ret = llnet_send(fd, buffer+current_written_length, remaining_length, 0);
+	net_stats_on_send(fd, ret, false);
 
     if(ret == 0){
     	//should not happen: 0 byte written
@@ -104,6 +109,7 @@ int32_t LLNET_STREAMSOCKETCHANNEL_IMPL_read(int32_t fd, int8_t* dst, int32_t off
     }
 
 	int32_t ret = llnet_recv(fd, (void*)(dst+offset), length, 0);
+	net_stats_on_receive(fd, ret, false);
 	LLNET_DEBUG_TRACE("%s: result=%d errno=%d\n", __func__, ret,llnet_errno(fd));
 
 	if(ret > 0){
@@ -189,29 +195,20 @@ int32_t LLNET_STREAMSOCKETCHANNEL_IMPL_accept(int32_t fd, int64_t absoluteTimeou
 		SNI_throwNativeIOException(J_NETWORK_NOT_INITIALIZED, "network not initialized");
 		return SNI_IGNORED_RETURNED_VALUE;
     }
-    int32_t ret;
     int32_t fd_errno;
-    ret = llnet_accept(fd, NULL, NULL);
+    // the accepted socket is already in non blocking mode
+    int32_t client_socket_fd = accept_queue_accept(fd);
 
-    if(0 > ret){
+    if(0 > client_socket_fd){
     	//error
     	fd_errno = llnet_errno(fd);
     	LLNET_handle_blocking_operation_error(fd, fd_errno, SELECT_READ, absoluteTimeout, (SNI_callback)LLNET_STREAMSOCKETCHANNEL_IMPL_accept, NULL);
     	return SNI_IGNORED_RETURNED_VALUE;
     }
 
-    int32_t client_socket_fd = ret;
-    //set the accepted socket in non blocking mode
-	ret = LLNET_set_non_blocking(client_socket_fd);
-
-	//set the socket in non blocking mode
-	if(0 != ret){
-		fd_errno = llnet_errno(client_socket_fd);
-		LLNET_DEBUG_TRACE("%s: set_non_blocking errno=%d, err=%d\n", __func__, fd_errno, ret);
-		SNI_throwNativeIOException(LLNET_map_to_java_exception(fd_errno), LLNET_get_socket_error_msg(fd_errno));
-		close(client_socket_fd);
-		return SNI_IGNORED_RETURNED_VALUE;
-	}
+	// the accepted socket has the family of the listening socket
+	(void)socket_table_add(client_socket_fd, socket_table_get_family(fd), SOCK_STREAM, true);
+	tcp_fastopen_on_accept(client_socket_fd);
 	return client_socket_fd;
 }
 
@@ -0,0 +1,188 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/**
+ * @file
+ * @brief Batched accept implementation over Linux accept4().
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include "accept_queue.h"
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include "LLNET_Common.h"
+#include "LLNET_linux_configuration.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/**
+ * Sanity check between the expected version of the configuration and the actual version of
+ * the configuration.
+ * If an error is raised here, it means that a new version of the CCO has been installed and
+ * the configuration LLNET_linux_configuration.h must be updated based on the one provided
+ * by the new CCO version.
+ */
+#if LLNET_LINUX_CONFIGURATION_VERSION != 2
+
+	#error "Version of the configuration file LLNET_linux_configuration.h is not compatible with this implementation."
+
+#endif
+
+/** @brief Connections parked for a listening socket (circular buffer). */
+typedef struct {
+	uint8_t in_use; // 1 if the entry is used by a listening socket
+	int32_t fd; // listening socket
+	int32_t head; // index of the oldest parked connection
+	int32_t count; // number of parked connections
+	int32_t connections[ACCEPT_QUEUE_LENGTH];
+} accept_queue_t;
+
+/*
+ * See implementations for descriptions.
+ */
+static accept_queue_t* accept_queue_get(int32_t fd, bool allocate);
+static void accept_queue_update_rate(int32_t accepted);
+
+/** @brief Queues of the listening sockets. */
+static accept_queue_t accept_queues[ACCEPT_QUEUE_MAX_LISTENERS];
+
+/** @brief Accept statistics. */
+static int64_t accept_stats[ACCEPT_STATS_COUNT];
+
+/** @brief Start time of the current one-second rate window. */
+static int64_t accept_rate_window_start_ms = 0;
+
+/** @brief Connections accepted in the current one-second rate window. */
+static int64_t accept_rate_window_count = 0;
+
+int64_t LLNET_ACCEPT_IMPL_getStatistic(int32_t id){
+	if(id < 0 || id >= ACCEPT_STATS_COUNT){
+		return -1;
+	}
+	// close the current window if it has elapsed
+	accept_queue_update_rate(0);
+	return accept_stats[id];
+}
+
+int32_t accept_queue_accept(int32_t fd){
+	accept_queue_t* queue = accept_queue_get(fd, false);
+
+	if(queue != NULL && queue->count > 0){
+		int32_t connection = queue->connections[queue->head];
+		queue->head = (queue->head + 1) % ACCEPT_QUEUE_LENGTH;
+		queue->count--;
+		return connection;
+	}
+
+	int32_t connection = accept4(fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+	if(connection == -1){
+		return -1;
+	}
+	int32_t accepted = 1;
+
+	// Drain the backlog into the queue
+	if(queue == NULL){
+		queue = accept_queue_get(fd, true);
+	}
+	if(queue != NULL){
+		while(queue->count < ACCEPT_QUEUE_LENGTH){
+			int32_t extra = accept4(fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+			if(extra == -1){
+				// EAGAIN: the backlog is empty. Other errors are reported by the next accept.
+				break;
+			}
+			queue->connections[(queue->head + queue->count) % ACCEPT_QUEUE_LENGTH] = extra;
+			queue->count++;
+			accepted++;
+		}
+		if(queue->count == 0){
+			// nothing parked, free the entry for another listener
+			queue->in_use = 0;
+		}
+	}
+
+	accept_stats[ACCEPT_STAT_ACCEPTED] += accepted;
+	accept_stats[ACCEPT_STAT_QUEUED] += accepted - 1;
+	if(accepted > 1){
+		accept_stats[ACCEPT_STAT_BATCHES]++;
+	}
+	if(accepted > accept_stats[ACCEPT_STAT_MAX_BATCH]){
+		accept_stats[ACCEPT_STAT_MAX_BATCH] = accepted;
+	}
+	accept_queue_update_rate(accepted);
+
+	LLNET_DEBUG_TRACE("%s(fd=0x%X) accepted %d connection(s)\n", __func__, fd, accepted);
+	return connection;
+}
+
+void accept_queue_notify_closed_fd(int32_t fd){
+	accept_queue_t* queue = accept_queue_get(fd, false);
+	if(queue != NULL){
+		for(int32_t i = 0; i < queue->count; i++){
+			close(queue->connections[(queue->head + i) % ACCEPT_QUEUE_LENGTH]);
+		}
+		queue->count = 0;
+		queue->head = 0;
+		queue->in_use = 0;
+	}
+}
+
+/**
+ * @brief Gets the queue of the given listening socket.
+ *
+ * @param[in] fd the listening socket.
+ * @param[in] allocate true to allocate a free queue if the socket has none.
+ *
+ * @return the queue, or NULL if none.
+ */
+static accept_queue_t* accept_queue_get(int32_t fd, bool allocate){
+	accept_queue_t* free_queue = NULL;
+	for(int32_t i = 0; i < ACCEPT_QUEUE_MAX_LISTENERS; i++){
+		if(accept_queues[i].in_use == 1 && accept_queues[i].fd == fd){
+			return &accept_queues[i];
+		}
+		if(free_queue == NULL && accept_queues[i].in_use == 0){
+			free_queue = &accept_queues[i];
+		}
+	}
+	if(allocate && free_queue != NULL){
+		free_queue->in_use = 1;
+		free_queue->fd = fd;
+		free_queue->head = 0;
+		free_queue->count = 0;
+		return free_queue;
+	}
+	return NULL;
+}
+
+/**
+ * @brief Updates the accept rate statistics with newly accepted connections.
+ */
+static void accept_queue_update_rate(int32_t accepted){
+	int64_t now_ms = LLNET_current_time_ms();
+	int64_t elapsed_ms = now_ms - accept_rate_window_start_ms;
+
+	if(elapsed_ms >= 1000){
+		// the previous window has elapsed: it gives the current rate, unless it is older than one window
+		accept_stats[ACCEPT_STAT_RATE] = (elapsed_ms < 2000) ? accept_rate_window_count : 0;
+		if(accept_stats[ACCEPT_STAT_RATE] > accept_stats[ACCEPT_STAT_PEAK_RATE]){
+			accept_stats[ACCEPT_STAT_PEAK_RATE] = accept_stats[ACCEPT_STAT_RATE];
+		}
+		accept_rate_window_start_ms = now_ms;
+		accept_rate_window_count = 0;
+	}
+	accept_rate_window_count += accepted;
+}
+
+#ifdef __cplusplus
+	}
+#endif
@@ -22,6 +22,7 @@
 #include <stdbool.h>
 #include <unistd.h>
 #include "LLNET_Common.h"
+#include "net_stats.h"
 
 #ifdef __cplusplus
 	extern "C" {
@@ -47,6 +48,8 @@ typedef struct async_select_Request{
 	// Absolute time for timeout in milliseconds, 0 if no timeout
 	int64_t absolute_timeout_ms;
 	select_operation operation;
+	// Time of the Java thread suspension in microseconds, for the wait time statistics
+	int64_t suspend_time_us;
 	struct async_select_Request* next;
 } async_select_Request;
 
@@ -216,6 +219,7 @@ int32_t async_select(int32_t fd, select_operation operation, int64_t absolute_ti
 		return -1;
 	}
 
+	request->suspend_time_us = net_stats_on_suspend(fd);
 	async_select_add_new_request(request);
 	return 0;
 }
@@ -583,6 +587,7 @@ static void async_select_free_used_request_by_java_thread_id(int32_t java_thread
 	while(request != NULL){
 		if(request->java_thread_id == java_thread_id){
 			//request found
+			net_stats_on_resume(request->fd, request->suspend_time_us);
 			async_select_free_used_request(request, previous_request);
 			//break here since there is no more than 1 request by java thread id
 			break;
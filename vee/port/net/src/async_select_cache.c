@@ -16,64 +16,24 @@
 #include "async_select_cache.h"
 #include "LLNET_Common.h"
 #include "async_select_configuration.h"
+#include "socket_table.h"
 
 #ifdef __cplusplus
 	extern "C" {
 #endif
 
-/**
- * @brief Socket timeout cache structure
- */
-typedef struct async_select_sock_timeout {
-	int32_t fd;
-	int32_t timeout;
-	int64_t absolute_timeout;
-} async_select_sock_timeout;
-
-/**
- * @brief Cache of socket timeouts. Used to reserve ASYNC_SELECT_TIMEOUT_CACHE_SIZE structures.
+/*
+ * The timeouts are held by the socket table, indexed by file descriptor.
  */
-static async_select_sock_timeout async_select_sockets_timeout_cache[ASYNC_SELECT_TIMEOUT_CACHE_SIZE];
-
-static int32_t async_select_get_socket_index(int32_t fd)
-{
-	int32_t index = -1;
-
-	for (int32_t i = 0; i < ASYNC_SELECT_TIMEOUT_CACHE_SIZE; i++) {
-		if (async_select_sockets_timeout_cache[i].fd == fd) {
-			index = i;
-			break;
-		}
-	}
-	return index;
-}
-
-static int32_t async_select_add_socket_to_cache(int32_t fd)
-{
-	int32_t index = -1;
-	for (int32_t i = 0; i < ASYNC_SELECT_TIMEOUT_CACHE_SIZE; i++) {
-		if (async_select_sockets_timeout_cache[i].fd == -1) {
-			async_select_sockets_timeout_cache[i].fd = fd;
-			index = i;
-			break;
-		}
-	}
-
-	if (index == ASYNC_SELECT_TIMEOUT_CACHE_SIZE) {
-		LLNET_DEBUG_TRACE("async_select_add_socket: too many file descriptors in cache!\n");
-	}
-	return index;
-}
 
 void async_select_remove_socket_timeout_from_cache(int32_t fd)
 {
-	int32_t idx = async_select_get_socket_index(fd);
+	socket_table_entry_t* entry = socket_table_get(fd);
 
 	// check if the file descriptor is valid
-	if (idx >= 0) {
-		async_select_sockets_timeout_cache[idx].fd = -1;
-		async_select_sockets_timeout_cache[idx].timeout = -1;
-		async_select_sockets_timeout_cache[idx].absolute_timeout = -1;
+	if (entry != NULL) {
+		entry->timeout = -1;
+		entry->absolute_timeout = -1;
 	} else {
 		LLNET_DEBUG_TRACE("async_select_remove_socket_timeout_from_cache: invalid file descriptor(%d)!\n", fd);
 	}
@@ -81,20 +41,16 @@ void async_select_remove_socket_timeout_from_cache(int32_t fd)
 
 void async_select_init_socket_timeout_cache(void)
 {
-	for (int32_t i = 0; i < ASYNC_SELECT_TIMEOUT_CACHE_SIZE; i++) {
-		async_select_sockets_timeout_cache[i].fd = -1;
-		async_select_sockets_timeout_cache[i].timeout = -1;
-		async_select_sockets_timeout_cache[i].absolute_timeout = -1;
-	}
+	// nothing to do: the timeouts are reset when a socket is added to the socket table
 }
 
 int32_t async_select_get_socket_timeout_from_cache(int32_t fd)
 {
-	int32_t idx = async_select_get_socket_index(fd);
+	socket_table_entry_t* entry = socket_table_get(fd);
 
 	// check if the file descriptor was found
-	if (idx >= 0) {
-		return async_select_sockets_timeout_cache[idx].timeout;
+	if (entry != NULL) {
+		return entry->timeout;
 	} else {
 		return -1;
 	}
@@ -102,11 +58,11 @@ int32_t async_select_get_socket_timeout_from_cache(int32_t fd)
 
 int64_t async_select_get_socket_absolute_timeout_from_cache(int32_t fd)
 {
-	int32_t idx = async_select_get_socket_index(fd);
+	socket_table_entry_t* entry = socket_table_get(fd);
 
 	// check if the file descriptor was found
-	if (idx >= 0) {
-		return async_select_sockets_timeout_cache[idx].absolute_timeout;
+	if (entry != NULL) {
+		return entry->absolute_timeout;
 	} else {
 		return -1;
 	}
@@ -114,29 +70,29 @@ int64_t async_select_get_socket_absolute_timeout_from_cache(int32_t fd)
 
 void async_select_set_socket_timeout_in_cache(int32_t fd, int32_t timeout)
 {
-	int32_t idx = async_select_get_socket_index(fd);
+	socket_table_entry_t* entry = socket_table_get(fd);
 
 	// check if the file descriptor was found
-	if (idx < 0) {
-		idx = async_select_add_socket_to_cache(fd);
+	if (entry == NULL) {
+		entry = socket_table_add(fd, AF_UNSPEC, 0, false);
 	}
 
-	if (idx >= 0) {
-		async_select_sockets_timeout_cache[idx].timeout = timeout;
+	if (entry != NULL) {
+		entry->timeout = timeout;
 	}
 }
 
 int32_t async_select_set_socket_absolute_timeout_in_cache(int32_t fd, int64_t absolute_timeout)
 {
-	int32_t idx = async_select_get_socket_index(fd);
+	socket_table_entry_t* entry = socket_table_get(fd);
 
 	// check if the file descriptor was found
-	if (idx < 0) {
-		idx = async_select_add_socket_to_cache(fd);
+	if (entry == NULL) {
+		entry = socket_table_add(fd, AF_UNSPEC, 0, false);
 	}
 
-	if (idx >= 0) {
-		async_select_sockets_timeout_cache[idx].absolute_timeout = absolute_timeout;
+	if (entry != NULL) {
+		entry->absolute_timeout = absolute_timeout;
 	} else {
 		return -1;
 	}
@@ -0,0 +1,231 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/**
+ * @file
+ * @brief Low-latency busy-poll mode implementation over Linux poll().
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include "busy_poll.h"
+#include <errno.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/socket.h>
+#include "LLNET_Common.h"
+#include "LLNET_linux_configuration.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/**
+ * Sanity check between the expected version of the configuration and the actual version of
+ * the configuration.
+ * If an error is raised here, it means that a new version of the CCO has been installed and
+ * the configuration LLNET_linux_configuration.h must be updated based on the one provided
+ * by the new CCO version.
+ */
+#if LLNET_LINUX_CONFIGURATION_VERSION != 2
+
+	#error "Version of the configuration file LLNET_linux_configuration.h is not compatible with this implementation."
+
+#endif
+
+/** @brief Busy-poll time allowed per CPU window. */
+#define BUSY_POLL_WINDOW_BUDGET_US	((int64_t)BUSY_POLL_CPU_WINDOW_US * BUSY_POLL_MAX_CPU_PERCENT / 100)
+
+/** @brief Low-latency state of a socket. */
+typedef struct {
+	int32_t fd; // socket file descriptor
+	int32_t budget_us; // maximum busy-poll duration, 0 if the entry is free
+	int32_t estimate_us; // moving average of the readiness delays observed while busy-polling
+	int32_t backoff; // number of waits to skip after the next miss
+	int32_t skip; // remaining waits to skip
+} busy_poll_socket_t;
+
+/*
+ * See implementations for descriptions.
+ */
+static busy_poll_socket_t* busy_poll_get_socket(int32_t fd);
+static int64_t busy_poll_get_time_us(void);
+
+/** @brief Sockets with the low-latency mode enabled. */
+static busy_poll_socket_t busy_poll_sockets[BUSY_POLL_MAX_SOCKETS];
+
+/** @brief Busy-poll statistics. */
+static int64_t busy_poll_stats[BUSY_POLL_STATS_COUNT];
+
+/** @brief Start time of the current CPU window. */
+static int64_t busy_poll_window_start_us = 0;
+
+/** @brief Busy-poll time spent in the current CPU window. */
+static int64_t busy_poll_window_used_us = 0;
+
+int64_t LLNET_BUSY_POLL_IMPL_getStatistic(int32_t id){
+	if(id < 0 || id >= BUSY_POLL_STATS_COUNT){
+		return -1;
+	}
+	return busy_poll_stats[id];
+}
+
+int32_t busy_poll_set_budget(int32_t fd, int32_t budget_us){
+	busy_poll_socket_t* entry = busy_poll_get_socket(fd);
+
+	if(budget_us > BUSY_POLL_MAX_BUDGET_US){
+		budget_us = BUSY_POLL_MAX_BUDGET_US;
+	}
+	if(budget_us <= 0){
+		if(entry != NULL){
+			entry->budget_us = 0;
+		}
+		budget_us = 0;
+	}
+	else {
+		if(entry == NULL){
+			// allocate a free entry
+			entry = busy_poll_get_socket(-1);
+			if(entry == NULL){
+				errno = ENOBUFS;
+				return -1;
+			}
+			entry->fd = fd;
+		}
+		entry->budget_us = budget_us;
+		entry->estimate_us = budget_us / 2;
+		entry->backoff = 0;
+		entry->skip = 0;
+	}
+
+	// Best effort: let the kernel busy-poll the device queue too (requires driver support and may require CAP_NET_ADMIN)
+#ifdef SO_BUSY_POLL
+	(void)llnet_setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &budget_us, sizeof(budget_us));
+#endif
+#ifdef SO_PREFER_BUSY_POLL
+	int32_t prefer = (budget_us != 0) ? 1 : 0;
+	(void)llnet_setsockopt(fd, SOL_SOCKET, SO_PREFER_BUSY_POLL, &prefer, sizeof(prefer));
+#endif
+	return 0;
+}
+
+int32_t busy_poll_get_budget(int32_t fd){
+	busy_poll_socket_t* entry = busy_poll_get_socket(fd);
+	return (entry != NULL) ? entry->budget_us : 0;
+}
+
+bool busy_poll_wait(int32_t fd, select_operation operation){
+	busy_poll_socket_t* entry = busy_poll_get_socket(fd);
+	if(entry == NULL){
+		return false;
+	}
+	if(entry->skip > 0){
+		entry->skip--;
+		busy_poll_stats[BUSY_POLL_STAT_BACKED_OFF]++;
+		return false;
+	}
+
+	int64_t start_us = busy_poll_get_time_us();
+	if(start_us - busy_poll_window_start_us >= BUSY_POLL_CPU_WINDOW_US){
+		busy_poll_window_start_us = start_us;
+		busy_poll_window_used_us = 0;
+	}
+	int64_t allowed_us = BUSY_POLL_WINDOW_BUDGET_US - busy_poll_window_used_us;
+	if(allowed_us <= 0){
+		busy_poll_stats[BUSY_POLL_STAT_CAPPED]++;
+		return false;
+	}
+
+	// Busy-poll a bit longer than the usual readiness delay
+	int64_t spin_us = 2 * (int64_t)entry->estimate_us;
+	if(spin_us > entry->budget_us){
+		spin_us = entry->budget_us;
+	}
+	if(spin_us > allowed_us){
+		spin_us = allowed_us;
+	}
+
+	struct pollfd pfd;
+	pfd.fd = fd;
+	pfd.events = (operation == SELECT_READ) ? POLLIN : POLLOUT;
+	bool ready = false;
+	int64_t elapsed_us;
+	do {
+		pfd.revents = 0;
+		int32_t res = poll(&pfd, 1, 0);
+		elapsed_us = busy_poll_get_time_us() - start_us;
+		if(res > 0){
+			ready = true;
+		}
+		else if(res < 0 && errno != EINTR){
+			// Let async_select report the error; this spin is not a readiness sample
+			busy_poll_window_used_us += elapsed_us;
+			busy_poll_stats[BUSY_POLL_STAT_TIME_US] += elapsed_us;
+			return false;
+		}
+	} while(!ready && elapsed_us < spin_us);
+
+	busy_poll_window_used_us += elapsed_us;
+	busy_poll_stats[BUSY_POLL_STAT_POLLS]++;
+	busy_poll_stats[BUSY_POLL_STAT_TIME_US] += elapsed_us;
+
+	if(ready){
+		busy_poll_stats[BUSY_POLL_STAT_HITS]++;
+		entry->estimate_us = (int32_t)((7 * (int64_t)entry->estimate_us + elapsed_us) / 8);
+		entry->backoff = 0;
+	}
+	else {
+		// The readiness delay is longer than expected: busy-poll the whole budget next time,
+		// after skipping an exponentially growing number of waits.
+		busy_poll_stats[BUSY_POLL_STAT_MISSES]++;
+		entry->estimate_us = (int32_t)((7 * (int64_t)entry->estimate_us + entry->budget_us) / 8);
+		entry->backoff = (entry->backoff == 0) ? 1 : entry->backoff * 2;
+		if(entry->backoff > BUSY_POLL_MAX_BACKOFF){
+			entry->backoff = BUSY_POLL_MAX_BACKOFF;
+		}
+		entry->skip = entry->backoff;
+	}
+	return ready;
+}
+
+void busy_poll_notify_closed_fd(int32_t fd){
+	busy_poll_socket_t* entry = busy_poll_get_socket(fd);
+	if(entry != NULL){
+		entry->budget_us = 0;
+	}
+}
+
+/**
+ * @brief Gets the low-latency state of a socket.
+ *
+ * @param[in] fd the socket file descriptor, or -1 to get a free entry.
+ *
+ * @return the state, or NULL if not found.
+ */
+static busy_poll_socket_t* busy_poll_get_socket(int32_t fd){
+	for(int32_t i = 0; i < BUSY_POLL_MAX_SOCKETS; i++){
+		busy_poll_socket_t* entry = &busy_poll_sockets[i];
+		if(fd == -1 ? (entry->budget_us == 0) : (entry->budget_us != 0 && entry->fd == fd)){
+			return entry;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * @brief Returns the monotonic time in microseconds.
+ */
+static int64_t busy_poll_get_time_us(void){
+	struct timespec now;
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+	return (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+#ifdef __cplusplus
+	}
+#endif
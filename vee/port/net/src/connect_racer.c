@@ -0,0 +1,626 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/**
+ * @file
+ * @brief Connection racer implementation over Linux epoll and async_select.
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include "connect_racer.h"
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include "LLNET_ERRORS.h"
+#include "LLNET_linux_configuration.h"
+#include "async_select.h"
+#include "socket_table.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/**
+ * Sanity check between the expected version of the configuration and the actual version of
+ * the configuration.
+ * If an error is raised here, it means that a new version of the CCO has been installed and
+ * the configuration LLNET_linux_configuration.h must be updated based on the one provided
+ * by the new CCO version.
+ */
+#if LLNET_LINUX_CONFIGURATION_VERSION != 2
+
+	#error "Version of the configuration file LLNET_linux_configuration.h is not compatible with this implementation."
+
+#endif
+
+#ifdef LLNET_USE_CONNECT_RACER
+
+/** @brief A remembered host name resolution. */
+typedef struct {
+	uint32_t hostname_hash; // FNV-1a hash of the host name
+	int64_t time_ms; // time of the resolution, 0 if the entry is free
+	int32_t count; // number of addresses
+	union llnet_sockaddr addresses[CONNECT_RACER_MAX_ADDRESSES]; // addresses, ports are not set
+} connect_racer_resolution_t;
+
+/** @brief A connection race. */
+typedef struct {
+	uint8_t in_use; // 1 if the race is in progress
+	int32_t java_fd; // the Java socket, -1 if it has been closed during the race
+	int32_t domain; // the Java socket domain, used to open the other attempts
+	int32_t epoll_fd; // monitors the attempts in progress
+	int32_t count; // number of candidates
+	int32_t next; // index of the next candidate to try
+	int32_t attempts_count; // number of attempts in progress
+	int32_t attempts[CONNECT_RACER_MAX_ATTEMPTS]; // file descriptors of the attempts in progress
+	int32_t last_error; // errno of the last failed attempt
+	int64_t next_attempt_time_ms; // time at which the next attempt must be started
+	int64_t absolute_timeout_ms; // Java connect timeout, 0 if none
+	union llnet_sockaddr candidates[CONNECT_RACER_MAX_ATTEMPTS]; // addresses to try, in order
+} connect_racer_t;
+
+/** @brief A socket option copied from the Java socket to the other attempts. */
+typedef struct {
+	int level;
+	int name;
+} connect_racer_option_t;
+
+/**
+ * @brief Options copied from the Java socket to the other attempts.
+ * SO_RCVBUF and SO_SNDBUF are not copied: setting them disables the TCP buffers auto-tuning.
+ */
+static const connect_racer_option_t connect_racer_copied_options[] = {
+	{SOL_SOCKET, SO_KEEPALIVE},
+	{SOL_SOCKET, SO_OOBINLINE},
+	{SOL_SOCKET, SO_LINGER},
+	{SOL_SOCKET, SO_REUSEADDR},
+	{IPPROTO_TCP, TCP_NODELAY},
+	{IPPROTO_TCP, TCP_FASTOPEN_CONNECT},
+	{IPPROTO_IP, IP_TOS},
+#if LLNET_AF & LLNET_AF_IPV6
+	{IPPROTO_IPV6, IPV6_V6ONLY},
+#endif
+};
+
+/*
+ * See implementations for descriptions.
+ */
+static void connect_racer_callback(int32_t fd, int8_t* addr, int32_t length, int32_t port, int64_t absoluteTimeout);
+static void connect_racer_run(connect_racer_t* race);
+static int32_t connect_racer_start_attempt(connect_racer_t* race, int64_t now_ms);
+static int32_t connect_racer_check_attempts(connect_racer_t* race, int64_t now_ms);
+static void connect_racer_remove_attempt(connect_racer_t* race, int32_t fd);
+static int32_t connect_racer_open_socket(connect_racer_t* race);
+static void connect_racer_free(connect_racer_t* race);
+static int32_t connect_racer_build_candidates(connect_racer_t* race, const connect_racer_resolution_t* resolution, const union llnet_sockaddr* sockaddr);
+static const connect_racer_resolution_t* connect_racer_find_resolution(const union llnet_sockaddr* sockaddr);
+static bool connect_racer_is_same_address(const union llnet_sockaddr* a, const union llnet_sockaddr* b);
+static int32_t connect_racer_get_family(const union llnet_sockaddr* sockaddr);
+static socklen_t connect_racer_get_length(const union llnet_sockaddr* sockaddr);
+static uint32_t connect_racer_hash(const uint8_t* hostname);
+
+/** @brief Remembered host name resolutions. */
+static connect_racer_resolution_t connect_racer_resolutions[CONNECT_RACER_RESOLUTIONS_CACHE_SIZE];
+
+/** @brief Races pool. */
+static connect_racer_t connect_racer_races[CONNECT_RACER_MAX_RACES];
+
+void connect_racer_record_resolution(const uint8_t* hostname, const struct addrinfo* addrinfos){
+	uint32_t hash = connect_racer_hash(hostname);
+	connect_racer_resolution_t* resolution = &connect_racer_resolutions[0];
+
+	// Replace the previous resolution of this host, or else the oldest one
+	for(int32_t i = 0; i < CONNECT_RACER_RESOLUTIONS_CACHE_SIZE; i++){
+		connect_racer_resolution_t* current = &connect_racer_resolutions[i];
+		if(current->time_ms != 0 && current->hostname_hash == hash){
+			resolution = current;
+			break;
+		}
+		if(current->time_ms < resolution->time_ms){
+			resolution = current;
+		}
+	}
+
+	resolution->hostname_hash = hash;
+	resolution->time_ms = LLNET_current_time_ms();
+	resolution->count = 0;
+	for(const struct addrinfo* ai = addrinfos; ai != NULL && resolution->count < CONNECT_RACER_MAX_ADDRESSES; ai = ai->ai_next){
+		union llnet_sockaddr address;
+		(void)memset(&address, 0, sizeof(address));
+#if LLNET_AF & LLNET_AF_IPV4
+		if(ai->ai_family == AF_INET){
+			address.in.sin_family = AF_INET;
+			address.in.sin_addr = ((struct sockaddr_in*)ai->ai_addr)->sin_addr;
+		}
+#endif
+#if LLNET_AF & LLNET_AF_IPV6
+		if(ai->ai_family == AF_INET6){
+			address.in6.sin6_family = AF_INET6;
+			address.in6.sin6_addr = ((struct sockaddr_in6*)ai->ai_addr)->sin6_addr;
+		}
+#endif
+		if(address.addr.sa_family == 0){
+			continue;
+		}
+		// getaddrinfo() returns the same address once per socket type
+		bool duplicate = false;
+		for(int32_t i = 0; i < resolution->count; i++){
+			if(connect_racer_is_same_address(&resolution->addresses[i], &address)){
+				duplicate = true;
+				break;
+			}
+		}
+		if(!duplicate){
+			resolution->addresses[resolution->count] = address;
+			resolution->count++;
+		}
+	}
+}
+
+int32_t connect_racer_connect(int32_t fd, const union llnet_sockaddr* sockaddr, int32_t sockaddr_length, int64_t absolute_timeout_ms){
+	(void)sockaddr_length;
+
+	const connect_racer_resolution_t* resolution = connect_racer_find_resolution(sockaddr);
+	if(resolution == NULL || resolution->count < 2){
+		// no alternative address known
+		return 0;
+	}
+
+	// Only race unbound stream sockets: a local address or port cannot be shared between the attempts
+	union llnet_sockaddr local;
+	if(socket_table_get_type(fd) != SOCK_STREAM){
+		return 0;
+	}
+	int32_t domain = socket_table_get_family(fd);
+	if(domain == -1){
+		return 0;
+	}
+	if(socket_table_get_address(fd, &local, true) != 0){
+		return 0;
+	}
+#if LLNET_AF & LLNET_AF_IPV4
+	if(local.addr.sa_family == AF_INET && local.in.sin_port != 0){
+		return 0;
+	}
+#endif
+#if LLNET_AF & LLNET_AF_IPV6
+	if(local.addr.sa_family == AF_INET6 && local.in6.sin6_port != 0){
+		return 0;
+	}
+#endif
+
+	connect_racer_t* race = NULL;
+	for(int32_t i = 0; i < CONNECT_RACER_MAX_RACES; i++){
+		if(connect_racer_races[i].in_use == 0){
+			race = &connect_racer_races[i];
+			break;
+		}
+	}
+	if(race == NULL){
+		LLNET_DEBUG_TRACE("%s: no race available, simple connect on fd=0x%X\n", __func__, fd);
+		return 0;
+	}
+
+	(void)memset(race, 0, sizeof(connect_racer_t));
+	race->java_fd = fd;
+	race->domain = domain;
+	race->absolute_timeout_ms = absolute_timeout_ms;
+	race->count = connect_racer_build_candidates(race, resolution, sockaddr);
+	race->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if(race->epoll_fd == -1){
+		return 0;
+	}
+	race->in_use = 1;
+
+	LLNET_DEBUG_TRACE("%s: race %d candidates on fd=0x%X\n", __func__, race->count, fd);
+	connect_racer_run(race);
+	return 1;
+}
+
+void connect_racer_notify_closed_fd(int32_t fd){
+	for(int32_t i = 0; i < CONNECT_RACER_MAX_RACES; i++){
+		connect_racer_t* race = &connect_racer_races[i];
+		if(race->in_use == 1 && race->java_fd == fd){
+			// The file descriptor is already closed: forget it without closing it again
+			for(int32_t j = 0; j < race->attempts_count; j++){
+				if(race->attempts[j] == fd){
+					race->attempts_count--;
+					race->attempts[j] = race->attempts[race->attempts_count];
+					break;
+				}
+			}
+			race->java_fd = -1;
+			// wake up the racing Java thread
+			async_select_notify_closed_fd(race->epoll_fd);
+		}
+	}
+}
+
+/**
+ * @brief SNI callback called when the racing Java thread is resumed.
+ * The arguments are the ones of LLNET_SOCKETCHANNEL_IMPL_connect(); the race is the SNI callback argument.
+ */
+static void connect_racer_callback(int32_t fd, int8_t* addr, int32_t length, int32_t port, int64_t absoluteTimeout){
+	(void)fd;
+	(void)addr;
+	(void)length;
+	(void)port;
+	(void)absoluteTimeout;
+	connect_racer_t* race = NULL;
+	SNI_getCallbackArgs((void**)&race, NULL);
+	connect_racer_run(race);
+}
+
+/**
+ * @brief Makes the race progress: checks the attempts in progress, starts the next attempt when it is time
+ * and suspends the Java thread until something happens.
+ * Frees the race when it ends.
+ */
+static void connect_racer_run(connect_racer_t* race){
+	int32_t winner = -1;
+
+	while(true){
+		int64_t now_ms = LLNET_current_time_ms();
+
+		if(race->java_fd == -1){
+			connect_racer_free(race);
+			SNI_throwNativeIOException(J_EBADF, "socket closed");
+			return;
+		}
+		winner = connect_racer_check_attempts(race, now_ms);
+		if(winner != -1){
+			break;
+		}
+		if(race->absolute_timeout_ms != 0 && race->absolute_timeout_ms <= now_ms){
+			connect_racer_free(race);
+			SNI_throwNativeIOException(J_ETIMEDOUT, "timeout");
+			return;
+		}
+		if(race->next < race->count && (race->attempts_count == 0 || race->next_attempt_time_ms <= now_ms)){
+			winner = connect_racer_start_attempt(race, now_ms);
+			if(winner != -1){
+				break;
+			}
+			// check again, the next attempt starts now if this one failed immediately
+			continue;
+		}
+		if(race->attempts_count == 0){
+			// all the attempts failed
+			int32_t error = race->last_error;
+			connect_racer_free(race);
+			SNI_throwNativeIOException(LLNET_map_to_java_exception(error), LLNET_get_socket_error_msg(error));
+			return;
+		}
+
+		// Wait until an attempt completes, the next attempt must start or the connect timeout is reached
+		int64_t wakeup_time_ms = race->absolute_timeout_ms;
+		if(race->next < race->count && (wakeup_time_ms == 0 || race->next_attempt_time_ms < wakeup_time_ms)){
+			wakeup_time_ms = race->next_attempt_time_ms;
+		}
+		if(async_select(race->epoll_fd, SELECT_READ, wakeup_time_ms, (SNI_callback)connect_racer_callback, race) != 0){
+			// exception already thrown
+			connect_racer_free(race);
+		}
+		return;
+	}
+
+	LLNET_DEBUG_TRACE("%s: fd=0x%X won by attempt fd=0x%X\n", __func__, race->java_fd, winner);
+	int32_t error = 0;
+	if(winner != race->java_fd && dup2(winner, race->java_fd) == -1){
+		error = errno;
+	}
+	connect_racer_free(race);
+	if(error != 0){
+		SNI_throwNativeIOException(LLNET_map_to_java_exception(error), LLNET_get_socket_error_msg(error));
+	}
+}
+
+/**
+ * @brief Starts a connection attempt to the next candidate.
+ *
+ * @return the attempt file descriptor if it is connected immediately, -1 otherwise.
+ */
+static int32_t connect_racer_start_attempt(connect_racer_t* race, int64_t now_ms){
+	const union llnet_sockaddr* candidate = &race->candidates[race->next];
+	// The Java socket is used for the first attempt so that it keeps all its options if it wins
+	int32_t fd = (race->next == 0) ? race->java_fd : connect_racer_open_socket(race);
+	race->next++;
+	race->next_attempt_time_ms = now_ms + CONNECT_RACER_ATTEMPT_DELAY_MS;
+
+	int32_t error = 0;
+	if(fd == -1){
+		error = errno;
+	}
+	else if(llnet_connect(fd, &candidate->addr, connect_racer_get_length(candidate)) == 0){
+		return fd;
+	}
+	else if(errno != EINPROGRESS){
+		error = errno;
+	}
+	else {
+		struct epoll_event event = {0};
+		event.events = EPOLLOUT;
+		event.data.fd = fd;
+		if(epoll_ctl(race->epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0){
+			race->attempts[race->attempts_count] = fd;
+			race->attempts_count++;
+			return -1;
+		}
+		error = errno;
+	}
+
+	LLNET_DEBUG_TRACE("%s: attempt %d failed errno=%d\n", __func__, race->next - 1, error);
+	race->last_error = error;
+	// The next attempt starts immediately
+	race->next_attempt_time_ms = now_ms;
+	if(fd != -1 && fd != race->java_fd){
+		close(fd);
+	}
+	return -1;
+}
+
+/**
+ * @brief Checks the attempts in progress. The failed ones are removed.
+ *
+ * @return the file descriptor of a connected attempt, -1 if none.
+ */
+static int32_t connect_racer_check_attempts(connect_racer_t* race, int64_t now_ms){
+	struct epoll_event events[CONNECT_RACER_MAX_ATTEMPTS];
+	int32_t count = epoll_wait(race->epoll_fd, events, CONNECT_RACER_MAX_ATTEMPTS, 0);
+
+	for(int32_t i = 0; i < count; i++){
+		int32_t fd = events[i].data.fd;
+		int32_t error_status = 0;
+		socklen_t error_status_size = sizeof(error_status);
+		if(llnet_getsockopt(fd, SOL_SOCKET, SO_ERROR, &error_status, &error_status_size) != 0){
+			error_status = errno;
+		}
+		if(error_status == 0 && (events[i].events & (EPOLLERR | EPOLLHUP)) == 0){
+			return fd;
+		}
+		race->last_error = (error_status != 0) ? error_status : ECONNRESET;
+		// The next attempt starts immediately
+		race->next_attempt_time_ms = now_ms;
+		connect_racer_remove_attempt(race, fd);
+	}
+	return -1;
+}
+
+/**
+ * @brief Removes an attempt from the race and closes it unless it is the Java socket.
+ */
+static void connect_racer_remove_attempt(connect_racer_t* race, int32_t fd){
+	(void)epoll_ctl(race->epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+	for(int32_t i = 0; i < race->attempts_count; i++){
+		if(race->attempts[i] == fd){
+			race->attempts_count--;
+			race->attempts[i] = race->attempts[race->attempts_count];
+			break;
+		}
+	}
+	if(fd != race->java_fd){
+		close(fd);
+	}
+}
+
+/**
+ * @brief Opens a non-blocking socket for an attempt, with the options of the Java socket.
+ *
+ * @return the socket file descriptor, or -1 on error.
+ */
+static int32_t connect_racer_open_socket(connect_racer_t* race){
+	int32_t fd = llnet_socket(race->domain, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if(fd == -1){
+		return -1;
+	}
+	if(LLNET_set_non_blocking(fd) != 0){
+		int32_t error = errno;
+		close(fd);
+		errno = error;
+		return -1;
+	}
+
+	for(uint32_t i = 0; i < sizeof(connect_racer_copied_options) / sizeof(connect_racer_option_t); i++){
+		uint8_t value[sizeof(struct linger)];
+		socklen_t value_length = sizeof(value);
+		const connect_racer_option_t* option = &connect_racer_copied_options[i];
+		if(llnet_getsockopt(race->java_fd, option->level, option->name, value, &value_length) == 0){
+			// best effort: the attempt is still valid without this option
+			(void)llnet_setsockopt(fd, option->level, option->name, value, value_length);
+		}
+	}
+	return fd;
+}
+
+/**
+ * @brief Frees a race: closes the epoll file descriptor and all the attempts but the Java socket.
+ */
+static void connect_racer_free(connect_racer_t* race){
+	close(race->epoll_fd);
+	for(int32_t i = 0; i < race->attempts_count; i++){
+		if(race->attempts[i] != race->java_fd){
+			close(race->attempts[i]);
+		}
+	}
+	race->attempts_count = 0;
+	race->in_use = 0;
+}
+
+/**
+ * @brief Fills the race candidates: the requested address first, then the other addresses of the host
+ * alternating the address families (RFC 8305 section 4).
+ *
+ * @return the number of candidates.
+ */
+static int32_t connect_racer_build_candidates(connect_racer_t* race, const connect_racer_resolution_t* resolution, const union llnet_sockaddr* sockaddr){
+	bool used[CONNECT_RACER_MAX_ADDRESSES] = {false};
+	int32_t count = 0;
+	int32_t last_family = connect_racer_get_family(sockaddr);
+
+	race->candidates[count] = *sockaddr;
+	count++;
+	for(int32_t i = 0; i < resolution->count; i++){
+		if(connect_racer_is_same_address(&resolution->addresses[i], sockaddr)){
+			used[i] = true;
+		}
+	}
+
+	while(count < CONNECT_RACER_MAX_ATTEMPTS){
+		int32_t pick = -1;
+		for(int32_t i = 0; i < resolution->count; i++){
+			if(!used[i]){
+				if(pick == -1){
+					pick = i;
+				}
+				if(connect_racer_get_family(&resolution->addresses[i]) != last_family){
+					pick = i;
+					break;
+				}
+			}
+		}
+		if(pick == -1){
+			break;
+		}
+		used[pick] = true;
+		last_family = connect_racer_get_family(&resolution->addresses[pick]);
+
+		union llnet_sockaddr* candidate = &race->candidates[count];
+		*candidate = resolution->addresses[pick];
+#if LLNET_AF & LLNET_AF_IPV4
+		if(candidate->addr.sa_family == AF_INET){
+			candidate->in.sin_port = sockaddr->in.sin_port;
+		}
+#endif
+#if LLNET_AF & LLNET_AF_IPV6
+		if(candidate->addr.sa_family == AF_INET6){
+			char ipAddress[INET6_ADDRSTRLEN];
+			candidate->in6.sin6_port = sockaddr->in6.sin6_port;
+			// Same scope ID lookup as LLNET_SOCKETCHANNEL_IMPL_connect()
+			if(inet_ntop(AF_INET6, &candidate->in6.sin6_addr, ipAddress, sizeof(ipAddress)) != NULL){
+				candidate->in6.sin6_scope_id = LLNET_getScopeForIp(ipAddress);
+			}
+		}
+#endif
+		count++;
+	}
+	return count;
+}
+
+/**
+ * @brief Finds the most recent resolution that returned the given address.
+ *
+ * @return the resolution, or NULL if not found.
+ */
+static const connect_racer_resolution_t* connect_racer_find_resolution(const union llnet_sockaddr* sockaddr){
+	const connect_racer_resolution_t* found = NULL;
+	int64_t now_ms = LLNET_current_time_ms();
+
+	for(int32_t i = 0; i < CONNECT_RACER_RESOLUTIONS_CACHE_SIZE; i++){
+		const connect_racer_resolution_t* resolution = &connect_racer_resolutions[i];
+		if(resolution->time_ms == 0 || (now_ms - resolution->time_ms) > CONNECT_RACER_RESOLUTION_LIFETIME_MS){
+			continue;
+		}
+		if(found != NULL && found->time_ms >= resolution->time_ms){
+			continue;
+		}
+		for(int32_t j = 0; j < resolution->count; j++){
+			if(connect_racer_is_same_address(&resolution->addresses[j], sockaddr)){
+				found = resolution;
+				break;
+			}
+		}
+	}
+	return found;
+}
+
+/**
+ * @brief Returns true if the two socket addresses have the same family and IP address (ports are ignored).
+ */
+static bool connect_racer_is_same_address(const union llnet_sockaddr* a, const union llnet_sockaddr* b){
+	if(a->addr.sa_family != b->addr.sa_family){
+		return false;
+	}
+#if LLNET_AF & LLNET_AF_IPV4
+	if(a->addr.sa_family == AF_INET){
+		return a->in.sin_addr.s_addr == b->in.sin_addr.s_addr;
+	}
+#endif
+#if LLNET_AF & LLNET_AF_IPV6
+	if(a->addr.sa_family == AF_INET6){
+		return 0 == memcmp(&a->in6.sin6_addr, &b->in6.sin6_addr, sizeof(struct in6_addr));
+	}
+#endif
+	return false;
+}
+
+/**
+ * @brief Returns the IP family of the given address, IPv4-mapped IPv6 addresses being IPv4.
+ */
+static int32_t connect_racer_get_family(const union llnet_sockaddr* sockaddr){
+#if LLNET_AF & LLNET_AF_IPV6
+	if(sockaddr->addr.sa_family == AF_INET6 && IN6_IS_ADDR_V4MAPPED(&sockaddr->in6.sin6_addr)){
+		return AF_INET;
+	}
+#endif
+	return sockaddr->addr.sa_family;
+}
+
+/**
+ * @brief Returns the length of the given socket address.
+ */
+static socklen_t connect_racer_get_length(const union llnet_sockaddr* sockaddr){
+#if LLNET_AF & LLNET_AF_IPV6
+	if(sockaddr->addr.sa_family == AF_INET6){
+		return sizeof(struct sockaddr_in6);
+	}
+#endif
+	return sizeof(struct sockaddr_in);
+}
+
+/**
+ * @brief Returns the FNV-1a hash of the given null terminated host name.
+ */
+static uint32_t connect_racer_hash(const uint8_t* hostname){
+	uint32_t hash = 2166136261u;
+	for(const uint8_t* c = hostname; *c != '\0'; c++){
+		hash ^= *c;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+#else // LLNET_USE_CONNECT_RACER
+
+void connect_racer_record_resolution(const uint8_t* hostname, const struct addrinfo* addrinfos){
+	(void)hostname;
+	(void)addrinfos;
+}
+
+int32_t connect_racer_connect(int32_t fd, const union llnet_sockaddr* sockaddr, int32_t sockaddr_length, int64_t absolute_timeout_ms){
+	(void)fd;
+	(void)sockaddr;
+	(void)sockaddr_length;
+	(void)absolute_timeout_ms;
+	return 0;
+}
+
+void connect_racer_notify_closed_fd(int32_t fd){
+	(void)fd;
+}
+
+#endif // LLNET_USE_CONNECT_RACER
+
+#ifdef __cplusplus
+	}
+#endif
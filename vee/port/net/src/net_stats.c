@@ -0,0 +1,155 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/**
+ * @file
+ * @brief Network I/O statistics implementation.
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include "net_stats.h"
+#include <stdio.h>
+#include <time.h>
+#include "sighandler.h"
+#include "socket_table.h"
+#include "LLNET_Common.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/*
+ * See implementations for descriptions.
+ */
+static void net_stats_add(int32_t fd, net_stat_t id, int64_t value);
+static int64_t net_stats_get_time_us(void);
+
+/** @brief Global statistics. */
+static int64_t net_stats[NET_STATS_COUNT];
+
+/** @brief Names of the statistics, for the dump. */
+static const char* const net_stats_names[NET_STAT_WAIT_HISTOGRAM] = {
+	"receive calls", "send calls", "bytes received", "bytes sent", "datagrams received", "datagrams sent",
+	"EAGAIN", "suspends", "resumes", "wait time (us)", "max wait time (us)"
+};
+
+int64_t LLNET_STATS_IMPL_getStatistic(int32_t fd, int32_t id){
+	if(id < 0 || id >= NET_STATS_COUNT){
+		return -1;
+	}
+	if(fd == -1){
+		return net_stats[id];
+	}
+	socket_table_entry_t* entry = socket_table_get(fd);
+	return (entry != NULL) ? entry->stats[id] : -1;
+}
+
+void net_stats_init(void){
+	if(microej_usr1_signal_register_dump(net_stats_dump) != 0){
+		LLNET_DEBUG_TRACE("%s: cannot register the SIGUSR1 dump\n", __func__);
+	}
+}
+
+void net_stats_on_receive(int32_t fd, int32_t result, bool datagram){
+	net_stats_add(fd, NET_STAT_RECEIVE_CALLS, 1);
+	if(result >= 0){
+		net_stats_add(fd, NET_STAT_BYTES_RECEIVED, result);
+		if(datagram){
+			net_stats_add(fd, NET_STAT_DATAGRAMS_RECEIVED, 1);
+		}
+	}
+}
+
+void net_stats_on_send(int32_t fd, int32_t result, bool datagram){
+	net_stats_add(fd, NET_STAT_SEND_CALLS, 1);
+	if(result >= 0){
+		net_stats_add(fd, NET_STAT_BYTES_SENT, result);
+		if(datagram){
+			net_stats_add(fd, NET_STAT_DATAGRAMS_SENT, 1);
+		}
+	}
+}
+
+void net_stats_on_eagain(int32_t fd){
+	net_stats_add(fd, NET_STAT_EAGAIN, 1);
+}
+
+int64_t net_stats_on_suspend(int32_t fd){
+	net_stats_add(fd, NET_STAT_SUSPENDS, 1);
+	return net_stats_get_time_us();
+}
+
+void net_stats_on_resume(int32_t fd, int64_t suspend_time_us){
+	int64_t wait_us = net_stats_get_time_us() - suspend_time_us;
+	if(wait_us < 0){
+		wait_us = 0;
+	}
+
+	int32_t bucket = 0;
+	for(int64_t value = wait_us >> 7; value > 0 && bucket < NET_STATS_WAIT_BUCKETS - 1; value >>= 1){
+		bucket++;
+	}
+
+	net_stats_add(fd, NET_STAT_RESUMES, 1);
+	net_stats_add(fd, NET_STAT_WAIT_TIME_US, wait_us);
+	net_stats_add(fd, (net_stat_t)(NET_STAT_WAIT_HISTOGRAM + bucket), 1);
+	if(wait_us > net_stats[NET_STAT_MAX_WAIT_TIME_US]){
+		net_stats[NET_STAT_MAX_WAIT_TIME_US] = wait_us;
+	}
+	socket_table_entry_t* entry = socket_table_get(fd);
+	if(entry != NULL && wait_us > entry->stats[NET_STAT_MAX_WAIT_TIME_US]){
+		entry->stats[NET_STAT_MAX_WAIT_TIME_US] = wait_us;
+	}
+}
+
+void net_stats_dump(void){
+	fprintf(stdout, "================================ Network stats ================================\n");
+	for(int32_t i = 0; i < NET_STAT_WAIT_HISTOGRAM; i++){
+		fprintf(stdout, "%s: %lld\n", net_stats_names[i], (long long)net_stats[i]);
+	}
+	fprintf(stdout, "wait time histogram:\n");
+	for(int32_t i = 0; i < NET_STATS_WAIT_BUCKETS; i++){
+		if(i == 0){
+			fprintf(stdout, "  < %lld us: ", 128LL);
+		}
+		else if(i == NET_STATS_WAIT_BUCKETS - 1){
+			fprintf(stdout, "  >= %lld us: ", 64LL << i);
+		}
+		else {
+			fprintf(stdout, "  %lld - %lld us: ", 64LL << i, 128LL << i);
+		}
+		fprintf(stdout, "%lld\n", (long long)net_stats[NET_STAT_WAIT_HISTOGRAM + i]);
+	}
+	fprintf(stdout, "===============================================================================\n");
+	fflush(stdout);
+}
+
+/**
+ * @brief Adds a value to a global statistic and to the statistic of the socket, if in the socket table.
+ */
+static void net_stats_add(int32_t fd, net_stat_t id, int64_t value){
+	net_stats[id] += value;
+	socket_table_entry_t* entry = socket_table_get(fd);
+	if(entry != NULL){
+		entry->stats[id] += value;
+	}
+}
+
+/**
+ * @brief Returns the monotonic time in microseconds.
+ */
+static int64_t net_stats_get_time_us(void){
+	struct timespec now;
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+	return (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+#ifdef __cplusplus
+	}
+#endif
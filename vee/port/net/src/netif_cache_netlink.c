@@ -0,0 +1,680 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/**
+ * @file
+ * @brief Network interface information cache implementation over Linux NETLINK_ROUTE sockets.
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include "netif_cache.h"
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/if_addr.h>
+#include "LLNET_Common.h"
+#include "osal.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/**
+ * Sanity check between the expected version of the configuration and the actual version of
+ * the configuration.
+ * If an error is raised here, it means that a new version of the CCO has been installed and
+ * the configuration LLNET_linux_configuration.h must be updated based on the one provided
+ * by the new CCO version.
+ */
+#if LLNET_LINUX_CONFIGURATION_VERSION != 2
+
+	#error "Version of the configuration file LLNET_linux_configuration.h is not compatible with this implementation."
+
+#endif
+
+/** @brief Netlink multicast groups the listener task subscribes to. */
+#define NETIF_CACHE_NETLINK_GROUPS (RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR)
+
+/*
+ * See implementations for descriptions.
+ */
+static void* netif_cache_task_main(void* args);
+static int32_t netif_cache_lock(void);
+static void netif_cache_unlock(void);
+static int32_t netif_cache_open_netlink(uint32_t groups);
+static int32_t netif_cache_refresh(void);
+static int32_t netif_cache_dump(int32_t fd, uint16_t type);
+static void netif_cache_handle_message(const struct nlmsghdr* nlh);
+static void netif_cache_handle_link(const struct nlmsghdr* nlh);
+static void netif_cache_handle_address(const struct nlmsghdr* nlh);
+static int32_t netif_cache_find_link(int32_t if_index);
+static int32_t netif_cache_find_address(int32_t if_index, uint8_t family, const uint8_t* addr);
+static void netif_cache_remove_link_addresses(int32_t if_index);
+static bool netif_cache_is_family_enabled(uint8_t family);
+static uint8_t netif_cache_get_address_length(uint8_t family);
+
+/**
+ * @brief Links, sorted by interface index.
+ */
+static netif_cache_link_t netif_cache_links[NETIF_CACHE_MAX_LINKS];
+static int32_t netif_cache_links_count = 0;
+
+/**
+ * @brief Addresses, in the order they have been reported by the kernel.
+ */
+static netif_cache_address_t netif_cache_addresses[NETIF_CACHE_MAX_ADDRESSES];
+static int32_t netif_cache_addresses_count = 0;
+
+/**
+ * @brief Buffer used to receive the dump responses. Protected by the cache mutex.
+ * Declared as uint32_t to guarantee the alignment required by the netlink headers.
+ */
+static uint32_t netif_cache_dump_buffer[NETIF_CACHE_NETLINK_BUFFER_SIZE / sizeof(uint32_t)];
+
+/**
+ * @brief Buffer used by the listener task to receive the notifications.
+ */
+static uint32_t netif_cache_listen_buffer[NETIF_CACHE_NETLINK_BUFFER_SIZE / sizeof(uint32_t)];
+
+/**
+ * @brief Sequence number of the last dump request.
+ */
+static uint32_t netif_cache_dump_seq = 0;
+
+/**
+ * @brief Netlink socket subscribed to the link and address notifications, -1 if none.
+ */
+static int32_t netif_cache_listen_fd = -1;
+
+/**
+ * @brief Set to one while the listener task keeps the cache up to date.
+ * When zero, the cache is refreshed on each query.
+ */
+static volatile uint8_t netif_cache_listening = 0;
+
+/**
+ * @brief Set to one once a dump has succeeded and the cache holds a complete snapshot.
+ * While zero, the cache is refreshed on each query, even if the listener task is running.
+ */
+static volatile uint8_t netif_cache_synchronized = 0;
+
+/**
+ * @brief Set to one once the cache is initialized.
+ */
+static uint8_t netif_cache_initialized = 0;
+
+/**
+ * @brief Mutex used for critical sections.
+ */
+static OSAL_mutex_handle_t netif_cache_mutex;
+
+/**
+ * @brief Listener OS task.
+ */
+static OSAL_task_handle_t netif_cache_task;
+
+/**
+ * @brief Stack of the listener task.
+ */
+OSAL_task_stack_declare(netif_cache_task_stack, NETIF_CACHE_TASK_STACK_SIZE);
+
+int32_t netif_cache_init(void){
+	if(netif_cache_initialized == 1){
+		return 0;
+	}
+
+	if(OSAL_OK != OSAL_mutex_create(NETIF_CACHE_MUTEX_NAME, &netif_cache_mutex)){
+		return -1;
+	}
+
+	// Subscribe to the notifications before the dump so that no change can be missed:
+	// notifications received during the dump are applied afterwards and are idempotent.
+	netif_cache_listen_fd = netif_cache_open_netlink(NETIF_CACHE_NETLINK_GROUPS);
+
+	OSAL_mutex_take(&netif_cache_mutex, OSAL_INFINITE_TIME);
+	int32_t res = netif_cache_refresh();
+	OSAL_mutex_give(&netif_cache_mutex);
+	if(res != 0){
+		LLNET_DEBUG_TRACE("%s: initial dump failed (errno=%d), refresh on each query until a dump succeeds\n", __func__, errno);
+	}
+
+	if(netif_cache_listen_fd != -1){
+		netif_cache_listening = 1;
+		if(OSAL_OK != OSAL_task_create(netif_cache_task_main, NETIF_CACHE_TASK_NAME, netif_cache_task_stack, NETIF_CACHE_TASK_PRIORITY, NULL, &netif_cache_task)){
+			netif_cache_listening = 0;
+			close(netif_cache_listen_fd);
+			netif_cache_listen_fd = -1;
+		}
+	}
+	if(netif_cache_listening == 0){
+		LLNET_DEBUG_TRACE("%s: WARNING: no netlink listener, fall back to a dump on each query\n", __func__);
+	}
+
+	netif_cache_initialized = 1;
+	return 0;
+}
+
+int32_t netif_cache_get_links_count(void){
+	if(netif_cache_lock() != 0){
+		return -1;
+	}
+	int32_t count = netif_cache_links_count;
+	netif_cache_unlock();
+	return count;
+}
+
+int32_t netif_cache_get_link(int32_t id, netif_cache_link_t* link){
+	if(netif_cache_lock() != 0){
+		return -1;
+	}
+	int32_t res = -1;
+	if(id >= 0 && id < netif_cache_links_count){
+		*link = netif_cache_links[id];
+		res = 0;
+	}
+	netif_cache_unlock();
+	return res;
+}
+
+int32_t netif_cache_get_link_by_name(const uint8_t* name, int32_t length, netif_cache_link_t* link){
+	if(length <= 0 || length >= IF_NAMESIZE){
+		// interface name is too long
+		return -1;
+	}
+	if(netif_cache_lock() != 0){
+		return -1;
+	}
+	int32_t res = -1;
+	for(int32_t i = 0; i < netif_cache_links_count; i++){
+		const char* link_name = netif_cache_links[i].name;
+		if(0 == strncmp(link_name, (const char*)name, length) && link_name[length] == '\0'){
+			*link = netif_cache_links[i];
+			res = 0;
+			break;
+		}
+	}
+	netif_cache_unlock();
+	return res;
+}
+
+int32_t netif_cache_get_addresses_count(int32_t if_index){
+	if(netif_cache_lock() != 0){
+		return -1;
+	}
+	int32_t count = 0;
+	for(int32_t i = 0; i < netif_cache_addresses_count; i++){
+		if(netif_cache_addresses[i].if_index == if_index){
+			count++;
+		}
+	}
+	netif_cache_unlock();
+	return count;
+}
+
+int32_t netif_cache_get_address(int32_t if_index, int32_t id, netif_cache_address_t* address){
+	if(netif_cache_lock() != 0){
+		return -1;
+	}
+	int32_t res = -1;
+	int32_t count = 0;
+	for(int32_t i = 0; i < netif_cache_addresses_count; i++){
+		if(netif_cache_addresses[i].if_index == if_index){
+			if(count == id){
+				*address = netif_cache_addresses[i];
+				res = 0;
+				break;
+			}
+			count++;
+		}
+	}
+	netif_cache_unlock();
+	return res;
+}
+
+uint32_t netif_cache_get_index_by_address(int32_t family, const void* addr){
+	if(netif_cache_lock() != 0){
+		return 0;
+	}
+	uint32_t if_index = 0;
+	uint8_t addr_length = netif_cache_get_address_length((uint8_t)family);
+	for(int32_t i = 0; i < netif_cache_addresses_count; i++){
+		netif_cache_address_t* address = &netif_cache_addresses[i];
+		if(address->family == family && 0 == memcmp(address->addr, addr, addr_length)){
+			if_index = (uint32_t)address->if_index;
+			break;
+		}
+	}
+	netif_cache_unlock();
+	return if_index;
+}
+
+uint32_t netif_cache_get_index_by_name(const char* name){
+	if(netif_cache_lock() != 0){
+		return 0;
+	}
+	uint32_t if_index = 0;
+	for(int32_t i = 0; i < netif_cache_links_count; i++){
+		if(0 == strncmp(netif_cache_links[i].name, name, IF_NAMESIZE)){
+			if_index = (uint32_t)netif_cache_links[i].index;
+			break;
+		}
+	}
+	netif_cache_unlock();
+	return if_index;
+}
+
+/**
+ * @brief The entry point for the listener task.
+ * Applies the link and address notifications to the cache.
+ */
+static void* netif_cache_task_main(void* args){
+	(void)args;
+	struct sockaddr_nl sender;
+
+	while(true){
+		socklen_t sender_length = sizeof(sender);
+		ssize_t size = recvfrom(netif_cache_listen_fd, netif_cache_listen_buffer, sizeof(netif_cache_listen_buffer), 0, (struct sockaddr*)&sender, &sender_length);
+		if(size < 0){
+			if(errno == EINTR){
+				continue;
+			}
+			if(errno == ENOBUFS){
+				// The socket receive buffer overran: some notifications are lost, resynchronize.
+				LLNET_DEBUG_TRACE("%s: notifications lost, resynchronize\n", __func__);
+				OSAL_mutex_take(&netif_cache_mutex, OSAL_INFINITE_TIME);
+				(void)netif_cache_refresh();
+				OSAL_mutex_give(&netif_cache_mutex);
+				continue;
+			}
+			// Unrecoverable error: fall back to a dump on each query.
+			LLNET_DEBUG_TRACE("%s: recv error (errno=%d), stop listening\n", __func__, errno);
+			OSAL_mutex_take(&netif_cache_mutex, OSAL_INFINITE_TIME);
+			netif_cache_listening = 0;
+			close(netif_cache_listen_fd);
+			netif_cache_listen_fd = -1;
+			OSAL_mutex_give(&netif_cache_mutex);
+			break;
+		}
+		if(sender.nl_pid != 0){
+			// Only trust the messages sent by the kernel
+			continue;
+		}
+
+		OSAL_mutex_take(&netif_cache_mutex, OSAL_INFINITE_TIME);
+		int32_t remaining = (int32_t)size;
+		for(struct nlmsghdr* nlh = (struct nlmsghdr*)netif_cache_listen_buffer; NLMSG_OK(nlh, remaining); nlh = NLMSG_NEXT(nlh, remaining)){
+			netif_cache_handle_message(nlh);
+		}
+		OSAL_mutex_give(&netif_cache_mutex);
+	}
+	return NULL;
+}
+
+/**
+ * @brief Enters the cache critical section, initializing the cache if needed.
+ * If no listener keeps the cache up to date, or if no dump has succeeded yet, the cache is refreshed.
+ *
+ * @return 0 on success (the lock is taken), -1 on failure (the lock is not taken).
+ */
+static int32_t netif_cache_lock(void){
+	if(netif_cache_initialized == 0 && netif_cache_init() != 0){
+		return -1;
+	}
+	OSAL_mutex_take(&netif_cache_mutex, OSAL_INFINITE_TIME);
+	if((netif_cache_listening == 0 || netif_cache_synchronized == 0) && netif_cache_refresh() != 0){
+		OSAL_mutex_give(&netif_cache_mutex);
+		return -1;
+	}
+	return 0;
+}
+
+/**
+ * @brief Exits the cache critical section.
+ */
+static void netif_cache_unlock(void){
+	OSAL_mutex_give(&netif_cache_mutex);
+}
+
+/**
+ * @brief Opens a NETLINK_ROUTE socket subscribed to the given multicast groups.
+ *
+ * @return the socket file descriptor, or -1 on error.
+ */
+static int32_t netif_cache_open_netlink(uint32_t groups){
+	int32_t fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+	if(fd == -1){
+		return -1;
+	}
+
+	struct sockaddr_nl local = {0};
+	local.nl_family = AF_NETLINK;
+	local.nl_groups = groups;
+	if(bind(fd, (struct sockaddr*)&local, sizeof(local)) == -1){
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+/**
+ * @brief Rebuilds the whole cache from a netlink dump of the links and of the addresses.
+ * Must be called with the cache lock taken.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+static int32_t netif_cache_refresh(void){
+	int32_t fd = netif_cache_open_netlink(0);
+	if(fd == -1){
+		netif_cache_synchronized = 0;
+		return -1;
+	}
+
+	netif_cache_links_count = 0;
+	netif_cache_addresses_count = 0;
+
+	int32_t res = netif_cache_dump(fd, RTM_GETLINK);
+	if(res == 0){
+		res = netif_cache_dump(fd, RTM_GETADDR);
+	}
+	close(fd);
+	netif_cache_synchronized = (res == 0) ? 1 : 0;
+	return res;
+}
+
+/**
+ * @brief Sends a dump request of the given type and applies the responses to the cache.
+ * Must be called with the cache lock taken.
+ *
+ * @param[in] fd the netlink socket.
+ * @param[in] type RTM_GETLINK or RTM_GETADDR.
+ *
+ * @return 0 on success, -1 on failure.
+ */
+static int32_t netif_cache_dump(int32_t fd, uint16_t type){
+	struct {
+		struct nlmsghdr header;
+		struct ifinfomsg body; // struct ifaddrmsg for RTM_GETADDR, which is smaller
+	} request;
+
+	(void)memset(&request, 0, sizeof(request));
+	request.header.nlmsg_len = (type == RTM_GETLINK) ? NLMSG_LENGTH(sizeof(struct ifinfomsg)) : NLMSG_LENGTH(sizeof(struct ifaddrmsg));
+	request.header.nlmsg_type = type;
+	request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+	request.header.nlmsg_seq = ++netif_cache_dump_seq;
+	// body family is AF_UNSPEC (0): dump all families
+
+	if(send(fd, &request, request.header.nlmsg_len, 0) < 0){
+		return -1;
+	}
+
+	while(true){
+		ssize_t size = recv(fd, netif_cache_dump_buffer, sizeof(netif_cache_dump_buffer), 0);
+		if(size < 0){
+			if(errno == EINTR){
+				continue;
+			}
+			return -1;
+		}
+		if(size == 0){
+			return -1;
+		}
+
+		int32_t remaining = (int32_t)size;
+		for(struct nlmsghdr* nlh = (struct nlmsghdr*)netif_cache_dump_buffer; NLMSG_OK(nlh, remaining); nlh = NLMSG_NEXT(nlh, remaining)){
+			if(nlh->nlmsg_seq != netif_cache_dump_seq){
+				continue;
+			}
+			if(nlh->nlmsg_type == NLMSG_DONE){
+				return 0;
+			}
+			if(nlh->nlmsg_type == NLMSG_ERROR){
+				return -1;
+			}
+			netif_cache_handle_message(nlh);
+		}
+	}
+}
+
+/**
+ * @brief Applies a netlink message to the cache.
+ * Must be called with the cache lock taken.
+ */
+static void netif_cache_handle_message(const struct nlmsghdr* nlh){
+	switch(nlh->nlmsg_type){
+		case RTM_NEWLINK:
+		case RTM_DELLINK:
+			netif_cache_handle_link(nlh);
+			break;
+		case RTM_NEWADDR:
+		case RTM_DELADDR:
+			netif_cache_handle_address(nlh);
+			break;
+		default:
+			// not a link or address message
+			break;
+	}
+}
+
+/**
+ * @brief Applies a RTM_NEWLINK or RTM_DELLINK message to the cache.
+ * Must be called with the cache lock taken.
+ */
+static void netif_cache_handle_link(const struct nlmsghdr* nlh){
+	if(nlh->nlmsg_len < NLMSG_LENGTH(sizeof(struct ifinfomsg))){
+		return;
+	}
+	struct ifinfomsg* ifi = (struct ifinfomsg*)NLMSG_DATA(nlh);
+	int32_t pos = netif_cache_find_link(ifi->ifi_index);
+
+	if(nlh->nlmsg_type == RTM_DELLINK){
+		if(pos >= 0){
+			netif_cache_links_count--;
+			(void)memmove(&netif_cache_links[pos], &netif_cache_links[pos+1], (netif_cache_links_count - pos) * sizeof(netif_cache_link_t));
+			netif_cache_remove_link_addresses(ifi->ifi_index);
+		}
+		return;
+	}
+
+	netif_cache_link_t link = {0};
+	if(pos >= 0){
+		// Keep the attributes that may be omitted in a change notification
+		link = netif_cache_links[pos];
+	}
+	link.index = ifi->ifi_index;
+	link.flags = ifi->ifi_flags;
+	link.hw_type = ifi->ifi_type;
+
+	int32_t attributes_length = (int32_t)IFLA_PAYLOAD(nlh);
+	for(struct rtattr* rta = IFLA_RTA(ifi); RTA_OK(rta, attributes_length); rta = RTA_NEXT(rta, attributes_length)){
+		int32_t payload_length = (int32_t)RTA_PAYLOAD(rta);
+		switch(rta->rta_type){
+			case IFLA_IFNAME:
+				(void)strncpy(link.name, (const char*)RTA_DATA(rta), sizeof(link.name));
+				link.name[sizeof(link.name) - 1] = '\0';
+				break;
+			case IFLA_MTU:
+				if(payload_length >= (int32_t)sizeof(uint32_t)){
+					link.mtu = (int32_t)*(uint32_t*)RTA_DATA(rta);
+				}
+				break;
+			case IFLA_ADDRESS:
+				if(payload_length > NETIF_CACHE_HW_ADDR_MAX_LENGTH){
+					payload_length = NETIF_CACHE_HW_ADDR_MAX_LENGTH;
+				}
+				(void)memcpy(link.hw_addr, RTA_DATA(rta), payload_length);
+				link.hw_addr_length = (uint8_t)payload_length;
+				break;
+			default:
+				break;
+		}
+	}
+
+	if(pos >= 0){
+		netif_cache_links[pos] = link;
+		return;
+	}
+
+	if(netif_cache_links_count == NETIF_CACHE_MAX_LINKS){
+		LLNET_DEBUG_TRACE("%s: too many links in cache, %s ignored!\n", __func__, link.name);
+		return;
+	}
+	// Insert the new link so that the links stay sorted by index
+	pos = netif_cache_links_count;
+	while(pos > 0 && netif_cache_links[pos-1].index > link.index){
+		netif_cache_links[pos] = netif_cache_links[pos-1];
+		pos--;
+	}
+	netif_cache_links[pos] = link;
+	netif_cache_links_count++;
+}
+
+/**
+ * @brief Applies a RTM_NEWADDR or RTM_DELADDR message to the cache.
+ * Must be called with the cache lock taken.
+ */
+static void netif_cache_handle_address(const struct nlmsghdr* nlh){
+	if(nlh->nlmsg_len < NLMSG_LENGTH(sizeof(struct ifaddrmsg))){
+		return;
+	}
+	struct ifaddrmsg* ifa = (struct ifaddrmsg*)NLMSG_DATA(nlh);
+	if(!netif_cache_is_family_enabled(ifa->ifa_family)){
+		return;
+	}
+
+	netif_cache_address_t address = {0};
+	address.if_index = (int32_t)ifa->ifa_index;
+	address.family = ifa->ifa_family;
+	address.prefix_length = ifa->ifa_prefixlen;
+	uint8_t addr_length = netif_cache_get_address_length(ifa->ifa_family);
+	bool has_local = false;
+	bool has_address = false;
+
+	int32_t attributes_length = (int32_t)IFA_PAYLOAD(nlh);
+	for(struct rtattr* rta = IFA_RTA(ifa); RTA_OK(rta, attributes_length); rta = RTA_NEXT(rta, attributes_length)){
+		if(RTA_PAYLOAD(rta) < addr_length){
+			continue;
+		}
+		switch(rta->rta_type){
+			case IFA_LOCAL:
+				// IFA_LOCAL is the local address, IFA_ADDRESS is the peer address on point-to-point links
+				(void)memcpy(address.addr, RTA_DATA(rta), addr_length);
+				has_local = true;
+				has_address = true;
+				break;
+			case IFA_ADDRESS:
+				if(!has_local){
+					(void)memcpy(address.addr, RTA_DATA(rta), addr_length);
+					has_address = true;
+				}
+				break;
+			case IFA_BROADCAST:
+				if(ifa->ifa_family == AF_INET){
+					(void)memcpy(address.broadcast, RTA_DATA(rta), sizeof(address.broadcast));
+					address.has_broadcast = 1;
+				}
+				break;
+			default:
+				break;
+		}
+	}
+	if(!has_address){
+		return;
+	}
+
+	int32_t pos = netif_cache_find_address(address.if_index, address.family, address.addr);
+	if(nlh->nlmsg_type == RTM_DELADDR){
+		if(pos >= 0){
+			netif_cache_addresses_count--;
+			(void)memmove(&netif_cache_addresses[pos], &netif_cache_addresses[pos+1], (netif_cache_addresses_count - pos) * sizeof(netif_cache_address_t));
+		}
+	}
+	else if(pos >= 0){
+		netif_cache_addresses[pos] = address;
+	}
+	else if(netif_cache_addresses_count < NETIF_CACHE_MAX_ADDRESSES){
+		netif_cache_addresses[netif_cache_addresses_count] = address;
+		netif_cache_addresses_count++;
+	}
+	else {
+		LLNET_DEBUG_TRACE("%s: too many addresses in cache!\n", __func__);
+	}
+}
+
+/**
+ * @brief Returns the position of the link with the given index, or -1 if not found.
+ */
+static int32_t netif_cache_find_link(int32_t if_index){
+	for(int32_t i = 0; i < netif_cache_links_count; i++){
+		if(netif_cache_links[i].index == if_index){
+			return i;
+		}
+	}
+	return -1;
+}
+
+/**
+ * @brief Returns the position of the given address of the given interface, or -1 if not found.
+ */
+static int32_t netif_cache_find_address(int32_t if_index, uint8_t family, const uint8_t* addr){
+	uint8_t addr_length = netif_cache_get_address_length(family);
+	for(int32_t i = 0; i < netif_cache_addresses_count; i++){
+		netif_cache_address_t* address = &netif_cache_addresses[i];
+		if(address->if_index == if_index && address->family == family && 0 == memcmp(address->addr, addr, addr_length)){
+			return i;
+		}
+	}
+	return -1;
+}
+
+/**
+ * @brief Removes all the addresses of the given interface.
+ */
+static void netif_cache_remove_link_addresses(int32_t if_index){
+	int32_t kept = 0;
+	for(int32_t i = 0; i < netif_cache_addresses_count; i++){
+		if(netif_cache_addresses[i].if_index != if_index){
+			netif_cache_addresses[kept] = netif_cache_addresses[i];
+			kept++;
+		}
+	}
+	netif_cache_addresses_count = kept;
+}
+
+/**
+ * @brief Returns true if the given address family is enabled by LLNET_AF.
+ */
+static bool netif_cache_is_family_enabled(uint8_t family){
+#if LLNET_AF & LLNET_AF_IPV4
+	if(family == AF_INET){
+		return true;
+	}
+#endif
+#if LLNET_AF & LLNET_AF_IPV6
+	if(family == AF_INET6){
+		return true;
+	}
+#endif
+	return false;
+}
+
+/**
+ * @brief Returns the length in bytes of an address of the given family.
+ */
+static uint8_t netif_cache_get_address_length(uint8_t family){
+	return (family == AF_INET) ? sizeof(struct in_addr) : sizeof(struct in6_addr);
+}
+
+#ifdef __cplusplus
+	}
+#endif
@@ -0,0 +1,226 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/**
+ * @file
+ * @brief Table of the native socket states implementation.
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include "socket_table.h"
+#include <stdio.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include "sighandler.h"
+#include "LLNET_linux_configuration.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/**
+ * Sanity check between the expected version of the configuration and the actual version of
+ * the configuration.
+ * If an error is raised here, it means that a new version of the CCO has been installed and
+ * the configuration LLNET_linux_configuration.h must be updated based on the one provided
+ * by the new CCO version.
+ */
+#if LLNET_LINUX_CONFIGURATION_VERSION != 2
+
+	#error "Version of the configuration file LLNET_linux_configuration.h is not compatible with this implementation."
+
+#endif
+
+/*
+ * See implementations for descriptions.
+ */
+static bool socket_table_is_bound_or_connected(const union llnet_sockaddr* address);
+static const char* socket_table_format_address(const union llnet_sockaddr* address, char* buffer, size_t length);
+
+/** @brief Socket states, indexed by file descriptor. */
+static socket_table_entry_t socket_table[SOCKET_TABLE_SIZE];
+
+void socket_table_init(void){
+	if(microej_usr1_signal_register_dump(socket_table_dump) != 0){
+		LLNET_DEBUG_TRACE("%s: cannot register the SIGUSR1 dump\n", __func__);
+	}
+}
+
+socket_table_entry_t* socket_table_add(int32_t fd, int32_t family, int32_t type, bool non_blocking){
+	if(fd < 0 || fd >= SOCKET_TABLE_SIZE){
+		return NULL;
+	}
+	socket_table_entry_t* entry = &socket_table[fd];
+	memset(entry, 0, sizeof(*entry));
+	entry->family = family;
+	entry->type = type;
+	entry->non_blocking = non_blocking ? 1 : 0;
+	entry->timeout = -1;
+	entry->absolute_timeout = -1;
+	entry->in_use = 1;
+	return entry;
+}
+
+void socket_table_remove(int32_t fd){
+	if(fd >= 0 && fd < SOCKET_TABLE_SIZE){
+		socket_table[fd].in_use = 0;
+	}
+}
+
+socket_table_entry_t* socket_table_get(int32_t fd){
+	if(fd < 0 || fd >= SOCKET_TABLE_SIZE || socket_table[fd].in_use == 0){
+		return NULL;
+	}
+	return &socket_table[fd];
+}
+
+int32_t socket_table_get_type(int32_t fd){
+	socket_table_entry_t* entry = socket_table_get(fd);
+	if(entry != NULL && entry->type != 0){
+		return entry->type;
+	}
+	int32_t type;
+	socklen_t length = sizeof(type);
+	if(llnet_getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &length) != 0){
+		return -1;
+	}
+	if(entry != NULL){
+		entry->type = type;
+	}
+	return type;
+}
+
+int32_t socket_table_get_family(int32_t fd){
+	socket_table_entry_t* entry = socket_table_get(fd);
+	if(entry != NULL && entry->family != AF_UNSPEC){
+		return entry->family;
+	}
+	int32_t family;
+	socklen_t length = sizeof(family);
+	if(llnet_getsockopt(fd, SOL_SOCKET, SO_DOMAIN, &family, &length) != 0){
+		return -1;
+	}
+	if(entry != NULL){
+		entry->family = family;
+	}
+	return family;
+}
+
+int32_t socket_table_get_address(int32_t fd, union llnet_sockaddr* address, bool local){
+	socket_table_entry_t* entry = socket_table_get(fd);
+	if(entry != NULL){
+		if(local && entry->local_address_valid == 1){
+			*address = entry->local_address;
+			return 0;
+		}
+		if(!local && entry->peer_address_valid == 1){
+			*address = entry->peer_address;
+			return 0;
+		}
+	}
+
+	socklen_t length = sizeof(*address);
+	memset(address, 0, sizeof(*address));
+	int32_t res = local ? llnet_getsockname(fd, &address->addr, &length) : llnet_getpeername(fd, &address->addr, &length);
+	if(res != 0){
+		return -1;
+	}
+
+	// An unbound local address may still change (implicit bind), an unconnected peer address is not an address
+	if(entry != NULL && socket_table_is_bound_or_connected(address)){
+		if(local){
+			entry->local_address = *address;
+			entry->local_address_valid = 1;
+		}
+		else {
+			entry->peer_address = *address;
+			entry->peer_address_valid = 1;
+		}
+	}
+	return 0;
+}
+
+void socket_table_invalidate_addresses(int32_t fd){
+	socket_table_entry_t* entry = socket_table_get(fd);
+	if(entry != NULL){
+		entry->local_address_valid = 0;
+		entry->peer_address_valid = 0;
+	}
+}
+
+void socket_table_dump(void){
+	char local[INET6_ADDRSTRLEN + 8];
+	char peer[INET6_ADDRSTRLEN + 8];
+
+	fprintf(stdout, "=================================== Sockets ===================================\n");
+	for(int32_t fd = 0; fd < SOCKET_TABLE_SIZE; fd++){
+		const socket_table_entry_t* entry = &socket_table[fd];
+		if(entry->in_use == 0){
+			continue;
+		}
+		fprintf(stdout, "fd=%d family=%s type=%s %s timeout=%d local=%s peer=%s rx=%lld tx=%lld eagain=%lld suspends=%lld wait=%lldus\n",
+				(int)fd,
+				(entry->family == AF_INET) ? "inet" : (entry->family == AF_INET6) ? "inet6" : (entry->family == AF_UNIX) ? "unix" : "?",
+				(entry->type == SOCK_STREAM) ? "stream" : (entry->type == SOCK_DGRAM) ? "dgram" : "?",
+				(entry->non_blocking == 1) ? "non-blocking" : "blocking",
+				(int)entry->timeout,
+				(entry->local_address_valid == 1) ? socket_table_format_address(&entry->local_address, local, sizeof(local)) : "-",
+				(entry->peer_address_valid == 1) ? socket_table_format_address(&entry->peer_address, peer, sizeof(peer)) : "-",
+				(long long)entry->stats[NET_STAT_BYTES_RECEIVED], (long long)entry->stats[NET_STAT_BYTES_SENT],
+				(long long)entry->stats[NET_STAT_EAGAIN], (long long)entry->stats[NET_STAT_SUSPENDS],
+				(long long)entry->stats[NET_STAT_WAIT_TIME_US]);
+	}
+	fprintf(stdout, "===============================================================================\n");
+	fflush(stdout);
+}
+
+/**
+ * @brief Tells whether an IP address has a port, i.e. is a bound local address or a connected peer address.
+ */
+static bool socket_table_is_bound_or_connected(const union llnet_sockaddr* address){
+#if LLNET_AF & LLNET_AF_IPV4
+	if(address->addr.sa_family == AF_INET){
+		return address->in.sin_port != 0;
+	}
+#endif
+#if LLNET_AF & LLNET_AF_IPV6
+	if(address->addr.sa_family == AF_INET6){
+		return address->in6.sin6_port != 0;
+	}
+#endif
+	return false;
+}
+
+/**
+ * @brief Formats an IP address and its port.
+ *
+ * @return the given buffer.
+ */
+static const char* socket_table_format_address(const union llnet_sockaddr* address, char* buffer, size_t length){
+	char ip[INET6_ADDRSTRLEN] = "?";
+	int32_t port = 0;
+#if LLNET_AF & LLNET_AF_IPV4
+	if(address->addr.sa_family == AF_INET){
+		(void)inet_ntop(AF_INET, &address->in.sin_addr, ip, sizeof(ip));
+		port = ntohs(address->in.sin_port);
+	}
+#endif
+#if LLNET_AF & LLNET_AF_IPV6
+	if(address->addr.sa_family == AF_INET6){
+		(void)inet_ntop(AF_INET6, &address->in6.sin6_addr, ip, sizeof(ip));
+		port = ntohs(address->in6.sin6_port);
+	}
+#endif
+	(void)snprintf(buffer, length, "%s:%d", ip, (int)port);
+	return buffer;
+}
+
+#ifdef __cplusplus
+	}
+#endif
@@ -0,0 +1,156 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/**
+ * @file
+ * @brief TCP Fast Open support implementation over Linux.
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include "tcp_fastopen.h"
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include "LLNET_Common.h"
+#include "LLNET_linux_configuration.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/**
+ * Sanity check between the expected version of the configuration and the actual version of
+ * the configuration.
+ * If an error is raised here, it means that a new version of the CCO has been installed and
+ * the configuration LLNET_linux_configuration.h must be updated based on the one provided
+ * by the new CCO version.
+ */
+#if LLNET_LINUX_CONFIGURATION_VERSION != 2
+
+	#error "Version of the configuration file LLNET_linux_configuration.h is not compatible with this implementation."
+
+#endif
+
+/** @brief TCP Fast Open statistics, updated from the VM task only. */
+static int64_t tcp_fastopen_stats[TCP_FASTOPEN_STATS_COUNT];
+
+/**
+ * @brief Set to 1 once Fast Open has been enabled on a client socket.
+ * Until then, closing a socket does not query its Fast Open state.
+ */
+static uint8_t tcp_fastopen_client_used = (LLNET_TCP_FASTOPEN_CONNECT_DEFAULT != 0) ? 1 : 0;
+
+/**
+ * @brief Set to 1 once Fast Open has been enabled on a listening socket.
+ * Until then, accepting a connection does not query its Fast Open state.
+ */
+static uint8_t tcp_fastopen_server_used = (LLNET_TCP_FASTOPEN_LISTEN_QUEUE_LENGTH != 0) ? 1 : 0;
+
+int64_t LLNET_TCP_FASTOPEN_IMPL_getStatistic(int32_t id){
+	if(id < 0 || id >= TCP_FASTOPEN_STATS_COUNT){
+		return -1;
+	}
+	return tcp_fastopen_stats[id];
+}
+
+void tcp_fastopen_on_listen(int32_t fd){
+#if LLNET_TCP_FASTOPEN_LISTEN_QUEUE_LENGTH != 0
+	int32_t queue_length = 0;
+	socklen_t optlen = sizeof(queue_length);
+	if(llnet_getsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN, &queue_length, &optlen) == 0 && queue_length == 0){
+		queue_length = LLNET_TCP_FASTOPEN_LISTEN_QUEUE_LENGTH;
+		if(llnet_setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN, &queue_length, sizeof(queue_length)) == -1){
+			// not fatal: the socket listens without Fast Open
+			LLNET_DEBUG_TRACE("%s(fd=0x%X) cannot enable TCP_FASTOPEN (errno=%d)\n", __func__, fd, llnet_errno(fd));
+			tcp_fastopen_stats[TCP_FASTOPEN_STAT_ENABLE_ERRORS]++;
+		}
+	}
+#else
+	(void)fd;
+#endif
+}
+
+void tcp_fastopen_on_connect(int32_t fd){
+	int32_t enabled = 0;
+	socklen_t optlen = sizeof(enabled);
+
+#if LLNET_TCP_FASTOPEN_CONNECT_DEFAULT != 0
+	enabled = 1;
+	if(llnet_setsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &enabled, sizeof(enabled)) == -1){
+		// not fatal: the socket connects with a regular 3-way handshake
+		LLNET_DEBUG_TRACE("%s(fd=0x%X) cannot enable TCP_FASTOPEN_CONNECT (errno=%d)\n", __func__, fd, llnet_errno(fd));
+		tcp_fastopen_stats[TCP_FASTOPEN_STAT_ENABLE_ERRORS]++;
+		return;
+	}
+#else
+	if(tcp_fastopen_client_used == 0){
+		return;
+	}
+	if(llnet_getsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &enabled, &optlen) != 0){
+		return;
+	}
+#endif
+	if(enabled != 0){
+		tcp_fastopen_stats[TCP_FASTOPEN_STAT_CLIENT_CONNECTS]++;
+	}
+	(void)optlen;
+}
+
+void tcp_fastopen_on_accept(int32_t fd){
+	if(tcp_fastopen_server_used == 0){
+		return;
+	}
+	struct tcp_info info;
+	socklen_t optlen = sizeof(info);
+	if(llnet_getsockopt(fd, IPPROTO_TCP, TCP_INFO, &info, &optlen) == 0){
+		tcp_fastopen_stats[TCP_FASTOPEN_STAT_SERVER_ACCEPTS]++;
+		if((info.tcpi_options & TCPI_OPT_SYN_DATA) != 0){
+			tcp_fastopen_stats[TCP_FASTOPEN_STAT_SERVER_SYN_DATA_ACCEPTED]++;
+		}
+	}
+}
+
+void tcp_fastopen_on_close(int32_t fd){
+	if(tcp_fastopen_client_used == 0){
+		return;
+	}
+	int32_t enabled = 0;
+	socklen_t optlen = sizeof(enabled);
+	if(llnet_getsockopt(fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &enabled, &optlen) != 0 || enabled == 0){
+		// not a TCP socket, or Fast Open not enabled
+		return;
+	}
+	struct tcp_info info;
+	optlen = sizeof(info);
+	if(llnet_getsockopt(fd, IPPROTO_TCP, TCP_INFO, &info, &optlen) != 0 || info.tcpi_state == TCP_LISTEN || info.tcpi_state == TCP_CLOSE){
+		// not a connection
+		return;
+	}
+	if((info.tcpi_options & TCPI_OPT_SYN_DATA) != 0){
+		tcp_fastopen_stats[TCP_FASTOPEN_STAT_CLIENT_SYN_DATA_ACKED]++;
+	}
+	else {
+		tcp_fastopen_stats[TCP_FASTOPEN_STAT_CLIENT_FALLBACKS]++;
+	}
+}
+
+void tcp_fastopen_on_set_option(int32_t option, int32_t value){
+	if(value != 0){
+		if(option == LLNET_SOCKETOPTION_TCP_FASTOPEN){
+			tcp_fastopen_server_used = 1;
+		}
+		else if(option == LLNET_SOCKETOPTION_TCP_FASTOPEN_CONNECT){
+			tcp_fastopen_client_used = 1;
+		}
+	}
+}
+
+#ifdef __cplusplus
+	}
+#endif
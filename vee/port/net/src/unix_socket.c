@@ -0,0 +1,399 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/**
+ * @file
+ * @brief Unix domain socket channels implementation over Linux.
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include "unix_socket.h"
+#include <errno.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "sni.h"
+#include "LLNET_configuration.h"
+#include "LLNET_ERRORS.h"
+#include "LLNET_Common.h"
+#include "LLNET_linux_configuration.h"
+#include "socket_table.h"
+#include "net_stats.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/**
+ * Sanity check between the expected version of the configuration and the actual version of
+ * the configuration.
+ * If an error is raised here, it means that a new version of the CCO has been installed and
+ * the configuration LLNET_linux_configuration.h must be updated based on the one provided
+ * by the new CCO version.
+ */
+#if LLNET_LINUX_CONFIGURATION_VERSION != 2
+
+	#error "Version of the configuration file LLNET_linux_configuration.h is not compatible with this implementation."
+
+#endif
+
+/*
+ * See implementations for descriptions.
+ */
+static socklen_t unix_socket_to_sockaddr(int8_t* path, int32_t length, struct sockaddr_un* sockaddr);
+static int32_t unix_socket_from_sockaddr(struct sockaddr_un* sockaddr, socklen_t sockaddr_length, int8_t* path, int32_t length);
+static int32_t unix_socket_get_path(int32_t fd, int8_t* path, int32_t length, bool local);
+
+int32_t LLNET_UNIX_IMPL_socket(uint8_t stream)
+{
+	LLNET_DEBUG_TRACE("%s[thread %d](stream=%d)\n", __func__, SNI_getCurrentJavaThreadID(), stream);
+
+	if(llnet_is_ready() == false){
+		SNI_throwNativeIOException(J_NETWORK_NOT_INITIALIZED, "network not initialized");
+		return SNI_IGNORED_RETURNED_VALUE;
+	}
+
+	int32_t fd = llnet_socket(AF_UNIX, (stream ? SOCK_STREAM : SOCK_DGRAM) | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if(fd == -1){
+		int32_t fd_errno = llnet_errno(-1);
+		LLNET_DEBUG_TRACE("%s: llnet_socket() errno=%d\n", __func__, fd_errno);
+		SNI_throwNativeIOException(LLNET_map_to_java_exception(fd_errno), LLNET_get_socket_error_msg(fd_errno));
+		return SNI_IGNORED_RETURNED_VALUE;
+	}
+	(void)socket_table_add(fd, AF_UNIX, stream ? SOCK_STREAM : SOCK_DGRAM, true);
+	return fd;
+}
+
+void LLNET_UNIX_IMPL_bind(int32_t fd, int8_t* path, int32_t length)
+{
+	LLNET_DEBUG_TRACE("%s[thread %d](fd=0x%X, length=%d)\n", __func__, SNI_getCurrentJavaThreadID(), fd, length);
+
+	if(llnet_is_ready() == false){
+		SNI_throwNativeIOException(J_NETWORK_NOT_INITIALIZED, "network not initialized");
+		return;
+	}
+
+	struct sockaddr_un sockaddr;
+	socklen_t sockaddr_length = unix_socket_to_sockaddr(path, length, &sockaddr);
+	if(sockaddr_length == 0){
+		SNI_throwNativeIOException(J_EINVAL, "invalid path length");
+		return;
+	}
+
+	if(llnet_bind(fd, (struct sockaddr*)&sockaddr, sockaddr_length) == -1){
+		int32_t fd_errno = llnet_errno(fd);
+		SNI_throwNativeIOException(LLNET_map_to_java_exception(fd_errno), LLNET_get_socket_error_msg(fd_errno));
+	}
+}
+
+void LLNET_UNIX_IMPL_connect(int32_t fd, int8_t* path, int32_t length, int64_t absoluteTimeout)
+{
+	LLNET_DEBUG_TRACE("%s[thread %d](fd=0x%X, length=%d, absoluteTimeout=%lld)\n", __func__, SNI_getCurrentJavaThreadID(), fd, length, absoluteTimeout);
+
+	if(llnet_is_ready() == false){
+		SNI_throwNativeIOException(J_NETWORK_NOT_INITIALIZED, "network not initialized");
+		return;
+	}
+
+	struct sockaddr_un sockaddr;
+	socklen_t sockaddr_length = unix_socket_to_sockaddr(path, length, &sockaddr);
+	if(sockaddr_length == 0){
+		SNI_throwNativeIOException(J_EINVAL, "invalid path length");
+		return;
+	}
+
+	if(llnet_connect(fd, (struct sockaddr*)&sockaddr, sockaddr_length) == 0){
+		// successful connection
+		return;
+	}
+
+	int32_t fd_errno = llnet_errno(fd);
+	if(fd_errno != EAGAIN){
+		SNI_throwNativeIOException(LLNET_map_to_java_exception(fd_errno), LLNET_get_socket_error_msg(fd_errno));
+		return;
+	}
+
+	// The peer backlog is full. The socket is writable meanwhile, so retry after a delay rather than with async_select().
+	int64_t delay = UNIX_SOCKET_CONNECT_RETRY_DELAY_MS;
+	if(absoluteTimeout != 0){
+		int64_t remaining = absoluteTimeout - LLNET_current_time_ms();
+		if(remaining <= 0){
+			SNI_throwNativeIOException(J_ETIMEDOUT, "timeout");
+			return;
+		}
+		if(remaining < delay){
+			delay = remaining;
+		}
+	}
+	if(SNI_OK != SNI_suspendCurrentJavaThreadWithCallback(delay, (SNI_callback)LLNET_UNIX_IMPL_connect, NULL)){
+		SNI_throwNativeIOException(J_EUNKNOWN, "thread cannot be suspended");
+	}
+}
+
+int32_t LLNET_UNIX_IMPL_getLocalPath(int32_t fd, int8_t* path, int32_t length)
+{
+	LLNET_DEBUG_TRACE("%s[thread %d](fd=0x%X)\n", __func__, SNI_getCurrentJavaThreadID(), fd);
+	return unix_socket_get_path(fd, path, length, true);
+}
+
+int32_t LLNET_UNIX_IMPL_getPeerPath(int32_t fd, int8_t* path, int32_t length)
+{
+	LLNET_DEBUG_TRACE("%s[thread %d](fd=0x%X)\n", __func__, SNI_getCurrentJavaThreadID(), fd);
+	return unix_socket_get_path(fd, path, length, false);
+}
+
+void LLNET_UNIX_IMPL_send(int32_t fd, int8_t* src, int32_t offset, int32_t length, int8_t* path, int32_t pathLength)
+{
+	LLNET_DEBUG_TRACE("%s[thread %d](fd=0x%X, length=%d, pathLength=%d)\n", __func__, SNI_getCurrentJavaThreadID(), fd, length, pathLength);
+
+	if(llnet_is_ready() == false){
+		SNI_throwNativeIOException(J_NETWORK_NOT_INITIALIZED, "network not initialized");
+		return;
+	}
+
+	struct sockaddr_un sockaddr;
+	socklen_t sockaddr_length = 0;
+	if(pathLength != 0){
+		sockaddr_length = unix_socket_to_sockaddr(path, pathLength, &sockaddr);
+		if(sockaddr_length == 0){
+			SNI_throwNativeIOException(J_EINVAL, "invalid path length");
+			return;
+		}
+	}
+
+	int32_t ret = llnet_sendto(fd, src+offset, length, 0, (sockaddr_length != 0) ? (struct sockaddr*)&sockaddr : NULL, sockaddr_length);
+	net_stats_on_send(fd, ret, true);
+	LLNET_DEBUG_TRACE("%s(fd=0x%X) sendto result=%d errno=%d\n", __func__, fd, ret, llnet_errno(fd));
+
+	if(0 > ret){
+		LLNET_handle_blocking_operation_error(fd, llnet_errno(fd), SELECT_WRITE, 0, (SNI_callback)LLNET_UNIX_IMPL_send, NULL);
+		return;
+	}
+}
+
+int64_t LLNET_UNIX_IMPL_receive(int32_t fd, int8_t* dst, int32_t offset, int32_t length, int8_t* path, int32_t pathLength, int64_t absoluteTimeout)
+{
+	LLNET_DEBUG_TRACE("%s[thread %d](fd=0x%X, length=%d, absoluteTimeout=%lld)\n", __func__, SNI_getCurrentJavaThreadID(), fd, length, absoluteTimeout);
+
+	if(llnet_is_ready() == false){
+		SNI_throwNativeIOException(J_NETWORK_NOT_INITIALIZED, "network not initialized");
+		return SNI_IGNORED_RETURNED_VALUE;
+	}
+
+	struct sockaddr_un sockaddr;
+	socklen_t sockaddr_length = sizeof(sockaddr);
+	int32_t ret = llnet_recvfrom(fd, dst+offset, length, 0, (struct sockaddr*)&sockaddr, &sockaddr_length);
+	net_stats_on_receive(fd, ret, true);
+	LLNET_DEBUG_TRACE("%s recvfrom() returned %d errno = %d\n", __func__, ret, llnet_errno(fd));
+
+	if(0 > ret){
+		//receive error
+		LLNET_handle_blocking_operation_error(fd, llnet_errno(fd), SELECT_READ, absoluteTimeout, (SNI_callback)LLNET_UNIX_IMPL_receive, NULL);
+		return SNI_IGNORED_RETURNED_VALUE;
+	}
+
+	int32_t sender_length = unix_socket_from_sockaddr(&sockaddr, sockaddr_length, path, pathLength);
+	if(sender_length < 0){
+		SNI_throwNativeIOException(J_EINVAL, "wrong path length");
+		return SNI_IGNORED_RETURNED_VALUE;
+	}
+	return (((int64_t)ret) << 32l) | (uint32_t)sender_length;
+}
+
+int32_t LLNET_UNIX_IMPL_sendWithFd(int32_t fd, int8_t* src, int32_t offset, int32_t length, int32_t passedFd)
+{
+	LLNET_DEBUG_TRACE("%s[thread %d](fd=0x%X, length=%d, passedFd=%d)\n", __func__, SNI_getCurrentJavaThreadID(), fd, length, passedFd);
+
+	if(llnet_is_ready() == false){
+		SNI_throwNativeIOException(J_NETWORK_NOT_INITIALIZED, "network not initialized");
+		return SNI_IGNORED_RETURNED_VALUE;
+	}
+	if(length <= 0){
+		// the file descriptor must be attached to at least one byte
+		SNI_throwNativeIOException(J_EINVAL, "no data to send");
+		return SNI_IGNORED_RETURNED_VALUE;
+	}
+
+	union {
+		char buffer[CMSG_SPACE(sizeof(int))];
+		struct cmsghdr align;
+	} control;
+	memset(&control, 0, sizeof(control));
+
+	struct iovec iov;
+	iov.iov_base = src + offset;
+	iov.iov_len = length;
+
+	struct msghdr message = {0};
+	message.msg_iov = &iov;
+	message.msg_iovlen = 1;
+	message.msg_control = control.buffer;
+	message.msg_controllen = sizeof(control.buffer);
+
+	struct cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+	cmsg->cmsg_level = SOL_SOCKET;
+	cmsg->cmsg_type = SCM_RIGHTS;
+	cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+	memcpy(CMSG_DATA(cmsg), &passedFd, sizeof(int));
+
+	int32_t ret = sendmsg(fd, &message, MSG_NOSIGNAL);
+	net_stats_on_send(fd, ret, socket_table_get_type(fd) == SOCK_DGRAM);
+	LLNET_DEBUG_TRACE("%s(fd=0x%X) sendmsg result=%d errno=%d\n", __func__, fd, ret, llnet_errno(fd));
+
+	if(0 > ret){
+		LLNET_handle_blocking_operation_error(fd, llnet_errno(fd), SELECT_WRITE, 0, (SNI_callback)LLNET_UNIX_IMPL_sendWithFd, NULL);
+		return SNI_IGNORED_RETURNED_VALUE;
+	}
+	return ret;
+}
+
+int32_t LLNET_UNIX_IMPL_receiveWithFd(int32_t fd, int8_t* dst, int32_t offset, int32_t length, int32_t* receivedFd, int64_t absoluteTimeout)
+{
+	LLNET_DEBUG_TRACE("%s[thread %d](fd=0x%X, length=%d, absoluteTimeout=%lld)\n", __func__, SNI_getCurrentJavaThreadID(), fd, length, absoluteTimeout);
+
+	if(llnet_is_ready() == false){
+		SNI_throwNativeIOException(J_NETWORK_NOT_INITIALIZED, "network not initialized");
+		return SNI_IGNORED_RETURNED_VALUE;
+	}
+
+	// Room for one file descriptor: the kernel closes the ones that do not fit and sets MSG_CTRUNC
+	union {
+		char buffer[CMSG_SPACE(sizeof(int))];
+		struct cmsghdr align;
+	} control;
+
+	struct iovec iov;
+	iov.iov_base = dst + offset;
+	iov.iov_len = length;
+
+	struct msghdr message = {0};
+	message.msg_iov = &iov;
+	message.msg_iovlen = 1;
+	message.msg_control = control.buffer;
+	message.msg_controllen = sizeof(control.buffer);
+
+	int32_t ret = recvmsg(fd, &message, MSG_CMSG_CLOEXEC);
+	net_stats_on_receive(fd, ret, socket_table_get_type(fd) == SOCK_DGRAM);
+	LLNET_DEBUG_TRACE("%s(fd=0x%X) recvmsg result=%d errno=%d\n", __func__, fd, ret, llnet_errno(fd));
+
+	if(0 > ret){
+		//receive error
+		LLNET_handle_blocking_operation_error(fd, llnet_errno(fd), SELECT_READ, absoluteTimeout, (SNI_callback)LLNET_UNIX_IMPL_receiveWithFd, NULL);
+		return SNI_IGNORED_RETURNED_VALUE;
+	}
+
+	receivedFd[0] = -1;
+	for(struct cmsghdr* cmsg = CMSG_FIRSTHDR(&message); cmsg != NULL; cmsg = CMSG_NXTHDR(&message, cmsg)){
+		if(cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS && cmsg->cmsg_len >= CMSG_LEN(sizeof(int))){
+			memcpy(&receivedFd[0], CMSG_DATA(cmsg), sizeof(int));
+		}
+	}
+
+	if(0 == ret && receivedFd[0] == -1){
+		//EOF
+		return -1;
+	}
+	return ret;
+}
+
+/**
+ * @brief Fills a Unix domain socket address from path bytes.
+ *
+ * @param[in] path the path bytes, starting with a NUL byte for an abstract address.
+ * @param[in] length the path length.
+ * @param[out] sockaddr the address to fill.
+ *
+ * @return the address length, 0 if the path length is invalid.
+ */
+static socklen_t unix_socket_to_sockaddr(int8_t* path, int32_t length, struct sockaddr_un* sockaddr){
+	memset(sockaddr, 0, sizeof(*sockaddr));
+	sockaddr->sun_family = AF_UNIX;
+
+	if(length <= 0 || (uint32_t)length > sizeof(sockaddr->sun_path)){
+		return 0;
+	}
+	if(path[0] != 0){
+		// a filesystem path needs room for the terminating NUL character
+		if((uint32_t)length == sizeof(sockaddr->sun_path)){
+			return 0;
+		}
+		memcpy(sockaddr->sun_path, path, length);
+		return (socklen_t)sizeof(*sockaddr);
+	}
+	// abstract address: the name length is given by the address length
+	memcpy(sockaddr->sun_path, path, length);
+	return (socklen_t)(offsetof(struct sockaddr_un, sun_path) + length);
+}
+
+/**
+ * @brief Gets the path bytes of a Unix domain socket address.
+ *
+ * @param[in] sockaddr the address.
+ * @param[in] sockaddr_length the address length.
+ * @param[out] path the buffer to fill with the path bytes.
+ * @param[in] length the buffer length.
+ *
+ * @return the path length (0 for an unnamed address), -1 if the buffer is too small.
+ */
+static int32_t unix_socket_from_sockaddr(struct sockaddr_un* sockaddr, socklen_t sockaddr_length, int8_t* path, int32_t length){
+	if(sockaddr_length <= offsetof(struct sockaddr_un, sun_path)){
+		// unnamed socket
+		return 0;
+	}
+	int32_t path_length = (int32_t)(sockaddr_length - offsetof(struct sockaddr_un, sun_path));
+	if(path_length > (int32_t)sizeof(sockaddr->sun_path)){
+		path_length = sizeof(sockaddr->sun_path);
+	}
+	if(sockaddr->sun_path[0] != 0){
+		// filesystem path: strip the terminating NUL character
+		path_length = strnlen(sockaddr->sun_path, path_length);
+	}
+	if(path_length > length){
+		return -1;
+	}
+	memcpy(path, sockaddr->sun_path, path_length);
+	return path_length;
+}
+
+/**
+ * @brief Gets the local or peer path of a Unix domain socket.
+ */
+static int32_t unix_socket_get_path(int32_t fd, int8_t* path, int32_t length, bool local){
+	if(llnet_is_ready() == false){
+		SNI_throwNativeIOException(J_NETWORK_NOT_INITIALIZED, "network not initialized");
+		return SNI_IGNORED_RETURNED_VALUE;
+	}
+
+	struct sockaddr_un sockaddr;
+	socklen_t sockaddr_length = sizeof(sockaddr);
+	int32_t res = local ? llnet_getsockname(fd, (struct sockaddr*)&sockaddr, &sockaddr_length)
+						: llnet_getpeername(fd, (struct sockaddr*)&sockaddr, &sockaddr_length);
+	if(res == -1){
+		int32_t fd_errno = llnet_errno(fd);
+		SNI_throwNativeIOException(LLNET_map_to_java_exception(fd_errno), LLNET_get_socket_error_msg(fd_errno));
+		return SNI_IGNORED_RETURNED_VALUE;
+	}
+	if(sockaddr.sun_family != AF_UNIX){
+		SNI_throwNativeIOException(J_EAFNOSUPPORT, "unsupported address family");
+		return SNI_IGNORED_RETURNED_VALUE;
+	}
+
+	int32_t path_length = unix_socket_from_sockaddr(&sockaddr, sockaddr_length, path, length);
+	if(path_length < 0){
+		SNI_throwNativeIOException(J_EINVAL, "wrong path length");
+		return SNI_IGNORED_RETURNED_VALUE;
+	}
+	return path_length;
+}
+
+#ifdef __cplusplus
+	}
+#endif
@@ -0,0 +1,83 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ *
+ */
+
+/**
+ * @file
+ * @brief MicroEJ Security low level API: Linux kernel crypto API (AF_ALG) backend.
+ *
+ * The following digest, MAC and cipher algorithms can run on the kernel crypto API instead of OpenSSL, to use the
+ * crypto engine of the SoC when the kernel has a driver for it (the kernel software implementation otherwise):
+ * - "MD5", "SHA-1", "SHA-256" and "SHA-512" (md5, sha1, sha256 and sha512 hashes),
+ * - "HmacSHA256" (hmac(sha256) hash),
+ * - "AES/CBC/NoPadding" and "DESede/CBC/NoPadding" (cbc(aes) and cbc(des3_ede) ciphers).
+ *
+ * An algorithm runs on the kernel when it is selected and the kernel provides it, on OpenSSL otherwise. The selection
+ * is a comma separated list of algorithm names, or "*" for all of them: LLSEC_AFALG_ALGORITHMS at build time, replaced
+ * by the LLSEC_AFALG environment variable, or by LLSEC_AFALG_select() at run time. It applies to the digests, MACs and
+ * ciphers initialized afterwards.
+ *
+ * Each operation costs a few system calls: the kernel suits large buffers and crypto engines, small messages are
+ * faster on OpenSSL. The buffers of at least LLSEC_AFALG_SPLICE_THRESHOLD bytes are given to the kernel without copy.
+ * The AEAD transformations always run on OpenSSL.
+ *
+ * The functions returning an error set the OpenSSL error queue with the system error.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#ifndef LLSEC_AFALG_OPENSSL_H
+#define LLSEC_AFALG_OPENSSL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+typedef struct {
+	int tfm_fd;      // socket bound to the kernel algorithm, holding the key
+	int op_fd;       // socket of the operations, accepted from tfm_fd
+	int pipe_fds[2]; // pipe of the transfers without copy, opened on the first large buffer
+	bool pending;    // hash data written since the last result
+} LLSEC_afalg_ctx;
+
+// Select the algorithms that run on the kernel: comma separated names, "*" for all of them, or NULL to restore the
+// selection of the LLSEC_AFALG environment variable or of LLSEC_AFALG_ALGORITHMS
+void LLSEC_AFALG_select(const char* algorithm_names);
+
+// Return true if the algorithm is selected and provided by the kernel
+bool LLSEC_AFALG_is_enabled(const char* algorithm_name);
+
+// Open the kernel algorithm of an LLSEC algorithm, with its key if not NULL. Return false on error
+bool LLSEC_AFALG_open(LLSEC_afalg_ctx* ctx, const char* algorithm_name, const uint8_t* key, int32_t key_length);
+
+// Close the sockets and the pipe
+void LLSEC_AFALG_close(LLSEC_afalg_ctx* ctx);
+
+// Hash: add data, then compute the result if more is false. Return false on error
+bool LLSEC_AFALG_hash_update(LLSEC_afalg_ctx* ctx, const uint8_t* data, int32_t length, bool more);
+
+// Hash: read the result and restart for a new message. Return the result size, or -1 on error
+int32_t LLSEC_AFALG_hash_final(LLSEC_afalg_ctx* ctx, uint8_t* out, int32_t out_length);
+
+// Hash: drop the data written since the last result. Return false on error
+bool LLSEC_AFALG_hash_reset(LLSEC_afalg_ctx* ctx);
+
+// Cipher: encrypt or decrypt up to LLSEC_AFALG_CHUNK_SIZE bytes, a multiple of the block size, with the given IV. The
+// IV is not updated. Return false on error
+bool LLSEC_AFALG_cipher(LLSEC_afalg_ctx* ctx, bool decrypt, const uint8_t* iv, int32_t iv_length,
+                        const uint8_t* in, int32_t length, uint8_t* out);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif /* LLSEC_AFALG_OPENSSL_H */
@@ -0,0 +1,69 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ *
+ */
+
+/**
+ * @file
+ * @brief MicroEJ Security low level API: authenticated encryption natives.
+ *
+ * The AEAD transformations ("AES/GCM/NoPadding" and "ChaCha20-Poly1305") encrypt or decrypt and authenticate the data
+ * in a single pass. They use the LLSEC_CIPHER_IMPL_init(), encrypt(), decrypt() and close() natives of the other
+ * transformations, with the IV as nonce (12 bytes recommended), and the natives below:
+ * - the additional authenticated data is given with LLSEC_CIPHER_IMPL_update_aad() before the first encrypt() or
+ *   decrypt() call,
+ * - an encryption ends with LLSEC_CIPHER_IMPL_get_tag(),
+ * - a decryption ends with LLSEC_CIPHER_IMPL_verify_tag(). The decrypted data must not be used before the tag is
+ *   verified.
+ *
+ * A new message can then be processed after a new nonce is set with LLSEC_CIPHER_IMPL_set_IV(). A nonce must never be
+ * reused with the same key.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#ifndef LLSEC_CIPHER_OPENSSL_H
+#define LLSEC_CIPHER_OPENSSL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+// Minimum and maximum sizes of an authentication tag in bytes
+#define LLSEC_CIPHER_AEAD_MIN_TAG_LENGTH (4)
+#define LLSEC_CIPHER_AEAD_MAX_TAG_LENGTH (16)
+
+#ifndef LLSEC_CIPHER_IMPL_update_aad
+#define LLSEC_CIPHER_IMPL_update_aad Java_com_microej_security_AEADCipher_updateAAD
+#endif
+#ifndef LLSEC_CIPHER_IMPL_get_tag
+#define LLSEC_CIPHER_IMPL_get_tag Java_com_microej_security_AEADCipher_getTag
+#endif
+#ifndef LLSEC_CIPHER_IMPL_verify_tag
+#define LLSEC_CIPHER_IMPL_verify_tag Java_com_microej_security_AEADCipher_verifyTag
+#endif
+
+// Native: authenticate additional data of an AEAD transformation. Return SNI_OK, or SNI_ERROR on error with an exception
+// thrown
+int32_t LLSEC_CIPHER_IMPL_update_aad(int32_t transformation_id, int32_t native_id, uint8_t* aad, int32_t aad_offset, int32_t aad_length);
+
+// Native: end an AEAD encryption and get the tag of tag_length bytes. Return tag_length, or SNI_ERROR on error with an
+// exception thrown
+int32_t LLSEC_CIPHER_IMPL_get_tag(int32_t transformation_id, int32_t native_id, uint8_t* tag, int32_t tag_offset, int32_t tag_length);
+
+// Native: end an AEAD decryption and verify its tag. Return 1 if the data is authentic, 0 if not, or SNI_ERROR on error
+// with an exception thrown
+int32_t LLSEC_CIPHER_IMPL_verify_tag(int32_t transformation_id, int32_t native_id, uint8_t* tag, int32_t tag_offset, int32_t tag_length);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif /* LLSEC_CIPHER_OPENSSL_H */
@@ -0,0 +1,84 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ *
+ */
+
+/**
+ * @file
+ * @brief MicroEJ Security low level API: OpenSSL algorithm table and context pools.
+ *
+ * The digest and cipher algorithms are fetched once (explicit fetch with OpenSSL 3, which otherwise fetches the
+ * algorithm implicitly on each init) and looked up by type. The digest, cipher and MAC contexts are reset and kept
+ * for reuse instead of being freed, up to LLSEC_CTX_POOL_SIZE of each kind. The public key contexts are kept bound
+ * to their key, up to LLSEC_CTX_POOL_PKEY_SIZE: a context holds a reference to its key, which stays allocated until
+ * the context is evicted.
+ *
+ * The pools can be used from any task.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#ifndef LLSEC_CTX_POOL_OPENSSL_H
+#define LLSEC_CTX_POOL_OPENSSL_H
+
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/opensslv.h>
+#include "LLSEC_openssl.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+#if (OPENSSL_VERSION_NUMBER < 0x30000000L)
+typedef HMAC_CTX LLSEC_mac_ctx;
+#else
+typedef EVP_MAC_CTX LLSEC_mac_ctx;
+#endif
+
+// Initialize the pools, called by OPENSSL_SECURITY_global_initialize() and on first use
+void LLSEC_CTX_POOL_initialize(void);
+
+// Get a digest algorithm, NULL if not available
+const EVP_MD* LLSEC_CTX_POOL_get_md(LLSEC_md_type type);
+
+// Get a cipher algorithm, NULL if not available
+const EVP_CIPHER* LLSEC_CTX_POOL_get_cipher(LLSEC_cipher_type type);
+
+// Take a digest context, to initialize with EVP_DigestInit_ex(). Return NULL if out of memory
+EVP_MD_CTX* LLSEC_CTX_POOL_take_md_ctx(void);
+
+// Reset a digest context and keep it for reuse, or free it if the pool is full
+void LLSEC_CTX_POOL_give_md_ctx(EVP_MD_CTX* ctx);
+
+// Take a cipher context, to initialize with EVP_EncryptInit_ex() or EVP_DecryptInit_ex(). Return NULL if out of memory
+EVP_CIPHER_CTX* LLSEC_CTX_POOL_take_cipher_ctx(void);
+
+// Reset a cipher context and keep it for reuse, or free it if the pool is full
+void LLSEC_CTX_POOL_give_cipher_ctx(EVP_CIPHER_CTX* ctx);
+
+// Take an HMAC context, to initialize with HMAC_Init_ex() or EVP_MAC_init(). Return NULL if out of memory
+LLSEC_mac_ctx* LLSEC_CTX_POOL_take_mac_ctx(void);
+
+// Reset an HMAC context and keep it for reuse, or free it if the pool is full
+void LLSEC_CTX_POOL_give_mac_ctx(LLSEC_mac_ctx* ctx);
+
+// Take a context bound to a public or private key, to initialize with the operation init. Return NULL if out of memory
+EVP_PKEY_CTX* LLSEC_CTX_POOL_take_pkey_ctx(EVP_PKEY* key);
+
+// Keep a key context for reuse with the same key, evicting the oldest one if the pool is full
+void LLSEC_CTX_POOL_give_pkey_ctx(EVP_PKEY_CTX* ctx);
+
+// Free the kept contexts bound to a key, to call when the key is closed so that it is not held by the pool
+void LLSEC_CTX_POOL_purge_pkey_ctx(const EVP_PKEY* key);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif /* LLSEC_CTX_POOL_OPENSSL_H */
@@ -0,0 +1,51 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ *
+ */
+
+/**
+ * @file
+ * @brief MicroEJ Security low level API: one-shot digest natives.
+ *
+ * These natives hash a whole message, or many small messages, in a single native call instead of the init(),
+ * update(), digest() and close() calls. The messages are given back to back in one buffer, with their lengths, and
+ * their digests are written back to back in the output buffer.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#ifndef LLSEC_DIGEST_OPENSSL_H
+#define LLSEC_DIGEST_OPENSSL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+#ifndef LLSEC_DIGEST_IMPL_digest_once
+#define LLSEC_DIGEST_IMPL_digest_once Java_com_microej_security_OneShotDigest_digest
+#endif
+#ifndef LLSEC_DIGEST_IMPL_digest_many
+#define LLSEC_DIGEST_IMPL_digest_many Java_com_microej_security_OneShotDigest_digestMany
+#endif
+
+// Native: hash buffer_length bytes. Return the digest length, or SNI_ERROR on error with an exception thrown
+int32_t LLSEC_DIGEST_IMPL_digest_once(int32_t algorithm_id, uint8_t* buffer, int32_t buffer_offset, int32_t buffer_length,
+                                      uint8_t* out, int32_t out_offset, int32_t out_length);
+
+// Native: hash count messages stored back to back, the lengths of which are given in lengths. Return the total length of
+// the digests, or SNI_ERROR on error with an exception thrown
+int32_t LLSEC_DIGEST_IMPL_digest_many(int32_t algorithm_id, uint8_t* buffer, int32_t buffer_offset, int32_t buffer_length,
+                                      int32_t* lengths, int32_t count, uint8_t* out, int32_t out_offset, int32_t out_length);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif /* LLSEC_DIGEST_OPENSSL_H */
@@ -0,0 +1,64 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ *
+ */
+
+/**
+ * @file
+ * @brief MicroEJ Security low level API: pre-generated key pairs.
+ *
+ * A background task keeps up to LLSEC_KEY_POOL_DEPTH key pairs ready for each of the last LLSEC_KEY_POOL_SLOTS
+ * requested EC curves (and RSA key sizes and exponents if LLSEC_KEY_POOL_RSA_ENABLED is set). A key pair generation
+ * takes a ready key pair if there is one, otherwise it generates it as before and the background task fills the pool
+ * for the next requests. The background task runs with the lowest priority, so it uses the idle CPU time.
+ *
+ * With OpenSSL 1.0.2, the background task is only started if the application has installed the OpenSSL locking
+ * callbacks.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#ifndef LLSEC_KEY_POOL_OPENSSL_H
+#define LLSEC_KEY_POOL_OPENSSL_H
+
+#include <stdint.h>
+#include <openssl/evp.h>
+#include "LLSEC_configuration.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+// Maximum size of an EC curve name
+#define LLSEC_KEY_POOL_CURVE_NAME_SIZE (32)
+
+// Statistics ids, see LLSEC_KEY_POOL_IMPL_getStatistic()
+#define LLSEC_KEY_POOL_STAT_HITS      (0) // key pairs taken from the pool
+#define LLSEC_KEY_POOL_STAT_MISSES    (1) // key pairs generated on request because the pool was empty
+#define LLSEC_KEY_POOL_STAT_GENERATED (2) // key pairs generated by the background task
+#define LLSEC_KEY_POOL_STAT_READY     (3) // key pairs currently ready
+#define LLSEC_KEY_POOL_STAT_COUNT     (4)
+
+#ifndef LLSEC_KEY_POOL_IMPL_getStatistic
+#define LLSEC_KEY_POOL_IMPL_getStatistic Java_com_microej_security_KeyPairPool_getStatistic
+#endif
+
+// Take a ready EC key pair for this curve, NULL if there is none. The pool is then refilled in the background
+EVP_PKEY* LLSEC_KEY_POOL_take_ec(const char* curve_name);
+
+// Take a ready RSA key pair for this size and public exponent, NULL if there is none or the RSA pool is disabled
+EVP_PKEY* LLSEC_KEY_POOL_take_rsa(int32_t key_size, int32_t public_exponent);
+
+// Native: get a statistic, one of LLSEC_KEY_POOL_STAT_*. Return -1 for an unknown id
+int64_t LLSEC_KEY_POOL_IMPL_getStatistic(int32_t id);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif /* LLSEC_KEY_POOL_OPENSSL_H */
@@ -0,0 +1,53 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ *
+ */
+
+/**
+ * @file
+ * @brief MicroEJ Security low level API: one-shot MAC natives.
+ *
+ * These natives authenticate a whole message, or many small messages with the same key, in a single native call
+ * instead of the init(), update(), do_final() and close() calls. The messages are given back to back in one buffer,
+ * with their lengths, and their MACs are written back to back in the output buffer.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#ifndef LLSEC_MAC_OPENSSL_H
+#define LLSEC_MAC_OPENSSL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+#ifndef LLSEC_MAC_IMPL_mac_once
+#define LLSEC_MAC_IMPL_mac_once Java_com_microej_security_OneShotMac_mac
+#endif
+#ifndef LLSEC_MAC_IMPL_mac_many
+#define LLSEC_MAC_IMPL_mac_many Java_com_microej_security_OneShotMac_macMany
+#endif
+
+// Native: authenticate buffer_length bytes. Return the MAC length, or SNI_ERROR on error with an exception thrown
+int32_t LLSEC_MAC_IMPL_mac_once(int32_t algorithm_id, uint8_t* key, int32_t key_length,
+                                uint8_t* buffer, int32_t buffer_offset, int32_t buffer_length,
+                                uint8_t* out, int32_t out_offset, int32_t out_length);
+
+// Native: authenticate count messages stored back to back, the lengths of which are given in lengths. Return the total
+// length of the MACs, or SNI_ERROR on error with an exception thrown
+int32_t LLSEC_MAC_IMPL_mac_many(int32_t algorithm_id, uint8_t* key, int32_t key_length,
+                                uint8_t* buffer, int32_t buffer_offset, int32_t buffer_length, int32_t* lengths, int32_t count,
+                                uint8_t* out, int32_t out_offset, int32_t out_length);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif /* LLSEC_MAC_OPENSSL_H */
@@ -0,0 +1,74 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ *
+ */
+
+/**
+ * @file
+ * @brief MicroEJ Security low level API: cache of decoded certificates and keys.
+ *
+ * The X509 and EVP_PKEY objects decoded from DER or PEM bytes are kept in a LRU cache of LLSEC_OBJECT_CACHE_SIZE
+ * entries, identified by the SHA-256 hash of the bytes. Decoding the same bytes again returns a new reference to the
+ * cached object, without ASN.1 parsing. The objects are reference counted: the callers free their reference as
+ * before and the cache frees its reference on eviction.
+ *
+ * Private keys are only cached if LLSEC_OBJECT_CACHE_PRIVATE_KEYS is set.
+ *
+ * The cache must be used from the VM task only.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#ifndef LLSEC_OBJECT_CACHE_OPENSSL_H
+#define LLSEC_OBJECT_CACHE_OPENSSL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+#include "LLSEC_configuration.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+// Kinds of cached objects, the same bytes decoded as different kinds are different entries
+typedef enum {
+	LLSEC_OBJECT_CACHE_X509,
+	LLSEC_OBJECT_CACHE_PUBLIC_KEY,
+	LLSEC_OBJECT_CACHE_RSA_PRIVATE_KEY,
+	LLSEC_OBJECT_CACHE_EC_PRIVATE_KEY
+} LLSEC_object_cache_kind;
+
+// Identifier of a cache entry
+typedef struct {
+	LLSEC_object_cache_kind kind;
+	int32_t length;
+	uint8_t hash[32];
+} LLSEC_object_cache_key;
+
+// Compute the identifier of encoded bytes. Return false if the bytes cannot be cached
+bool LLSEC_OBJECT_CACHE_make_key(LLSEC_object_cache_key* key, LLSEC_object_cache_kind kind, const uint8_t* data, int32_t length);
+
+// Get a new reference to a cached certificate and its format, NULL if not cached
+X509* LLSEC_OBJECT_CACHE_get_x509(const LLSEC_object_cache_key* key, int* format);
+
+// Add a decoded certificate to the cache, which takes its own reference
+void LLSEC_OBJECT_CACHE_put_x509(const LLSEC_object_cache_key* key, X509* x509, int format);
+
+// Get a new reference to a cached key, NULL if not cached
+EVP_PKEY* LLSEC_OBJECT_CACHE_get_pkey(const LLSEC_object_cache_key* key);
+
+// Add a decoded key to the cache, which takes its own reference
+void LLSEC_OBJECT_CACHE_put_pkey(const LLSEC_object_cache_key* key, EVP_PKEY* pkey);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif /* LLSEC_OBJECT_CACHE_OPENSSL_H */
@@ -0,0 +1,160 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ *
+ */
+
+/**
+ * @file
+ * @brief MicroEJ Security low level API: crypto workers for the expensive operations.
+ *
+ * RSA and EC key generations, signatures, verifications, RSA decryptions and PBKDF2 derivations run on a pool of
+ * async workers when their cost is above the LLSEC_WORKER_*_MIN_* thresholds, so they do not block the other Java
+ * threads. The calling Java thread is suspended until its operation is done. Cheaper operations run inline on the
+ * VM task.
+ *
+ * The inputs are copied to the job before the Java thread is suspended and the outputs are copied back to the Java
+ * arrays in the on_done callback, on the VM task. The workers only call OpenSSL: the SNI resources are registered and
+ * the exceptions thrown from the on_done callbacks. The OpenSSL error queue is per thread, so the worker stores the
+ * error in the job. The key of a job is referenced until the job is freed: another Java thread may close it meanwhile.
+ *
+ * With OpenSSL 1.0.2, the workers are only started if the application has installed the OpenSSL locking callbacks.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#ifndef LLSEC_WORKER_OPENSSL_H
+#define LLSEC_WORKER_OPENSSL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <openssl/evp.h>
+#include "sni.h"
+#include "microej_async_worker.h"
+#include "LLSEC_configuration.h"
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+#if (LLSEC_WORKER_COUNT < 1) || (LLSEC_WORKER_COUNT > 4)
+#error "LLSEC_WORKER_COUNT must be between 1 and 4"
+#endif
+
+// Maximum size of a digest to sign or verify (SHA-512)
+#define LLSEC_WORKER_DIGEST_SIZE (64)
+
+// Maximum size of an EC curve name
+#define LLSEC_WORKER_CURVE_NAME_SIZE (32)
+
+// Maximum size of an error message
+#define LLSEC_WORKER_ERROR_MESSAGE_SIZE (128)
+
+// OpenSSL error of an operation done on a worker
+typedef struct {
+	unsigned long code;
+	char message[LLSEC_WORKER_ERROR_MESSAGE_SIZE];
+} LLSEC_WORKER_error;
+
+// Signature or verification
+typedef struct {
+	int32_t algorithm_id;
+	uint8_t digest[LLSEC_WORKER_DIGEST_SIZE];
+	int32_t digest_length;
+	uint8_t signature[LLSEC_WORKER_BUFFER_SIZE];
+	int32_t signature_length;
+} LLSEC_WORKER_signature;
+
+// RSA decryption
+typedef struct {
+	int32_t transformation_id;
+	uint8_t input[LLSEC_WORKER_BUFFER_SIZE];
+	int32_t input_length;
+	uint8_t output[LLSEC_WORKER_BUFFER_SIZE];
+	int32_t output_length;
+} LLSEC_WORKER_rsa_cipher;
+
+// RSA or EC key pair generation
+typedef struct {
+	int32_t algorithm_id;
+	int32_t rsa_key_size;
+	int32_t rsa_public_exponent;
+	char ec_curve_stdname[LLSEC_WORKER_CURVE_NAME_SIZE];
+	EVP_PKEY* key; // the generated key
+} LLSEC_WORKER_key_pair;
+
+// PBKDF2 derivation
+typedef struct {
+	int32_t algorithm_id;
+	uint8_t password[LLSEC_WORKER_BUFFER_SIZE];
+	int32_t password_length;
+	uint8_t salt[LLSEC_WORKER_BUFFER_SIZE];
+	int32_t salt_length;
+	int32_t iterations;
+	int32_t key_length; // in bytes
+	uint8_t* key; // the derived key, allocated with LLSEC_calloc
+} LLSEC_WORKER_pbkdf2;
+
+// Parameters and result of a job
+typedef struct {
+	MICROEJ_ASYNC_WORKER_handle_t* worker; // worker that executes the job
+	int32_t result; // operation result
+	LLSEC_WORKER_error error; // set if the operation failed
+	EVP_PKEY* key; // key of a signature, verification or RSA decryption, see LLSEC_WORKER_hold_key()
+	union {
+		LLSEC_WORKER_signature signature;
+		LLSEC_WORKER_rsa_cipher rsa_cipher;
+		LLSEC_WORKER_key_pair key_pair;
+		LLSEC_WORKER_pbkdf2 pbkdf2;
+	} operation;
+} LLSEC_WORKER_job;
+
+// Start the workers, called by OPENSSL_SECURITY_global_initialize() and on first use. If a worker cannot be started,
+// all the operations run on the VM task
+void LLSEC_WORKER_initialize(void);
+
+// Tell whether an RSA or EC operation with this key is worth a worker, i.e. the workers are started and the key is
+// above the threshold. RSA public key operations always run inline
+bool LLSEC_WORKER_is_expensive_pkey(EVP_PKEY* key, bool is_private);
+
+// Tell whether an RSA key generation is worth a worker
+bool LLSEC_WORKER_is_expensive_rsa_keygen(int32_t key_size);
+
+// Tell whether an EC key generation is worth a worker
+bool LLSEC_WORKER_is_expensive_ec_keygen(const char* curve_name);
+
+// Tell whether a PBKDF2 derivation is worth a worker
+bool LLSEC_WORKER_is_expensive_pbkdf2(int32_t iterations);
+
+// Allocate a job, from the VM task. If no job is available, the current Java thread is suspended, retry_callback is
+// called when a job is available and NULL is returned. On error, NULL is returned and an exception is pending
+MICROEJ_ASYNC_WORKER_job_t* LLSEC_WORKER_allocate_job(SNI_callback retry_callback);
+
+// Execute a job and suspend the current Java thread until it is done, then on_done_callback is called with the
+// arguments of the native. On error, the job is freed and an exception is pending
+void LLSEC_WORKER_exec(MICROEJ_ASYNC_WORKER_job_t* job, MICROEJ_ASYNC_WORKER_action_t action, SNI_callback on_done_callback);
+
+// Get the job done, from an on_done_callback. Its parameters must be read before LLSEC_WORKER_free_job()
+MICROEJ_ASYNC_WORKER_job_t* LLSEC_WORKER_get_job_done(void);
+
+// Free a job, and release its key
+void LLSEC_WORKER_free_job(MICROEJ_ASYNC_WORKER_job_t* job);
+
+// Reference the key of a job until the job is freed, from the VM task before LLSEC_WORKER_exec()
+void LLSEC_WORKER_hold_key(LLSEC_WORKER_job* params, EVP_PKEY* key);
+
+// Save the first OpenSSL error of the worker thread in the job, from an action
+void LLSEC_WORKER_save_error(LLSEC_WORKER_job* params);
+
+// Throw a NativeException with the error saved in the job, from an on_done_callback
+void LLSEC_WORKER_throw_error(const LLSEC_WORKER_job* params);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif /* LLSEC_WORKER_OPENSSL_H */
@@ -22,4 +22,130 @@
 #define LLSEC_calloc                              calloc
 #define LLSEC_free                                free
 
+// Maximum number of idle digest, cipher and MAC contexts kept for reuse, per kind (see LLSEC_CTX_POOL_openssl.h)
+#ifndef LLSEC_CTX_POOL_SIZE
+#define LLSEC_CTX_POOL_SIZE                       (8)
+#endif
+
+// Maximum number of idle public key contexts kept for reuse, each one bound to its key
+#ifndef LLSEC_CTX_POOL_PKEY_SIZE
+#define LLSEC_CTX_POOL_PKEY_SIZE                  (4)
+#endif
+
+// Set to 0 to run all the public key operations and key derivations on the VM task (see LLSEC_WORKER_openssl.h)
+#ifndef LLSEC_WORKER_ENABLED
+#define LLSEC_WORKER_ENABLED                      (1)
+#endif
+
+// Number of crypto workers, from 1 to 4. Each worker has its own task
+#ifndef LLSEC_WORKER_COUNT
+#define LLSEC_WORKER_COUNT                        (1)
+#endif
+
+// Number of jobs of each crypto worker, i.e. operations it executes or queues at the same time
+#ifndef LLSEC_WORKER_JOB_COUNT
+#define LLSEC_WORKER_JOB_COUNT                    (4)
+#endif
+
+// Number of Java threads that can wait for a job of each crypto worker
+#ifndef LLSEC_WORKER_WAITING_LIST_SIZE
+#define LLSEC_WORKER_WAITING_LIST_SIZE            (8)
+#endif
+
+// Size of the stack of each crypto worker in bytes
+#ifndef LLSEC_WORKER_STACK_SIZE
+#define LLSEC_WORKER_STACK_SIZE                   (1024*64)
+#endif
+
+// Priority of the crypto workers
+#ifndef LLSEC_WORKER_PRIORITY
+#define LLSEC_WORKER_PRIORITY                     (5)
+#endif
+
+// Maximum size in bytes of a signature, RSA block, password or salt copied to a job. Larger operations run inline
+#ifndef LLSEC_WORKER_BUFFER_SIZE
+#define LLSEC_WORKER_BUFFER_SIZE                  (512)
+#endif
+
+// RSA key generations, signatures and decryptions with keys of at least this size run on a worker
+#ifndef LLSEC_WORKER_RSA_MIN_BITS
+#define LLSEC_WORKER_RSA_MIN_BITS                 (2048)
+#endif
+
+// EC key generations, signatures and verifications with curves of at least this size run on a worker
+#ifndef LLSEC_WORKER_EC_MIN_BITS
+#define LLSEC_WORKER_EC_MIN_BITS                  (384)
+#endif
+
+// PBKDF2 derivations with at least this number of iterations run on a worker
+#ifndef LLSEC_WORKER_PBKDF2_MIN_ITERATIONS
+#define LLSEC_WORKER_PBKDF2_MIN_ITERATIONS        (1000)
+#endif
+
+// Set to 0 to disable the pre-generation of key pairs (see LLSEC_KEY_POOL_openssl.h)
+#ifndef LLSEC_KEY_POOL_ENABLED
+#define LLSEC_KEY_POOL_ENABLED                    (1)
+#endif
+
+// Set to 1 to pre-generate RSA key pairs too
+#ifndef LLSEC_KEY_POOL_RSA_ENABLED
+#define LLSEC_KEY_POOL_RSA_ENABLED                (0)
+#endif
+
+// Number of curves or RSA key sizes with pre-generated key pairs, the least recently requested one is replaced
+#ifndef LLSEC_KEY_POOL_SLOTS
+#define LLSEC_KEY_POOL_SLOTS                      (4)
+#endif
+
+// Number of key pairs kept ready for each curve or RSA key size
+#ifndef LLSEC_KEY_POOL_DEPTH
+#define LLSEC_KEY_POOL_DEPTH                      (4)
+#endif
+
+// Size of the stack of the key pre-generation task in bytes
+#ifndef LLSEC_KEY_POOL_STACK_SIZE
+#define LLSEC_KEY_POOL_STACK_SIZE                 (1024*64)
+#endif
+
+// Priority of the key pre-generation task, for the OSAL ports that support it
+#ifndef LLSEC_KEY_POOL_PRIORITY
+#define LLSEC_KEY_POOL_PRIORITY                   (1)
+#endif
+
+// Nice value of the key pre-generation task on Linux, so it only runs when the CPU is idle
+#ifndef LLSEC_KEY_POOL_NICE
+#define LLSEC_KEY_POOL_NICE                       (19)
+#endif
+
+// Number of decoded certificates and keys kept for reuse (see LLSEC_OBJECT_CACHE_openssl.h), 0 to disable the cache
+#ifndef LLSEC_OBJECT_CACHE_SIZE
+#define LLSEC_OBJECT_CACHE_SIZE                   (8)
+#endif
+
+// Set to 1 to cache the decoded private keys too. They then stay in memory until evicted from the cache
+#ifndef LLSEC_OBJECT_CACHE_PRIVATE_KEYS
+#define LLSEC_OBJECT_CACHE_PRIVATE_KEYS           (0)
+#endif
+
+// Set to 0 to remove the Linux kernel crypto API backend (see LLSEC_AFALG_openssl.h)
+#ifndef LLSEC_AFALG_ENABLED
+#define LLSEC_AFALG_ENABLED                       (1)
+#endif
+
+// Comma separated names of the algorithms that run on the kernel crypto API, "*" for all of them. Replaced at run
+// time by the LLSEC_AFALG environment variable
+#ifndef LLSEC_AFALG_ALGORITHMS
+#define LLSEC_AFALG_ALGORITHMS                    ""
+#endif
+
+// Maximum number of bytes given to the kernel in one operation
+#ifndef LLSEC_AFALG_CHUNK_SIZE
+#define LLSEC_AFALG_CHUNK_SIZE                    (64*1024)
+#endif
+
+// Buffers of at least this size are given to the kernel without copy (vmsplice() and splice())
+#ifndef LLSEC_AFALG_SPLICE_THRESHOLD
+#define LLSEC_AFALG_SPLICE_THRESHOLD              (16*1024)
+#endif
+
 #endif /* LLSEC_CONFIGURATION_H */
@@ -17,6 +17,8 @@
 #ifndef LLSEC_OPENSSL_H
 #define LLSEC_OPENSSL_H
 
+#include <stdbool.h>
+#include <stdint.h>
 #include "openssl/evp.h"
 
 #ifdef __cplusplus
@@ -48,9 +50,23 @@ typedef enum {
     LLSEC_MD_SHA224,
     LLSEC_MD_SHA256,
     LLSEC_MD_SHA384,
-    LLSEC_MD_SHA512
+    LLSEC_MD_SHA512,
+    LLSEC_MD_MD5,
+    LLSEC_MD_TYPES_COUNT
 } LLSEC_md_type;
 
+typedef enum {
+    LLSEC_CIPHER_AES_128_CBC,
+    LLSEC_CIPHER_AES_192_CBC,
+    LLSEC_CIPHER_AES_256_CBC,
+    LLSEC_CIPHER_DES_EDE3_CBC,
+    LLSEC_CIPHER_AES_128_GCM,
+    LLSEC_CIPHER_AES_192_GCM,
+    LLSEC_CIPHER_AES_256_GCM,
+    LLSEC_CIPHER_CHACHA20_POLY1305, // NULL cipher with OpenSSL 1.0.2
+    LLSEC_CIPHER_TYPES_COUNT
+} LLSEC_cipher_type;
+
 //keep backward compatibility
 #define openssl_security_global_initialize OPENSSL_SECURITY_global_initialize
 
@@ -61,6 +77,16 @@ void OPENSSL_SECURITY_global_initialize(void);
 // clean up openssl algorithm and error string
 void OPENSSL_SECURITY_global_clean_up(void);
 
+// Check the arguments of a multi-buffer native: count messages of the given lengths stored back to back in buffer_length
+// bytes, and count outputs of output_size bytes in out_length bytes
+bool OPENSSL_SECURITY_check_messages(int32_t buffer_length, const int32_t* lengths, int32_t count, int32_t out_length, int32_t output_size);
+
+// Generate an RSA key pair, NULL on error with the OpenSSL error queue set. Does not use SNI
+EVP_PKEY* LLSEC_KEY_PAIR_GENERATOR_RSA_openssl_generate(int32_t rsa_Key_size, int32_t rsa_public_exponent);
+
+// Generate an EC key pair, NULL on error with the OpenSSL error queue set. Does not use SNI
+EVP_PKEY* LLSEC_KEY_PAIR_GENERATOR_EC_openssl_generate(const char* ec_curve_stdname);
+
 #ifdef __cplusplus
 	}
 #endif
@@ -0,0 +1,484 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ *
+ */
+
+/**
+ * @file
+ * @brief MicroEJ Security low level API: Linux kernel crypto API (AF_ALG) backend.
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <linux/if_alg.h>
+#include <openssl/err.h>
+#include <openssl/opensslv.h>
+#include "LLSEC_configuration.h"
+#include "LLSEC_AFALG_openssl.h"
+
+// #define LLSEC_AFALG_DEBUG_TRACE
+
+#ifdef LLSEC_AFALG_DEBUG_TRACE
+#define LLSEC_AFALG_DEBUG_PRINTF(...) (void)printf(__VA_ARGS__)
+#else
+#define LLSEC_AFALG_DEBUG_PRINTF(...) ((void)0)
+#endif
+
+#if LLSEC_AFALG_ENABLED
+
+#ifndef SOL_ALG
+#define SOL_ALG (279)
+#endif
+
+// Maximum size of a hash result (SHA-512)
+#define LLSEC_AFALG_MAX_HASH_SIZE  (64)
+
+// Maximum size of an IV (AES block)
+#define LLSEC_AFALG_MAX_IV_SIZE    (16)
+
+// Maximum size of the selection string
+#define LLSEC_AFALG_SELECTION_SIZE (256)
+
+typedef struct {
+	const char* algorithm_name; // the LLSEC name
+	const char* type;           // the kernel algorithm type
+	const char* name;           // the kernel algorithm name
+	int8_t available;           // 1 if the kernel provides the algorithm, 0 if not, -1 if not checked yet
+} LLSEC_AFALG_algorithm;
+
+static LLSEC_AFALG_algorithm algorithms[7] = {
+	{ "MD5",                  "hash",     "md5",           -1 },
+	{ "SHA-1",                "hash",     "sha1",          -1 },
+	{ "SHA-256",              "hash",     "sha256",        -1 },
+	{ "SHA-512",              "hash",     "sha512",        -1 },
+	{ "HmacSHA256",           "hash",     "hmac(sha256)",  -1 },
+	{ "AES/CBC/NoPadding",    "skcipher", "cbc(aes)",      -1 },
+	{ "DESede/CBC/NoPadding", "skcipher", "cbc(des3_ede)", -1 },
+};
+
+// Selected algorithms, loaded on first use. Only used by the VM task
+static char selection[LLSEC_AFALG_SELECTION_SIZE];
+static bool selection_loaded = false;
+
+static LLSEC_AFALG_algorithm* LLSEC_AFALG_find(const char* algorithm_name);
+static bool LLSEC_AFALG_is_selected(const char* algorithm_name);
+static int LLSEC_AFALG_bind(const LLSEC_AFALG_algorithm* algorithm);
+static bool LLSEC_AFALG_send(int fd, const uint8_t* data, int32_t length, int flags);
+static bool LLSEC_AFALG_receive(int fd, uint8_t* out, int32_t length);
+static bool LLSEC_AFALG_splice(LLSEC_afalg_ctx* ctx, const uint8_t* data, int32_t length);
+static void LLSEC_AFALG_close_fd(int* fd);
+static void LLSEC_AFALG_put_error(int error);
+
+void LLSEC_AFALG_select(const char* algorithm_names) {
+	const char* names = algorithm_names;
+	if (NULL == names) {
+		names = getenv("LLSEC_AFALG");
+	}
+	if (NULL == names) {
+		names = LLSEC_AFALG_ALGORITHMS;
+	}
+	(void)snprintf(selection, sizeof(selection), "%s", names);
+	selection_loaded = true;
+	LLSEC_AFALG_DEBUG_PRINTF("%s \"%s\"\n", __func__, selection);
+}
+
+bool LLSEC_AFALG_is_enabled(const char* algorithm_name) {
+	bool enabled = false;
+	LLSEC_AFALG_algorithm* algorithm = LLSEC_AFALG_find(algorithm_name);
+	if ((NULL != algorithm) && LLSEC_AFALG_is_selected(algorithm_name)) {
+		if (0 > algorithm->available) {
+			// Checked once, binding a socket is enough
+			int fd = LLSEC_AFALG_bind(algorithm);
+			algorithm->available = (0 <= fd) ? 1 : 0;
+			LLSEC_AFALG_close_fd(&fd);
+			LLSEC_AFALG_DEBUG_PRINTF("%s %s(%s) %savailable\n", __func__, algorithm->type, algorithm->name,
+			                         (1 == algorithm->available) ? "" : "not ");
+		}
+		enabled = (1 == algorithm->available);
+	}
+	return enabled;
+}
+
+bool LLSEC_AFALG_open(LLSEC_afalg_ctx* ctx, const char* algorithm_name, const uint8_t* key, int32_t key_length) {
+	const LLSEC_AFALG_algorithm* algorithm = LLSEC_AFALG_find(algorithm_name);
+	bool ok = (NULL != algorithm);
+
+	ctx->tfm_fd = -1;
+	ctx->op_fd = -1;
+	ctx->pipe_fds[0] = -1;
+	ctx->pipe_fds[1] = -1;
+	ctx->pending = false;
+
+	if (!ok) {
+		errno = ENOENT;
+	} else {
+		ctx->tfm_fd = LLSEC_AFALG_bind(algorithm);
+		ok = (0 <= ctx->tfm_fd);
+	}
+	if (ok && (NULL != key)) {
+		ok = (0 == setsockopt(ctx->tfm_fd, SOL_ALG, ALG_SET_KEY, key, (socklen_t)key_length));
+	}
+	if (ok) {
+		// The operation socket inherits the key
+		ctx->op_fd = accept4(ctx->tfm_fd, NULL, NULL, SOCK_CLOEXEC);
+		ok = (0 <= ctx->op_fd);
+	}
+
+	if (!ok) {
+		LLSEC_AFALG_put_error(errno);
+		LLSEC_AFALG_close(ctx);
+	}
+	return ok;
+}
+
+void LLSEC_AFALG_close(LLSEC_afalg_ctx* ctx) {
+	LLSEC_AFALG_close_fd(&ctx->pipe_fds[0]);
+	LLSEC_AFALG_close_fd(&ctx->pipe_fds[1]);
+	LLSEC_AFALG_close_fd(&ctx->op_fd);
+	LLSEC_AFALG_close_fd(&ctx->tfm_fd);
+}
+
+bool LLSEC_AFALG_hash_update(LLSEC_afalg_ctx* ctx, const uint8_t* data, int32_t length, bool more) {
+	bool ok;
+	if (LLSEC_AFALG_SPLICE_THRESHOLD <= length) {
+		ok = LLSEC_AFALG_splice(ctx, data, length);
+		if (ok && !more) {
+			// The data was spliced as partial, an empty send computes the result
+			ok = LLSEC_AFALG_send(ctx->op_fd, data, 0, 0);
+		}
+	} else {
+		ok = LLSEC_AFALG_send(ctx->op_fd, data, length, more ? MSG_MORE : 0);
+	}
+	// On error, the partial data is dropped by the next reset
+	ctx->pending = more || !ok;
+
+	if (!ok) {
+		LLSEC_AFALG_put_error(errno);
+	}
+	return ok;
+}
+
+int32_t LLSEC_AFALG_hash_final(LLSEC_afalg_ctx* ctx, uint8_t* out, int32_t out_length) {
+	int32_t result_length = -1;
+	ssize_t received;
+	do {
+		// Computes the result if the last data was written with more set
+		received = recv(ctx->op_fd, out, (size_t)out_length, 0);
+	} while ((0 > received) && (EINTR == errno));
+	ctx->pending = false;
+
+	if (0 > received) {
+		LLSEC_AFALG_put_error(errno);
+	} else {
+		result_length = (int32_t)received;
+	}
+	return result_length;
+}
+
+bool LLSEC_AFALG_hash_reset(LLSEC_afalg_ctx* ctx) {
+	bool ok = true;
+	if (ctx->pending) {
+		uint8_t result[LLSEC_AFALG_MAX_HASH_SIZE];
+		ok = (0 <= LLSEC_AFALG_hash_final(ctx, result, (int32_t)sizeof(result)));
+	}
+	return ok;
+}
+
+bool LLSEC_AFALG_cipher(LLSEC_afalg_ctx* ctx, bool decrypt, const uint8_t* iv, int32_t iv_length,
+                        const uint8_t* in, int32_t length, uint8_t* out) {
+	bool ok = (0 < iv_length) && (LLSEC_AFALG_MAX_IV_SIZE >= iv_length) && (LLSEC_AFALG_CHUNK_SIZE >= length);
+	bool splice_input = (LLSEC_AFALG_SPLICE_THRESHOLD <= length);
+	union {
+		uint8_t buffer[CMSG_SPACE(sizeof(uint32_t)) + CMSG_SPACE(sizeof(struct af_alg_iv) + LLSEC_AFALG_MAX_IV_SIZE)];
+		struct cmsghdr align;
+	} control;
+	struct msghdr message;
+	struct iovec iov;
+
+	if (!ok) {
+		errno = EINVAL;
+	} else if (0 < length) {
+		(void)memset(&control, 0, sizeof(control));
+		(void)memset(&message, 0, sizeof(message));
+		message.msg_control = control.buffer;
+		message.msg_controllen = sizeof(control.buffer);
+
+		// The operation and the IV are given with the data, the kernel keeps no state between two calls
+		struct cmsghdr* header = CMSG_FIRSTHDR(&message);
+		uint32_t operation = decrypt ? ALG_OP_DECRYPT : ALG_OP_ENCRYPT;
+		header->cmsg_level = SOL_ALG;
+		header->cmsg_type = ALG_SET_OP;
+		header->cmsg_len = CMSG_LEN(sizeof(uint32_t));
+		(void)memcpy(CMSG_DATA(header), &operation, sizeof(operation));
+
+		header = CMSG_NXTHDR(&message, header);
+		struct af_alg_iv* alg_iv = (struct af_alg_iv*)CMSG_DATA(header);
+		header->cmsg_level = SOL_ALG;
+		header->cmsg_type = ALG_SET_IV;
+		header->cmsg_len = CMSG_LEN(sizeof(struct af_alg_iv) + (size_t)iv_length);
+		alg_iv->ivlen = (uint32_t)iv_length;
+		(void)memcpy(alg_iv->iv, iv, (size_t)iv_length);
+		message.msg_controllen = CMSG_SPACE(sizeof(uint32_t)) + CMSG_SPACE(sizeof(struct af_alg_iv) + (size_t)iv_length);
+
+		ssize_t sent;
+		if (splice_input) {
+			// Control only, the data follows
+			sent = sendmsg(ctx->op_fd, &message, MSG_MORE);
+			ok = (0 == sent);
+		} else {
+			iov.iov_base = (void*)in;
+			iov.iov_len = (size_t)length;
+			message.msg_iov = &iov;
+			message.msg_iovlen = 1;
+			sent = sendmsg(ctx->op_fd, &message, 0);
+			ok = (length == sent);
+		}
+		if (!ok && (0 <= sent)) {
+			errno = EIO;
+		}
+
+		if (ok && splice_input) {
+			ok = LLSEC_AFALG_splice(ctx, in, length);
+			if (ok) {
+				// End of the data
+				ok = LLSEC_AFALG_send(ctx->op_fd, in, 0, 0);
+			}
+		}
+		if (ok) {
+			ok = LLSEC_AFALG_receive(ctx->op_fd, out, length);
+		}
+	} else {
+		// Nothing to do
+	}
+
+	if (!ok) {
+		LLSEC_AFALG_put_error(errno);
+	}
+	return ok;
+}
+
+/**
+ * @brief Finds the kernel algorithm of an LLSEC algorithm.
+ *
+ * @param[in] algorithm_name the LLSEC algorithm name.
+ *
+ * @return the kernel algorithm, NULL if the algorithm can not run on the kernel.
+ */
+static LLSEC_AFALG_algorithm* LLSEC_AFALG_find(const char* algorithm_name) {
+	LLSEC_AFALG_algorithm* found = NULL;
+	int32_t nb_algorithms = sizeof(algorithms) / sizeof(LLSEC_AFALG_algorithm);
+	for (int32_t i = 0; (NULL == found) && (i < nb_algorithms); i++) {
+		if (0 == strcmp(algorithm_name, algorithms[i].algorithm_name)) {
+			found = &algorithms[i];
+		}
+	}
+	return found;
+}
+
+/**
+ * @brief Tells if an algorithm is in the selection.
+ *
+ * @param[in] algorithm_name the LLSEC algorithm name.
+ *
+ * @return true if the name or "*" is in the selection.
+ */
+static bool LLSEC_AFALG_is_selected(const char* algorithm_name) {
+	bool selected = false;
+	size_t name_length = strlen(algorithm_name);
+	if (!selection_loaded) {
+		LLSEC_AFALG_select(NULL);
+	}
+
+	const char* item = selection;
+	while (!selected && ('\0' != *item)) {
+		size_t item_length = strcspn(item, ",");
+		selected = ((1u == item_length) && ('*' == item[0])) ||
+		           ((name_length == item_length) && (0 == strncmp(item, algorithm_name, name_length)));
+		item = &item[item_length];
+		if (',' == *item) {
+			item++;
+		}
+	}
+	return selected;
+}
+
+/**
+ * @brief Opens a socket bound to a kernel algorithm.
+ *
+ * @param[in] algorithm the kernel algorithm.
+ *
+ * @return the socket, -1 on error with errno set.
+ */
+static int LLSEC_AFALG_bind(const LLSEC_AFALG_algorithm* algorithm) {
+	struct sockaddr_alg address;
+	(void)memset(&address, 0, sizeof(address));
+	address.salg_family = AF_ALG;
+	(void)strncpy((char*)address.salg_type, algorithm->type, sizeof(address.salg_type) - 1u);
+	(void)strncpy((char*)address.salg_name, algorithm->name, sizeof(address.salg_name) - 1u);
+
+	int fd = socket(AF_ALG, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+	if ((0 <= fd) && (0 != bind(fd, (struct sockaddr*)&address, sizeof(address)))) {
+		int error = errno;
+		(void)close(fd);
+		errno = error;
+		fd = -1;
+	}
+	return fd;
+}
+
+/**
+ * @brief Sends data, an empty send if length is 0.
+ *
+ * @param[in] fd the operation socket.
+ * @param[in] data the data.
+ * @param[in] length the data size in bytes.
+ * @param[in] flags MSG_MORE if more data follows, 0 otherwise.
+ *
+ * @return false on error with errno set.
+ */
+static bool LLSEC_AFALG_send(int fd, const uint8_t* data, int32_t length, int flags) {
+	bool ok = true;
+	int32_t offset = 0;
+	do {
+		ssize_t sent = send(fd, &data[offset], (size_t)(length - offset), flags);
+		if (0 <= sent) {
+			offset += (int32_t)sent;
+		} else if (EINTR != errno) {
+			ok = false;
+		} else {
+			// Interrupted, retry
+		}
+	} while (ok && (offset < length));
+	return ok;
+}
+
+/**
+ * @brief Receives the whole output of an operation.
+ *
+ * @param[in] fd the operation socket.
+ * @param[out] out the output buffer.
+ * @param[in] length the output size in bytes.
+ *
+ * @return false on error with errno set.
+ */
+static bool LLSEC_AFALG_receive(int fd, uint8_t* out, int32_t length) {
+	bool ok = true;
+	int32_t offset = 0;
+	while (ok && (offset < length)) {
+		ssize_t received = recv(fd, &out[offset], (size_t)(length - offset), 0);
+		if (0 < received) {
+			offset += (int32_t)received;
+		} else if (0 == received) {
+			errno = EIO;
+			ok = false;
+		} else if (EINTR != errno) {
+			ok = false;
+		} else {
+			// Interrupted, retry
+		}
+	}
+	return ok;
+}
+
+/**
+ * @brief Gives data to the kernel without copy: the pipe references the pages of the buffer, then gives them to the
+ * operation socket. The data is sent with more set, the buffer must not be modified before the result is read.
+ *
+ * @param[in] ctx the context, its pipe is opened on first use.
+ * @param[in] data the data.
+ * @param[in] length the data size in bytes.
+ *
+ * @return false on error with errno set.
+ */
+static bool LLSEC_AFALG_splice(LLSEC_afalg_ctx* ctx, const uint8_t* data, int32_t length) {
+	bool ok = true;
+	if (0 > ctx->pipe_fds[0]) {
+		ok = (0 == pipe2(ctx->pipe_fds, O_CLOEXEC));
+		if (ok) {
+			// Best effort, a larger pipe takes a whole chunk at once
+			(void)fcntl(ctx->pipe_fds[1], F_SETPIPE_SZ, LLSEC_AFALG_CHUNK_SIZE);
+		} else {
+			ctx->pipe_fds[0] = -1;
+			ctx->pipe_fds[1] = -1;
+		}
+	}
+
+	int32_t offset = 0;
+	while (ok && (offset < length)) {
+		struct iovec iov;
+		iov.iov_base = (void*)&data[offset];
+		iov.iov_len = (size_t)(length - offset);
+		ssize_t in_pipe = vmsplice(ctx->pipe_fds[1], &iov, 1, 0);
+		ok = (0 < in_pipe);
+		while (ok && (0 < in_pipe)) {
+			ssize_t moved = splice(ctx->pipe_fds[0], NULL, ctx->op_fd, NULL, (size_t)in_pipe, SPLICE_F_MORE);
+			ok = (0 < moved);
+			if (ok) {
+				in_pipe -= moved;
+				offset += (int32_t)moved;
+			}
+		}
+	}
+
+	if (!ok) {
+		// The pipe may still hold data, a new one is opened on next use
+		int error = errno;
+		LLSEC_AFALG_close_fd(&ctx->pipe_fds[0]);
+		LLSEC_AFALG_close_fd(&ctx->pipe_fds[1]);
+		errno = error;
+	}
+	return ok;
+}
+
+/**
+ * @brief Closes a file descriptor if open.
+ *
+ * @param[in,out] fd the file descriptor, set to -1.
+ */
+static void LLSEC_AFALG_close_fd(int* fd) {
+	if (0 <= *fd) {
+		(void)close(*fd);
+		*fd = -1;
+	}
+}
+
+/**
+ * @brief Adds a system error to the OpenSSL error queue, so that the natives throw it as the OpenSSL errors.
+ *
+ * @param[in] error the errno value.
+ */
+static void LLSEC_AFALG_put_error(int error) {
+	LLSEC_AFALG_DEBUG_PRINTF("%s %s\n", __func__, strerror(error));
+#if (OPENSSL_VERSION_NUMBER < 0x30000000L)
+	ERR_put_error(ERR_LIB_SYS, 0, error, __FILE__, __LINE__);
+#else
+	ERR_raise(ERR_LIB_SYS, error);
+#endif
+}
+
+#else // LLSEC_AFALG_ENABLED
+
+void LLSEC_AFALG_select(const char* algorithm_names) {
+	(void)algorithm_names;
+}
+
+bool LLSEC_AFALG_is_enabled(const char* algorithm_name) {
+	(void)algorithm_name;
+	return false;
+}
+
+#endif // LLSEC_AFALG_ENABLED
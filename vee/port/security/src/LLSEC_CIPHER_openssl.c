@@ -16,12 +16,17 @@
 
 
 #include <LLSEC_CIPHER_impl.h>
+#include <LLSEC_CIPHER_openssl.h>
+#include <LLSEC_AFALG_openssl.h>
+#include <LLSEC_CTX_POOL_openssl.h>
+#include <LLSEC_configuration.h>
 #include <openssl/evp.h>
 #include <openssl/err.h>
 #include <openssl/opensslv.h>
 
 #include <string.h>
 #include <sni.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #define MICROEJ_LLSECU_CIPHER_SUCCESS 1
@@ -33,6 +38,16 @@
 #define DES_CBC_BLOCK_BITS    (64u)
 #define DES_CBC_BLOCK_BYTES   (DES_CBC_BLOCK_BITS / 8u)
 
+// The AEAD transformations encrypt byte per byte
+#define AEAD_UNIT_BYTES       (1u)
+
+#ifndef EVP_CTRL_AEAD_SET_IVLEN
+// OpenSSL 1.0.2 only has the GCM names
+#define EVP_CTRL_AEAD_SET_IVLEN EVP_CTRL_GCM_SET_IVLEN
+#define EVP_CTRL_AEAD_GET_TAG   EVP_CTRL_GCM_GET_TAG
+#define EVP_CTRL_AEAD_SET_TAG   EVP_CTRL_GCM_SET_TAG
+#endif
+
 // #define LLSEC_CIPHER_DEBUG_TRACE
 
 #ifdef LLSEC_CIPHER_DEBUG_TRACE
@@ -48,6 +63,9 @@ typedef int (*LLSEC_CIPHER_init)(void** native_id, uint8_t is_decrypting, const
 typedef int (*LLSEC_CIPHER_decrypt)(void* native_id, const uint8_t* buffer, int32_t buffer_length, uint8_t* output);
 typedef int (*LLSEC_CIPHER_encrypt)(void* native_id, const uint8_t* buffer, int32_t buffer_length, uint8_t* output);
 typedef void (*LLSEC_CIPHER_close)(void* native_id);
+typedef void (*LLSEC_CIPHER_get_IV)(void* native_id, uint8_t* iv, int32_t iv_length);
+typedef void (*LLSEC_CIPHER_set_IV)(void* native_id, const uint8_t* iv, int32_t iv_length);
+typedef int32_t (*LLSEC_CIPHER_get_IV_length)(void* native_id);
 
 typedef struct {
 	char* name; // the name of the transformation
@@ -56,16 +74,50 @@ typedef struct {
 	LLSEC_CIPHER_encrypt encrypt;
 	LLSEC_CIPHER_close close;
 	LLSEC_CIPHER_transformation_desc description;
+	bool aead; // true for the authenticated encryption transformations, see LLSEC_CIPHER_openssl.h
+	LLSEC_CIPHER_get_IV get_iv;
+	LLSEC_CIPHER_set_IV set_iv;
+	LLSEC_CIPHER_get_IV_length get_iv_length;
 } LLSEC_CIPHER_transformation;
 
+#if LLSEC_AFALG_ENABLED
+/**
+ * Context of a transformation on the kernel crypto API. The kernel keeps no IV between two operations, the CBC
+ * chaining is done here.
+ */
+typedef struct {
+	LLSEC_afalg_ctx afalg;
+	bool decrypt;
+	int32_t iv_length; // the block size
+	uint8_t iv[AES_CBC_BLOCK_BYTES];
+} LLSEC_CIPHER_afalg_ctx;
+#endif
+
 static int LLSEC_CIPHER_aescbc_init(void** native_id, uint8_t is_decrypting, const uint8_t* key, int32_t key_length, const uint8_t* iv, int32_t iv_length);
 static int LLSEC_CIPHER_des3cbc_init(void** native_id, uint8_t is_decrypting, const uint8_t* key, int32_t key_length, const uint8_t* iv, int32_t iv_length);
+static int LLSEC_CIPHER_aesgcm_init(void** native_id, uint8_t is_decrypting, const uint8_t* key, int32_t key_length, const uint8_t* iv, int32_t iv_length);
+static int LLSEC_CIPHER_chacha20poly1305_init(void** native_id, uint8_t is_decrypting, const uint8_t* key, int32_t key_length, const uint8_t* iv, int32_t iv_length);
+static int openssl_aead_init(void** native_id, uint8_t is_decrypting, const EVP_CIPHER* cipher_type, const uint8_t* key, const uint8_t* iv, int32_t iv_length);
 static int openssl_cipher_decrypt(void* native_id, const uint8_t* buffer, int32_t buffer_length, uint8_t* output);
 static int openssl_cipher_encrypt(void* native_id, const uint8_t* buffer, int32_t buffer_length, uint8_t* output);
+static int openssl_aead_update(void* native_id, const uint8_t* buffer, int32_t buffer_length, uint8_t* output);
 static void openssl_cipher_close(void* native_id);
+static void openssl_cipher_get_iv(void* native_id, uint8_t* iv, int32_t iv_length);
+static void openssl_cipher_set_iv(void* native_id, const uint8_t* iv, int32_t iv_length);
+static int32_t openssl_cipher_get_iv_length(void* native_id);
+#if LLSEC_AFALG_ENABLED
+static int LLSEC_CIPHER_afalg_aescbc_init(void** native_id, uint8_t is_decrypting, const uint8_t* key, int32_t key_length, const uint8_t* iv, int32_t iv_length);
+static int LLSEC_CIPHER_afalg_des3cbc_init(void** native_id, uint8_t is_decrypting, const uint8_t* key, int32_t key_length, const uint8_t* iv, int32_t iv_length);
+static int afalg_cipher_init(void** native_id, const char* transformation_name, int32_t block_size, uint8_t is_decrypting, const uint8_t* key, int32_t key_length, const uint8_t* iv, int32_t iv_length);
+static int afalg_cipher_update(void* native_id, const uint8_t* buffer, int32_t buffer_length, uint8_t* output);
+static void afalg_cipher_close(void* native_id);
+static void afalg_cipher_get_iv(void* native_id, uint8_t* iv, int32_t iv_length);
+static void afalg_cipher_set_iv(void* native_id, const uint8_t* iv, int32_t iv_length);
+static int32_t afalg_cipher_get_iv_length(void* native_id);
+#endif
 
 // cppcheck-suppress misra-c2012-8.9 // Define here for code readability even if it called once in this file.
-static LLSEC_CIPHER_transformation available_transformations[2] =
+static LLSEC_CIPHER_transformation available_transformations[4] =
 {
 	{
 		.name = "AES/CBC/NoPadding",
@@ -77,7 +129,10 @@ static LLSEC_CIPHER_transformation available_transformations[2] =
 			.block_size = AES_CBC_BLOCK_BYTES,
 			.unit_bytes = AES_CBC_BLOCK_BYTES,
 			.cipher_mode = CBC_MODE,
-		}
+		},
+		.get_iv = openssl_cipher_get_iv,
+		.set_iv = openssl_cipher_set_iv,
+		.get_iv_length = openssl_cipher_get_iv_length
 	},
 	{
 		.name = "DESede/CBC/NoPadding",
@@ -89,10 +144,85 @@ static LLSEC_CIPHER_transformation available_transformations[2] =
 			.block_size = DES_CBC_BLOCK_BYTES,
 			.unit_bytes = DES_CBC_BLOCK_BYTES,
 			.cipher_mode = CBC_MODE,
-		}
+		},
+		.get_iv = openssl_cipher_get_iv,
+		.set_iv = openssl_cipher_set_iv,
+		.get_iv_length = openssl_cipher_get_iv_length
+	},
+	{
+		.name = "AES/GCM/NoPadding",
+		.init = LLSEC_CIPHER_aesgcm_init,
+		.decrypt = openssl_aead_update,
+		.encrypt = openssl_aead_update,
+		.close = openssl_cipher_close,
+		{
+			.block_size = AES_CBC_BLOCK_BYTES,
+			.unit_bytes = AEAD_UNIT_BYTES,
+			// The IV (nonce) is required as for CBC
+			.cipher_mode = CBC_MODE,
+		},
+		.aead = true,
+		.get_iv = openssl_cipher_get_iv,
+		.set_iv = openssl_cipher_set_iv,
+		.get_iv_length = openssl_cipher_get_iv_length
+	},
+	{
+		.name = "ChaCha20-Poly1305",
+		.init = LLSEC_CIPHER_chacha20poly1305_init,
+		.decrypt = openssl_aead_update,
+		.encrypt = openssl_aead_update,
+		.close = openssl_cipher_close,
+		{
+			.block_size = AEAD_UNIT_BYTES,
+			.unit_bytes = AEAD_UNIT_BYTES,
+			// The IV (nonce) is required as for CBC
+			.cipher_mode = CBC_MODE,
+		},
+		.aead = true,
+		.get_iv = openssl_cipher_get_iv,
+		.set_iv = openssl_cipher_set_iv,
+		.get_iv_length = openssl_cipher_get_iv_length
 	}
 };
 
+#if LLSEC_AFALG_ENABLED
+// Same transformations on the kernel crypto API, see LLSEC_AFALG_openssl.h
+// cppcheck-suppress misra-c2012-8.9 // Define here for code readability even if it called once in this file.
+static LLSEC_CIPHER_transformation afalg_transformations[2] =
+{
+	{
+		.name = "AES/CBC/NoPadding",
+		.init = LLSEC_CIPHER_afalg_aescbc_init,
+		.decrypt = afalg_cipher_update,
+		.encrypt = afalg_cipher_update,
+		.close = afalg_cipher_close,
+		{
+			.block_size = AES_CBC_BLOCK_BYTES,
+			.unit_bytes = AES_CBC_BLOCK_BYTES,
+			.cipher_mode = CBC_MODE,
+		},
+		.get_iv = afalg_cipher_get_iv,
+		.set_iv = afalg_cipher_set_iv,
+		.get_iv_length = afalg_cipher_get_iv_length
+	},
+	{
+		.name = "DESede/CBC/NoPadding",
+		.init = LLSEC_CIPHER_afalg_des3cbc_init,
+		.decrypt = afalg_cipher_update,
+		.encrypt = afalg_cipher_update,
+		.close = afalg_cipher_close,
+		{
+			.block_size = DES_CBC_BLOCK_BYTES,
+			.unit_bytes = DES_CBC_BLOCK_BYTES,
+			.cipher_mode = CBC_MODE,
+		},
+		.get_iv = afalg_cipher_get_iv,
+		.set_iv = afalg_cipher_set_iv,
+		.get_iv_length = afalg_cipher_get_iv_length
+	}
+};
+#endif
+
 static int LLSEC_CIPHER_aescbc_init(void** native_id, uint8_t is_decrypting, const uint8_t* key, int32_t key_length, const uint8_t* iv, int32_t iv_length)
 {
 	LLSEC_CIPHER_DEBUG_PRINTF("%s \n", __func__);
@@ -100,7 +230,7 @@ static int LLSEC_CIPHER_aescbc_init(void** native_id, uint8_t is_decrypting, con
 	int return_code = MICROEJ_LLSECU_CIPHER_SUCCESS;
 	const EVP_CIPHER *cipher_type;
 
-	EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+	EVP_CIPHER_CTX *ctx = LLSEC_CTX_POOL_take_cipher_ctx();
 	if (NULL == ctx) {
 		return_code = MICROEJ_LLSECU_CIPHER_ERROR;
 	}
@@ -110,16 +240,15 @@ static int LLSEC_CIPHER_aescbc_init(void** native_id, uint8_t is_decrypting, con
 		// Key can only be 128, 192, 256
 		switch (key_length * 8) {
 		case 128:
-			cipher_type = EVP_aes_128_cbc();
+			cipher_type = LLSEC_CTX_POOL_get_cipher(LLSEC_CIPHER_AES_128_CBC);
 			break;
 		case 192:
-			cipher_type = EVP_aes_192_cbc();
+			cipher_type = LLSEC_CTX_POOL_get_cipher(LLSEC_CIPHER_AES_192_CBC);
 			break;
 		case 256:
-			cipher_type = EVP_aes_256_cbc();
+			cipher_type = LLSEC_CTX_POOL_get_cipher(LLSEC_CIPHER_AES_256_CBC);
 			break;
 		default:
-			EVP_CIPHER_CTX_free(ctx);
 			return_code = MICROEJ_LLSECU_CIPHER_ERROR;
 			break;
 		}
@@ -142,7 +271,7 @@ static int LLSEC_CIPHER_aescbc_init(void** native_id, uint8_t is_decrypting, con
 		// Store ctx address in native_id
 		*native_id = (void*)ctx;
 	} else {
-		EVP_CIPHER_CTX_free(ctx);
+		LLSEC_CTX_POOL_give_cipher_ctx(ctx);
 	}
 
 	return return_code;
@@ -154,7 +283,7 @@ static int LLSEC_CIPHER_des3cbc_init(void** native_id, uint8_t is_decrypting, co
 	(void)iv_length;
 	int return_code = MICROEJ_LLSECU_CIPHER_SUCCESS;
 
-	EVP_CIPHER_CTX *ctx = EVP_CIPHER_CTX_new();
+	EVP_CIPHER_CTX *ctx = LLSEC_CTX_POOL_take_cipher_ctx();
 	if (NULL == ctx) {
 		return_code = MICROEJ_LLSECU_CIPHER_ERROR;
 	}
@@ -162,9 +291,9 @@ static int LLSEC_CIPHER_des3cbc_init(void** native_id, uint8_t is_decrypting, co
 
 	if (MICROEJ_LLSECU_CIPHER_SUCCESS == return_code) {
 		if ((uint8_t) 1 == is_decrypting) {
-			return_code = EVP_DecryptInit_ex(ctx, EVP_des_ede3_cbc(), NULL, key, iv);
+			return_code = EVP_DecryptInit_ex(ctx, LLSEC_CTX_POOL_get_cipher(LLSEC_CIPHER_DES_EDE3_CBC), NULL, key, iv);
 		} else {
-			return_code = EVP_EncryptInit_ex(ctx, EVP_des_ede3_cbc(), NULL, key, iv);
+			return_code = EVP_EncryptInit_ex(ctx, LLSEC_CTX_POOL_get_cipher(LLSEC_CIPHER_DES_EDE3_CBC), NULL, key, iv);
 		}
 	}
 
@@ -177,12 +306,100 @@ static int LLSEC_CIPHER_des3cbc_init(void** native_id, uint8_t is_decrypting, co
 		// Store ctx address in native_id
 		*native_id = (void*)ctx;
 	} else {
-		EVP_CIPHER_CTX_free(ctx);
+		LLSEC_CTX_POOL_give_cipher_ctx(ctx);
+	}
+
+	return return_code;
+}
+
+static int LLSEC_CIPHER_aesgcm_init(void** native_id, uint8_t is_decrypting, const uint8_t* key, int32_t key_length, const uint8_t* iv, int32_t iv_length)
+{
+	LLSEC_CIPHER_DEBUG_PRINTF("%s \n", __func__);
+	int return_code = MICROEJ_LLSECU_CIPHER_SUCCESS;
+	const EVP_CIPHER *cipher_type = NULL;
+
+	// Key can only be 128, 192, 256
+	switch (key_length * 8) {
+	case 128:
+		cipher_type = LLSEC_CTX_POOL_get_cipher(LLSEC_CIPHER_AES_128_GCM);
+		break;
+	case 192:
+		cipher_type = LLSEC_CTX_POOL_get_cipher(LLSEC_CIPHER_AES_192_GCM);
+		break;
+	case 256:
+		cipher_type = LLSEC_CTX_POOL_get_cipher(LLSEC_CIPHER_AES_256_GCM);
+		break;
+	default:
+		return_code = MICROEJ_LLSECU_CIPHER_ERROR;
+		break;
+	}
+
+	if (MICROEJ_LLSECU_CIPHER_SUCCESS == return_code) {
+		return_code = openssl_aead_init(native_id, is_decrypting, cipher_type, key, iv, iv_length);
 	}
+	return return_code;
+}
 
+static int LLSEC_CIPHER_chacha20poly1305_init(void** native_id, uint8_t is_decrypting, const uint8_t* key, int32_t key_length, const uint8_t* iv, int32_t iv_length)
+{
+	LLSEC_CIPHER_DEBUG_PRINTF("%s \n", __func__);
+	int return_code = MICROEJ_LLSECU_CIPHER_ERROR;
+	// NULL with OpenSSL 1.0.2
+	const EVP_CIPHER *cipher_type = LLSEC_CTX_POOL_get_cipher(LLSEC_CIPHER_CHACHA20_POLY1305);
+
+	// Key can only be 256
+	if ((NULL != cipher_type) && (32 == key_length)) {
+		return_code = openssl_aead_init(native_id, is_decrypting, cipher_type, key, iv, iv_length);
+	}
 	return return_code;
 }
 
+/**
+ * @brief Initializes an AEAD cipher context.
+ *
+ * @param[out] native_id the cipher context.
+ * @param[in] is_decrypting 1 for a decryption.
+ * @param[in] cipher_type the AEAD cipher.
+ * @param[in] key the key, of the cipher key size.
+ * @param[in] iv the nonce.
+ * @param[in] iv_length the nonce size in bytes.
+ *
+ * @return MICROEJ_LLSECU_CIPHER_SUCCESS on success, MICROEJ_LLSECU_CIPHER_ERROR on error.
+ */
+static int openssl_aead_init(void** native_id, uint8_t is_decrypting, const EVP_CIPHER* cipher_type, const uint8_t* key, const uint8_t* iv, int32_t iv_length)
+{
+	int return_code = MICROEJ_LLSECU_CIPHER_SUCCESS;
+	int enc = ((uint8_t) 1 == is_decrypting) ? 0 : 1;
+
+	EVP_CIPHER_CTX *ctx = LLSEC_CTX_POOL_take_cipher_ctx();
+	if (NULL == ctx) {
+		return_code = MICROEJ_LLSECU_CIPHER_ERROR;
+	}
+
+	if (MICROEJ_LLSECU_CIPHER_SUCCESS == return_code) {
+		// The nonce size must be set before the nonce
+		return_code = EVP_CipherInit_ex(ctx, cipher_type, NULL, NULL, NULL, enc);
+	}
+
+	if ((MICROEJ_LLSECU_CIPHER_SUCCESS == return_code) && (iv_length != EVP_CIPHER_CTX_iv_length(ctx))) {
+		return_code = EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_IVLEN, iv_length, NULL);
+	}
+
+	if (MICROEJ_LLSECU_CIPHER_SUCCESS == return_code) {
+		return_code = EVP_CipherInit_ex(ctx, NULL, NULL, key, iv, enc);
+	}
+
+	if (MICROEJ_LLSECU_CIPHER_SUCCESS == return_code) {
+		// Store ctx address in native_id
+		*native_id = (void*)ctx;
+	} else if (NULL != ctx) {
+		LLSEC_CTX_POOL_give_cipher_ctx(ctx);
+	} else {
+		// Out of memory
+	}
+
+	return return_code;
+}
 
 static int openssl_cipher_decrypt(void* native_id, const uint8_t* buffer, int32_t buffer_length, uint8_t* output)
 {
@@ -212,17 +429,178 @@ static int openssl_cipher_encrypt(void* native_id, const uint8_t* buffer, int32_
 	return return_code;
 }
 
+static int openssl_aead_update(void* native_id, const uint8_t* buffer, int32_t buffer_length, uint8_t* output)
+{
+	LLSEC_CIPHER_DEBUG_PRINTF("%s \n", __func__);
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
+	EVP_CIPHER_CTX *ctx = (EVP_CIPHER_CTX*)native_id;
+	int len = 0;
+
+	// Stream encryption, the whole output is produced now. The final step is done with the tag
+	return EVP_CipherUpdate(ctx, output, &len, buffer, buffer_length);
+}
+
 static void openssl_cipher_close(void* native_id)
 {
 	LLSEC_CIPHER_DEBUG_PRINTF("%s \n", __func__);
 	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
 	EVP_CIPHER_CTX *ctx = (EVP_CIPHER_CTX*)native_id;
 
-	/* Clean up */
-	EVP_CIPHER_CTX_free(ctx);
+	/* Clean up, the context is kept for reuse */
+	LLSEC_CTX_POOL_give_cipher_ctx(ctx);
+}
+
+static void openssl_cipher_get_iv(void* native_id, uint8_t* iv, int32_t iv_length)
+{
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
+	EVP_CIPHER_CTX *ctx = (EVP_CIPHER_CTX*)native_id;
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+	(void)memcpy(iv, ctx->iv, iv_length);
+#elif (OPENSSL_VERSION_NUMBER < 0x30000000L)
+	(void)memcpy(iv, EVP_CIPHER_CTX_iv(ctx), iv_length);
+#else
+	(void)EVP_CIPHER_CTX_get_updated_iv(ctx, iv, iv_length);
+#endif
+}
+
+static void openssl_cipher_set_iv(void* native_id, const uint8_t* iv, int32_t iv_length)
+{
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
+	EVP_CIPHER_CTX *ctx = (EVP_CIPHER_CTX*)native_id;
+	(void)iv_length;
+	// Keep the direction of the context, a new IV also resets the CBC chaining and starts a new AEAD message
+	(void)EVP_CipherInit_ex(ctx, NULL, NULL, NULL, iv, -1);
+}
+
+static int32_t openssl_cipher_get_iv_length(void* native_id)
+{
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
+	const EVP_CIPHER_CTX *ctx = (EVP_CIPHER_CTX*)native_id;
+	return EVP_CIPHER_CTX_iv_length(ctx);
+}
+
+#if LLSEC_AFALG_ENABLED
+static int LLSEC_CIPHER_afalg_aescbc_init(void** native_id, uint8_t is_decrypting, const uint8_t* key, int32_t key_length, const uint8_t* iv, int32_t iv_length)
+{
+	LLSEC_CIPHER_DEBUG_PRINTF("%s \n", __func__);
+	return afalg_cipher_init(native_id, "AES/CBC/NoPadding", AES_CBC_BLOCK_BYTES, is_decrypting, key, key_length, iv, iv_length);
+}
 
+static int LLSEC_CIPHER_afalg_des3cbc_init(void** native_id, uint8_t is_decrypting, const uint8_t* key, int32_t key_length, const uint8_t* iv, int32_t iv_length)
+{
+	LLSEC_CIPHER_DEBUG_PRINTF("%s \n", __func__);
+	return afalg_cipher_init(native_id, "DESede/CBC/NoPadding", DES_CBC_BLOCK_BYTES, is_decrypting, key, key_length, iv, iv_length);
 }
 
+/**
+ * @brief Initializes a CBC transformation on the kernel crypto API.
+ *
+ * @param[out] native_id the transformation context.
+ * @param[in] transformation_name the LLSEC transformation name.
+ * @param[in] block_size the block size, which is also the IV size.
+ * @param[in] is_decrypting 1 for a decryption.
+ * @param[in] key the key, checked by the kernel.
+ * @param[in] key_length the key size in bytes.
+ * @param[in] iv the IV, NULL for a zero IV.
+ * @param[in] iv_length the IV size in bytes.
+ *
+ * @return MICROEJ_LLSECU_CIPHER_SUCCESS on success, MICROEJ_LLSECU_CIPHER_ERROR on error.
+ */
+static int afalg_cipher_init(void** native_id, const char* transformation_name, int32_t block_size, uint8_t is_decrypting, const uint8_t* key, int32_t key_length, const uint8_t* iv, int32_t iv_length)
+{
+	int return_code = MICROEJ_LLSECU_CIPHER_SUCCESS;
+
+	LLSEC_CIPHER_afalg_ctx* ctx = (LLSEC_CIPHER_afalg_ctx*)LLSEC_calloc(1, sizeof(LLSEC_CIPHER_afalg_ctx));
+	if ((NULL == ctx) || ((NULL != iv) && (block_size != iv_length))) {
+		return_code = MICROEJ_LLSECU_CIPHER_ERROR;
+	}
+
+	if ((MICROEJ_LLSECU_CIPHER_SUCCESS == return_code) && !LLSEC_AFALG_open(&ctx->afalg, transformation_name, key, key_length)) {
+		return_code = MICROEJ_LLSECU_CIPHER_ERROR;
+	}
+
+	if (MICROEJ_LLSECU_CIPHER_SUCCESS == return_code) {
+		ctx->decrypt = ((uint8_t) 1 == is_decrypting);
+		ctx->iv_length = block_size;
+		if (NULL != iv) {
+			(void)memcpy(ctx->iv, iv, (size_t)block_size);
+		}
+		*native_id = (void*)ctx;
+	} else if (NULL != ctx) {
+		LLSEC_free(ctx);
+	} else {
+		// Out of memory
+	}
+	return return_code;
+}
+
+static int afalg_cipher_update(void* native_id, const uint8_t* buffer, int32_t buffer_length, uint8_t* output)
+{
+	LLSEC_CIPHER_DEBUG_PRINTF("%s \n", __func__);
+	int return_code = MICROEJ_LLSECU_CIPHER_SUCCESS;
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
+	LLSEC_CIPHER_afalg_ctx* ctx = (LLSEC_CIPHER_afalg_ctx*)native_id;
+	// Whole blocks, so that each chunk ends on a block
+	int32_t chunk_size = LLSEC_AFALG_CHUNK_SIZE - (LLSEC_AFALG_CHUNK_SIZE % ctx->iv_length);
+	uint8_t next_iv[AES_CBC_BLOCK_BYTES];
+	int32_t offset = 0;
+
+	if (0 != (buffer_length % ctx->iv_length)) {
+		return_code = MICROEJ_LLSECU_CIPHER_ERROR;
+	}
+
+	while ((MICROEJ_LLSECU_CIPHER_SUCCESS == return_code) && (offset < buffer_length)) {
+		int32_t length = buffer_length - offset;
+		if (length > chunk_size) {
+			length = chunk_size;
+		}
+		// The next IV is the last encrypted block, saved before a decryption in place overwrites it
+		if (ctx->decrypt) {
+			(void)memcpy(next_iv, &buffer[offset + length - ctx->iv_length], (size_t)ctx->iv_length);
+		}
+		if (!LLSEC_AFALG_cipher(&ctx->afalg, ctx->decrypt, ctx->iv, ctx->iv_length, &buffer[offset], length, &output[offset])) {
+			return_code = MICROEJ_LLSECU_CIPHER_ERROR;
+		} else if (ctx->decrypt) {
+			(void)memcpy(ctx->iv, next_iv, (size_t)ctx->iv_length);
+		} else {
+			(void)memcpy(ctx->iv, &output[offset + length - ctx->iv_length], (size_t)ctx->iv_length);
+		}
+		offset += length;
+	}
+	return return_code;
+}
+
+static void afalg_cipher_close(void* native_id)
+{
+	LLSEC_CIPHER_DEBUG_PRINTF("%s \n", __func__);
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
+	LLSEC_CIPHER_afalg_ctx* ctx = (LLSEC_CIPHER_afalg_ctx*)native_id;
+	LLSEC_AFALG_close(&ctx->afalg);
+	LLSEC_free(ctx);
+}
+
+static void afalg_cipher_get_iv(void* native_id, uint8_t* iv, int32_t iv_length)
+{
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
+	const LLSEC_CIPHER_afalg_ctx* ctx = (LLSEC_CIPHER_afalg_ctx*)native_id;
+	(void)memcpy(iv, ctx->iv, (size_t)((iv_length < ctx->iv_length) ? iv_length : ctx->iv_length));
+}
+
+static void afalg_cipher_set_iv(void* native_id, const uint8_t* iv, int32_t iv_length)
+{
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
+	LLSEC_CIPHER_afalg_ctx* ctx = (LLSEC_CIPHER_afalg_ctx*)native_id;
+	(void)memcpy(ctx->iv, iv, (size_t)((iv_length < ctx->iv_length) ? iv_length : ctx->iv_length));
+}
+
+static int32_t afalg_cipher_get_iv_length(void* native_id)
+{
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
+	const LLSEC_CIPHER_afalg_ctx* ctx = (LLSEC_CIPHER_afalg_ctx*)native_id;
+	return ctx->iv_length;
+}
+#endif
+
 // cppcheck-suppress constParameterPointer // SNI type conflict
 int32_t LLSEC_CIPHER_IMPL_get_transformation_description(uint8_t* transformation_name, LLSEC_CIPHER_transformation_desc* transformation_desc)
 {
@@ -241,6 +619,19 @@ int32_t LLSEC_CIPHER_IMPL_get_transformation_description(uint8_t* transformation
 		transformation++;
 	}
 
+#if LLSEC_AFALG_ENABLED
+	// The kernel replaces OpenSSL when selected and available
+	if ((nb_transformations >= 0) && LLSEC_AFALG_is_enabled(transformation->name)) {
+		int32_t nb_afalg_transformations = sizeof(afalg_transformations) / sizeof(LLSEC_CIPHER_transformation);
+		for (int32_t i = 0; i < nb_afalg_transformations; i++) {
+			if (0 == strcmp(transformation->name, afalg_transformations[i].name)) {
+				transformation = &afalg_transformations[i];
+				break;
+			}
+		}
+	}
+#endif
+
 	if (nb_transformations >= 0) {
 		// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
 		return_code = (int32_t)transformation;
@@ -262,46 +653,29 @@ int32_t LLSEC_CIPHER_IMPL_get_buffered_length(int32_t nativeTransformationId, in
 void LLSEC_CIPHER_IMPL_get_IV(int32_t transformation_id, int32_t native_id, uint8_t* iv, int32_t iv_length)
 {
 	LLSEC_CIPHER_DEBUG_PRINTF("%s \n", __func__);
-	(void)transformation_id;
 	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
-	EVP_CIPHER_CTX *ctx = (EVP_CIPHER_CTX*)native_id;
-#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
-	(void)memcpy(iv, ctx->iv, iv_length);
-#elif (OPENSSL_VERSION_NUMBER < 0x30000000L)
-	(void)memcpy(iv, EVP_CIPHER_CTX_iv(ctx), iv_length);
-#else
-	(void)EVP_CIPHER_CTX_get_updated_iv(ctx, iv, iv_length);
-#endif
+	const LLSEC_CIPHER_transformation* transformation = (LLSEC_CIPHER_transformation*)transformation_id;
+	// cppcheck-suppress misra-c2012-11.6 // Abstract data type for SNI usage
+	transformation->get_iv((void*)native_id, iv, iv_length);
 }
 
 // cppcheck-suppress constParameterPointer // SNI type conflict
 void LLSEC_CIPHER_IMPL_set_IV(int32_t transformation_id, int32_t native_id, uint8_t* iv, int32_t iv_length) {
 	LLSEC_CIPHER_DEBUG_PRINTF("%s \n", __func__);
-	(void)transformation_id;
 	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
-	EVP_CIPHER_CTX *ctx = (EVP_CIPHER_CTX*)native_id;
-#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
-	(void)memcpy(ctx->iv, iv, iv_length);
-#else
-	(void)iv_length;
-	(void)EVP_EncryptInit_ex(ctx, NULL, NULL, NULL, iv);
-#endif
+	const LLSEC_CIPHER_transformation* transformation = (LLSEC_CIPHER_transformation*)transformation_id;
+	// cppcheck-suppress misra-c2012-11.6 // Abstract data type for SNI usage
+	transformation->set_iv((void*)native_id, iv, iv_length);
 }
 
 int32_t LLSEC_CIPHER_IMPL_get_IV_length(int32_t transformation_id, int32_t native_id)
 {
 	LLSEC_CIPHER_DEBUG_PRINTF("%s \n", __func__);
-	(void)transformation_id;
-	int32_t return_code = 0;
 	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
-	const EVP_CIPHER_CTX *ctx = (EVP_CIPHER_CTX*)native_id;
-	int iv_len = EVP_CIPHER_CTX_iv_length(ctx);
-	if (0 == iv_len) {
-		return_code = SNI_ERROR;
-	} else {
-		return_code = iv_len;
-	}
-	return return_code;
+	const LLSEC_CIPHER_transformation* transformation = (LLSEC_CIPHER_transformation*)transformation_id;
+	// cppcheck-suppress misra-c2012-11.6 // Abstract data type for SNI usage
+	int32_t iv_len = transformation->get_iv_length((void*)native_id);
+	return (0 == iv_len) ? SNI_ERROR : iv_len;
 }
 
 int32_t LLSEC_CIPHER_IMPL_init(int32_t transformation_id, uint8_t is_decrypting, uint8_t* key, int32_t key_length, uint8_t* iv, int32_t iv_length)
@@ -395,3 +769,98 @@ int32_t LLSEC_CIPHER_IMPL_get_close_id(int32_t transformation_id) {
 	// cppcheck-suppress misra-c2012-11.1 // Abstract data type for SNI usage
 	return (int32_t) transformation->close;
 }
+
+int32_t LLSEC_CIPHER_IMPL_update_aad(int32_t transformation_id, int32_t native_id, uint8_t* aad, int32_t aad_offset, int32_t aad_length)
+{
+	LLSEC_CIPHER_DEBUG_PRINTF("%s \n", __func__);
+	int32_t return_code = MICROEJ_LLSECU_CIPHER_SUCCESS;
+	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
+	const LLSEC_CIPHER_transformation* transformation = (LLSEC_CIPHER_transformation*)transformation_id;
+	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
+	EVP_CIPHER_CTX *ctx = (EVP_CIPHER_CTX*)native_id;
+	int len = 0;
+
+	if (!transformation->aead) {
+		(void)SNI_throwNativeException(SNI_ERROR, "Not an AEAD transformation");
+		return_code = SNI_ERROR;
+	}
+
+	if (MICROEJ_LLSECU_CIPHER_SUCCESS == return_code) {
+		// A NULL output authenticates the input without encrypting it
+		if (MICROEJ_LLSECU_CIPHER_SUCCESS != EVP_CipherUpdate(ctx, NULL, &len, &aad[aad_offset], aad_length)) {
+			int err = ERR_get_error();
+			(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
+			return_code = SNI_ERROR;
+		}
+	}
+
+	if (MICROEJ_LLSECU_CIPHER_SUCCESS == return_code) {
+		return_code = SNI_OK;
+	}
+	return return_code;
+}
+
+int32_t LLSEC_CIPHER_IMPL_get_tag(int32_t transformation_id, int32_t native_id, uint8_t* tag, int32_t tag_offset, int32_t tag_length)
+{
+	LLSEC_CIPHER_DEBUG_PRINTF("%s \n", __func__);
+	int32_t return_code = MICROEJ_LLSECU_CIPHER_SUCCESS;
+	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
+	const LLSEC_CIPHER_transformation* transformation = (LLSEC_CIPHER_transformation*)transformation_id;
+	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
+	EVP_CIPHER_CTX *ctx = (EVP_CIPHER_CTX*)native_id;
+	int len = 0;
+
+	if (!transformation->aead || (tag_length < LLSEC_CIPHER_AEAD_MIN_TAG_LENGTH) || (tag_length > LLSEC_CIPHER_AEAD_MAX_TAG_LENGTH)) {
+		(void)SNI_throwNativeException(SNI_ERROR, "Invalid AEAD transformation or tag length");
+		return_code = SNI_ERROR;
+	}
+
+	if (MICROEJ_LLSECU_CIPHER_SUCCESS == return_code) {
+		// The stream ciphers output nothing on the final step
+		if ((MICROEJ_LLSECU_CIPHER_SUCCESS != EVP_EncryptFinal_ex(ctx, NULL, &len)) ||
+		    (MICROEJ_LLSECU_CIPHER_SUCCESS != EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_GET_TAG, tag_length, &tag[tag_offset]))) {
+			int err = ERR_get_error();
+			(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
+			return_code = SNI_ERROR;
+		}
+	}
+
+	if (MICROEJ_LLSECU_CIPHER_SUCCESS == return_code) {
+		return_code = tag_length;
+	}
+	return return_code;
+}
+
+int32_t LLSEC_CIPHER_IMPL_verify_tag(int32_t transformation_id, int32_t native_id, uint8_t* tag, int32_t tag_offset, int32_t tag_length)
+{
+	LLSEC_CIPHER_DEBUG_PRINTF("%s \n", __func__);
+	int32_t return_code = MICROEJ_LLSECU_CIPHER_SUCCESS;
+	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
+	const LLSEC_CIPHER_transformation* transformation = (LLSEC_CIPHER_transformation*)transformation_id;
+	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
+	EVP_CIPHER_CTX *ctx = (EVP_CIPHER_CTX*)native_id;
+	int len = 0;
+
+	if (!transformation->aead || (tag_length < LLSEC_CIPHER_AEAD_MIN_TAG_LENGTH) || (tag_length > LLSEC_CIPHER_AEAD_MAX_TAG_LENGTH)) {
+		(void)SNI_throwNativeException(SNI_ERROR, "Invalid AEAD transformation or tag length");
+		return_code = SNI_ERROR;
+	}
+
+	if (MICROEJ_LLSECU_CIPHER_SUCCESS == return_code) {
+		if (MICROEJ_LLSECU_CIPHER_SUCCESS != EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_AEAD_SET_TAG, tag_length, &tag[tag_offset])) {
+			int err = ERR_get_error();
+			(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
+			return_code = SNI_ERROR;
+		}
+	}
+
+	if (MICROEJ_LLSECU_CIPHER_SUCCESS == return_code) {
+		// The final step fails if the tag does not match
+		if (MICROEJ_LLSECU_CIPHER_SUCCESS != EVP_DecryptFinal_ex(ctx, NULL, &len)) {
+			LLSEC_CIPHER_DEBUG_PRINTF("%s tag mismatch\n", __func__);
+			ERR_clear_error();
+			return_code = MICROEJ_LLSECU_CIPHER_ERROR;
+		}
+	}
+	return return_code;
+}
@@ -0,0 +1,344 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ *
+ */
+
+/**
+ * @file
+ * @brief MicroEJ Security low level API: OpenSSL algorithm table and context pools.
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/opensslv.h>
+#include "LLSEC_configuration.h"
+#include "LLSEC_CTX_POOL_openssl.h"
+#include "osal.h"
+
+// #define LLSEC_CTX_POOL_DEBUG_TRACE
+
+#ifdef LLSEC_CTX_POOL_DEBUG_TRACE
+#define LLSEC_CTX_POOL_DEBUG_PRINTF(...) (void)printf(__VA_ARGS__)
+#else
+#define LLSEC_CTX_POOL_DEBUG_PRINTF(...) ((void)0)
+#endif
+
+// Idle contexts of one kind
+typedef struct {
+	void* contexts[LLSEC_CTX_POOL_SIZE];
+	int32_t count;
+} LLSEC_CTX_POOL_pool;
+
+static void LLSEC_CTX_POOL_lock(void);
+static void LLSEC_CTX_POOL_unlock(void);
+static void* LLSEC_CTX_POOL_pop(LLSEC_CTX_POOL_pool* pool);
+static bool LLSEC_CTX_POOL_push(LLSEC_CTX_POOL_pool* pool, void* ctx);
+
+// OpenSSL names of the LLSEC_md_type and LLSEC_cipher_type algorithms, for the explicit fetch
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+static const char* const md_names[LLSEC_MD_TYPES_COUNT] = {
+	"SHA1", "SHA224", "SHA256", "SHA384", "SHA512", "MD5"
+};
+static const char* const cipher_names[LLSEC_CIPHER_TYPES_COUNT] = {
+	"AES-128-CBC", "AES-192-CBC", "AES-256-CBC", "DES-EDE3-CBC",
+	"AES-128-GCM", "AES-192-GCM", "AES-256-GCM", "ChaCha20-Poly1305"
+};
+#endif
+
+static bool initialized = false;
+static OSAL_mutex_handle_t pool_mutex;
+static bool pool_mutex_created = false;
+
+static const EVP_MD* md_table[LLSEC_MD_TYPES_COUNT];
+static const EVP_CIPHER* cipher_table[LLSEC_CIPHER_TYPES_COUNT];
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+static EVP_MAC* hmac = NULL;
+#endif
+
+static LLSEC_CTX_POOL_pool md_ctx_pool;
+static LLSEC_CTX_POOL_pool cipher_ctx_pool;
+#if (OPENSSL_VERSION_NUMBER < 0x30000000L)
+static LLSEC_CTX_POOL_pool mac_ctx_pool;
+#endif
+
+// Key contexts, the oldest first
+static EVP_PKEY_CTX* pkey_ctx_pool[LLSEC_CTX_POOL_PKEY_SIZE];
+static int32_t pkey_ctx_count = 0;
+
+void LLSEC_CTX_POOL_initialize(void) {
+	// Called first from the VM task, before any crypto task uses the pools
+	if (!initialized) {
+		LLSEC_CTX_POOL_DEBUG_PRINTF("%s \n", __func__);
+		// cppcheck-suppress misra-c2012-11.8 // String casts conform to OSAL_mutex_create function definitions.
+		pool_mutex_created = (OSAL_OK == OSAL_mutex_create((uint8_t*)"LLSEC context pools", &pool_mutex));
+
+		md_table[LLSEC_MD_SHA1] = EVP_sha1();
+		md_table[LLSEC_MD_SHA224] = EVP_sha224();
+		md_table[LLSEC_MD_SHA256] = EVP_sha256();
+		md_table[LLSEC_MD_SHA384] = EVP_sha384();
+		md_table[LLSEC_MD_SHA512] = EVP_sha512();
+		md_table[LLSEC_MD_MD5] = EVP_md5();
+		cipher_table[LLSEC_CIPHER_AES_128_CBC] = EVP_aes_128_cbc();
+		cipher_table[LLSEC_CIPHER_AES_192_CBC] = EVP_aes_192_cbc();
+		cipher_table[LLSEC_CIPHER_AES_256_CBC] = EVP_aes_256_cbc();
+		cipher_table[LLSEC_CIPHER_DES_EDE3_CBC] = EVP_des_ede3_cbc();
+		cipher_table[LLSEC_CIPHER_AES_128_GCM] = EVP_aes_128_gcm();
+		cipher_table[LLSEC_CIPHER_AES_192_GCM] = EVP_aes_192_gcm();
+		cipher_table[LLSEC_CIPHER_AES_256_GCM] = EVP_aes_256_gcm();
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L) && !defined(OPENSSL_NO_CHACHA) && !defined(OPENSSL_NO_POLY1305)
+		cipher_table[LLSEC_CIPHER_CHACHA20_POLY1305] = EVP_chacha20_poly1305();
+#else
+		cipher_table[LLSEC_CIPHER_CHACHA20_POLY1305] = NULL;
+#endif
+#if (OPENSSL_VERSION_NUMBER >= 0x30000000L)
+		// The fetched algorithms are kept until the end of the process. The legacy ones are kept if the fetch fails.
+		for (int32_t i = 0; i < (int32_t)LLSEC_MD_TYPES_COUNT; i++) {
+			EVP_MD* md = EVP_MD_fetch(NULL, md_names[i], NULL);
+			if (NULL != md) {
+				md_table[i] = md;
+			}
+		}
+		for (int32_t i = 0; i < (int32_t)LLSEC_CIPHER_TYPES_COUNT; i++) {
+			EVP_CIPHER* cipher = EVP_CIPHER_fetch(NULL, cipher_names[i], NULL);
+			if (NULL != cipher) {
+				cipher_table[i] = cipher;
+			}
+		}
+		hmac = EVP_MAC_fetch(NULL, "HMAC", NULL);
+#endif
+		initialized = true;
+	}
+}
+
+const EVP_MD* LLSEC_CTX_POOL_get_md(LLSEC_md_type type) {
+	const EVP_MD* md = NULL;
+	LLSEC_CTX_POOL_initialize();
+	if ((int32_t)type < (int32_t)LLSEC_MD_TYPES_COUNT) {
+		md = md_table[type];
+	}
+	return md;
+}
+
+const EVP_CIPHER* LLSEC_CTX_POOL_get_cipher(LLSEC_cipher_type type) {
+	const EVP_CIPHER* cipher = NULL;
+	LLSEC_CTX_POOL_initialize();
+	if ((int32_t)type < (int32_t)LLSEC_CIPHER_TYPES_COUNT) {
+		cipher = cipher_table[type];
+	}
+	return cipher;
+}
+
+EVP_MD_CTX* LLSEC_CTX_POOL_take_md_ctx(void) {
+	LLSEC_CTX_POOL_lock();
+	// cppcheck-suppress misra-c2012-11.5 // The pool only holds digest contexts
+	EVP_MD_CTX* ctx = (EVP_MD_CTX*)LLSEC_CTX_POOL_pop(&md_ctx_pool);
+	LLSEC_CTX_POOL_unlock();
+	if (NULL == ctx) {
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+		ctx = EVP_MD_CTX_create();
+#else
+		ctx = EVP_MD_CTX_new();
+#endif
+	}
+	return ctx;
+}
+
+void LLSEC_CTX_POOL_give_md_ctx(EVP_MD_CTX* ctx) {
+	if (NULL != ctx) {
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+		(void)EVP_MD_CTX_cleanup(ctx); // cleans the context and sets its memory to 0, ready for reuse
+#else
+		(void)EVP_MD_CTX_reset(ctx);
+#endif
+		LLSEC_CTX_POOL_lock();
+		bool kept = LLSEC_CTX_POOL_push(&md_ctx_pool, ctx);
+		LLSEC_CTX_POOL_unlock();
+		if (!kept) {
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+			EVP_MD_CTX_destroy(ctx);
+#else
+			EVP_MD_CTX_free(ctx);
+#endif
+		}
+	}
+}
+
+EVP_CIPHER_CTX* LLSEC_CTX_POOL_take_cipher_ctx(void) {
+	LLSEC_CTX_POOL_lock();
+	// cppcheck-suppress misra-c2012-11.5 // The pool only holds cipher contexts
+	EVP_CIPHER_CTX* ctx = (EVP_CIPHER_CTX*)LLSEC_CTX_POOL_pop(&cipher_ctx_pool);
+	LLSEC_CTX_POOL_unlock();
+	if (NULL == ctx) {
+		ctx = EVP_CIPHER_CTX_new();
+	}
+	return ctx;
+}
+
+void LLSEC_CTX_POOL_give_cipher_ctx(EVP_CIPHER_CTX* ctx) {
+	if (NULL != ctx) {
+		// Clears the key schedule
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+		(void)EVP_CIPHER_CTX_cleanup(ctx); // cleans the context and sets its memory to 0, ready for reuse
+#else
+		(void)EVP_CIPHER_CTX_reset(ctx);
+#endif
+		LLSEC_CTX_POOL_lock();
+		bool kept = LLSEC_CTX_POOL_push(&cipher_ctx_pool, ctx);
+		LLSEC_CTX_POOL_unlock();
+		if (!kept) {
+			EVP_CIPHER_CTX_free(ctx);
+		}
+	}
+}
+
+LLSEC_mac_ctx* LLSEC_CTX_POOL_take_mac_ctx(void) {
+	LLSEC_mac_ctx* ctx = NULL;
+#if (OPENSSL_VERSION_NUMBER < 0x30000000L)
+	LLSEC_CTX_POOL_lock();
+	// cppcheck-suppress misra-c2012-11.5 // The pool only holds HMAC contexts
+	ctx = (LLSEC_mac_ctx*)LLSEC_CTX_POOL_pop(&mac_ctx_pool);
+	LLSEC_CTX_POOL_unlock();
+	if (NULL == ctx) {
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+		ctx = (HMAC_CTX*)OPENSSL_malloc(sizeof(HMAC_CTX));
+		if (NULL != ctx) {
+			HMAC_CTX_init(ctx);
+		}
+#else
+		ctx = HMAC_CTX_new();
+#endif
+	}
+#else
+	// An EVP_MAC_CTX cannot be reset without a new key: only the algorithm fetch is saved
+	LLSEC_CTX_POOL_initialize();
+	if (NULL != hmac) {
+		ctx = EVP_MAC_CTX_new(hmac);
+	}
+#endif
+	return ctx;
+}
+
+void LLSEC_CTX_POOL_give_mac_ctx(LLSEC_mac_ctx* ctx) {
+	if (NULL != ctx) {
+#if (OPENSSL_VERSION_NUMBER < 0x30000000L)
+		// Clears the key
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+		HMAC_CTX_cleanup(ctx); // cleans the context and sets its memory to 0, ready for reuse
+#else
+		(void)HMAC_CTX_reset(ctx);
+#endif
+		LLSEC_CTX_POOL_lock();
+		bool kept = LLSEC_CTX_POOL_push(&mac_ctx_pool, ctx);
+		LLSEC_CTX_POOL_unlock();
+		if (!kept) {
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+			OPENSSL_free(ctx);
+#else
+			HMAC_CTX_free(ctx);
+#endif
+		}
+#else
+		EVP_MAC_CTX_free(ctx);
+#endif
+	}
+}
+
+EVP_PKEY_CTX* LLSEC_CTX_POOL_take_pkey_ctx(EVP_PKEY* key) {
+	EVP_PKEY_CTX* ctx = NULL;
+	LLSEC_CTX_POOL_lock();
+	for (int32_t i = 0; (NULL == ctx) && (i < pkey_ctx_count); i++) {
+		if (EVP_PKEY_CTX_get0_pkey(pkey_ctx_pool[i]) == key) {
+			ctx = pkey_ctx_pool[i];
+			pkey_ctx_count--;
+			(void)memmove(&pkey_ctx_pool[i], &pkey_ctx_pool[i + 1], (size_t)(pkey_ctx_count - i) * sizeof(EVP_PKEY_CTX*));
+		}
+	}
+	LLSEC_CTX_POOL_unlock();
+	if (NULL == ctx) {
+		// The context holds a reference to the key
+		ctx = EVP_PKEY_CTX_new(key, NULL);
+	}
+	return ctx;
+}
+
+void LLSEC_CTX_POOL_give_pkey_ctx(EVP_PKEY_CTX* ctx) {
+	if (NULL != ctx) {
+		EVP_PKEY_CTX* evicted = NULL;
+		LLSEC_CTX_POOL_lock();
+		if (LLSEC_CTX_POOL_PKEY_SIZE == pkey_ctx_count) {
+			evicted = pkey_ctx_pool[0];
+			pkey_ctx_count--;
+			(void)memmove(&pkey_ctx_pool[0], &pkey_ctx_pool[1], (size_t)pkey_ctx_count * sizeof(EVP_PKEY_CTX*));
+		}
+		pkey_ctx_pool[pkey_ctx_count] = ctx;
+		pkey_ctx_count++;
+		LLSEC_CTX_POOL_unlock();
+		// Releases the key reference
+		EVP_PKEY_CTX_free(evicted);
+	}
+}
+
+void LLSEC_CTX_POOL_purge_pkey_ctx(const EVP_PKEY* key) {
+	EVP_PKEY_CTX* purged[LLSEC_CTX_POOL_PKEY_SIZE];
+	int32_t nb_purged = 0;
+	int32_t count = 0;
+	LLSEC_CTX_POOL_lock();
+	for (int32_t i = 0; i < pkey_ctx_count; i++) {
+		if (EVP_PKEY_CTX_get0_pkey(pkey_ctx_pool[i]) == key) {
+			purged[nb_purged] = pkey_ctx_pool[i];
+			nb_purged++;
+		} else {
+			pkey_ctx_pool[count] = pkey_ctx_pool[i];
+			count++;
+		}
+	}
+	pkey_ctx_count = count;
+	LLSEC_CTX_POOL_unlock();
+	for (int32_t i = 0; i < nb_purged; i++) {
+		// Releases the key reference
+		EVP_PKEY_CTX_free(purged[i]);
+	}
+}
+
+static void LLSEC_CTX_POOL_lock(void) {
+	LLSEC_CTX_POOL_initialize();
+	if (pool_mutex_created) {
+		(void)OSAL_mutex_take(&pool_mutex, OSAL_INFINITE_TIME);
+	}
+}
+
+static void LLSEC_CTX_POOL_unlock(void) {
+	if (pool_mutex_created) {
+		(void)OSAL_mutex_give(&pool_mutex);
+	}
+}
+
+// Called with the mutex taken
+static void* LLSEC_CTX_POOL_pop(LLSEC_CTX_POOL_pool* pool) {
+	void* ctx = NULL;
+	if (pool->count > 0) {
+		pool->count--;
+		ctx = pool->contexts[pool->count];
+	}
+	return ctx;
+}
+
+// Called with the mutex taken
+static bool LLSEC_CTX_POOL_push(LLSEC_CTX_POOL_pool* pool, void* ctx) {
+	bool kept = false;
+	if (pool->count < LLSEC_CTX_POOL_SIZE) {
+		pool->contexts[pool->count] = ctx;
+		pool->count++;
+		kept = true;
+	}
+	return kept;
+}
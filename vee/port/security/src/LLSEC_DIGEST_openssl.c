@@ -16,6 +16,11 @@
 
 
 #include <LLSEC_DIGEST_impl.h>
+#include <LLSEC_DIGEST_openssl.h>
+#include <LLSEC_AFALG_openssl.h>
+#include <LLSEC_CTX_POOL_openssl.h>
+#include <LLSEC_configuration.h>
+#include <LLSEC_openssl.h>
 #include <openssl/evp.h>
 #include <openssl/sha.h>
 #include <openssl/md5.h>
@@ -24,6 +29,7 @@
 #include <openssl/opensslv.h>
 #include <string.h>
 #include <sni.h>
+#include <stdbool.h>
 #include <stdint.h>
 
 #define MICROEJ_LLSECU_DIGEST_SUCCESS 1
@@ -42,6 +48,7 @@ typedef int (*LLSEC_DIGEST_init)(void** native_id);
 typedef int (*LLSEC_DIGEST_update)(void* native_id, const uint8_t* buffer, int32_t buffer_length);
 typedef int (*LLSEC_DIGEST_digest)(void* native_id, uint8_t* out, int32_t* out_length);
 typedef void (*LLSEC_DIGEST_close)(void* native_id);
+typedef int (*LLSEC_DIGEST_many)(LLSEC_md_type md_type, const uint8_t* buffer, const int32_t* lengths, int32_t count, uint8_t* out);
 
 /*
  * LL-API related functions & struct
@@ -53,15 +60,31 @@ typedef struct {
 	LLSEC_DIGEST_digest digest;
 	LLSEC_DIGEST_close close;
 	LLSEC_DIGEST_algorithm_desc description;
+	LLSEC_md_type md_type; // for the one-shot natives
+	LLSEC_DIGEST_many many;
 } LLSEC_DIGEST_algorithm;
 
 static int openssl_digest_update(void* native_id, const uint8_t* buffer, int32_t buffer_length);
 static int openssl_digest_digest(void* native_id, uint8_t* out, int32_t* out_length);
+static int openssl_digest_init(void** native_id, LLSEC_md_type md_type);
 static int LLSEC_DIGEST_MD5_init(void** native_id);
 static int LLSEC_DIGEST_SHA1_init(void** native_id);
 static int LLSEC_DIGEST_SHA256_init(void** native_id);
 static int LLSEC_DIGEST_SHA512_init(void** native_id);
 static void openssl_digest_close(void* native_id);
+static int openssl_digest_many(LLSEC_md_type md_type, const uint8_t* buffer, const int32_t* lengths, int32_t count, uint8_t* out);
+#if LLSEC_AFALG_ENABLED
+static int afalg_digest_update(void* native_id, const uint8_t* buffer, int32_t buffer_length);
+static int afalg_digest_digest(void* native_id, uint8_t* out, int32_t* out_length);
+static int afalg_digest_init(void** native_id, LLSEC_md_type md_type);
+static int LLSEC_DIGEST_afalg_MD5_init(void** native_id);
+static int LLSEC_DIGEST_afalg_SHA1_init(void** native_id);
+static int LLSEC_DIGEST_afalg_SHA256_init(void** native_id);
+static int LLSEC_DIGEST_afalg_SHA512_init(void** native_id);
+static void afalg_digest_close(void* native_id);
+static int afalg_digest_many(LLSEC_md_type md_type, const uint8_t* buffer, const int32_t* lengths, int32_t count, uint8_t* out);
+static const char* afalg_digest_name(LLSEC_md_type md_type);
+#endif
 
 // cppcheck-suppress misra-c2012-8.9 // Define here for code readability even if it called once in this file.
 static LLSEC_DIGEST_algorithm available_algorithms[4] = {
@@ -73,7 +96,9 @@ static LLSEC_DIGEST_algorithm available_algorithms[4] = {
 		.close  = openssl_digest_close,
 		{
 			.digest_length = MD5_DIGEST_LENGTH
-		}
+		},
+		.md_type = LLSEC_MD_MD5,
+		.many    = openssl_digest_many
 	},
 	{
 		.name   = "SHA-1",
@@ -83,7 +108,9 @@ static LLSEC_DIGEST_algorithm available_algorithms[4] = {
 		.close  = openssl_digest_close,
 		{
 			.digest_length = SHA_DIGEST_LENGTH
-		}
+		},
+		.md_type = LLSEC_MD_SHA1,
+		.many    = openssl_digest_many
 	},
 	{
 		.name   = "SHA-256",
@@ -93,7 +120,9 @@ static LLSEC_DIGEST_algorithm available_algorithms[4] = {
 		.close  = openssl_digest_close,
 		{
 			.digest_length = SHA256_DIGEST_LENGTH
-		}
+		},
+		.md_type = LLSEC_MD_SHA256,
+		.many    = openssl_digest_many
 	},
 	{
 		.name   = "SHA-512",
@@ -103,10 +132,67 @@ static LLSEC_DIGEST_algorithm available_algorithms[4] = {
 		.close  = openssl_digest_close,
 		{
 			.digest_length = SHA512_DIGEST_LENGTH
-		}
+		},
+		.md_type = LLSEC_MD_SHA512,
+		.many    = openssl_digest_many
 	}
 };
 
+#if LLSEC_AFALG_ENABLED
+// Same algorithms on the kernel crypto API, see LLSEC_AFALG_openssl.h
+// cppcheck-suppress misra-c2012-8.9 // Define here for code readability even if it called once in this file.
+static LLSEC_DIGEST_algorithm afalg_algorithms[4] = {
+	{
+		.name   = "MD5",
+		.init   = LLSEC_DIGEST_afalg_MD5_init,
+		.update = afalg_digest_update,
+		.digest = afalg_digest_digest,
+		.close  = afalg_digest_close,
+		{
+			.digest_length = MD5_DIGEST_LENGTH
+		},
+		.md_type = LLSEC_MD_MD5,
+		.many    = afalg_digest_many
+	},
+	{
+		.name   = "SHA-1",
+		.init   = LLSEC_DIGEST_afalg_SHA1_init,
+		.update = afalg_digest_update,
+		.digest = afalg_digest_digest,
+		.close  = afalg_digest_close,
+		{
+			.digest_length = SHA_DIGEST_LENGTH
+		},
+		.md_type = LLSEC_MD_SHA1,
+		.many    = afalg_digest_many
+	},
+	{
+		.name   = "SHA-256",
+		.init   = LLSEC_DIGEST_afalg_SHA256_init,
+		.update = afalg_digest_update,
+		.digest = afalg_digest_digest,
+		.close  = afalg_digest_close,
+		{
+			.digest_length = SHA256_DIGEST_LENGTH
+		},
+		.md_type = LLSEC_MD_SHA256,
+		.many    = afalg_digest_many
+	},
+	{
+		.name   = "SHA-512",
+		.init   = LLSEC_DIGEST_afalg_SHA512_init,
+		.update = afalg_digest_update,
+		.digest = afalg_digest_digest,
+		.close  = afalg_digest_close,
+		{
+			.digest_length = SHA512_DIGEST_LENGTH
+		},
+		.md_type = LLSEC_MD_SHA512,
+		.many    = afalg_digest_many
+	}
+};
+#endif
+
 /*
  * Generic openssl function
  */
@@ -138,135 +224,219 @@ static void openssl_digest_close(void* native_id)
 
 	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
 	EVP_MD_CTX* md_ctx  = (EVP_MD_CTX*)native_id;
-	// Memory deallocation
-#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
-	EVP_MD_CTX_destroy(md_ctx); //EVP_MD_CTX_destroy() cleans the ctx before releasing it
-#else
-	EVP_MD_CTX_free(md_ctx);
-#endif
-
+	// The context is cleaned and kept for reuse
+	LLSEC_CTX_POOL_give_md_ctx(md_ctx);
 }
 
 /*
- * Specific sha-1 function
+ * Generic init: the context comes from the pool and the algorithm from the algorithm table
  */
-static int LLSEC_DIGEST_MD5_init(void** native_id) {
+static int openssl_digest_init(void** native_id, LLSEC_md_type md_type) {
 	LLSEC_DIGEST_DEBUG_PRINTF("%s \n", __func__);
 	int return_code = MICROEJ_LLSECU_DIGEST_SUCCESS;
 
-	// Memory allocation
-	EVP_MD_CTX* md_ctx  = EVP_MD_CTX_create();
+	EVP_MD_CTX* md_ctx = LLSEC_CTX_POOL_take_md_ctx();
 	if (NULL == md_ctx) {
 		return_code = MICROEJ_LLSECU_DIGEST_ERROR;
 	}
 
 	if (MICROEJ_LLSECU_DIGEST_SUCCESS == return_code) {
-		return_code = EVP_DigestInit_ex(md_ctx, EVP_md5(), NULL);
+		return_code = EVP_DigestInit_ex(md_ctx, LLSEC_CTX_POOL_get_md(md_type), NULL);
 	}
 
 	if (MICROEJ_LLSECU_DIGEST_SUCCESS == return_code) {
 		*native_id = md_ctx;
 	} else {
-#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
-		EVP_MD_CTX_destroy(md_ctx);
-#else
-		EVP_MD_CTX_free(md_ctx);
-#endif
+		LLSEC_CTX_POOL_give_md_ctx(md_ctx);
 	}
 
 	return return_code;
 }
 
 /*
- * Specific sha-1 function
+ * Generic one-shot digest: count messages stored back to back with a single context from the pool
  */
-static int LLSEC_DIGEST_SHA1_init(void** native_id) {
-	LLSEC_DIGEST_DEBUG_PRINTF("%s \n", __func__);
+static int openssl_digest_many(LLSEC_md_type md_type, const uint8_t* buffer, const int32_t* lengths, int32_t count, uint8_t* out) {
+	LLSEC_DIGEST_DEBUG_PRINTF("%s count=%d\n", __func__, (int)count);
 	int return_code = MICROEJ_LLSECU_DIGEST_SUCCESS;
+	const EVP_MD* md = LLSEC_CTX_POOL_get_md(md_type);
+	const uint8_t* message = buffer;
+	uint8_t* digest = out;
 
-	// Memory allocation
-	EVP_MD_CTX* md_ctx  = EVP_MD_CTX_create();
+	EVP_MD_CTX* md_ctx = LLSEC_CTX_POOL_take_md_ctx();
 	if (NULL == md_ctx) {
 		return_code = MICROEJ_LLSECU_DIGEST_ERROR;
 	}
 
-	if (MICROEJ_LLSECU_DIGEST_SUCCESS == return_code) {
-		return_code = EVP_DigestInit_ex(md_ctx, EVP_sha1(), NULL);
+	for (int32_t i = 0; (MICROEJ_LLSECU_DIGEST_SUCCESS == return_code) && (i < count); i++) {
+		unsigned int digest_length = 0;
+		if ((MICROEJ_LLSECU_DIGEST_SUCCESS != EVP_DigestInit_ex(md_ctx, md, NULL)) ||
+		    (MICROEJ_LLSECU_DIGEST_SUCCESS != EVP_DigestUpdate(md_ctx, message, (size_t)lengths[i])) ||
+		    (MICROEJ_LLSECU_DIGEST_SUCCESS != EVP_DigestFinal_ex(md_ctx, digest, &digest_length))) {
+			return_code = MICROEJ_LLSECU_DIGEST_ERROR;
+		}
+		message = &message[lengths[i]];
+		digest = &digest[digest_length];
 	}
 
-	if (MICROEJ_LLSECU_DIGEST_SUCCESS == return_code) {
-		*native_id = md_ctx;
-	} else {
-#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
-		EVP_MD_CTX_destroy(md_ctx);
-#else
-		EVP_MD_CTX_free(md_ctx);
-#endif
+	if (NULL != md_ctx) {
+		LLSEC_CTX_POOL_give_md_ctx(md_ctx);
 	}
-
 	return return_code;
 }
 
+/*
+ * Specific md5 function
+ */
+static int LLSEC_DIGEST_MD5_init(void** native_id) {
+	return openssl_digest_init(native_id, LLSEC_MD_MD5);
+}
+
+/*
+ * Specific sha-1 function
+ */
+static int LLSEC_DIGEST_SHA1_init(void** native_id) {
+	return openssl_digest_init(native_id, LLSEC_MD_SHA1);
+}
+
 /*
  * Specific sha-256 function
  */
 static int LLSEC_DIGEST_SHA256_init(void** native_id) {
+	return openssl_digest_init(native_id, LLSEC_MD_SHA256);
+}
+
+/*
+ * Specific sha-512 function
+ */
+static int LLSEC_DIGEST_SHA512_init(void** native_id) {
+	return openssl_digest_init(native_id, LLSEC_MD_SHA512);
+}
+
+#if LLSEC_AFALG_ENABLED
+/*
+ * Generic kernel crypto API function
+ */
+static int afalg_digest_update(void* native_id, const uint8_t* buffer, int32_t buffer_length)
+{
+	LLSEC_DIGEST_DEBUG_PRINTF("%s \n", __func__);
+
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
+	LLSEC_afalg_ctx* ctx = (LLSEC_afalg_ctx*)native_id;
+	return LLSEC_AFALG_hash_update(ctx, buffer, buffer_length, true) ? MICROEJ_LLSECU_DIGEST_SUCCESS : MICROEJ_LLSECU_DIGEST_ERROR;
+}
+
+static int afalg_digest_digest(void* native_id, uint8_t* out, int32_t* out_length)
+{
+	LLSEC_DIGEST_DEBUG_PRINTF("%s \n", __func__);
+
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
+	LLSEC_afalg_ctx* ctx = (LLSEC_afalg_ctx*)native_id;
+	int32_t length = LLSEC_AFALG_hash_final(ctx, out, *out_length);
+	if (0 <= length) {
+		*out_length = length;
+	}
+	return (0 <= length) ? MICROEJ_LLSECU_DIGEST_SUCCESS : MICROEJ_LLSECU_DIGEST_ERROR;
+}
+
+static void afalg_digest_close(void* native_id)
+{
+	LLSEC_DIGEST_DEBUG_PRINTF("%s \n", __func__);
+
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
+	LLSEC_afalg_ctx* ctx = (LLSEC_afalg_ctx*)native_id;
+	LLSEC_AFALG_close(ctx);
+	LLSEC_free(ctx);
+}
+
+static int afalg_digest_init(void** native_id, LLSEC_md_type md_type) {
 	LLSEC_DIGEST_DEBUG_PRINTF("%s \n", __func__);
 	int return_code = MICROEJ_LLSECU_DIGEST_SUCCESS;
 
-	// Memory allocation
-	EVP_MD_CTX* md_ctx  = EVP_MD_CTX_create();
-	if (NULL == md_ctx) {
+	LLSEC_afalg_ctx* ctx = (LLSEC_afalg_ctx*)LLSEC_calloc(1, sizeof(LLSEC_afalg_ctx));
+	if (NULL == ctx) {
 		return_code = MICROEJ_LLSECU_DIGEST_ERROR;
 	}
 
-	if (MICROEJ_LLSECU_DIGEST_SUCCESS == return_code) {
-		return_code = EVP_DigestInit_ex(md_ctx, EVP_sha256(), NULL);
+	if ((MICROEJ_LLSECU_DIGEST_SUCCESS == return_code) && !LLSEC_AFALG_open(ctx, afalg_digest_name(md_type), NULL, 0)) {
+		LLSEC_free(ctx);
+		return_code = MICROEJ_LLSECU_DIGEST_ERROR;
 	}
 
 	if (MICROEJ_LLSECU_DIGEST_SUCCESS == return_code) {
-		*native_id = md_ctx;
-	} else {
-#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
-		EVP_MD_CTX_destroy(md_ctx);
-#else
-		EVP_MD_CTX_free(md_ctx);
-#endif
+		*native_id = ctx;
 	}
-
 	return return_code;
 }
 
 /*
- * Specific sha-512 function
+ * Generic one-shot digest: each message is written with its end, then its digest is read
  */
-static int LLSEC_DIGEST_SHA512_init(void** native_id) {
-	LLSEC_DIGEST_DEBUG_PRINTF("%s \n", __func__);
+static int afalg_digest_many(LLSEC_md_type md_type, const uint8_t* buffer, const int32_t* lengths, int32_t count, uint8_t* out) {
+	LLSEC_DIGEST_DEBUG_PRINTF("%s count=%d\n", __func__, (int)count);
 	int return_code = MICROEJ_LLSECU_DIGEST_SUCCESS;
+	const uint8_t* message = buffer;
+	uint8_t* digest = out;
+	LLSEC_afalg_ctx ctx;
+	bool opened = LLSEC_AFALG_open(&ctx, afalg_digest_name(md_type), NULL, 0);
 
-	// Memory allocation
-	EVP_MD_CTX* md_ctx  = EVP_MD_CTX_create();
-	if (NULL == md_ctx) {
+	if (!opened) {
 		return_code = MICROEJ_LLSECU_DIGEST_ERROR;
 	}
 
-	if (MICROEJ_LLSECU_DIGEST_SUCCESS == return_code) {
-		return_code = EVP_DigestInit_ex(md_ctx, EVP_sha512(), NULL);
+	for (int32_t i = 0; (MICROEJ_LLSECU_DIGEST_SUCCESS == return_code) && (i < count); i++) {
+		int32_t digest_length = -1;
+		if (LLSEC_AFALG_hash_update(&ctx, message, lengths[i], false)) {
+			digest_length = LLSEC_AFALG_hash_final(&ctx, digest, EVP_MAX_MD_SIZE);
+		}
+		if (0 > digest_length) {
+			return_code = MICROEJ_LLSECU_DIGEST_ERROR;
+		} else {
+			message = &message[lengths[i]];
+			digest = &digest[digest_length];
+		}
 	}
 
-	if (MICROEJ_LLSECU_DIGEST_SUCCESS == return_code) {
-		*native_id = md_ctx;
-	} else {
-#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
-		EVP_MD_CTX_destroy(md_ctx);
-#else
-		EVP_MD_CTX_free(md_ctx);
-#endif
+	if (opened) {
+		LLSEC_AFALG_close(&ctx);
 	}
-
 	return return_code;
 }
 
+/*
+ * The kernel algorithm is found from the LLSEC algorithm name
+ */
+static const char* afalg_digest_name(LLSEC_md_type md_type) {
+	const char* name = "";
+	int32_t nb_algorithms = sizeof(afalg_algorithms) / sizeof(LLSEC_DIGEST_algorithm);
+	for (int32_t i = 0; i < nb_algorithms; i++) {
+		if (md_type == afalg_algorithms[i].md_type) {
+			name = afalg_algorithms[i].name;
+		}
+	}
+	return name;
+}
+
+/*
+ * Specific kernel crypto API functions
+ */
+static int LLSEC_DIGEST_afalg_MD5_init(void** native_id) {
+	return afalg_digest_init(native_id, LLSEC_MD_MD5);
+}
+
+static int LLSEC_DIGEST_afalg_SHA1_init(void** native_id) {
+	return afalg_digest_init(native_id, LLSEC_MD_SHA1);
+}
+
+static int LLSEC_DIGEST_afalg_SHA256_init(void** native_id) {
+	return afalg_digest_init(native_id, LLSEC_MD_SHA256);
+}
+
+static int LLSEC_DIGEST_afalg_SHA512_init(void** native_id) {
+	return afalg_digest_init(native_id, LLSEC_MD_SHA512);
+}
+#endif
+
 // cppcheck-suppress constParameterPointer // SNI type conflict
 int32_t LLSEC_DIGEST_IMPL_get_algorithm_description(uint8_t* algorithm_name, LLSEC_DIGEST_algorithm_desc* algorithm_desc)
 {
@@ -285,6 +455,13 @@ int32_t LLSEC_DIGEST_IMPL_get_algorithm_description(uint8_t* algorithm_name, LLS
 		algorithm++;
 	}
 
+#if LLSEC_AFALG_ENABLED
+	// The tables have the same order, the kernel replaces OpenSSL when selected and available
+	if ((nb_algorithms >= 0) && LLSEC_AFALG_is_enabled(algorithm->name)) {
+		algorithm = &afalg_algorithms[algorithm - &available_algorithms[0]];
+	}
+#endif
+
 	if (nb_algorithms >= 0) {
 		// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
 		return_code = (int32_t)algorithm;
@@ -373,3 +550,36 @@ void LLSEC_DIGEST_IMPL_update(int32_t algorithm_id, int32_t native_id, uint8_t*
 		(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
 	}
 }
+
+int32_t LLSEC_DIGEST_IMPL_digest_once(int32_t algorithm_id, uint8_t* buffer, int32_t buffer_offset, int32_t buffer_length,
+                                      uint8_t* out, int32_t out_offset, int32_t out_length)
+{
+	LLSEC_DIGEST_DEBUG_PRINTF("%s \n", __func__);
+	return LLSEC_DIGEST_IMPL_digest_many(algorithm_id, buffer, buffer_offset, buffer_length, &buffer_length, 1, out, out_offset, out_length);
+}
+
+int32_t LLSEC_DIGEST_IMPL_digest_many(int32_t algorithm_id, uint8_t* buffer, int32_t buffer_offset, int32_t buffer_length,
+                                      int32_t* lengths, int32_t count, uint8_t* out, int32_t out_offset, int32_t out_length)
+{
+	LLSEC_DIGEST_DEBUG_PRINTF("%s \n", __func__);
+	int32_t return_code = MICROEJ_LLSECU_DIGEST_SUCCESS;
+	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
+	const LLSEC_DIGEST_algorithm* algorithm = (LLSEC_DIGEST_algorithm*)algorithm_id;
+	int32_t digest_length = algorithm->description.digest_length;
+
+	if (!OPENSSL_SECURITY_check_messages(buffer_length, lengths, count, out_length, digest_length)) {
+		(void)SNI_throwNativeException(SNI_ERROR, "Invalid message lengths or digest buffer too small");
+		return_code = SNI_ERROR;
+	}
+
+	if (MICROEJ_LLSECU_DIGEST_SUCCESS == return_code) {
+		if (MICROEJ_LLSECU_DIGEST_SUCCESS == algorithm->many(algorithm->md_type, &buffer[buffer_offset], lengths, count, &out[out_offset])) {
+			return_code = count * digest_length;
+		} else {
+			int err = ERR_get_error();
+			(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
+			return_code = SNI_ERROR;
+		}
+	}
+	return return_code;
+}
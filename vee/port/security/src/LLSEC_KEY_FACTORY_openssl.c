@@ -25,6 +25,8 @@
 
 #include "LLSEC_configuration.h"
 #include "LLSEC_openssl.h"
+#include "LLSEC_CTX_POOL_openssl.h"
+#include "LLSEC_OBJECT_CACHE_openssl.h"
 
 #define MICROEJ_LLSECU_KEY_FACTORY_SUCCESS 1
 #define MICROEJ_LLSECU_KEY_FACTORY_ERROR   0
@@ -58,6 +60,7 @@ static int32_t LLSEC_KEY_FACTORY_EC_openssl_get_private_key_data(LLSEC_priv_key*
 static int32_t LLSEC_KEY_FACTORY_EC_openssl_get_public_key_data(LLSEC_pub_key* pub_key, uint8_t* encoded_key, int32_t encoded_key_length);
 static void LLSEC_KEY_FACTORY_openssl_private_key_close(void* native_id);
 static void LLSEC_KEY_FACTORY_openssl_public_key_close(void* native_id);
+static EVP_PKEY* LLSEC_KEY_FACTORY_openssl_decode(LLSEC_object_cache_kind kind, const uint8_t* encoded_key, int32_t encoded_key_length);
 
 // cppcheck-suppress misra-c2012-8.9 // Define here for code readability even if it called once in this file
 static LLSEC_KEY_FACTORY_algorithm available_algorithms[2] =
@@ -84,7 +87,7 @@ static int32_t LLSEC_KEY_FACTORY_RSA_openssl_get_private_key_data(LLSEC_priv_key
 	int32_t return_code = MICROEJ_LLSECU_KEY_FACTORY_SUCCESS;
 
 	priv_key->type = TYPE_RSA;
-	priv_key->key = d2i_PrivateKey(EVP_PKEY_RSA, (NULL) , (const unsigned char **)&encoded_key, encoded_key_length);
+	priv_key->key = LLSEC_KEY_FACTORY_openssl_decode(LLSEC_OBJECT_CACHE_RSA_PRIVATE_KEY, encoded_key, encoded_key_length);
 	if (NULL == priv_key->key) {
 		int err = ERR_get_error();
 		(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
@@ -117,7 +120,7 @@ static int32_t LLSEC_KEY_FACTORY_RSA_openssl_get_public_key_data(LLSEC_pub_key*
 	int32_t return_code = MICROEJ_LLSECU_KEY_FACTORY_SUCCESS;
 
 	pub_key->type = TYPE_RSA;
-	pub_key->key = d2i_PUBKEY((EVP_PKEY**) (NULL) , (const unsigned char **)&encoded_key, encoded_key_length);
+	pub_key->key = LLSEC_KEY_FACTORY_openssl_decode(LLSEC_OBJECT_CACHE_PUBLIC_KEY, encoded_key, encoded_key_length);
 	if (NULL == pub_key->key) {
 		int err = ERR_get_error();
 		(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
@@ -150,7 +153,7 @@ static int LLSEC_KEY_FACTORY_EC_openssl_get_private_key_data(LLSEC_priv_key* pri
 	int32_t return_code = MICROEJ_LLSECU_KEY_FACTORY_SUCCESS;
 
 	priv_key->type = TYPE_ECDSA;
-	priv_key->key  = d2i_PrivateKey(EVP_PKEY_EC, (NULL) , (const unsigned char **)&encoded_key, encoded_key_length);
+	priv_key->key = LLSEC_KEY_FACTORY_openssl_decode(LLSEC_OBJECT_CACHE_EC_PRIVATE_KEY, encoded_key, encoded_key_length);
 	if (NULL == priv_key->key) {
 		// Error
 		int err = ERR_get_error();
@@ -186,7 +189,7 @@ static int32_t LLSEC_KEY_FACTORY_EC_openssl_get_public_key_data(LLSEC_pub_key* p
 	pub_key->type = TYPE_ECDSA;
 	// with no call to EVP_PKEY_free this will leak memory
 	// A mean to free native memory upon gargbage collection of the associated Java object is required
-	pub_key->key = d2i_PUBKEY((EVP_PKEY**) (NULL) , (const unsigned char **)&encoded_key, encoded_key_length);
+	pub_key->key = LLSEC_KEY_FACTORY_openssl_decode(LLSEC_OBJECT_CACHE_PUBLIC_KEY, encoded_key, encoded_key_length);
 	if (NULL == pub_key->key) {
 		int err = ERR_get_error();
 		(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
@@ -213,9 +216,42 @@ static int32_t LLSEC_KEY_FACTORY_EC_openssl_get_public_key_data(LLSEC_pub_key* p
 	return return_code;
 }
 
+/**
+ * @brief Decodes a key, or takes a new reference to the key already decoded from the same bytes.
+ *
+ * @param[in] kind the key kind: a X.509 public key or a PKCS#8 RSA or EC private key.
+ * @param[in] encoded_key the encoded key.
+ * @param[in] encoded_key_length the encoded key length.
+ *
+ * @return the key, to free with EVP_PKEY_free(). NULL on error, with the OpenSSL error queued.
+ */
+static EVP_PKEY* LLSEC_KEY_FACTORY_openssl_decode(LLSEC_object_cache_kind kind, const uint8_t* encoded_key, int32_t encoded_key_length) {
+	EVP_PKEY* key = NULL;
+	LLSEC_object_cache_key cache_key;
+	bool cacheable = LLSEC_OBJECT_CACHE_make_key(&cache_key, kind, encoded_key, encoded_key_length);
+	if (cacheable) {
+		key = LLSEC_OBJECT_CACHE_get_pkey(&cache_key);
+	}
+
+	if (NULL == key) {
+		const unsigned char* der = encoded_key;
+		if (LLSEC_OBJECT_CACHE_PUBLIC_KEY == kind) {
+			key = d2i_PUBKEY(NULL, &der, encoded_key_length);
+		} else {
+			int type = (LLSEC_OBJECT_CACHE_RSA_PRIVATE_KEY == kind) ? EVP_PKEY_RSA : EVP_PKEY_EC;
+			key = d2i_PrivateKey(type, NULL, &der, encoded_key_length);
+		}
+		if (cacheable && (NULL != key)) {
+			LLSEC_OBJECT_CACHE_put_pkey(&cache_key, key);
+		}
+	}
+	return key;
+}
+
 static void LLSEC_KEY_FACTORY_openssl_private_key_close(void* native_id) {
 	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
 	LLSEC_priv_key* key = (LLSEC_priv_key*) native_id;
+	LLSEC_CTX_POOL_purge_pkey_ctx(key->key);
 	EVP_PKEY_free(key->key);
 	LLSEC_free(key);
 }
@@ -223,6 +259,7 @@ static void LLSEC_KEY_FACTORY_openssl_private_key_close(void* native_id) {
 static void LLSEC_KEY_FACTORY_openssl_public_key_close(void* native_id) {
 	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
 	LLSEC_pub_key* key = (LLSEC_pub_key*) native_id;
+	LLSEC_CTX_POOL_purge_pkey_ctx(key->key);
 	EVP_PKEY_free(key->key);
 	LLSEC_free(key);
 }
@@ -9,6 +9,9 @@
 #include <LLSEC_KEY_PAIR_GENERATOR_impl.h>
 #include "LLSEC_configuration.h"
 #include <LLSEC_openssl.h>
+#include "LLSEC_CTX_POOL_openssl.h"
+#include "LLSEC_KEY_POOL_openssl.h"
+#include "LLSEC_WORKER_openssl.h"
 #include <sni.h>
 #include <string.h>
 #include <openssl/rsa.h>
@@ -38,14 +41,11 @@
 
 typedef void (*LLSEC_KEY_PAIR_GENERATOR_close)(void* native_id);
 
-//RSA
-static int32_t LLSEC_KEY_PAIR_GENERATOR_RSA_openssl_generateKeyPair(int32_t rsa_Key_size, int32_t rsa_public_exponent);
-
-//EC
-static int32_t LLSEC_KEY_PAIR_GENERATOR_EC_openssl_generateKeyPair(const uint8_t* ec_curve_stdname);
-
 //common
+static int32_t LLSEC_KEY_PAIR_GENERATOR_openssl_register(EVP_PKEY* pk);
 static void LLSEC_KEY_PAIR_GENERATOR_openssl_close(void* native_id);
+static void LLSEC_KEY_PAIR_GENERATOR_generate_action(MICROEJ_ASYNC_WORKER_job_t* job);
+static int32_t LLSEC_KEY_PAIR_GENERATOR_generate_on_done(int32_t algorithm_id, int32_t rsa_key_size, int32_t rsa_public_exponent, uint8_t* ec_curve_stdname);
 
 typedef struct {
 	char* name;
@@ -65,7 +65,12 @@ static LLSEC_KEY_PAIR_GENERATOR_algorithm supportedAlgorithms[2] = {
 
 };
 
-static int32_t LLSEC_KEY_PAIR_GENERATOR_RSA_openssl_generateKeyPair(int32_t rsa_Key_size, int32_t rsa_public_exponent) {
+/**
+ * @brief Generates an RSA key pair. Does not use SNI, so it can run in a crypto worker or the key pool task.
+ *
+ * @return the key pair, NULL on error with the OpenSSL error queue set.
+ */
+EVP_PKEY* LLSEC_KEY_PAIR_GENERATOR_RSA_openssl_generate(int32_t rsa_Key_size, int32_t rsa_public_exponent) {
 	LLSEC_KEY_PAIR_GENERATOR_PRINTF("%s \n", __func__);
 	EVP_PKEY *pk = NULL;
 
@@ -73,121 +78,82 @@ static int32_t LLSEC_KEY_PAIR_GENERATOR_RSA_openssl_generateKeyPair(int32_t rsa_
 	// Initialize key exponent
 	BIGNUM* bn = BN_new();
 	if (NULL == bn) {
-		int err = ERR_get_error();
-		(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
-
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
+		return NULL;
 	}
 	BN_set_word(bn, rsa_public_exponent); //F0, F4 or other random number
 
 	// Initialize RSA key
 	RSA *rsa = RSA_new();
 	if (NULL == rsa) {
-		int err = ERR_get_error();
-		(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
-
 		BN_free(bn);
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
+		return NULL;
 	}
 
 	// Generate RSA key
 	if (RSA_generate_key_ex(rsa, rsa_Key_size, bn, NULL) != 1) { // returns 1 on success or 0 on error.
-		int err = ERR_get_error();
-		(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
-
 		BN_free(bn);
 		RSA_free(rsa);
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
+		return NULL;
 	}
 
 	BN_free(bn); // not needed any more, clean it.
 
 	pk = EVP_PKEY_new();
 	if (NULL == pk) {
-		int err = ERR_get_error();
-		(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
-
 		RSA_free(rsa);
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
+		return NULL;
 	}
 
 	if (EVP_PKEY_assign_RSA(pk, rsa) <= 0) {
-		int err = ERR_get_error();
-		(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
-
 		RSA_free(rsa);
 		EVP_PKEY_free(pk);
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
+		return NULL;
 	}
 #else
 	EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, NULL);
 	if (NULL == ctx) {
-		uint32_t err = ERR_get_error();
-		LLSEC_KEY_PAIR_GENERATOR_PRINTF("%s EVP_PKEY_CTX_new_id failed: %s\n", __func__, ERR_error_string(err, NULL));
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
+		LLSEC_KEY_PAIR_GENERATOR_PRINTF("%s EVP_PKEY_CTX_new_id failed\n", __func__);
+		return NULL;
 	}
 
 	if (EVP_PKEY_keygen_init(ctx) <= 0) {
-		uint32_t err = ERR_get_error();
-		LLSEC_KEY_PAIR_GENERATOR_PRINTF("%s EVP_PKEY_keygen_init failed: %s\n", __func__, ERR_error_string(err, NULL));
+		LLSEC_KEY_PAIR_GENERATOR_PRINTF("%s EVP_PKEY_keygen_init failed\n", __func__);
 		EVP_PKEY_CTX_free(ctx);
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
+		return NULL;
 	}
 
 	if (EVP_PKEY_CTX_set_rsa_keygen_bits(ctx, (int)rsa_Key_size) <=0) {
-		uint32_t err = ERR_get_error();
-		LLSEC_KEY_PAIR_GENERATOR_PRINTF("%s EVP_PKEY_CTX_set_rsa_keygen_bits for %s failed: %s\n", __func__, ec_curve_stdname, ERR_error_string(err, NULL));
+		LLSEC_KEY_PAIR_GENERATOR_PRINTF("%s EVP_PKEY_CTX_set_rsa_keygen_bits failed\n", __func__);
 		EVP_PKEY_CTX_free(ctx);
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
+		return NULL;
 	}
 
- 	BIGNUM *bn = BN_new();
-  	BN_set_word(bn, rsa_public_exponent);
+	BIGNUM *bn = BN_new();
+	BN_set_word(bn, rsa_public_exponent);
 	if (EVP_PKEY_CTX_set1_rsa_keygen_pubexp(ctx, bn) <=0) {
-		uint32_t err = ERR_get_error();
-		LLSEC_KEY_PAIR_GENERATOR_PRINTF("%s EVP_PKEY_CTX_set1_rsa_keygen_pubexp for %s failed: %s\n", __func__, ec_curve_stdname, ERR_error_string(err, NULL));
+		LLSEC_KEY_PAIR_GENERATOR_PRINTF("%s EVP_PKEY_CTX_set1_rsa_keygen_pubexp failed\n", __func__);
 		EVP_PKEY_CTX_free(ctx);
 		BN_free(bn);
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
+		return NULL;
 	}
 	BN_free(bn);
 
 	if (EVP_PKEY_keygen(ctx, &pk) <= 0) {
-		uint32_t err = ERR_get_error();
-		LLSEC_KEY_PAIR_GENERATOR_PRINTF("%s EVP_PKEY_generate failed: %s\n", __func__, ERR_error_string(err, NULL));
-		EVP_PKEY_CTX_free(ctx);
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
+		LLSEC_KEY_PAIR_GENERATOR_PRINTF("%s EVP_PKEY_generate failed\n", __func__);
+		pk = NULL;
 	}
 	EVP_PKEY_CTX_free(ctx);
 #endif // OPENSSL_VERSION_NUMBER
 
-	LLSEC_priv_key* key = (LLSEC_priv_key*) LLSEC_calloc(1, sizeof(LLSEC_priv_key));
-	if (NULL == key) {
-		(void)SNI_throwNativeException(SNI_ERROR, "Can't allocate LLSEC_priv_key structure");
-		EVP_PKEY_free(pk); //rsa structure is freed when the key is freed
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
-	}
-
-	key->key = pk;
-	key->type = TYPE_RSA;
-
-	// Register the key to be managed by SNI as a native resource.
-	// the close callback when be called when the key is collected by the GC
-	// The key is freed in the close callback
-	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
-	int32_t native_id = (int32_t) key;
-	// cppcheck-suppress misra-c2012-11.6 // Abstract data type for SNI usage
-	if (SNI_registerResource((void*)native_id, LLSEC_KEY_PAIR_GENERATOR_openssl_close, NULL) != SNI_OK) {
-		(void)SNI_throwNativeException(SNI_ERROR, "SNI: can't register native resource");
-		EVP_PKEY_free(key->key);
-		free(key);
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
-	}
-
-	return native_id;
+	return pk;
 }
 
-static int32_t LLSEC_KEY_PAIR_GENERATOR_EC_openssl_generateKeyPair(const uint8_t* ec_curve_stdname) {
+/**
+ * @brief Generates an EC key pair. Does not use SNI, so it can run in a crypto worker or the key pool task.
+ *
+ * @return the key pair, NULL on error with the OpenSSL error queue set.
+ */
+EVP_PKEY* LLSEC_KEY_PAIR_GENERATOR_EC_openssl_generate(const char* ec_curve_stdname) {
 	LLSEC_KEY_PAIR_GENERATOR_PRINTF("%s \n", __func__);
 	EVP_PKEY *pk = NULL;
 
@@ -195,60 +161,45 @@ static int32_t LLSEC_KEY_PAIR_GENERATOR_EC_openssl_generateKeyPair(const uint8_t
 	// Initialize EC key
 	int eccgrp = OBJ_txt2nid(ec_curve_stdname);
 	if(NID_undef == eccgrp) {
-		int err = ERR_get_error();
-		(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
+		return NULL;
 	}
 
 	EC_KEY *ecc = EC_KEY_new_by_curve_name(eccgrp);
 	if (NULL == ecc) {
-		int err = ERR_get_error();
-		(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
+		return NULL;
 	}
 
 	EC_KEY_set_asn1_flag(ecc, OPENSSL_EC_NAMED_CURVE);
 
 	// Generate EC key pair
 	if (EC_KEY_generate_key(ecc) <= 0) {
-		int err = ERR_get_error();
-		(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
-
 		EC_KEY_free(ecc);
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
+		return NULL;
 	}
 
 	pk = EVP_PKEY_new();
 	if (NULL == pk) {
-		int err = ERR_get_error();
-		(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
-
 		EC_KEY_free(ecc);
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
+		return NULL;
 	}
 
 	if (EVP_PKEY_assign_EC_KEY(pk, ecc) <= 0) {
-		int err = ERR_get_error();
-		(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
-
 		EC_KEY_free(ecc);
 		EVP_PKEY_free(pk);
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
+		return NULL;
 	}
 #else
 	// Create Key generation context
 	EVP_PKEY_CTX *ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, NULL);
 	if (NULL == ctx) {
-		uint32_t err = ERR_get_error();
-		LLSEC_KEY_PAIR_GENERATOR_PRINTF("%s EVP_PKEY_CTX_new_id failed: %s\n", __func__, ERR_error_string(err, NULL));
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
+		LLSEC_KEY_PAIR_GENERATOR_PRINTF("%s EVP_PKEY_CTX_new_id failed\n", __func__);
+		return NULL;
 	}
 
 	if (EVP_PKEY_keygen_init(ctx) <= 0) {
-		uint32_t err = ERR_get_error();
-		LLSEC_KEY_PAIR_GENERATOR_PRINTF("%s EVP_PKEY_keygen_init failed: %s\n", __func__, ERR_error_string(err, NULL));
+		LLSEC_KEY_PAIR_GENERATOR_PRINTF("%s EVP_PKEY_keygen_init failed\n", __func__);
 		EVP_PKEY_CTX_free(ctx);
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
+		return NULL;
 	}
 
 	int curve_nid = EC_curve_nist2nid(ec_curve_stdname);
@@ -257,31 +208,36 @@ static int32_t LLSEC_KEY_PAIR_GENERATOR_EC_openssl_generateKeyPair(const uint8_t
 	}
 
 	if (EVP_PKEY_CTX_set_ec_paramgen_curve_nid(ctx, curve_nid) <=0) {
-		uint32_t err = ERR_get_error();
-		LLSEC_KEY_PAIR_GENERATOR_PRINTF("%s EVP_PKEY_CTX_set_ec_paramgen_curve_nid for %s failed: %s\n", __func__, ec_curve_stdname, ERR_error_string(err, NULL));
+		LLSEC_KEY_PAIR_GENERATOR_PRINTF("%s EVP_PKEY_CTX_set_ec_paramgen_curve_nid for %s failed\n", __func__, ec_curve_stdname);
 		EVP_PKEY_CTX_free(ctx);
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
+		return NULL;
 	}
 
 	if (EVP_PKEY_keygen(ctx, &pk) <= 0) {
-		uint32_t err = ERR_get_error();
-		LLSEC_KEY_PAIR_GENERATOR_PRINTF("%s EVP_PKEY_generate failed: %s\n", __func__, ERR_error_string(err, NULL));
-		EVP_PKEY_CTX_free(ctx);
-		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
+		LLSEC_KEY_PAIR_GENERATOR_PRINTF("%s EVP_PKEY_generate failed\n", __func__);
+		pk = NULL;
 	}
 	EVP_PKEY_CTX_free(ctx);
 #endif // OPENSSL_VERSION_NUMBER
 
+	return pk;
+}
+
+/**
+ * @brief Registers a generated key pair as an SNI native resource, on the VM task. Frees the key pair on error.
+ *
+ * @return the native id of the key pair, LLSEC_KEY_PAIR_GENERATOR_ERROR on error with an exception pending.
+ */
+static int32_t LLSEC_KEY_PAIR_GENERATOR_openssl_register(EVP_PKEY* pk) {
 	LLSEC_priv_key* key = (LLSEC_priv_key*) LLSEC_calloc(1, sizeof(LLSEC_priv_key));
 	if (NULL == key) {
 		(void)SNI_throwNativeException(SNI_ERROR, "Can't allocate LLSEC_priv_key structure");
-
-		EVP_PKEY_free(pk); //ecc structure is freed when the key is freed
+		EVP_PKEY_free(pk); //rsa or ecc structure is freed when the key is freed
 		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
 	}
 
 	key->key = pk;
-	key->type = TYPE_ECDSA;
+	key->type = (LLSEC_pub_key_type)EVP_PKEY_base_id(pk);
 
 	// Register the key to be managed by SNI as a native resource.
 	// the close callback when be called when the key is collected by the GC
@@ -296,13 +252,55 @@ static int32_t LLSEC_KEY_PAIR_GENERATOR_EC_openssl_generateKeyPair(const uint8_t
 		return LLSEC_KEY_PAIR_GENERATOR_ERROR;
 	}
 
-	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
 	return native_id;
 }
 
+/**
+ * @brief Generates a key pair, in a crypto worker.
+ */
+static void LLSEC_KEY_PAIR_GENERATOR_generate_action(MICROEJ_ASYNC_WORKER_job_t* job) {
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for async worker usage
+	LLSEC_WORKER_job* params = (LLSEC_WORKER_job*)job->params;
+	LLSEC_WORKER_key_pair* operation = &params->operation.key_pair;
+	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
+	const LLSEC_KEY_PAIR_GENERATOR_algorithm* algorithm = (LLSEC_KEY_PAIR_GENERATOR_algorithm*)operation->algorithm_id;
+
+	if (0 == strcmp(algorithm->name, "RSA")) {
+		operation->key = LLSEC_KEY_PAIR_GENERATOR_RSA_openssl_generate(operation->rsa_key_size, operation->rsa_public_exponent);
+	} else {
+		operation->key = LLSEC_KEY_PAIR_GENERATOR_EC_openssl_generate(operation->ec_curve_stdname);
+	}
+	if (NULL == operation->key) {
+		LLSEC_WORKER_save_error(params);
+	}
+}
+
+/**
+ * @brief Registers the key pair generated in a crypto worker, on the VM task.
+ */
+static int32_t LLSEC_KEY_PAIR_GENERATOR_generate_on_done(int32_t algorithm_id, int32_t rsa_key_size, int32_t rsa_public_exponent, uint8_t* ec_curve_stdname) {
+	(void)algorithm_id;
+	(void)rsa_key_size;
+	(void)rsa_public_exponent;
+	(void)ec_curve_stdname;
+	int32_t return_code = LLSEC_KEY_PAIR_GENERATOR_ERROR;
+
+	MICROEJ_ASYNC_WORKER_job_t* job = LLSEC_WORKER_get_job_done();
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for async worker usage
+	LLSEC_WORKER_job* params = (LLSEC_WORKER_job*)job->params;
+	if (NULL == params->operation.key_pair.key) {
+		LLSEC_WORKER_throw_error(params);
+	} else {
+		return_code = LLSEC_KEY_PAIR_GENERATOR_openssl_register(params->operation.key_pair.key);
+	}
+	LLSEC_WORKER_free_job(job);
+	return return_code;
+}
+
 static void LLSEC_KEY_PAIR_GENERATOR_openssl_close(void* native_id) {
 	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
 	LLSEC_priv_key* key = (LLSEC_priv_key*) native_id;
+	LLSEC_CTX_POOL_purge_pkey_ctx(key->key);
 	EVP_PKEY_free(key->key);
 	free(key);
 }
@@ -334,10 +332,53 @@ int32_t LLSEC_KEY_PAIR_GENERATOR_IMPL_generateKeyPair(int32_t algorithm_id, int3
 
 	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
 	const LLSEC_KEY_PAIR_GENERATOR_algorithm* algorithm = (LLSEC_KEY_PAIR_GENERATOR_algorithm*) algorithm_id;
-	if (0 == strcmp(algorithm->name, "RSA")) {
-		return_code = LLSEC_KEY_PAIR_GENERATOR_RSA_openssl_generateKeyPair(rsa_key_size, rsa_public_exponent);
-	} else if (0 == strcmp(algorithm->name, "EC")) {
-		return_code = LLSEC_KEY_PAIR_GENERATOR_EC_openssl_generateKeyPair(ec_curve_stdname);
+	bool is_rsa = (0 == strcmp(algorithm->name, "RSA"));
+	bool is_ec = (0 == strcmp(algorithm->name, "EC"));
+	EVP_PKEY* pk = NULL;
+
+	// A pre-generated key pair, if any
+	if (is_rsa) {
+		pk = LLSEC_KEY_POOL_take_rsa(rsa_key_size, rsa_public_exponent);
+	} else if (is_ec) {
+		pk = LLSEC_KEY_POOL_take_ec((const char*)ec_curve_stdname);
+	} else {
+		// Unsupported algorithm
+	}
+
+	if (NULL != pk) {
+		return_code = LLSEC_KEY_PAIR_GENERATOR_openssl_register(pk);
+	} else if ((is_rsa && LLSEC_WORKER_is_expensive_rsa_keygen(rsa_key_size)) ||
+	    (is_ec && LLSEC_WORKER_is_expensive_ec_keygen((const char*)ec_curve_stdname))) {
+		// The generation runs on a crypto worker, the Java thread is suspended until
+		// LLSEC_KEY_PAIR_GENERATOR_generate_on_done()
+		// cppcheck-suppress misra-c2012-11.1 // SNI callback
+		MICROEJ_ASYNC_WORKER_job_t* job = LLSEC_WORKER_allocate_job((SNI_callback)LLSEC_KEY_PAIR_GENERATOR_IMPL_generateKeyPair);
+		if (NULL != job) {
+			// cppcheck-suppress misra-c2012-11.5 // Abstract data type for async worker usage
+			LLSEC_WORKER_job* params = (LLSEC_WORKER_job*)job->params;
+			LLSEC_WORKER_key_pair* operation = &params->operation.key_pair;
+			operation->algorithm_id = algorithm_id;
+			operation->rsa_key_size = rsa_key_size;
+			operation->rsa_public_exponent = rsa_public_exponent;
+			if (is_ec) {
+				// The length has been checked by LLSEC_WORKER_is_expensive_ec_keygen()
+				(void)strcpy(operation->ec_curve_stdname, (const char*)ec_curve_stdname);
+			}
+			LLSEC_WORKER_exec(job, LLSEC_KEY_PAIR_GENERATOR_generate_action, (SNI_callback)LLSEC_KEY_PAIR_GENERATOR_generate_on_done);
+		} // else the Java thread waits for a job, or an exception is pending
+		return_code = SNI_IGNORED_RETURNED_VALUE;
+	} else if (is_rsa || is_ec) {
+		if (is_rsa) {
+			pk = LLSEC_KEY_PAIR_GENERATOR_RSA_openssl_generate(rsa_key_size, rsa_public_exponent);
+		} else {
+			pk = LLSEC_KEY_PAIR_GENERATOR_EC_openssl_generate((const char*)ec_curve_stdname);
+		}
+		if (NULL == pk) {
+			int err = ERR_get_error();
+			(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
+		} else {
+			return_code = LLSEC_KEY_PAIR_GENERATOR_openssl_register(pk);
+		}
 	} else {
 		// Algorithm not found error.
 		// this should never happen because the algorithm_id is a valid algorithm at this level.
@@ -0,0 +1,296 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ *
+ */
+
+/**
+ * @file
+ * @brief MicroEJ Security low level API: pre-generated key pairs.
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <openssl/crypto.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/opensslv.h>
+#ifdef __linux__
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include "LLSEC_configuration.h"
+#include "LLSEC_KEY_POOL_openssl.h"
+#include "LLSEC_openssl.h"
+#include "osal.h"
+
+// #define LLSEC_KEY_POOL_DEBUG_TRACE
+
+#ifdef LLSEC_KEY_POOL_DEBUG_TRACE
+#define LLSEC_KEY_POOL_DEBUG_PRINTF(...) (void)printf(__VA_ARGS__)
+#else
+#define LLSEC_KEY_POOL_DEBUG_PRINTF(...) ((void)0)
+#endif
+
+// Ready key pairs of a curve or an RSA key size and exponent
+typedef struct {
+	int type; // EVP_PKEY_EC or EVP_PKEY_RSA, EVP_PKEY_NONE if the slot is unused
+	uint32_t id; // changes each time the slot is assigned
+	int32_t rsa_key_size;
+	int32_t rsa_public_exponent;
+	char curve_name[LLSEC_KEY_POOL_CURVE_NAME_SIZE];
+	int64_t last_request; // value of request_count at the last request
+	EVP_PKEY* keys[LLSEC_KEY_POOL_DEPTH];
+	int32_t count;
+} LLSEC_KEY_POOL_slot;
+
+#if LLSEC_KEY_POOL_ENABLED == 1
+static EVP_PKEY* LLSEC_KEY_POOL_take(int type, int32_t rsa_key_size, int32_t rsa_public_exponent, const char* curve_name);
+static void LLSEC_KEY_POOL_initialize(void);
+static LLSEC_KEY_POOL_slot* LLSEC_KEY_POOL_get_slot(int type, int32_t rsa_key_size, int32_t rsa_public_exponent, const char* curve_name);
+static LLSEC_KEY_POOL_slot* LLSEC_KEY_POOL_get_slot_to_fill(void);
+static void LLSEC_KEY_POOL_clear_slot(LLSEC_KEY_POOL_slot* slot);
+static void* LLSEC_KEY_POOL_task(void* args);
+
+OSAL_task_stack_declare(llsec_key_pool_stack, LLSEC_KEY_POOL_STACK_SIZE);
+
+static bool initialized = false;
+static bool started = false;
+static OSAL_mutex_handle_t pool_mutex;
+static OSAL_binary_semaphore_handle_t refill_semaphore;
+static OSAL_task_handle_t refill_task;
+
+// Accessed with pool_mutex
+static LLSEC_KEY_POOL_slot slots[LLSEC_KEY_POOL_SLOTS];
+static uint32_t last_slot_id = 0;
+static int64_t request_count = 0;
+static int64_t statistics[LLSEC_KEY_POOL_STAT_COUNT];
+#endif // LLSEC_KEY_POOL_ENABLED == 1
+
+EVP_PKEY* LLSEC_KEY_POOL_take_ec(const char* curve_name) {
+	EVP_PKEY* key = NULL;
+#if LLSEC_KEY_POOL_ENABLED == 1
+	if (strlen(curve_name) < (size_t)LLSEC_KEY_POOL_CURVE_NAME_SIZE) {
+		key = LLSEC_KEY_POOL_take(EVP_PKEY_EC, 0, 0, curve_name);
+	}
+#else
+	(void)curve_name;
+#endif
+	return key;
+}
+
+EVP_PKEY* LLSEC_KEY_POOL_take_rsa(int32_t key_size, int32_t public_exponent) {
+	EVP_PKEY* key = NULL;
+#if (LLSEC_KEY_POOL_ENABLED == 1) && (LLSEC_KEY_POOL_RSA_ENABLED == 1)
+	key = LLSEC_KEY_POOL_take(EVP_PKEY_RSA, key_size, public_exponent, "");
+#else
+	(void)key_size;
+	(void)public_exponent;
+#endif
+	return key;
+}
+
+int64_t LLSEC_KEY_POOL_IMPL_getStatistic(int32_t id) {
+	int64_t value = -1;
+	if ((id >= 0) && (id < LLSEC_KEY_POOL_STAT_COUNT)) {
+		value = 0;
+#if LLSEC_KEY_POOL_ENABLED == 1
+		if (started) {
+			(void)OSAL_mutex_take(&pool_mutex, OSAL_INFINITE_TIME);
+			value = statistics[id];
+			(void)OSAL_mutex_give(&pool_mutex);
+		}
+#endif
+	}
+	return value;
+}
+
+#if LLSEC_KEY_POOL_ENABLED == 1
+/**
+ * @brief Takes a ready key pair and wakes up the background task to refill the pool. From the VM task.
+ *
+ * @return the key pair, NULL if there is none.
+ */
+static EVP_PKEY* LLSEC_KEY_POOL_take(int type, int32_t rsa_key_size, int32_t rsa_public_exponent, const char* curve_name) {
+	EVP_PKEY* key = NULL;
+
+	LLSEC_KEY_POOL_initialize();
+	if (started) {
+		(void)OSAL_mutex_take(&pool_mutex, OSAL_INFINITE_TIME);
+		LLSEC_KEY_POOL_slot* slot = LLSEC_KEY_POOL_get_slot(type, rsa_key_size, rsa_public_exponent, curve_name);
+		request_count++;
+		slot->last_request = request_count;
+		if (0 < slot->count) {
+			slot->count--;
+			key = slot->keys[slot->count];
+			slot->keys[slot->count] = NULL;
+			statistics[LLSEC_KEY_POOL_STAT_HITS]++;
+			statistics[LLSEC_KEY_POOL_STAT_READY]--;
+		} else {
+			statistics[LLSEC_KEY_POOL_STAT_MISSES]++;
+		}
+		(void)OSAL_mutex_give(&pool_mutex);
+
+		(void)OSAL_binary_semaphore_give(&refill_semaphore);
+	}
+	LLSEC_KEY_POOL_DEBUG_PRINTF("%s type %d %s: %s\n", __func__, type, curve_name, (NULL != key) ? "hit" : "miss");
+	return key;
+}
+
+/**
+ * @brief Starts the background task, on the first request.
+ */
+static void LLSEC_KEY_POOL_initialize(void) {
+	if (!initialized) {
+		initialized = true;
+		bool ok = true;
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+		// OpenSSL 1.0.2 is only thread safe with the locking callbacks
+		ok = (NULL != CRYPTO_get_locking_callback());
+#endif
+		// cppcheck-suppress misra-c2012-11.8 // String casts conform to OSAL function definitions.
+		ok = ok && (OSAL_OK == OSAL_mutex_create((uint8_t*)"LLSEC key pool", &pool_mutex));
+		// cppcheck-suppress misra-c2012-11.8 // String casts conform to OSAL function definitions.
+		ok = ok && (OSAL_OK == OSAL_binary_semaphore_create((uint8_t*)"LLSEC key pool refill", 0, &refill_semaphore));
+		// cppcheck-suppress misra-c2012-11.8 // String casts conform to OSAL function definitions.
+		ok = ok && (OSAL_OK == OSAL_task_create(LLSEC_KEY_POOL_task, (uint8_t*)"MicroEJ Key Pool", llsec_key_pool_stack,
+		                                        LLSEC_KEY_POOL_PRIORITY, NULL, &refill_task));
+		if (!ok) {
+			LLSEC_KEY_POOL_DEBUG_PRINTF("%s cannot start the key pre-generation task\n", __func__);
+		}
+		started = ok;
+	}
+}
+
+/**
+ * @brief Gets the slot of a curve or RSA key size, replacing the least recently requested one if there is none.
+ * Called with pool_mutex.
+ */
+static LLSEC_KEY_POOL_slot* LLSEC_KEY_POOL_get_slot(int type, int32_t rsa_key_size, int32_t rsa_public_exponent, const char* curve_name) {
+	LLSEC_KEY_POOL_slot* slot = NULL;
+	LLSEC_KEY_POOL_slot* oldest = &slots[0];
+
+	for (int32_t i = 0; (NULL == slot) && (i < LLSEC_KEY_POOL_SLOTS); i++) {
+		LLSEC_KEY_POOL_slot* candidate = &slots[i];
+		if ((type == candidate->type) && (rsa_key_size == candidate->rsa_key_size) &&
+		    (rsa_public_exponent == candidate->rsa_public_exponent) && (0 == strcmp(curve_name, candidate->curve_name))) {
+			slot = candidate;
+		} else if (candidate->last_request < oldest->last_request) {
+			oldest = candidate;
+		} else {
+			// Keep looking
+		}
+	}
+
+	if (NULL == slot) {
+		slot = oldest;
+		LLSEC_KEY_POOL_clear_slot(slot);
+		last_slot_id++;
+		slot->id = last_slot_id;
+		slot->type = type;
+		slot->rsa_key_size = rsa_key_size;
+		slot->rsa_public_exponent = rsa_public_exponent;
+		(void)strcpy(slot->curve_name, curve_name);
+	}
+	return slot;
+}
+
+/**
+ * @brief Gets the used slot with the fewest ready key pairs, NULL if all the used slots are full. Called with
+ * pool_mutex.
+ */
+static LLSEC_KEY_POOL_slot* LLSEC_KEY_POOL_get_slot_to_fill(void) {
+	LLSEC_KEY_POOL_slot* slot = NULL;
+	for (int32_t i = 0; i < LLSEC_KEY_POOL_SLOTS; i++) {
+		LLSEC_KEY_POOL_slot* candidate = &slots[i];
+		if ((EVP_PKEY_NONE != candidate->type) && (LLSEC_KEY_POOL_DEPTH > candidate->count) &&
+		    ((NULL == slot) || (candidate->count < slot->count))) {
+			slot = candidate;
+		}
+	}
+	return slot;
+}
+
+/**
+ * @brief Frees the ready key pairs of a slot and marks it unused. Called with pool_mutex.
+ */
+static void LLSEC_KEY_POOL_clear_slot(LLSEC_KEY_POOL_slot* slot) {
+	while (0 < slot->count) {
+		slot->count--;
+		EVP_PKEY_free(slot->keys[slot->count]);
+		slot->keys[slot->count] = NULL;
+		statistics[LLSEC_KEY_POOL_STAT_READY]--;
+	}
+	slot->type = EVP_PKEY_NONE;
+	slot->last_request = 0;
+}
+
+/**
+ * @brief Background task: fills the slots each time a key pair is requested.
+ */
+static void* LLSEC_KEY_POOL_task(void* args) {
+	(void)args;
+#ifdef __linux__
+	// The nice value of a Linux thread is set with its thread id
+	(void)setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), LLSEC_KEY_POOL_NICE);
+#endif
+
+	for (;;) {
+		(void)OSAL_binary_semaphore_take(&refill_semaphore, OSAL_INFINITE_TIME);
+
+		bool filling = true;
+		while (filling) {
+			// Copy the parameters, the slot may be replaced during the generation
+			LLSEC_KEY_POOL_slot request;
+			(void)OSAL_mutex_take(&pool_mutex, OSAL_INFINITE_TIME);
+			LLSEC_KEY_POOL_slot* slot = LLSEC_KEY_POOL_get_slot_to_fill();
+			if (NULL != slot) {
+				(void)memcpy(&request, slot, sizeof(LLSEC_KEY_POOL_slot));
+			}
+			(void)OSAL_mutex_give(&pool_mutex);
+
+			if (NULL == slot) {
+				filling = false;
+			} else {
+				EVP_PKEY* key;
+				if (EVP_PKEY_EC == request.type) {
+					key = LLSEC_KEY_PAIR_GENERATOR_EC_openssl_generate(request.curve_name);
+				} else {
+					key = LLSEC_KEY_PAIR_GENERATOR_RSA_openssl_generate(request.rsa_key_size, request.rsa_public_exponent);
+				}
+
+				(void)OSAL_mutex_take(&pool_mutex, OSAL_INFINITE_TIME);
+				if (NULL == key) {
+					// Invalid parameters, the requests generate the key pairs (and throw the error) themselves
+					ERR_clear_error();
+					if (slot->id == request.id) {
+						LLSEC_KEY_POOL_clear_slot(slot);
+					}
+				} else if ((slot->id == request.id) && (LLSEC_KEY_POOL_DEPTH > slot->count)) {
+					slot->keys[slot->count] = key;
+					slot->count++;
+					key = NULL;
+					statistics[LLSEC_KEY_POOL_STAT_GENERATED]++;
+					statistics[LLSEC_KEY_POOL_STAT_READY]++;
+				} else {
+					// The slot has been replaced
+				}
+				(void)OSAL_mutex_give(&pool_mutex);
+
+				if (NULL != key) {
+					EVP_PKEY_free(key);
+				}
+			}
+		}
+	}
+	return NULL;
+}
+#endif // LLSEC_KEY_POOL_ENABLED == 1
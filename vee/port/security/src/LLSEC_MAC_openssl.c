@@ -21,6 +21,11 @@
 #include <openssl/err.h>
 #include <openssl/opensslv.h>
 #include "LLSEC_MAC_impl.h"
+#include "LLSEC_MAC_openssl.h"
+#include "LLSEC_AFALG_openssl.h"
+#include "LLSEC_CTX_POOL_openssl.h"
+#include "LLSEC_configuration.h"
+#include "LLSEC_openssl.h"
 
 #define MICROEJ_LLSECU_MAC_SUCCESS 1
 #define MICROEJ_LLSECU_MAC_ERROR   0
@@ -54,6 +59,14 @@ static int LLSEC_MAC_openssl_update(void* native_id, const uint8_t* buffer, int3
 static int LLSEC_MAC_openssl_do_final(void* native_id, uint8_t* out, int32_t out_length);
 static int LLSEC_MAC_openssl_reset(void* native_id);
 static void LLSEC_MAC_openssl_close(void* native_id);
+#if LLSEC_AFALG_ENABLED
+static int LLSEC_MAC_afalg_HmacSha256_init(void** native_id, const uint8_t* key, int32_t key_length);
+static int LLSEC_MAC_afalg_init(void** native_id, const char* algorithm_name, const uint8_t* key, int32_t key_length);
+static int LLSEC_MAC_afalg_update(void* native_id, const uint8_t* buffer, int32_t buffer_length);
+static int LLSEC_MAC_afalg_do_final(void* native_id, uint8_t* out, int32_t out_length);
+static int LLSEC_MAC_afalg_reset(void* native_id);
+static void LLSEC_MAC_afalg_close(void* native_id);
+#endif
 
 // cppcheck-suppress misra-c2012-8.9 // Define here for code readability even if it called once in this file
 static LLSEC_MAC_algorithm available_algorithms[1] = {
@@ -70,38 +83,37 @@ static LLSEC_MAC_algorithm available_algorithms[1] = {
 	}
 };
 
+#if LLSEC_AFALG_ENABLED
+// Same algorithms on the kernel crypto API, see LLSEC_AFALG_openssl.h
+// cppcheck-suppress misra-c2012-8.9 // Define here for code readability even if it called once in this file
+static LLSEC_MAC_algorithm afalg_algorithms[1] = {
+	{
+		.name = "HmacSHA256",
+		.init = LLSEC_MAC_afalg_HmacSha256_init,
+		.update = LLSEC_MAC_afalg_update,
+		.do_final = LLSEC_MAC_afalg_do_final,
+		.reset = LLSEC_MAC_afalg_reset,
+		.close = LLSEC_MAC_afalg_close,
+		{
+			.mac_length = 32
+		}
+	}
+};
+#endif
+
 static int LLSEC_MAC_openssl_HmacSha256_init(void** native_id, const uint8_t* key, int32_t key_length) {
 	LLSECU_MAC_DEBUG_PRINTF("%s \n", __func__);
-#if (OPENSSL_VERSION_NUMBER < 0x30000000L)
-	HMAC_CTX* ctx = NULL;
-#else
-	EVP_MAC_CTX* ctx = NULL;
-#endif
 	int return_code = MICROEJ_LLSECU_MAC_SUCCESS;
 
-#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
-	ctx = (HMAC_CTX*)OPENSSL_malloc(sizeof(HMAC_CTX));
-#elif (OPENSSL_VERSION_NUMBER < 0x30000000L)
-	ctx = HMAC_CTX_new();
-#else
-	EVP_MAC* mac = EVP_MAC_fetch(NULL, "HMAC", NULL);
-	if (NULL != mac) {
-		ctx = EVP_MAC_CTX_new(mac);
-		EVP_MAC_free(mac);
-	}
-#endif
-
+	// The context comes from the pool, initialized
+	LLSEC_mac_ctx* ctx = LLSEC_CTX_POOL_take_mac_ctx();
 	if (NULL == ctx) {
 		return_code = MICROEJ_LLSECU_MAC_ERROR;
 	}
 
 	if (MICROEJ_LLSECU_MAC_SUCCESS == return_code) {
-#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
-		HMAC_CTX_init(ctx);
-#endif
-
 #if (OPENSSL_VERSION_NUMBER < 0x30000000L)
-		return_code = HMAC_Init_ex(ctx, key, key_length, EVP_sha256(), NULL);
+		return_code = HMAC_Init_ex(ctx, key, key_length, LLSEC_CTX_POOL_get_md(LLSEC_MD_SHA256), NULL);
 #else
 		OSSL_PARAM params[2];
 		// https://github.com/openssl/openssl/issues/20956
@@ -114,14 +126,7 @@ static int LLSEC_MAC_openssl_HmacSha256_init(void** native_id, const uint8_t* ke
 	}
 
 	if (MICROEJ_LLSECU_MAC_SUCCESS != return_code) {
-#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
-		HMAC_CTX_cleanup(ctx);
-		OPENSSL_free((void*)ctx);
-#elif (OPENSSL_VERSION_NUMBER < 0x30000000L)
-		HMAC_CTX_free(ctx);
-#else
-		EVP_MAC_CTX_free(ctx);
-#endif
+		LLSEC_CTX_POOL_give_mac_ctx(ctx);
 	} else {
 		//set the context as native id
 		(*native_id) = (void*)ctx;
@@ -164,38 +169,89 @@ static int LLSEC_MAC_openssl_do_final(void* native_id, uint8_t* out, int32_t out
 static int LLSEC_MAC_openssl_reset(void* native_id) {
 	LLSECU_MAC_DEBUG_PRINTF("%s \n", __func__);
 
+	// Restart with the same key and digest, the context stays usable
+#if (OPENSSL_VERSION_NUMBER < 0x30000000L)
 	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
 	HMAC_CTX* ctx = (HMAC_CTX*)(native_id);
-#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
-	HMAC_CTX_cleanup(ctx); //HMAC_CTX_cleanup() cleans the ctx and set its memory to 0
-#elif (OPENSSL_VERSION_NUMBER < 0x30000000L)
-	HMAC_CTX_reset(ctx);
+	int rc = HMAC_Init_ex(ctx, NULL, 0, NULL, NULL);
 #else
-	// not implemented
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
+	EVP_MAC_CTX* ctx = (EVP_MAC_CTX*)(native_id);
+	int rc = EVP_MAC_init(ctx, NULL, 0, NULL);
 #endif
-	return MICROEJ_LLSECU_MAC_SUCCESS;
+	return rc;
 }
 
 static void LLSEC_MAC_openssl_close(void* native_id) {
 	LLSECU_MAC_DEBUG_PRINTF("%s \n", __func__);
 
-#if (OPENSSL_VERSION_NUMBER < 0x30000000L)
 	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
-	HMAC_CTX* ctx = (HMAC_CTX*)(native_id);
-#else
+	LLSEC_mac_ctx* ctx = (LLSEC_mac_ctx*)(native_id);
+	// The key is cleared and the context kept for reuse
+	LLSEC_CTX_POOL_give_mac_ctx(ctx);
+}
+
+#if LLSEC_AFALG_ENABLED
+static int LLSEC_MAC_afalg_HmacSha256_init(void** native_id, const uint8_t* key, int32_t key_length) {
+	return LLSEC_MAC_afalg_init(native_id, "HmacSHA256", key, key_length);
+}
+
+static int LLSEC_MAC_afalg_init(void** native_id, const char* algorithm_name, const uint8_t* key, int32_t key_length) {
+	LLSECU_MAC_DEBUG_PRINTF("%s \n", __func__);
+	int return_code = MICROEJ_LLSECU_MAC_SUCCESS;
+
+	LLSEC_afalg_ctx* ctx = (LLSEC_afalg_ctx*)LLSEC_calloc(1, sizeof(LLSEC_afalg_ctx));
+	if (NULL == ctx) {
+		return_code = MICROEJ_LLSECU_MAC_ERROR;
+	}
+
+	// The key is kept by the kernel
+	if ((MICROEJ_LLSECU_MAC_SUCCESS == return_code) && !LLSEC_AFALG_open(ctx, algorithm_name, key, key_length)) {
+		LLSEC_free(ctx);
+		return_code = MICROEJ_LLSECU_MAC_ERROR;
+	}
+
+	if (MICROEJ_LLSECU_MAC_SUCCESS == return_code) {
+		(*native_id) = (void*)ctx;
+	}
+	return return_code;
+}
+
+static int LLSEC_MAC_afalg_update(void* native_id, const uint8_t* buffer, int32_t buffer_length) {
+	LLSECU_MAC_DEBUG_PRINTF("%s \n", __func__);
+
 	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
-	EVP_MAC_CTX* ctx = (EVP_MAC_CTX*)(native_id);
-#endif
-#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
-	HMAC_CTX_cleanup(ctx);
-	OPENSSL_free(ctx);
-#elif (OPENSSL_VERSION_NUMBER < 0x30000000L)
-	HMAC_CTX_free(ctx);
-#else
-	EVP_MAC_CTX_free(ctx);
-#endif
+	LLSEC_afalg_ctx* ctx = (LLSEC_afalg_ctx*)(native_id);
+	return LLSEC_AFALG_hash_update(ctx, buffer, buffer_length, true) ? MICROEJ_LLSECU_MAC_SUCCESS : MICROEJ_LLSECU_MAC_ERROR;
+}
+
+static int LLSEC_MAC_afalg_do_final(void* native_id, uint8_t* out, int32_t out_length) {
+	LLSECU_MAC_DEBUG_PRINTF("%s \n", __func__);
+
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
+	LLSEC_afalg_ctx* ctx = (LLSEC_afalg_ctx*)(native_id);
+	// The kernel restarts with the same key
+	return (0 <= LLSEC_AFALG_hash_final(ctx, out, out_length)) ? MICROEJ_LLSECU_MAC_SUCCESS : MICROEJ_LLSECU_MAC_ERROR;
+}
+
+static int LLSEC_MAC_afalg_reset(void* native_id) {
+	LLSECU_MAC_DEBUG_PRINTF("%s \n", __func__);
+
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
+	LLSEC_afalg_ctx* ctx = (LLSEC_afalg_ctx*)(native_id);
+	return LLSEC_AFALG_hash_reset(ctx) ? MICROEJ_LLSECU_MAC_SUCCESS : MICROEJ_LLSECU_MAC_ERROR;
 }
 
+static void LLSEC_MAC_afalg_close(void* native_id) {
+	LLSECU_MAC_DEBUG_PRINTF("%s \n", __func__);
+
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
+	LLSEC_afalg_ctx* ctx = (LLSEC_afalg_ctx*)(native_id);
+	LLSEC_AFALG_close(ctx);
+	LLSEC_free(ctx);
+}
+#endif
+
 // cppcheck-suppress constParameterPointer // SNI type conflict
 int32_t LLSEC_MAC_IMPL_get_algorithm_description(uint8_t* algorithm_name, LLSEC_MAC_algorithm_desc* algorithm_desc) {
 	LLSECU_MAC_DEBUG_PRINTF("%s \n", __func__);
@@ -213,6 +269,13 @@ int32_t LLSEC_MAC_IMPL_get_algorithm_description(uint8_t* algorithm_name, LLSEC_
 		algorithm++;
 	}
 
+#if LLSEC_AFALG_ENABLED
+	// The tables have the same order, the kernel replaces OpenSSL when selected and available
+	if ((nb_algorithms >= 0) && LLSEC_AFALG_is_enabled(algorithm->name)) {
+		algorithm = &afalg_algorithms[algorithm - &available_algorithms[0]];
+	}
+#endif
+
 	if (nb_algorithms >= 0) {
 		// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
 		return_code = (int32_t)algorithm;
@@ -323,3 +386,60 @@ int32_t LLSEC_MAC_IMPL_get_close_id(int32_t algorithm_id) {
 	// cppcheck-suppress misra-c2012-11.1 // Abstract data type for SNI usage
 	return (int32_t) algorithm->close;
 }
+
+int32_t LLSEC_MAC_IMPL_mac_once(int32_t algorithm_id, uint8_t* key, int32_t key_length,
+                                uint8_t* buffer, int32_t buffer_offset, int32_t buffer_length,
+                                uint8_t* out, int32_t out_offset, int32_t out_length) {
+	LLSECU_MAC_DEBUG_PRINTF("%s \n", __func__);
+	return LLSEC_MAC_IMPL_mac_many(algorithm_id, key, key_length, buffer, buffer_offset, buffer_length, &buffer_length, 1,
+	                               out, out_offset, out_length);
+}
+
+int32_t LLSEC_MAC_IMPL_mac_many(int32_t algorithm_id, uint8_t* key, int32_t key_length,
+                                uint8_t* buffer, int32_t buffer_offset, int32_t buffer_length, int32_t* lengths, int32_t count,
+                                uint8_t* out, int32_t out_offset, int32_t out_length) {
+	LLSECU_MAC_DEBUG_PRINTF("%s count=%d\n", __func__, (int)count);
+	int32_t return_code = MICROEJ_LLSECU_MAC_SUCCESS;
+	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
+	const LLSEC_MAC_algorithm* algorithm = (LLSEC_MAC_algorithm*)algorithm_id;
+	int32_t mac_length = algorithm->description.mac_length;
+	void* native_id = NULL;
+
+	if (!OPENSSL_SECURITY_check_messages(buffer_length, lengths, count, out_length, mac_length)) {
+		(void)SNI_throwNativeException(SNI_ERROR, "Invalid message lengths or MAC buffer too small");
+		return_code = SNI_ERROR;
+	}
+
+	// The context is not registered as a SNI resource, it is closed before returning
+	if ((MICROEJ_LLSECU_MAC_SUCCESS == return_code) && (MICROEJ_LLSECU_MAC_SUCCESS != algorithm->init(&native_id, key, key_length))) {
+		native_id = NULL;
+		return_code = MICROEJ_LLSECU_MAC_ERROR;
+	}
+
+	const uint8_t* message = &buffer[buffer_offset];
+	uint8_t* mac = &out[out_offset];
+	for (int32_t i = 0; (MICROEJ_LLSECU_MAC_SUCCESS == return_code) && (i < count); i++) {
+		if ((MICROEJ_LLSECU_MAC_SUCCESS != algorithm->update(native_id, message, lengths[i])) ||
+		    (MICROEJ_LLSECU_MAC_SUCCESS != algorithm->do_final(native_id, mac, mac_length)) ||
+		    (MICROEJ_LLSECU_MAC_SUCCESS != algorithm->reset(native_id))) {
+			return_code = MICROEJ_LLSECU_MAC_ERROR;
+		}
+		message = &message[lengths[i]];
+		mac = &mac[mac_length];
+	}
+
+	if (NULL != native_id) {
+		algorithm->close(native_id);
+	}
+
+	if (MICROEJ_LLSECU_MAC_SUCCESS == return_code) {
+		return_code = count * mac_length;
+	} else if (MICROEJ_LLSECU_MAC_ERROR == return_code) {
+		int err = ERR_get_error();
+		(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
+		return_code = SNI_ERROR;
+	} else {
+		// SNI_ERROR, exception already thrown
+	}
+	return return_code;
+}
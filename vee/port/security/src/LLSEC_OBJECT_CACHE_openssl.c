@@ -0,0 +1,223 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ *
+ */
+
+/**
+ * @file
+ * @brief MicroEJ Security low level API: cache of decoded certificates and keys.
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <openssl/crypto.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/opensslv.h>
+#include <openssl/x509.h>
+#include "LLSEC_configuration.h"
+#include "LLSEC_OBJECT_CACHE_openssl.h"
+
+// #define LLSEC_OBJECT_CACHE_DEBUG_TRACE
+
+#ifdef LLSEC_OBJECT_CACHE_DEBUG_TRACE
+#define LLSEC_OBJECT_CACHE_DEBUG_PRINTF(...) (void)printf(__VA_ARGS__)
+#else
+#define LLSEC_OBJECT_CACHE_DEBUG_PRINTF(...) ((void)0)
+#endif
+
+#if LLSEC_OBJECT_CACHE_SIZE > 0
+typedef struct {
+	LLSEC_object_cache_key key;
+	// X509* for LLSEC_OBJECT_CACHE_X509, EVP_PKEY* otherwise, NULL if the entry is free
+	void* object;
+	// Certificate format (CERT_DER_FORMAT or CERT_PEM_FORMAT)
+	int format;
+	// Value of use_counter at the last use, the entry with the lowest value is evicted first
+	uint32_t last_use;
+} LLSEC_OBJECT_CACHE_entry;
+
+static LLSEC_OBJECT_CACHE_entry entries[LLSEC_OBJECT_CACHE_SIZE];
+static uint32_t use_counter = 0;
+
+static LLSEC_OBJECT_CACHE_entry* LLSEC_OBJECT_CACHE_find(const LLSEC_object_cache_key* key);
+static void LLSEC_OBJECT_CACHE_put(const LLSEC_object_cache_key* key, void* object, int format);
+static void LLSEC_OBJECT_CACHE_up_ref(LLSEC_object_cache_kind kind, void* object);
+static void LLSEC_OBJECT_CACHE_free(LLSEC_object_cache_kind kind, void* object);
+#endif
+
+bool LLSEC_OBJECT_CACHE_make_key(LLSEC_object_cache_key* key, LLSEC_object_cache_kind kind, const uint8_t* data, int32_t length) {
+	bool ok = false;
+#if LLSEC_OBJECT_CACHE_SIZE > 0
+#if LLSEC_OBJECT_CACHE_PRIVATE_KEYS == 0
+	bool cacheable = (LLSEC_OBJECT_CACHE_X509 == kind) || (LLSEC_OBJECT_CACHE_PUBLIC_KEY == kind);
+#else
+	bool cacheable = true;
+#endif
+	if (cacheable && (0 < length)) {
+		unsigned int hash_length = 0;
+		(void)memset(key, 0, sizeof(LLSEC_object_cache_key));
+		key->kind = kind;
+		key->length = length;
+		if ((1 == EVP_Digest(data, (size_t)length, key->hash, &hash_length, EVP_sha256(), NULL)) &&
+		    (sizeof(key->hash) == hash_length)) {
+			ok = true;
+		} else {
+			// Decode without the cache
+			ERR_clear_error();
+		}
+	}
+#else
+	(void)key;
+	(void)kind;
+	(void)data;
+	(void)length;
+#endif
+	return ok;
+}
+
+X509* LLSEC_OBJECT_CACHE_get_x509(const LLSEC_object_cache_key* key, int* format) {
+	X509* x509 = NULL;
+#if LLSEC_OBJECT_CACHE_SIZE > 0
+	LLSEC_OBJECT_CACHE_entry* entry = LLSEC_OBJECT_CACHE_find(key);
+	if (NULL != entry) {
+		x509 = (X509*)entry->object;
+		LLSEC_OBJECT_CACHE_up_ref(LLSEC_OBJECT_CACHE_X509, x509);
+		if (NULL != format) {
+			*format = entry->format;
+		}
+	}
+#else
+	(void)key;
+	(void)format;
+#endif
+	return x509;
+}
+
+void LLSEC_OBJECT_CACHE_put_x509(const LLSEC_object_cache_key* key, X509* x509, int format) {
+#if LLSEC_OBJECT_CACHE_SIZE > 0
+	LLSEC_OBJECT_CACHE_put(key, x509, format);
+#else
+	(void)key;
+	(void)x509;
+	(void)format;
+#endif
+}
+
+EVP_PKEY* LLSEC_OBJECT_CACHE_get_pkey(const LLSEC_object_cache_key* key) {
+	EVP_PKEY* pkey = NULL;
+#if LLSEC_OBJECT_CACHE_SIZE > 0
+	const LLSEC_OBJECT_CACHE_entry* entry = LLSEC_OBJECT_CACHE_find(key);
+	if (NULL != entry) {
+		pkey = (EVP_PKEY*)entry->object;
+		LLSEC_OBJECT_CACHE_up_ref(key->kind, pkey);
+	}
+#else
+	(void)key;
+#endif
+	return pkey;
+}
+
+void LLSEC_OBJECT_CACHE_put_pkey(const LLSEC_object_cache_key* key, EVP_PKEY* pkey) {
+#if LLSEC_OBJECT_CACHE_SIZE > 0
+	LLSEC_OBJECT_CACHE_put(key, pkey, 0);
+#else
+	(void)key;
+	(void)pkey;
+#endif
+}
+
+#if LLSEC_OBJECT_CACHE_SIZE > 0
+/**
+ * @brief Finds the entry of a key and marks it as the most recently used one.
+ *
+ * @param[in] key the entry identifier.
+ *
+ * @return the entry, NULL if not cached.
+ */
+static LLSEC_OBJECT_CACHE_entry* LLSEC_OBJECT_CACHE_find(const LLSEC_object_cache_key* key) {
+	LLSEC_OBJECT_CACHE_entry* found = NULL;
+	for (int32_t i = 0; (NULL == found) && (i < LLSEC_OBJECT_CACHE_SIZE); i++) {
+		LLSEC_OBJECT_CACHE_entry* entry = &entries[i];
+		if ((NULL != entry->object) && (entry->key.kind == key->kind) && (entry->key.length == key->length) &&
+		    (0 == memcmp(entry->key.hash, key->hash, sizeof(key->hash)))) {
+			use_counter++;
+			entry->last_use = use_counter;
+			found = entry;
+		}
+	}
+	LLSEC_OBJECT_CACHE_DEBUG_PRINTF("%s kind=%d length=%d %s\n", __func__, (int)key->kind, (int)key->length,
+	                                (NULL != found) ? "hit" : "miss");
+	return found;
+}
+
+/**
+ * @brief Adds an object to the cache, replacing a free entry or the least recently used one.
+ *
+ * @param[in] key the entry identifier.
+ * @param[in] object the decoded object, the cache takes its own reference.
+ * @param[in] format the certificate format.
+ */
+static void LLSEC_OBJECT_CACHE_put(const LLSEC_object_cache_key* key, void* object, int format) {
+	LLSEC_OBJECT_CACHE_entry* entry = &entries[0];
+	for (int32_t i = 1; (NULL != entry->object) && (i < LLSEC_OBJECT_CACHE_SIZE); i++) {
+		if ((NULL == entries[i].object) || (entries[i].last_use < entry->last_use)) {
+			entry = &entries[i];
+		}
+	}
+	if (NULL != entry->object) {
+		LLSEC_OBJECT_CACHE_DEBUG_PRINTF("%s evict kind=%d length=%d\n", __func__, (int)entry->key.kind, (int)entry->key.length);
+		LLSEC_OBJECT_CACHE_free(entry->key.kind, entry->object);
+	}
+	LLSEC_OBJECT_CACHE_up_ref(key->kind, object);
+	entry->key = *key;
+	entry->object = object;
+	entry->format = format;
+	use_counter++;
+	entry->last_use = use_counter;
+}
+
+/**
+ * @brief Takes a new reference to a cached object.
+ *
+ * @param[in] kind the object kind.
+ * @param[in] object the X509 or EVP_PKEY object.
+ */
+static void LLSEC_OBJECT_CACHE_up_ref(LLSEC_object_cache_kind kind, void* object) {
+	if (LLSEC_OBJECT_CACHE_X509 == kind) {
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+		(void)CRYPTO_add(&((X509*)object)->references, 1, CRYPTO_LOCK_X509);
+#else
+		(void)X509_up_ref((X509*)object);
+#endif
+	} else {
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+		(void)CRYPTO_add(&((EVP_PKEY*)object)->references, 1, CRYPTO_LOCK_EVP_PKEY);
+#else
+		(void)EVP_PKEY_up_ref((EVP_PKEY*)object);
+#endif
+	}
+}
+
+/**
+ * @brief Releases a reference to a cached object.
+ *
+ * @param[in] kind the object kind.
+ * @param[in] object the X509 or EVP_PKEY object.
+ */
+static void LLSEC_OBJECT_CACHE_free(LLSEC_object_cache_kind kind, void* object) {
+	if (LLSEC_OBJECT_CACHE_X509 == kind) {
+		X509_free((X509*)object);
+	} else {
+		EVP_PKEY_free((EVP_PKEY*)object);
+	}
+}
+#endif // LLSEC_OBJECT_CACHE_SIZE > 0
@@ -27,6 +27,7 @@
 #include "sni.h"
 #include "LLSEC_RSA_CIPHER_impl.h"
 #include "LLSEC_openssl.h"
+#include "LLSEC_WORKER_openssl.h"
 
 #define MICROEJ_LLSECU_CIPHER_SUCCESS 1
 #define MICROEJ_LLSECU_CIPHER_ERROR   0
@@ -57,9 +58,14 @@ typedef struct {
 } LLSEC_RSA_CIPHER_transformation;
 
 static int LLSEC_CIPHER_rsa_init(void** native_id, uint8_t is_decrypting, int32_t key_id, int32_t padding_type, int32_t oaep_hash_algorithm);
+static int openssl_rsa_cipher_setup(EVP_PKEY_CTX* ctx, uint8_t is_decrypting, int32_t padding_type, int32_t oaep_hash_algorithm);
 static int openssl_rsa_cipher_decrypt(void* native_id, const uint8_t* buffer, int32_t buffer_length, uint8_t* output, int32_t* output_length);
 static int openssl_rsa_cipher_encrypt(void* native_id, const uint8_t* buffer, int32_t buffer_length, uint8_t* output, int32_t* output_length);
 static void openssl_rsa_cipher_close(void* native_id);
+static void LLSEC_RSA_CIPHER_decrypt_action(MICROEJ_ASYNC_WORKER_job_t* job);
+static int32_t LLSEC_RSA_CIPHER_decrypt_on_done(int32_t transformation_id, int32_t native_id, uint8_t *buffer,
+                                                int32_t buffer_offset, int32_t buffer_length, uint8_t *output,
+                                                int32_t output_offset);
 
 // cppcheck-suppress misra-c2012-8.9 // Define here for code readability even if it called once in this file
 static LLSEC_RSA_CIPHER_transformation available_transformations[3] =
@@ -118,26 +124,38 @@ static int LLSEC_CIPHER_rsa_init(void** native_id, uint8_t is_decrypting, int32_
 	}
 
 	if (MICROEJ_LLSECU_CIPHER_SUCCESS == return_code) {
-		if ((uint8_t) 1 == is_decrypting) {
-			if (EVP_PKEY_decrypt_init(ctx) <= 0) {
-				err = ERR_get_error();
-				LLSEC_RSA_CIPHER_DEBUG_PRINTF("%s EVP_PKEY_decrypt_init failed: %s\n", __func__, ERR_error_string(err, NULL));
-				return_code = MICROEJ_LLSECU_CIPHER_ERROR;
-			}
-		} else {
-			if (EVP_PKEY_encrypt_init(ctx) <= 0) {
-				err = ERR_get_error();
-				LLSEC_RSA_CIPHER_DEBUG_PRINTF("%s EVP_PKEY_encrypt_init failed: %s\n", __func__, ERR_error_string(err, NULL));
-				return_code = MICROEJ_LLSECU_CIPHER_ERROR;
-			}
+		return_code = openssl_rsa_cipher_setup(ctx, is_decrypting, padding_type, oaep_hash_algorithm);
+	}
+
+	*native_id = (void*)ctx;
+
+	return return_code;
+}
+
+/**
+ * @brief Initializes a context for an encryption or a decryption with the given padding.
+ *
+ * @return MICROEJ_LLSECU_CIPHER_SUCCESS on success, MICROEJ_LLSECU_CIPHER_ERROR with the OpenSSL error queued on error.
+ */
+static int openssl_rsa_cipher_setup(EVP_PKEY_CTX* ctx, uint8_t is_decrypting, int32_t padding_type, int32_t oaep_hash_algorithm) {
+	int32_t return_code = MICROEJ_LLSECU_CIPHER_SUCCESS;
+
+	if ((uint8_t) 1 == is_decrypting) {
+		if (EVP_PKEY_decrypt_init(ctx) <= 0) {
+			LLSEC_RSA_CIPHER_DEBUG_PRINTF("%s EVP_PKEY_decrypt_init failed: %s\n", __func__, ERR_error_string(ERR_peek_error(), NULL));
+			return_code = MICROEJ_LLSECU_CIPHER_ERROR;
+		}
+	} else {
+		if (EVP_PKEY_encrypt_init(ctx) <= 0) {
+			LLSEC_RSA_CIPHER_DEBUG_PRINTF("%s EVP_PKEY_encrypt_init failed: %s\n", __func__, ERR_error_string(ERR_peek_error(), NULL));
+			return_code = MICROEJ_LLSECU_CIPHER_ERROR;
 		}
 	}
 
 	int32_t padding = (padding_type == (int32_t)PAD_PKCS1_TYPE) ? RSA_PKCS1_PADDING : RSA_PKCS1_OAEP_PADDING;
 	if (MICROEJ_LLSECU_CIPHER_SUCCESS == return_code) {
 		if (EVP_PKEY_CTX_set_rsa_padding(ctx, padding) <=0) {
-			err = ERR_get_error();
-			LLSEC_RSA_CIPHER_DEBUG_PRINTF("%s EVP_PKEY_CTX_set_rsa_padding failed: %s\n", __func__, ERR_error_string(err, NULL));
+			LLSEC_RSA_CIPHER_DEBUG_PRINTF("%s EVP_PKEY_CTX_set_rsa_padding failed: %s\n", __func__, ERR_error_string(ERR_peek_error(), NULL));
 			return_code = MICROEJ_LLSECU_CIPHER_ERROR;
 		}
 	}
@@ -146,20 +164,15 @@ static int LLSEC_CIPHER_rsa_init(void** native_id, uint8_t is_decrypting, int32_
 		if (padding_type == (int32_t)PAD_OAEP_MGF1_TYPE) {
 			const EVP_MD *md = (oaep_hash_algorithm == (int32_t)OAEP_HASH_SHA_1_ALGORITHM) ? EVP_sha1() : EVP_sha256();
 			if (EVP_PKEY_CTX_set_rsa_oaep_md(ctx, md) <= 0) {
-				err = ERR_get_error();
-				LLSEC_RSA_CIPHER_DEBUG_PRINTF("%s EVP_PKEY_CTX_set_rsa_oaep_md failed: %s\n", __func__, ERR_error_string(err, NULL));
+				LLSEC_RSA_CIPHER_DEBUG_PRINTF("%s EVP_PKEY_CTX_set_rsa_oaep_md failed: %s\n", __func__, ERR_error_string(ERR_peek_error(), NULL));
 				return_code = MICROEJ_LLSECU_CIPHER_ERROR;
 			}
 			if (EVP_PKEY_CTX_set_rsa_mgf1_md(ctx, md) <= 0) {
-				err = ERR_get_error();
-				LLSEC_RSA_CIPHER_DEBUG_PRINTF("%s EVP_PKEY_CTX_set_rsa_mgf1_md failed: %s\n", __func__, ERR_error_string(err, NULL));
+				LLSEC_RSA_CIPHER_DEBUG_PRINTF("%s EVP_PKEY_CTX_set_rsa_mgf1_md failed: %s\n", __func__, ERR_error_string(ERR_peek_error(), NULL));
 				return_code = MICROEJ_LLSECU_CIPHER_ERROR;
 			}
 		}
 	}
-
-	*native_id = (void*)ctx;
-
 	return return_code;
 }
 
@@ -338,16 +351,92 @@ int32_t LLSEC_RSA_CIPHER_IMPL_decrypt(int32_t transformation_id, int32_t native_
 	LLSEC_RSA_CIPHER_DEBUG_PRINTF("%s\n", __func__);
 	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
 	LLSEC_RSA_CIPHER_transformation* transformation = (LLSEC_RSA_CIPHER_transformation*)transformation_id;
-	size_t output_len = 0;
+	int32_t return_code = SNI_ERROR;
 	// cppcheck-suppress misra-c2012-11.6 // Abstract data type for SNI usage
-	int32_t return_code = transformation->decrypt((void*)native_id, &buffer[buffer_offset], buffer_length, &output[output_offset], &output_len);
-	if (MICROEJ_LLSECU_CIPHER_SUCCESS == return_code) {
-		return_code = output_len;
+	EVP_PKEY* key = EVP_PKEY_CTX_get0_pkey((EVP_PKEY_CTX*)native_id);
+
+	if ((LLSEC_WORKER_BUFFER_SIZE >= buffer_length) && (LLSEC_WORKER_BUFFER_SIZE >= EVP_PKEY_size(key)) &&
+	    LLSEC_WORKER_is_expensive_pkey(key, true)) {
+		// The private key operation runs on a crypto worker, the Java thread is suspended until
+		// LLSEC_RSA_CIPHER_decrypt_on_done(). The job references the key and not the cipher context, which may be
+		// closed before the job is done
+		// cppcheck-suppress misra-c2012-11.1 // SNI callback
+		MICROEJ_ASYNC_WORKER_job_t* job = LLSEC_WORKER_allocate_job((SNI_callback)LLSEC_RSA_CIPHER_IMPL_decrypt);
+		if (NULL != job) {
+			// cppcheck-suppress misra-c2012-11.5 // Abstract data type for async worker usage
+			LLSEC_WORKER_job* params = (LLSEC_WORKER_job*)job->params;
+			LLSEC_WORKER_rsa_cipher* operation = &params->operation.rsa_cipher;
+			operation->transformation_id = transformation_id;
+			LLSEC_WORKER_hold_key(params, key);
+			(void)memcpy(operation->input, &buffer[buffer_offset], buffer_length);
+			operation->input_length = buffer_length;
+			LLSEC_WORKER_exec(job, LLSEC_RSA_CIPHER_decrypt_action, (SNI_callback)LLSEC_RSA_CIPHER_decrypt_on_done);
+		} // else the Java thread waits for a job, or an exception is pending
+		return_code = SNI_IGNORED_RETURNED_VALUE;
 	} else {
-		int err = ERR_get_error();
-		(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
-		return_code = SNI_ERROR;
+		size_t output_len = 0;
+		// cppcheck-suppress misra-c2012-11.6 // Abstract data type for SNI usage
+		return_code = transformation->decrypt((void*)native_id, &buffer[buffer_offset], buffer_length, &output[output_offset], &output_len);
+		if (MICROEJ_LLSECU_CIPHER_SUCCESS == return_code) {
+			return_code = output_len;
+		} else {
+			int err = ERR_get_error();
+			(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
+			return_code = SNI_ERROR;
+		}
+	}
+	return return_code;
+}
+
+/**
+ * @brief Decrypts a block with the private key, in a crypto worker.
+ */
+static void LLSEC_RSA_CIPHER_decrypt_action(MICROEJ_ASYNC_WORKER_job_t* job) {
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for async worker usage
+	LLSEC_WORKER_job* params = (LLSEC_WORKER_job*)job->params;
+	LLSEC_WORKER_rsa_cipher* operation = &params->operation.rsa_cipher;
+	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
+	LLSEC_RSA_CIPHER_transformation* transformation = (LLSEC_RSA_CIPHER_transformation*)operation->transformation_id;
+
+	// A new context: the padding would stay in a context of the pool, which the signatures share
+	EVP_PKEY_CTX* ctx = EVP_PKEY_CTX_new(params->key, NULL);
+	params->result = MICROEJ_LLSECU_CIPHER_ERROR;
+	if ((NULL != ctx) && (MICROEJ_LLSECU_CIPHER_SUCCESS ==
+	                      openssl_rsa_cipher_setup(ctx, 1, transformation->description.padding_type,
+	                                               transformation->description.oaep_hash_algorithm))) {
+		params->result = transformation->decrypt((void*)ctx, operation->input, operation->input_length,
+		                                         operation->output, &operation->output_length);
+	}
+	if (MICROEJ_LLSECU_CIPHER_SUCCESS != params->result) {
+		LLSEC_WORKER_save_error(params);
+	}
+	EVP_PKEY_CTX_free(ctx);
+}
+
+/**
+ * @brief Copies the block decrypted in a crypto worker to the Java array, on the VM task.
+ */
+static int32_t LLSEC_RSA_CIPHER_decrypt_on_done(int32_t transformation_id, int32_t native_id, uint8_t *buffer,
+                                                int32_t buffer_offset, int32_t buffer_length, uint8_t *output,
+                                                int32_t output_offset) {
+	(void)transformation_id;
+	(void)native_id;
+	(void)buffer;
+	(void)buffer_offset;
+	(void)buffer_length;
+	int32_t return_code = SNI_ERROR;
+
+	MICROEJ_ASYNC_WORKER_job_t* job = LLSEC_WORKER_get_job_done();
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for async worker usage
+	LLSEC_WORKER_job* params = (LLSEC_WORKER_job*)job->params;
+	const LLSEC_WORKER_rsa_cipher* operation = &params->operation.rsa_cipher;
+	if (MICROEJ_LLSECU_CIPHER_SUCCESS == params->result) {
+		(void)memcpy(&output[output_offset], operation->output, operation->output_length);
+		return_code = operation->output_length;
+	} else {
+		LLSEC_WORKER_throw_error(params);
 	}
+	LLSEC_WORKER_free_job(job);
 	return return_code;
 }
 
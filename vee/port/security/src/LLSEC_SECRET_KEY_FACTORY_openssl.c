@@ -23,6 +23,8 @@
 #include "LLSEC_SECRET_KEY_FACTORY_impl.h"
 #include "LLSEC_configuration.h"
 #include "LLSEC_openssl.h"
+#include "LLSEC_CTX_POOL_openssl.h"
+#include "LLSEC_WORKER_openssl.h"
 
 #define MICROEJ_LLSECU_SECRET_KEY_FACTORY_SUCCESS 1
 #define MICROEJ_LLSECU_SECRET_KEY_FACTORY_ERROR 0
@@ -41,6 +43,10 @@ typedef void    (*LLSEC_SECRET_KEY_FACTORY_key_close)(void* native_id);
 int32_t     LLSEC_SECRET_KEY_FACTORY_PBKDF2_openssl_get_key_data(LLSEC_secret_key* secret_key, LLSEC_md_type md_type, uint8_t* password, int32_t password_length, uint8_t* salt, int32_t salt_length, int32_t iterations, int32_t key_length);
 static void LLSEC_SECRET_KEY_FACTORY_PBKDF2_openssl_key_close(void* native_id);
 void        LLSEC_SECRET_KEY_FACTORY_openssl_free_secret_key(LLSEC_secret_key* secret_key);
+static int32_t LLSEC_SECRET_KEY_FACTORY_PBKDF2_openssl_derive(uint8_t* key, LLSEC_md_type md_type, const uint8_t* password, int32_t password_length, const uint8_t* salt, int32_t salt_length, int32_t iterations, int32_t key_length);
+static int32_t LLSEC_SECRET_KEY_FACTORY_openssl_register(LLSEC_secret_key* secret_key);
+static void    LLSEC_SECRET_KEY_FACTORY_get_key_data_action(MICROEJ_ASYNC_WORKER_job_t* job);
+static int32_t LLSEC_SECRET_KEY_FACTORY_get_key_data_on_done(int32_t algorithm_id, uint8_t *password, int32_t password_length, uint8_t *salt, int32_t salt_length, int32_t iterations, int32_t key_length);
 
 typedef struct {
 	const char*                           name;
@@ -97,7 +103,6 @@ int32_t LLSEC_SECRET_KEY_FACTORY_PBKDF2_openssl_get_key_data(LLSEC_secret_key* s
 	LLSEC_SECRET_KEY_FACTORY_DEBUG_PRINTF("%s \n", __func__);
 
 	int32_t return_code = MICROEJ_LLSECU_SECRET_KEY_FACTORY_SUCCESS;
-	const EVP_MD *md = NULL;
 
 	/* Allocate resources */
 	secret_key->key = (unsigned char*)LLSEC_calloc(key_length, sizeof(unsigned char));
@@ -106,64 +111,136 @@ int32_t LLSEC_SECRET_KEY_FACTORY_PBKDF2_openssl_get_key_data(LLSEC_secret_key* s
 		return_code = MICROEJ_LLSECU_SECRET_KEY_FACTORY_ERROR;
 	}
 
-	/* Set MD to be used */
-	switch (md_type) {
-		case LLSEC_MD_SHA1:
-			md = EVP_sha1();
-			break;
-		case LLSEC_MD_SHA224:
-			md = EVP_sha224();
-			break;
-		case LLSEC_MD_SHA256:
-			md = EVP_sha256();
-			break;
-		case LLSEC_MD_SHA384:
-			md = EVP_sha384();
-			break;
-		case LLSEC_MD_SHA512:
-			md = EVP_sha512();
-			break;
-		default:
-			(void)SNI_throwNativeException(SNI_ERROR, "invalid MD");
-			return_code = MICROEJ_LLSECU_SECRET_KEY_FACTORY_ERROR;
-			break;
-	}
-
 	/* PKCS#5 PBKDF2 using HMAC */
 	if (MICROEJ_LLSECU_SECRET_KEY_FACTORY_SUCCESS == return_code) {
 		secret_key->key_length = key_length;
+		return_code = LLSEC_SECRET_KEY_FACTORY_PBKDF2_openssl_derive(secret_key->key, md_type, password, password_length,
+		                                                             salt, salt_length, iterations, key_length);
+		if (MICROEJ_LLSECU_SECRET_KEY_FACTORY_SUCCESS != return_code) {
+			(void)SNI_throwNativeException(SNI_ERROR, "PKCS5_PBKDF2_HMAC() failed");
+		}
+	}
+
+	/* Register SNI close callback and return key struct addr (native_id) */
+	if (MICROEJ_LLSECU_SECRET_KEY_FACTORY_SUCCESS == return_code) {
+		return_code = LLSEC_SECRET_KEY_FACTORY_openssl_register(secret_key);
+	} else {
+		LLSEC_SECRET_KEY_FACTORY_openssl_free_secret_key(secret_key);
+	}
+
+	return return_code;
+}
+
+/**
+ * @brief Derives a key with PKCS#5 PBKDF2 using HMAC. Does not use SNI, so it can run in a crypto worker.
+ *
+ * @return MICROEJ_LLSECU_SECRET_KEY_FACTORY_SUCCESS on success.
+ */
+static int32_t LLSEC_SECRET_KEY_FACTORY_PBKDF2_openssl_derive(uint8_t* key, LLSEC_md_type md_type, const uint8_t* password, int32_t password_length, const uint8_t* salt, int32_t salt_length, int32_t iterations, int32_t key_length) {
+	int32_t return_code = MICROEJ_LLSECU_SECRET_KEY_FACTORY_ERROR;
+
+	/* MD to be used, NULL if invalid */
+	const EVP_MD *md = LLSEC_CTX_POOL_get_md(md_type);
+	if (NULL != md) {
 		int openssl_rc = PKCS5_PBKDF2_HMAC((const char*) password,
 										   (int) password_length,
 										   (const unsigned char *) salt,
 										   (int) salt_length,
 										   (int) iterations,
-										   (const EVP_MD*) md,
-										   (int) secret_key->key_length,
-										   (unsigned char*) secret_key->key);
-		if (1 != openssl_rc) {
+										   md,
+										   (int) key_length,
+										   (unsigned char*) key);
+		if (1 == openssl_rc) {
+			return_code = MICROEJ_LLSECU_SECRET_KEY_FACTORY_SUCCESS;
+		} else {
 			LLSEC_SECRET_KEY_FACTORY_DEBUG_PRINTF("%s PKCS5_PBKDF2_HMAC() failed\n", __func__);
-			(void)SNI_throwNativeException(SNI_ERROR, "PKCS5_PBKDF2_HMAC() failed");
-			return_code = MICROEJ_LLSECU_SECRET_KEY_FACTORY_ERROR;
 		}
 	}
+	return return_code;
+}
 
-	/* Register SNI close callback */
-	if (MICROEJ_LLSECU_SECRET_KEY_FACTORY_SUCCESS == return_code) {
-		if (SNI_OK != SNI_registerResource((void* )secret_key, (SNI_closeFunction)LLSEC_SECRET_KEY_FACTORY_PBKDF2_openssl_key_close, NULL)) {
-			(void)SNI_throwNativeException(SNI_ERROR, "Can't register SNI native resource");
-			return_code = MICROEJ_LLSECU_SECRET_KEY_FACTORY_ERROR;
-		}
-	}
+/**
+ * @brief Registers a derived secret key as an SNI native resource, on the VM task. Frees the key on error.
+ *
+ * @return the native id of the key, MICROEJ_LLSECU_SECRET_KEY_FACTORY_ERROR on error with an exception pending.
+ */
+static int32_t LLSEC_SECRET_KEY_FACTORY_openssl_register(LLSEC_secret_key* secret_key) {
+	int32_t return_code = MICROEJ_LLSECU_SECRET_KEY_FACTORY_ERROR;
 
-	/* Return key struct addr (native_id) */
-	if (MICROEJ_LLSECU_SECRET_KEY_FACTORY_SUCCESS == return_code) {
+	/* Register SNI close callback */
+	if (SNI_OK != SNI_registerResource((void* )secret_key, (SNI_closeFunction)LLSEC_SECRET_KEY_FACTORY_PBKDF2_openssl_key_close, NULL)) {
+		(void)SNI_throwNativeException(SNI_ERROR, "Can't register SNI native resource");
+		LLSEC_SECRET_KEY_FACTORY_openssl_free_secret_key(secret_key);
+	} else {
+		/* Return key struct addr (native_id) */
 		// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
 		return_code = (int32_t)secret_key;
 		LLSEC_SECRET_KEY_FACTORY_DEBUG_PRINTF("%s PKCS5_PBKDF2_HMAC() success. (native_id = %d)\n", __func__, (int)return_code);
-	} else {
-		LLSEC_SECRET_KEY_FACTORY_openssl_free_secret_key(secret_key);
 	}
+	return return_code;
+}
+
+/**
+ * @brief Derives a key, in a crypto worker. All the algorithms are PBKDF2.
+ */
+static void LLSEC_SECRET_KEY_FACTORY_get_key_data_action(MICROEJ_ASYNC_WORKER_job_t* job) {
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for async worker usage
+	LLSEC_WORKER_job* params = (LLSEC_WORKER_job*)job->params;
+	LLSEC_WORKER_pbkdf2* operation = &params->operation.pbkdf2;
+	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
+	const LLSEC_SECRET_KEY_FACTORY_IMPL_algorithm* algorithm = (LLSEC_SECRET_KEY_FACTORY_IMPL_algorithm*)operation->algorithm_id;
+
+	params->result = MICROEJ_LLSECU_SECRET_KEY_FACTORY_ERROR;
+	operation->key = (uint8_t*)LLSEC_calloc(operation->key_length, sizeof(unsigned char));
+	if (NULL != operation->key) {
+		params->result = LLSEC_SECRET_KEY_FACTORY_PBKDF2_openssl_derive(operation->key, algorithm->md_type,
+		                                                                operation->password, operation->password_length,
+		                                                                operation->salt, operation->salt_length,
+		                                                                operation->iterations, operation->key_length);
+	}
+	// The password copy is not needed anymore
+	OPENSSL_cleanse(operation->password, sizeof(operation->password));
+	if (MICROEJ_LLSECU_SECRET_KEY_FACTORY_SUCCESS != params->result) {
+		LLSEC_WORKER_save_error(params);
+		if (NULL != operation->key) {
+			LLSEC_free(operation->key);
+			operation->key = NULL;
+		}
+	}
+}
 
+/**
+ * @brief Registers the key derived in a crypto worker, on the VM task.
+ */
+static int32_t LLSEC_SECRET_KEY_FACTORY_get_key_data_on_done(int32_t algorithm_id, uint8_t *password, int32_t password_length, uint8_t *salt, int32_t salt_length, int32_t iterations, int32_t key_length) {
+	(void)algorithm_id;
+	(void)password;
+	(void)password_length;
+	(void)salt;
+	(void)salt_length;
+	(void)iterations;
+	(void)key_length;
+	int32_t return_code = SNI_ERROR;
+
+	MICROEJ_ASYNC_WORKER_job_t* job = LLSEC_WORKER_get_job_done();
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for async worker usage
+	LLSEC_WORKER_job* params = (LLSEC_WORKER_job*)job->params;
+	const LLSEC_WORKER_pbkdf2* operation = &params->operation.pbkdf2;
+	if (MICROEJ_LLSECU_SECRET_KEY_FACTORY_SUCCESS != params->result) {
+		(void)SNI_throwNativeException(SNI_ERROR, "PKCS5_PBKDF2_HMAC() failed");
+	} else {
+		// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
+		LLSEC_secret_key* secret_key = (LLSEC_secret_key*)LLSEC_calloc(1, sizeof(LLSEC_secret_key));
+		if (NULL == secret_key) {
+			(void)SNI_throwNativeException(SNI_ERROR, "Can't allocate LLSEC_secret_key structure");
+			LLSEC_free(operation->key);
+		} else {
+			secret_key->key = operation->key;
+			secret_key->key_length = operation->key_length;
+			return_code = LLSEC_SECRET_KEY_FACTORY_openssl_register(secret_key);
+		}
+	}
+	LLSEC_WORKER_free_job(job);
 	return return_code;
 }
 
@@ -233,15 +310,37 @@ int32_t LLSEC_SECRET_KEY_FACTORY_IMPL_get_key_data(int32_t algorithm_id, uint8_t
 	LLSEC_SECRET_KEY_FACTORY_DEBUG_PRINTF("%s password length = %d, salt length = %d, key length = %d (handler = %d)\n", __func__, (int)password_length, (int)salt_length, (int)key_length, (int)algorithm_id);
 	int32_t return_code = SNI_ERROR;
 
-	/* Allocate secret key structure */
-	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
-	LLSEC_secret_key* secret_key = (LLSEC_secret_key*)LLSEC_calloc(1, sizeof(LLSEC_secret_key));
-	if (NULL == secret_key) {
-		(void)SNI_throwNativeException(SNI_ERROR, "Can't allocate LLSEC_secret_key structure");
+	if ((LLSEC_WORKER_BUFFER_SIZE >= password_length) && (LLSEC_WORKER_BUFFER_SIZE >= salt_length) &&
+	    LLSEC_WORKER_is_expensive_pbkdf2(iterations)) {
+		/* The derivation runs on a crypto worker, the Java thread is suspended until
+		 * LLSEC_SECRET_KEY_FACTORY_get_key_data_on_done() */
+		// cppcheck-suppress misra-c2012-11.1 // SNI callback
+		MICROEJ_ASYNC_WORKER_job_t* job = LLSEC_WORKER_allocate_job((SNI_callback)LLSEC_SECRET_KEY_FACTORY_IMPL_get_key_data);
+		if (NULL != job) {
+			// cppcheck-suppress misra-c2012-11.5 // Abstract data type for async worker usage
+			LLSEC_WORKER_job* params = (LLSEC_WORKER_job*)job->params;
+			LLSEC_WORKER_pbkdf2* operation = &params->operation.pbkdf2;
+			operation->algorithm_id = algorithm_id;
+			(void)memcpy(operation->password, password, password_length);
+			operation->password_length = password_length;
+			(void)memcpy(operation->salt, salt, salt_length);
+			operation->salt_length = salt_length;
+			operation->iterations = iterations;
+			operation->key_length = key_length/8;
+			LLSEC_WORKER_exec(job, LLSEC_SECRET_KEY_FACTORY_get_key_data_action, (SNI_callback)LLSEC_SECRET_KEY_FACTORY_get_key_data_on_done);
+		} // else the Java thread waits for a job, or an exception is pending
+		return_code = SNI_IGNORED_RETURNED_VALUE;
 	} else {
-		// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
-		LLSEC_SECRET_KEY_FACTORY_IMPL_algorithm* algorithm = (LLSEC_SECRET_KEY_FACTORY_IMPL_algorithm*)algorithm_id;
-		return_code = algorithm->get_key_data(secret_key, algorithm->md_type, password, password_length, salt, salt_length, iterations, key_length/8);
+		/* Allocate secret key structure */
+		// cppcheck-suppress misra-c2012-11.5 // Abstract data type for SNI usage
+		LLSEC_secret_key* secret_key = (LLSEC_secret_key*)LLSEC_calloc(1, sizeof(LLSEC_secret_key));
+		if (NULL == secret_key) {
+			(void)SNI_throwNativeException(SNI_ERROR, "Can't allocate LLSEC_secret_key structure");
+		} else {
+			// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
+			LLSEC_SECRET_KEY_FACTORY_IMPL_algorithm* algorithm = (LLSEC_SECRET_KEY_FACTORY_IMPL_algorithm*)algorithm_id;
+			return_code = algorithm->get_key_data(secret_key, algorithm->md_type, password, password_length, salt, salt_length, iterations, key_length/8);
+		}
 	}
 
 	return return_code;
@@ -16,6 +16,8 @@
 
 #include <LLSEC_SIG_impl.h>
 #include <LLSEC_openssl.h>
+#include <LLSEC_CTX_POOL_openssl.h>
+#include <LLSEC_WORKER_openssl.h>
 #include <openssl/evp.h>
 #include <openssl/pem.h>
 #include <openssl/err.h>
@@ -40,26 +42,31 @@
 
 
 typedef struct LLSEC_SIG_algorithm LLSEC_SIG_algorithm;
-typedef int (*LLSEC_SIG_verify)(const LLSEC_SIG_algorithm* algorithm, const uint8_t* signature, int32_t signature_length, LLSEC_pub_key* pub_key, const uint8_t* digest, int32_t digest_length);
-typedef int (*LLSEC_SIG_sign)(const LLSEC_SIG_algorithm* algorithm, uint8_t* signature, int32_t* signature_length, LLSEC_priv_key* priv_key, const uint8_t* digest, int32_t digest_length);
+typedef int (*LLSEC_SIG_verify)(const LLSEC_SIG_algorithm* algorithm, const uint8_t* signature, int32_t signature_length, EVP_PKEY* pub_key, const uint8_t* digest, int32_t digest_length);
+typedef int (*LLSEC_SIG_sign)(const LLSEC_SIG_algorithm* algorithm, uint8_t* signature, int32_t* signature_length, EVP_PKEY* priv_key, const uint8_t* digest, int32_t digest_length);
 
 struct LLSEC_SIG_algorithm {
 	char* name;
 	char* digest_name;
-	char* digest_native_name;
+	LLSEC_md_type digest_type;
 	char* oid;
 	LLSEC_SIG_verify verify;
 	LLSEC_SIG_sign sign;
 };
 
-static int LLSEC_SIG_openssl_verify(const LLSEC_SIG_algorithm* algorithm, const uint8_t* signature, int32_t signature_length, LLSEC_pub_key* pub_key, const uint8_t* digest, int32_t digest_length);
-static int LLSEC_SIG_openssl_sign(const LLSEC_SIG_algorithm* algorithm, uint8_t* signature, int32_t* signature_length, LLSEC_priv_key* priv_key, const uint8_t* digest, int32_t digest_length);
+static int LLSEC_SIG_openssl_verify(const LLSEC_SIG_algorithm* algorithm, const uint8_t* signature, int32_t signature_length, EVP_PKEY* pub_key, const uint8_t* digest, int32_t digest_length);
+static int LLSEC_SIG_openssl_sign(const LLSEC_SIG_algorithm* algorithm, uint8_t* signature, int32_t* signature_length, EVP_PKEY* priv_key, const uint8_t* digest, int32_t digest_length);
+static void LLSEC_SIG_async_exec(bool is_sign, int32_t algorithm_id, const uint8_t* signature, int32_t signature_length, EVP_PKEY* key, const uint8_t* digest, int32_t digest_length);
+static void LLSEC_SIG_verify_action(MICROEJ_ASYNC_WORKER_job_t* job);
+static void LLSEC_SIG_sign_action(MICROEJ_ASYNC_WORKER_job_t* job);
+static uint8_t LLSEC_SIG_verify_on_done(int32_t algorithm_id, uint8_t* signature, int32_t signature_length, int32_t nativeId, uint8_t* digest, int32_t digest_length);
+static int32_t LLSEC_SIG_sign_on_done(int32_t algorithm_id, uint8_t* signature, int32_t signature_length, int32_t nativeId, uint8_t* digest, int32_t digest_length);
 
 static LLSEC_SIG_algorithm available_algorithms[] = {
 	{
 		.name = "SHA256withRSA",
 		.digest_name = "SHA-256",
-		.digest_native_name = "SHA256",
+		.digest_type = LLSEC_MD_SHA256,
 		.oid = "1.2.840.113549.1.1.11",
 		.verify = LLSEC_SIG_openssl_verify,
 		.sign = LLSEC_SIG_openssl_sign
@@ -67,7 +74,7 @@ static LLSEC_SIG_algorithm available_algorithms[] = {
 	{
 		.name = "SHA256withECDSA",
 		.digest_name = "SHA-256",
-		.digest_native_name = "SHA256",
+		.digest_type = LLSEC_MD_SHA256,
 		.oid = "1.2.840.10045.4.3.2",
 		.verify = LLSEC_SIG_openssl_verify,
 		.sign = LLSEC_SIG_openssl_sign
@@ -75,14 +82,15 @@ static LLSEC_SIG_algorithm available_algorithms[] = {
 };
 
 
-static int LLSEC_SIG_openssl_verify(const LLSEC_SIG_algorithm* algorithm, const uint8_t* signature, int32_t signature_length, LLSEC_pub_key* pub_key, const uint8_t* digest, int32_t digest_length)
+static int LLSEC_SIG_openssl_verify(const LLSEC_SIG_algorithm* algorithm, const uint8_t* signature, int32_t signature_length, EVP_PKEY* pub_key, const uint8_t* digest, int32_t digest_length)
 {
 	LLSEC_SIG_DEBUG_PRINTF("%s \n", __func__);
 
 	EVP_PKEY_CTX* ctx = NULL;
 	int return_code = MICROEJ_LLSECU_SIG_SUCCESS;
 
-	ctx = EVP_PKEY_CTX_new(pub_key->key, NULL);
+	// The context of the last operations with this key is reused
+	ctx = LLSEC_CTX_POOL_take_pkey_ctx(pub_key);
 	if (NULL == ctx) {
 		// Context init failed
 		LLSEC_SIG_DEBUG_PRINTF("EVP_PKEY_CTX_new failed");
@@ -98,7 +106,7 @@ static int LLSEC_SIG_openssl_verify(const LLSEC_SIG_algorithm* algorithm, const
 	}
 
 	if (MICROEJ_LLSECU_SIG_SUCCESS == return_code) {
-		if (EVP_PKEY_CTX_set_signature_md(ctx, EVP_get_digestbyname(algorithm->digest_native_name)) <= 0) {
+		if (EVP_PKEY_CTX_set_signature_md(ctx, LLSEC_CTX_POOL_get_md(algorithm->digest_type)) <= 0) {
 			// Set signature method failed
 			LLSEC_SIG_DEBUG_PRINTF("EVP_PKEY_CTX_set_signature_md failed");
 			return_code = MICROEJ_LLSECU_SIG_ERROR;
@@ -116,20 +124,21 @@ static int LLSEC_SIG_openssl_verify(const LLSEC_SIG_algorithm* algorithm, const
 		}
 	}
 	if (NULL != ctx) {
-		EVP_PKEY_CTX_free(ctx);
+		LLSEC_CTX_POOL_give_pkey_ctx(ctx);
 	}
 
 	return return_code;
 }
 
-static int LLSEC_SIG_openssl_sign(const LLSEC_SIG_algorithm* algorithm, uint8_t* signature, int32_t* signature_length, LLSEC_priv_key* priv_key, const uint8_t* digest, int32_t digest_length)
+static int LLSEC_SIG_openssl_sign(const LLSEC_SIG_algorithm* algorithm, uint8_t* signature, int32_t* signature_length, EVP_PKEY* priv_key, const uint8_t* digest, int32_t digest_length)
 {
 	LLSEC_SIG_DEBUG_PRINTF("%s \n", __func__);
 
 	EVP_PKEY_CTX *ctx;
 	int return_code = MICROEJ_LLSECU_SIG_SUCCESS;
 
-	ctx = EVP_PKEY_CTX_new(priv_key->key, NULL);
+	// The context of the last operations with this key is reused
+	ctx = LLSEC_CTX_POOL_take_pkey_ctx(priv_key);
 	if (NULL == ctx) {
 		// Init context failed
 		LLSEC_SIG_DEBUG_PRINTF("EVP_PKEY_CTX_new failed");
@@ -145,7 +154,7 @@ static int LLSEC_SIG_openssl_sign(const LLSEC_SIG_algorithm* algorithm, uint8_t*
 	}
 
 	if (MICROEJ_LLSECU_SIG_SUCCESS == return_code) {
-		if (EVP_PKEY_CTX_set_signature_md(ctx, EVP_get_digestbyname(algorithm->digest_native_name)) <= 0) {
+		if (EVP_PKEY_CTX_set_signature_md(ctx, LLSEC_CTX_POOL_get_md(algorithm->digest_type)) <= 0) {
 			LLSEC_SIG_DEBUG_PRINTF("EVP_PKEY_CTX_set_signature_md failed");
 			return_code = MICROEJ_LLSECU_SIG_ERROR;
 		}
@@ -169,7 +178,7 @@ static int LLSEC_SIG_openssl_sign(const LLSEC_SIG_algorithm* algorithm, uint8_t*
 
 	// Clean memory
 	if (NULL != ctx) {
-		EVP_PKEY_CTX_free(ctx);
+		LLSEC_CTX_POOL_give_pkey_ctx(ctx);
 	}
 
 	return return_code;
@@ -239,17 +248,26 @@ uint8_t LLSEC_SIG_IMPL_verify(int32_t algorithm_id, uint8_t* signature, int32_t
 	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
 	LLSEC_SIG_algorithm* algorithm = (LLSEC_SIG_algorithm*)algorithm_id;
 	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
-	int return_code = algorithm->verify(algorithm, signature, signature_length, (LLSEC_pub_key*) nativeId, digest, digest_length);
+	LLSEC_pub_key* pub_key = (LLSEC_pub_key*)nativeId;
 
-	if (MICROEJ_LLSECU_SIG_SUCCESS == return_code) {
-		return_jcode = JTRUE;
-	}
-	else if (MICROEJ_LLSECU_SIGNATURE_INVALID == return_code) {
-		return_jcode = JFALSE;
+	if ((LLSEC_WORKER_DIGEST_SIZE >= digest_length) && (LLSEC_WORKER_BUFFER_SIZE >= signature_length) &&
+	    LLSEC_WORKER_is_expensive_pkey(pub_key->key, false)) {
+		// Suspend the Java thread until LLSEC_SIG_verify_on_done()
+		LLSEC_SIG_async_exec(false, algorithm_id, signature, signature_length, pub_key->key, digest, digest_length);
+		return_jcode = SNI_IGNORED_RETURNED_VALUE;
 	} else {
-		int err = ERR_get_error();
-		(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
-		return_jcode = SNI_ERROR;
+		int return_code = algorithm->verify(algorithm, signature, signature_length, pub_key->key, digest, digest_length);
+
+		if (MICROEJ_LLSECU_SIG_SUCCESS == return_code) {
+			return_jcode = JTRUE;
+		}
+		else if (MICROEJ_LLSECU_SIGNATURE_INVALID == return_code) {
+			return_jcode = JFALSE;
+		} else {
+			int err = ERR_get_error();
+			(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
+			return_jcode = SNI_ERROR;
+		}
 	}
 	return return_jcode;
 }
@@ -262,14 +280,136 @@ int32_t LLSEC_SIG_IMPL_sign(int32_t algorithm_id, uint8_t* signature, int32_t si
 	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
 	LLSEC_SIG_algorithm* algorithm = (LLSEC_SIG_algorithm*)algorithm_id;
 	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
-	int return_code = algorithm->sign(algorithm, signature, &signature_length, (LLSEC_priv_key*)nativeId, digest, digest_length);
+	LLSEC_priv_key* priv_key = (LLSEC_priv_key*)nativeId;
+
+	if ((LLSEC_WORKER_DIGEST_SIZE >= digest_length) && (LLSEC_WORKER_BUFFER_SIZE >= EVP_PKEY_size(priv_key->key)) &&
+	    LLSEC_WORKER_is_expensive_pkey(priv_key->key, true)) {
+		// Suspend the Java thread until LLSEC_SIG_sign_on_done()
+		LLSEC_SIG_async_exec(true, algorithm_id, signature, signature_length, priv_key->key, digest, digest_length);
+		return_jcode = SNI_IGNORED_RETURNED_VALUE;
+	} else {
+		int return_code = algorithm->sign(algorithm, signature, &signature_length, priv_key->key, digest, digest_length);
+
+		if (MICROEJ_LLSECU_SIG_SUCCESS != return_code) {
+			int err = ERR_get_error();
+			(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
+			return_jcode = JFALSE;
+		} else {
+			return_jcode = signature_length;
+		}
+	}
+	return return_jcode;
+}
+
+/**
+ * @brief Copies the inputs of a signature or a verification to a job and executes it on a crypto worker.
+ * The key is referenced by the job, so it stays valid if the Java key is closed before the job is done.
+ */
+static void LLSEC_SIG_async_exec(bool is_sign, int32_t algorithm_id, const uint8_t* signature, int32_t signature_length, EVP_PKEY* key, const uint8_t* digest, int32_t digest_length) {
+	// cppcheck-suppress misra-c2012-11.1 // SNI callback
+	SNI_callback retry_callback = is_sign ? (SNI_callback)LLSEC_SIG_IMPL_sign : (SNI_callback)LLSEC_SIG_IMPL_verify;
+	MICROEJ_ASYNC_WORKER_job_t* job = LLSEC_WORKER_allocate_job(retry_callback);
+	if (NULL != job) {
+		// cppcheck-suppress misra-c2012-11.5 // Abstract data type for async worker usage
+		LLSEC_WORKER_job* params = (LLSEC_WORKER_job*)job->params;
+		LLSEC_WORKER_signature* operation = &params->operation.signature;
+		operation->algorithm_id = algorithm_id;
+		LLSEC_WORKER_hold_key(params, key);
+		(void)memcpy(operation->digest, digest, digest_length);
+		operation->digest_length = digest_length;
+		if (is_sign) {
+			LLSEC_WORKER_exec(job, LLSEC_SIG_sign_action, (SNI_callback)LLSEC_SIG_sign_on_done);
+		} else {
+			(void)memcpy(operation->signature, signature, signature_length);
+			operation->signature_length = signature_length;
+			LLSEC_WORKER_exec(job, LLSEC_SIG_verify_action, (SNI_callback)LLSEC_SIG_verify_on_done);
+		}
+	} // else the Java thread waits for a job, or an exception is pending
+}
+
+/**
+ * @brief Verifies a signature, in a crypto worker.
+ */
+static void LLSEC_SIG_verify_action(MICROEJ_ASYNC_WORKER_job_t* job) {
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for async worker usage
+	LLSEC_WORKER_job* params = (LLSEC_WORKER_job*)job->params;
+	LLSEC_WORKER_signature* operation = &params->operation.signature;
+	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
+	LLSEC_SIG_algorithm* algorithm = (LLSEC_SIG_algorithm*)operation->algorithm_id;
+
+	params->result = algorithm->verify(algorithm, operation->signature, operation->signature_length, params->key,
+	                                   operation->digest, operation->digest_length);
+	if (MICROEJ_LLSECU_SIG_ERROR == params->result) {
+		LLSEC_WORKER_save_error(params);
+	}
+}
+
+/**
+ * @brief Signs a digest, in a crypto worker.
+ */
+static void LLSEC_SIG_sign_action(MICROEJ_ASYNC_WORKER_job_t* job) {
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for async worker usage
+	LLSEC_WORKER_job* params = (LLSEC_WORKER_job*)job->params;
+	LLSEC_WORKER_signature* operation = &params->operation.signature;
+	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
+	LLSEC_SIG_algorithm* algorithm = (LLSEC_SIG_algorithm*)operation->algorithm_id;
+
+	operation->signature_length = LLSEC_WORKER_BUFFER_SIZE;
+	params->result = algorithm->sign(algorithm, operation->signature, &operation->signature_length, params->key,
+	                                 operation->digest, operation->digest_length);
+	if (MICROEJ_LLSECU_SIG_SUCCESS != params->result) {
+		LLSEC_WORKER_save_error(params);
+	}
+}
 
-	if (MICROEJ_LLSECU_SIG_SUCCESS != return_code) {
-		int err = ERR_get_error();
-		(void)SNI_throwNativeException(err, ERR_error_string(err, NULL));
+/**
+ * @brief Returns the result of a verification done in a crypto worker, on the VM task.
+ */
+static uint8_t LLSEC_SIG_verify_on_done(int32_t algorithm_id, uint8_t* signature, int32_t signature_length, int32_t nativeId, uint8_t* digest, int32_t digest_length) {
+	(void)algorithm_id;
+	(void)signature;
+	(void)signature_length;
+	(void)nativeId;
+	(void)digest;
+	(void)digest_length;
+	int return_jcode = SNI_ERROR;
+
+	MICROEJ_ASYNC_WORKER_job_t* job = LLSEC_WORKER_get_job_done();
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for async worker usage
+	LLSEC_WORKER_job* params = (LLSEC_WORKER_job*)job->params;
+	if (MICROEJ_LLSECU_SIG_SUCCESS == params->result) {
+		return_jcode = JTRUE;
+	} else if (MICROEJ_LLSECU_SIGNATURE_INVALID == params->result) {
 		return_jcode = JFALSE;
 	} else {
-		return_jcode = signature_length;
+		LLSEC_WORKER_throw_error(params);
+	}
+	LLSEC_WORKER_free_job(job);
+	return return_jcode;
+}
+
+/**
+ * @brief Copies the signature computed in a crypto worker to the Java array, on the VM task.
+ */
+static int32_t LLSEC_SIG_sign_on_done(int32_t algorithm_id, uint8_t* signature, int32_t signature_length, int32_t nativeId, uint8_t* digest, int32_t digest_length) {
+	(void)algorithm_id;
+	(void)nativeId;
+	(void)digest;
+	(void)digest_length;
+	int return_jcode = JFALSE;
+
+	MICROEJ_ASYNC_WORKER_job_t* job = LLSEC_WORKER_get_job_done();
+	// cppcheck-suppress misra-c2012-11.5 // Abstract data type for async worker usage
+	LLSEC_WORKER_job* params = (LLSEC_WORKER_job*)job->params;
+	const LLSEC_WORKER_signature* operation = &params->operation.signature;
+	if (MICROEJ_LLSECU_SIG_SUCCESS != params->result) {
+		LLSEC_WORKER_throw_error(params);
+	} else if (operation->signature_length > signature_length) {
+		(void)SNI_throwNativeException(SNI_ERROR, "signature buffer too small");
+	} else {
+		(void)memcpy(signature, operation->signature, operation->signature_length);
+		return_jcode = operation->signature_length;
 	}
+	LLSEC_WORKER_free_job(job);
 	return return_jcode;
 }
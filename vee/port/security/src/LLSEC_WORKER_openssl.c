@@ -0,0 +1,250 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ *
+ */
+
+/**
+ * @file
+ * @brief MicroEJ Security low level API: crypto workers for the expensive operations.
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <openssl/crypto.h>
+#include <openssl/ec.h>
+#include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/objects.h>
+#include <openssl/opensslv.h>
+#include "sni.h"
+#include "LLSEC_configuration.h"
+#include "LLSEC_CTX_POOL_openssl.h"
+#include "LLSEC_WORKER_openssl.h"
+
+// #define LLSEC_WORKER_DEBUG_TRACE
+
+#ifdef LLSEC_WORKER_DEBUG_TRACE
+#define LLSEC_WORKER_DEBUG_PRINTF(...) (void)printf(__VA_ARGS__)
+#else
+#define LLSEC_WORKER_DEBUG_PRINTF(...) ((void)0)
+#endif
+
+#if LLSEC_WORKER_ENABLED == 1
+static int32_t LLSEC_WORKER_select(void);
+
+MICROEJ_ASYNC_WORKER_worker_declare(llsec_worker_0, LLSEC_WORKER_JOB_COUNT, LLSEC_WORKER_job, LLSEC_WORKER_WAITING_LIST_SIZE);
+OSAL_task_stack_declare(llsec_worker_0_stack, LLSEC_WORKER_STACK_SIZE);
+#if LLSEC_WORKER_COUNT > 1
+MICROEJ_ASYNC_WORKER_worker_declare(llsec_worker_1, LLSEC_WORKER_JOB_COUNT, LLSEC_WORKER_job, LLSEC_WORKER_WAITING_LIST_SIZE);
+OSAL_task_stack_declare(llsec_worker_1_stack, LLSEC_WORKER_STACK_SIZE);
+#endif
+#if LLSEC_WORKER_COUNT > 2
+MICROEJ_ASYNC_WORKER_worker_declare(llsec_worker_2, LLSEC_WORKER_JOB_COUNT, LLSEC_WORKER_job, LLSEC_WORKER_WAITING_LIST_SIZE);
+OSAL_task_stack_declare(llsec_worker_2_stack, LLSEC_WORKER_STACK_SIZE);
+#endif
+#if LLSEC_WORKER_COUNT > 3
+MICROEJ_ASYNC_WORKER_worker_declare(llsec_worker_3, LLSEC_WORKER_JOB_COUNT, LLSEC_WORKER_job, LLSEC_WORKER_WAITING_LIST_SIZE);
+OSAL_task_stack_declare(llsec_worker_3_stack, LLSEC_WORKER_STACK_SIZE);
+#endif
+
+static MICROEJ_ASYNC_WORKER_handle_t* const workers[LLSEC_WORKER_COUNT] = {
+	&llsec_worker_0,
+#if LLSEC_WORKER_COUNT > 1
+	&llsec_worker_1,
+#endif
+#if LLSEC_WORKER_COUNT > 2
+	&llsec_worker_2,
+#endif
+#if LLSEC_WORKER_COUNT > 3
+	&llsec_worker_3,
+#endif
+};
+
+// Number of jobs allocated on each worker. Only accessed from the VM task
+static int32_t pending_jobs[LLSEC_WORKER_COUNT];
+#endif // LLSEC_WORKER_ENABLED == 1
+
+static bool initialized = false;
+static bool started = false;
+
+void LLSEC_WORKER_initialize(void) {
+	if (!initialized) {
+		initialized = true;
+		// The workers use the pools, which must be initialized from the VM task
+		LLSEC_CTX_POOL_initialize();
+#if LLSEC_WORKER_ENABLED == 1
+		OSAL_task_stack_t const stacks[LLSEC_WORKER_COUNT] = {
+			llsec_worker_0_stack,
+#if LLSEC_WORKER_COUNT > 1
+			llsec_worker_1_stack,
+#endif
+#if LLSEC_WORKER_COUNT > 2
+			llsec_worker_2_stack,
+#endif
+#if LLSEC_WORKER_COUNT > 3
+			llsec_worker_3_stack,
+#endif
+		};
+		static const char* const names[4] = { "MicroEJ Crypto 0", "MicroEJ Crypto 1", "MicroEJ Crypto 2", "MicroEJ Crypto 3" };
+
+		bool ok = true;
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+		// OpenSSL 1.0.2 is only thread safe with the locking callbacks
+		if (NULL == CRYPTO_get_locking_callback()) {
+			LLSEC_WORKER_DEBUG_PRINTF("%s no OpenSSL locking callback, crypto operations run on the VM task\n", __func__);
+			ok = false;
+		}
+#endif
+		for (int32_t i = 0; ok && (i < LLSEC_WORKER_COUNT); i++) {
+			// cppcheck-suppress misra-c2012-11.8 // String casts conform to MICROEJ_ASYNC_WORKER_initialize function definitions.
+			MICROEJ_ASYNC_WORKER_status_t status = MICROEJ_ASYNC_WORKER_initialize(workers[i], (uint8_t*)names[i], stacks[i],
+			                                                                       LLSEC_WORKER_PRIORITY);
+			if (MICROEJ_ASYNC_WORKER_OK != status) {
+				// Workers already started stay idle
+				LLSEC_WORKER_DEBUG_PRINTF("%s cannot start crypto worker %d (status=%d), crypto operations run on the VM task\n", __func__, (int)i, (int)status);
+				ok = false;
+			}
+		}
+		started = ok;
+#endif
+	}
+}
+
+bool LLSEC_WORKER_is_expensive_pkey(EVP_PKEY* key, bool is_private) {
+	LLSEC_WORKER_initialize();
+	bool expensive = false;
+	if (started && (NULL != key)) {
+		int bits = EVP_PKEY_bits(key);
+		int type = EVP_PKEY_base_id(key);
+		if (EVP_PKEY_RSA == type) {
+			// The public exponent is small, only the private key operations are expensive
+			expensive = is_private && (bits >= LLSEC_WORKER_RSA_MIN_BITS);
+		} else if (EVP_PKEY_EC == type) {
+			expensive = (bits >= LLSEC_WORKER_EC_MIN_BITS);
+		} else {
+			// Unknown cost, keep it inline
+		}
+	}
+	return expensive;
+}
+
+bool LLSEC_WORKER_is_expensive_rsa_keygen(int32_t key_size) {
+	LLSEC_WORKER_initialize();
+	return started && (key_size >= LLSEC_WORKER_RSA_MIN_BITS);
+}
+
+bool LLSEC_WORKER_is_expensive_ec_keygen(const char* curve_name) {
+	LLSEC_WORKER_initialize();
+	bool expensive = false;
+	if (started && (strlen(curve_name) < (size_t)LLSEC_WORKER_CURVE_NAME_SIZE)) {
+		int nid = EC_curve_nist2nid(curve_name);
+		if (NID_undef == nid) {
+			nid = OBJ_txt2nid(curve_name);
+		}
+		EC_GROUP* group = EC_GROUP_new_by_curve_name(nid);
+		if (NULL != group) {
+			expensive = (EC_GROUP_get_degree(group) >= LLSEC_WORKER_EC_MIN_BITS);
+			EC_GROUP_free(group);
+		} else {
+			// Unknown curve, the generation fails inline
+			ERR_clear_error();
+		}
+	}
+	return expensive;
+}
+
+bool LLSEC_WORKER_is_expensive_pbkdf2(int32_t iterations) {
+	LLSEC_WORKER_initialize();
+	return started && (iterations >= LLSEC_WORKER_PBKDF2_MIN_ITERATIONS);
+}
+
+MICROEJ_ASYNC_WORKER_job_t* LLSEC_WORKER_allocate_job(SNI_callback retry_callback) {
+	MICROEJ_ASYNC_WORKER_job_t* job = NULL;
+#if LLSEC_WORKER_ENABLED == 1
+	int32_t index = LLSEC_WORKER_select();
+	job = MICROEJ_ASYNC_WORKER_allocate_job(workers[index], retry_callback);
+	if (NULL != job) {
+		LLSEC_WORKER_job* params = (LLSEC_WORKER_job*)job->params;
+		(void)memset(params, 0, sizeof(LLSEC_WORKER_job));
+		params->worker = workers[index];
+		pending_jobs[index]++;
+	} // else the Java thread waits for a job, or an exception is pending
+#else
+	(void)retry_callback;
+	(void)SNI_throwNativeException(SNI_ERROR, "crypto workers disabled");
+#endif
+	return job;
+}
+
+void LLSEC_WORKER_exec(MICROEJ_ASYNC_WORKER_job_t* job, MICROEJ_ASYNC_WORKER_action_t action, SNI_callback on_done_callback) {
+	LLSEC_WORKER_job* params = (LLSEC_WORKER_job*)job->params;
+	MICROEJ_ASYNC_WORKER_status_t status = MICROEJ_ASYNC_WORKER_async_exec(params->worker, job, action, on_done_callback);
+	if (MICROEJ_ASYNC_WORKER_OK != status) {
+		// MICROEJ_ASYNC_WORKER_async_exec has thrown a SNI exception
+		LLSEC_WORKER_free_job(job);
+	}
+}
+
+MICROEJ_ASYNC_WORKER_job_t* LLSEC_WORKER_get_job_done(void) {
+	return MICROEJ_ASYNC_WORKER_get_job_done();
+}
+
+void LLSEC_WORKER_free_job(MICROEJ_ASYNC_WORKER_job_t* job) {
+#if LLSEC_WORKER_ENABLED == 1
+	const LLSEC_WORKER_job* params = (LLSEC_WORKER_job*)job->params;
+	for (int32_t i = 0; i < LLSEC_WORKER_COUNT; i++) {
+		if (workers[i] == params->worker) {
+			pending_jobs[i]--;
+		}
+	}
+	EVP_PKEY_free(params->key);
+	(void)MICROEJ_ASYNC_WORKER_free_job(params->worker, job);
+#else
+	(void)job;
+#endif
+}
+
+void LLSEC_WORKER_hold_key(LLSEC_WORKER_job* params, EVP_PKEY* key) {
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+	(void)CRYPTO_add(&key->references, 1, CRYPTO_LOCK_EVP_PKEY);
+#else
+	(void)EVP_PKEY_up_ref(key);
+#endif
+	params->key = key;
+}
+
+void LLSEC_WORKER_save_error(LLSEC_WORKER_job* params) {
+	params->error.code = ERR_get_error();
+	ERR_error_string_n(params->error.code, params->error.message, sizeof(params->error.message));
+	// Do not leave errors to the next operation of this worker
+	ERR_clear_error();
+}
+
+void LLSEC_WORKER_throw_error(const LLSEC_WORKER_job* params) {
+	(void)SNI_throwNativeException((int32_t)params->error.code, params->error.message);
+}
+
+#if LLSEC_WORKER_ENABLED == 1
+/**
+ * @brief Selects the worker with the fewest pending jobs.
+ *
+ * @return the worker index.
+ */
+static int32_t LLSEC_WORKER_select(void) {
+	int32_t index = 0;
+	for (int32_t i = 1; i < LLSEC_WORKER_COUNT; i++) {
+		if (pending_jobs[i] < pending_jobs[index]) {
+			index = i;
+		}
+	}
+	return index;
+}
+#endif // LLSEC_WORKER_ENABLED == 1
@@ -16,6 +16,8 @@
 
 #include "LLSEC_configuration.h"
 #include "LLSEC_openssl.h"
+#include "LLSEC_CTX_POOL_openssl.h"
+#include "LLSEC_OBJECT_CACHE_openssl.h"
 #include "LLSEC_X509_CERT_impl.h"
 #include <openssl/bio.h>
 #include <openssl/x509.h>
@@ -47,29 +49,44 @@ static int32_t LLSEC_X509_CERT_openssl_close_key(int32_t native_id);
 static X509* get_x509_certificate(int8_t* cert_data, int32_t len, int* cert_format)
 {
 	LLSEC_X509_DEBUG_PRINTF("%s \n", __func__);
-	X509 *x509;
-	x509 = d2i_X509(NULL, (const unsigned char**)&cert_data, len);
-	if (NULL != x509) {
-		if (NULL != cert_format) {
-			*cert_format = MICROEJ_LLSECU_X509_DER_FORMAT;
-		}
-	} else {
-		BIO *bp = BIO_new_mem_buf(cert_data, len);
-		// Can we generate a x509 certificate with pem parsing
-		x509 = PEM_read_bio_X509(bp, NULL, NULL, NULL);
-		if (NULL != cert_format) {
+	X509 *x509 = NULL;
+	int format = MICROEJ_LLSECU_X509_UNKNOWN_FORMAT;
+
+	// Repeated parsings of the same certificate reuse the decoded one
+	LLSEC_object_cache_key key;
+	// cppcheck-suppress misra-c2012-11.3 // Encoded certificate bytes
+	bool cacheable = LLSEC_OBJECT_CACHE_make_key(&key, LLSEC_OBJECT_CACHE_X509, (const uint8_t*)cert_data, len);
+	if (cacheable) {
+		x509 = LLSEC_OBJECT_CACHE_get_x509(&key, &format);
+	}
+
+	if (NULL == x509) {
+		const unsigned char* der = (const unsigned char*)cert_data;
+		x509 = d2i_X509(NULL, &der, len);
+		if (NULL != x509) {
+			format = MICROEJ_LLSECU_X509_DER_FORMAT;
+		} else {
+			BIO *bp = BIO_new_mem_buf(cert_data, len);
+			// Can we generate a x509 certificate with pem parsing
+			x509 = PEM_read_bio_X509(bp, NULL, NULL, NULL);
 			if(x509 != NULL) {
-				*cert_format = MICROEJ_LLSECU_X509_PEM_FORMAT;
-			} else 	{
-				*cert_format = MICROEJ_LLSECU_X509_UNKNOWN_FORMAT;
+				format = MICROEJ_LLSECU_X509_PEM_FORMAT;
 			}
+			// x509 is NULL if PEM_read_bio failed
+			BIO_free_all(bp);
+			// Do not leave the errors of the DER parsing to the next operation
+			ERR_clear_error();
 		}
-		// x509 is NULL if PEM_read_bio failed
-		BIO_free_all(bp);
+		if (cacheable && (NULL != x509)) {
+			LLSEC_OBJECT_CACHE_put_x509(&key, x509, format);
+		}
+	}
 
+	if (NULL != cert_format) {
+		*cert_format = format;
 	}
 	// Will return a NULL pointer if failed
-	// Return a valid certificate on success
+	// Return a valid certificate on success, the caller frees its reference with X509_free()
 	return x509;
 }
 
@@ -78,6 +95,7 @@ static int32_t LLSEC_X509_CERT_openssl_close_key(int32_t native_id) {
 	LLSEC_X509_DEBUG_PRINTF("%s \n", __func__);
 	// cppcheck-suppress misra-c2012-11.4 // Abstract data type for SNI usage
 	LLSEC_pub_key* pub_key = (LLSEC_pub_key*) native_id;
+	LLSEC_CTX_POOL_purge_pkey_ctx(pub_key->key);
 	EVP_PKEY_free(pub_key->key);
 	free(pub_key);
 	return 1;
@@ -161,7 +179,6 @@ int32_t LLSEC_X509_CERT_IMPL_verify(int8_t* cert_data, int32_t cert_data_length,
 		int rc = X509_verify(x509, pub_key->key);
 		if (rc != MICROEJ_LLSECU_X509_SUCCESS) {
 			// Error
-			X509_free(x509);
 			LLSEC_X509_DEBUG_PRINTF("LLSEC_X509 > verify error");
 			(void)SNI_throwNativeException(SNI_ERROR, "Error x509 verify failed");
 			return_code = MICROEJ_LLSECU_X509_ERROR;
@@ -179,7 +196,7 @@ int32_t LLSEC_X509_CERT_IMPL_get_x500_principal_data(int8_t* cert_data, int32_t
 	size_t length = 0;
 	int return_code = MICROEJ_LLSECU_X509_SUCCESS;
 
-	const X509 *x509 = get_x509_certificate(cert_data, cert_data_length, NULL);
+	X509 *x509 = get_x509_certificate(cert_data, cert_data_length, NULL);
 	if (NULL == x509) {
 		(void)SNI_throwNativeException(SNI_ERROR, "Bad x509 certificate");
 		return_code = MICROEJ_LLSECU_X509_ERROR;
@@ -227,6 +244,10 @@ int32_t LLSEC_X509_CERT_IMPL_get_x500_principal_data(int8_t* cert_data, int32_t
 		(void)memcpy(principal_data, data, length);
 		return_code = length;
 	}
+
+	if (NULL != x509) {
+		X509_free(x509);
+	}
 	return return_code;
 }
 
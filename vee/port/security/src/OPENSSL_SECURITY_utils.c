@@ -15,6 +15,8 @@
  */
 
 #include "LLSEC_openssl.h"
+#include "LLSEC_CTX_POOL_openssl.h"
+#include "LLSEC_WORKER_openssl.h"
 #include <openssl/err.h>
 #include <openssl/crypto.h>
 #include <openssl/opensslv.h>
@@ -30,6 +32,8 @@ void OPENSSL_SECURITY_global_initialize()
 //#else: The needed resources (algorithms, error strings etc.) are automatically initialized. Explicit initialization is not required.
 
 #endif
+	LLSEC_CTX_POOL_initialize();
+	LLSEC_WORKER_initialize();
 }
 
 // clean up openssl algorithm and error string
@@ -43,3 +47,14 @@ void OPENSSL_SECURITY_global_clean_up()
 
 #endif
 }
+
+bool OPENSSL_SECURITY_check_messages(int32_t buffer_length, const int32_t* lengths, int32_t count, int32_t out_length, int32_t output_size)
+{
+	bool ok = (0 <= count) && (0 <= buffer_length) && (((int64_t)count * output_size) <= (int64_t)out_length);
+	int64_t total_length = 0;
+	for (int32_t i = 0; ok && (i < count); i++) {
+		total_length += lengths[i];
+		ok = (0 <= lengths[i]) && (total_length <= (int64_t)buffer_length);
+	}
+	return ok;
+}
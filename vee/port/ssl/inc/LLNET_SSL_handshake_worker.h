@@ -0,0 +1,153 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#ifndef LLNET_SSL_HANDSHAKE_WORKER
+#define LLNET_SSL_HANDSHAKE_WORKER
+#include <sni.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <openssl/ssl.h>
+#include "microej_async_worker.h"
+
+/**
+ * @file
+ * @brief LLNET SSL handshake workers header.
+ *
+ * The steps of the initial handshakes (SSL_connect()/SSL_accept() on the non-blocking socket) run on a pool of
+ * async workers instead of the VM task, so the key exchange and certificate computations of concurrent handshakes
+ * use several cores and do not delay the other Java threads. The calling Java thread is suspended until its step
+ * is done. Each job goes to the worker with the fewest pending jobs.
+ *
+ * OpenSSL error queue and errno are per thread: the worker stores the step result, the SSL error and the
+ * translated error code in the job, for the VM task.
+ *
+ * A session is busy from LLNET_SSL_HANDSHAKE_WORKER_exec() to LLNET_SSL_HANDSHAKE_WORKER_get_result(): the job
+ * holds a reference to it, and the VM task must not use it meanwhile. A session closed by another Java thread
+ * during a step is freed when the step result is got (see LLNET_SSL_HANDSHAKE_WORKER_defer_free()).
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/**
+ * @brief Set to 0 to run the handshakes on the VM task.
+ */
+#ifndef LLNET_SSL_HANDSHAKE_WORKER_ENABLED
+#define LLNET_SSL_HANDSHAKE_WORKER_ENABLED (1)
+#endif
+
+/**
+ * @brief Number of handshake workers, from 1 to 4. Each worker has its own task.
+ */
+#ifndef LLNET_SSL_HANDSHAKE_WORKER_COUNT
+#define LLNET_SSL_HANDSHAKE_WORKER_COUNT (2)
+#endif
+
+#if (LLNET_SSL_HANDSHAKE_WORKER_COUNT < 1) || (LLNET_SSL_HANDSHAKE_WORKER_COUNT > 4)
+#error "LLNET_SSL_HANDSHAKE_WORKER_COUNT must be between 1 and 4"
+#endif
+
+/**
+ * @brief Number of jobs of each handshake worker, i.e. handshakes it executes or queues at the same time.
+ */
+#ifndef LLNET_SSL_HANDSHAKE_WORKER_JOB_COUNT
+#define LLNET_SSL_HANDSHAKE_WORKER_JOB_COUNT (8)
+#endif
+
+/**
+ * @brief Number of Java threads that can wait for a job of each handshake worker.
+ */
+#ifndef LLNET_SSL_HANDSHAKE_WAITING_LIST_SIZE
+#define LLNET_SSL_HANDSHAKE_WAITING_LIST_SIZE (16)
+#endif
+
+/**
+ * @brief Size of the stack of each handshake worker in bytes. OpenSSL public key operations need a large stack.
+ */
+#ifndef LLNET_SSL_HANDSHAKE_WORKER_STACK_SIZE
+#define LLNET_SSL_HANDSHAKE_WORKER_STACK_SIZE (1024*64)
+#endif
+
+/**
+ * @brief Priority of the handshake workers.
+ */
+#ifndef LLNET_SSL_HANDSHAKE_WORKER_PRIORITY
+#define LLNET_SSL_HANDSHAKE_WORKER_PRIORITY (5)
+#endif
+
+/** @brief Parameters and result of a handshake step. */
+typedef struct {
+	SSL* ssl;
+	bool is_client;
+	int32_t ret; // SSL_connect() or SSL_accept() result
+	int32_t ssl_error; // SSL_get_error() result
+	int32_t error_code; // LLNET_SSL_TranslateReturnCode() result
+	int32_t sys_errno; // errno after the step
+	bool closed; // true if LLNET_SSL_HANDSHAKE_WORKER_defer_free() was called during the step
+	MICROEJ_ASYNC_WORKER_handle_t* worker; // worker that executed the step
+} LLNET_SSL_HANDSHAKE_job_t;
+
+/**
+ * @brief Starts the handshake workers. If a worker cannot be started, or with OpenSSL 1.0.2 without locking
+ * callbacks, the handshakes run on the VM task.
+ */
+void LLNET_SSL_HANDSHAKE_WORKER_initialize(void);
+
+/**
+ * @brief Tells whether the handshakes run on the workers.
+ */
+bool LLNET_SSL_HANDSHAKE_WORKER_is_started(void);
+
+/**
+ * @brief Executes a handshake step on a worker and suspends the current Java thread until it is done.
+ *
+ * An exception is thrown if the session is busy. If no job is available, the current Java thread is suspended and retry_callback is called when a job is
+ * available. On error, an exception is pending.
+ *
+ * @param[in] ssl the SSL session.
+ * @param[in] is_client true for SSL_connect(), false for SSL_accept().
+ * @param[in] retry_callback the SNI callback to call if no job is available, usually the calling native.
+ * @param[in] on_done_callback the SNI callback to call when the step is done. It must call
+ * LLNET_SSL_HANDSHAKE_WORKER_get_result().
+ */
+void LLNET_SSL_HANDSHAKE_WORKER_exec(SSL* ssl, bool is_client, SNI_callback retry_callback, SNI_callback on_done_callback);
+
+/**
+ * @brief Gets the result of the handshake step done and frees its job. Must be called from the on_done_callback
+ * given to LLNET_SSL_HANDSHAKE_WORKER_exec().
+ *
+ * @param[out] result the result of the step.
+ *
+ * The session is no longer busy and the reference of the job is released. If result->closed is true, the caller
+ * must free the session.
+ *
+ * @return false if not called from an on_done_callback.
+ */
+bool LLNET_SSL_HANDSHAKE_WORKER_get_result(LLNET_SSL_HANDSHAKE_job_t* result);
+
+/**
+ * @brief Tells whether a handshake step of the session runs or waits on a worker.
+ */
+bool LLNET_SSL_HANDSHAKE_WORKER_is_busy(SSL* ssl);
+
+/**
+ * @brief Defers the free of a busy session to the end of its handshake step: the on_done_callback gets a result
+ * with the closed flag set.
+ *
+ * @return true if the free is deferred, false if the session is not busy and can be freed at once.
+ */
+bool LLNET_SSL_HANDSHAKE_WORKER_defer_free(SSL* ssl);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
@@ -0,0 +1,79 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#ifndef LLNET_SSL_KTLS
+#define LLNET_SSL_KTLS
+#include <sni.h>
+#include <stdint.h>
+#include <openssl/ssl.h>
+
+/**
+ * @file
+ * @brief LLNET SSL kernel TLS (kTLS) offload over OpenSSL header.
+ *
+ * When OpenSSL is built with kTLS support (OpenSSL 3.0 or later) and the kernel supports the negotiated cipher,
+ * the record encryption and decryption of the established connections are done by the kernel socket: SSL_read()
+ * and SSL_write() then pass the application data straight to the socket. Otherwise, OpenSSL silently keeps the
+ * user-space record layer, for each direction independently.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/**
+ * @brief Set to 0 to keep the record layer of all the TLS connections in user space.
+ */
+#ifndef LLNET_SSL_KTLS_ENABLED
+#define LLNET_SSL_KTLS_ENABLED (1)
+#endif
+
+/** @brief kTLS status flag: the records sent are encrypted by the kernel. */
+#define LLNET_SSL_KTLS_SEND    (0x1)
+/** @brief kTLS status flag: the records received are decrypted by the kernel. */
+#define LLNET_SSL_KTLS_RECEIVE (0x2)
+
+#ifndef LLNET_SSL_KTLS_IMPL_getStatus
+#define LLNET_SSL_KTLS_IMPL_getStatus Java_com_microej_ssl_KernelTLS_getStatus
+#endif
+
+/**
+ * @brief Native: gets the kTLS status of an SSL connection.
+ *
+ * @param[in] ssl the SSL session.
+ *
+ * @return a combination of LLNET_SSL_KTLS_SEND and LLNET_SSL_KTLS_RECEIVE, 0 if the connection uses the user-space
+ * record layer in both directions or the handshake is not done.
+ */
+int32_t LLNET_SSL_KTLS_IMPL_getStatus(int32_t ssl);
+
+/**
+ * @brief Allows the TLS connections of a context to use kTLS, if enabled and supported by OpenSSL.
+ * Does nothing for DTLS contexts.
+ *
+ * @param[in] ctx the SSL context.
+ * @param[in] protocol the protocol of the context.
+ */
+void LLNET_SSL_KTLS_enable(SSL_CTX* ctx, int32_t protocol);
+
+/**
+ * @brief Gets the kTLS status of an SSL connection.
+ *
+ * @param[in] ssl the SSL session.
+ *
+ * @return a combination of LLNET_SSL_KTLS_SEND and LLNET_SSL_KTLS_RECEIVE.
+ */
+int32_t LLNET_SSL_KTLS_get_status(SSL* ssl);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
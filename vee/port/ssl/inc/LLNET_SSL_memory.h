@@ -0,0 +1,156 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#ifndef LLNET_SSL_MEMORY
+#define LLNET_SSL_MEMORY
+#include <sni.h>
+#include <stdint.h>
+#include <openssl/ssl.h>
+
+/**
+ * @file
+ * @brief LLNET SSL memory management header.
+ *
+ * - Idle connections release their record buffers (SSL_MODE_RELEASE_BUFFERS): a connection holds its read and
+ *   write buffers only while a record is being processed.
+ * - The OpenSSL allocations go through this module (CRYPTO_set_mem_functions()). The freed blocks of
+ *   LLNET_SSL_MEMORY_POOL_MIN_BLOCK bytes or more, i.e. the record buffers, are kept in a pool shared by all the
+ *   connections, up to LLNET_SSL_MEMORY_POOL_BLOCKS blocks, and reused for the allocations of the same size. The
+ *   write coalescing buffers (LLNET_SSL_record.h) come from the same pool.
+ * - Each allocation is charged to the session being processed by the calling thread (creation, handshake, read,
+ *   write and shutdown), so the memory held by each connection can be queried.
+ *
+ * The allocation functions can only be replaced before the first OpenSSL allocation. LLNET_SSL_MEMORY_initialize()
+ * is called by LLNET_SSL_SOCKET_IMPL_initialize(); if another module used OpenSSL before, it should be called
+ * earlier by the BSP, otherwise the pool and the accounting are disabled.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/**
+ * @brief Set to 0 to keep the record buffers of the idle connections.
+ */
+#ifndef LLNET_SSL_MEMORY_RELEASE_BUFFERS
+#define LLNET_SSL_MEMORY_RELEASE_BUFFERS (1)
+#endif
+
+/**
+ * @brief Set to 0 to keep the OpenSSL allocation functions: no pool and no accounting.
+ */
+#ifndef LLNET_SSL_MEMORY_HOOKS_ENABLED
+#define LLNET_SSL_MEMORY_HOOKS_ENABLED (1)
+#endif
+
+/**
+ * @brief Minimum size in bytes of the blocks kept in the pool.
+ */
+#ifndef LLNET_SSL_MEMORY_POOL_MIN_BLOCK
+#define LLNET_SSL_MEMORY_POOL_MIN_BLOCK (4096)
+#endif
+
+/**
+ * @brief Maximum number of blocks kept in the pool. Set to 0 to disable the pool.
+ */
+#ifndef LLNET_SSL_MEMORY_POOL_BLOCKS
+#define LLNET_SSL_MEMORY_POOL_BLOCKS (16)
+#endif
+
+/**
+ * @brief Number of distinct block sizes kept in the pool.
+ */
+#ifndef LLNET_SSL_MEMORY_POOL_SIZES
+#define LLNET_SSL_MEMORY_POOL_SIZES (4)
+#endif
+
+/** @brief SSL memory statistics identifiers. */
+typedef enum {
+	LLNET_SSL_MEMORY_STAT_ALLOCATED_BYTES = 0, // bytes currently allocated
+	LLNET_SSL_MEMORY_STAT_PEAK_BYTES = 1, // maximum of the bytes allocated
+	LLNET_SSL_MEMORY_STAT_POOLED_BYTES = 2, // bytes of the blocks in the pool, global only
+	LLNET_SSL_MEMORY_STAT_POOL_HITS = 3, // allocations served by the pool, global only
+	LLNET_SSL_MEMORY_STAT_POOL_MISSES = 4, // allocations of pool-sized blocks not served by the pool, global only
+	LLNET_SSL_MEMORY_STATS_COUNT = 5
+} LLNET_SSL_MEMORY_stat_t;
+
+/** @brief Memory charged to a session. */
+typedef struct LLNET_SSL_MEMORY_account LLNET_SSL_MEMORY_account_t;
+
+#ifndef LLNET_SSL_MEMORY_IMPL_getStatistic
+#define LLNET_SSL_MEMORY_IMPL_getStatistic Java_com_microej_ssl_SSLMemory_getStatistic
+#endif
+
+/**
+ * @brief Native: gets an SSL memory statistic.
+ *
+ * @param[in] ssl the SSL session, or 0 for all the OpenSSL allocations.
+ * @param[in] id the statistic identifier, one of LLNET_SSL_MEMORY_stat_t.
+ *
+ * @return the statistic value, or -1 if the identifier is unknown or global only, the session has no account, or
+ * the allocation functions could not be replaced.
+ */
+int64_t LLNET_SSL_MEMORY_IMPL_getStatistic(int32_t ssl, int32_t id);
+
+/**
+ * @brief Replaces the OpenSSL allocation functions, if not done yet and still possible.
+ */
+void LLNET_SSL_MEMORY_initialize(void);
+
+/**
+ * @brief Configures the memory mode of the connections of a context.
+ *
+ * @param[in] ctx the SSL context.
+ */
+void LLNET_SSL_MEMORY_configure_context(SSL_CTX* ctx);
+
+/**
+ * @brief Creates an account, to charge the allocations of SSL_new() to before attaching it to the new session.
+ *
+ * @return the account, or NULL if out of memory or the allocation functions could not be replaced.
+ */
+LLNET_SSL_MEMORY_account_t* LLNET_SSL_MEMORY_create_account(void);
+
+/**
+ * @brief Attaches an account to a session, or frees it if the session could not be created.
+ *
+ * @param[in] ssl the SSL session, or NULL.
+ * @param[in] account the account, or NULL.
+ */
+void LLNET_SSL_MEMORY_attach(SSL* ssl, LLNET_SSL_MEMORY_account_t* account);
+
+/**
+ * @brief Detaches the account of a session, before freeing it. The account is freed with its last block.
+ *
+ * @param[in] ssl the SSL session.
+ */
+void LLNET_SSL_MEMORY_detach(SSL* ssl);
+
+/**
+ * @brief Gets the account of a session.
+ *
+ * @param[in] ssl the SSL session.
+ *
+ * @return the account, NULL if none.
+ */
+LLNET_SSL_MEMORY_account_t* LLNET_SSL_MEMORY_get_account(const SSL* ssl);
+
+/**
+ * @brief Sets the account the allocations of the calling thread are charged to.
+ *
+ * @param[in] account the account, NULL to stop charging.
+ */
+void LLNET_SSL_MEMORY_set_current_account(LLNET_SSL_MEMORY_account_t* account);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
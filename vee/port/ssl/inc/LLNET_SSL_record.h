@@ -0,0 +1,187 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#ifndef LLNET_SSL_RECORD
+#define LLNET_SSL_RECORD
+#include <sni.h>
+#include <stdint.h>
+#include <openssl/ssl.h>
+
+/**
+ * @file
+ * @brief LLNET SSL record layer tuning header.
+ *
+ * - Record sizing: the records sent are at most LLNET_SSL_RECORD_INITIAL_FRAGMENT bytes long (one TCP segment, so
+ *   the peer can decrypt the first bytes without waiting for a whole 16 KB record) until
+ *   LLNET_SSL_RECORD_BOOST_BYTES bytes have been sent, then LLNET_SSL_RECORD_MAX_SEND_FRAGMENT bytes long. The
+ *   small records are used again after LLNET_SSL_RECORD_IDLE_RESET_MS ms without write.
+ * - Write coalescing, enabled per connection: the application writes smaller than the free space of the current
+ *   record are copied to a buffer and sent as a single record when the buffer is full, on an explicit flush, before
+ *   a read or a shutdown, or on the first write after the coalescing deadline. The SSL sessions are only used from
+ *   the VM task, so the deadline does not trigger a flush by itself: there is no timer. An application that enables
+ *   the coalescing must call LLNET_SSL_RECORD_IMPL_flush() after the last write of a message, otherwise its last
+ *   bytes stay in the buffer until it writes, reads or closes the connection again.
+ * - Statistics: records sent and received (counted from the record headers seen by the OpenSSL message callback,
+ *   OpenSSL 1.1.1 or later), application bytes sent, SSL_write() calls, coalesced writes and flushes.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/**
+ * @brief Maximum size of the records sent, from 512 to 16384 bytes (SSL_CTX_set_max_send_fragment()).
+ */
+#ifndef LLNET_SSL_RECORD_MAX_SEND_FRAGMENT
+#define LLNET_SSL_RECORD_MAX_SEND_FRAGMENT (16384)
+#endif
+
+/**
+ * @brief Set to 1 to let OpenSSL read as many bytes as available from the socket, instead of one record at a time
+ * (SSL_CTX_set_read_ahead()).
+ */
+#ifndef LLNET_SSL_RECORD_READ_AHEAD
+#define LLNET_SSL_RECORD_READ_AHEAD (0)
+#endif
+
+/**
+ * @brief Set to 0 to always send records of LLNET_SSL_RECORD_MAX_SEND_FRAGMENT bytes.
+ */
+#ifndef LLNET_SSL_RECORD_DYNAMIC_SIZING
+#define LLNET_SSL_RECORD_DYNAMIC_SIZING (1)
+#endif
+
+/**
+ * @brief Size of the records sent at the start of a connection and after an idle period, from 512 bytes.
+ */
+#ifndef LLNET_SSL_RECORD_INITIAL_FRAGMENT
+#define LLNET_SSL_RECORD_INITIAL_FRAGMENT (1360)
+#endif
+
+/**
+ * @brief Number of application bytes sent with small records before switching to LLNET_SSL_RECORD_MAX_SEND_FRAGMENT.
+ */
+#ifndef LLNET_SSL_RECORD_BOOST_BYTES
+#define LLNET_SSL_RECORD_BOOST_BYTES (1024*1024)
+#endif
+
+/**
+ * @brief Idle time in milliseconds after which small records are used again.
+ */
+#ifndef LLNET_SSL_RECORD_IDLE_RESET_MS
+#define LLNET_SSL_RECORD_IDLE_RESET_MS (1000)
+#endif
+
+/** @brief SSL record statistics identifiers. */
+typedef enum {
+	LLNET_SSL_RECORD_STAT_RECORDS_SENT = 0,
+	LLNET_SSL_RECORD_STAT_RECORDS_RECEIVED = 1,
+	LLNET_SSL_RECORD_STAT_BYTES_SENT = 2, // application bytes
+	LLNET_SSL_RECORD_STAT_WRITE_CALLS = 3, // SSL_write() calls
+	LLNET_SSL_RECORD_STAT_COALESCED_WRITES = 4, // application writes copied to the coalescing buffer
+	LLNET_SSL_RECORD_STAT_FLUSHES = 5, // coalescing buffers sent
+	LLNET_SSL_RECORD_STATS_COUNT = 6
+} LLNET_SSL_RECORD_stat_t;
+
+#ifndef LLNET_SSL_RECORD_IMPL_getStatistic
+#define LLNET_SSL_RECORD_IMPL_getStatistic Java_com_microej_ssl_SSLRecordLayer_getStatistic
+#endif
+#ifndef LLNET_SSL_RECORD_IMPL_setCoalescing
+#define LLNET_SSL_RECORD_IMPL_setCoalescing Java_com_microej_ssl_SSLRecordLayer_setCoalescing
+#endif
+#ifndef LLNET_SSL_RECORD_IMPL_flush
+#define LLNET_SSL_RECORD_IMPL_flush Java_com_microej_ssl_SSLRecordLayer_flush
+#endif
+
+/**
+ * @brief Native: gets an SSL record statistic.
+ *
+ * @param[in] ssl the SSL session, or 0 for the global statistic (sessions freed included).
+ * @param[in] id the statistic identifier, one of LLNET_SSL_RECORD_stat_t.
+ *
+ * @return the statistic value, or -1 if the identifier is unknown or the session has no statistics.
+ */
+int64_t LLNET_SSL_RECORD_IMPL_getStatistic(int32_t ssl, int32_t id);
+
+/**
+ * @brief Native: enables or disables the write coalescing of a connection. Disabling it sends the pending bytes
+ * on the next write, flush, read or shutdown.
+ *
+ * @param[in] ssl the SSL session.
+ * @param[in] deadline_ms maximum time in milliseconds the bytes stay in the coalescing buffer when written to
+ * again, 0 to disable the coalescing.
+ *
+ * @warning The deadline is only checked on the next write: the bytes of the last write are not sent until an explicit
+ * LLNET_SSL_RECORD_IMPL_flush(), a read, a shutdown or another write.
+ *
+ * @note Throws NativeIOException if the coalescing buffer cannot be allocated.
+ */
+void LLNET_SSL_RECORD_IMPL_setCoalescing(int32_t ssl, int32_t deadline_ms);
+
+/**
+ * @brief Native: sends the bytes pending in the coalescing buffer of a connection.
+ *
+ * @param[in] ssl the SSL session.
+ * @param[in] fd the socket file descriptor.
+ * @param[in] absolute_java_start_time the time the Java operation started, in milliseconds.
+ * @param[in] relative_timeout the timeout in milliseconds, 0 for no timeout.
+ *
+ * @note Throws NativeIOException on error.
+ */
+void LLNET_SSL_RECORD_IMPL_flush(int32_t ssl, int32_t fd, int64_t absolute_java_start_time, int32_t relative_timeout);
+
+/**
+ * @brief Configures the record layer of a context and counts its records.
+ *
+ * @param[in] ctx the SSL context.
+ * @param[in] protocol the protocol of the context.
+ */
+void LLNET_SSL_RECORD_configure_context(SSL_CTX* ctx, int32_t protocol);
+
+/**
+ * @brief Creates the record layer state of a session. If it cannot be allocated, the session uses the OpenSSL
+ * defaults, with no coalescing and no statistics.
+ *
+ * @param[in] ssl the SSL session.
+ */
+void LLNET_SSL_RECORD_attach(SSL* ssl);
+
+/**
+ * @brief Frees the record layer state of a session. The bytes pending in the coalescing buffer are dropped.
+ *
+ * @param[in] ssl the SSL session.
+ */
+void LLNET_SSL_RECORD_detach(SSL* ssl);
+
+/**
+ * @brief Writes application bytes, through the coalescing buffer if enabled.
+ *
+ * @param[in] ssl the SSL session.
+ * @param[in] data the bytes.
+ * @param[in] length the number of bytes.
+ *
+ * @return the number of bytes written or buffered, or the SSL_write() result on error, to give to SSL_get_error().
+ */
+int32_t LLNET_SSL_RECORD_write(SSL* ssl, const uint8_t* data, int32_t length);
+
+/**
+ * @brief Sends the bytes pending in the coalescing buffer, if any.
+ *
+ * @param[in] ssl the SSL session.
+ *
+ * @return 1 if no byte is pending anymore, or the SSL_write() result on error, to give to SSL_get_error().
+ */
+int32_t LLNET_SSL_RECORD_flush_pending(SSL* ssl);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
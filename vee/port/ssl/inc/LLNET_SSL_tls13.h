@@ -0,0 +1,175 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#ifndef LLNET_SSL_TLS13
+#define LLNET_SSL_TLS13
+#include <sni.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <LLNET_SSL_CONSTANTS.h>
+#include <openssl/ssl.h>
+
+/**
+ * @file
+ * @brief LLNET SSL TLS 1.3 header: session resumption and 0-RTT early data.
+ *
+ * Requires OpenSSL 1.1.1 or later, otherwise TLSv1_3_PROTOCOL contexts cannot be created and the natives report no
+ * early data.
+ *
+ * - Resumption: the client contexts keep the last resumable session of each server host name (SNI), up to
+ *   LLNET_SSL_TLS13_SESSION_CACHE_SIZE host names. A new client session with the same host name resumes it, with a
+ *   1-RTT PSK handshake in TLS 1.3. TLS 1.3 tickets are used only once.
+ * - 0-RTT: before the handshake of a resumed session, a client can send idempotent requests as early data. The
+ *   server accepts up to LLNET_SSL_TLS13_MAX_EARLY_DATA bytes of early data, read before the handshake. OpenSSL
+ *   anti-replay protection is kept: the server session cache lets each ticket be used for early data only once,
+ *   and early data with a ticket no longer in the cache is rejected.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/**
+ * @brief TLS 1.3 protocol identifier, if not defined by the Java library.
+ */
+#ifndef TLSv1_3_PROTOCOL
+#define TLSv1_3_PROTOCOL (6)
+#endif
+
+/**
+ * @brief Number of server host names whose session is kept by a client context, 0 to disable the resumption.
+ */
+#ifndef LLNET_SSL_TLS13_SESSION_CACHE_SIZE
+#define LLNET_SSL_TLS13_SESSION_CACHE_SIZE (8)
+#endif
+
+/**
+ * @brief Maximum number of early data bytes accepted by a server context, 0 to reject early data.
+ */
+#ifndef LLNET_SSL_TLS13_MAX_EARLY_DATA
+#define LLNET_SSL_TLS13_MAX_EARLY_DATA (0)
+#endif
+
+/**
+ * @brief Number of sessions kept by a server context. The anti-replay protection rejects early data once the
+ * session of the ticket has been evicted.
+ */
+#ifndef LLNET_SSL_TLS13_SERVER_CACHE_SIZE
+#define LLNET_SSL_TLS13_SERVER_CACHE_SIZE (256)
+#endif
+
+/*
+ * Define LLNET_SSL_TLS13_CIPHERSUITES to a colon-separated list to replace the OpenSSL default TLS 1.3 cipher suites.
+ */
+
+/** @brief Early data status, the SSL_get_early_data_status() values. */
+#define LLNET_SSL_TLS13_EARLY_DATA_NOT_SENT (0)
+#define LLNET_SSL_TLS13_EARLY_DATA_REJECTED (1)
+#define LLNET_SSL_TLS13_EARLY_DATA_ACCEPTED (2)
+
+#ifndef LLNET_SSL_TLS13_IMPL_writeEarlyData
+#define LLNET_SSL_TLS13_IMPL_writeEarlyData Java_com_microej_ssl_TLS13_writeEarlyData
+#endif
+#ifndef LLNET_SSL_TLS13_IMPL_readEarlyData
+#define LLNET_SSL_TLS13_IMPL_readEarlyData Java_com_microej_ssl_TLS13_readEarlyData
+#endif
+#ifndef LLNET_SSL_TLS13_IMPL_getEarlyDataStatus
+#define LLNET_SSL_TLS13_IMPL_getEarlyDataStatus Java_com_microej_ssl_TLS13_getEarlyDataStatus
+#endif
+#ifndef LLNET_SSL_TLS13_IMPL_isSessionReused
+#define LLNET_SSL_TLS13_IMPL_isSessionReused Java_com_microej_ssl_TLS13_isSessionReused
+#endif
+
+/**
+ * @brief Native: client side, sends early data before the handshake. To be used for idempotent requests only: the
+ * server may reject the early data, then the bytes must be sent again after the handshake.
+ *
+ * @param[in] ssl the SSL session, not handshaken yet.
+ * @param[in] fd the socket file descriptor.
+ * @param[in] buffer the bytes.
+ * @param[in] offset the offset of the first byte.
+ * @param[in] length the number of bytes.
+ * @param[in] absolute_java_start_time the time the Java operation started, in milliseconds.
+ * @param[in] relative_timeout the timeout in milliseconds, 0 for no timeout.
+ *
+ * @return the number of bytes sent as early data, 0 if the session cannot send early data (not resumed, or the
+ * server does not accept early data).
+ *
+ * @note Throws NativeIOException on error.
+ */
+int32_t LLNET_SSL_TLS13_IMPL_writeEarlyData(int32_t ssl, int32_t fd, int8_t* buffer, int32_t offset, int32_t length,
+                                            int64_t absolute_java_start_time, int32_t relative_timeout);
+
+/**
+ * @brief Native: server side, reads early data before the handshake. Once it returns -1, the handshake is completed
+ * with LLNET_SSL_SOCKET_IMPL_initialServerHandShake().
+ *
+ * @param[in] ssl the SSL session, not handshaken yet.
+ * @param[in] fd the socket file descriptor.
+ * @param[in] buffer the destination buffer.
+ * @param[in] offset the offset in the buffer.
+ * @param[in] length the maximum number of bytes to read.
+ * @param[in] absolute_java_start_time the time the Java operation started, in milliseconds.
+ * @param[in] relative_timeout the timeout in milliseconds, 0 for no timeout.
+ *
+ * @return the number of bytes read, or -1 if there is no more early data.
+ *
+ * @note Throws NativeIOException on error.
+ */
+int32_t LLNET_SSL_TLS13_IMPL_readEarlyData(int32_t ssl, int32_t fd, int8_t* buffer, int32_t offset, int32_t length,
+                                           int64_t absolute_java_start_time, int32_t relative_timeout);
+
+/**
+ * @brief Native: gets the early data status of a session, after the handshake.
+ *
+ * @param[in] ssl the SSL session.
+ *
+ * @return one of LLNET_SSL_TLS13_EARLY_DATA_NOT_SENT, LLNET_SSL_TLS13_EARLY_DATA_REJECTED or
+ * LLNET_SSL_TLS13_EARLY_DATA_ACCEPTED.
+ */
+int32_t LLNET_SSL_TLS13_IMPL_getEarlyDataStatus(int32_t ssl);
+
+/**
+ * @brief Native: tells whether the handshake of a session resumed a previous session.
+ *
+ * @param[in] ssl the SSL session.
+ *
+ * @return true if the session was resumed.
+ */
+bool LLNET_SSL_TLS13_IMPL_isSessionReused(int32_t ssl);
+
+/**
+ * @brief Configures the session resumption and early data of a context.
+ *
+ * @param[in] ctx the SSL context.
+ * @param[in] protocol the protocol of the context.
+ * @param[in] is_client true for a client context.
+ */
+void LLNET_SSL_TLS13_configure_context(SSL_CTX* ctx, int32_t protocol, bool is_client);
+
+/**
+ * @brief Frees the sessions kept by a context, before freeing it.
+ *
+ * @param[in] ctx the SSL context.
+ */
+void LLNET_SSL_TLS13_release(SSL_CTX* ctx);
+
+/**
+ * @brief Client side, sets the session kept for the host name of a new session, if any.
+ *
+ * @param[in] ssl the new SSL session, with its host name set.
+ */
+void LLNET_SSL_TLS13_resume(SSL* ssl);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#ifndef LLNET_SSL_TRUST_STORE
+#define LLNET_SSL_TRUST_STORE
+#include <sni.h>
+#include <stdint.h>
+#include <openssl/ssl.h>
+
+/**
+ * @file
+ * @brief LLNET SSL shared trust store header.
+ *
+ * The trusted certificates are parsed once: a process-wide cache maps the SHA-256 hash of the encoded certificate
+ * to its X509 object, shared by all the contexts that trust it. Each context only records its set of trusted
+ * certificates. When the first SSL session is created after the set changed, the context is bound to the shared
+ * X509_STORE holding exactly that set, which is built on first use and reference counted. Shared stores are not
+ * modified once built.
+ *
+ * Contexts bound to a shared store cache the successful verifications of the peer certificate chains for
+ * LLNET_SSL_TRUST_STORE_VERIFY_CACHE_TTL_S seconds, keyed by the store and the hashes of the chain certificates.
+ *
+ * Requires OpenSSL 1.1.0 or later; with older versions, the certificates are added to the store of each context.
+ *
+ * All the functions must be called from the VM task.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/**
+ * @brief Number of buckets of the certificate cache.
+ */
+#ifndef LLNET_SSL_TRUST_STORE_CERT_BUCKETS
+#define LLNET_SSL_TRUST_STORE_CERT_BUCKETS (256)
+#endif
+
+/**
+ * @brief Number of chain verification results cached. Set to 0 to disable the verification cache.
+ */
+#ifndef LLNET_SSL_TRUST_STORE_VERIFY_CACHE_SIZE
+#define LLNET_SSL_TRUST_STORE_VERIFY_CACHE_SIZE (64)
+#endif
+
+/**
+ * @brief Time to live in seconds of a cached chain verification result.
+ */
+#ifndef LLNET_SSL_TRUST_STORE_VERIFY_CACHE_TTL_S
+#define LLNET_SSL_TRUST_STORE_VERIFY_CACHE_TTL_S (600)
+#endif
+
+/**
+ * @brief Adds a trusted certificate to a context.
+ *
+ * @param[in] ctx the SSL context.
+ * @param[in] cert the encoded certificate, PEM or DER.
+ * @param[in] cert_size the certificate length.
+ *
+ * @return J_SSL_NO_ERROR on success, J_CERT_PARSE_ERROR if the certificate cannot be parsed, J_MEMORY_ERROR if
+ * out of memory.
+ */
+int32_t LLNET_SSL_TRUST_STORE_add(SSL_CTX* ctx, const uint8_t* cert, int32_t cert_size);
+
+/**
+ * @brief Removes all the trusted certificates of a context.
+ *
+ * @param[in] ctx the SSL context.
+ */
+void LLNET_SSL_TRUST_STORE_clear(SSL_CTX* ctx);
+
+/**
+ * @brief Binds a context to the shared store of its trusted certificates, if they changed since the last call.
+ * Must be called before creating an SSL session.
+ *
+ * @param[in] ctx the SSL context.
+ *
+ * @return J_SSL_NO_ERROR on success, J_MEMORY_ERROR if out of memory.
+ */
+int32_t LLNET_SSL_TRUST_STORE_bind(SSL_CTX* ctx);
+
+/**
+ * @brief Releases the trusted certificates and the shared store of a context. Must be called before freeing it.
+ *
+ * @param[in] ctx the SSL context.
+ */
+void LLNET_SSL_TRUST_STORE_release(SSL_CTX* ctx);
+
+#ifdef __cplusplus
+	}
+#endif
+
+#endif
@@ -8,6 +8,11 @@
 #include <LLNET_SSL_CONSTANTS.h>
 #include <LLNET_SSL_ERRORS.h>
 #include <LLNET_SSL_cookie.h>
+#include <LLNET_SSL_ktls.h>
+#include <LLNET_SSL_memory.h>
+#include <LLNET_SSL_record.h>
+#include <LLNET_SSL_tls13.h>
+#include <LLNET_SSL_trust_store.h>
 #include <LLNET_SSL_util.h>
 #include <openssl/ssl.h>
 #include <openssl/x509_vfy.h>
@@ -41,6 +46,11 @@ static int32_t LLNET_SSL_CONTEXT_setContextVersion(SSL_CTX* ctx, int32_t protoco
 		case TLSv1_2_PROTOCOL:
 			version = TLS1_2_VERSION;
 			break;
+#ifdef TLS1_3_VERSION
+		case TLSv1_3_PROTOCOL:
+			version = TLS1_3_VERSION;
+			break;
+#endif
 		case DTLSv1_PROTOCOL:
 			version = DTLS1_VERSION;
 			break;
@@ -104,6 +114,9 @@ static int32_t LLNET_SSL_CONTEXT_IMPL_createClientContext(int32_t protocol) {
 		case TLSv1_PROTOCOL:
 		case TLSv1_1_PROTOCOL:
 		case TLSv1_2_PROTOCOL:
+#ifdef TLS1_3_VERSION
+		case TLSv1_3_PROTOCOL:
+#endif
 			ctx = SSL_CTX_new(TLS_client_method());
 			break;
 		case DTLSv1_PROTOCOL:
@@ -127,6 +140,10 @@ static int32_t LLNET_SSL_CONTEXT_IMPL_createClientContext(int32_t protocol) {
 
 	LLNET_SSL_DEBUG_TRACE("(method=%d) return ctx=%p\n", protocol,ctx);
 	if(ctx != NULL){
+		LLNET_SSL_KTLS_enable(ctx, protocol);
+		LLNET_SSL_RECORD_configure_context(ctx, protocol);
+		LLNET_SSL_MEMORY_configure_context(ctx);
+		LLNET_SSL_TLS13_configure_context(ctx, protocol, true);
 		ret = (int32_t)ctx;
 	} else {
 		(void)SNI_throwNativeIOException(J_UNKNOWN_ERROR, "Unknown error");
@@ -180,6 +197,9 @@ static int32_t LLNET_SSL_CONTEXT_IMPL_createServerContext(int32_t protocol) {
 		case TLSv1_PROTOCOL:
 		case TLSv1_1_PROTOCOL:
 		case TLSv1_2_PROTOCOL:
+#ifdef TLS1_3_VERSION
+		case TLSv1_3_PROTOCOL:
+#endif
 			ctx = SSL_CTX_new(TLS_server_method());
 			break;
 		case DTLSv1_PROTOCOL:
@@ -205,6 +225,10 @@ static int32_t LLNET_SSL_CONTEXT_IMPL_createServerContext(int32_t protocol) {
 
 	LLNET_SSL_DEBUG_TRACE("(method=%d) return ctx=%p\n", protocol,ctx);
 	if(ctx != NULL){
+		LLNET_SSL_KTLS_enable(ctx, protocol);
+		LLNET_SSL_RECORD_configure_context(ctx, protocol);
+		LLNET_SSL_MEMORY_configure_context(ctx);
+		LLNET_SSL_TLS13_configure_context(ctx, protocol, false);
 		ret = (int32_t)ctx;
 	} else {
 		(void)SNI_throwNativeIOException(J_UNKNOWN_ERROR, "Unknown error");
@@ -216,36 +240,10 @@ static int32_t LLNET_SSL_CONTEXT_IMPL_createServerContext(int32_t protocol) {
 
 void LLNET_SSL_CONTEXT_IMPL_addTrustedCertificate(int32_t context, uint8_t *cert, int32_t cert_size, int32_t format) {
 	LLNET_SSL_DEBUG_TRACE_INFO("context=%d, cert=0x%x, cert_size=%d, format=%d\n", context, cert, cert_size, format);
-	int32_t ret = J_SSL_NO_ERROR;
+	(void)format;
 	SSL_CTX* ssl_context = (SSL_CTX*)context;
-	X509* x509 = LLNET_SSL_X509_CERT_create(cert, 0, cert_size, &format);
-
-	if(x509 != NULL){
-		// The certificate has been created: add it the store of the context (create the store if needed).
-		X509_STORE* store = SSL_CTX_get_cert_store(ssl_context);
-		if(store == NULL){
-			// No store for the context: create it
-			store = X509_STORE_new();
-			if (store != NULL) {
-				SSL_CTX_set_cert_store(ssl_context, store);
-			} else {
-				X509_free(x509);
-				ret = J_CERT_PARSE_ERROR;
-			}
-		}
-
-		if (store != NULL) {
-			// Store has been created or was retrieved
-			int e_add_cert = X509_STORE_add_cert(store, x509);
-			// Note: I suppose that X509_STORE_add_cert returns 0 on success.
-			// This is specified neither in the man page nor in the header file ???
-			if (e_add_cert <= 0) {
-				ret = J_CERT_PARSE_ERROR;
-			}
-		}
-	} else {
-		ret = J_CERT_PARSE_ERROR;
-	}
+	// The certificate is parsed once and shared by all the contexts that trust it
+	int32_t ret = LLNET_SSL_TRUST_STORE_add(ssl_context, cert, cert_size);
 
 	if (ret != J_SSL_NO_ERROR) {
 		(void)SNI_throwNativeIOException(ret, "Error adding trusted certificate");
@@ -374,15 +372,15 @@ int32_t LLNET_SSL_CONTEXT_IMPL_createContext(int32_t protocol, uint8_t is_client
 void LLNET_SSL_CONTEXT_IMPL_clearTrustStore(int32_t context){
 	LLNET_SSL_DEBUG_TRACE("%s\n", __func__);
 	SSL_CTX* ssl_context = (SSL_CTX*)context;
-	// Set an empty store to the context.
-	// The function SSL_CTX_set_cert_store() frees previously allocated
-	// store if any.
-	SSL_CTX_set_cert_store(ssl_context, X509_STORE_new());
+	// The context is bound to the shared store of its new set of certificates when the next session is created.
+	LLNET_SSL_TRUST_STORE_clear(ssl_context);
 	return;
 }
 
 void LLNET_SSL_CONTEXT_IMPL_freeContext(int32_t context) {
 	LLNET_SSL_DEBUG_TRACE("(context=%p)\n", (SSL_CTX*) context);
+	LLNET_SSL_TRUST_STORE_release((SSL_CTX*) context);
+	LLNET_SSL_TLS13_release((SSL_CTX*) context);
 	(void)SSL_CTX_free((SSL_CTX*) context);
 }
 
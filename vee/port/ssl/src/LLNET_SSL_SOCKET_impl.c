@@ -17,6 +17,12 @@
 #include <LLNET_SSL_ERRORS.h>
 #include <LLNET_CHANNEL_impl.h>
 #include <LLNET_SSL_verifyCallback.h>
+#include <LLNET_SSL_ktls.h>
+#include <LLNET_SSL_handshake_worker.h>
+#include <LLNET_SSL_memory.h>
+#include <LLNET_SSL_record.h>
+#include <LLNET_SSL_tls13.h>
+#include <LLNET_SSL_trust_store.h>
 #include <LLNET_Common.h>
 #include <LLSEC_ERRORS.h>
 
@@ -36,13 +42,21 @@
  * Static functions
 */
 static void LLNET_SSL_SOCKET_IMPL_initial_handshake(int32_t ssl, int32_t fd, int64_t absolute_java_start_time, int32_t relative_timeout, bool is_client);
+static void LLNET_SSL_SOCKET_IMPL_clientHandShake_on_done(int32_t ssl, int32_t fd, int64_t absolute_java_start_time, int32_t relative_timeout);
+static void LLNET_SSL_SOCKET_IMPL_serverHandShake_on_done(int32_t ssl, int32_t fd, int64_t absolute_java_start_time, int32_t relative_timeout);
+static void LLNET_SSL_SOCKET_IMPL_handshake_on_done(int32_t ssl, int32_t fd, int64_t absolute_java_start_time, int32_t relative_timeout, bool is_client);
+static void LLNET_SSL_SOCKET_IMPL_handshake_step_done(int32_t ssl, int32_t fd, int64_t absolute_java_start_time, int32_t relative_timeout,
+                                                      SNI_callback callback, int32_t ret, int32_t ssl_error, int32_t error_code, int32_t fd_errno);
 
 void LLNET_SSL_SOCKET_IMPL_initialize(void) {
 	LLNET_SSL_DEBUG_TRACE("\n");
+	// Before any OpenSSL allocation
+	LLNET_SSL_MEMORY_initialize();
 	(void)SSL_library_init();
 #ifdef LLNET_SSL_DEBUG
 	SSL_load_error_strings();
 #endif
+	LLNET_SSL_HANDSHAKE_WORKER_initialize();
 	return;
 }
 
@@ -54,10 +68,20 @@ int32_t LLNET_SSL_SOCKET_IMPL_create(int32_t context, int32_t fd, uint8_t* host_
 
 	LLNET_SSL_DEBUG_TRACE("(context=%d, fd=%d)\n", context, fd);
 
-	/* create new SSL session */
-	ssl = SSL_new(ctx);
+	/* create new SSL session, using the shared store of the trusted certificates of the context */
+	if (LLNET_SSL_TRUST_STORE_bind(ctx) == J_SSL_NO_ERROR) {
+		// charge the session structures to the account of the new session
+		LLNET_SSL_MEMORY_account_t* account = LLNET_SSL_MEMORY_create_account();
+		LLNET_SSL_MEMORY_set_current_account(account);
+		ssl = SSL_new(ctx);
+		LLNET_SSL_MEMORY_set_current_account(NULL);
+		LLNET_SSL_MEMORY_attach(ssl, account);
+	} else {
+		ssl = NULL;
+	}
 	if (ssl != NULL) {
 		if (SSL_set_fd(ssl, fd) != 1) {
+			LLNET_SSL_MEMORY_detach(ssl);
 			SSL_free(ssl);
 			(void)SNI_throwNativeIOException(J_UNKNOWN_ERROR, "Error setting file descriptor");
 		} else {
@@ -71,6 +95,11 @@ int32_t LLNET_SSL_SOCKET_IMPL_create(int32_t context, int32_t fd, uint8_t* host_
 			if ((NULL != host_name) && (hostname_len > 0)) {
 				(void)SSL_set_tlsext_host_name(ssl, (char*)host_name);
 			}
+			if (is_client_mode) {
+				//resume the last session with this host, if any
+				LLNET_SSL_TLS13_resume(ssl);
+			}
+			LLNET_SSL_RECORD_attach(ssl);
 			ret = (int32_t)ssl;
 		}
 	} else {
@@ -98,35 +127,95 @@ static void LLNET_SSL_SOCKET_IMPL_initial_handshake(int32_t ssl, int32_t fd, int
 		(void)SNI_throwNativeIOException(J_SOCKET_ERROR, "Could not set socket non blocking");
 	}
 
-	//initiates handshake in non-blocking mode
 	if (is_client) {
 		callback = (SNI_callback)LLNET_SSL_SOCKET_IMPL_initialClientHandShake;
-		ret = SSL_connect((SSL*)ssl);
 	} else {
 		callback = (SNI_callback)LLNET_SSL_SOCKET_IMPL_initialServerHandShake;
-		ret = SSL_accept((SSL*)ssl);
 	}
 
-	//reset non-blocking mode
-	if (LLNET_set_non_blocking(fd) < 0) {
-		(void)SNI_throwNativeIOException(J_SOCKET_ERROR, "Could not set socket non blocking");
+	if (LLNET_SSL_HANDSHAKE_WORKER_is_started()) {
+		//the handshake step runs on a worker, the result is handled when the Java thread is resumed
+		SNI_callback on_done_callback = is_client ? (SNI_callback)LLNET_SSL_SOCKET_IMPL_clientHandShake_on_done
+		                                          : (SNI_callback)LLNET_SSL_SOCKET_IMPL_serverHandShake_on_done;
+		LLNET_SSL_HANDSHAKE_WORKER_exec((SSL*)ssl, is_client, callback, on_done_callback);
+	} else {
+		//initiates handshake in non-blocking mode
+		LLNET_SSL_MEMORY_set_current_account(LLNET_SSL_MEMORY_get_account((SSL*)ssl));
+		if (is_client) {
+			ret = SSL_connect((SSL*)ssl);
+		} else {
+			ret = SSL_accept((SSL*)ssl);
+		}
+		LLNET_SSL_MEMORY_set_current_account(NULL);
+
+		//reset non-blocking mode
+		if (LLNET_set_non_blocking(fd) < 0) {
+			(void)SNI_throwNativeIOException(J_SOCKET_ERROR, "Could not set socket non blocking");
+		}
+
+		if (ret != 1) {
+			int32_t ssl_error = SSL_get_error((SSL*)ssl, ret);
+			LLNET_SSL_SOCKET_IMPL_handshake_step_done(ssl, fd, absolute_java_start_time, relative_timeout, callback, ret,
+			                                          ssl_error, LLNET_SSL_TranslateReturnCode((SSL*)ssl, ret), llnet_errno(fd));
+		} else {
+			LLNET_SSL_SOCKET_IMPL_handshake_step_done(ssl, fd, absolute_java_start_time, relative_timeout, callback, ret,
+			                                          SSL_ERROR_NONE, J_SSL_NO_ERROR, 0);
+		}
+	}
+}
+
+static void LLNET_SSL_SOCKET_IMPL_clientHandShake_on_done(int32_t ssl, int32_t fd, int64_t absolute_java_start_time, int32_t relative_timeout) {
+	LLNET_SSL_SOCKET_IMPL_handshake_on_done(ssl, fd, absolute_java_start_time, relative_timeout, true);
+}
+
+static void LLNET_SSL_SOCKET_IMPL_serverHandShake_on_done(int32_t ssl, int32_t fd, int64_t absolute_java_start_time, int32_t relative_timeout) {
+	LLNET_SSL_SOCKET_IMPL_handshake_on_done(ssl, fd, absolute_java_start_time, relative_timeout, false);
+}
+
+/**
+ * Handles the result of a handshake step done by a handshake worker.
+ */
+static void LLNET_SSL_SOCKET_IMPL_handshake_on_done(int32_t ssl, int32_t fd, int64_t absolute_java_start_time, int32_t relative_timeout, bool is_client) {
+	LLNET_SSL_HANDSHAKE_job_t result;
+	SNI_callback callback = is_client ? (SNI_callback)LLNET_SSL_SOCKET_IMPL_initialClientHandShake
+	                                  : (SNI_callback)LLNET_SSL_SOCKET_IMPL_initialServerHandShake;
+
+	if (LLNET_SSL_HANDSHAKE_WORKER_get_result(&result)) {
+		if (result.closed) {
+			// The free was deferred by LLNET_SSL_SOCKET_IMPL_freeSSL() during the step
+			LLNET_SSL_SOCKET_IMPL_freeSSL(ssl);
+			(void)SNI_throwNativeIOException(J_SOCKET_ERROR, "Socket closed during initial handshake");
+		} else {
+			LLNET_SSL_SOCKET_IMPL_handshake_step_done(ssl, fd, absolute_java_start_time, relative_timeout, callback,
+			                                          result.ret, result.ssl_error, result.error_code, result.sys_errno);
+		}
+	} else {
+		(void)SNI_throwNativeIOException(J_UNKNOWN_ERROR, "Initial handshake error");
 	}
+}
 
+/**
+ * Completes a handshake step: waits for the socket if the handshake needs more data, throws an exception on error.
+ */
+static void LLNET_SSL_SOCKET_IMPL_handshake_step_done(int32_t ssl, int32_t fd, int64_t absolute_java_start_time, int32_t relative_timeout,
+                                                      SNI_callback callback, int32_t ret, int32_t ssl_error, int32_t error_code, int32_t fd_errno) {
 	if (ret != 1) {
-		int32_t ssl_error = SSL_get_error((SSL*)ssl, ret);
 		int64_t absolute_timeout_ms = 0;
 		if (0 != relative_timeout) {
 			absolute_timeout_ms = absolute_java_start_time + (int64_t) relative_timeout;
 		}
 
 		if (ssl_error == SSL_ERROR_WANT_READ) {
-			LLNET_handle_blocking_operation_error(fd, llnet_errno(fd), SELECT_READ, absolute_timeout_ms, callback, NULL);
+			LLNET_handle_blocking_operation_error(fd, fd_errno, SELECT_READ, absolute_timeout_ms, callback, NULL);
 		} else if (ssl_error == SSL_ERROR_WANT_WRITE) {
-			LLNET_handle_blocking_operation_error(fd, llnet_errno(fd), SELECT_WRITE, absolute_timeout_ms, callback, NULL);
+			LLNET_handle_blocking_operation_error(fd, fd_errno, SELECT_WRITE, absolute_timeout_ms, callback, NULL);
 		} else {
 			LLNET_SSL_DEBUG_PRINT_ERR();
-			(void)SNI_throwNativeIOException(LLNET_SSL_TranslateReturnCode((SSL*)ssl, ssl_error), "Initial handshake error");
+			(void)SNI_throwNativeIOException(error_code, "Initial handshake error");
 		}
+	} else {
+		LLNET_SSL_DEBUG_TRACE_INFO("(ssl=0x%x, fd=%d) handshake done, kTLS status=0x%x\n", ssl, fd,
+		                           LLNET_SSL_KTLS_get_status((SSL*)ssl));
 	}
 }
 
@@ -144,7 +233,13 @@ int32_t LLNET_SSL_SOCKET_IMPL_read(int32_t ssl, int32_t fd, int8_t *buffer, int3
 	int shutdown_status = SSL_get_shutdown((SSL *)ssl);
 	//non-blocking read
 	if (((SSL *)ssl != NULL) && (shutdown_status == 0)) {
-		ret = SSL_read((SSL *)ssl, buffer + offset, length);
+		// Send the bytes pending in the coalescing buffer first: the peer may wait for them before answering
+		ret = LLNET_SSL_RECORD_flush_pending((SSL *)ssl);
+		if (ret > 0) {
+			LLNET_SSL_MEMORY_set_current_account(LLNET_SSL_MEMORY_get_account((SSL *)ssl));
+			ret = SSL_read((SSL *)ssl, buffer + offset, length);
+			LLNET_SSL_MEMORY_set_current_account(NULL);
+		}
 	}
 
 	//reset non-blocking mode
@@ -188,7 +283,7 @@ int32_t LLNET_SSL_SOCKET_IMPL_write(int32_t ssl, int32_t fd, int8_t* buffer, int
 	}
 
 	//non-blocking read
-	ret = SSL_write((SSL*)ssl, buffer+offset, length);
+	ret = LLNET_SSL_RECORD_write((SSL*)ssl, (uint8_t*)buffer+offset, length);
 
 	//reset non-blocking mode
 	if (LLNET_set_non_blocking(fd) < 0) {
@@ -234,7 +329,14 @@ int32_t LLNET_SSL_SOCKET_IMPL_available(int32_t ssl){
 void LLNET_SSL_SOCKET_IMPL_freeSSL(int32_t ssl_id) {
 	LLNET_SSL_DEBUG_TRACE("(ssl=0x%x)\n", ssl_id);
 	SSL* ssl = (SSL*)ssl_id;
-	(void)SSL_free(ssl);
+	if (LLNET_SSL_HANDSHAKE_WORKER_defer_free(ssl)) {
+		// A worker runs a handshake step on the session: freed when the handshake Java thread gets the result
+		LLNET_SSL_DEBUG_TRACE("(ssl=0x%x) handshake in progress, free deferred\n", ssl_id);
+	} else {
+		LLNET_SSL_RECORD_detach(ssl);
+		LLNET_SSL_MEMORY_detach(ssl);
+		(void)SSL_free(ssl);
+	}
 	return;
 }
 
@@ -244,29 +346,45 @@ void LLNET_SSL_SOCKET_IMPL_shutdown(int32_t ssl_id, int32_t fd, bool autoclose,
 	                      autoclose ? "true" : "false", absolute_java_start_time, relative_timeout);
 	SSL *ssl = (SSL *)ssl_id;
 
-	// Send close notify
-	int ret = SSL_shutdown(ssl);
+	int64_t absolute_timeout_ms = 0;
+	if (0 != relative_timeout) {
+		absolute_timeout_ms = absolute_java_start_time + (int64_t)relative_timeout;
+	}
+
+	if (LLNET_SSL_HANDSHAKE_WORKER_is_busy(ssl)) {
+		// A worker runs a handshake step on the session: no close notify before the end of the handshake
+		LLNET_SSL_DEBUG_TRACE("handshake in progress, no close notify\n");
+		return;
+	}
 
-	// Wait for peer close notify
-	if ((0 == ret) && !autoclose) {
+	// Send the bytes pending in the coalescing buffer before the close notify
+	int ret = LLNET_SSL_RECORD_flush_pending(ssl);
+	if ((ret <= 0) && (SSL_ERROR_WANT_WRITE == SSL_get_error(ssl, ret))) {
+		LLNET_handle_blocking_operation_error(fd, llnet_errno(fd), SELECT_WRITE, absolute_timeout_ms,
+		                                      (SNI_callback)LLNET_SSL_SOCKET_IMPL_shutdown, NULL);
+	} else {
+		LLNET_SSL_MEMORY_set_current_account(LLNET_SSL_MEMORY_get_account(ssl));
+		// Send close notify
 		ret = SSL_shutdown(ssl);
-		if (1 != ret) {
-			int ssl_error = SSL_get_error(ssl, ret);
-			if (SSL_ERROR_WANT_READ == ssl_error) {
-				int64_t absolute_timeout_ms = 0;
-				if (0 != relative_timeout) {
-					absolute_timeout_ms = absolute_java_start_time + (int64_t)relative_timeout;
+
+		// Wait for peer close notify
+		if ((0 == ret) && !autoclose) {
+			ret = SSL_shutdown(ssl);
+			if (1 != ret) {
+				int ssl_error = SSL_get_error(ssl, ret);
+				if (SSL_ERROR_WANT_READ == ssl_error) {
+					LLNET_handle_blocking_operation_error(fd, llnet_errno(fd), SELECT_READ, absolute_timeout_ms,
+					                                      (SNI_callback)LLNET_SSL_SOCKET_IMPL_shutdown, NULL);
+				} else {
+					(void)SNI_throwNativeIOException(LLNET_SSL_TranslateReturnCode(ssl, ret), "Error during shutdown");
 				}
-				LLNET_handle_blocking_operation_error(fd, llnet_errno(fd), SELECT_READ, absolute_timeout_ms,
-				                                      (SNI_callback)LLNET_SSL_SOCKET_IMPL_shutdown, NULL);
 			} else {
-				(void)SNI_throwNativeIOException(LLNET_SSL_TranslateReturnCode(ssl, ret), "Error during shutdown");
+				LLNET_SSL_DEBUG_TRACE("Shutdown successful\n");
 			}
 		} else {
 			LLNET_SSL_DEBUG_TRACE("Shutdown successful\n");
 		}
-	} else {
-		LLNET_SSL_DEBUG_TRACE("Shutdown successful\n");
+		LLNET_SSL_MEMORY_set_current_account(NULL);
 	}
 }
 
@@ -0,0 +1,310 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <LLNET_SSL_handshake_worker.h>
+#include <LLNET_SSL_CONSTANTS.h>
+#include <LLNET_SSL_ERRORS.h>
+#include <LLNET_SSL_memory.h>
+#include <LLNET_SSL_util.h>
+#include <openssl/crypto.h>
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+#include <errno.h>
+
+/**
+ * @file
+ * @brief LLNET SSL handshake workers implementation.
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+#if LLNET_SSL_HANDSHAKE_WORKER_ENABLED == 1
+/*
+ * See implementations for descriptions.
+ */
+static void LLNET_SSL_HANDSHAKE_WORKER_action(MICROEJ_ASYNC_WORKER_job_t* job);
+static int32_t LLNET_SSL_HANDSHAKE_WORKER_select(void);
+static void* LLNET_SSL_HANDSHAKE_WORKER_get_state(SSL* ssl);
+static void LLNET_SSL_HANDSHAKE_WORKER_up_ref(SSL* ssl);
+static bool LLNET_SSL_HANDSHAKE_WORKER_release(SSL* ssl);
+
+/* Async worker tasks declaration --------------------------------------------*/
+MICROEJ_ASYNC_WORKER_worker_declare(llnet_ssl_handshake_worker_0, LLNET_SSL_HANDSHAKE_WORKER_JOB_COUNT, LLNET_SSL_HANDSHAKE_job_t, LLNET_SSL_HANDSHAKE_WAITING_LIST_SIZE);
+OSAL_task_stack_declare(llnet_ssl_handshake_worker_0_stack, LLNET_SSL_HANDSHAKE_WORKER_STACK_SIZE);
+#if LLNET_SSL_HANDSHAKE_WORKER_COUNT > 1
+MICROEJ_ASYNC_WORKER_worker_declare(llnet_ssl_handshake_worker_1, LLNET_SSL_HANDSHAKE_WORKER_JOB_COUNT, LLNET_SSL_HANDSHAKE_job_t, LLNET_SSL_HANDSHAKE_WAITING_LIST_SIZE);
+OSAL_task_stack_declare(llnet_ssl_handshake_worker_1_stack, LLNET_SSL_HANDSHAKE_WORKER_STACK_SIZE);
+#endif
+#if LLNET_SSL_HANDSHAKE_WORKER_COUNT > 2
+MICROEJ_ASYNC_WORKER_worker_declare(llnet_ssl_handshake_worker_2, LLNET_SSL_HANDSHAKE_WORKER_JOB_COUNT, LLNET_SSL_HANDSHAKE_job_t, LLNET_SSL_HANDSHAKE_WAITING_LIST_SIZE);
+OSAL_task_stack_declare(llnet_ssl_handshake_worker_2_stack, LLNET_SSL_HANDSHAKE_WORKER_STACK_SIZE);
+#endif
+#if LLNET_SSL_HANDSHAKE_WORKER_COUNT > 3
+MICROEJ_ASYNC_WORKER_worker_declare(llnet_ssl_handshake_worker_3, LLNET_SSL_HANDSHAKE_WORKER_JOB_COUNT, LLNET_SSL_HANDSHAKE_job_t, LLNET_SSL_HANDSHAKE_WAITING_LIST_SIZE);
+OSAL_task_stack_declare(llnet_ssl_handshake_worker_3_stack, LLNET_SSL_HANDSHAKE_WORKER_STACK_SIZE);
+#endif
+
+/** @brief The handshake workers. */
+static MICROEJ_ASYNC_WORKER_handle_t* const llnet_ssl_handshake_workers[LLNET_SSL_HANDSHAKE_WORKER_COUNT] = {
+	&llnet_ssl_handshake_worker_0,
+#if LLNET_SSL_HANDSHAKE_WORKER_COUNT > 1
+	&llnet_ssl_handshake_worker_1,
+#endif
+#if LLNET_SSL_HANDSHAKE_WORKER_COUNT > 2
+	&llnet_ssl_handshake_worker_2,
+#endif
+#if LLNET_SSL_HANDSHAKE_WORKER_COUNT > 3
+	&llnet_ssl_handshake_worker_3,
+#endif
+};
+
+/** @brief Number of jobs executed or queued by each worker. Only accessed from the VM task. */
+static int32_t llnet_ssl_handshake_pending_jobs[LLNET_SSL_HANDSHAKE_WORKER_COUNT];
+
+/** @brief Index of the busy state in the ex_data of the sessions, -1 if not allocated. Only accessed from the VM task. */
+static int llnet_ssl_handshake_index = -1;
+
+/** @brief Busy states of a session, by address: a handshake step is in flight, and the session was closed meanwhile. */
+static uint8_t llnet_ssl_handshake_busy;
+static uint8_t llnet_ssl_handshake_closed;
+#endif // LLNET_SSL_HANDSHAKE_WORKER_ENABLED == 1
+
+/** @brief True if all the workers have been started. */
+static bool llnet_ssl_handshake_workers_started = false;
+
+void LLNET_SSL_HANDSHAKE_WORKER_initialize(void) {
+#if LLNET_SSL_HANDSHAKE_WORKER_ENABLED == 1
+	OSAL_task_stack_t const stacks[LLNET_SSL_HANDSHAKE_WORKER_COUNT] = {
+		llnet_ssl_handshake_worker_0_stack,
+#if LLNET_SSL_HANDSHAKE_WORKER_COUNT > 1
+		llnet_ssl_handshake_worker_1_stack,
+#endif
+#if LLNET_SSL_HANDSHAKE_WORKER_COUNT > 2
+		llnet_ssl_handshake_worker_2_stack,
+#endif
+#if LLNET_SSL_HANDSHAKE_WORKER_COUNT > 3
+		llnet_ssl_handshake_worker_3_stack,
+#endif
+	};
+	static const char* const names[4] = { "MicroEJ SSL 0", "MicroEJ SSL 1", "MicroEJ SSL 2", "MicroEJ SSL 3" };
+
+	if (!llnet_ssl_handshake_workers_started) {
+		bool started = true;
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+		// OpenSSL 1.0.2 is only thread safe with the locking callbacks
+		if (NULL == CRYPTO_get_locking_callback()) {
+			LLNET_SSL_DEBUG_TRACE("No OpenSSL locking callback, handshakes run on the VM task\n");
+			started = false;
+		}
+#endif
+		if (started && (-1 == llnet_ssl_handshake_index)) {
+			llnet_ssl_handshake_index = SSL_get_ex_new_index(0, NULL, NULL, NULL, NULL);
+			if (-1 == llnet_ssl_handshake_index) {
+				LLNET_SSL_DEBUG_TRACE("No SSL ex_data index, handshakes run on the VM task\n");
+				started = false;
+			}
+		}
+		for (int32_t i = 0; started && (i < LLNET_SSL_HANDSHAKE_WORKER_COUNT); i++) {
+			// cppcheck-suppress misra-c2012-11.8 // String casts conform to MICROEJ_ASYNC_WORKER_initialize function definitions.
+			MICROEJ_ASYNC_WORKER_status_t status = MICROEJ_ASYNC_WORKER_initialize(llnet_ssl_handshake_workers[i],
+			                                                                       (uint8_t*)names[i], stacks[i],
+			                                                                       LLNET_SSL_HANDSHAKE_WORKER_PRIORITY);
+			if (MICROEJ_ASYNC_WORKER_OK != status) {
+				// Workers already started stay idle
+				LLNET_SSL_DEBUG_TRACE("Cannot start SSL handshake worker %d (status=%d), handshakes run on the VM task\n", i, status);
+				started = false;
+			}
+		}
+		llnet_ssl_handshake_workers_started = started;
+	}
+#endif
+}
+
+bool LLNET_SSL_HANDSHAKE_WORKER_is_started(void) {
+	return llnet_ssl_handshake_workers_started;
+}
+
+void LLNET_SSL_HANDSHAKE_WORKER_exec(SSL* ssl, bool is_client, SNI_callback retry_callback, SNI_callback on_done_callback) {
+#if LLNET_SSL_HANDSHAKE_WORKER_ENABLED == 1
+	if (LLNET_SSL_HANDSHAKE_WORKER_is_busy(ssl)) {
+		// Another Java thread runs a handshake step on this session
+		(void)SNI_throwNativeIOException(J_SOCKET_ERROR, "SSL handshake in progress");
+	} else {
+		int32_t index = LLNET_SSL_HANDSHAKE_WORKER_select();
+		MICROEJ_ASYNC_WORKER_handle_t* worker = llnet_ssl_handshake_workers[index];
+		MICROEJ_ASYNC_WORKER_job_t* job = MICROEJ_ASYNC_WORKER_allocate_job(worker, retry_callback);
+		if (NULL != job) {
+			LLNET_SSL_HANDSHAKE_job_t* params = (LLNET_SSL_HANDSHAKE_job_t*)job->params;
+			params->ssl = ssl;
+			params->is_client = is_client;
+			params->closed = false;
+			params->worker = worker;
+
+			if (1 != SSL_set_ex_data(ssl, llnet_ssl_handshake_index, &llnet_ssl_handshake_busy)) {
+				(void)MICROEJ_ASYNC_WORKER_free_job(worker, job);
+				(void)SNI_throwNativeIOException(J_UNKNOWN_ERROR, "Could not start SSL handshake step");
+			} else {
+				// The session is held by the job until the result is got
+				LLNET_SSL_HANDSHAKE_WORKER_up_ref(ssl);
+				MICROEJ_ASYNC_WORKER_status_t status = MICROEJ_ASYNC_WORKER_async_exec(worker, job,
+				                                                                       LLNET_SSL_HANDSHAKE_WORKER_action,
+				                                                                       on_done_callback);
+				if (MICROEJ_ASYNC_WORKER_OK == status) {
+					llnet_ssl_handshake_pending_jobs[index]++;
+				} else {
+					// MICROEJ_ASYNC_WORKER_async_exec has thrown a SNI exception
+					(void)LLNET_SSL_HANDSHAKE_WORKER_release(ssl);
+					(void)MICROEJ_ASYNC_WORKER_free_job(worker, job);
+				}
+			}
+		} // else the Java thread waits for a job, or an exception is pending
+	}
+#else
+	(void)ssl;
+	(void)is_client;
+	(void)retry_callback;
+	(void)on_done_callback;
+	(void)SNI_throwNativeIOException(J_UNKNOWN_ERROR, "SSL handshake workers disabled");
+#endif
+}
+
+bool LLNET_SSL_HANDSHAKE_WORKER_get_result(LLNET_SSL_HANDSHAKE_job_t* result) {
+	bool done = false;
+#if LLNET_SSL_HANDSHAKE_WORKER_ENABLED == 1
+	MICROEJ_ASYNC_WORKER_job_t* job = MICROEJ_ASYNC_WORKER_get_job_done();
+	if (NULL != job) {
+		LLNET_SSL_HANDSHAKE_job_t* params = (LLNET_SSL_HANDSHAKE_job_t*)job->params;
+		*result = *params;
+		result->closed = LLNET_SSL_HANDSHAKE_WORKER_release(params->ssl);
+		for (int32_t i = 0; i < LLNET_SSL_HANDSHAKE_WORKER_COUNT; i++) {
+			if (llnet_ssl_handshake_workers[i] == params->worker) {
+				llnet_ssl_handshake_pending_jobs[i]--;
+			}
+		}
+		(void)MICROEJ_ASYNC_WORKER_free_job(params->worker, job);
+		done = true;
+	}
+#else
+	(void)result;
+#endif
+	return done;
+}
+
+bool LLNET_SSL_HANDSHAKE_WORKER_is_busy(SSL* ssl) {
+#if LLNET_SSL_HANDSHAKE_WORKER_ENABLED == 1
+	return NULL != LLNET_SSL_HANDSHAKE_WORKER_get_state(ssl);
+#else
+	(void)ssl;
+	return false;
+#endif
+}
+
+bool LLNET_SSL_HANDSHAKE_WORKER_defer_free(SSL* ssl) {
+	bool deferred = false;
+#if LLNET_SSL_HANDSHAKE_WORKER_ENABLED == 1
+	if (NULL != LLNET_SSL_HANDSHAKE_WORKER_get_state(ssl)) {
+		// The ex_data slot exists: only a pointer is stored
+		(void)SSL_set_ex_data(ssl, llnet_ssl_handshake_index, &llnet_ssl_handshake_closed);
+		deferred = true;
+	}
+#else
+	(void)ssl;
+#endif
+	return deferred;
+}
+
+#if LLNET_SSL_HANDSHAKE_WORKER_ENABLED == 1
+/**
+ * @brief Executes a handshake step on the socket in non-blocking mode, in a worker task.
+ */
+static void LLNET_SSL_HANDSHAKE_WORKER_action(MICROEJ_ASYNC_WORKER_job_t* job) {
+	LLNET_SSL_HANDSHAKE_job_t* params = (LLNET_SSL_HANDSHAKE_job_t*)job->params;
+	SSL* ssl = params->ssl;
+
+	// The error queue of the worker thread may hold errors of a previous handshake
+	ERR_clear_error();
+	errno = 0;
+	LLNET_SSL_MEMORY_set_current_account(LLNET_SSL_MEMORY_get_account(ssl));
+	if (params->is_client) {
+		params->ret = SSL_connect(ssl);
+	} else {
+		params->ret = SSL_accept(ssl);
+	}
+	params->sys_errno = errno;
+	LLNET_SSL_MEMORY_set_current_account(NULL);
+	if (1 == params->ret) {
+		params->ssl_error = SSL_ERROR_NONE;
+		params->error_code = J_SSL_NO_ERROR;
+	} else {
+		params->ssl_error = SSL_get_error(ssl, params->ret);
+		params->error_code = LLNET_SSL_TranslateReturnCode(ssl, params->ret);
+		if ((SSL_ERROR_WANT_READ != params->ssl_error) && (SSL_ERROR_WANT_WRITE != params->ssl_error)) {
+			LLNET_SSL_DEBUG_PRINT_ERR();
+		}
+	}
+}
+
+/**
+ * @brief Selects the worker with the fewest pending jobs.
+ *
+ * @return the worker index.
+ */
+static int32_t LLNET_SSL_HANDSHAKE_WORKER_select(void) {
+	int32_t index = 0;
+	for (int32_t i = 1; i < LLNET_SSL_HANDSHAKE_WORKER_COUNT; i++) {
+		if (llnet_ssl_handshake_pending_jobs[i] < llnet_ssl_handshake_pending_jobs[index]) {
+			index = i;
+		}
+	}
+	return index;
+}
+
+/**
+ * @brief Gets the busy state of a session.
+ *
+ * @return &llnet_ssl_handshake_busy or &llnet_ssl_handshake_closed, NULL if the session is not busy.
+ */
+static void* LLNET_SSL_HANDSHAKE_WORKER_get_state(SSL* ssl) {
+	void* state = NULL;
+	if (-1 != llnet_ssl_handshake_index) {
+		state = SSL_get_ex_data(ssl, llnet_ssl_handshake_index);
+	}
+	return state;
+}
+
+/**
+ * @brief Takes a reference to a session, released by LLNET_SSL_HANDSHAKE_WORKER_release().
+ */
+static void LLNET_SSL_HANDSHAKE_WORKER_up_ref(SSL* ssl) {
+#if (OPENSSL_VERSION_NUMBER < 0x10100000L)
+	(void)CRYPTO_add(&ssl->references, 1, CRYPTO_LOCK_SSL);
+#else
+	(void)SSL_up_ref(ssl);
+#endif
+}
+
+/**
+ * @brief Clears the busy state of a session and releases the reference taken for its job.
+ *
+ * @return true if the session was closed during the step.
+ */
+static bool LLNET_SSL_HANDSHAKE_WORKER_release(SSL* ssl) {
+	bool closed = (&llnet_ssl_handshake_closed == LLNET_SSL_HANDSHAKE_WORKER_get_state(ssl));
+	(void)SSL_set_ex_data(ssl, llnet_ssl_handshake_index, NULL);
+	// Not the last reference: the session is freed by LLNET_SSL_SOCKET_IMPL_freeSSL()
+	SSL_free(ssl);
+	return closed;
+}
+#endif // LLNET_SSL_HANDSHAKE_WORKER_ENABLED == 1
+
+#ifdef __cplusplus
+	}
+#endif
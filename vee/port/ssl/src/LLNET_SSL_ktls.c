@@ -0,0 +1,63 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <LLNET_SSL_ktls.h>
+#include <LLNET_SSL_CONSTANTS.h>
+#include <LLNET_SSL_util.h>
+#include <openssl/ssl.h>
+#include <openssl/bio.h>
+
+/**
+ * @file
+ * @brief LLNET SSL kernel TLS (kTLS) offload implementation over OpenSSL.
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+int32_t LLNET_SSL_KTLS_IMPL_getStatus(int32_t ssl) {
+	LLNET_SSL_DEBUG_TRACE("(ssl=0x%x)\n", ssl);
+	return LLNET_SSL_KTLS_get_status((SSL*)ssl);
+}
+
+void LLNET_SSL_KTLS_enable(SSL_CTX* ctx, int32_t protocol) {
+#if (LLNET_SSL_KTLS_ENABLED == 1) && defined(SSL_OP_ENABLE_KTLS)
+	// The kernel offload applies to the TLS records over TCP only
+	if ((DTLSv1_PROTOCOL != protocol) && (DTLSv1_2_PROTOCOL != protocol)) {
+		// OpenSSL enables kTLS at the end of the handshake, for each direction the kernel supports the cipher of,
+		// and keeps the user-space record layer otherwise.
+		(void)SSL_CTX_set_options(ctx, SSL_OP_ENABLE_KTLS);
+	}
+#else
+	(void)ctx;
+	(void)protocol;
+#endif
+}
+
+int32_t LLNET_SSL_KTLS_get_status(SSL* ssl) {
+	int32_t status = 0;
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+	if ((NULL != ssl) && (1 == SSL_is_init_finished(ssl))) {
+		if (BIO_get_ktls_send(SSL_get_wbio(ssl))) {
+			status |= LLNET_SSL_KTLS_SEND;
+		}
+		if (BIO_get_ktls_recv(SSL_get_rbio(ssl))) {
+			status |= LLNET_SSL_KTLS_RECEIVE;
+		}
+	}
+#else
+	(void)ssl;
+#endif
+	return status;
+}
+
+#ifdef __cplusplus
+	}
+#endif
@@ -0,0 +1,397 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <LLNET_SSL_memory.h>
+#include <LLNET_SSL_util.h>
+#include <openssl/crypto.h>
+#include <openssl/ssl.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "osal.h"
+
+/**
+ * @file
+ * @brief LLNET SSL memory management implementation over OpenSSL.
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+// CRYPTO_set_mem_functions() takes the file and line arguments since OpenSSL 1.1.0
+#if (LLNET_SSL_MEMORY_HOOKS_ENABLED == 1) && (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+#define LLNET_SSL_MEMORY_HOOKS
+#endif
+
+/** @brief Memory charged to a session. */
+struct LLNET_SSL_MEMORY_account {
+	int64_t allocated; // bytes currently allocated
+	int64_t peak; // maximum of the bytes allocated
+	int32_t blocks; // number of blocks currently allocated
+	bool detached; // true once the session is freed
+};
+
+/*
+ * See implementations for descriptions.
+ */
+static void LLNET_SSL_MEMORY_detach_account(LLNET_SSL_MEMORY_account_t* account);
+
+#ifdef LLNET_SSL_MEMORY_HOOKS
+/** @brief Header of the blocks allocated for OpenSSL, 16 bytes to keep the payload aligned. */
+typedef union LLNET_SSL_MEMORY_header {
+	struct {
+		size_t size; // payload size
+		LLNET_SSL_MEMORY_account_t* account; // account charged, NULL if none
+	} info;
+	struct {
+		uint8_t padding[16];
+	} align;
+} LLNET_SSL_MEMORY_header_t;
+
+/** @brief Free blocks of a given size, linked through the first bytes of their payload. */
+typedef struct LLNET_SSL_MEMORY_bucket {
+	size_t size; // payload size, meaningless if the bucket is empty
+	LLNET_SSL_MEMORY_header_t* first;
+	int32_t count;
+} LLNET_SSL_MEMORY_bucket_t;
+
+static void* LLNET_SSL_MEMORY_malloc(size_t size, const char* file, int line);
+static void* LLNET_SSL_MEMORY_realloc(void* ptr, size_t size, const char* file, int line);
+static void LLNET_SSL_MEMORY_free(void* ptr, const char* file, int line);
+static void LLNET_SSL_MEMORY_charge(LLNET_SSL_MEMORY_account_t* account, size_t size);
+static void LLNET_SSL_MEMORY_discharge(LLNET_SSL_MEMORY_account_t* account, size_t size);
+static LLNET_SSL_MEMORY_header_t* LLNET_SSL_MEMORY_pool_take(size_t size);
+static bool LLNET_SSL_MEMORY_pool_put(LLNET_SSL_MEMORY_header_t* header);
+
+/** @brief Whether the OpenSSL allocation functions have been replaced. */
+static bool llnet_ssl_memory_hooked = false;
+
+/** @brief Protects the accounts, the global statistics and the pool. */
+static OSAL_mutex_handle_t llnet_ssl_memory_mutex;
+
+/** @brief Account of the session processed by the calling thread. */
+static pthread_key_t llnet_ssl_memory_current_key;
+
+/** @brief All the OpenSSL allocations. */
+static LLNET_SSL_MEMORY_account_t llnet_ssl_memory_global;
+
+/** @brief Global pool statistics. */
+static int64_t llnet_ssl_memory_pooled_bytes = 0;
+static int64_t llnet_ssl_memory_pool_hits = 0;
+static int64_t llnet_ssl_memory_pool_misses = 0;
+
+/** @brief Shared pool of the freed record buffers. */
+static LLNET_SSL_MEMORY_bucket_t llnet_ssl_memory_pool[LLNET_SSL_MEMORY_POOL_SIZES];
+static int32_t llnet_ssl_memory_pool_count = 0;
+#endif
+
+/** @brief Index of the account in the SSL extra data, -1 if not allocated yet. */
+static int llnet_ssl_memory_index = -1;
+
+int64_t LLNET_SSL_MEMORY_IMPL_getStatistic(int32_t ssl, int32_t id) {
+	int64_t value = -1;
+#ifdef LLNET_SSL_MEMORY_HOOKS
+	if (llnet_ssl_memory_hooked) {
+		OSAL_mutex_take(&llnet_ssl_memory_mutex, OSAL_INFINITE_TIME);
+		LLNET_SSL_MEMORY_account_t* account = (0 == ssl) ? &llnet_ssl_memory_global : LLNET_SSL_MEMORY_get_account((SSL*)ssl);
+		if (NULL == account) {
+			// No account for this session
+		} else if ((int32_t)LLNET_SSL_MEMORY_STAT_ALLOCATED_BYTES == id) {
+			value = account->allocated;
+		} else if ((int32_t)LLNET_SSL_MEMORY_STAT_PEAK_BYTES == id) {
+			value = account->peak;
+		} else if (0 != ssl) {
+			// Global statistics only
+		} else if ((int32_t)LLNET_SSL_MEMORY_STAT_POOLED_BYTES == id) {
+			value = llnet_ssl_memory_pooled_bytes;
+		} else if ((int32_t)LLNET_SSL_MEMORY_STAT_POOL_HITS == id) {
+			value = llnet_ssl_memory_pool_hits;
+		} else if ((int32_t)LLNET_SSL_MEMORY_STAT_POOL_MISSES == id) {
+			value = llnet_ssl_memory_pool_misses;
+		} else {
+			// Unknown statistic
+		}
+		OSAL_mutex_give(&llnet_ssl_memory_mutex);
+	}
+#else
+	(void)ssl;
+	(void)id;
+#endif
+	return value;
+}
+
+void LLNET_SSL_MEMORY_initialize(void) {
+#ifdef LLNET_SSL_MEMORY_HOOKS
+	static bool initialized = false;
+	if (!initialized) {
+		initialized = true;
+		// cppcheck-suppress misra-c2012-11.8 // String casts conform to OSAL_mutex_create function definitions.
+		if ((OSAL_OK == OSAL_mutex_create((uint8_t*)"SSL memory", &llnet_ssl_memory_mutex))
+		    && (0 == pthread_key_create(&llnet_ssl_memory_current_key, NULL))) {
+			// Fails if OpenSSL already allocated memory
+			llnet_ssl_memory_hooked = (1 == CRYPTO_set_mem_functions(LLNET_SSL_MEMORY_malloc, LLNET_SSL_MEMORY_realloc,
+			                                                         LLNET_SSL_MEMORY_free));
+		}
+		if (!llnet_ssl_memory_hooked) {
+			LLNET_SSL_DEBUG_TRACE("OpenSSL allocation functions not replaced, no buffer pool and no memory accounting\n");
+		}
+	}
+#endif
+}
+
+void LLNET_SSL_MEMORY_configure_context(SSL_CTX* ctx) {
+#if LLNET_SSL_MEMORY_RELEASE_BUFFERS == 1
+	(void)SSL_CTX_set_mode(ctx, SSL_MODE_RELEASE_BUFFERS);
+#else
+	(void)ctx;
+#endif
+}
+
+LLNET_SSL_MEMORY_account_t* LLNET_SSL_MEMORY_create_account(void) {
+	LLNET_SSL_MEMORY_account_t* account = NULL;
+#ifdef LLNET_SSL_MEMORY_HOOKS
+	if (llnet_ssl_memory_hooked) {
+		account = calloc(1, sizeof(*account));
+	}
+#endif
+	return account;
+}
+
+void LLNET_SSL_MEMORY_attach(SSL* ssl, LLNET_SSL_MEMORY_account_t* account) {
+	if (NULL != account) {
+		if (-1 == llnet_ssl_memory_index) {
+			llnet_ssl_memory_index = SSL_get_ex_new_index(0, NULL, NULL, NULL, NULL);
+		}
+		if ((NULL == ssl) || (-1 == llnet_ssl_memory_index) || (1 != SSL_set_ex_data(ssl, llnet_ssl_memory_index, account))) {
+			LLNET_SSL_DEBUG_TRACE("no memory account for ssl=%p\n", ssl);
+			// Blocks may still be charged to it, e.g. if SSL_new() failed halfway
+			LLNET_SSL_MEMORY_detach_account(account);
+		}
+	}
+}
+
+void LLNET_SSL_MEMORY_detach(SSL* ssl) {
+	LLNET_SSL_MEMORY_account_t* account = LLNET_SSL_MEMORY_get_account(ssl);
+	if (NULL != account) {
+		(void)SSL_set_ex_data(ssl, llnet_ssl_memory_index, NULL);
+		LLNET_SSL_MEMORY_detach_account(account);
+	}
+}
+
+LLNET_SSL_MEMORY_account_t* LLNET_SSL_MEMORY_get_account(const SSL* ssl) {
+	LLNET_SSL_MEMORY_account_t* account = NULL;
+	if ((NULL != ssl) && (-1 != llnet_ssl_memory_index)) {
+		account = (LLNET_SSL_MEMORY_account_t*)SSL_get_ex_data(ssl, llnet_ssl_memory_index);
+	}
+	return account;
+}
+
+void LLNET_SSL_MEMORY_set_current_account(LLNET_SSL_MEMORY_account_t* account) {
+#ifdef LLNET_SSL_MEMORY_HOOKS
+	if (llnet_ssl_memory_hooked) {
+		(void)pthread_setspecific(llnet_ssl_memory_current_key, account);
+	}
+#else
+	(void)account;
+#endif
+}
+
+/**
+ * @brief Marks an account as detached from its session, and frees it if no block is charged to it anymore.
+ */
+static void LLNET_SSL_MEMORY_detach_account(LLNET_SSL_MEMORY_account_t* account) {
+	bool release;
+#ifdef LLNET_SSL_MEMORY_HOOKS
+	OSAL_mutex_take(&llnet_ssl_memory_mutex, OSAL_INFINITE_TIME);
+	account->detached = true;
+	release = (0 == account->blocks);
+	OSAL_mutex_give(&llnet_ssl_memory_mutex);
+#else
+	release = true;
+#endif
+	if (release) {
+		free(account);
+	}
+}
+
+#ifdef LLNET_SSL_MEMORY_HOOKS
+/**
+ * @brief OpenSSL allocation function: takes the block from the pool if possible and charges it to the account of
+ * the calling thread.
+ *
+ * Called from any task using OpenSSL.
+ */
+static void* LLNET_SSL_MEMORY_malloc(size_t size, const char* file, int line) {
+	(void)file;
+	(void)line;
+	void* ptr = NULL;
+	LLNET_SSL_MEMORY_header_t* header = NULL;
+	LLNET_SSL_MEMORY_account_t* account = (LLNET_SSL_MEMORY_account_t*)pthread_getspecific(llnet_ssl_memory_current_key);
+
+	if (size <= (SIZE_MAX - sizeof(LLNET_SSL_MEMORY_header_t))) {
+		if (size >= (size_t)LLNET_SSL_MEMORY_POOL_MIN_BLOCK) {
+			OSAL_mutex_take(&llnet_ssl_memory_mutex, OSAL_INFINITE_TIME);
+			header = LLNET_SSL_MEMORY_pool_take(size);
+			OSAL_mutex_give(&llnet_ssl_memory_mutex);
+		}
+		if (NULL == header) {
+			header = (LLNET_SSL_MEMORY_header_t*)malloc(sizeof(LLNET_SSL_MEMORY_header_t) + size);
+		}
+	}
+
+	if (NULL != header) {
+		header->info.size = size;
+		header->info.account = account;
+		OSAL_mutex_take(&llnet_ssl_memory_mutex, OSAL_INFINITE_TIME);
+		LLNET_SSL_MEMORY_charge(&llnet_ssl_memory_global, size);
+		if (NULL != account) {
+			LLNET_SSL_MEMORY_charge(account, size);
+		}
+		OSAL_mutex_give(&llnet_ssl_memory_mutex);
+		ptr = (void*)(header + 1);
+	}
+	return ptr;
+}
+
+/**
+ * @brief OpenSSL reallocation function. OpenSSL seldom reallocates, and never the record buffers: the block is
+ * always moved, so it is charged to the account of the calling thread.
+ */
+static void* LLNET_SSL_MEMORY_realloc(void* ptr, size_t size, const char* file, int line) {
+	void* new_ptr;
+	if (NULL == ptr) {
+		new_ptr = LLNET_SSL_MEMORY_malloc(size, file, line);
+	} else if (0u == size) {
+		LLNET_SSL_MEMORY_free(ptr, file, line);
+		new_ptr = NULL;
+	} else {
+		new_ptr = LLNET_SSL_MEMORY_malloc(size, file, line);
+		if (NULL != new_ptr) {
+			size_t old_size = ((LLNET_SSL_MEMORY_header_t*)ptr - 1)->info.size;
+			(void)memcpy(new_ptr, ptr, (old_size < size) ? old_size : size);
+			LLNET_SSL_MEMORY_free(ptr, file, line);
+		}
+	}
+	return new_ptr;
+}
+
+/**
+ * @brief OpenSSL free function: discharges the block from its account and puts it in the pool if possible.
+ *
+ * Called from any task using OpenSSL.
+ */
+static void LLNET_SSL_MEMORY_free(void* ptr, const char* file, int line) {
+	(void)file;
+	(void)line;
+	if (NULL != ptr) {
+		LLNET_SSL_MEMORY_header_t* header = (LLNET_SSL_MEMORY_header_t*)ptr - 1;
+		LLNET_SSL_MEMORY_account_t* account = header->info.account;
+		bool release_account = false;
+		bool pooled = false;
+
+		OSAL_mutex_take(&llnet_ssl_memory_mutex, OSAL_INFINITE_TIME);
+		LLNET_SSL_MEMORY_discharge(&llnet_ssl_memory_global, header->info.size);
+		if (NULL != account) {
+			LLNET_SSL_MEMORY_discharge(account, header->info.size);
+			release_account = account->detached && (0 == account->blocks);
+		}
+		if (header->info.size >= (size_t)LLNET_SSL_MEMORY_POOL_MIN_BLOCK) {
+			pooled = LLNET_SSL_MEMORY_pool_put(header);
+		}
+		OSAL_mutex_give(&llnet_ssl_memory_mutex);
+
+		if (!pooled) {
+			free(header);
+		}
+		if (release_account) {
+			free(account);
+		}
+	}
+}
+
+/**
+ * @brief Charges a block to an account. Called with the mutex taken.
+ */
+static void LLNET_SSL_MEMORY_charge(LLNET_SSL_MEMORY_account_t* account, size_t size) {
+	account->allocated += (int64_t)size;
+	account->blocks++;
+	if (account->allocated > account->peak) {
+		account->peak = account->allocated;
+	}
+}
+
+/**
+ * @brief Discharges a block from an account. Called with the mutex taken.
+ */
+static void LLNET_SSL_MEMORY_discharge(LLNET_SSL_MEMORY_account_t* account, size_t size) {
+	account->allocated -= (int64_t)size;
+	account->blocks--;
+}
+
+/**
+ * @brief Takes a free block of the given size from the pool. Called with the mutex taken.
+ *
+ * @return the block, NULL if the pool has none.
+ */
+static LLNET_SSL_MEMORY_header_t* LLNET_SSL_MEMORY_pool_take(size_t size) {
+	LLNET_SSL_MEMORY_header_t* header = NULL;
+	for (int32_t i = 0; (NULL == header) && (i < LLNET_SSL_MEMORY_POOL_SIZES); i++) {
+		LLNET_SSL_MEMORY_bucket_t* bucket = &llnet_ssl_memory_pool[i];
+		if ((bucket->count > 0) && (bucket->size == size)) {
+			header = bucket->first;
+			(void)memcpy((void*)&bucket->first, (void*)(header + 1), sizeof(bucket->first));
+			bucket->count--;
+			llnet_ssl_memory_pool_count--;
+			llnet_ssl_memory_pooled_bytes -= (int64_t)size;
+		}
+	}
+	if (NULL != header) {
+		llnet_ssl_memory_pool_hits++;
+	} else {
+		llnet_ssl_memory_pool_misses++;
+	}
+	return header;
+}
+
+/**
+ * @brief Puts a freed block in the pool, in the bucket of its size or an empty one. Called with the mutex taken.
+ *
+ * @return true if the block is pooled, false if the pool is full or has no bucket for its size.
+ */
+static bool LLNET_SSL_MEMORY_pool_put(LLNET_SSL_MEMORY_header_t* header) {
+	LLNET_SSL_MEMORY_bucket_t* bucket = NULL;
+	if (llnet_ssl_memory_pool_count < LLNET_SSL_MEMORY_POOL_BLOCKS) {
+		for (int32_t i = 0; (NULL == bucket) && (i < LLNET_SSL_MEMORY_POOL_SIZES); i++) {
+			if ((llnet_ssl_memory_pool[i].count > 0) && (llnet_ssl_memory_pool[i].size == header->info.size)) {
+				bucket = &llnet_ssl_memory_pool[i];
+			}
+		}
+		for (int32_t i = 0; (NULL == bucket) && (i < LLNET_SSL_MEMORY_POOL_SIZES); i++) {
+			if (0 == llnet_ssl_memory_pool[i].count) {
+				bucket = &llnet_ssl_memory_pool[i];
+			}
+		}
+	}
+	if (NULL != bucket) {
+		bucket->size = header->info.size;
+		(void)memcpy((void*)(header + 1), (void*)&bucket->first, sizeof(bucket->first));
+		bucket->first = header;
+		bucket->count++;
+		llnet_ssl_memory_pool_count++;
+		llnet_ssl_memory_pooled_bytes += (int64_t)header->info.size;
+	}
+	return NULL != bucket;
+}
+#endif
+
+#ifdef __cplusplus
+	}
+#endif
@@ -0,0 +1,317 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <LLNET_SSL_record.h>
+#include <LLNET_SSL_CONSTANTS.h>
+#include <LLNET_SSL_ERRORS.h>
+#include <LLNET_SSL_memory.h>
+#include <LLNET_SSL_util.h>
+#include <LLNET_Common.h>
+#include <openssl/ssl.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file
+ * @brief LLNET SSL record layer tuning implementation over OpenSSL.
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+/** @brief Record layer state of a session, held in the session extra data. */
+typedef struct LLNET_SSL_RECORD_state {
+	uint8_t* buffer; // coalescing buffer of LLNET_SSL_RECORD_MAX_SEND_FRAGMENT bytes, NULL if coalescing disabled
+	int32_t pending; // number of bytes in the coalescing buffer
+	int32_t deadline_ms; // coalescing deadline, 0 if coalescing disabled
+	int64_t first_pending_ms; // time the first pending byte was buffered
+	int32_t fragment; // current maximum size of the records sent
+	int64_t bytes_since_idle; // application bytes sent since the connection start or the last idle period
+	int64_t last_write_ms; // time of the last SSL_write()
+	int64_t stats[LLNET_SSL_RECORD_STATS_COUNT];
+	struct LLNET_SSL_RECORD_state* previous; // live sessions list
+	struct LLNET_SSL_RECORD_state* next;
+} LLNET_SSL_RECORD_state_t;
+
+/*
+ * See implementations for descriptions.
+ */
+static LLNET_SSL_RECORD_state_t* LLNET_SSL_RECORD_get_state(const SSL* ssl);
+static int32_t LLNET_SSL_RECORD_ssl_write(SSL* ssl, LLNET_SSL_RECORD_state_t* state, const uint8_t* data, int32_t length);
+#if LLNET_SSL_RECORD_DYNAMIC_SIZING == 1
+static void LLNET_SSL_RECORD_update_fragment(SSL* ssl, LLNET_SSL_RECORD_state_t* state);
+#endif
+#ifdef SSL3_RT_HEADER
+static void LLNET_SSL_RECORD_message_callback(int write_p, int version, int content_type, const void* buf, size_t len, SSL* ssl, void* arg);
+#endif
+
+/** @brief Index of the record layer state in the SSL extra data, -1 if not allocated yet. */
+static int llnet_ssl_record_index = -1;
+
+/** @brief Sessions with a record layer state. */
+static LLNET_SSL_RECORD_state_t* llnet_ssl_record_states = NULL;
+
+/** @brief Statistics of the freed sessions. */
+static int64_t llnet_ssl_record_freed_stats[LLNET_SSL_RECORD_STATS_COUNT];
+
+int64_t LLNET_SSL_RECORD_IMPL_getStatistic(int32_t ssl, int32_t id) {
+	int64_t value = -1;
+	if ((id >= 0) && (id < (int32_t)LLNET_SSL_RECORD_STATS_COUNT)) {
+		if (0 == ssl) {
+			value = llnet_ssl_record_freed_stats[id];
+			for (LLNET_SSL_RECORD_state_t* state = llnet_ssl_record_states; NULL != state; state = state->next) {
+				value += state->stats[id];
+			}
+		} else {
+			LLNET_SSL_RECORD_state_t* state = LLNET_SSL_RECORD_get_state((SSL*)ssl);
+			if (NULL != state) {
+				value = state->stats[id];
+			}
+		}
+	}
+	return value;
+}
+
+void LLNET_SSL_RECORD_IMPL_setCoalescing(int32_t ssl, int32_t deadline_ms) {
+	LLNET_SSL_DEBUG_TRACE("(ssl=0x%x, deadline_ms=%d)\n", ssl, deadline_ms);
+	LLNET_SSL_RECORD_state_t* state = LLNET_SSL_RECORD_get_state((SSL*)ssl);
+	if (NULL == state) {
+		(void)SNI_throwNativeIOException(J_MEMORY_ERROR, "No record layer state");
+	} else if (deadline_ms > 0) {
+		if (NULL == state->buffer) {
+			// Taken from the pool of record buffers and charged to the session
+			LLNET_SSL_MEMORY_set_current_account(LLNET_SSL_MEMORY_get_account((SSL*)ssl));
+			state->buffer = OPENSSL_malloc(LLNET_SSL_RECORD_MAX_SEND_FRAGMENT);
+			LLNET_SSL_MEMORY_set_current_account(NULL);
+		}
+		if (NULL == state->buffer) {
+			(void)SNI_throwNativeIOException(J_MEMORY_ERROR, "Could not allocate coalescing buffer");
+		} else {
+			state->deadline_ms = deadline_ms;
+		}
+	} else {
+		// The buffer is freed once the pending bytes are sent
+		state->deadline_ms = 0;
+	}
+}
+
+void LLNET_SSL_RECORD_IMPL_flush(int32_t ssl, int32_t fd, int64_t absolute_java_start_time, int32_t relative_timeout) {
+	LLNET_SSL_DEBUG_TRACE("(ssl=0x%x, fd=%d)\n", ssl, fd);
+	int32_t ret = LLNET_SSL_RECORD_flush_pending((SSL*)ssl);
+
+	if (ret <= 0) {
+		int32_t ssl_error = SSL_get_error((SSL*)ssl, ret);
+		int64_t absolute_timeout_ms = 0;
+		if (0 != relative_timeout) {
+			absolute_timeout_ms = absolute_java_start_time + (int64_t)relative_timeout;
+		}
+
+		if (ssl_error == SSL_ERROR_WANT_WRITE) {
+			LLNET_SSL_handle_blocking_operation_error(fd, llnet_errno(fd), SELECT_WRITE, absolute_timeout_ms,
+			                                          (SNI_callback)LLNET_SSL_RECORD_IMPL_flush, NULL);
+		} else if (ssl_error == SSL_ERROR_WANT_READ) {
+			LLNET_SSL_handle_blocking_operation_error(fd, llnet_errno(fd), SELECT_READ, absolute_timeout_ms,
+			                                          (SNI_callback)LLNET_SSL_RECORD_IMPL_flush, NULL);
+		} else {
+			(void)SNI_throwNativeIOException(LLNET_SSL_TranslateReturnCode((SSL*)ssl, ret), "Flush error");
+		}
+	}
+}
+
+void LLNET_SSL_RECORD_configure_context(SSL_CTX* ctx, int32_t protocol) {
+	(void)SSL_CTX_set_max_send_fragment(ctx, LLNET_SSL_RECORD_MAX_SEND_FRAGMENT);
+	// DTLS always reads whole datagrams
+	if ((DTLSv1_PROTOCOL != protocol) && (DTLSv1_2_PROTOCOL != protocol)) {
+		SSL_CTX_set_read_ahead(ctx, LLNET_SSL_RECORD_READ_AHEAD);
+	}
+#ifdef SSL3_RT_HEADER
+	SSL_CTX_set_msg_callback(ctx, LLNET_SSL_RECORD_message_callback);
+#endif
+}
+
+void LLNET_SSL_RECORD_attach(SSL* ssl) {
+	if (-1 == llnet_ssl_record_index) {
+		llnet_ssl_record_index = SSL_get_ex_new_index(0, NULL, NULL, NULL, NULL);
+	}
+	LLNET_SSL_RECORD_state_t* state = calloc(1, sizeof(*state));
+	if ((NULL != state) && (-1 != llnet_ssl_record_index) && (1 == SSL_set_ex_data(ssl, llnet_ssl_record_index, state))) {
+		state->fragment = LLNET_SSL_RECORD_MAX_SEND_FRAGMENT;
+#if LLNET_SSL_RECORD_DYNAMIC_SIZING == 1
+		if (1 == SSL_set_max_send_fragment(ssl, LLNET_SSL_RECORD_INITIAL_FRAGMENT)) {
+			state->fragment = LLNET_SSL_RECORD_INITIAL_FRAGMENT;
+		}
+#endif
+		state->next = llnet_ssl_record_states;
+		if (NULL != llnet_ssl_record_states) {
+			llnet_ssl_record_states->previous = state;
+		}
+		llnet_ssl_record_states = state;
+	} else {
+		LLNET_SSL_DEBUG_TRACE("no record layer state for ssl=%p\n", ssl);
+		free(state);
+	}
+}
+
+void LLNET_SSL_RECORD_detach(SSL* ssl) {
+	LLNET_SSL_RECORD_state_t* state = LLNET_SSL_RECORD_get_state(ssl);
+	if (NULL != state) {
+		for (int32_t i = 0; i < (int32_t)LLNET_SSL_RECORD_STATS_COUNT; i++) {
+			llnet_ssl_record_freed_stats[i] += state->stats[i];
+		}
+		if (NULL != state->previous) {
+			state->previous->next = state->next;
+		} else {
+			llnet_ssl_record_states = state->next;
+		}
+		if (NULL != state->next) {
+			state->next->previous = state->previous;
+		}
+		(void)SSL_set_ex_data(ssl, llnet_ssl_record_index, NULL);
+		OPENSSL_free(state->buffer);
+		free(state);
+	}
+}
+
+int32_t LLNET_SSL_RECORD_write(SSL* ssl, const uint8_t* data, int32_t length) {
+	int32_t ret;
+	LLNET_SSL_RECORD_state_t* state = LLNET_SSL_RECORD_get_state(ssl);
+
+	if ((NULL == state) || (NULL == state->buffer)) {
+		ret = LLNET_SSL_RECORD_ssl_write(ssl, state, data, length);
+	} else {
+		ret = 1;
+		// Send the pending bytes first if the new ones do not fit in the current record or they waited too long
+		if ((state->pending > 0) && (((state->pending + length) > state->fragment) || (0 == state->deadline_ms)
+		                             || ((LLNET_current_time_ms() - state->first_pending_ms) >= state->deadline_ms))) {
+			ret = LLNET_SSL_RECORD_flush_pending(ssl);
+		}
+
+		if (ret > 0) {
+			if ((state->deadline_ms > 0) && ((state->pending + length) < state->fragment)) {
+				if (0 == state->pending) {
+					state->first_pending_ms = LLNET_current_time_ms();
+				}
+				(void)memcpy(state->buffer + state->pending, data, (size_t)length);
+				state->pending += length;
+				state->stats[LLNET_SSL_RECORD_STAT_COALESCED_WRITES]++;
+				ret = length;
+			} else {
+				ret = LLNET_SSL_RECORD_ssl_write(ssl, state, data, length);
+			}
+		}
+	}
+	return ret;
+}
+
+int32_t LLNET_SSL_RECORD_flush_pending(SSL* ssl) {
+	int32_t ret = 1;
+	LLNET_SSL_RECORD_state_t* state = LLNET_SSL_RECORD_get_state(ssl);
+
+	if ((NULL != state) && (state->pending > 0)) {
+		// On SSL_ERROR_WANT_WRITE, OpenSSL requires the retry with the same buffer and length: the buffer does not move
+		ret = LLNET_SSL_RECORD_ssl_write(ssl, state, state->buffer, state->pending);
+		if (ret > 0) {
+			state->pending = 0;
+			state->stats[LLNET_SSL_RECORD_STAT_FLUSHES]++;
+			ret = 1;
+		}
+	}
+	if ((NULL != state) && (0 == state->pending) && (0 == state->deadline_ms) && (NULL != state->buffer)) {
+		OPENSSL_free(state->buffer);
+		state->buffer = NULL;
+	}
+	return ret;
+}
+
+/**
+ * @brief Gets the record layer state of a session.
+ *
+ * @return the state, NULL if the session has none.
+ */
+static LLNET_SSL_RECORD_state_t* LLNET_SSL_RECORD_get_state(const SSL* ssl) {
+	LLNET_SSL_RECORD_state_t* state = NULL;
+	if ((NULL != ssl) && (-1 != llnet_ssl_record_index)) {
+		state = (LLNET_SSL_RECORD_state_t*)SSL_get_ex_data(ssl, llnet_ssl_record_index);
+	}
+	return state;
+}
+
+/**
+ * @brief Calls SSL_write(), after adapting the record size, and updates the statistics.
+ */
+static int32_t LLNET_SSL_RECORD_ssl_write(SSL* ssl, LLNET_SSL_RECORD_state_t* state, const uint8_t* data, int32_t length) {
+#if LLNET_SSL_RECORD_DYNAMIC_SIZING == 1
+	if (NULL != state) {
+		LLNET_SSL_RECORD_update_fragment(ssl, state);
+	}
+#endif
+	LLNET_SSL_MEMORY_set_current_account(LLNET_SSL_MEMORY_get_account(ssl));
+	int32_t ret = SSL_write(ssl, data, length);
+	LLNET_SSL_MEMORY_set_current_account(NULL);
+	if (NULL != state) {
+		state->stats[LLNET_SSL_RECORD_STAT_WRITE_CALLS]++;
+		if (ret > 0) {
+			state->stats[LLNET_SSL_RECORD_STAT_BYTES_SENT] += ret;
+			state->bytes_since_idle += ret;
+		}
+	}
+	return ret;
+}
+
+#if LLNET_SSL_RECORD_DYNAMIC_SIZING == 1
+/**
+ * @brief Switches to the large records once enough bytes have been sent, and back to the small records after an
+ * idle period, when the congestion window of the connection may have been reduced.
+ */
+static void LLNET_SSL_RECORD_update_fragment(SSL* ssl, LLNET_SSL_RECORD_state_t* state) {
+	int64_t now = LLNET_current_time_ms();
+	int32_t fragment = state->fragment;
+
+	if ((0 != state->last_write_ms) && ((now - state->last_write_ms) >= LLNET_SSL_RECORD_IDLE_RESET_MS)) {
+		state->bytes_since_idle = 0;
+		fragment = LLNET_SSL_RECORD_INITIAL_FRAGMENT;
+	} else if (state->bytes_since_idle >= LLNET_SSL_RECORD_BOOST_BYTES) {
+		fragment = LLNET_SSL_RECORD_MAX_SEND_FRAGMENT;
+	} else {
+		// Keep the current size
+	}
+	state->last_write_ms = now;
+
+	// The coalescing buffer is sent before a write: it never holds more than a record
+	if ((fragment != state->fragment) && (0 == state->pending) && (1 == SSL_set_max_send_fragment(ssl, fragment))) {
+		state->fragment = fragment;
+	}
+}
+#endif
+
+#ifdef SSL3_RT_HEADER
+/**
+ * @brief OpenSSL message callback: counts the record headers read and written.
+ *
+ * Called from the task running the handshake or the VM task, never at the same time for a given session.
+ */
+static void LLNET_SSL_RECORD_message_callback(int write_p, int version, int content_type, const void* buf, size_t len, SSL* ssl, void* arg) {
+	(void)version;
+	(void)buf;
+	(void)len;
+	(void)arg;
+	if (SSL3_RT_HEADER == content_type) {
+		LLNET_SSL_RECORD_state_t* state = LLNET_SSL_RECORD_get_state(ssl);
+		if (NULL != state) {
+			state->stats[(0 != write_p) ? LLNET_SSL_RECORD_STAT_RECORDS_SENT : LLNET_SSL_RECORD_STAT_RECORDS_RECEIVED]++;
+		}
+	}
+}
+#endif
+
+#ifdef __cplusplus
+	}
+#endif
@@ -0,0 +1,358 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <LLNET_SSL_tls13.h>
+#include <LLNET_SSL_CONSTANTS.h>
+#include <LLNET_SSL_ERRORS.h>
+#include <LLNET_SSL_memory.h>
+#include <LLNET_SSL_util.h>
+#include <LLNET_Common.h>
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+#include <stdlib.h>
+#include <string.h>
+#include "osal.h"
+
+/**
+ * @file
+ * @brief LLNET SSL TLS 1.3 implementation over OpenSSL.
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+#if defined(TLS1_3_VERSION) && (LLNET_SSL_TLS13_SESSION_CACHE_SIZE > 0)
+#define LLNET_SSL_TLS13_RESUMPTION
+#endif
+
+/** @brief Server session id context, required to resume the sessions of the contexts verifying the clients. */
+#define LLNET_SSL_TLS13_SESSION_ID_CONTEXT "LLNET_SSL"
+
+#ifdef LLNET_SSL_TLS13_RESUMPTION
+/** @brief Maximum length of a host name. */
+#define LLNET_SSL_TLS13_HOST_NAME_MAX (255)
+
+/** @brief Session kept for a server host name. */
+typedef struct LLNET_SSL_TLS13_entry {
+	char host_name[LLNET_SSL_TLS13_HOST_NAME_MAX + 1];
+	SSL_SESSION* session; // NULL if the entry is free
+	uint32_t last_use; // value of the cache clock when the session was stored or used
+} LLNET_SSL_TLS13_entry_t;
+
+/** @brief Sessions kept by a client context, held in the context extra data. */
+typedef struct LLNET_SSL_TLS13_cache {
+	LLNET_SSL_TLS13_entry_t entries[LLNET_SSL_TLS13_SESSION_CACHE_SIZE];
+	uint32_t clock;
+} LLNET_SSL_TLS13_cache_t;
+
+/*
+ * See implementations for descriptions.
+ */
+static LLNET_SSL_TLS13_cache_t* LLNET_SSL_TLS13_get_cache(const SSL_CTX* ctx);
+static LLNET_SSL_TLS13_entry_t* LLNET_SSL_TLS13_find(LLNET_SSL_TLS13_cache_t* cache, const char* host_name);
+static int LLNET_SSL_TLS13_new_session_callback(SSL* ssl, SSL_SESSION* session);
+
+/** @brief Index of the session cache in the SSL_CTX extra data, -1 if not allocated yet. */
+static int llnet_ssl_tls13_cache_index = -1;
+
+/**
+ * @brief Protects the session caches: the new sessions are stored by the tasks running the handshakes and by the
+ * VM task when the tickets are received after the handshake.
+ */
+static OSAL_mutex_handle_t llnet_ssl_tls13_mutex;
+static bool llnet_ssl_tls13_mutex_created = false;
+#endif
+
+#ifdef TLS1_3_VERSION
+/*
+ * See implementations for descriptions.
+ */
+static void LLNET_SSL_TLS13_handle_early_data_error(int32_t ssl, int32_t fd, int64_t absolute_java_start_time,
+                                                    int32_t relative_timeout, int32_t ret, SNI_callback callback,
+                                                    const char* message);
+#endif
+
+int32_t LLNET_SSL_TLS13_IMPL_writeEarlyData(int32_t ssl, int32_t fd, int8_t* buffer, int32_t offset, int32_t length,
+                                            int64_t absolute_java_start_time, int32_t relative_timeout) {
+	LLNET_SSL_DEBUG_TRACE("(ssl=0x%x, fd=%d, offset=%d, length=%d)\n", ssl, fd, offset, length);
+	int32_t ret = 0;
+#ifdef TLS1_3_VERSION
+	SSL_SESSION* session = SSL_get_session((SSL*)ssl);
+	uint32_t max_early_data = (NULL != session) ? SSL_SESSION_get_max_early_data(session) : 0u;
+
+	if ((max_early_data > 0u) && (length > 0)) {
+		size_t written = 0;
+		size_t count = ((uint32_t)length < max_early_data) ? (size_t)length : (size_t)max_early_data;
+
+		//set non-blocking mode
+		if (LLNET_set_non_blocking(fd) < 0) {
+			(void)SNI_throwNativeIOException(J_SOCKET_ERROR, "Could not set socket non blocking");
+		}
+
+		LLNET_SSL_MEMORY_set_current_account(LLNET_SSL_MEMORY_get_account((SSL*)ssl));
+		// Sends the ClientHello first, retried with the same arguments until it succeeds
+		int32_t result = SSL_write_early_data((SSL*)ssl, buffer + offset, count, &written);
+		LLNET_SSL_MEMORY_set_current_account(NULL);
+
+		if (1 == result) {
+			ret = (int32_t)written;
+		} else {
+			LLNET_SSL_TLS13_handle_early_data_error(ssl, fd, absolute_java_start_time, relative_timeout, result,
+			                                        (SNI_callback)LLNET_SSL_TLS13_IMPL_writeEarlyData, "Early data write error");
+			ret = SNI_IGNORED_RETURNED_VALUE;
+		}
+	}
+#else
+	(void)ssl;
+	(void)fd;
+	(void)buffer;
+	(void)offset;
+	(void)length;
+	(void)absolute_java_start_time;
+	(void)relative_timeout;
+#endif
+	return ret;
+}
+
+int32_t LLNET_SSL_TLS13_IMPL_readEarlyData(int32_t ssl, int32_t fd, int8_t* buffer, int32_t offset, int32_t length,
+                                           int64_t absolute_java_start_time, int32_t relative_timeout) {
+	LLNET_SSL_DEBUG_TRACE("(ssl=0x%x, fd=%d, offset=%d, length=%d)\n", ssl, fd, offset, length);
+	int32_t ret = -1;
+#ifdef TLS1_3_VERSION
+	if (SSL_in_before((SSL*)ssl) || SSL_in_init((SSL*)ssl)) {
+		size_t read_bytes = 0;
+
+		//set non-blocking mode
+		if (LLNET_set_non_blocking(fd) < 0) {
+			(void)SNI_throwNativeIOException(J_SOCKET_ERROR, "Could not set socket non blocking");
+		}
+
+		LLNET_SSL_MEMORY_set_current_account(LLNET_SSL_MEMORY_get_account((SSL*)ssl));
+		int32_t result = SSL_read_early_data((SSL*)ssl, buffer + offset, (size_t)length, &read_bytes);
+		LLNET_SSL_MEMORY_set_current_account(NULL);
+
+		if (SSL_READ_EARLY_DATA_SUCCESS == result) {
+			ret = (int32_t)read_bytes;
+		} else if (SSL_READ_EARLY_DATA_FINISH == result) {
+			// The last early data bytes may come with the end of the early data
+			ret = (read_bytes > 0u) ? (int32_t)read_bytes : -1;
+		} else {
+			LLNET_SSL_TLS13_handle_early_data_error(ssl, fd, absolute_java_start_time, relative_timeout, result,
+			                                        (SNI_callback)LLNET_SSL_TLS13_IMPL_readEarlyData, "Early data read error");
+			ret = SNI_IGNORED_RETURNED_VALUE;
+		}
+	}
+#else
+	(void)ssl;
+	(void)fd;
+	(void)buffer;
+	(void)offset;
+	(void)length;
+	(void)absolute_java_start_time;
+	(void)relative_timeout;
+#endif
+	return ret;
+}
+
+int32_t LLNET_SSL_TLS13_IMPL_getEarlyDataStatus(int32_t ssl) {
+	int32_t ret = LLNET_SSL_TLS13_EARLY_DATA_NOT_SENT;
+#ifdef TLS1_3_VERSION
+	ret = SSL_get_early_data_status((SSL*)ssl);
+#else
+	(void)ssl;
+#endif
+	return ret;
+}
+
+bool LLNET_SSL_TLS13_IMPL_isSessionReused(int32_t ssl) {
+	return 1 == SSL_session_reused((SSL*)ssl);
+}
+
+void LLNET_SSL_TLS13_configure_context(SSL_CTX* ctx, int32_t protocol, bool is_client) {
+	(void)protocol;
+#ifdef TLS1_3_VERSION
+#ifdef LLNET_SSL_TLS13_CIPHERSUITES
+	if (1 != SSL_CTX_set_ciphersuites(ctx, LLNET_SSL_TLS13_CIPHERSUITES)) {
+		LLNET_SSL_DEBUG_TRACE("could not set TLS 1.3 cipher suites %s\n", LLNET_SSL_TLS13_CIPHERSUITES);
+	}
+#endif
+	if (is_client) {
+#ifdef LLNET_SSL_TLS13_RESUMPTION
+		if (-1 == llnet_ssl_tls13_cache_index) {
+			llnet_ssl_tls13_cache_index = SSL_CTX_get_ex_new_index(0, NULL, NULL, NULL, NULL);
+		}
+		if (!llnet_ssl_tls13_mutex_created) {
+			// cppcheck-suppress misra-c2012-11.8 // String casts conform to OSAL_mutex_create function definitions.
+			llnet_ssl_tls13_mutex_created = (OSAL_OK == OSAL_mutex_create((uint8_t*)"SSL sessions", &llnet_ssl_tls13_mutex));
+		}
+		LLNET_SSL_TLS13_cache_t* cache = calloc(1, sizeof(*cache));
+		if ((NULL != cache) && llnet_ssl_tls13_mutex_created && (-1 != llnet_ssl_tls13_cache_index)
+		    && (1 == SSL_CTX_set_ex_data(ctx, llnet_ssl_tls13_cache_index, cache))) {
+			// The sessions are kept per host name by this module, not by the OpenSSL internal cache
+			(void)SSL_CTX_set_session_cache_mode(ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+			SSL_CTX_sess_set_new_cb(ctx, LLNET_SSL_TLS13_new_session_callback);
+		} else {
+			LLNET_SSL_DEBUG_TRACE("no session cache for context %p\n", ctx);
+			free(cache);
+		}
+#endif
+	} else {
+		(void)SSL_CTX_set_session_id_context(ctx, (const unsigned char*)LLNET_SSL_TLS13_SESSION_ID_CONTEXT,
+		                                     (unsigned int)strlen(LLNET_SSL_TLS13_SESSION_ID_CONTEXT));
+		(void)SSL_CTX_sess_set_cache_size(ctx, LLNET_SSL_TLS13_SERVER_CACHE_SIZE);
+		// Early data anti-replay protection, on by default, relies on the server session cache
+		(void)SSL_CTX_clear_options(ctx, SSL_OP_NO_ANTI_REPLAY);
+		(void)SSL_CTX_set_max_early_data(ctx, LLNET_SSL_TLS13_MAX_EARLY_DATA);
+		(void)SSL_CTX_set_recv_max_early_data(ctx, LLNET_SSL_TLS13_MAX_EARLY_DATA);
+	}
+#else
+	(void)ctx;
+	(void)is_client;
+#endif
+}
+
+void LLNET_SSL_TLS13_release(SSL_CTX* ctx) {
+#ifdef LLNET_SSL_TLS13_RESUMPTION
+	LLNET_SSL_TLS13_cache_t* cache = LLNET_SSL_TLS13_get_cache(ctx);
+	if (NULL != cache) {
+		(void)SSL_CTX_set_ex_data(ctx, llnet_ssl_tls13_cache_index, NULL);
+		for (int32_t i = 0; i < LLNET_SSL_TLS13_SESSION_CACHE_SIZE; i++) {
+			SSL_SESSION_free(cache->entries[i].session);
+		}
+		free(cache);
+	}
+#else
+	(void)ctx;
+#endif
+}
+
+void LLNET_SSL_TLS13_resume(SSL* ssl) {
+#ifdef LLNET_SSL_TLS13_RESUMPTION
+	LLNET_SSL_TLS13_cache_t* cache = LLNET_SSL_TLS13_get_cache(SSL_get_SSL_CTX(ssl));
+	const char* host_name = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+	if ((NULL != cache) && (NULL != host_name)) {
+		OSAL_mutex_take(&llnet_ssl_tls13_mutex, OSAL_INFINITE_TIME);
+		LLNET_SSL_TLS13_entry_t* entry = LLNET_SSL_TLS13_find(cache, host_name);
+		if (NULL != entry) {
+			if (1 == SSL_set_session(ssl, entry->session)) {
+				LLNET_SSL_DEBUG_TRACE("resuming session of %s\n", host_name);
+			}
+			if (TLS1_3_VERSION == SSL_SESSION_get_protocol_version(entry->session)) {
+				// TLS 1.3 tickets are single use, the server sends new ones after the handshake
+				SSL_SESSION_free(entry->session);
+				entry->session = NULL;
+			} else {
+				entry->last_use = ++cache->clock;
+			}
+		}
+		OSAL_mutex_give(&llnet_ssl_tls13_mutex);
+	}
+#else
+	(void)ssl;
+#endif
+}
+
+#ifdef TLS1_3_VERSION
+/**
+ * @brief Waits for the socket on a non-blocking early data operation, or throws the error.
+ */
+static void LLNET_SSL_TLS13_handle_early_data_error(int32_t ssl, int32_t fd, int64_t absolute_java_start_time,
+                                                    int32_t relative_timeout, int32_t ret, SNI_callback callback,
+                                                    const char* message) {
+	int32_t ssl_error = SSL_get_error((SSL*)ssl, ret);
+	int64_t absolute_timeout_ms = 0;
+	if (0 != relative_timeout) {
+		absolute_timeout_ms = absolute_java_start_time + (int64_t)relative_timeout;
+	}
+
+	if (ssl_error == SSL_ERROR_WANT_READ) {
+		LLNET_SSL_handle_blocking_operation_error(fd, llnet_errno(fd), SELECT_READ, absolute_timeout_ms, callback, NULL);
+	} else if (ssl_error == SSL_ERROR_WANT_WRITE) {
+		LLNET_SSL_handle_blocking_operation_error(fd, llnet_errno(fd), SELECT_WRITE, absolute_timeout_ms, callback, NULL);
+	} else {
+		LLNET_SSL_DEBUG_PRINT_ERR();
+		(void)SNI_throwNativeIOException(LLNET_SSL_TranslateReturnCode((SSL*)ssl, ret), message);
+	}
+}
+#endif
+
+#ifdef LLNET_SSL_TLS13_RESUMPTION
+/**
+ * @brief Gets the session cache of a client context.
+ *
+ * @return the cache, NULL if the context has none.
+ */
+static LLNET_SSL_TLS13_cache_t* LLNET_SSL_TLS13_get_cache(const SSL_CTX* ctx) {
+	LLNET_SSL_TLS13_cache_t* cache = NULL;
+	if ((NULL != ctx) && (-1 != llnet_ssl_tls13_cache_index)) {
+		cache = (LLNET_SSL_TLS13_cache_t*)SSL_CTX_get_ex_data(ctx, llnet_ssl_tls13_cache_index);
+	}
+	return cache;
+}
+
+/**
+ * @brief Finds the session kept for a host name. Called with the mutex taken.
+ *
+ * @return the entry, NULL if no session is kept for the host name.
+ */
+static LLNET_SSL_TLS13_entry_t* LLNET_SSL_TLS13_find(LLNET_SSL_TLS13_cache_t* cache, const char* host_name) {
+	LLNET_SSL_TLS13_entry_t* entry = NULL;
+	for (int32_t i = 0; (NULL == entry) && (i < LLNET_SSL_TLS13_SESSION_CACHE_SIZE); i++) {
+		if ((NULL != cache->entries[i].session) && (0 == strcmp(cache->entries[i].host_name, host_name))) {
+			entry = &cache->entries[i];
+		}
+	}
+	return entry;
+}
+
+/**
+ * @brief OpenSSL new session callback of the client contexts: keeps the session for the host name of the
+ * connection, replacing the previous one or the least recently used one.
+ *
+ * Called from the task running the handshake, or the VM task for the TLS 1.3 tickets received after the handshake.
+ *
+ * @return 1 if the session is kept, 0 otherwise.
+ */
+static int LLNET_SSL_TLS13_new_session_callback(SSL* ssl, SSL_SESSION* session) {
+	int ret = 0;
+	LLNET_SSL_TLS13_cache_t* cache = LLNET_SSL_TLS13_get_cache(SSL_get_SSL_CTX(ssl));
+	const char* host_name = SSL_get_servername(ssl, TLSEXT_NAMETYPE_host_name);
+
+	if ((NULL != cache) && (NULL != host_name) && (strlen(host_name) <= (size_t)LLNET_SSL_TLS13_HOST_NAME_MAX)
+	    && (1 == SSL_SESSION_is_resumable(session))) {
+		OSAL_mutex_take(&llnet_ssl_tls13_mutex, OSAL_INFINITE_TIME);
+		LLNET_SSL_TLS13_entry_t* entry = LLNET_SSL_TLS13_find(cache, host_name);
+		for (int32_t i = 0; (NULL == entry) && (i < LLNET_SSL_TLS13_SESSION_CACHE_SIZE); i++) {
+			if (NULL == cache->entries[i].session) {
+				entry = &cache->entries[i];
+			}
+		}
+		if (NULL == entry) {
+			entry = &cache->entries[0];
+			for (int32_t i = 1; i < LLNET_SSL_TLS13_SESSION_CACHE_SIZE; i++) {
+				if (cache->entries[i].last_use < entry->last_use) {
+					entry = &cache->entries[i];
+				}
+			}
+		}
+		SSL_SESSION_free(entry->session);
+		(void)strcpy(entry->host_name, host_name);
+		entry->session = session;
+		entry->last_use = ++cache->clock;
+		OSAL_mutex_give(&llnet_ssl_tls13_mutex);
+		ret = 1;
+	}
+	return ret;
+}
+#endif
+
+#ifdef __cplusplus
+	}
+#endif
@@ -0,0 +1,569 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+#include <LLNET_SSL_trust_store.h>
+#include <LLNET_SSL_CONSTANTS.h>
+#include <LLNET_SSL_ERRORS.h>
+#include <LLNET_SSL_util.h>
+#include <openssl/ssl.h>
+#include <openssl/evp.h>
+#include <openssl/x509_vfy.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "osal.h"
+
+/**
+ * @file
+ * @brief LLNET SSL shared trust store implementation over OpenSSL.
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+
+/** @brief Length of the SHA-256 hashes. */
+#define LLNET_SSL_TRUST_STORE_HASH_LENGTH (32)
+
+/** @brief A parsed certificate, shared by the contexts that trust it. */
+typedef struct LLNET_SSL_TRUST_STORE_cert {
+	uint8_t hash[LLNET_SSL_TRUST_STORE_HASH_LENGTH]; // hash of the encoded certificate
+	X509* x509;
+	int32_t references; // number of contexts that trust the certificate
+	struct LLNET_SSL_TRUST_STORE_cert* next; // next certificate in the bucket
+} LLNET_SSL_TRUST_STORE_cert_t;
+
+/** @brief A shared X509 store, never modified once built. */
+typedef struct LLNET_SSL_TRUST_STORE_store {
+	uint8_t key[LLNET_SSL_TRUST_STORE_HASH_LENGTH]; // hash of the sorted hashes of the certificates
+	X509_STORE* store;
+	uintptr_t id; // unique identifier, never reused
+	int32_t references; // number of contexts bound to the store
+	struct LLNET_SSL_TRUST_STORE_store* next;
+} LLNET_SSL_TRUST_STORE_store_t;
+
+/** @brief The trusted certificates of a context, held in the context extra data. */
+typedef struct {
+	LLNET_SSL_TRUST_STORE_cert_t** certs;
+	int32_t count;
+	int32_t capacity;
+	bool changed; // true if the certificates changed since the context was bound
+	LLNET_SSL_TRUST_STORE_store_t* store; // shared store the context is bound to, NULL if none
+} LLNET_SSL_TRUST_STORE_set_t;
+
+/** @brief A successful chain verification. */
+typedef struct {
+	uint8_t key[LLNET_SSL_TRUST_STORE_HASH_LENGTH]; // hash of the store identifier, the side and the chain
+	int64_t expiry_s; // monotonic time after which the entry is invalid, 0 if free
+	int64_t not_after_s; // earliest notAfter of the verified chain, in seconds since the Epoch
+} LLNET_SSL_TRUST_STORE_verified_t;
+
+/*
+ * See implementations for descriptions.
+ */
+static LLNET_SSL_TRUST_STORE_set_t* LLNET_SSL_TRUST_STORE_get_set(SSL_CTX* ctx, bool create);
+static LLNET_SSL_TRUST_STORE_cert_t* LLNET_SSL_TRUST_STORE_get_cert(const uint8_t* cert, int32_t cert_size, int32_t* error);
+static void LLNET_SSL_TRUST_STORE_release_cert(LLNET_SSL_TRUST_STORE_cert_t* cert);
+static void LLNET_SSL_TRUST_STORE_release_certs(LLNET_SSL_TRUST_STORE_set_t* set);
+static LLNET_SSL_TRUST_STORE_store_t* LLNET_SSL_TRUST_STORE_get_store(LLNET_SSL_TRUST_STORE_set_t* set);
+static void LLNET_SSL_TRUST_STORE_release_store(LLNET_SSL_TRUST_STORE_store_t* store);
+static int LLNET_SSL_TRUST_STORE_compare_certs(const void* a, const void* b);
+#if LLNET_SSL_TRUST_STORE_VERIFY_CACHE_SIZE > 0
+static int LLNET_SSL_TRUST_STORE_verify(X509_STORE_CTX* store_ctx, void* arg);
+static bool LLNET_SSL_TRUST_STORE_get_chain_key(X509_STORE_CTX* store_ctx, uint8_t* key);
+static bool LLNET_SSL_TRUST_STORE_get_chain_not_after(X509_STORE_CTX* store_ctx, int64_t* not_after_s);
+static int64_t LLNET_SSL_TRUST_STORE_get_time_s(void);
+#endif
+
+/** @brief Cached certificates, indexed by the first byte of their hash. */
+static LLNET_SSL_TRUST_STORE_cert_t* llnet_ssl_trust_store_certs[LLNET_SSL_TRUST_STORE_CERT_BUCKETS];
+
+/** @brief Shared stores. */
+static LLNET_SSL_TRUST_STORE_store_t* llnet_ssl_trust_store_stores = NULL;
+
+/** @brief Last shared store identifier. */
+static uintptr_t llnet_ssl_trust_store_last_id = 0;
+
+/** @brief Index of the trusted certificates in the SSL_CTX extra data, -1 if not allocated yet. */
+static int llnet_ssl_trust_store_ctx_index = -1;
+
+/** @brief Index of the shared store identifier in the X509_STORE extra data, -1 if not allocated yet. */
+static int llnet_ssl_trust_store_store_index = -1;
+
+#if LLNET_SSL_TRUST_STORE_VERIFY_CACHE_SIZE > 0
+/** @brief Cached chain verifications, replaced in round robin. Accessed from the handshake workers too. */
+static LLNET_SSL_TRUST_STORE_verified_t llnet_ssl_trust_store_verified[LLNET_SSL_TRUST_STORE_VERIFY_CACHE_SIZE];
+static int32_t llnet_ssl_trust_store_verified_next = 0;
+static OSAL_mutex_handle_t llnet_ssl_trust_store_mutex;
+static bool llnet_ssl_trust_store_mutex_created = false;
+#endif
+
+int32_t LLNET_SSL_TRUST_STORE_add(SSL_CTX* ctx, const uint8_t* cert, int32_t cert_size) {
+	int32_t ret = J_SSL_NO_ERROR;
+	LLNET_SSL_TRUST_STORE_set_t* set = LLNET_SSL_TRUST_STORE_get_set(ctx, true);
+	LLNET_SSL_TRUST_STORE_cert_t* trusted = NULL;
+
+	if (NULL == set) {
+		ret = J_MEMORY_ERROR;
+	} else {
+		trusted = LLNET_SSL_TRUST_STORE_get_cert(cert, cert_size, &ret);
+	}
+
+	if (NULL != trusted) {
+		bool found = false;
+		for (int32_t i = 0; i < set->count; i++) {
+			if (set->certs[i] == trusted) {
+				found = true;
+				break;
+			}
+		}
+		if (!found) {
+			if (set->count == set->capacity) {
+				int32_t capacity = (set->capacity == 0) ? 16 : (set->capacity * 2);
+				LLNET_SSL_TRUST_STORE_cert_t** certs = realloc(set->certs, (size_t)capacity * sizeof(*certs));
+				if (NULL == certs) {
+					ret = J_MEMORY_ERROR;
+				} else {
+					set->certs = certs;
+					set->capacity = capacity;
+				}
+			}
+			if (J_SSL_NO_ERROR == ret) {
+				trusted->references++;
+				set->certs[set->count] = trusted;
+				set->count++;
+				set->changed = true;
+			}
+		}
+		if (0 == trusted->references) {
+			// Newly parsed certificate that could not be added
+			LLNET_SSL_TRUST_STORE_release_cert(trusted);
+		}
+	}
+	return ret;
+}
+
+void LLNET_SSL_TRUST_STORE_clear(SSL_CTX* ctx) {
+	LLNET_SSL_TRUST_STORE_set_t* set = LLNET_SSL_TRUST_STORE_get_set(ctx, true);
+	if (NULL != set) {
+		LLNET_SSL_TRUST_STORE_release_certs(set);
+		set->changed = true;
+	} else {
+		// Keep the previous behavior: set an empty store to the context
+		SSL_CTX_set_cert_store(ctx, X509_STORE_new());
+	}
+}
+
+int32_t LLNET_SSL_TRUST_STORE_bind(SSL_CTX* ctx) {
+	int32_t ret = J_SSL_NO_ERROR;
+	LLNET_SSL_TRUST_STORE_set_t* set = LLNET_SSL_TRUST_STORE_get_set(ctx, false);
+
+	if ((NULL != set) && set->changed) {
+		LLNET_SSL_TRUST_STORE_store_t* store = LLNET_SSL_TRUST_STORE_get_store(set);
+		if (NULL == store) {
+			ret = J_MEMORY_ERROR;
+		} else {
+			store->references++;
+			SSL_CTX_set1_cert_store(ctx, store->store);
+			if (NULL != set->store) {
+				LLNET_SSL_TRUST_STORE_release_store(set->store);
+			}
+			set->store = store;
+			set->changed = false;
+			LLNET_SSL_DEBUG_TRACE("context %p bound to store %d (%d certificates)\n", ctx, (int)store->id, (int)set->count);
+
+#if LLNET_SSL_TRUST_STORE_VERIFY_CACHE_SIZE > 0
+			if (!llnet_ssl_trust_store_mutex_created) {
+				// cppcheck-suppress misra-c2012-11.8 // String casts conform to OSAL_mutex_create function definitions.
+				llnet_ssl_trust_store_mutex_created = (OSAL_OK == OSAL_mutex_create((uint8_t*)"SSL trust store", &llnet_ssl_trust_store_mutex));
+			}
+			if (llnet_ssl_trust_store_mutex_created) {
+				SSL_CTX_set_cert_verify_callback(ctx, LLNET_SSL_TRUST_STORE_verify, NULL);
+			}
+#endif
+		}
+	}
+	return ret;
+}
+
+void LLNET_SSL_TRUST_STORE_release(SSL_CTX* ctx) {
+	LLNET_SSL_TRUST_STORE_set_t* set = LLNET_SSL_TRUST_STORE_get_set(ctx, false);
+	if (NULL != set) {
+		LLNET_SSL_TRUST_STORE_release_certs(set);
+		if (NULL != set->store) {
+			LLNET_SSL_TRUST_STORE_release_store(set->store);
+		}
+		free(set->certs);
+		free(set);
+		(void)SSL_CTX_set_ex_data(ctx, llnet_ssl_trust_store_ctx_index, NULL);
+	}
+}
+
+/**
+ * @brief Gets the trusted certificates of a context.
+ *
+ * @param[in] ctx the SSL context.
+ * @param[in] create true to create them if the context has none.
+ *
+ * @return the trusted certificates, NULL if none or out of memory.
+ */
+static LLNET_SSL_TRUST_STORE_set_t* LLNET_SSL_TRUST_STORE_get_set(SSL_CTX* ctx, bool create) {
+	LLNET_SSL_TRUST_STORE_set_t* set = NULL;
+	if (-1 == llnet_ssl_trust_store_ctx_index) {
+		llnet_ssl_trust_store_ctx_index = SSL_CTX_get_ex_new_index(0, NULL, NULL, NULL, NULL);
+	}
+	if (-1 != llnet_ssl_trust_store_ctx_index) {
+		set = (LLNET_SSL_TRUST_STORE_set_t*)SSL_CTX_get_ex_data(ctx, llnet_ssl_trust_store_ctx_index);
+		if ((NULL == set) && create) {
+			set = calloc(1, sizeof(*set));
+			if ((NULL != set) && (1 != SSL_CTX_set_ex_data(ctx, llnet_ssl_trust_store_ctx_index, set))) {
+				free(set);
+				set = NULL;
+			}
+		}
+	}
+	return set;
+}
+
+/**
+ * @brief Gets a certificate from the cache, or parses it and adds it to the cache with no reference.
+ *
+ * @param[in] cert the encoded certificate.
+ * @param[in] cert_size the certificate length.
+ * @param[out] error the error code, set on error only.
+ *
+ * @return the certificate, NULL on error.
+ */
+static LLNET_SSL_TRUST_STORE_cert_t* LLNET_SSL_TRUST_STORE_get_cert(const uint8_t* cert, int32_t cert_size, int32_t* error) {
+	uint8_t hash[LLNET_SSL_TRUST_STORE_HASH_LENGTH];
+	LLNET_SSL_TRUST_STORE_cert_t* cached = NULL;
+
+	if (1 != EVP_Digest(cert, (size_t)cert_size, hash, NULL, EVP_sha256(), NULL)) {
+		*error = J_MEMORY_ERROR;
+	} else {
+		int32_t bucket = hash[0] % LLNET_SSL_TRUST_STORE_CERT_BUCKETS;
+		for (cached = llnet_ssl_trust_store_certs[bucket]; NULL != cached; cached = cached->next) {
+			if (0 == memcmp(cached->hash, hash, sizeof(hash))) {
+				break;
+			}
+		}
+
+		if (NULL == cached) {
+			X509* x509 = LLNET_SSL_X509_CERT_create(cert, 0, cert_size, NULL);
+			if (NULL == x509) {
+				*error = J_CERT_PARSE_ERROR;
+			} else {
+				cached = malloc(sizeof(*cached));
+				if (NULL == cached) {
+					X509_free(x509);
+					*error = J_MEMORY_ERROR;
+				} else {
+					(void)memcpy(cached->hash, hash, sizeof(hash));
+					cached->x509 = x509;
+					cached->references = 0;
+					cached->next = llnet_ssl_trust_store_certs[bucket];
+					llnet_ssl_trust_store_certs[bucket] = cached;
+				}
+			}
+		}
+	}
+	return cached;
+}
+
+/**
+ * @brief Releases a reference to a certificate, and frees it if it has no more reference.
+ */
+static void LLNET_SSL_TRUST_STORE_release_cert(LLNET_SSL_TRUST_STORE_cert_t* cert) {
+	if (cert->references > 0) {
+		cert->references--;
+	}
+	if (0 == cert->references) {
+		LLNET_SSL_TRUST_STORE_cert_t** previous = &llnet_ssl_trust_store_certs[cert->hash[0] % LLNET_SSL_TRUST_STORE_CERT_BUCKETS];
+		while (*previous != cert) {
+			previous = &(*previous)->next;
+		}
+		*previous = cert->next;
+		// The shared stores that hold the certificate have their own reference
+		X509_free(cert->x509);
+		free(cert);
+	}
+}
+
+/**
+ * @brief Releases the certificates of a context.
+ */
+static void LLNET_SSL_TRUST_STORE_release_certs(LLNET_SSL_TRUST_STORE_set_t* set) {
+	for (int32_t i = 0; i < set->count; i++) {
+		LLNET_SSL_TRUST_STORE_release_cert(set->certs[i]);
+	}
+	set->count = 0;
+}
+
+/**
+ * @brief Gets the shared store holding exactly the given certificates, or builds it.
+ *
+ * @return the shared store, NULL if out of memory.
+ */
+static LLNET_SSL_TRUST_STORE_store_t* LLNET_SSL_TRUST_STORE_get_store(LLNET_SSL_TRUST_STORE_set_t* set) {
+	uint8_t key[LLNET_SSL_TRUST_STORE_HASH_LENGTH];
+	LLNET_SSL_TRUST_STORE_store_t* shared = NULL;
+	EVP_MD_CTX* md_ctx = EVP_MD_CTX_new();
+	bool hashed = false;
+
+	// The key does not depend on the order the certificates were added in
+	if (set->count > 1) {
+		qsort(set->certs, (size_t)set->count, sizeof(*set->certs), LLNET_SSL_TRUST_STORE_compare_certs);
+	}
+	if ((NULL != md_ctx) && (1 == EVP_DigestInit_ex(md_ctx, EVP_sha256(), NULL))) {
+		hashed = true;
+		for (int32_t i = 0; hashed && (i < set->count); i++) {
+			hashed = (1 == EVP_DigestUpdate(md_ctx, set->certs[i]->hash, LLNET_SSL_TRUST_STORE_HASH_LENGTH));
+		}
+		hashed = hashed && (1 == EVP_DigestFinal_ex(md_ctx, key, NULL));
+	}
+	EVP_MD_CTX_free(md_ctx);
+
+	if (hashed) {
+		for (shared = llnet_ssl_trust_store_stores; NULL != shared; shared = shared->next) {
+			if (0 == memcmp(shared->key, key, sizeof(key))) {
+				break;
+			}
+		}
+	}
+
+	if (hashed && (NULL == shared)) {
+		if (-1 == llnet_ssl_trust_store_store_index) {
+			llnet_ssl_trust_store_store_index = X509_STORE_get_ex_new_index(0, NULL, NULL, NULL, NULL);
+		}
+		shared = malloc(sizeof(*shared));
+		X509_STORE* store = X509_STORE_new();
+		bool built = (NULL != shared) && (NULL != store) && (-1 != llnet_ssl_trust_store_store_index);
+		for (int32_t i = 0; built && (i < set->count); i++) {
+			built = (1 == X509_STORE_add_cert(store, set->certs[i]->x509));
+		}
+		if (built) {
+			llnet_ssl_trust_store_last_id++;
+			built = (1 == X509_STORE_set_ex_data(store, llnet_ssl_trust_store_store_index, (void*)llnet_ssl_trust_store_last_id));
+		}
+		if (built) {
+			(void)memcpy(shared->key, key, sizeof(key));
+			shared->store = store;
+			shared->id = llnet_ssl_trust_store_last_id;
+			shared->references = 0;
+			shared->next = llnet_ssl_trust_store_stores;
+			llnet_ssl_trust_store_stores = shared;
+		} else {
+			X509_STORE_free(store);
+			free(shared);
+			shared = NULL;
+		}
+	}
+	return shared;
+}
+
+/**
+ * @brief Releases a reference to a shared store, and frees it if no context is bound to it anymore. The contexts
+ * and sessions still using the X509 store hold their own reference.
+ */
+static void LLNET_SSL_TRUST_STORE_release_store(LLNET_SSL_TRUST_STORE_store_t* store) {
+	store->references--;
+	if (0 == store->references) {
+		LLNET_SSL_TRUST_STORE_store_t** previous = &llnet_ssl_trust_store_stores;
+		while (*previous != store) {
+			previous = &(*previous)->next;
+		}
+		*previous = store->next;
+		X509_STORE_free(store->store);
+		free(store);
+	}
+}
+
+/**
+ * @brief Orders the certificates by hash, for qsort().
+ */
+static int LLNET_SSL_TRUST_STORE_compare_certs(const void* a, const void* b) {
+	const LLNET_SSL_TRUST_STORE_cert_t* cert_a = *(const LLNET_SSL_TRUST_STORE_cert_t* const*)a;
+	const LLNET_SSL_TRUST_STORE_cert_t* cert_b = *(const LLNET_SSL_TRUST_STORE_cert_t* const*)b;
+	return memcmp(cert_a->hash, cert_b->hash, LLNET_SSL_TRUST_STORE_HASH_LENGTH);
+}
+
+#if LLNET_SSL_TRUST_STORE_VERIFY_CACHE_SIZE > 0
+/**
+ * @brief Peer certificate chain verification callback, set with SSL_CTX_set_cert_verify_callback(). Skips the
+ * verification of a chain successfully verified against the same shared store recently.
+ *
+ * Called from the task running the handshake.
+ */
+static int LLNET_SSL_TRUST_STORE_verify(X509_STORE_CTX* store_ctx, void* arg) {
+	(void)arg;
+	uint8_t key[LLNET_SSL_TRUST_STORE_HASH_LENGTH];
+	bool keyed = LLNET_SSL_TRUST_STORE_get_chain_key(store_ctx, key);
+	bool cached = false;
+	int ret;
+
+	if (keyed) {
+		int64_t now = LLNET_SSL_TRUST_STORE_get_time_s();
+		OSAL_mutex_take(&llnet_ssl_trust_store_mutex, OSAL_INFINITE_TIME);
+		for (int32_t i = 0; i < LLNET_SSL_TRUST_STORE_VERIFY_CACHE_SIZE; i++) {
+			LLNET_SSL_TRUST_STORE_verified_t* verified = &llnet_ssl_trust_store_verified[i];
+			if ((verified->expiry_s > now) && (0 == memcmp(verified->key, key, sizeof(key)))) {
+				// All the certificates of the chain, up to the trust anchor, must still be valid
+				cached = ((int64_t)time(NULL) < verified->not_after_s);
+				break;
+			}
+		}
+		OSAL_mutex_give(&llnet_ssl_trust_store_mutex);
+	}
+
+	if (cached) {
+		X509_STORE_CTX_set_error(store_ctx, X509_V_OK);
+		ret = 1;
+	} else {
+		ret = X509_verify_cert(store_ctx);
+		int64_t not_after_s;
+		if (keyed && (1 == ret) && LLNET_SSL_TRUST_STORE_get_chain_not_after(store_ctx, &not_after_s)) {
+			OSAL_mutex_take(&llnet_ssl_trust_store_mutex, OSAL_INFINITE_TIME);
+			LLNET_SSL_TRUST_STORE_verified_t* verified = &llnet_ssl_trust_store_verified[llnet_ssl_trust_store_verified_next];
+			(void)memcpy(verified->key, key, sizeof(key));
+			verified->expiry_s = LLNET_SSL_TRUST_STORE_get_time_s() + LLNET_SSL_TRUST_STORE_VERIFY_CACHE_TTL_S;
+			verified->not_after_s = not_after_s;
+			llnet_ssl_trust_store_verified_next = (llnet_ssl_trust_store_verified_next + 1) % LLNET_SSL_TRUST_STORE_VERIFY_CACHE_SIZE;
+			OSAL_mutex_give(&llnet_ssl_trust_store_mutex);
+		}
+	}
+	return ret;
+}
+
+/**
+ * @brief Computes the verification cache key of a peer chain: hash of the shared store identifier, the side of
+ * the connection (the certificate purpose differs) and the hashes of the chain certificates.
+ *
+ * @return false if the store is not a shared store or on error.
+ */
+static bool LLNET_SSL_TRUST_STORE_get_chain_key(X509_STORE_CTX* store_ctx, uint8_t* key) {
+	uintptr_t id = (uintptr_t)X509_STORE_get_ex_data(X509_STORE_CTX_get0_store(store_ctx), llnet_ssl_trust_store_store_index);
+	SSL* ssl = (SSL*)X509_STORE_CTX_get_ex_data(store_ctx, SSL_get_ex_data_X509_STORE_CTX_idx());
+	X509* leaf = X509_STORE_CTX_get0_cert(store_ctx);
+	STACK_OF(X509)* untrusted = X509_STORE_CTX_get0_untrusted(store_ctx);
+	EVP_MD_CTX* md_ctx;
+	bool keyed = false;
+
+	if ((0 != id) && (NULL != ssl) && (NULL != leaf)) {
+		md_ctx = EVP_MD_CTX_new();
+		if ((NULL != md_ctx) && (1 == EVP_DigestInit_ex(md_ctx, EVP_sha256(), NULL))) {
+			uint8_t is_server = (uint8_t)SSL_is_server(ssl);
+			uint8_t hash[EVP_MAX_MD_SIZE];
+			unsigned int hash_length;
+
+			keyed = (1 == EVP_DigestUpdate(md_ctx, &id, sizeof(id)))
+			        && (1 == EVP_DigestUpdate(md_ctx, &is_server, sizeof(is_server)))
+			        && (1 == X509_digest(leaf, EVP_sha256(), hash, &hash_length))
+			        && (1 == EVP_DigestUpdate(md_ctx, hash, hash_length));
+			for (int i = 0; keyed && (i < sk_X509_num(untrusted)); i++) {
+				X509* cert = sk_X509_value(untrusted, i);
+				if (cert != leaf) {
+					keyed = (1 == X509_digest(cert, EVP_sha256(), hash, &hash_length))
+					        && (1 == EVP_DigestUpdate(md_ctx, hash, hash_length));
+				}
+			}
+			keyed = keyed && (1 == EVP_DigestFinal_ex(md_ctx, key, NULL));
+		}
+		EVP_MD_CTX_free(md_ctx);
+	}
+	return keyed;
+}
+
+/**
+ * @brief Gets the earliest notAfter of the certificates of a verified chain, trust anchor included.
+ *
+ * @return false on error.
+ */
+static bool LLNET_SSL_TRUST_STORE_get_chain_not_after(X509_STORE_CTX* store_ctx, int64_t* not_after_s) {
+	STACK_OF(X509)* chain = X509_STORE_CTX_get0_chain(store_ctx);
+	int64_t now = (int64_t)time(NULL);
+	bool ok = (NULL != chain) && (0 < sk_X509_num(chain));
+
+	*not_after_s = INT64_MAX;
+	for (int i = 0; ok && (i < sk_X509_num(chain)); i++) {
+		int days;
+		int seconds;
+		// Time left from now to the notAfter of the certificate
+		ok = (1 == ASN1_TIME_diff(&days, &seconds, NULL, X509_get0_notAfter(sk_X509_value(chain, i))));
+		if (ok) {
+			int64_t not_after = now + ((int64_t)days * 86400) + seconds;
+			if (not_after < *not_after_s) {
+				*not_after_s = not_after;
+			}
+		}
+	}
+	return ok;
+}
+
+/**
+ * @brief Returns the monotonic time in seconds.
+ */
+static int64_t LLNET_SSL_TRUST_STORE_get_time_s(void) {
+	struct timespec now;
+	(void)clock_gettime(CLOCK_MONOTONIC, &now);
+	return (int64_t)now.tv_sec;
+}
+#endif // LLNET_SSL_TRUST_STORE_VERIFY_CACHE_SIZE > 0
+
+#else // OPENSSL_VERSION_NUMBER < 0x10100000L
+
+int32_t LLNET_SSL_TRUST_STORE_add(SSL_CTX* ctx, const uint8_t* cert, int32_t cert_size) {
+	int32_t ret = J_SSL_NO_ERROR;
+	X509* x509 = LLNET_SSL_X509_CERT_create(cert, 0, cert_size, NULL);
+
+	if (x509 != NULL) {
+		// The certificate has been created: add it the store of the context (create the store if needed).
+		X509_STORE* store = SSL_CTX_get_cert_store(ctx);
+		if (store == NULL) {
+			// No store for the context: create it
+			store = X509_STORE_new();
+			if (store != NULL) {
+				SSL_CTX_set_cert_store(ctx, store);
+			} else {
+				ret = J_CERT_PARSE_ERROR;
+			}
+		}
+
+		if ((store != NULL) && (X509_STORE_add_cert(store, x509) <= 0)) {
+			ret = J_CERT_PARSE_ERROR;
+		}
+		// The store holds its own reference
+		X509_free(x509);
+	} else {
+		ret = J_CERT_PARSE_ERROR;
+	}
+	return ret;
+}
+
+void LLNET_SSL_TRUST_STORE_clear(SSL_CTX* ctx) {
+	// The function SSL_CTX_set_cert_store() frees previously allocated store if any.
+	SSL_CTX_set_cert_store(ctx, X509_STORE_new());
+}
+
+int32_t LLNET_SSL_TRUST_STORE_bind(SSL_CTX* ctx) {
+	(void)ctx;
+	return J_SSL_NO_ERROR;
+}
+
+void LLNET_SSL_TRUST_STORE_release(SSL_CTX* ctx) {
+	(void)ctx;
+}
+
+#endif // OPENSSL_VERSION_NUMBER >= 0x10100000L
+
+#ifdef __cplusplus
+	}
+#endif
@@ -20,6 +20,10 @@ void T_LLKERNEL_main(void);
 
 TestRef	T_LLKERNEL_tests(void);
 
+TestRef	T_LLKERNEL_STRESS_tests(void);
+
+TestRef	T_LLKERNEL_STORE_tests(void);
+
 #ifdef __cplusplus
 }
 #endif
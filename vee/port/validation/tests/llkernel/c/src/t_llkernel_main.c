@@ -7,16 +7,44 @@
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdlib.h>
+#include <unistd.h>
 #include "t_llkernel.h"
 #include "../../../../framework/c/embunit/embUnit/embUnit.h"
 #include "../../../../framework/c/utils/inc/u_print.h"
 
+#include "LLKERNEL_RAM.h"
+#include "LLKERNEL_STORE.h"
+
 #define LLKERNEL_VERSION "v1.0.0"
 
+/* Feature store file of the tests, removed at the end. Not used if the LLKERNEL_STORE environment variable is set */
+#define LLKERNEL_TEST_STORE_TEMPLATE "/tmp/t_llkernel_XXXXXX.store"
+
 void T_LLKERNEL_main(void) {
     UTIL_print_string("\nT_LLKERNEL " LLKERNEL_VERSION "\n");
+#if LLKERNEL_STORE_ENABLED == 1
+	char store_path[] = LLKERNEL_TEST_STORE_TEMPLATE;
+	bool temporary_store = false;
+	if (NULL == getenv("LLKERNEL_STORE")) {
+		int fd = mkstemps(store_path, 6);
+		if (0 <= fd) {
+			(void)close(fd);
+			temporary_store = (0 == setenv("LLKERNEL_STORE", store_path, 1));
+		}
+	}
+#endif
 	TestRunner_start();
 	TestRunner_runTest(T_LLKERNEL_tests());
+	TestRunner_runTest(T_LLKERNEL_STORE_tests());
+	TestRunner_runTest(T_LLKERNEL_STRESS_tests());
 	TestRunner_end();
+#if LLKERNEL_STORE_ENABLED == 1
+	if (temporary_store) {
+		LLKERNEL_STORE_close();
+		(void)unlink(store_path);
+		(void)unsetenv("LLKERNEL_STORE");
+	}
+#endif
 	return;
 }
@@ -0,0 +1,150 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/**
+ * @file
+ * @brief Persistence tests of the LLKERNEL Feature store.
+ *
+ * Features are installed with the LLKERNEL natives, then the store file is closed and opened again, as on a restart:
+ * the committed Features must come back at the same addresses with the same content, and a Feature whose install
+ * was not flushed must be removed.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "t_llkernel.h"
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "../../../../framework/c/utils/inc/u_print.h"
+
+#include "LLKERNEL_RAM.h"
+#include "LLKERNEL_STORE.h"
+
+
+// --------------------------------------------------------------------------------
+// -                                  Constants                                   -
+// --------------------------------------------------------------------------------
+
+#define LLKERNEL_OK (0)
+
+#define STORE_NB_FEATURES   (3)
+#define STORE_ROM_SIZE      (3000)
+#define STORE_RAM_SIZE      (256)
+
+extern int32_t LLKERNEL_IMPL_allocateFeature__II(int32_t size_ROM, int32_t size_RAM);
+extern void *LLKERNEL_IMPL_getFeatureAddressROM__I(int32_t handle);
+extern int32_t LLKERNEL_IMPL_copyToROM__LiceTea_lang_Ram_2LiceTea_lang_Ram_2I(void *dest_address_ROM, void *src_address, int32_t size);
+extern int32_t LLKERNEL_IMPL_flushCopyToROM(void);
+extern int32_t LLKERNEL_IMPL_getAllocatedFeaturesCount(void);
+extern int32_t LLKERNEL_IMPL_getFeatureHandle__I(int32_t index);
+extern void LLKERNEL_IMPL_freeFeature__I(int32_t handle);
+
+/* Content of the features, the byte at offset o of the feature i is (i + o) */
+static uint8_t content[STORE_NB_FEATURES + STORE_ROM_SIZE];
+
+
+// --------------------------------------------------------------------------------
+// -                                  Utilities                                   -
+// --------------------------------------------------------------------------------
+
+static void cleanup_installed_features(void) {
+	int32_t nbAllocatedFeatures = LLKERNEL_IMPL_getAllocatedFeaturesCount();
+	while (nbAllocatedFeatures > 0) {
+		LLKERNEL_IMPL_freeFeature__I(LLKERNEL_IMPL_getFeatureHandle__I(0));
+		nbAllocatedFeatures = LLKERNEL_IMPL_getAllocatedFeaturesCount();
+	}
+}
+
+/** @brief Installs a feature with the natives, returns false on error. */
+static bool install_feature(int32_t index, uint8_t** ROM_area) {
+	int32_t handle = LLKERNEL_IMPL_allocateFeature__II(STORE_ROM_SIZE, STORE_RAM_SIZE);
+	if (0 == handle) {
+		return false;
+	}
+	*ROM_area = (uint8_t*)LLKERNEL_IMPL_getFeatureAddressROM__I(handle);
+	return LLKERNEL_OK == LLKERNEL_IMPL_copyToROM__LiceTea_lang_Ram_2LiceTea_lang_Ram_2I(*ROM_area, &content[index],
+	                                                                                      STORE_ROM_SIZE);
+}
+
+/** @brief Function call before running test. */
+static void T_LLKERNEL_STORE_setUp(void)
+{
+	UTIL_print_string("\nT_LLKERNEL_STORE_setUp\n");
+	cleanup_installed_features();
+	for (int32_t i = 0; i < (int32_t)sizeof(content); i++) {
+		content[i] = (uint8_t)i;
+	}
+}
+
+/** @brief Function call after running test. */
+static void T_LLKERNEL_STORE_tearDown(void)
+{
+	UTIL_print_string("T_LLKERNEL_STORE_tearDown\n");
+	cleanup_installed_features();
+}
+
+
+// --------------------------------------------------------------------------------
+// -                                  Tests                                       -
+// --------------------------------------------------------------------------------
+
+/** @brief Checks that the flushed features are found after a re-open of the store, and the interrupted one is not. */
+static void T_LLKERNEL_CHECK_store_reopen(void)
+{
+	UTIL_print_string("LLKERNEL store re-open\n");
+#if LLKERNEL_STORE_ENABLED == 1
+	if (!LLKERNEL_STORE_open()) {
+		UTIL_print_string("Feature store unavailable, test skipped\n");
+		return;
+	}
+
+	uint8_t* ROM_areas[STORE_NB_FEATURES];
+	for (int32_t i = 0; i < (STORE_NB_FEATURES - 1); i++) {
+		TEST_ASSERT_MESSAGE(install_feature(i, &ROM_areas[i]), "Feature install failed");
+	}
+	TEST_ASSERT_MESSAGE(LLKERNEL_OK == LLKERNEL_IMPL_flushCopyToROM(), "LLKERNEL_IMPL_flushCopyToROM() returned an error");
+	// Interrupted install: copied but not flushed
+	TEST_ASSERT_MESSAGE(install_feature(STORE_NB_FEATURES - 1, &ROM_areas[STORE_NB_FEATURES - 1]),
+	                    "Feature install failed");
+
+	LLKERNEL_STORE_close();
+	TEST_ASSERT_MESSAGE(LLKERNEL_STORE_open(), "LLKERNEL_STORE_open() failed");
+
+	int32_t slots[LLKERNEL_STORE_MAX_FEATURES];
+	int32_t count = LLKERNEL_STORE_get_slots(slots, LLKERNEL_STORE_MAX_FEATURES);
+	TEST_ASSERT_EQUAL_INT(STORE_NB_FEATURES - 1, count);
+	for (int32_t i = 0; i < count; i++) {
+		void* ROM_area;
+		void* RAM_area;
+		int32_t ROM_area_size;
+		int32_t RAM_area_size;
+		LLKERNEL_STORE_get_areas(slots[i], &ROM_area, &ROM_area_size, &RAM_area, &RAM_area_size);
+		TEST_ASSERT_MESSAGE(ROM_areas[i] == (uint8_t*)ROM_area, "Wrong ROM address after re-open");
+		TEST_ASSERT_EQUAL_INT(STORE_ROM_SIZE, ROM_area_size);
+		TEST_ASSERT_EQUAL_INT(STORE_RAM_SIZE, RAM_area_size);
+		TEST_ASSERT_MESSAGE(0 == memcmp(ROM_area, &content[i], STORE_ROM_SIZE), "Corrupted feature content after re-open");
+	}
+#else
+	UTIL_print_string("Feature store disabled, test skipped\n");
+#endif
+}
+
+TestRef T_LLKERNEL_STORE_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixture_llkernel_store) {
+		new_TestFixture("T_LLKERNEL_store_reopen", T_LLKERNEL_CHECK_store_reopen),
+	};
+	EMB_UNIT_TESTCALLER(llkernel_store_tests, "LLKERNEL store", T_LLKERNEL_STORE_setUp, T_LLKERNEL_STORE_tearDown,
+	                    fixture_llkernel_store);
+
+	return (TestRef)&llkernel_store_tests;
+}
@@ -0,0 +1,274 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/**
+ * @file
+ * @brief Install/uninstall stress benchmark of the LLKERNEL natives.
+ *
+ * For STRESS_DURATION_MS milliseconds (LLKERNEL_STRESS_DURATION_MS environment variable), features are allocated until
+ * LLKERNEL_IMPL_allocateFeature() fails (or STRESS_MAX_FEATURES are installed), copied to ROM by interleaved chunks like
+ * several downloads in progress, looked up by index and handle, then uninstalled in a different order than the install
+ * one. The install order, the handles and the ROM contents are checked at each cycle.
+ *
+ * The number of operations per second of each step is printed at the end, after the allocation mode. With the Feature
+ * store (LLKERNEL_STORE_ENABLED, the default with KERNEL_RAM_IMPL_MALLOC), the Features are allocated in the store
+ * file and the copy step includes the sync of the file by LLKERNEL_IMPL_flushCopyToROM(): the figures depend on the
+ * storage of the file (a temporary file of /tmp for the validation, see t_llkernel_main.c). Otherwise, the Features
+ * are allocated in the arena or the heap and the flush does nothing.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "t_llkernel.h"
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "../../../../framework/c/utils/inc/u_print.h"
+
+#include "LLKERNEL_RAM.h"
+#include "LLKERNEL_STORE.h"
+
+
+// --------------------------------------------------------------------------------
+// -                                  Constants                                   -
+// --------------------------------------------------------------------------------
+
+#define LLKERNEL_OK (0)
+
+/* Default duration of the benchmark */
+#ifndef STRESS_DURATION_MS
+#define STRESS_DURATION_MS      (1000)
+#endif
+
+/* Maximum number of features installed at the same time */
+#define STRESS_MAX_FEATURES     (64)
+
+/* Size of the chunks copied to ROM */
+#define STRESS_CHUNK_SIZE       (64)
+
+/* ROM area sizes are STRESS_ROM_SIZE + (index % 8) * STRESS_ROM_SIZE */
+#define STRESS_ROM_SIZE         (512)
+#define STRESS_MAX_ROM_SIZE     (8 * STRESS_ROM_SIZE)
+#define STRESS_RAM_SIZE         (256)
+
+/* Lookups of all the installed features per cycle */
+#define STRESS_LOOKUP_ROUNDS    (16)
+
+extern int32_t LLKERNEL_IMPL_allocateFeature__II(int32_t size_ROM, int32_t size_RAM);
+extern void *LLKERNEL_IMPL_getFeatureAddressROM__I(int32_t handle);
+extern void *LLKERNEL_IMPL_getFeatureAddressRAM__I(int32_t handle);
+extern int32_t LLKERNEL_IMPL_copyToROM__LiceTea_lang_Ram_2LiceTea_lang_Ram_2I(void *dest_address_ROM, void *src_address, int32_t size);
+extern int32_t LLKERNEL_IMPL_flushCopyToROM(void);
+extern int32_t LLKERNEL_IMPL_getAllocatedFeaturesCount(void);
+extern int32_t LLKERNEL_IMPL_getFeatureHandle__I(int32_t index);
+extern void LLKERNEL_IMPL_freeFeature__I(int32_t handle);
+
+typedef struct {
+	const char* name;
+	int64_t operations;
+	int64_t time_ns;
+} stress_step;
+
+enum { STEP_INSTALL, STEP_COPY, STEP_LOOKUP, STEP_UNINSTALL, NB_STEPS };
+
+static stress_step steps[NB_STEPS] = {
+	{ "install",   0, 0 },
+	{ "copy chunk", 0, 0 },
+	{ "lookup",    0, 0 },
+	{ "uninstall", 0, 0 },
+};
+
+static int32_t handles[STRESS_MAX_FEATURES];
+static uint8_t* ROM_areas[STRESS_MAX_FEATURES];
+static int32_t ROM_sizes[STRESS_MAX_FEATURES];
+
+/* Content of the features, the byte at offset o of the feature i is (i + o) */
+static uint8_t content[STRESS_MAX_FEATURES + STRESS_MAX_ROM_SIZE];
+
+
+// --------------------------------------------------------------------------------
+// -                                  Utilities                                   -
+// --------------------------------------------------------------------------------
+
+static int64_t get_time_ns(void) {
+	struct timespec ts;
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((int64_t)ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+
+static void add_step_time(int32_t step, int64_t start, int64_t operations) {
+	steps[step].time_ns += get_time_ns() - start;
+	steps[step].operations += operations;
+}
+
+static void cleanup_installed_features(void) {
+	int32_t nbAllocatedFeatures = LLKERNEL_IMPL_getAllocatedFeaturesCount();
+	while (nbAllocatedFeatures > 0) {
+		LLKERNEL_IMPL_freeFeature__I(LLKERNEL_IMPL_getFeatureHandle__I(0));
+		nbAllocatedFeatures = LLKERNEL_IMPL_getAllocatedFeaturesCount();
+	}
+}
+
+/** @brief Gets where the features are allocated, and what the copy step measures. */
+static const char* get_allocation_mode(void) {
+	const char* mode = "heap, copy in memory";
+#if LLKERNEL_ARENA_ENABLED == 1
+	mode = "Feature arena, copy in memory";
+#endif
+#if LLKERNEL_STORE_ENABLED == 1
+	if (LLKERNEL_STORE_open()) {
+		mode = "Feature store file, copy includes the file sync";
+	}
+#endif
+	return mode;
+}
+
+/** @brief Checks that the features still installed are in their install order. */
+static void check_install_order(int32_t nb_features, int32_t first, int32_t increment) {
+	int32_t index = 0;
+	for (int32_t i = first; i < nb_features; i += increment) {
+		TEST_ASSERT_EQUAL_INT(handles[i], LLKERNEL_IMPL_getFeatureHandle__I(index));
+		index++;
+	}
+	TEST_ASSERT_EQUAL_INT(index, LLKERNEL_IMPL_getAllocatedFeaturesCount());
+}
+
+/** @brief Function call before running test. */
+static void T_LLKERNEL_STRESS_setUp(void)
+{
+	UTIL_print_string("\nT_LLKERNEL_STRESS_setUp\n");
+	cleanup_installed_features();
+	for (int32_t i = 0; i < (int32_t)sizeof(content); i++) {
+		content[i] = (uint8_t)i;
+	}
+}
+
+/** @brief Function call after running test. */
+static void T_LLKERNEL_STRESS_tearDown(void)
+{
+	UTIL_print_string("T_LLKERNEL_STRESS_tearDown\n");
+	cleanup_installed_features();
+}
+
+
+// --------------------------------------------------------------------------------
+// -                                  Benchmark                                   -
+// --------------------------------------------------------------------------------
+
+/** @brief Installs, copies, looks up and uninstalls features for STRESS_DURATION_MS milliseconds. */
+static void T_LLKERNEL_CHECK_install_uninstall_stress(void)
+{
+	UTIL_print_string("LLKERNEL install/uninstall stress\n");
+
+	const char* duration = getenv("LLKERNEL_STRESS_DURATION_MS");
+	int64_t duration_ns = (int64_t)((NULL != duration) ? atoi(duration) : STRESS_DURATION_MS) * 1000000;
+	int64_t cycles = 0;
+	int32_t nb_features = 0;
+
+	int64_t bench_start = get_time_ns();
+	do {
+		// Install: allocate up to the maximum number of features
+		int64_t start = get_time_ns();
+		nb_features = 0;
+		while (nb_features < STRESS_MAX_FEATURES) {
+			int32_t size_ROM = STRESS_ROM_SIZE + ((nb_features % 8) * STRESS_ROM_SIZE);
+			int32_t handle = LLKERNEL_IMPL_allocateFeature__II(size_ROM, STRESS_RAM_SIZE);
+			if (0 == handle) {
+				break;
+			}
+			handles[nb_features] = handle;
+			ROM_sizes[nb_features] = size_ROM;
+			ROM_areas[nb_features] = (uint8_t*)LLKERNEL_IMPL_getFeatureAddressROM__I(handle);
+			nb_features++;
+		}
+		add_step_time(STEP_INSTALL, start, nb_features);
+		TEST_ASSERT_MESSAGE(0 < nb_features, "LLKERNEL_IMPL_allocateFeature() returned an error");
+
+		// Copy: one chunk of each feature in turn
+		start = get_time_ns();
+		int64_t chunks = 0;
+		for (int32_t offset = 0; offset < STRESS_MAX_ROM_SIZE; offset += STRESS_CHUNK_SIZE) {
+			for (int32_t i = 0; i < nb_features; i++) {
+				if (offset < ROM_sizes[i]) {
+					int32_t result = LLKERNEL_IMPL_copyToROM__LiceTea_lang_Ram_2LiceTea_lang_Ram_2I(
+						ROM_areas[i] + offset, &content[i + offset], STRESS_CHUNK_SIZE);
+					TEST_ASSERT_MESSAGE(LLKERNEL_OK == result, "LLKERNEL_IMPL_copyToROM() returned an error");
+					chunks++;
+				}
+			}
+		}
+		TEST_ASSERT_MESSAGE(LLKERNEL_OK == LLKERNEL_IMPL_flushCopyToROM(),
+		                    "LLKERNEL_IMPL_flushCopyToROM() returned an error");
+		add_step_time(STEP_COPY, start, chunks);
+
+		for (int32_t i = 0; i < nb_features; i++) {
+			TEST_ASSERT_MESSAGE(0 == memcmp(ROM_areas[i], &content[i], ROM_sizes[i]), "Corrupted feature content");
+		}
+
+		// Lookup: handle of each allocation index, then its areas
+		start = get_time_ns();
+		for (int32_t round = 0; round < STRESS_LOOKUP_ROUNDS; round++) {
+			for (int32_t i = 0; i < nb_features; i++) {
+				int32_t handle = LLKERNEL_IMPL_getFeatureHandle__I(i);
+				TEST_ASSERT_EQUAL_INT(handles[i], handle);
+				TEST_ASSERT_MESSAGE(ROM_areas[i] == LLKERNEL_IMPL_getFeatureAddressROM__I(handle), "Wrong ROM address");
+				TEST_ASSERT_NOT_NULL(LLKERNEL_IMPL_getFeatureAddressRAM__I(handle));
+			}
+		}
+		add_step_time(STEP_LOOKUP, start, (int64_t)STRESS_LOOKUP_ROUNDS * nb_features);
+
+		// Uninstall: odd allocation indexes first, then the remaining features from the last one
+		start = get_time_ns();
+		for (int32_t i = 1; i < nb_features; i += 2) {
+			LLKERNEL_IMPL_freeFeature__I(handles[i]);
+		}
+		add_step_time(STEP_UNINSTALL, start, nb_features / 2);
+		check_install_order(nb_features, 0, 2);
+		if (0 == cycles) {
+			// A freed handle is not valid anymore (checked once, the error is logged)
+			TEST_ASSERT_NULL(LLKERNEL_IMPL_getFeatureAddressROM__I(handles[1]));
+		}
+
+		start = get_time_ns();
+		for (int32_t i = ((nb_features - 1) / 2) * 2; i >= 0; i -= 2) {
+			LLKERNEL_IMPL_freeFeature__I(handles[i]);
+		}
+		add_step_time(STEP_UNINSTALL, start, (nb_features + 1) / 2);
+		TEST_ASSERT_EQUAL_INT(0, LLKERNEL_IMPL_getAllocatedFeaturesCount());
+
+		cycles++;
+	} while ((get_time_ns() - bench_start) < duration_ns);
+
+	char line[128];
+	(void)snprintf(line, sizeof(line), "Allocation mode: %s\n", get_allocation_mode());
+	UTIL_print_string(line);
+	(void)snprintf(line, sizeof(line), "%lld cycles of %d features\n", (long long)cycles, (int)nb_features);
+	UTIL_print_string(line);
+	for (int32_t i = 0; i < NB_STEPS; i++) {
+		double seconds = (double)steps[i].time_ns / 1e9;
+		(void)snprintf(line, sizeof(line), "%-12s %12lld ops %14.1f op/s\n", steps[i].name,
+		               (long long)steps[i].operations, (double)steps[i].operations / seconds);
+		UTIL_print_string(line);
+	}
+}
+
+TestRef T_LLKERNEL_STRESS_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixture_llkernel_stress) {
+		new_TestFixture("T_LLKERNEL_install_uninstall_stress", T_LLKERNEL_CHECK_install_uninstall_stress),
+	};
+	EMB_UNIT_TESTCALLER(llkernel_stress_tests, "LLKERNEL stress", T_LLKERNEL_STRESS_setUp, T_LLKERNEL_STRESS_tearDown,
+	                    fixture_llkernel_stress);
+
+	return (TestRef)&llkernel_stress_tests;
+}
@@ -0,0 +1,35 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#ifndef T_LLNET_H
+#define T_LLNET_H
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @brief this function is the entry point for the LLNET Test Suite.
+ */
+void T_LLNET_main(void);
+
+/**
+ * @brief Functional tests of the Unix domain socket natives of the net module (see t_llnet.c).
+ */
+TestRef	T_LLNET_tests(void);
+
+/**
+ * @brief Loopback latency and throughput benchmark of the socket options of the net module (see t_llnet_bench.c).
+ */
+TestRef	T_LLNET_BENCH_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,291 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/**
+ * @file
+ * @brief Functional tests of the Unix domain socket natives of the net module.
+ *
+ * The natives are called as the Java channels do. Without the VM, a native cannot wait for a socket: each call is
+ * made when it completes at once (connection with room in the backlog, read of data already sent).
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/un.h>
+
+#include "t_llnet.h"
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "../../../../framework/c/utils/inc/u_print.h"
+
+#include "LLNET_CHANNEL_impl.h"
+#include "LLNET_STREAMSOCKETCHANNEL_impl.h"
+#include "unix_socket.h"
+
+
+// --------------------------------------------------------------------------------
+// -                                  Constants                                   -
+// --------------------------------------------------------------------------------
+
+/* Directory of the filesystem paths, and prefix of the names (followed by the process id) */
+#define UNIX_DIRECTORY      "/tmp/"
+#define UNIX_NAME           "t_llnet"
+
+/* Size of the path buffers: as sun_path */
+#define UNIX_PATH_SIZE      ((int32_t)sizeof(((struct sockaddr_un*)0)->sun_path))
+
+/* Size of the messages */
+#define MESSAGE_SIZE        (100)
+
+static int8_t message[MESSAGE_SIZE];
+static int8_t receiveBuffer[MESSAGE_SIZE];
+
+/**
+ * @brief Fills the bytes of a Unix domain socket path, as given to the natives (without terminating NUL character).
+ *
+ * @param[out] path the buffer of UNIX_PATH_SIZE bytes to fill.
+ * @param[in] abstract true for an address in the abstract namespace, false for a filesystem path.
+ * @param[in] suffix the suffix of the name, unique in the test.
+ *
+ * @return the path length.
+ */
+static int32_t make_path(int8_t* path, bool abstract, const char* suffix) {
+	char name[UNIX_PATH_SIZE];
+	int32_t length = snprintf(name, sizeof(name), "%s%s_%d_%s", abstract ? "@" : UNIX_DIRECTORY, UNIX_NAME,
+	                          (int)getpid(), suffix);
+	(void)memcpy(path, name, (size_t)length);
+	if (abstract) {
+		path[0] = 0;
+	} else {
+		// Left by an interrupted run
+		(void)unlink(name);
+	}
+	return length;
+}
+
+/** @brief Removes the file of a filesystem path, once its socket is closed. */
+static void remove_path(const int8_t* path, int32_t length) {
+	if (0 != path[0]) {
+		char name[UNIX_PATH_SIZE + 1];
+		(void)memcpy(name, path, (size_t)length);
+		name[length] = '\0';
+		(void)unlink(name);
+	}
+}
+
+/** @brief Returns true if the path returned by a native is the expected one. */
+static bool path_equals(const int8_t* expected, int32_t expected_length, const int8_t* path, int32_t length) {
+	return (length == expected_length) && (0 == memcmp(expected, path, (size_t)length));
+}
+
+/**
+ * @brief Opens a Unix domain stream connection with the natives: the listening socket is bound to the path.
+ *
+ * @return false on error.
+ */
+static bool open_stream(const int8_t* path, int32_t length, int32_t* listen_fd, int32_t* client_fd, int32_t* server_fd) {
+	*listen_fd = LLNET_UNIX_IMPL_socket(1);
+	*client_fd = LLNET_UNIX_IMPL_socket(1);
+	*server_fd = -1;
+	if ((*listen_fd <= 0) || (*client_fd <= 0)) {
+		return false;
+	}
+	LLNET_UNIX_IMPL_bind(*listen_fd, (int8_t*)path, length);
+	LLNET_CHANNEL_IMPL_listen(*listen_fd, 1);
+	// The backlog has room: the connection completes without waiting
+	LLNET_UNIX_IMPL_connect(*client_fd, (int8_t*)path, length, 0);
+	*server_fd = LLNET_STREAMSOCKETCHANNEL_IMPL_accept(*listen_fd, 0);
+	return *server_fd > 0;
+}
+
+/** @brief Closes the sockets of a connection, as the Java channels do. */
+static void close_stream(int32_t listen_fd, int32_t client_fd, int32_t server_fd) {
+	int32_t fds[] = { client_fd, server_fd, listen_fd };
+	for (int32_t i = 0; i < (int32_t)(sizeof(fds) / sizeof(fds[0])); i++) {
+		if (fds[i] > 0) {
+			LLNET_CHANNEL_IMPL_close(fds[i]);
+		}
+	}
+}
+
+/** @brief Function call before running test. */
+static void T_LLNET_setUp(void)
+{
+	UTIL_print_string("\nT_LLNET_setUp\n");
+	for (int32_t i = 0; i < MESSAGE_SIZE; i++) {
+		message[i] = (int8_t)i;
+	}
+	(void)memset(receiveBuffer, 0, sizeof(receiveBuffer));
+}
+
+/** @brief Function call after running test. */
+static void T_LLNET_tearDown(void)
+{
+	UTIL_print_string("T_LLNET_tearDown\n");
+}
+
+/** @brief Connects a stream socket to a listening socket bound to a path, checks the local and peer paths of the
+ *  		sockets, then exchanges data with the stream natives.
+ */
+static void check_stream(bool abstract)
+{
+	int8_t path[UNIX_PATH_SIZE];
+	int8_t readPath[UNIX_PATH_SIZE];
+	int32_t length = make_path(path, abstract, "stream");
+	int32_t listen_fd;
+	int32_t client_fd;
+	int32_t server_fd;
+
+	bool opened = open_stream(path, length, &listen_fd, &client_fd, &server_fd);
+	if (!opened) {
+		close_stream(listen_fd, client_fd, server_fd);
+		remove_path(path, length);
+		TEST_ASSERT_MESSAGE(false, "Cannot open the Unix domain connection");
+	}
+
+	int32_t readLength = LLNET_UNIX_IMPL_getLocalPath(listen_fd, readPath, UNIX_PATH_SIZE);
+	TEST_ASSERT_MESSAGE(path_equals(path, length, readPath, readLength), "Wrong local path of the listening socket");
+	readLength = LLNET_UNIX_IMPL_getLocalPath(server_fd, readPath, UNIX_PATH_SIZE);
+	TEST_ASSERT_MESSAGE(path_equals(path, length, readPath, readLength), "Wrong local path of the accepted socket");
+	readLength = LLNET_UNIX_IMPL_getPeerPath(client_fd, readPath, UNIX_PATH_SIZE);
+	TEST_ASSERT_MESSAGE(path_equals(path, length, readPath, readLength), "Wrong peer path of the client socket");
+	/* The client socket is not bound */
+	TEST_ASSERT_EQUAL_INT(0, LLNET_UNIX_IMPL_getLocalPath(client_fd, readPath, UNIX_PATH_SIZE));
+	TEST_ASSERT_EQUAL_INT(0, LLNET_UNIX_IMPL_getPeerPath(server_fd, readPath, UNIX_PATH_SIZE));
+
+	LLNET_STREAMSOCKETCHANNEL_IMPL_write(client_fd, message, 0, MESSAGE_SIZE);
+	TEST_ASSERT_EQUAL_INT(MESSAGE_SIZE, LLNET_STREAMSOCKETCHANNEL_IMPL_read(server_fd, receiveBuffer, 0, MESSAGE_SIZE, 0));
+	TEST_ASSERT_MESSAGE(0 == memcmp(message, receiveBuffer, MESSAGE_SIZE), "Received data differs from the sent data");
+
+	close_stream(listen_fd, client_fd, server_fd);
+	remove_path(path, length);
+}
+
+static void T_LLNET_CHECK_unix_stream_path(void)
+{
+	check_stream(false);
+}
+
+static void T_LLNET_CHECK_unix_stream_abstract(void)
+{
+	check_stream(true);
+}
+
+/** @brief Sends datagrams to a socket bound to an abstract address: from a socket bound to a filesystem path, then
+ *  		from the same socket once connected, then from an unbound socket. The receiver gets the sender path.
+ */
+static void T_LLNET_CHECK_unix_datagram(void)
+{
+	int8_t senderPath[UNIX_PATH_SIZE];
+	int8_t receiverPath[UNIX_PATH_SIZE];
+	int8_t readPath[UNIX_PATH_SIZE];
+	int32_t senderLength = make_path(senderPath, false, "sender");
+	int32_t receiverLength = make_path(receiverPath, true, "receiver");
+
+	int32_t sender_fd = LLNET_UNIX_IMPL_socket(0);
+	int32_t receiver_fd = LLNET_UNIX_IMPL_socket(0);
+	int32_t unbound_fd = LLNET_UNIX_IMPL_socket(0);
+	TEST_ASSERT_MESSAGE((sender_fd > 0) && (receiver_fd > 0) && (unbound_fd > 0),
+	                    "LLNET_UNIX_IMPL_socket() returned an error");
+	LLNET_UNIX_IMPL_bind(sender_fd, senderPath, senderLength);
+	LLNET_UNIX_IMPL_bind(receiver_fd, receiverPath, receiverLength);
+
+	/* The datagram is queued on the receiver by the send */
+	LLNET_UNIX_IMPL_send(sender_fd, message, 0, MESSAGE_SIZE, receiverPath, receiverLength);
+	int64_t result = LLNET_UNIX_IMPL_receive(receiver_fd, receiveBuffer, 0, MESSAGE_SIZE, readPath, UNIX_PATH_SIZE, 0);
+	TEST_ASSERT_EQUAL_INT(MESSAGE_SIZE, (int32_t)(result >> 32));
+	TEST_ASSERT_MESSAGE(path_equals(senderPath, senderLength, readPath, (int32_t)result), "Wrong sender path");
+	TEST_ASSERT_MESSAGE(0 == memcmp(message, receiveBuffer, MESSAGE_SIZE), "Received data differs from the sent data");
+
+	/* Connected: sent without path */
+	LLNET_UNIX_IMPL_connect(sender_fd, receiverPath, receiverLength, 0);
+	int32_t readLength = LLNET_UNIX_IMPL_getPeerPath(sender_fd, readPath, UNIX_PATH_SIZE);
+	TEST_ASSERT_MESSAGE(path_equals(receiverPath, receiverLength, readPath, readLength), "Wrong peer path");
+	LLNET_UNIX_IMPL_send(sender_fd, message, 10, 20, NULL, 0);
+	result = LLNET_UNIX_IMPL_receive(receiver_fd, receiveBuffer, 0, MESSAGE_SIZE, readPath, UNIX_PATH_SIZE, 0);
+	TEST_ASSERT_EQUAL_INT(20, (int32_t)(result >> 32));
+	TEST_ASSERT_MESSAGE(path_equals(senderPath, senderLength, readPath, (int32_t)result), "Wrong sender path");
+	TEST_ASSERT_MESSAGE(0 == memcmp(message + 10, receiveBuffer, 20), "Received data differs from the sent data");
+
+	/* Unbound sender: no path */
+	LLNET_UNIX_IMPL_send(unbound_fd, message, 0, 1, receiverPath, receiverLength);
+	result = LLNET_UNIX_IMPL_receive(receiver_fd, receiveBuffer, 0, MESSAGE_SIZE, readPath, UNIX_PATH_SIZE, 0);
+	TEST_ASSERT_EQUAL_INT(1, (int32_t)(result >> 32));
+	TEST_ASSERT_EQUAL_INT(0, (int32_t)result);
+
+	LLNET_CHANNEL_IMPL_close(unbound_fd);
+	LLNET_CHANNEL_IMPL_close(receiver_fd);
+	LLNET_CHANNEL_IMPL_close(sender_fd);
+	remove_path(senderPath, senderLength);
+}
+
+/** @brief Passes the write end of a pipe over a Unix domain connection (SCM_RIGHTS), then writes to the pipe through
+ *  		the received file descriptor. Then data without file descriptor, and the end of the connection.
+ */
+static void T_LLNET_CHECK_unix_pass_fd(void)
+{
+	int8_t path[UNIX_PATH_SIZE];
+	int32_t length = make_path(path, true, "fd");
+	int32_t listen_fd;
+	int32_t client_fd;
+	int32_t server_fd;
+	int pipe_fds[2];
+
+	bool opened = open_stream(path, length, &listen_fd, &client_fd, &server_fd);
+	if (!opened) {
+		close_stream(listen_fd, client_fd, server_fd);
+		TEST_ASSERT_MESSAGE(false, "Cannot open the Unix domain connection");
+	}
+	TEST_ASSERT_EQUAL_INT(0, pipe2(pipe_fds, O_CLOEXEC));
+
+	TEST_ASSERT_EQUAL_INT(1, LLNET_UNIX_IMPL_sendWithFd(client_fd, message, 5, 1, pipe_fds[1]));
+	/* The received file descriptor keeps the pipe open */
+	(void)close(pipe_fds[1]);
+	int32_t received_fd = -1;
+	TEST_ASSERT_EQUAL_INT(1, LLNET_UNIX_IMPL_receiveWithFd(server_fd, receiveBuffer, 0, MESSAGE_SIZE, &received_fd, 0));
+	TEST_ASSERT_EQUAL_INT(message[5], receiveBuffer[0]);
+	TEST_ASSERT_MESSAGE(received_fd >= 0, "No file descriptor received");
+	TEST_ASSERT_MESSAGE(0 != (fcntl(received_fd, F_GETFD) & FD_CLOEXEC), "Received file descriptor not close-on-exec");
+
+	TEST_ASSERT_EQUAL_INT(MESSAGE_SIZE, (int32_t)write(received_fd, message, MESSAGE_SIZE));
+	(void)close(received_fd);
+	TEST_ASSERT_EQUAL_INT(MESSAGE_SIZE, (int32_t)read(pipe_fds[0], receiveBuffer, MESSAGE_SIZE));
+	TEST_ASSERT_MESSAGE(0 == memcmp(message, receiveBuffer, MESSAGE_SIZE), "Data differs through the passed pipe");
+	/* Every write end is closed */
+	TEST_ASSERT_EQUAL_INT(0, (int32_t)read(pipe_fds[0], receiveBuffer, MESSAGE_SIZE));
+	(void)close(pipe_fds[0]);
+
+	LLNET_STREAMSOCKETCHANNEL_IMPL_write(client_fd, message, 0, MESSAGE_SIZE);
+	received_fd = 0;
+	TEST_ASSERT_EQUAL_INT(MESSAGE_SIZE,
+	                      LLNET_UNIX_IMPL_receiveWithFd(server_fd, receiveBuffer, 0, MESSAGE_SIZE, &received_fd, 0));
+	TEST_ASSERT_EQUAL_INT(-1, received_fd);
+
+	LLNET_CHANNEL_IMPL_close(client_fd);
+	TEST_ASSERT_EQUAL_INT(-1, LLNET_UNIX_IMPL_receiveWithFd(server_fd, receiveBuffer, 0, MESSAGE_SIZE, &received_fd, 0));
+
+	close_stream(listen_fd, -1, server_fd);
+}
+
+TestRef T_LLNET_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixture_llnet) {
+		new_TestFixture("T_LLNET_unix_stream_path", T_LLNET_CHECK_unix_stream_path),
+		new_TestFixture("T_LLNET_unix_stream_abstract", T_LLNET_CHECK_unix_stream_abstract),
+		new_TestFixture("T_LLNET_unix_datagram", T_LLNET_CHECK_unix_datagram),
+		new_TestFixture("T_LLNET_unix_pass_fd", T_LLNET_CHECK_unix_pass_fd),
+	};
+	EMB_UNIT_TESTCALLER(llnet_tests, "LLNET Unix domain sockets", T_LLNET_setUp, T_LLNET_tearDown, fixture_llnet);
+
+	return (TestRef)&llnet_tests;
+}
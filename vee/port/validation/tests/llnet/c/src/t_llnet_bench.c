@@ -0,0 +1,565 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/**
+ * @file
+ * @brief Loopback benchmark of the socket options of the net module.
+ *
+ * The natives need the VM to wait for the sockets, so the TCP connections are made with the system calls of the
+ * natives, the socket options are set with the LLNET_CHANNEL natives, and the helpers of the net module are called as
+ * the natives do (Fast Open statistics). The Unix domain connections are made with the LLNET_UNIX natives, which do
+ * not wait when the backlog has room. The echo and bulk connections are closed with LLNET_CHANNEL_IMPL_close().
+ * Each measurement lasts BENCH_DURATION_MS milliseconds (LLNET_BENCH_DURATION_MS environment variable), and prints
+ * the number of operations per second and the median and 99th percentile duration of one operation.
+ *
+ * - TCP Fast Open: the LLNET_SOCKETOPTION_TCP_FASTOPEN and LLNET_SOCKETOPTION_TCP_FASTOPEN_CONNECT options are set
+ *   and read back, then connection, request and response on 127.0.0.1, with a regular 3-way handshake then with
+ *   TCP_FASTOPEN_CONNECT. Fast Open saves one round trip per connection: on loopback it is only visible with an
+ *   artificial latency, e.g. <code>tc qdisc add dev lo root netem delay 5ms</code> (then
+ *   <code>tc qdisc del dev lo root</code>). The kernel must accept Fast Open for clients and servers
+ *   (<code>net.ipv4.tcp_fastopen=3</code>), otherwise the connections fall back to a regular handshake.
+ * - Busy-poll: 64-byte request and response with an echo thread over a TCP loopback connection, the client waiting
+ *   for the response as the natives do: busy_poll_wait() then, when the socket is still not ready, a blocking poll()
+ *   in place of the async_select() suspend (a lower bound of its cost, without the async_select task round trip).
+ *   The client runs without then with the BUSY_POLL_MAX_BUDGET_US budget; the busy-poll time is printed in percent
+ *   of the measurement, to be compared with BUSY_POLL_MAX_CPU_PERCENT.
+ * - Unix domain sockets: the same request and response, then 64-kilobyte writes counted by a reader thread, over an
+ *   AF_UNIX stream connection in the abstract namespace and over a TCP loopback connection. The sockets of the
+ *   connection are made blocking for the echo and reader threads.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include "t_llnet.h"
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "../../../../framework/c/utils/inc/u_print.h"
+
+#include "LLNET_CHANNEL_impl.h"
+#include "LLNET_STREAMSOCKETCHANNEL_impl.h"
+#include "LLNET_linux_configuration.h"
+#include "busy_poll.h"
+#include "tcp_fastopen.h"
+#include "unix_socket.h"
+
+
+// --------------------------------------------------------------------------------
+// -                                  Constants                                   -
+// --------------------------------------------------------------------------------
+
+/* Default duration of each measurement */
+#ifndef BENCH_DURATION_MS
+#define BENCH_DURATION_MS       (1000)
+#endif
+
+/* Number of durations kept for the percentiles: the last ones of the measurement */
+#define BENCH_MAX_SAMPLES       (0x10000)
+
+/* Size of a request and of its response */
+#define BENCH_MESSAGE_SIZE      (64)
+
+/* Fast Open queue length of the listening socket */
+#define BENCH_FASTOPEN_QUEUE    (16)
+
+#define BENCH_FASTOPEN_SYSCTL   "/proc/sys/net/ipv4/tcp_fastopen"
+
+/* Size of a write of the throughput measurement */
+#define BENCH_BULK_SIZE         (64 * 1024)
+
+/* Abstract namespace name of the Unix domain listening socket, followed by the process id */
+#define BENCH_UNIX_NAME         "t_llnet_bench"
+
+
+// --------------------------------------------------------------------------------
+// -                                  Variables                                   -
+// --------------------------------------------------------------------------------
+
+/* @brief A connection, request and response benchmark */
+typedef struct {
+	int32_t listen_fd;
+	struct sockaddr_in address;
+	bool fast_open;
+} bench_tfo_context;
+
+/* @brief A request and response benchmark, with an echo thread */
+typedef struct {
+	int32_t client_fd;
+	int32_t server_fd;
+	pthread_t echo_thread;
+} bench_ping_context;
+
+/* @brief A throughput benchmark, with a reader thread */
+typedef struct {
+	int32_t client_fd;
+	int32_t server_fd;
+	pthread_t reader_thread;
+	int64_t received;
+} bench_bulk_context;
+
+typedef bool (*bench_operation)(void* context);
+
+static uint8_t request[BENCH_MESSAGE_SIZE];
+static uint8_t response[BENCH_MESSAGE_SIZE];
+static uint8_t buffer[BENCH_MESSAGE_SIZE];
+static uint8_t bulk_data[BENCH_BULK_SIZE];
+static uint8_t bulk_buffer[BENCH_BULK_SIZE];
+
+static int64_t samples[BENCH_MAX_SAMPLES];
+static int64_t duration_ns;
+
+
+// --------------------------------------------------------------------------------
+// -                                  Measurement                                 -
+// --------------------------------------------------------------------------------
+
+static int64_t get_time_ns(void) {
+	struct timespec ts;
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((int64_t)ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+
+static int compare_samples(const void* a, const void* b) {
+	int64_t first = *(const int64_t*)a;
+	int64_t second = *(const int64_t*)b;
+	return (first > second) - (first < second);
+}
+
+/* @brief Returns the given percentile of the sorted durations, in microseconds */
+static double get_percentile(int32_t count, int32_t percentile) {
+	int32_t index = ((count * percentile) + 99) / 100;
+	if (index > 0) {
+		index--;
+	}
+	return (double)samples[index] / 1e3;
+}
+
+/** @brief Runs an operation repeatedly, then prints its figures. */
+static void bench_run(const char* benchmark, const char* mode, bench_operation operation, void* context)
+{
+	char line[256];
+	int64_t operations = 0;
+
+	/* Warm up: first connection, Fast Open cookie */
+	TEST_ASSERT_MESSAGE(operation(context), "Benchmark operation failed");
+
+	int64_t start = get_time_ns();
+	int64_t end = start;
+	while ((end - start) < duration_ns) {
+		int64_t begin = end;
+		TEST_ASSERT_MESSAGE(operation(context), "Benchmark operation failed");
+		end = get_time_ns();
+		samples[operations % BENCH_MAX_SAMPLES] = end - begin;
+		operations++;
+	}
+
+	int32_t count = (operations < BENCH_MAX_SAMPLES) ? (int32_t)operations : BENCH_MAX_SAMPLES;
+	qsort(samples, count, sizeof(samples[0]), compare_samples);
+	double seconds = (double)(end - start) / 1e9;
+	(void)snprintf(line, sizeof(line), "%-16s %-14s %10lld ops %12.1f op/s  p50 %10.2f us  p99 %10.2f us\n", benchmark,
+	               mode, (long long)operations, (double)operations / seconds, get_percentile(count, 50),
+	               get_percentile(count, 99));
+	UTIL_print_string(line);
+}
+
+/** @brief Reads exactly <code>size</code> bytes. */
+static bool read_full(int32_t fd, uint8_t* data, int32_t size) {
+	int32_t offset = 0;
+	while (offset < size) {
+		ssize_t received = read(fd, data + offset, (size_t)(size - offset));
+		if (received > 0) {
+			offset += (int32_t)received;
+		} else if ((received < 0) && (EINTR == errno)) {
+			// Interrupted, try again
+		} else {
+			break;
+		}
+	}
+	return offset == size;
+}
+
+/** @brief Opens a socket listening on an ephemeral port of 127.0.0.1, returns -1 on error. */
+static int32_t open_listener(struct sockaddr_in* address, int32_t fast_open_queue) {
+	socklen_t length = sizeof(*address);
+	(void)memset(address, 0, sizeof(*address));
+	address->sin_family = AF_INET;
+	address->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	int32_t fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if ((fd >= 0) && (fast_open_queue > 0)) {
+		LLNET_CHANNEL_IMPL_setOption(fd, LLNET_SOCKETOPTION_TCP_FASTOPEN, fast_open_queue);
+	}
+	if ((fd >= 0) && ((0 != bind(fd, (struct sockaddr*)address, sizeof(*address))) || (0 != listen(fd, 128)) ||
+	                  (0 != getsockname(fd, (struct sockaddr*)address, &length)))) {
+		(void)close(fd);
+		fd = -1;
+	}
+	return fd;
+}
+
+/** @brief Opens a TCP loopback connection, returns false on error. */
+static bool open_tcp_connection(int32_t* client_fd, int32_t* server_fd) {
+	struct sockaddr_in address;
+	int32_t listen_fd = open_listener(&address, 0);
+	*client_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	*server_fd = -1;
+	if ((listen_fd >= 0) && (*client_fd >= 0) &&
+	    (0 == connect(*client_fd, (struct sockaddr*)&address, sizeof(address)))) {
+		*server_fd = accept4(listen_fd, NULL, NULL, SOCK_CLOEXEC);
+	}
+	if (listen_fd >= 0) {
+		(void)close(listen_fd);
+	}
+	if (*server_fd >= 0) {
+		// As the natives, the small messages are sent at once
+		int32_t no_delay = 1;
+		(void)setsockopt(*client_fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+		(void)setsockopt(*server_fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+	} else if (*client_fd >= 0) {
+		(void)close(*client_fd);
+	}
+	return *server_fd >= 0;
+}
+
+/** @brief Makes a socket created by the natives blocking, for the threads of the benchmark. */
+static bool set_blocking(int32_t fd) {
+	return 0 == fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+}
+
+/** @brief Opens a Unix domain stream connection in the abstract namespace with the natives, returns false on error. */
+static bool open_unix_connection(int32_t* client_fd, int32_t* server_fd) {
+	char name[sizeof(((struct sockaddr_un*)0)->sun_path)];
+	// The first byte of the path is NUL: abstract namespace
+	int32_t length = snprintf(name, sizeof(name), "@%s_%d", BENCH_UNIX_NAME, (int)getpid());
+	name[0] = '\0';
+
+	int32_t listen_fd = LLNET_UNIX_IMPL_socket(1);
+	*client_fd = LLNET_UNIX_IMPL_socket(1);
+	*server_fd = -1;
+	if ((listen_fd > 0) && (*client_fd > 0)) {
+		LLNET_UNIX_IMPL_bind(listen_fd, (int8_t*)name, length);
+		LLNET_CHANNEL_IMPL_listen(listen_fd, 1);
+		// The backlog has room: the connection completes without waiting
+		LLNET_UNIX_IMPL_connect(*client_fd, (int8_t*)name, length, 0);
+		*server_fd = LLNET_STREAMSOCKETCHANNEL_IMPL_accept(listen_fd, 0);
+	}
+	if (listen_fd > 0) {
+		LLNET_CHANNEL_IMPL_close(listen_fd);
+	}
+	if ((*server_fd > 0) && set_blocking(*client_fd) && set_blocking(*server_fd)) {
+		return true;
+	}
+	if (*server_fd > 0) {
+		LLNET_CHANNEL_IMPL_close(*server_fd);
+	}
+	if (*client_fd > 0) {
+		LLNET_CHANNEL_IMPL_close(*client_fd);
+	}
+	return false;
+}
+
+/* Sends back each message, until the connection is closed by the client */
+static void* echo_thread_run(void* arg) {
+	bench_ping_context* ping = (bench_ping_context*)arg;
+	uint8_t message[BENCH_MESSAGE_SIZE];
+	while (read_full(ping->server_fd, message, BENCH_MESSAGE_SIZE) &&
+	       (BENCH_MESSAGE_SIZE == write(ping->server_fd, message, BENCH_MESSAGE_SIZE))) {
+		// Next message
+	}
+	return NULL;
+}
+
+/** @brief Starts the echo thread of a connection, the client socket is made non-blocking as in the natives. */
+static bool start_echo(bench_ping_context* ping) {
+	return (0 == fcntl(ping->client_fd, F_SETFL, fcntl(ping->client_fd, F_GETFL) | O_NONBLOCK)) &&
+	       (0 == pthread_create(&ping->echo_thread, NULL, echo_thread_run, ping));
+}
+
+/** @brief Closes the connection and waits for the end of the echo thread. */
+static void stop_echo(bench_ping_context* ping) {
+	(void)shutdown(ping->client_fd, SHUT_RDWR);
+	(void)pthread_join(ping->echo_thread, NULL);
+	LLNET_CHANNEL_IMPL_close(ping->client_fd);
+	LLNET_CHANNEL_IMPL_close(ping->server_fd);
+}
+
+/* Reads and counts the data, until the connection is closed by the client */
+static void* reader_thread_run(void* arg) {
+	bench_bulk_context* bulk = (bench_bulk_context*)arg;
+	ssize_t received;
+	do {
+		received = read(bulk->server_fd, bulk_buffer, sizeof(bulk_buffer));
+		if (received > 0) {
+			bulk->received += received;
+		}
+	} while ((received > 0) || ((received < 0) && (EINTR == errno)));
+	return NULL;
+}
+
+/** @brief Function call before running test. */
+static void T_LLNET_BENCH_setUp(void)
+{
+	UTIL_print_string("\nT_LLNET_BENCH_setUp\n");
+	(void)memset(request, 0x51, sizeof(request));
+	(void)memset(response, 0x52, sizeof(response));
+
+	const char* duration = getenv("LLNET_BENCH_DURATION_MS");
+	duration_ns = (int64_t)((NULL != duration) ? atoi(duration) : BENCH_DURATION_MS) * 1000000;
+}
+
+/** @brief Function call after running test. */
+static void T_LLNET_BENCH_tearDown(void)
+{
+	UTIL_print_string("T_LLNET_BENCH_tearDown\n");
+}
+
+
+// --------------------------------------------------------------------------------
+// -                                  Operations                                  -
+// --------------------------------------------------------------------------------
+
+/* Connection, request, response and close. The server side is handled on the same task: the kernel completes the
+ * handshake. The client resets the connection on close, so that the ephemeral ports are not kept in TIME_WAIT */
+static bool tfo_operation(void* context) {
+	bench_tfo_context* tfo = (bench_tfo_context*)context;
+	bool done = false;
+	int32_t fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (fd >= 0) {
+		if (tfo->fast_open) {
+			LLNET_CHANNEL_IMPL_setOption(fd, LLNET_SOCKETOPTION_TCP_FASTOPEN_CONNECT, 1);
+		}
+		tcp_fastopen_on_connect(fd);
+		// With Fast Open, connect() returns at once and the request is sent in the SYN
+		if ((0 == connect(fd, (struct sockaddr*)&tfo->address, sizeof(tfo->address))) &&
+		    (BENCH_MESSAGE_SIZE == write(fd, request, BENCH_MESSAGE_SIZE))) {
+			int32_t connection = accept4(tfo->listen_fd, NULL, NULL, SOCK_CLOEXEC);
+			if (connection >= 0) {
+				tcp_fastopen_on_accept(connection);
+				done = read_full(connection, buffer, BENCH_MESSAGE_SIZE) &&
+				       (BENCH_MESSAGE_SIZE == write(connection, response, BENCH_MESSAGE_SIZE)) &&
+				       read_full(fd, buffer, BENCH_MESSAGE_SIZE);
+				(void)close(connection);
+			}
+		}
+		struct linger reset = { 1, 0 };
+		(void)setsockopt(fd, SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+		tcp_fastopen_on_close(fd);
+		(void)close(fd);
+	}
+	return done;
+}
+
+
+/* Request and response. The client waits for the response as the natives: busy-poll, then suspend */
+static bool ping_operation(void* context) {
+	bench_ping_context* ping = (bench_ping_context*)context;
+	int32_t offset = 0;
+	if (BENCH_MESSAGE_SIZE == write(ping->client_fd, request, BENCH_MESSAGE_SIZE)) {
+		while (offset < BENCH_MESSAGE_SIZE) {
+			ssize_t received = read(ping->client_fd, buffer + offset, (size_t)(BENCH_MESSAGE_SIZE - offset));
+			if (received > 0) {
+				offset += (int32_t)received;
+			} else if ((received < 0) && ((EAGAIN == errno) || (EWOULDBLOCK == errno))) {
+				if (!busy_poll_wait(ping->client_fd, SELECT_READ)) {
+					// As async_select(): suspended until the socket is readable
+					struct pollfd pfd = { ping->client_fd, POLLIN, 0 };
+					(void)poll(&pfd, 1, -1);
+				}
+			} else if ((received < 0) && (EINTR == errno)) {
+				// Interrupted, try again
+			} else {
+				break;
+			}
+		}
+	}
+	return BENCH_MESSAGE_SIZE == offset;
+}
+
+
+/* One write of BENCH_BULK_SIZE bytes, the client socket is blocking */
+static bool bulk_operation(void* context) {
+	bench_bulk_context* bulk = (bench_bulk_context*)context;
+	int32_t offset = 0;
+	while (offset < BENCH_BULK_SIZE) {
+		ssize_t sent = write(bulk->client_fd, bulk_data + offset, (size_t)(BENCH_BULK_SIZE - offset));
+		if (sent > 0) {
+			offset += (int32_t)sent;
+		} else if ((sent < 0) && (EINTR == errno)) {
+			// Interrupted, try again
+		} else {
+			break;
+		}
+	}
+	return BENCH_BULK_SIZE == offset;
+}
+
+
+// --------------------------------------------------------------------------------
+// -                                  Tests                                       -
+// --------------------------------------------------------------------------------
+
+static void T_LLNET_BENCH_tcp_fastopen(void)
+{
+	UTIL_print_string("LLNET TCP Fast Open benchmark\n");
+	char line[160];
+	FILE* sysctl = fopen(BENCH_FASTOPEN_SYSCTL, "r");
+	int sysctl_value = -1;
+	if (NULL != sysctl) {
+		if (1 != fscanf(sysctl, "%d", &sysctl_value)) {
+			sysctl_value = -1;
+		}
+		(void)fclose(sysctl);
+	}
+	(void)snprintf(line, sizeof(line), "net.ipv4.tcp_fastopen=%d%s\n", sysctl_value,
+	               (3 == (sysctl_value & 3)) ? "" : ", the Fast Open connections fall back to a regular handshake");
+	UTIL_print_string(line);
+
+	// The options are handled by the natives: set, read back, then cleared
+	int32_t fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	TEST_ASSERT_MESSAGE(fd >= 0, "Cannot open the socket");
+	LLNET_CHANNEL_IMPL_setOption(fd, LLNET_SOCKETOPTION_TCP_FASTOPEN_CONNECT, 1);
+	int32_t enabled = LLNET_CHANNEL_IMPL_getOption(fd, LLNET_SOCKETOPTION_TCP_FASTOPEN_CONNECT);
+	LLNET_CHANNEL_IMPL_setOption(fd, LLNET_SOCKETOPTION_TCP_FASTOPEN_CONNECT, 0);
+	int32_t disabled = LLNET_CHANNEL_IMPL_getOption(fd, LLNET_SOCKETOPTION_TCP_FASTOPEN_CONNECT);
+	(void)close(fd);
+	TEST_ASSERT_EQUAL_INT(1, enabled);
+	TEST_ASSERT_EQUAL_INT(0, disabled);
+
+	bench_tfo_context regular;
+	regular.listen_fd = open_listener(&regular.address, 0);
+	regular.fast_open = false;
+	TEST_ASSERT_MESSAGE(regular.listen_fd >= 0, "Cannot open the listening socket");
+	bench_run("tcp_fastopen", "regular", tfo_operation, &regular);
+	(void)close(regular.listen_fd);
+
+	bench_tfo_context fast_open;
+	fast_open.listen_fd = open_listener(&fast_open.address, BENCH_FASTOPEN_QUEUE);
+	fast_open.fast_open = true;
+	TEST_ASSERT_MESSAGE(fast_open.listen_fd >= 0, "Cannot open the listening socket");
+	TEST_ASSERT_EQUAL_INT(BENCH_FASTOPEN_QUEUE,
+	                      LLNET_CHANNEL_IMPL_getOption(fast_open.listen_fd, LLNET_SOCKETOPTION_TCP_FASTOPEN));
+	int64_t connects = LLNET_TCP_FASTOPEN_IMPL_getStatistic(TCP_FASTOPEN_STAT_CLIENT_CONNECTS);
+	int64_t accepts = LLNET_TCP_FASTOPEN_IMPL_getStatistic(TCP_FASTOPEN_STAT_SERVER_ACCEPTS);
+	int64_t acked = LLNET_TCP_FASTOPEN_IMPL_getStatistic(TCP_FASTOPEN_STAT_CLIENT_SYN_DATA_ACKED);
+	int64_t fallbacks = LLNET_TCP_FASTOPEN_IMPL_getStatistic(TCP_FASTOPEN_STAT_CLIENT_FALLBACKS);
+	int64_t accepted = LLNET_TCP_FASTOPEN_IMPL_getStatistic(TCP_FASTOPEN_STAT_SERVER_SYN_DATA_ACCEPTED);
+	bench_run("tcp_fastopen", "fast_open", tfo_operation, &fast_open);
+	(void)close(fast_open.listen_fd);
+	// The options set with the natives enable the Fast Open statistics of the connections
+	TEST_ASSERT_MESSAGE(LLNET_TCP_FASTOPEN_IMPL_getStatistic(TCP_FASTOPEN_STAT_CLIENT_CONNECTS) > connects,
+	                    "Fast Open connections not counted");
+	TEST_ASSERT_MESSAGE(LLNET_TCP_FASTOPEN_IMPL_getStatistic(TCP_FASTOPEN_STAT_SERVER_ACCEPTS) > accepts,
+	                    "Fast Open accepted connections not counted");
+
+	(void)snprintf(line, sizeof(line), "Fast Open: %lld SYN data acknowledged, %lld fallbacks, %lld SYN data accepted\n",
+	               (long long)(LLNET_TCP_FASTOPEN_IMPL_getStatistic(TCP_FASTOPEN_STAT_CLIENT_SYN_DATA_ACKED) - acked),
+	               (long long)(LLNET_TCP_FASTOPEN_IMPL_getStatistic(TCP_FASTOPEN_STAT_CLIENT_FALLBACKS) - fallbacks),
+	               (long long)(LLNET_TCP_FASTOPEN_IMPL_getStatistic(TCP_FASTOPEN_STAT_SERVER_SYN_DATA_ACCEPTED) - accepted));
+	UTIL_print_string(line);
+}
+
+static void T_LLNET_BENCH_busy_poll(void)
+{
+	UTIL_print_string("LLNET busy-poll benchmark\n");
+	static const int32_t budgets[] = { 0, BUSY_POLL_MAX_BUDGET_US };
+	static const char* modes[] = { "suspend", "busy_poll" };
+	char line[200];
+
+	for (int32_t i = 0; i < (int32_t)(sizeof(budgets) / sizeof(budgets[0])); i++) {
+		bench_ping_context ping;
+		TEST_ASSERT_MESSAGE(open_tcp_connection(&ping.client_fd, &ping.server_fd), "Cannot open the connection");
+		TEST_ASSERT_MESSAGE(0 == busy_poll_set_budget(ping.client_fd, budgets[i]), "busy_poll_set_budget() failed");
+		TEST_ASSERT_MESSAGE(start_echo(&ping), "Cannot start the echo thread");
+
+		int64_t before[BUSY_POLL_STATS_COUNT];
+		for (int32_t id = 0; id < BUSY_POLL_STATS_COUNT; id++) {
+			before[id] = LLNET_BUSY_POLL_IMPL_getStatistic(id);
+		}
+		int64_t start = get_time_ns();
+		bench_run("busy_poll", modes[i], ping_operation, &ping);
+		int64_t elapsed_us = (get_time_ns() - start) / 1000;
+		stop_echo(&ping);
+
+		int64_t time_us = LLNET_BUSY_POLL_IMPL_getStatistic(BUSY_POLL_STAT_TIME_US) - before[BUSY_POLL_STAT_TIME_US];
+		(void)snprintf(line, sizeof(line),
+		               "%s: busy-poll %.1f%% of the time (cap %d%%), %lld polls, %lld hits, %lld misses, %lld capped, "
+		               "%lld backed off\n", modes[i], (100.0 * (double)time_us) / (double)elapsed_us,
+		               BUSY_POLL_MAX_CPU_PERCENT,
+		               (long long)(LLNET_BUSY_POLL_IMPL_getStatistic(BUSY_POLL_STAT_POLLS) - before[BUSY_POLL_STAT_POLLS]),
+		               (long long)(LLNET_BUSY_POLL_IMPL_getStatistic(BUSY_POLL_STAT_HITS) - before[BUSY_POLL_STAT_HITS]),
+		               (long long)(LLNET_BUSY_POLL_IMPL_getStatistic(BUSY_POLL_STAT_MISSES) - before[BUSY_POLL_STAT_MISSES]),
+		               (long long)(LLNET_BUSY_POLL_IMPL_getStatistic(BUSY_POLL_STAT_CAPPED) - before[BUSY_POLL_STAT_CAPPED]),
+		               (long long)(LLNET_BUSY_POLL_IMPL_getStatistic(BUSY_POLL_STAT_BACKED_OFF) -
+		                           before[BUSY_POLL_STAT_BACKED_OFF]));
+		UTIL_print_string(line);
+	}
+}
+
+static void T_LLNET_BENCH_unix_socket(void)
+{
+	UTIL_print_string("LLNET Unix domain socket benchmark\n");
+	typedef bool (*bench_connection)(int32_t* client_fd, int32_t* server_fd);
+	static const bench_connection connections[] = { open_tcp_connection, open_unix_connection };
+	static const char* modes[] = { "tcp_loopback", "unix" };
+	char line[160];
+
+	for (int32_t i = 0; i < (int32_t)(sizeof(connections) / sizeof(connections[0])); i++) {
+		bench_ping_context ping;
+		TEST_ASSERT_MESSAGE(connections[i](&ping.client_fd, &ping.server_fd), "Cannot open the connection");
+		TEST_ASSERT_MESSAGE(start_echo(&ping), "Cannot start the echo thread");
+		bench_run("unix_latency", modes[i], ping_operation, &ping);
+		stop_echo(&ping);
+	}
+
+	for (int32_t i = 0; i < (int32_t)(sizeof(connections) / sizeof(connections[0])); i++) {
+		bench_bulk_context bulk;
+		bulk.received = 0;
+		TEST_ASSERT_MESSAGE(connections[i](&bulk.client_fd, &bulk.server_fd), "Cannot open the connection");
+		TEST_ASSERT_MESSAGE(0 == pthread_create(&bulk.reader_thread, NULL, reader_thread_run, &bulk),
+		                    "Cannot start the reader thread");
+		int64_t start = get_time_ns();
+		bench_run("unix_bulk", modes[i], bulk_operation, &bulk);
+		(void)shutdown(bulk.client_fd, SHUT_WR);
+		(void)pthread_join(bulk.reader_thread, NULL);
+		double seconds = (double)(get_time_ns() - start) / 1e9;
+		LLNET_CHANNEL_IMPL_close(bulk.client_fd);
+		LLNET_CHANNEL_IMPL_close(bulk.server_fd);
+
+		(void)snprintf(line, sizeof(line), "%s: %.1f MiB/s received\n", modes[i],
+		               (double)bulk.received / (1024.0 * 1024.0) / seconds);
+		UTIL_print_string(line);
+	}
+}
+
+TestRef T_LLNET_BENCH_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixture_llnet_bench) {
+		new_TestFixture("T_LLNET_BENCH_tcp_fastopen", T_LLNET_BENCH_tcp_fastopen),
+		new_TestFixture("T_LLNET_BENCH_busy_poll", T_LLNET_BENCH_busy_poll),
+		new_TestFixture("T_LLNET_BENCH_unix_socket", T_LLNET_BENCH_unix_socket),
+	};
+	EMB_UNIT_TESTCALLER(llnet_bench_tests, "LLNET benchmark", T_LLNET_BENCH_setUp, T_LLNET_BENCH_tearDown,
+	                    fixture_llnet_bench);
+
+	return (TestRef)&llnet_bench_tests;
+}
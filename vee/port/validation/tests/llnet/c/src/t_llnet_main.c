@@ -0,0 +1,27 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include "t_llnet.h"
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "../../../../framework/c/utils/inc/u_print.h"
+
+#include "LLNET_CHANNEL_impl.h"
+
+#define LLNET_VERSION "v1.0.0"
+
+void T_LLNET_main(void) {
+    UTIL_print_string("\nT_LLNET " LLNET_VERSION "\n");
+	// As the VM at startup, before the natives: the socket table and the async_select task
+	LLNET_CHANNEL_IMPL_initialize();
+	TestRunner_start();
+	TestRunner_runTest(T_LLNET_tests());
+	TestRunner_runTest(T_LLNET_BENCH_tests());
+	TestRunner_end();
+	return;
+}
@@ -0,0 +1,32 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#ifndef T_LLSEC_H
+#define T_LLSEC_H
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @brief this function is the entry point for the LLSEC Test Suite.
+ */
+void T_LLSEC_main(void);
+
+TestRef	T_LLSEC_tests(void);
+
+/**
+ * @brief Throughput and latency benchmark of the LLSEC natives, written to a CSV file (see t_llsec_bench.c).
+ */
+TestRef	T_LLSEC_BENCH_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
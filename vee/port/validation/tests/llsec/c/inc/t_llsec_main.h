@@ -0,0 +1,28 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/* Prevent recursive inclusion */
+
+#ifndef __T_LLSEC_MAIN_H
+#define __T_LLSEC_MAIN_H
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/* public function declaration */
+
+/**
+ * @brief this function is the entry point for the LLSEC Test Suite.
+ */
+void T_LLSEC_main(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,401 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <openssl/opensslv.h>
+
+#include "t_llsec.h"
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "../../../../framework/c/utils/inc/u_print.h"
+
+#include "LLSEC_AFALG_openssl.h"
+#include "LLSEC_CIPHER_impl.h"
+#include "LLSEC_CIPHER_openssl.h"
+#include "LLSEC_DIGEST_impl.h"
+#include "LLSEC_DIGEST_openssl.h"
+#include "LLSEC_MAC_impl.h"
+#include "LLSEC_MAC_openssl.h"
+
+
+// --------------------------------------------------------------------------------
+// -                                  Constants                                   -
+// --------------------------------------------------------------------------------
+
+#define AES_KEY_SIZE        16
+#define CHACHA_KEY_SIZE     32
+#define NONCE_SIZE          12
+#define CBC_IV_SIZE         16
+#define TAG_SIZE            16
+#define HMAC_SHA256_SIZE    32
+#define AAD_SIZE            13
+#define SHA256_SIZE         32
+
+/* Number of small messages hashed in one native call */
+#define SMALL_MESSAGES      8
+
+/* Largest message of the tests */
+#define MESSAGE_BUFFER_SIZE 0x4000 /* 16 KiB */
+
+/* Number of bytes processed by each throughput measurement */
+#define THROUGHPUT_BYTES    (8 * 1024 * 1024)
+
+static uint8_t key[CHACHA_KEY_SIZE];
+static uint8_t mac_key[HMAC_SHA256_SIZE];
+static uint8_t nonce[CBC_IV_SIZE];
+static uint8_t aad[AAD_SIZE];
+static uint8_t tag[TAG_SIZE];
+static uint8_t mac[HMAC_SHA256_SIZE];
+
+/* @brief Buffers of the plain, encrypted and decrypted messages */
+static uint8_t plainBuffer[MESSAGE_BUFFER_SIZE];
+static uint8_t cipherBuffer[MESSAGE_BUFFER_SIZE];
+static uint8_t decryptedBuffer[MESSAGE_BUFFER_SIZE];
+static uint8_t afalgBuffer[MESSAGE_BUFFER_SIZE];
+
+/* @brief Outputs of the one-shot natives and of the init/update/final natives */
+static uint8_t oneShotBuffer[SMALL_MESSAGES * SHA256_SIZE];
+static uint8_t streamBuffer[SMALL_MESSAGES * SHA256_SIZE];
+
+/* Lengths of the small messages stored back to back in plainBuffer, including an empty one */
+static int32_t smallLengths[SMALL_MESSAGES] = { 0, 1, 16, 31, 55, 56, 64, 200 };
+
+static int64_t get_time_ns(void) {
+	struct timespec ts;
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((int64_t)ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+
+static void print_throughput(const char* name, int32_t message_size, int64_t bytes, int64_t duration_ns) {
+	char line[128];
+	double mb_per_s = ((double)bytes / (1024.0 * 1024.0)) / ((double)duration_ns / 1e9);
+	(void)snprintf(line, sizeof(line), "%-28s %6d B  %10.1f MB/s\n", name, (int)message_size, mb_per_s);
+	UTIL_print_string(line);
+}
+
+static int32_t get_transformation(const char* name) {
+	LLSEC_CIPHER_transformation_desc description;
+	return LLSEC_CIPHER_IMPL_get_transformation_description((uint8_t*)name, &description);
+}
+
+/** @brief Function call before running test. */
+static void T_LLSEC_setUp(void)
+{
+	UTIL_print_string("\nT_LLSEC_setUp\n");
+	for (int32_t i = 0; i < MESSAGE_BUFFER_SIZE; i++) {
+		plainBuffer[i] = (uint8_t)i;
+	}
+	memset(key, 0x4b, sizeof(key));
+	memset(mac_key, 0x6d, sizeof(mac_key));
+	memset(nonce, 0x4e, sizeof(nonce));
+	memset(aad, 0x41, sizeof(aad));
+	memset(cipherBuffer, 0, MESSAGE_BUFFER_SIZE);
+	memset(decryptedBuffer, 0, MESSAGE_BUFFER_SIZE);
+}
+
+/** @brief Function call after running test. */
+static void T_LLSEC_tearDown(void)
+{
+	UTIL_print_string("T_LLSEC_tearDown\n");
+}
+
+/** @brief Encrypts a message with an AEAD transformation, then decrypts it and verifies its tag.
+ *  		The decryption of a tampered message must fail.
+ */
+static void check_aead_round_trip(const char* name, int32_t key_size)
+{
+	int32_t transformation = get_transformation(name);
+	TEST_ASSERT_MESSAGE(SNI_ERROR != transformation, "Unknown cipher transformation");
+	int32_t length = 1000; /* not a multiple of the block size */
+
+	int32_t encryptor = LLSEC_CIPHER_IMPL_init(transformation, 0, key, key_size, nonce, NONCE_SIZE);
+	TEST_ASSERT_MESSAGE(SNI_ERROR != encryptor, "LLSEC_CIPHER_IMPL_init() returned an error");
+	TEST_ASSERT_EQUAL_INT(SNI_OK, LLSEC_CIPHER_IMPL_update_aad(transformation, encryptor, aad, 0, AAD_SIZE));
+	/* Two chunks, as a Java update() then doFinal() */
+	TEST_ASSERT_EQUAL_INT(100, LLSEC_CIPHER_IMPL_encrypt(transformation, encryptor, plainBuffer, 0, 100, cipherBuffer, 0));
+	TEST_ASSERT_EQUAL_INT(length - 100, LLSEC_CIPHER_IMPL_encrypt(transformation, encryptor, plainBuffer, 100, length - 100, cipherBuffer, 100));
+	TEST_ASSERT_EQUAL_INT(TAG_SIZE, LLSEC_CIPHER_IMPL_get_tag(transformation, encryptor, tag, 0, TAG_SIZE));
+	LLSEC_CIPHER_IMPL_close(transformation, encryptor);
+
+	int32_t decryptor = LLSEC_CIPHER_IMPL_init(transformation, 1, key, key_size, nonce, NONCE_SIZE);
+	TEST_ASSERT_MESSAGE(SNI_ERROR != decryptor, "LLSEC_CIPHER_IMPL_init() returned an error");
+	TEST_ASSERT_EQUAL_INT(SNI_OK, LLSEC_CIPHER_IMPL_update_aad(transformation, decryptor, aad, 0, AAD_SIZE));
+	TEST_ASSERT_EQUAL_INT(length, LLSEC_CIPHER_IMPL_decrypt(transformation, decryptor, cipherBuffer, 0, length, decryptedBuffer, 0));
+	TEST_ASSERT_EQUAL_INT(1, LLSEC_CIPHER_IMPL_verify_tag(transformation, decryptor, tag, 0, TAG_SIZE));
+	if(0 != memcmp(plainBuffer, decryptedBuffer, length)){
+		TEST_ASSERT_MESSAGE(false, "Decrypted message differs from the plain message");
+	}
+
+	/* Same message with a new nonce on the same context, with a flipped bit */
+	LLSEC_CIPHER_IMPL_set_IV(transformation, decryptor, nonce, NONCE_SIZE);
+	TEST_ASSERT_EQUAL_INT(SNI_OK, LLSEC_CIPHER_IMPL_update_aad(transformation, decryptor, aad, 0, AAD_SIZE));
+	cipherBuffer[10] ^= 0x01;
+	TEST_ASSERT_EQUAL_INT(length, LLSEC_CIPHER_IMPL_decrypt(transformation, decryptor, cipherBuffer, 0, length, decryptedBuffer, 0));
+	TEST_ASSERT_EQUAL_INT(0, LLSEC_CIPHER_IMPL_verify_tag(transformation, decryptor, tag, 0, TAG_SIZE));
+	LLSEC_CIPHER_IMPL_close(transformation, decryptor);
+}
+
+static void T_LLSEC_CHECK_aes_gcm_round_trip(void)
+{
+	UTIL_print_string("LLSEC AES/GCM round trip\n");
+	check_aead_round_trip("AES/GCM/NoPadding", AES_KEY_SIZE);
+}
+
+// ChaCha20-Poly1305 is not available before OpenSSL 1.1.0
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+static void T_LLSEC_CHECK_chacha20_poly1305_round_trip(void)
+{
+	UTIL_print_string("LLSEC ChaCha20-Poly1305 round trip\n");
+	check_aead_round_trip("ChaCha20-Poly1305", CHACHA_KEY_SIZE);
+}
+#endif
+
+/** @brief Hashes small messages with one call of the multi-buffer native, and compares with the init/update/digest natives. */
+static void T_LLSEC_CHECK_digest_many(void)
+{
+	UTIL_print_string("LLSEC digest many\n");
+	LLSEC_DIGEST_algorithm_desc description;
+	int32_t algorithm = LLSEC_DIGEST_IMPL_get_algorithm_description((uint8_t*)"SHA-256", &description);
+	TEST_ASSERT_MESSAGE(SNI_ERROR != algorithm, "Unknown digest algorithm");
+	TEST_ASSERT_EQUAL_INT(SHA256_SIZE, description.digest_length);
+
+	int32_t result = LLSEC_DIGEST_IMPL_digest_many(algorithm, plainBuffer, 0, MESSAGE_BUFFER_SIZE, smallLengths, SMALL_MESSAGES,
+	                                               oneShotBuffer, 0, sizeof(oneShotBuffer));
+	TEST_ASSERT_EQUAL_INT(SMALL_MESSAGES * SHA256_SIZE, result);
+
+	int32_t offset = 0;
+	for (int32_t i = 0; i < SMALL_MESSAGES; i++) {
+		int32_t digest = LLSEC_DIGEST_IMPL_init(algorithm);
+		TEST_ASSERT_MESSAGE(SNI_ERROR != digest, "LLSEC_DIGEST_IMPL_init() returned an error");
+		LLSEC_DIGEST_IMPL_update(algorithm, digest, plainBuffer, offset, smallLengths[i]);
+		LLSEC_DIGEST_IMPL_digest(algorithm, digest, streamBuffer, i * SHA256_SIZE, SHA256_SIZE);
+		LLSEC_DIGEST_IMPL_close(algorithm, digest);
+		offset += smallLengths[i];
+	}
+	if(0 != memcmp(oneShotBuffer, streamBuffer, sizeof(oneShotBuffer))){
+		TEST_ASSERT_MESSAGE(false, "One-shot digests differ from the init/update/digest ones");
+	}
+
+	/* Single message */
+	memset(oneShotBuffer, 0, sizeof(oneShotBuffer));
+	result = LLSEC_DIGEST_IMPL_digest_once(algorithm, plainBuffer, 1, 16, oneShotBuffer, 0, SHA256_SIZE);
+	TEST_ASSERT_EQUAL_INT(SHA256_SIZE, result);
+	if(0 != memcmp(oneShotBuffer, &streamBuffer[2 * SHA256_SIZE], SHA256_SIZE)){
+		TEST_ASSERT_MESSAGE(false, "One-shot digest differs from the init/update/digest one");
+	}
+
+	/* Messages larger than the buffer */
+	result = LLSEC_DIGEST_IMPL_digest_many(algorithm, plainBuffer, 0, 100, smallLengths, SMALL_MESSAGES,
+	                                       oneShotBuffer, 0, sizeof(oneShotBuffer));
+	TEST_ASSERT_EQUAL_INT(SNI_ERROR, result);
+}
+
+/** @brief Authenticates small messages with one call of the multi-buffer native, and compares with the init/update/do_final
+ *  		natives on a single context reset after each message.
+ */
+static void T_LLSEC_CHECK_mac_many(void)
+{
+	UTIL_print_string("LLSEC MAC many\n");
+	LLSEC_MAC_algorithm_desc description;
+	int32_t algorithm = LLSEC_MAC_IMPL_get_algorithm_description((uint8_t*)"HmacSHA256", &description);
+	TEST_ASSERT_MESSAGE(SNI_ERROR != algorithm, "Unknown MAC algorithm");
+
+	int32_t result = LLSEC_MAC_IMPL_mac_many(algorithm, mac_key, sizeof(mac_key), plainBuffer, 0, MESSAGE_BUFFER_SIZE,
+	                                         smallLengths, SMALL_MESSAGES, oneShotBuffer, 0, sizeof(oneShotBuffer));
+	TEST_ASSERT_EQUAL_INT(SMALL_MESSAGES * HMAC_SHA256_SIZE, result);
+
+	int32_t hmac = LLSEC_MAC_IMPL_init(algorithm, mac_key, sizeof(mac_key));
+	TEST_ASSERT_MESSAGE(SNI_ERROR != hmac, "LLSEC_MAC_IMPL_init() returned an error");
+	int32_t offset = 0;
+	for (int32_t i = 0; i < SMALL_MESSAGES; i++) {
+		LLSEC_MAC_IMPL_update(algorithm, hmac, plainBuffer, offset, smallLengths[i]);
+		LLSEC_MAC_IMPL_do_final(algorithm, hmac, streamBuffer, i * HMAC_SHA256_SIZE, HMAC_SHA256_SIZE);
+		LLSEC_MAC_IMPL_reset(algorithm, hmac);
+		offset += smallLengths[i];
+	}
+	LLSEC_MAC_IMPL_close(algorithm, hmac);
+	if(0 != memcmp(oneShotBuffer, streamBuffer, sizeof(oneShotBuffer))){
+		TEST_ASSERT_MESSAGE(false, "One-shot MACs differ from the init/update/do_final ones");
+	}
+
+	memset(oneShotBuffer, 0, sizeof(oneShotBuffer));
+	result = LLSEC_MAC_IMPL_mac_once(algorithm, mac_key, sizeof(mac_key), plainBuffer, 1, 16, oneShotBuffer, 0, HMAC_SHA256_SIZE);
+	TEST_ASSERT_EQUAL_INT(HMAC_SHA256_SIZE, result);
+	if(0 != memcmp(oneShotBuffer, &streamBuffer[2 * HMAC_SHA256_SIZE], HMAC_SHA256_SIZE)){
+		TEST_ASSERT_MESSAGE(false, "One-shot MAC differs from the init/update/do_final one");
+	}
+
+	/* Output buffer too small */
+	result = LLSEC_MAC_IMPL_mac_once(algorithm, mac_key, sizeof(mac_key), plainBuffer, 0, 16, oneShotBuffer, 0, HMAC_SHA256_SIZE - 1);
+	TEST_ASSERT_EQUAL_INT(SNI_ERROR, result);
+}
+
+/** @brief Hashes, authenticates and encrypts plainBuffer with the given backend selection, in several updates. */
+static void run_selection(const char* selection, uint8_t* digest, uint8_t* hmac, uint8_t* encrypted, uint8_t* iv)
+{
+	int32_t split = 1024;
+	LLSEC_AFALG_select(selection);
+
+	LLSEC_DIGEST_algorithm_desc digest_description;
+	int32_t digest_algorithm = LLSEC_DIGEST_IMPL_get_algorithm_description((uint8_t*)"SHA-256", &digest_description);
+	TEST_ASSERT_MESSAGE(SNI_ERROR != digest_algorithm, "Unknown digest algorithm");
+	int32_t sha = LLSEC_DIGEST_IMPL_init(digest_algorithm);
+	TEST_ASSERT_MESSAGE(SNI_ERROR != sha, "LLSEC_DIGEST_IMPL_init() returned an error");
+	LLSEC_DIGEST_IMPL_update(digest_algorithm, sha, plainBuffer, 0, split);
+	LLSEC_DIGEST_IMPL_update(digest_algorithm, sha, plainBuffer, split, MESSAGE_BUFFER_SIZE - split);
+	LLSEC_DIGEST_IMPL_digest(digest_algorithm, sha, digest, 0, SHA256_SIZE);
+	LLSEC_DIGEST_IMPL_close(digest_algorithm, sha);
+
+	LLSEC_MAC_algorithm_desc mac_description;
+	int32_t mac_algorithm = LLSEC_MAC_IMPL_get_algorithm_description((uint8_t*)"HmacSHA256", &mac_description);
+	TEST_ASSERT_MESSAGE(SNI_ERROR != mac_algorithm, "Unknown MAC algorithm");
+	int32_t mac_id = LLSEC_MAC_IMPL_init(mac_algorithm, mac_key, sizeof(mac_key));
+	TEST_ASSERT_MESSAGE(SNI_ERROR != mac_id, "LLSEC_MAC_IMPL_init() returned an error");
+	LLSEC_MAC_IMPL_update(mac_algorithm, mac_id, plainBuffer, 0, MESSAGE_BUFFER_SIZE);
+	LLSEC_MAC_IMPL_do_final(mac_algorithm, mac_id, hmac, 0, HMAC_SHA256_SIZE);
+	LLSEC_MAC_IMPL_close(mac_algorithm, mac_id);
+
+	int32_t transformation = get_transformation("AES/CBC/NoPadding");
+	TEST_ASSERT_MESSAGE(SNI_ERROR != transformation, "Unknown cipher transformation");
+	int32_t encryptor = LLSEC_CIPHER_IMPL_init(transformation, 0, key, AES_KEY_SIZE, nonce, CBC_IV_SIZE);
+	TEST_ASSERT_MESSAGE(SNI_ERROR != encryptor, "LLSEC_CIPHER_IMPL_init() returned an error");
+	TEST_ASSERT_EQUAL_INT(split, LLSEC_CIPHER_IMPL_encrypt(transformation, encryptor, plainBuffer, 0, split, encrypted, 0));
+	TEST_ASSERT_EQUAL_INT(MESSAGE_BUFFER_SIZE - split, LLSEC_CIPHER_IMPL_encrypt(transformation, encryptor, plainBuffer, split,
+	                                                                             MESSAGE_BUFFER_SIZE - split, encrypted, split));
+	TEST_ASSERT_EQUAL_INT(CBC_IV_SIZE, LLSEC_CIPHER_IMPL_get_IV_length(transformation, encryptor));
+	LLSEC_CIPHER_IMPL_get_IV(transformation, encryptor, iv, CBC_IV_SIZE);
+	LLSEC_CIPHER_IMPL_close(transformation, encryptor);
+
+	/* Decryption in place */
+	(void)memcpy(decryptedBuffer, encrypted, MESSAGE_BUFFER_SIZE);
+	int32_t decryptor = LLSEC_CIPHER_IMPL_init(transformation, 1, key, AES_KEY_SIZE, nonce, CBC_IV_SIZE);
+	TEST_ASSERT_MESSAGE(SNI_ERROR != decryptor, "LLSEC_CIPHER_IMPL_init() returned an error");
+	TEST_ASSERT_EQUAL_INT(MESSAGE_BUFFER_SIZE, LLSEC_CIPHER_IMPL_decrypt(transformation, decryptor, decryptedBuffer, 0,
+	                                                                     MESSAGE_BUFFER_SIZE, decryptedBuffer, 0));
+	LLSEC_CIPHER_IMPL_close(transformation, decryptor);
+	if(0 != memcmp(plainBuffer, decryptedBuffer, MESSAGE_BUFFER_SIZE)){
+		TEST_ASSERT_MESSAGE(false, "Decrypted message differs from the plain one");
+	}
+}
+
+/** @brief Runs SHA-256, HmacSHA256 and AES/CBC on the kernel crypto API, and compares with OpenSSL.
+ *  		Without kernel support, the algorithms run on OpenSSL again.
+ */
+static void T_LLSEC_CHECK_afalg(void)
+{
+	uint8_t openssl_digest[SHA256_SIZE];
+	uint8_t openssl_mac[HMAC_SHA256_SIZE];
+	uint8_t openssl_iv[CBC_IV_SIZE];
+	uint8_t afalg_digest[SHA256_SIZE];
+	uint8_t afalg_mac[HMAC_SHA256_SIZE];
+	uint8_t afalg_iv[CBC_IV_SIZE];
+
+	UTIL_print_string("LLSEC kernel crypto API\n");
+	run_selection("", openssl_digest, openssl_mac, cipherBuffer, openssl_iv);
+	run_selection("*", afalg_digest, afalg_mac, afalgBuffer, afalg_iv);
+	UTIL_print_string(LLSEC_AFALG_is_enabled("SHA-256") ? "SHA-256 on the kernel\n" : "SHA-256 on OpenSSL\n");
+	UTIL_print_string(LLSEC_AFALG_is_enabled("HmacSHA256") ? "HmacSHA256 on the kernel\n" : "HmacSHA256 on OpenSSL\n");
+	UTIL_print_string(LLSEC_AFALG_is_enabled("AES/CBC/NoPadding") ? "AES/CBC on the kernel\n" : "AES/CBC on OpenSSL\n");
+	LLSEC_AFALG_select(NULL);
+
+	if(0 != memcmp(openssl_digest, afalg_digest, SHA256_SIZE)){
+		TEST_ASSERT_MESSAGE(false, "Kernel digest differs from the OpenSSL one");
+	}
+	if(0 != memcmp(openssl_mac, afalg_mac, HMAC_SHA256_SIZE)){
+		TEST_ASSERT_MESSAGE(false, "Kernel MAC differs from the OpenSSL one");
+	}
+	if(0 != memcmp(cipherBuffer, afalgBuffer, MESSAGE_BUFFER_SIZE)){
+		TEST_ASSERT_MESSAGE(false, "Kernel encryption differs from the OpenSSL one");
+	}
+	if(0 != memcmp(openssl_iv, afalg_iv, CBC_IV_SIZE)){
+		TEST_ASSERT_MESSAGE(false, "Kernel IV differs from the OpenSSL one");
+	}
+}
+
+/** @brief Measures the throughput of an AEAD transformation: one pass per message. */
+static void bench_aead(const char* name, int32_t key_size, int32_t message_size)
+{
+	int32_t transformation = get_transformation(name);
+	TEST_ASSERT_MESSAGE(SNI_ERROR != transformation, "Unknown cipher transformation");
+	int32_t encryptor = LLSEC_CIPHER_IMPL_init(transformation, 0, key, key_size, nonce, NONCE_SIZE);
+	TEST_ASSERT_MESSAGE(SNI_ERROR != encryptor, "LLSEC_CIPHER_IMPL_init() returned an error");
+
+	int32_t messages = THROUGHPUT_BYTES / message_size;
+	int64_t start = get_time_ns();
+	for (int32_t i = 0; i < messages; i++) {
+		/* A nonce must never be reused with the same key, except for a measurement like this one */
+		LLSEC_CIPHER_IMPL_set_IV(transformation, encryptor, nonce, NONCE_SIZE);
+		(void)LLSEC_CIPHER_IMPL_update_aad(transformation, encryptor, aad, 0, AAD_SIZE);
+		(void)LLSEC_CIPHER_IMPL_encrypt(transformation, encryptor, plainBuffer, 0, message_size, cipherBuffer, 0);
+		TEST_ASSERT_EQUAL_INT(TAG_SIZE, LLSEC_CIPHER_IMPL_get_tag(transformation, encryptor, tag, 0, TAG_SIZE));
+	}
+	print_throughput(name, message_size, (int64_t)messages * message_size, get_time_ns() - start);
+	LLSEC_CIPHER_IMPL_close(transformation, encryptor);
+}
+
+/** @brief Measures the throughput of AES-CBC encryption then HMAC-SHA256: two passes per message. */
+static void bench_cbc_hmac(int32_t message_size)
+{
+	LLSEC_MAC_algorithm_desc mac_description;
+	int32_t transformation = get_transformation("AES/CBC/NoPadding");
+	TEST_ASSERT_MESSAGE(SNI_ERROR != transformation, "Unknown cipher transformation");
+	int32_t mac_algorithm = LLSEC_MAC_IMPL_get_algorithm_description((uint8_t*)"HmacSHA256", &mac_description);
+	TEST_ASSERT_MESSAGE(SNI_ERROR != mac_algorithm, "Unknown MAC algorithm");
+
+	int32_t encryptor = LLSEC_CIPHER_IMPL_init(transformation, 0, key, AES_KEY_SIZE, nonce, CBC_IV_SIZE);
+	TEST_ASSERT_MESSAGE(SNI_ERROR != encryptor, "LLSEC_CIPHER_IMPL_init() returned an error");
+	int32_t hmac = LLSEC_MAC_IMPL_init(mac_algorithm, mac_key, sizeof(mac_key));
+	TEST_ASSERT_MESSAGE(SNI_ERROR != hmac, "LLSEC_MAC_IMPL_init() returned an error");
+
+	int32_t messages = THROUGHPUT_BYTES / message_size;
+	int64_t start = get_time_ns();
+	for (int32_t i = 0; i < messages; i++) {
+		LLSEC_CIPHER_IMPL_set_IV(transformation, encryptor, nonce, CBC_IV_SIZE);
+		(void)LLSEC_CIPHER_IMPL_encrypt(transformation, encryptor, plainBuffer, 0, message_size, cipherBuffer, 0);
+		LLSEC_MAC_IMPL_update(mac_algorithm, hmac, aad, 0, AAD_SIZE);
+		LLSEC_MAC_IMPL_update(mac_algorithm, hmac, cipherBuffer, 0, message_size);
+		LLSEC_MAC_IMPL_do_final(mac_algorithm, hmac, mac, 0, HMAC_SHA256_SIZE);
+		LLSEC_MAC_IMPL_reset(mac_algorithm, hmac);
+	}
+	print_throughput("AES/CBC + HmacSHA256", message_size, (int64_t)messages * message_size, get_time_ns() - start);
+	LLSEC_MAC_IMPL_close(mac_algorithm, hmac);
+	LLSEC_CIPHER_IMPL_close(transformation, encryptor);
+}
+
+/** @brief Compares the single pass AEAD throughput with CBC encryption followed by a HMAC, for small and large messages. */
+static void T_LLSEC_CHECK_aead_throughput(void)
+{
+	UTIL_print_string("LLSEC AEAD throughput\n");
+	const int32_t message_sizes[] = { 1024, MESSAGE_BUFFER_SIZE };
+
+	for (uint32_t i = 0; i < (sizeof(message_sizes) / sizeof(message_sizes[0])); i++) {
+		bench_cbc_hmac(message_sizes[i]);
+		bench_aead("AES/GCM/NoPadding", AES_KEY_SIZE, message_sizes[i]);
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+		bench_aead("ChaCha20-Poly1305", CHACHA_KEY_SIZE, message_sizes[i]);
+#endif
+	}
+}
+
+TestRef T_LLSEC_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixture_llsec) {
+		new_TestFixture("T_LLSEC_aes_gcm_round_trip", T_LLSEC_CHECK_aes_gcm_round_trip),
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+		new_TestFixture("T_LLSEC_chacha20_poly1305_round_trip", T_LLSEC_CHECK_chacha20_poly1305_round_trip),
+#endif
+		new_TestFixture("T_LLSEC_aead_throughput", T_LLSEC_CHECK_aead_throughput),
+		new_TestFixture("T_LLSEC_digest_many", T_LLSEC_CHECK_digest_many),
+		new_TestFixture("T_LLSEC_mac_many", T_LLSEC_CHECK_mac_many),
+		new_TestFixture("T_LLSEC_afalg", T_LLSEC_CHECK_afalg),
+	};
+	EMB_UNIT_TESTCALLER(llsec_tests, "LLSEC tests", T_LLSEC_setUp, T_LLSEC_tearDown, fixture_llsec);
+
+	return (TestRef)&llsec_tests;
+}
@@ -0,0 +1,635 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/**
+ * @file
+ * @brief Throughput and latency benchmark of the LLSEC natives.
+ *
+ * Each registered digest, cipher, MAC, signature, RSA cipher, PBKDF2 and key pair generator algorithm is called through
+ * its LLSEC_*_IMPL_* natives, for BENCH_DURATION_MS milliseconds (LLSEC_BENCH_DURATION_MS environment variable) and at
+ * least BENCH_MIN_OPERATIONS times. The digests, ciphers and MACs process messages from 16 B to 1 MiB.
+ *
+ * One CSV line is written per algorithm, operation and message size to BENCH_OUTPUT (LLSEC_BENCH_OUTPUT environment
+ * variable): number of operations per second, MB/s, and median and 99th percentile latency of one operation.
+ *
+ * The figures can be compared with <code>openssl speed</code> on the same machine: the messages sizes include its
+ * own ones, MB/s are millions of bytes per second (<code>openssl speed</code> reports thousands of bytes per second),
+ * and the algorithms match <code>-evp md5</code>, <code>sha1</code>, <code>sha256</code>, <code>sha512</code>,
+ * <code>aes-128-cbc</code>, <code>des-ede3-cbc</code>, <code>aes-128-gcm</code>, <code>chacha20-poly1305</code>,
+ * <code>-hmac sha256</code>, <code>rsa2048</code>, <code>ecdsap256</code> and <code>ecdsap384</code>. Here, each
+ * operation also includes the cost of the natives (context lookup, finalization, AEAD nonce and tag) and of the timer.
+ *
+ * The context pool benchmark measures whole operations on BENCH_POOL_MESSAGE_SIZE bytes, from the init native to the
+ * close one, with the contexts and algorithms of LLSEC_CTX_POOL_openssl.h (backend "pool"), then with a context
+ * allocated and an algorithm looked up by name for each operation, as the natives did before the pool (backend
+ * "fresh").
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+#include <openssl/opensslv.h>
+
+#include "t_llsec.h"
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "../../../../framework/c/utils/inc/u_print.h"
+
+#include "LLSEC_AFALG_openssl.h"
+#include "LLSEC_CIPHER_impl.h"
+#include "LLSEC_CIPHER_openssl.h"
+#include "LLSEC_DIGEST_impl.h"
+#include "LLSEC_KEY_PAIR_GENERATOR_impl.h"
+#include "LLSEC_MAC_impl.h"
+#include "LLSEC_RSA_CIPHER_impl.h"
+#include "LLSEC_SECRET_KEY_FACTORY_impl.h"
+#include "LLSEC_SIG_impl.h"
+
+
+// --------------------------------------------------------------------------------
+// -                                  Constants                                   -
+// --------------------------------------------------------------------------------
+
+/* Default duration of each measurement */
+#ifndef BENCH_DURATION_MS
+#define BENCH_DURATION_MS       (250)
+#endif
+
+/* Default path of the CSV file */
+#ifndef BENCH_OUTPUT
+#define BENCH_OUTPUT            "llsec_bench.csv"
+#endif
+
+/* Minimum number of operations of each measurement, for the slow ones like the RSA key generation */
+#define BENCH_MIN_OPERATIONS    (8)
+
+/* Number of latencies kept for the percentiles: the last ones of the measurement */
+#define BENCH_MAX_SAMPLES       (0x10000)
+
+/* Largest message */
+#define BENCH_BUFFER_SIZE       (1024 * 1024)
+
+#define BENCH_KEY_SIZE          (32)
+#define BENCH_IV_SIZE           (16)
+#define BENCH_NONCE_SIZE        (12)
+#define BENCH_AAD_SIZE          (13)
+#define BENCH_TAG_SIZE          (16)
+#define BENCH_OUTPUT_SIZE       (512) /* digest, MAC, tag, signature or RSA block */
+#define BENCH_SALT_SIZE         (16)
+#define BENCH_PBKDF2_ITERATIONS (1000)
+#define BENCH_PBKDF2_KEY_BITS   (256)
+#define BENCH_RSA_KEY_BITS      (2048)
+#define BENCH_RSA_EXPONENT      (65537)
+#define BENCH_RSA_MESSAGE_SIZE  (32) /* a symmetric key, below the limit of all the paddings */
+#define BENCH_SIG_DIGEST_SIZE   (32) /* SHA-256 */
+#define BENCH_POOL_MESSAGE_SIZE (64)
+
+#define BENCH_CSV_HEADER "category,algorithm,backend,operation,size_bytes,operations,seconds,ops_per_s,mb_per_s,p50_us,p99_us\n"
+
+/* Message sizes of the digests, ciphers and MACs: the ones of openssl speed, then larger ones */
+static const int32_t bench_sizes[] = { 16, 64, 256, 1024, 8192, 16384, 65536, BENCH_BUFFER_SIZE };
+
+typedef struct {
+	const char* name;
+	int32_t key_size;
+	int32_t iv_size;
+	bool aead;
+} bench_cipher;
+
+static const char* const bench_digests[] = { "MD5", "SHA-1", "SHA-256", "SHA-512" };
+
+static const bench_cipher bench_ciphers[] = {
+	{ "AES/CBC/NoPadding",    16, BENCH_IV_SIZE,    false },
+	{ "DESede/CBC/NoPadding", 24, 8,                false },
+	{ "AES/GCM/NoPadding",    16, BENCH_NONCE_SIZE, true  },
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+	{ "ChaCha20-Poly1305",    32, BENCH_NONCE_SIZE, true  },
+#endif
+};
+
+static const char* const bench_macs[] = { "HmacSHA256" };
+
+static const char* const bench_rsa_ciphers[] = {
+	"RSA/ECB/PKCS1Padding",
+	"RSA/ECB/OAEPWithSHA-1AndMGF1Padding",
+	"RSA/ECB/OAEPWithSHA-256AndMGF1Padding",
+};
+
+static const char* const bench_pbkdf2[] = {
+	"PBKDF2WithHmacSHA1", "PBKDF2WithHmacSHA224", "PBKDF2WithHmacSHA256", "PBKDF2WithHmacSHA384", "PBKDF2WithHmacSHA512",
+};
+
+/* Curves of the EC signatures and key pair generations */
+static const char* const bench_curves[] = { "prime256v1", "secp384r1" };
+
+
+// --------------------------------------------------------------------------------
+// -                                  Variables                                   -
+// --------------------------------------------------------------------------------
+
+/* @brief State of the measured operation */
+typedef struct {
+	int32_t algorithm;
+	int32_t native_id;
+	int32_t key_id;
+	int32_t size;
+	int32_t output_size;
+	int32_t iv_size;
+	const char* curve;
+} bench_context;
+
+typedef void (*bench_operation)(bench_context* context);
+
+static uint8_t inputBuffer[BENCH_BUFFER_SIZE];
+static uint8_t outputBuffer[BENCH_BUFFER_SIZE];
+static uint8_t resultBuffer[BENCH_OUTPUT_SIZE];
+static uint8_t signatureBuffer[BENCH_OUTPUT_SIZE];
+static uint8_t key[BENCH_KEY_SIZE];
+static uint8_t iv[BENCH_IV_SIZE];
+static uint8_t aad[BENCH_AAD_SIZE];
+static uint8_t salt[BENCH_SALT_SIZE];
+static uint8_t password[] = "benchmark password";
+
+static int64_t samples[BENCH_MAX_SAMPLES];
+static int64_t duration_ns;
+static FILE* output = NULL;
+static bool output_created = false;
+
+
+// --------------------------------------------------------------------------------
+// -                                  Measurement                                 -
+// --------------------------------------------------------------------------------
+
+static int64_t get_time_ns(void) {
+	struct timespec ts;
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((int64_t)ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+
+static int compare_samples(const void* a, const void* b) {
+	int64_t first = *(const int64_t*)a;
+	int64_t second = *(const int64_t*)b;
+	return (first > second) - (first < second);
+}
+
+/* @brief Returns the given percentile of the sorted latencies, in microseconds */
+static double get_percentile(int32_t count, int32_t percentile) {
+	int32_t index = ((count * percentile) + 99) / 100;
+	if (index > 0) {
+		index--;
+	}
+	return (double)samples[index] / 1e3;
+}
+
+/** @brief Runs an operation repeatedly, then writes its figures. <code>size</code> is the number of bytes it processes. */
+static void bench_run(const char* category, const char* algorithm_name, const char* backend, const char* operation_name,
+                      bench_operation operation, bench_context* context, int32_t size)
+{
+	char line[256];
+	int64_t operations = 0;
+
+	/* Warm up: first allocations and lazy initializations */
+	operation(context);
+
+	int64_t start = get_time_ns();
+	int64_t end = start;
+	while (((end - start) < duration_ns) || (operations < BENCH_MIN_OPERATIONS)) {
+		int64_t begin = end;
+		operation(context);
+		end = get_time_ns();
+		samples[operations % BENCH_MAX_SAMPLES] = end - begin;
+		operations++;
+	}
+
+	int32_t count = (operations < BENCH_MAX_SAMPLES) ? (int32_t)operations : BENCH_MAX_SAMPLES;
+	qsort(samples, count, sizeof(samples[0]), compare_samples);
+	double seconds = (double)(end - start) / 1e9;
+	double ops_per_s = (double)operations / seconds;
+	double mb_per_s = (ops_per_s * (double)size) / 1e6;
+	double p50 = get_percentile(count, 50);
+	double p99 = get_percentile(count, 99);
+
+	(void)snprintf(line, sizeof(line), "%-12s %-38s %-8s %7d B %12.1f op/s %10.2f MB/s  p99 %10.2f us\n", operation_name,
+	               algorithm_name, backend, (int)size, ops_per_s, mb_per_s, p99);
+	UTIL_print_string(line);
+	if (NULL != output) {
+		(void)fprintf(output, "%s,%s,%s,%s,%d,%lld,%.6f,%.1f,%.3f,%.3f,%.3f\n", category, algorithm_name, backend,
+		              operation_name, (int)size, (long long)operations, seconds, ops_per_s, mb_per_s, p50, p99);
+		(void)fflush(output);
+	}
+}
+
+static const char* get_backend(const char* algorithm_name) {
+	return LLSEC_AFALG_is_enabled(algorithm_name) ? "afalg" : "openssl";
+}
+
+/** @brief Function call before running test. */
+static void T_LLSEC_BENCH_setUp(void)
+{
+	UTIL_print_string("\nT_LLSEC_BENCH_setUp\n");
+	for (int32_t i = 0; i < BENCH_BUFFER_SIZE; i++) {
+		inputBuffer[i] = (uint8_t)i;
+	}
+	memset(key, 0x4b, sizeof(key));
+	memset(iv, 0x49, sizeof(iv));
+	memset(aad, 0x41, sizeof(aad));
+	memset(salt, 0x53, sizeof(salt));
+
+	const char* duration = getenv("LLSEC_BENCH_DURATION_MS");
+	duration_ns = (int64_t)((NULL != duration) ? atoi(duration) : BENCH_DURATION_MS) * 1000000;
+
+	/* The file is created by the first test, the next ones append to it */
+	const char* path = getenv("LLSEC_BENCH_OUTPUT");
+	if (NULL == path) {
+		path = BENCH_OUTPUT;
+	}
+	output = fopen(path, output_created ? "a" : "w");
+	if (NULL == output) {
+		UTIL_print_string("Cannot open the benchmark output file, the figures are only printed\n");
+	} else if (!output_created) {
+		(void)fputs(BENCH_CSV_HEADER, output);
+		output_created = true;
+	} else {
+		// The header has already been written
+	}
+}
+
+/** @brief Function call after running test. */
+static void T_LLSEC_BENCH_tearDown(void)
+{
+	UTIL_print_string("T_LLSEC_BENCH_tearDown\n");
+	if (NULL != output) {
+		(void)fclose(output);
+		output = NULL;
+	}
+}
+
+
+// --------------------------------------------------------------------------------
+// -                                  Operations                                  -
+// --------------------------------------------------------------------------------
+
+/* Digest of a message, the context is reset by the digest */
+static void digest_operation(bench_context* context) {
+	LLSEC_DIGEST_IMPL_update(context->algorithm, context->native_id, inputBuffer, 0, context->size);
+	LLSEC_DIGEST_IMPL_digest(context->algorithm, context->native_id, resultBuffer, 0, context->output_size);
+}
+
+/* Encryption of the next part of a message, as a Java update() */
+static void cipher_operation(bench_context* context) {
+	(void)LLSEC_CIPHER_IMPL_encrypt(context->algorithm, context->native_id, inputBuffer, 0, context->size, outputBuffer, 0);
+}
+
+/* Encryption of a whole message with its nonce and tag. A nonce must never be reused with the same key, except for a
+ * measurement like this one */
+static void aead_operation(bench_context* context) {
+	LLSEC_CIPHER_IMPL_set_IV(context->algorithm, context->native_id, iv, context->iv_size);
+	(void)LLSEC_CIPHER_IMPL_update_aad(context->algorithm, context->native_id, aad, 0, BENCH_AAD_SIZE);
+	(void)LLSEC_CIPHER_IMPL_encrypt(context->algorithm, context->native_id, inputBuffer, 0, context->size, outputBuffer, 0);
+	(void)LLSEC_CIPHER_IMPL_get_tag(context->algorithm, context->native_id, resultBuffer, 0, BENCH_TAG_SIZE);
+}
+
+/* MAC of a message, then reset of the context */
+static void mac_operation(bench_context* context) {
+	LLSEC_MAC_IMPL_update(context->algorithm, context->native_id, inputBuffer, 0, context->size);
+	LLSEC_MAC_IMPL_do_final(context->algorithm, context->native_id, resultBuffer, 0, context->output_size);
+	LLSEC_MAC_IMPL_reset(context->algorithm, context->native_id);
+}
+
+/* Signature of a digest, the length of the last one is kept for the verification */
+static void sign_operation(bench_context* context) {
+	context->output_size = LLSEC_SIG_IMPL_sign(context->algorithm, signatureBuffer, BENCH_OUTPUT_SIZE, context->key_id,
+	                                           inputBuffer, BENCH_SIG_DIGEST_SIZE);
+}
+
+static void verify_operation(bench_context* context) {
+	(void)LLSEC_SIG_IMPL_verify(context->algorithm, signatureBuffer, context->output_size, context->key_id, inputBuffer,
+	                            BENCH_SIG_DIGEST_SIZE);
+}
+
+static void rsa_encrypt_operation(bench_context* context) {
+	context->output_size = LLSEC_RSA_CIPHER_IMPL_encrypt(context->algorithm, context->native_id, inputBuffer, 0,
+	                                                     BENCH_RSA_MESSAGE_SIZE, signatureBuffer, 0);
+}
+
+static void rsa_decrypt_operation(bench_context* context) {
+	(void)LLSEC_RSA_CIPHER_IMPL_decrypt(context->algorithm, context->native_id, signatureBuffer, 0, context->output_size,
+	                                    outputBuffer, 0);
+}
+
+static void pbkdf2_operation(bench_context* context) {
+	int32_t secret_key = LLSEC_SECRET_KEY_FACTORY_IMPL_get_key_data(context->algorithm, password, sizeof(password) - 1,
+	                                                                salt, BENCH_SALT_SIZE, BENCH_PBKDF2_ITERATIONS,
+	                                                                BENCH_PBKDF2_KEY_BITS);
+	if (SNI_ERROR != secret_key) {
+		// cppcheck-suppress misra-c2012-11.1 // Abstract data type for SNI usage
+		SNI_closeFunction close = (SNI_closeFunction)LLSEC_SECRET_KEY_FACTORY_IMPL_get_close_id(context->algorithm);
+		// cppcheck-suppress misra-c2012-11.6 // Abstract data type for SNI usage
+		close((void*)secret_key);
+	}
+}
+
+/* Digest of a message with a pooled context */
+static void pooled_digest_operation(bench_context* context) {
+	int32_t native_id = LLSEC_DIGEST_IMPL_init(context->algorithm);
+	LLSEC_DIGEST_IMPL_update(context->algorithm, native_id, inputBuffer, 0, context->size);
+	LLSEC_DIGEST_IMPL_digest(context->algorithm, native_id, resultBuffer, 0, context->output_size);
+	LLSEC_DIGEST_IMPL_close(context->algorithm, native_id);
+}
+
+static void fresh_digest_operation(bench_context* context) {
+	unsigned int length;
+	EVP_MD_CTX* ctx = EVP_MD_CTX_create();
+	(void)EVP_DigestInit_ex(ctx, EVP_get_digestbyname("SHA256"), NULL);
+	(void)EVP_DigestUpdate(ctx, inputBuffer, (size_t)context->size);
+	(void)EVP_DigestFinal_ex(ctx, resultBuffer, &length);
+	EVP_MD_CTX_destroy(ctx);
+}
+
+/* Encryption of a message with a pooled context */
+static void pooled_cipher_operation(bench_context* context) {
+	int32_t native_id = LLSEC_CIPHER_IMPL_init(context->algorithm, 0, key, 16, iv, context->iv_size);
+	(void)LLSEC_CIPHER_IMPL_encrypt(context->algorithm, native_id, inputBuffer, 0, context->size, outputBuffer, 0);
+	LLSEC_CIPHER_IMPL_close(context->algorithm, native_id);
+}
+
+static void fresh_cipher_operation(bench_context* context) {
+	int length;
+	EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+	(void)EVP_EncryptInit_ex(ctx, EVP_get_cipherbyname("AES-128-CBC"), NULL, key, iv);
+	(void)EVP_CIPHER_CTX_set_padding(ctx, 0);
+	(void)EVP_EncryptUpdate(ctx, outputBuffer, &length, inputBuffer, context->size);
+	EVP_CIPHER_CTX_free(ctx);
+}
+
+/* MAC of a message with a pooled context */
+static void pooled_mac_operation(bench_context* context) {
+	int32_t native_id = LLSEC_MAC_IMPL_init(context->algorithm, key, BENCH_KEY_SIZE);
+	LLSEC_MAC_IMPL_update(context->algorithm, native_id, inputBuffer, 0, context->size);
+	LLSEC_MAC_IMPL_do_final(context->algorithm, native_id, resultBuffer, 0, context->output_size);
+	LLSEC_MAC_IMPL_close(context->algorithm, native_id);
+}
+
+/* One-shot HMAC, with its own context */
+static void fresh_mac_operation(bench_context* context) {
+	unsigned int length;
+	(void)HMAC(EVP_get_digestbyname("SHA256"), key, BENCH_KEY_SIZE, inputBuffer, (size_t)context->size, resultBuffer,
+	           &length);
+}
+
+/* Generates a key pair, returns its native ID or SNI_ERROR */
+static int32_t generate_key_pair(const char* algorithm_name, const char* curve) {
+	int32_t key_pair = SNI_ERROR;
+	int32_t algorithm = LLSEC_KEY_PAIR_GENERATOR_IMPL_get_algorithm((uint8_t*)algorithm_name);
+	if (SNI_ERROR != algorithm) {
+		key_pair = LLSEC_KEY_PAIR_GENERATOR_IMPL_generateKeyPair(algorithm, BENCH_RSA_KEY_BITS, BENCH_RSA_EXPONENT,
+		                                                         (uint8_t*)curve);
+	}
+	return key_pair;
+}
+
+static void close_key_pair(const char* algorithm_name, int32_t key_pair) {
+	int32_t algorithm = LLSEC_KEY_PAIR_GENERATOR_IMPL_get_algorithm((uint8_t*)algorithm_name);
+	// cppcheck-suppress misra-c2012-11.1 // Abstract data type for SNI usage
+	SNI_closeFunction close = (SNI_closeFunction)LLSEC_KEY_PAIR_GENERATOR_IMPL_get_close_id(algorithm);
+	// cppcheck-suppress misra-c2012-11.6 // Abstract data type for SNI usage
+	close((void*)key_pair);
+}
+
+static void key_pair_operation(bench_context* context) {
+	int32_t key_pair = LLSEC_KEY_PAIR_GENERATOR_IMPL_generateKeyPair(context->algorithm, BENCH_RSA_KEY_BITS,
+	                                                                 BENCH_RSA_EXPONENT, (uint8_t*)context->curve);
+	if ((SNI_ERROR != key_pair) && (0 != key_pair)) {
+		// cppcheck-suppress misra-c2012-11.1 // Abstract data type for SNI usage
+		SNI_closeFunction close = (SNI_closeFunction)LLSEC_KEY_PAIR_GENERATOR_IMPL_get_close_id(context->algorithm);
+		// cppcheck-suppress misra-c2012-11.6 // Abstract data type for SNI usage
+		close((void*)key_pair);
+	}
+}
+
+
+// --------------------------------------------------------------------------------
+// -                                  Tests                                       -
+// --------------------------------------------------------------------------------
+
+static void T_LLSEC_BENCH_digest(void)
+{
+	UTIL_print_string("LLSEC digest benchmark\n");
+	for (uint32_t i = 0; i < (sizeof(bench_digests) / sizeof(bench_digests[0])); i++) {
+		LLSEC_DIGEST_algorithm_desc description;
+		bench_context context = { 0 };
+		context.algorithm = LLSEC_DIGEST_IMPL_get_algorithm_description((uint8_t*)bench_digests[i], &description);
+		TEST_ASSERT_MESSAGE(SNI_ERROR != context.algorithm, "Unknown digest algorithm");
+		context.output_size = description.digest_length;
+		context.native_id = LLSEC_DIGEST_IMPL_init(context.algorithm);
+		TEST_ASSERT_MESSAGE(SNI_ERROR != context.native_id, "LLSEC_DIGEST_IMPL_init() returned an error");
+		for (uint32_t j = 0; j < (sizeof(bench_sizes) / sizeof(bench_sizes[0])); j++) {
+			context.size = bench_sizes[j];
+			bench_run("digest", bench_digests[i], get_backend(bench_digests[i]), "digest", digest_operation, &context,
+			          context.size);
+		}
+		LLSEC_DIGEST_IMPL_close(context.algorithm, context.native_id);
+	}
+}
+
+static void T_LLSEC_BENCH_cipher(void)
+{
+	UTIL_print_string("LLSEC cipher benchmark\n");
+	for (uint32_t i = 0; i < (sizeof(bench_ciphers) / sizeof(bench_ciphers[0])); i++) {
+		const bench_cipher* cipher = &bench_ciphers[i];
+		LLSEC_CIPHER_transformation_desc description;
+		bench_context context = { 0 };
+		context.algorithm = LLSEC_CIPHER_IMPL_get_transformation_description((uint8_t*)cipher->name, &description);
+		TEST_ASSERT_MESSAGE(SNI_ERROR != context.algorithm, "Unknown cipher transformation");
+		context.iv_size = cipher->iv_size;
+		context.native_id = LLSEC_CIPHER_IMPL_init(context.algorithm, 0, key, cipher->key_size, iv, cipher->iv_size);
+		TEST_ASSERT_MESSAGE(SNI_ERROR != context.native_id, "LLSEC_CIPHER_IMPL_init() returned an error");
+		for (uint32_t j = 0; j < (sizeof(bench_sizes) / sizeof(bench_sizes[0])); j++) {
+			context.size = bench_sizes[j];
+			bench_run("cipher", cipher->name, get_backend(cipher->name), "encrypt",
+			          cipher->aead ? aead_operation : cipher_operation, &context, context.size);
+		}
+		LLSEC_CIPHER_IMPL_close(context.algorithm, context.native_id);
+	}
+}
+
+static void T_LLSEC_BENCH_mac(void)
+{
+	UTIL_print_string("LLSEC MAC benchmark\n");
+	for (uint32_t i = 0; i < (sizeof(bench_macs) / sizeof(bench_macs[0])); i++) {
+		LLSEC_MAC_algorithm_desc description;
+		bench_context context = { 0 };
+		context.algorithm = LLSEC_MAC_IMPL_get_algorithm_description((uint8_t*)bench_macs[i], &description);
+		TEST_ASSERT_MESSAGE(SNI_ERROR != context.algorithm, "Unknown MAC algorithm");
+		context.output_size = description.mac_length;
+		context.native_id = LLSEC_MAC_IMPL_init(context.algorithm, key, BENCH_KEY_SIZE);
+		TEST_ASSERT_MESSAGE(SNI_ERROR != context.native_id, "LLSEC_MAC_IMPL_init() returned an error");
+		for (uint32_t j = 0; j < (sizeof(bench_sizes) / sizeof(bench_sizes[0])); j++) {
+			context.size = bench_sizes[j];
+			bench_run("mac", bench_macs[i], get_backend(bench_macs[i]), "mac", mac_operation, &context, context.size);
+		}
+		LLSEC_MAC_IMPL_close(context.algorithm, context.native_id);
+	}
+}
+
+/** @brief Signs and verifies a digest. The key pair is also the public key, as the verification only uses its public part. */
+static void bench_signature(const char* algorithm_name, const char* key_algorithm_name, const char* curve)
+{
+	char name[64];
+	uint8_t digest_name[16];
+	bench_context context = { 0 };
+	context.algorithm = LLSEC_SIG_IMPL_get_algorithm_description((uint8_t*)algorithm_name, digest_name, sizeof(digest_name));
+	TEST_ASSERT_MESSAGE(SNI_ERROR != context.algorithm, "Unknown signature algorithm");
+	context.key_id = generate_key_pair(key_algorithm_name, curve);
+	TEST_ASSERT_MESSAGE((SNI_ERROR != context.key_id) && (0 != context.key_id), "Key pair generation failed");
+
+	(void)snprintf(name, sizeof(name), "%s/%s", algorithm_name, (NULL != curve) ? curve : "2048");
+	bench_run("signature", name, "openssl", "sign", sign_operation, &context, BENCH_SIG_DIGEST_SIZE);
+	TEST_ASSERT_MESSAGE(context.output_size > 0, "LLSEC_SIG_IMPL_sign() returned an error");
+	TEST_ASSERT_EQUAL_INT(JTRUE, LLSEC_SIG_IMPL_verify(context.algorithm, signatureBuffer, context.output_size,
+	                                                   context.key_id, inputBuffer, BENCH_SIG_DIGEST_SIZE));
+	bench_run("signature", name, "openssl", "verify", verify_operation, &context, BENCH_SIG_DIGEST_SIZE);
+
+	close_key_pair(key_algorithm_name, context.key_id);
+}
+
+static void T_LLSEC_BENCH_signature(void)
+{
+	UTIL_print_string("LLSEC signature benchmark\n");
+	bench_signature("SHA256withRSA", "RSA", NULL);
+	for (uint32_t i = 0; i < (sizeof(bench_curves) / sizeof(bench_curves[0])); i++) {
+		bench_signature("SHA256withECDSA", "EC", bench_curves[i]);
+	}
+}
+
+static void T_LLSEC_BENCH_rsa_cipher(void)
+{
+	UTIL_print_string("LLSEC RSA cipher benchmark\n");
+	int32_t key_pair = generate_key_pair("RSA", NULL);
+	TEST_ASSERT_MESSAGE((SNI_ERROR != key_pair) && (0 != key_pair), "Key pair generation failed");
+
+	for (uint32_t i = 0; i < (sizeof(bench_rsa_ciphers) / sizeof(bench_rsa_ciphers[0])); i++) {
+		LLSEC_RSA_CIPHER_transformation_desc description;
+		bench_context encryption = { 0 };
+		bench_context decryption = { 0 };
+		int32_t transformation = LLSEC_RSA_CIPHER_IMPL_get_transformation_description((uint8_t*)bench_rsa_ciphers[i],
+		                                                                              &description);
+		TEST_ASSERT_MESSAGE(SNI_ERROR != transformation, "Unknown RSA cipher transformation");
+		encryption.algorithm = transformation;
+		encryption.native_id = LLSEC_RSA_CIPHER_IMPL_init(transformation, 0, key_pair, description.padding_type,
+		                                                  description.oaep_hash_algorithm);
+		TEST_ASSERT_MESSAGE(SNI_ERROR != encryption.native_id, "LLSEC_RSA_CIPHER_IMPL_init() returned an error");
+		decryption.algorithm = transformation;
+		decryption.native_id = LLSEC_RSA_CIPHER_IMPL_init(transformation, 1, key_pair, description.padding_type,
+		                                                  description.oaep_hash_algorithm);
+		TEST_ASSERT_MESSAGE(SNI_ERROR != decryption.native_id, "LLSEC_RSA_CIPHER_IMPL_init() returned an error");
+
+		bench_run("rsa_cipher", bench_rsa_ciphers[i], "openssl", "encrypt", rsa_encrypt_operation, &encryption,
+		          BENCH_RSA_MESSAGE_SIZE);
+		TEST_ASSERT_MESSAGE(encryption.output_size > 0, "LLSEC_RSA_CIPHER_IMPL_encrypt() returned an error");
+		decryption.output_size = encryption.output_size;
+		TEST_ASSERT_EQUAL_INT(BENCH_RSA_MESSAGE_SIZE, LLSEC_RSA_CIPHER_IMPL_decrypt(transformation, decryption.native_id,
+		                                                                           signatureBuffer, 0, decryption.output_size,
+		                                                                           outputBuffer, 0));
+		if(0 != memcmp(inputBuffer, outputBuffer, BENCH_RSA_MESSAGE_SIZE)){
+			TEST_ASSERT_MESSAGE(false, "Decrypted message differs from the plain message");
+		}
+		bench_run("rsa_cipher", bench_rsa_ciphers[i], "openssl", "decrypt", rsa_decrypt_operation, &decryption,
+		          BENCH_RSA_MESSAGE_SIZE);
+
+		LLSEC_RSA_CIPHER_IMPL_close(transformation, encryption.native_id);
+		LLSEC_RSA_CIPHER_IMPL_close(transformation, decryption.native_id);
+	}
+	close_key_pair("RSA", key_pair);
+}
+
+static void T_LLSEC_BENCH_pbkdf2(void)
+{
+	UTIL_print_string("LLSEC PBKDF2 benchmark\n");
+	for (uint32_t i = 0; i < (sizeof(bench_pbkdf2) / sizeof(bench_pbkdf2[0])); i++) {
+		bench_context context = { 0 };
+		context.algorithm = LLSEC_SECRET_KEY_FACTORY_IMPL_get_algorithm((uint8_t*)bench_pbkdf2[i]);
+		TEST_ASSERT_MESSAGE(SNI_ERROR != context.algorithm, "Unknown secret key factory algorithm");
+		/* One operation is BENCH_PBKDF2_ITERATIONS iterations on the password */
+		bench_run("pbkdf2", bench_pbkdf2[i], "openssl", "derive", pbkdf2_operation, &context, sizeof(password) - 1);
+	}
+}
+
+static void T_LLSEC_BENCH_key_pair(void)
+{
+	UTIL_print_string("LLSEC key pair generator benchmark\n");
+	char name[64];
+	bench_context context = { 0 };
+	context.algorithm = LLSEC_KEY_PAIR_GENERATOR_IMPL_get_algorithm((uint8_t*)"RSA");
+	TEST_ASSERT_MESSAGE(SNI_ERROR != context.algorithm, "Unknown key pair generator algorithm");
+	(void)snprintf(name, sizeof(name), "RSA/%d", BENCH_RSA_KEY_BITS);
+	bench_run("key_pair", name, "openssl", "generate", key_pair_operation, &context, 0);
+
+	context.algorithm = LLSEC_KEY_PAIR_GENERATOR_IMPL_get_algorithm((uint8_t*)"EC");
+	TEST_ASSERT_MESSAGE(SNI_ERROR != context.algorithm, "Unknown key pair generator algorithm");
+	for (uint32_t i = 0; i < (sizeof(bench_curves) / sizeof(bench_curves[0])); i++) {
+		context.curve = bench_curves[i];
+		(void)snprintf(name, sizeof(name), "EC/%s", bench_curves[i]);
+		bench_run("key_pair", name, "openssl", "generate", key_pair_operation, &context, 0);
+	}
+}
+
+static void T_LLSEC_BENCH_context_pool(void)
+{
+	UTIL_print_string("LLSEC context pool benchmark\n");
+	LLSEC_DIGEST_algorithm_desc digest_description;
+	bench_context digest = { 0 };
+	digest.algorithm = LLSEC_DIGEST_IMPL_get_algorithm_description((uint8_t*)"SHA-256", &digest_description);
+	TEST_ASSERT_MESSAGE(SNI_ERROR != digest.algorithm, "Unknown digest algorithm");
+	digest.output_size = digest_description.digest_length;
+	digest.size = BENCH_POOL_MESSAGE_SIZE;
+	bench_run("context_pool", "SHA-256", "pool", "digest", pooled_digest_operation, &digest, digest.size);
+	bench_run("context_pool", "SHA-256", "fresh", "digest", fresh_digest_operation, &digest, digest.size);
+
+	LLSEC_CIPHER_transformation_desc cipher_description;
+	bench_context cipher = { 0 };
+	cipher.algorithm = LLSEC_CIPHER_IMPL_get_transformation_description((uint8_t*)"AES/CBC/NoPadding",
+	                                                                    &cipher_description);
+	TEST_ASSERT_MESSAGE(SNI_ERROR != cipher.algorithm, "Unknown cipher transformation");
+	cipher.iv_size = BENCH_IV_SIZE;
+	cipher.size = BENCH_POOL_MESSAGE_SIZE;
+	bench_run("context_pool", "AES/CBC/NoPadding", "pool", "encrypt", pooled_cipher_operation, &cipher, cipher.size);
+	bench_run("context_pool", "AES/CBC/NoPadding", "fresh", "encrypt", fresh_cipher_operation, &cipher, cipher.size);
+
+	LLSEC_MAC_algorithm_desc mac_description;
+	bench_context mac = { 0 };
+	mac.algorithm = LLSEC_MAC_IMPL_get_algorithm_description((uint8_t*)"HmacSHA256", &mac_description);
+	TEST_ASSERT_MESSAGE(SNI_ERROR != mac.algorithm, "Unknown MAC algorithm");
+	mac.output_size = mac_description.mac_length;
+	mac.size = BENCH_POOL_MESSAGE_SIZE;
+	bench_run("context_pool", "HmacSHA256", "pool", "mac", pooled_mac_operation, &mac, mac.size);
+	bench_run("context_pool", "HmacSHA256", "fresh", "mac", fresh_mac_operation, &mac, mac.size);
+}
+
+TestRef T_LLSEC_BENCH_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixture_llsec_bench) {
+		new_TestFixture("T_LLSEC_BENCH_digest", T_LLSEC_BENCH_digest),
+		new_TestFixture("T_LLSEC_BENCH_cipher", T_LLSEC_BENCH_cipher),
+		new_TestFixture("T_LLSEC_BENCH_mac", T_LLSEC_BENCH_mac),
+		new_TestFixture("T_LLSEC_BENCH_signature", T_LLSEC_BENCH_signature),
+		new_TestFixture("T_LLSEC_BENCH_rsa_cipher", T_LLSEC_BENCH_rsa_cipher),
+		new_TestFixture("T_LLSEC_BENCH_pbkdf2", T_LLSEC_BENCH_pbkdf2),
+		new_TestFixture("T_LLSEC_BENCH_key_pair", T_LLSEC_BENCH_key_pair),
+		new_TestFixture("T_LLSEC_BENCH_context_pool", T_LLSEC_BENCH_context_pool),
+	};
+	EMB_UNIT_TESTCALLER(llsec_bench_tests, "LLSEC benchmark", T_LLSEC_BENCH_setUp, T_LLSEC_BENCH_tearDown, fixture_llsec_bench);
+
+	return (TestRef)&llsec_bench_tests;
+}
@@ -0,0 +1,23 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include "t_llsec.h"
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "../../../../framework/c/utils/inc/u_print.h"
+
+#define LLSEC_VERSION "v1.0.0"
+
+void T_LLSEC_main(void) {
+    UTIL_print_string("\nT_LLSEC " LLSEC_VERSION "\n");
+	TestRunner_start();
+	TestRunner_runTest(T_LLSEC_tests());
+	TestRunner_runTest(T_LLSEC_BENCH_tests());
+	TestRunner_end();
+	return;
+}
@@ -0,0 +1,35 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#ifndef T_LLSSL_H
+#define T_LLSSL_H
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+/**
+ * @brief this function is the entry point for the LLSSL Test Suite.
+ */
+void T_LLSSL_main(void);
+
+/**
+ * @brief Functional tests of the SSL socket natives (see t_llssl.c).
+ */
+TestRef	T_LLSSL_tests(void);
+
+/**
+ * @brief Loopback benchmark of the TLS connections of the SSL module (see t_llssl_bench.c).
+ */
+TestRef	T_LLSSL_BENCH_tests(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
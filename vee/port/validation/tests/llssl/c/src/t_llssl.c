@@ -0,0 +1,118 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/**
+ * @file
+ * @brief Functional tests of the SSL socket natives.
+ *
+ * The natives are called as the Java sockets do. Without the VM, a Java thread suspended by a native is not resumed:
+ * the result of a handshake step run by a worker is not got, and its session stays held by the job.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include <openssl/ssl.h>
+
+#include "t_llssl.h"
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "../../../../framework/c/utils/inc/u_print.h"
+
+#include "LLNET_SSL_CONSTANTS.h"
+#include "LLNET_SSL_CONTEXT_impl.h"
+#include "LLNET_SSL_SOCKET_impl.h"
+#include "LLNET_SSL_handshake_worker.h"
+#include "LLNET_SSL_memory.h"
+
+
+// --------------------------------------------------------------------------------
+// -                                  Constants                                   -
+// --------------------------------------------------------------------------------
+
+/* Maximum wait for the ClientHello sent by a handshake worker */
+#define CLIENT_HELLO_TIMEOUT_MS     (5000)
+
+/* Content type of the TLS handshake records */
+#define TLS_RECORD_HANDSHAKE        (0x16)
+
+static uint8_t receiveBuffer[0x4000];
+
+/** @brief Function call before running test. */
+static void T_LLSSL_setUp(void)
+{
+	UTIL_print_string("\nT_LLSSL_setUp\n");
+	(void)memset(receiveBuffer, 0, sizeof(receiveBuffer));
+}
+
+/** @brief Function call after running test. */
+static void T_LLSSL_tearDown(void)
+{
+	UTIL_print_string("T_LLSSL_tearDown\n");
+}
+
+/** @brief Closes a client socket, as another Java thread would, while a worker runs its first handshake step. The
+ *  		peer never answers the ClientHello. The session must not be shut down nor freed: no close notify is sent
+ *  		and the session keeps its memory account.
+ */
+static void T_LLSSL_CHECK_close_during_handshake(void)
+{
+	LLNET_SSL_HANDSHAKE_WORKER_initialize();
+	if (!LLNET_SSL_HANDSHAKE_WORKER_is_started()) {
+		UTIL_print_string("SSL handshake workers not started, test skipped\n");
+		return;
+	}
+
+	int fds[2];
+	TEST_ASSERT_EQUAL_INT(0, socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds));
+	int32_t context = LLNET_SSL_CONTEXT_IMPL_createContext(TLSv1_2_PROTOCOL, 1);
+	TEST_ASSERT_MESSAGE(0 != context, "LLNET_SSL_CONTEXT_IMPL_createContext() returned an error");
+	int32_t ssl = LLNET_SSL_SOCKET_IMPL_create(context, fds[0], NULL, 0, false, 1, 0);
+	TEST_ASSERT_MESSAGE(0 != ssl, "LLNET_SSL_SOCKET_IMPL_create() returned an error");
+
+	LLNET_SSL_SOCKET_IMPL_initialClientHandShake(ssl, fds[0], 0, 0);
+	TEST_ASSERT_MESSAGE(LLNET_SSL_HANDSHAKE_WORKER_is_busy((SSL*)ssl), "Session not busy during the handshake step");
+	struct pollfd pfd = { fds[1], POLLIN, 0 };
+	TEST_ASSERT_EQUAL_INT(1, poll(&pfd, 1, CLIENT_HELLO_TIMEOUT_MS));
+	ssize_t received = recv(fds[1], receiveBuffer, sizeof(receiveBuffer), MSG_DONTWAIT);
+	TEST_ASSERT_MESSAGE((received > 0) && (TLS_RECORD_HANDSHAKE == receiveBuffer[0]), "No ClientHello received");
+
+	/* As SSLSocket.close(): shutdown, close of the socket, then free */
+	LLNET_SSL_SOCKET_IMPL_shutdown(ssl, fds[0], true, 0, 0);
+	(void)close(fds[0]);
+	LLNET_SSL_SOCKET_IMPL_freeSSL(ssl);
+
+	TEST_ASSERT_MESSAGE(LLNET_SSL_HANDSHAKE_WORKER_is_busy((SSL*)ssl), "Session not busy after the close");
+	TEST_ASSERT_MESSAGE(NULL != LLNET_SSL_MEMORY_get_account((SSL*)ssl), "Session freed during the handshake step");
+	/* The peer gets the end of the connection, without close notify alert */
+	do {
+		received = recv(fds[1], receiveBuffer, sizeof(receiveBuffer), 0);
+	} while ((received < 0) && (EINTR == errno));
+	TEST_ASSERT_EQUAL_INT(0, (int32_t)received);
+
+	(void)close(fds[1]);
+	// The session holds a reference to the context
+	LLNET_SSL_CONTEXT_IMPL_freeContext(context);
+}
+
+TestRef T_LLSSL_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixture_llssl) {
+		new_TestFixture("T_LLSSL_close_during_handshake", T_LLSSL_CHECK_close_during_handshake),
+	};
+	EMB_UNIT_TESTCALLER(llssl_tests, "LLSSL sockets", T_LLSSL_setUp, T_LLSSL_tearDown, fixture_llssl);
+
+	return (TestRef)&llssl_tests;
+}
@@ -0,0 +1,774 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+/**
+ * @file
+ * @brief Loopback benchmark of the TLS connections of the SSL module.
+ *
+ * The natives need the VM to wait for the sockets, so the TLS connections are made with OpenSSL over TCP loopback
+ * connections, with the contexts and sessions configured by the helpers of the SSL module as the natives do (kTLS,
+ * memory accounts and record buffers, TLS 1.3 resumption). The client does not verify the self-signed certificate
+ * of the server. Each measurement lasts BENCH_DURATION_MS milliseconds (LLSSL_BENCH_DURATION_MS environment
+ * variable), and prints the number of operations per second and the median and 99th percentile duration of one
+ * operation.
+ *
+ * - kTLS: 16-kilobyte TLS 1.2 writes counted by a reader thread, with the user-space record layer then with kTLS.
+ *   kTLS requires OpenSSL 3.0 built with kTLS support and the kernel tls module (<code>modprobe tls</code>),
+ *   otherwise both measurements use the user-space record layer.
+ * - Memory: BENCH_MEMORY_CONNECTIONS idle TLS 1.2 connections after one 64-byte request and response, with the
+ *   record buffers kept by the idle connections (SSL_MODE_RELEASE_BUFFERS cleared) then released as by
+ *   LLNET_SSL_MEMORY_configure_context(). Prints the resident memory and the OpenSSL memory per connection, both
+ *   sides included, the number of connections per megabyte of resident memory, and the request and response
+ *   latency. The buffer pool is enabled at build time (LLNET_SSL_MEMORY_POOL_BLOCKS) for both measurements. The
+ *   resident memory freed by a measurement is reused by the next one: the OpenSSL memory, counted by the allocation
+ *   functions of LLNET_SSL_memory.c, is the exact figure.
+ * - TLS 1.3: time to the first byte of the response of a new connection (connection, handshake, 64-byte request and
+ *   response), with a full handshake, with the resumption of the session kept by LLNET_SSL_TLS13_resume(), then with
+ *   the request sent as 0-RTT early data. The server accepts BENCH_MESSAGE_SIZE bytes of early data, whatever
+ *   LLNET_SSL_TLS13_MAX_EARLY_DATA. Each mode saves round trips: on loopback they are only visible with an artificial
+ *   latency, e.g. <code>tc qdisc add dev lo root netem delay 5ms</code> (then <code>tc qdisc del dev lo root</code>).
+ *
+ * Requires OpenSSL 1.1.0 or later.
+ *
+ * @author MicroEJ Developer Team
+ * @version 1.0.0
+ * @date 18 October 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include <openssl/opensslv.h>
+#include <openssl/ssl.h>
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+
+#include "t_llssl.h"
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "../../../../framework/c/utils/inc/u_print.h"
+
+#include "LLNET_SSL_CONSTANTS.h"
+#include "LLNET_SSL_ktls.h"
+#include "LLNET_SSL_memory.h"
+#include "LLNET_SSL_tls13.h"
+
+#if (OPENSSL_VERSION_NUMBER >= 0x10100000L)
+
+
+// --------------------------------------------------------------------------------
+// -                                  Constants                                   -
+// --------------------------------------------------------------------------------
+
+/* Default duration of each measurement */
+#ifndef BENCH_DURATION_MS
+#define BENCH_DURATION_MS       (1000)
+#endif
+
+/* Number of durations kept for the percentiles: the last ones of the measurement */
+#define BENCH_MAX_SAMPLES       (0x10000)
+
+/* Size of a write of the throughput measurement: one full TLS record */
+#define BENCH_BULK_SIZE         (16 * 1024)
+
+/* Maximum wait of the peer during a handshake or a read, in milliseconds */
+#define BENCH_WAIT_TIMEOUT_MS   (5000)
+
+/* Number of idle connections of the memory measurement */
+#define BENCH_MEMORY_CONNECTIONS (64)
+
+/* Size of a request and of its response */
+#define BENCH_MESSAGE_SIZE      (64)
+
+/* Server host name, used for the resumption */
+#define BENCH_HOST_NAME         "localhost"
+
+
+// --------------------------------------------------------------------------------
+// -                                  Variables                                   -
+// --------------------------------------------------------------------------------
+
+/* @brief A TLS loopback connection, both sides handled by the calling task */
+typedef struct {
+	int32_t client_fd;
+	int32_t server_fd;
+	SSL* client;
+	SSL* server;
+} bench_tls_connection;
+
+/* @brief A throughput benchmark, with a reader thread */
+typedef struct {
+	bench_tls_connection connection;
+	pthread_t reader_thread;
+	int64_t received;
+} bench_bulk_context;
+
+/* @brief A TLS 1.3 new connection benchmark */
+typedef struct {
+	SSL_CTX* client_ctx;
+	SSL_CTX* server_ctx;
+	bool early_data;
+	int64_t resumed;
+	int64_t early_data_accepted;
+} bench_tls13_context;
+
+typedef bool (*bench_operation)(void* context);
+
+static EVP_PKEY* server_key;
+static X509* server_certificate;
+
+static uint8_t request[BENCH_MESSAGE_SIZE];
+static uint8_t response[BENCH_MESSAGE_SIZE];
+static uint8_t buffer[BENCH_MESSAGE_SIZE];
+static uint8_t bulk_data[BENCH_BULK_SIZE];
+static uint8_t bulk_buffer[BENCH_BULK_SIZE];
+
+static bench_tls_connection connections[BENCH_MEMORY_CONNECTIONS];
+
+static int64_t samples[BENCH_MAX_SAMPLES];
+static int64_t duration_ns;
+
+
+// --------------------------------------------------------------------------------
+// -                                  Measurement                                 -
+// --------------------------------------------------------------------------------
+
+static int64_t get_time_ns(void) {
+	struct timespec ts;
+	(void)clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((int64_t)ts.tv_sec * 1000000000) + ts.tv_nsec;
+}
+
+static int compare_samples(const void* a, const void* b) {
+	int64_t first = *(const int64_t*)a;
+	int64_t second = *(const int64_t*)b;
+	return (first > second) - (first < second);
+}
+
+/* @brief Returns the given percentile of the sorted durations, in microseconds */
+static double get_percentile(int32_t count, int32_t percentile) {
+	int32_t index = ((count * percentile) + 99) / 100;
+	if (index > 0) {
+		index--;
+	}
+	return (double)samples[index] / 1e3;
+}
+
+/** @brief Runs an operation repeatedly, then prints its figures. */
+static void bench_run(const char* benchmark, const char* mode, bench_operation operation, void* context)
+{
+	char line[256];
+	int64_t operations = 0;
+
+	/* Warm up */
+	TEST_ASSERT_MESSAGE(operation(context), "Benchmark operation failed");
+
+	int64_t start = get_time_ns();
+	int64_t end = start;
+	while ((end - start) < duration_ns) {
+		int64_t begin = end;
+		TEST_ASSERT_MESSAGE(operation(context), "Benchmark operation failed");
+		end = get_time_ns();
+		samples[operations % BENCH_MAX_SAMPLES] = end - begin;
+		operations++;
+	}
+
+	int32_t count = (operations < BENCH_MAX_SAMPLES) ? (int32_t)operations : BENCH_MAX_SAMPLES;
+	qsort(samples, count, sizeof(samples[0]), compare_samples);
+	double seconds = (double)(end - start) / 1e9;
+	(void)snprintf(line, sizeof(line), "%-16s %-14s %10lld ops %12.1f op/s  p50 %10.2f us  p99 %10.2f us\n", benchmark,
+	               mode, (long long)operations, (double)operations / seconds, get_percentile(count, 50),
+	               get_percentile(count, 99));
+	UTIL_print_string(line);
+}
+
+
+// --------------------------------------------------------------------------------
+// -                                  Connections                                 -
+// --------------------------------------------------------------------------------
+
+/** @brief Generates the P-256 key and the self-signed certificate of the server, once. */
+static bool create_credentials(void) {
+	if (NULL == server_certificate) {
+		EVP_PKEY_CTX* ctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, NULL);
+		if ((NULL != ctx) && (0 < EVP_PKEY_keygen_init(ctx)) &&
+		    (0 < EVP_PKEY_CTX_set_ec_paramgen_curve_nid(ctx, NID_X9_62_prime256v1)) &&
+		    (0 < EVP_PKEY_keygen(ctx, &server_key))) {
+			X509* certificate = X509_new();
+			X509_NAME* name = X509_NAME_new();
+			if ((NULL != certificate) && (NULL != name) && (1 == X509_set_version(certificate, 2)) &&
+			    (1 == ASN1_INTEGER_set(X509_get_serialNumber(certificate), 1)) &&
+			    (NULL != X509_gmtime_adj(X509_getm_notBefore(certificate), 0)) &&
+			    (NULL != X509_gmtime_adj(X509_getm_notAfter(certificate), 24 * 3600)) &&
+			    (1 == X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, (const unsigned char*)BENCH_HOST_NAME, -1,
+			                                     -1, 0)) &&
+			    (1 == X509_set_subject_name(certificate, name)) && (1 == X509_set_issuer_name(certificate, name)) &&
+			    (1 == X509_set_pubkey(certificate, server_key)) &&
+			    (0 < X509_sign(certificate, server_key, EVP_sha256()))) {
+				server_certificate = certificate;
+			} else {
+				X509_free(certificate);
+			}
+			X509_NAME_free(name);
+		}
+		EVP_PKEY_CTX_free(ctx);
+	}
+	return NULL != server_certificate;
+}
+
+/** @brief Creates a context configured as by the natives, TLS 1.2 or TLS 1.3 only. */
+static SSL_CTX* create_context(bool is_client, int32_t protocol) {
+	SSL_CTX* ctx = SSL_CTX_new(is_client ? TLS_client_method() : TLS_server_method());
+	if (NULL != ctx) {
+#ifdef TLS1_3_VERSION
+		int version = (TLSv1_3_PROTOCOL == protocol) ? TLS1_3_VERSION : TLS1_2_VERSION;
+#else
+		int version = TLS1_2_VERSION;
+#endif
+		bool configured = (1 == SSL_CTX_set_min_proto_version(ctx, version)) &&
+		                  (1 == SSL_CTX_set_max_proto_version(ctx, version));
+		if (is_client) {
+			SSL_CTX_set_verify(ctx, SSL_VERIFY_NONE, NULL);
+		} else {
+			configured = configured && (1 == SSL_CTX_use_certificate(ctx, server_certificate)) &&
+			             (1 == SSL_CTX_use_PrivateKey(ctx, server_key));
+		}
+		if (configured) {
+			// As LLNET_SSL_CONTEXT_IMPL_createClientContext() and LLNET_SSL_CONTEXT_IMPL_createServerContext()
+			LLNET_SSL_KTLS_enable(ctx, protocol);
+			LLNET_SSL_MEMORY_configure_context(ctx);
+			LLNET_SSL_TLS13_configure_context(ctx, protocol, is_client);
+		} else {
+			SSL_CTX_free(ctx);
+			ctx = NULL;
+		}
+	}
+	return ctx;
+}
+
+/** @brief Frees a context created by create_context(). */
+static void free_context(SSL_CTX* ctx) {
+	LLNET_SSL_TLS13_release(ctx);
+	SSL_CTX_free(ctx);
+}
+
+/** @brief Creates a session charged to its own memory account, as LLNET_SSL_SOCKET_IMPL_create(). */
+static SSL* create_session(SSL_CTX* ctx, int32_t fd, bool is_client) {
+	LLNET_SSL_MEMORY_account_t* account = LLNET_SSL_MEMORY_create_account();
+	LLNET_SSL_MEMORY_set_current_account(account);
+	SSL* ssl = SSL_new(ctx);
+	LLNET_SSL_MEMORY_set_current_account(NULL);
+	LLNET_SSL_MEMORY_attach(ssl, account);
+	if ((NULL != ssl) && (1 != SSL_set_fd(ssl, fd))) {
+		LLNET_SSL_MEMORY_detach(ssl);
+		SSL_free(ssl);
+		ssl = NULL;
+	}
+	if ((NULL != ssl) && is_client) {
+		SSL_set_connect_state(ssl);
+		(void)SSL_set_tlsext_host_name(ssl, BENCH_HOST_NAME);
+		LLNET_SSL_TLS13_resume(ssl);
+	} else if (NULL != ssl) {
+		SSL_set_accept_state(ssl);
+	} else {
+		// Not created
+	}
+	return ssl;
+}
+
+/** @brief Frees a session, as LLNET_SSL_SOCKET_IMPL_freeSSL(). */
+static void free_session(SSL* ssl) {
+	if (NULL != ssl) {
+		LLNET_SSL_MEMORY_detach(ssl);
+		SSL_free(ssl);
+	}
+}
+
+/** @brief Opens a TCP loopback connection with non-blocking sockets, returns false on error. */
+static bool open_tcp_connection(int32_t* client_fd, int32_t* server_fd) {
+	struct sockaddr_in address;
+	socklen_t length = sizeof(address);
+	(void)memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	int32_t listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	*client_fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	*server_fd = -1;
+	if ((listen_fd >= 0) && (*client_fd >= 0) && (0 == bind(listen_fd, (struct sockaddr*)&address, sizeof(address))) &&
+	    (0 == listen(listen_fd, 1)) && (0 == getsockname(listen_fd, (struct sockaddr*)&address, &length)) &&
+	    (0 == connect(*client_fd, (struct sockaddr*)&address, sizeof(address)))) {
+		*server_fd = accept4(listen_fd, NULL, NULL, SOCK_CLOEXEC | SOCK_NONBLOCK);
+	}
+	if (listen_fd >= 0) {
+		(void)close(listen_fd);
+	}
+	if (*server_fd >= 0) {
+		// As the natives, the sockets are non-blocking and the small records are sent at once
+		int32_t no_delay = 1;
+		(void)fcntl(*client_fd, F_SETFL, fcntl(*client_fd, F_GETFL) | O_NONBLOCK);
+		(void)setsockopt(*client_fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+		(void)setsockopt(*server_fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+	} else if (*client_fd >= 0) {
+		(void)close(*client_fd);
+	}
+	return *server_fd >= 0;
+}
+
+/** @brief Waits until one of the sockets of a connection is readable, returns false on timeout. */
+static bool wait_connection(const bench_tls_connection* connection) {
+	struct pollfd pfds[2] = { { connection->client_fd, POLLIN, 0 }, { connection->server_fd, POLLIN, 0 } };
+	return 0 < poll(pfds, 2, BENCH_WAIT_TIMEOUT_MS);
+}
+
+/** @brief Tells whether an OpenSSL call on a non-blocking socket has to be retried. */
+static bool must_retry(SSL* ssl, int ret) {
+	int error = SSL_get_error(ssl, ret);
+	return (SSL_ERROR_WANT_READ == error) || (SSL_ERROR_WANT_WRITE == error);
+}
+
+/**
+ * @brief Runs a handshake step of a session, charged to its account.
+ *
+ * @return 1 if the handshake is done, 0 if it waits for the peer, -1 on error.
+ */
+static int32_t handshake_step(SSL* ssl) {
+	int32_t status = 1;
+	if (1 != SSL_is_init_finished(ssl)) {
+		LLNET_SSL_MEMORY_set_current_account(LLNET_SSL_MEMORY_get_account(ssl));
+		int ret = SSL_do_handshake(ssl);
+		LLNET_SSL_MEMORY_set_current_account(NULL);
+		status = (1 == ret) ? 1 : (must_retry(ssl, ret) ? 0 : -1);
+	}
+	return status;
+}
+
+/** @brief Runs the handshake of both sides of a connection, returns false on error. */
+static bool handshake(bench_tls_connection* connection) {
+	int32_t client_status = 0;
+	int32_t server_status = 0;
+	bool progress = true;
+	while (progress && ((client_status <= 0) || (server_status <= 0))) {
+		client_status = handshake_step(connection->client);
+		server_status = handshake_step(connection->server);
+		if ((client_status < 0) || (server_status < 0)) {
+			progress = false;
+		} else if ((0 == client_status) || (0 == server_status)) {
+			progress = wait_connection(connection);
+		} else {
+			// Done
+		}
+	}
+	return (client_status > 0) && (server_status > 0);
+}
+
+/** @brief Writes a message on a session, charged to its account, returns false on error. */
+static bool tls_write(const bench_tls_connection* connection, SSL* ssl, const uint8_t* data, int32_t size) {
+	int ret;
+	bool retry;
+	do {
+		LLNET_SSL_MEMORY_set_current_account(LLNET_SSL_MEMORY_get_account(ssl));
+		ret = SSL_write(ssl, data, size);
+		LLNET_SSL_MEMORY_set_current_account(NULL);
+		retry = (ret <= 0) && must_retry(ssl, ret) && wait_connection(connection);
+	} while (retry);
+	return size == ret;
+}
+
+/** @brief Reads a message on a session, charged to its account, returns false on error. */
+static bool tls_read(const bench_tls_connection* connection, SSL* ssl, uint8_t* data, int32_t size) {
+	int32_t offset = 0;
+	bool retry = true;
+	while (retry && (offset < size)) {
+		LLNET_SSL_MEMORY_set_current_account(LLNET_SSL_MEMORY_get_account(ssl));
+		int ret = SSL_read(ssl, data + offset, size - offset);
+		LLNET_SSL_MEMORY_set_current_account(NULL);
+		if (ret > 0) {
+			offset += ret;
+		} else {
+			retry = must_retry(ssl, ret) && wait_connection(connection);
+		}
+	}
+	return size == offset;
+}
+
+/** @brief Opens a TLS loopback connection, without running the handshake. */
+static bool open_tls_connection(bench_tls_connection* connection, SSL_CTX* client_ctx, SSL_CTX* server_ctx) {
+	connection->client = NULL;
+	connection->server = NULL;
+	bool opened = open_tcp_connection(&connection->client_fd, &connection->server_fd);
+	if (opened) {
+		connection->client = create_session(client_ctx, connection->client_fd, true);
+		connection->server = create_session(server_ctx, connection->server_fd, false);
+		opened = (NULL != connection->client) && (NULL != connection->server);
+	}
+	return opened;
+}
+
+/** @brief Closes a TLS loopback connection, with a close_notify alert so that its session stays resumable. */
+static void close_tls_connection(bench_tls_connection* connection) {
+	if ((NULL != connection->client) && (NULL != connection->server)) {
+		// As LLNET_SSL_SOCKET_IMPL_shutdown(), without waiting for the close_notify of the peer
+		(void)SSL_shutdown(connection->client);
+		(void)SSL_shutdown(connection->server);
+	}
+	free_session(connection->client);
+	free_session(connection->server);
+	(void)close(connection->client_fd);
+	(void)close(connection->server_fd);
+}
+
+/** @brief Makes the sockets of a connection blocking, for the throughput measurement. */
+static void set_blocking(bench_tls_connection* connection) {
+	(void)fcntl(connection->client_fd, F_SETFL, fcntl(connection->client_fd, F_GETFL) & ~O_NONBLOCK);
+	(void)fcntl(connection->server_fd, F_SETFL, fcntl(connection->server_fd, F_GETFL) & ~O_NONBLOCK);
+}
+
+/** @brief Gets the resident memory of the process, in bytes. */
+static int64_t get_resident_size(void) {
+	long resident_pages = 0;
+	FILE* statm = fopen("/proc/self/statm", "r");
+	if (NULL != statm) {
+		if (1 != fscanf(statm, "%*s %ld", &resident_pages)) {
+			resident_pages = 0;
+		}
+		(void)fclose(statm);
+	}
+	return (int64_t)resident_pages * sysconf(_SC_PAGESIZE);
+}
+
+/* Reads and counts the data, until the connection is closed by the client */
+static void* reader_thread_run(void* arg) {
+	bench_bulk_context* bulk = (bench_bulk_context*)arg;
+	int received;
+	do {
+		received = SSL_read(bulk->connection.server, bulk_buffer, (int)sizeof(bulk_buffer));
+		if (received > 0) {
+			bulk->received += received;
+		}
+	} while (received > 0);
+	return NULL;
+}
+
+/** @brief Function call before running test. */
+static void T_LLSSL_BENCH_setUp(void)
+{
+	UTIL_print_string("\nT_LLSSL_BENCH_setUp\n");
+	// As LLNET_CHANNEL_IMPL_initialize(): the writes on a connection closed by the peer fail with EPIPE
+	(void)signal(SIGPIPE, SIG_IGN);
+	(void)memset(request, 0x51, sizeof(request));
+	(void)memset(response, 0x52, sizeof(response));
+	(void)memset(bulk_data, 0x53, sizeof(bulk_data));
+
+	const char* duration = getenv("LLSSL_BENCH_DURATION_MS");
+	duration_ns = (int64_t)((NULL != duration) ? atoi(duration) : BENCH_DURATION_MS) * 1000000;
+}
+
+/** @brief Function call after running test. */
+static void T_LLSSL_BENCH_tearDown(void)
+{
+	UTIL_print_string("T_LLSSL_BENCH_tearDown\n");
+}
+
+
+// --------------------------------------------------------------------------------
+// -                                  Operations                                  -
+// --------------------------------------------------------------------------------
+
+/* Request and response, on a connection whose sockets are non-blocking */
+static bool exchange_operation(void* context) {
+	bench_tls_connection* connection = (bench_tls_connection*)context;
+	return tls_write(connection, connection->client, request, BENCH_MESSAGE_SIZE) &&
+	       tls_read(connection, connection->server, buffer, BENCH_MESSAGE_SIZE) &&
+	       tls_write(connection, connection->server, response, BENCH_MESSAGE_SIZE) &&
+	       tls_read(connection, connection->client, buffer, BENCH_MESSAGE_SIZE);
+}
+
+#ifdef TLS1_3_VERSION
+/**
+ * @brief Sends the request as early data, and reads it on the server until the end of the early data. Both sides
+ * complete the handshake meanwhile.
+ */
+static bool early_data_exchange(bench_tls_connection* connection) {
+	size_t written = 0;
+	int ret;
+	bool progress;
+	do {
+		LLNET_SSL_MEMORY_set_current_account(LLNET_SSL_MEMORY_get_account(connection->client));
+		ret = SSL_write_early_data(connection->client, request, BENCH_MESSAGE_SIZE, &written);
+		LLNET_SSL_MEMORY_set_current_account(NULL);
+		progress = (1 != ret) && must_retry(connection->client, ret) && wait_connection(connection);
+	} while (progress);
+	progress = (1 == ret);
+
+	// As LLNET_SSL_TLS13_IMPL_readEarlyData(), until there is no more early data
+	int status = SSL_READ_EARLY_DATA_ERROR;
+	while (progress && (SSL_READ_EARLY_DATA_FINISH != status)) {
+		size_t received = 0;
+		LLNET_SSL_MEMORY_set_current_account(LLNET_SSL_MEMORY_get_account(connection->server));
+		status = SSL_read_early_data(connection->server, buffer, sizeof(buffer), &received);
+		LLNET_SSL_MEMORY_set_current_account(NULL);
+		if (SSL_READ_EARLY_DATA_ERROR == status) {
+			// The client handshake sends the end of the early data
+			progress = must_retry(connection->server, 0) && (handshake_step(connection->client) >= 0) &&
+			           wait_connection(connection);
+		}
+	}
+	return progress && handshake(connection);
+}
+#endif
+
+/* New connection, request and response */
+static bool tls13_operation(void* context) {
+	bench_tls13_context* tls13 = (bench_tls13_context*)context;
+	bench_tls_connection connection;
+	bool done = open_tls_connection(&connection, tls13->client_ctx, tls13->server_ctx);
+#ifdef TLS1_3_VERSION
+	SSL_SESSION* session = done ? SSL_get_session(connection.client) : NULL;
+	if (done && tls13->early_data && (NULL != session) && (SSL_SESSION_get_max_early_data(session) > 0)) {
+		done = early_data_exchange(&connection);
+		if (done && (SSL_EARLY_DATA_ACCEPTED == SSL_get_early_data_status(connection.server))) {
+			tls13->early_data_accepted++;
+		} else if (done) {
+			// Early data rejected: the request is sent again after the handshake
+			done = tls_write(&connection, connection.client, request, BENCH_MESSAGE_SIZE) &&
+			       tls_read(&connection, connection.server, buffer, BENCH_MESSAGE_SIZE);
+		} else {
+			// Failed
+		}
+		done = done && tls_write(&connection, connection.server, response, BENCH_MESSAGE_SIZE) &&
+		       tls_read(&connection, connection.client, buffer, BENCH_MESSAGE_SIZE);
+	} else
+#endif
+	{
+		done = done && handshake(&connection) && exchange_operation(&connection);
+	}
+	if (done && (1 == SSL_session_reused(connection.client))) {
+		tls13->resumed++;
+	}
+	close_tls_connection(&connection);
+	return done;
+}
+
+/* One write of BENCH_BULK_SIZE bytes, the client socket is blocking */
+static bool bulk_operation(void* context) {
+	bench_bulk_context* bulk = (bench_bulk_context*)context;
+	return BENCH_BULK_SIZE == SSL_write(bulk->connection.client, bulk_data, BENCH_BULK_SIZE);
+}
+
+
+// --------------------------------------------------------------------------------
+// -                                  Tests                                       -
+// --------------------------------------------------------------------------------
+
+static void T_LLSSL_BENCH_ktls(void)
+{
+	UTIL_print_string("LLSSL kTLS benchmark\n");
+	static const char* modes[] = { "user_space", "ktls" };
+	char line[160];
+	TEST_ASSERT_MESSAGE(create_credentials(), "Cannot create the server certificate");
+
+	for (int32_t i = 0; i < (int32_t)(sizeof(modes) / sizeof(modes[0])); i++) {
+		SSL_CTX* client_ctx = create_context(true, TLSv1_2_PROTOCOL);
+		SSL_CTX* server_ctx = create_context(false, TLSv1_2_PROTOCOL);
+		TEST_ASSERT_MESSAGE((NULL != client_ctx) && (NULL != server_ctx), "Cannot create the contexts");
+#ifdef SSL_OP_ENABLE_KTLS
+		if (0 == i) {
+			(void)SSL_CTX_clear_options(client_ctx, SSL_OP_ENABLE_KTLS);
+			(void)SSL_CTX_clear_options(server_ctx, SSL_OP_ENABLE_KTLS);
+		}
+#endif
+
+		bench_bulk_context bulk;
+		bulk.received = 0;
+		TEST_ASSERT_MESSAGE(open_tls_connection(&bulk.connection, client_ctx, server_ctx), "Cannot open the connection");
+		TEST_ASSERT_MESSAGE(handshake(&bulk.connection), "Handshake failed");
+		(void)snprintf(line, sizeof(line), "%s: kTLS status client 0x%x, server 0x%x (send 0x%x, receive 0x%x)\n",
+		               modes[i], (unsigned int)LLNET_SSL_KTLS_get_status(bulk.connection.client),
+		               (unsigned int)LLNET_SSL_KTLS_get_status(bulk.connection.server), LLNET_SSL_KTLS_SEND,
+		               LLNET_SSL_KTLS_RECEIVE);
+		UTIL_print_string(line);
+		if ((0 != i) && (0 == LLNET_SSL_KTLS_get_status(bulk.connection.client))) {
+			UTIL_print_string("kTLS not available, the user-space record layer is used\n");
+		}
+
+		set_blocking(&bulk.connection);
+		TEST_ASSERT_MESSAGE(0 == pthread_create(&bulk.reader_thread, NULL, reader_thread_run, &bulk),
+		                    "Cannot start the reader thread");
+		int64_t start = get_time_ns();
+		bench_run("ktls", modes[i], bulk_operation, &bulk);
+		(void)shutdown(bulk.connection.client_fd, SHUT_WR);
+		(void)pthread_join(bulk.reader_thread, NULL);
+		double seconds = (double)(get_time_ns() - start) / 1e9;
+		close_tls_connection(&bulk.connection);
+		free_context(client_ctx);
+		free_context(server_ctx);
+
+		(void)snprintf(line, sizeof(line), "%s: %.1f MiB/s received\n", modes[i],
+		               (double)bulk.received / (1024.0 * 1024.0) / seconds);
+		UTIL_print_string(line);
+	}
+}
+
+static void T_LLSSL_BENCH_memory(void)
+{
+	UTIL_print_string("LLSSL memory benchmark\n");
+	static const char* modes[] = { "keep_buffers", "release_buffers" };
+	char line[200];
+	TEST_ASSERT_MESSAGE(create_credentials(), "Cannot create the server certificate");
+	if (-1 == LLNET_SSL_MEMORY_IMPL_getStatistic(0, LLNET_SSL_MEMORY_STAT_ALLOCATED_BYTES)) {
+		UTIL_print_string("OpenSSL allocation functions not replaced, resident memory only\n");
+	}
+
+	for (int32_t i = 0; i < (int32_t)(sizeof(modes) / sizeof(modes[0])); i++) {
+		SSL_CTX* client_ctx = create_context(true, TLSv1_2_PROTOCOL);
+		SSL_CTX* server_ctx = create_context(false, TLSv1_2_PROTOCOL);
+		TEST_ASSERT_MESSAGE((NULL != client_ctx) && (NULL != server_ctx), "Cannot create the contexts");
+		if (0 == i) {
+			(void)SSL_CTX_clear_mode(client_ctx, SSL_MODE_RELEASE_BUFFERS);
+			(void)SSL_CTX_clear_mode(server_ctx, SSL_MODE_RELEASE_BUFFERS);
+		}
+
+		int64_t resident_before = get_resident_size();
+		int64_t allocated_before = LLNET_SSL_MEMORY_IMPL_getStatistic(0, LLNET_SSL_MEMORY_STAT_ALLOCATED_BYTES);
+		int64_t hits_before = LLNET_SSL_MEMORY_IMPL_getStatistic(0, LLNET_SSL_MEMORY_STAT_POOL_HITS);
+		int64_t misses_before = LLNET_SSL_MEMORY_IMPL_getStatistic(0, LLNET_SSL_MEMORY_STAT_POOL_MISSES);
+		int64_t client_allocated = 0;
+		int32_t count = 0;
+		bool opened = true;
+		while (opened && (count < BENCH_MEMORY_CONNECTIONS)) {
+			bench_tls_connection* connection = &connections[count];
+			opened = open_tls_connection(connection, client_ctx, server_ctx);
+			if (opened) {
+				count++;
+				opened = handshake(connection) && exchange_operation(connection);
+				client_allocated += LLNET_SSL_MEMORY_IMPL_getStatistic((int32_t)connection->client,
+				                                                       LLNET_SSL_MEMORY_STAT_ALLOCATED_BYTES);
+			}
+		}
+		int64_t resident = get_resident_size() - resident_before;
+		int64_t allocated = LLNET_SSL_MEMORY_IMPL_getStatistic(0, LLNET_SSL_MEMORY_STAT_ALLOCATED_BYTES) -
+		                    allocated_before;
+
+		if (opened) {
+			bench_run("memory", modes[i], exchange_operation, &connections[0]);
+		}
+		for (int32_t c = 0; c < count; c++) {
+			close_tls_connection(&connections[c]);
+		}
+		free_context(client_ctx);
+		free_context(server_ctx);
+		TEST_ASSERT_MESSAGE(opened, "Cannot open the connections");
+
+		(void)snprintf(line, sizeof(line),
+		               "%s: %d connections, per connection %lld bytes resident, %lld bytes OpenSSL (client session "
+		               "%lld bytes), %.1f connections per MB resident\n", modes[i], (int)count,
+		               (long long)(resident / count), (long long)(allocated / count),
+		               (long long)(client_allocated / count),
+		               (resident > 0) ? (((double)count * 1024.0 * 1024.0) / (double)resident) : 0.0);
+		UTIL_print_string(line);
+		(void)snprintf(line, sizeof(line), "%s: buffer pool %lld hits, %lld misses, %lld bytes pooled\n", modes[i],
+		               (long long)(LLNET_SSL_MEMORY_IMPL_getStatistic(0, LLNET_SSL_MEMORY_STAT_POOL_HITS) - hits_before),
+		               (long long)(LLNET_SSL_MEMORY_IMPL_getStatistic(0, LLNET_SSL_MEMORY_STAT_POOL_MISSES) -
+		                           misses_before),
+		               (long long)LLNET_SSL_MEMORY_IMPL_getStatistic(0, LLNET_SSL_MEMORY_STAT_POOLED_BYTES));
+		UTIL_print_string(line);
+	}
+}
+
+static void T_LLSSL_BENCH_tls13(void)
+{
+	UTIL_print_string("LLSSL TLS 1.3 benchmark\n");
+#ifdef TLS1_3_VERSION
+	static const char* modes[] = { "full", "resumption", "early_data" };
+	char line[160];
+	TEST_ASSERT_MESSAGE(create_credentials(), "Cannot create the server certificate");
+
+	for (int32_t i = 0; i < (int32_t)(sizeof(modes) / sizeof(modes[0])); i++) {
+		bench_tls13_context tls13;
+		tls13.client_ctx = create_context(true, TLSv1_3_PROTOCOL);
+		tls13.server_ctx = create_context(false, TLSv1_3_PROTOCOL);
+		tls13.early_data = (2 == i);
+		tls13.resumed = 0;
+		tls13.early_data_accepted = 0;
+		TEST_ASSERT_MESSAGE((NULL != tls13.client_ctx) && (NULL != tls13.server_ctx), "Cannot create the contexts");
+		if (0 == i) {
+			// No session kept by the client
+			(void)SSL_CTX_set_session_cache_mode(tls13.client_ctx, SSL_SESS_CACHE_OFF);
+		} else if (tls13.early_data) {
+			(void)SSL_CTX_set_max_early_data(tls13.server_ctx, BENCH_MESSAGE_SIZE);
+			(void)SSL_CTX_set_recv_max_early_data(tls13.server_ctx, BENCH_MESSAGE_SIZE);
+		} else {
+			// Resumption only, as configured by LLNET_SSL_TLS13_configure_context()
+		}
+
+		bench_run("tls13", modes[i], tls13_operation, &tls13);
+		free_context(tls13.client_ctx);
+		free_context(tls13.server_ctx);
+
+		(void)snprintf(line, sizeof(line), "%s: %lld connections resumed, %lld early data accepted\n", modes[i],
+		               (long long)tls13.resumed, (long long)tls13.early_data_accepted);
+		UTIL_print_string(line);
+	}
+#else
+	UTIL_print_string("OpenSSL 1.1.1 or later required, benchmark skipped\n");
+#endif
+}
+
+#else // OPENSSL_VERSION_NUMBER
+
+static void T_LLSSL_BENCH_setUp(void)
+{
+	UTIL_print_string("\nT_LLSSL_BENCH_setUp\n");
+}
+
+static void T_LLSSL_BENCH_tearDown(void)
+{
+	UTIL_print_string("T_LLSSL_BENCH_tearDown\n");
+}
+
+static void T_LLSSL_BENCH_ktls(void)
+{
+	UTIL_print_string("OpenSSL 1.1.0 or later required, benchmark skipped\n");
+}
+
+static void T_LLSSL_BENCH_memory(void)
+{
+	UTIL_print_string("OpenSSL 1.1.0 or later required, benchmark skipped\n");
+}
+
+static void T_LLSSL_BENCH_tls13(void)
+{
+	UTIL_print_string("OpenSSL 1.1.1 or later required, benchmark skipped\n");
+}
+
+#endif // OPENSSL_VERSION_NUMBER
+
+TestRef T_LLSSL_BENCH_tests(void)
+{
+	EMB_UNIT_TESTFIXTURES(fixture_llssl_bench) {
+		new_TestFixture("T_LLSSL_BENCH_ktls", T_LLSSL_BENCH_ktls),
+		new_TestFixture("T_LLSSL_BENCH_memory", T_LLSSL_BENCH_memory),
+		new_TestFixture("T_LLSSL_BENCH_tls13", T_LLSSL_BENCH_tls13),
+	};
+	EMB_UNIT_TESTCALLER(llssl_bench_tests, "LLSSL benchmark", T_LLSSL_BENCH_setUp, T_LLSSL_BENCH_tearDown,
+	                    fixture_llssl_bench);
+
+	return (TestRef)&llssl_bench_tests;
+}
@@ -0,0 +1,27 @@
+/*
+ * C
+ *
+ * Copyright 2026 MicroEJ Corp. All rights reserved.
+ * Use of this source code is governed by a BSD-style license that can be found with this software.
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include "t_llssl.h"
+#include "../../../../framework/c/embunit/embUnit/embUnit.h"
+#include "../../../../framework/c/utils/inc/u_print.h"
+
+#include "LLNET_SSL_memory.h"
+
+#define LLSSL_VERSION "v1.0.0"
+
+void T_LLSSL_main(void) {
+    UTIL_print_string("\nT_LLSSL " LLSSL_VERSION "\n");
+	// As LLNET_SSL_SOCKET_IMPL_initialize(), before any OpenSSL allocation
+	LLNET_SSL_MEMORY_initialize();
+	TestRunner_start();
+	TestRunner_runTest(T_LLSSL_tests());
+	TestRunner_runTest(T_LLSSL_BENCH_tests());
+	TestRunner_end();
+	return;
+}